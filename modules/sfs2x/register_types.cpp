@@ -5,7 +5,7 @@
 #include "sfs2x.h"
 
 void register_sfs2x_types() {
-    ClassDB::register_class<SmartFoxServer>();
+    ClassDB::register_class<SmartFoxClient>();
 }
 
 void unregister_sfs2x_types() {
@@ -1,25 +1,240 @@
 /* sfs2x.cpp */
 
 #include "sfs2x.h"
+#include "sfs2x_variant.h"
 
-void SmartFoxServer::add(int value) {
-    count += value;
+#include "Entities/Data/SFSObject.h"
+
+#define SIGNAL_ARGS_MAX 5
+
+struct SmartFoxSignal {
+	const char *event_type;
+	const char *name;
+	const char *args[SIGNAL_ARGS_MAX];
+	Variant::Type types[SIGNAL_ARGS_MAX];
+};
+
+// SFSEvent type -> signal, argument names match the keys filled by SFS2XSession
+static const SmartFoxSignal _signals[] = {
+	{ "connection", "connection", { "success", "error_code", "error_message" }, { Variant::BOOL, Variant::INT, Variant::STRING } },
+	{ "connectionLost", "connection_lost", { "reason" }, { Variant::STRING } },
+	{ "connectionRetry", "connection_retry", {}, {} },
+	{ "connectionResume", "connection_resume", {}, {} },
+	{ "socketError", "socket_error", { "error_message" }, { Variant::STRING } },
+	{ "login", "login", { "user_id", "user_name", "zone", "data" }, { Variant::INT, Variant::STRING, Variant::STRING, Variant::DICTIONARY } },
+	{ "loginError", "login_error", { "error_code", "error_message" }, { Variant::INT, Variant::STRING } },
+	{ "logout", "logout", {}, {} },
+	{ "roomJoin", "room_join", { "room_id", "room_name" }, { Variant::INT, Variant::STRING } },
+	{ "roomJoinError", "room_join_error", { "error_code", "error_message" }, { Variant::INT, Variant::STRING } },
+	{ "userEnterRoom", "user_enter_room", { "user_id", "user_name", "room_id" }, { Variant::INT, Variant::STRING, Variant::INT } },
+	{ "userExitRoom", "user_exit_room", { "user_id", "user_name", "room_id" }, { Variant::INT, Variant::STRING, Variant::INT } },
+	{ "publicMessage", "public_message", { "sender_id", "sender_name", "message", "room_id", "data" }, { Variant::INT, Variant::STRING, Variant::STRING, Variant::INT, Variant::DICTIONARY } },
+	{ "extensionResponse", "extension_response", { "cmd", "params", "room_id" }, { Variant::STRING, Variant::DICTIONARY, Variant::INT } },
+	{ "extensionReply", "extension_reply", { "request_id", "cmd", "params", "room_id" }, { Variant::INT, Variant::STRING, Variant::DICTIONARY, Variant::INT } },
+	{ "extensionRequestFailed", "extension_request_failed", { "request_id", "cmd", "reason" }, { Variant::INT, Variant::STRING, Variant::STRING } },
+	{ "pingPong", "ping_pong", { "lag" }, { Variant::INT } },
+	{ "outboundCongestion", "outbound_congestion", { "congested", "pending_bytes" }, { Variant::BOOL, Variant::INT } },
+	{ NULL, NULL, {}, {} }
+};
+
+static std::string _utf8(const String &p_string) {
+	CharString utf8 = p_string.utf8();
+	return std::string(utf8.get_data(), utf8.length());
+}
+
+void SmartFoxClient::_on_session_event(void *p_userdata, const std::string &p_type, const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_args) {
+
+	SmartFoxClient *instance = (SmartFoxClient *)p_userdata;
+
+	for (int i = 0; _signals[i].event_type != NULL; i++) {
+
+		const SmartFoxSignal &signal = _signals[i];
+		if (p_type != signal.event_type) {
+			continue;
+		}
+
+		Variant values[SIGNAL_ARGS_MAX];
+		const Variant *args[SIGNAL_ARGS_MAX];
+		int argcount = 0;
+
+		for (; argcount < SIGNAL_ARGS_MAX && signal.args[argcount] != NULL; argcount++) {
+			// Only the fields bound to the signal are converted, payload objects are converted in place
+			values[argcount] = sfs_object_field_to_variant(p_args, signal.args[argcount]);
+			if (values[argcount].get_type() == Variant::NIL) {
+				Variant::CallError ce;
+				values[argcount] = Variant::construct(signal.types[argcount], NULL, 0, ce);
+			}
+			args[argcount] = &values[argcount];
+		}
+
+		instance->emit_signal(signal.name, args, argcount);
+		return;
+	}
+}
+
+void SmartFoxClient::_notification(int p_what) {
+
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			set_process(true);
+		} break;
+		case NOTIFICATION_PROCESS: {
+			session.process_events();
+		} break;
+		case NOTIFICATION_EXIT_TREE: {
+			session.disconnect();
+		} break;
+	}
+}
+
+void SmartFoxClient::connect_to_host(const String &p_host, int p_port) {
+	session.connect(_utf8(p_host), p_port);
+}
+
+void SmartFoxClient::disconnect_from_host() {
+	session.disconnect();
+}
+
+bool SmartFoxClient::is_connected_to_host() const {
+	return session.is_connected();
+}
+
+void SmartFoxClient::login(const String &p_user_name, const String &p_password, const String &p_zone, const Dictionary &p_params) {
+	session.login(_utf8(p_user_name), _utf8(p_password), _utf8(p_zone), dictionary_to_sfs_object(p_params));
+}
+
+void SmartFoxClient::logout() {
+	session.logout();
+}
+
+void SmartFoxClient::join_room(const String &p_room_name, const String &p_password) {
+	session.join_room(_utf8(p_room_name), _utf8(p_password));
+}
+
+void SmartFoxClient::send_extension_request(const String &p_command, const Dictionary &p_params, int p_room_id, bool p_udp, const String &p_replacement_key) {
+	session.send_extension_request(_utf8(p_command), dictionary_to_sfs_object(p_params), p_room_id, p_udp, _utf8(p_replacement_key));
+}
+
+int SmartFoxClient::send_extension_request_async(const String &p_command, const Dictionary &p_params, int p_room_id, int p_timeout) {
+	return session.send_extension_request_async(_utf8(p_command), dictionary_to_sfs_object(p_params), p_room_id, p_timeout);
+}
+
+bool SmartFoxClient::cancel_extension_request(int p_request_id) {
+	return session.cancel_extension_request(p_request_id);
+}
+
+void SmartFoxClient::send_public_message(const String &p_message, const Dictionary &p_params) {
+	session.send_public_message(_utf8(p_message), dictionary_to_sfs_object(p_params));
 }
 
-void SmartFoxServer::reset() {
-    count = 0;
+void SmartFoxClient::process_events() {
+	session.process_events();
 }
 
-int SmartFoxServer::get_total() const {
-    return count;
+void SmartFoxClient::set_debug(bool p_enabled) {
+	session.set_debug(p_enabled);
+}
+
+bool SmartFoxClient::is_debug() const {
+	return session.is_debug();
+}
+
+void SmartFoxClient::set_poll_mode(bool p_enabled) {
+	session.set_poll_mode(p_enabled);
+}
+
+bool SmartFoxClient::is_poll_mode() const {
+	return session.is_poll_mode();
+}
+
+void SmartFoxClient::set_reconnection_seconds(int p_seconds) {
+	session.set_reconnection_seconds(p_seconds);
+}
+
+int SmartFoxClient::get_reconnection_seconds() const {
+	return session.get_reconnection_seconds();
+}
+
+void SmartFoxClient::set_send_watermarks(int p_high_watermark, int p_low_watermark) {
+	session.set_send_watermarks(p_high_watermark, p_low_watermark);
+}
+
+int SmartFoxClient::get_send_high_watermark() const {
+	return session.get_send_high_watermark();
+}
+
+int SmartFoxClient::get_send_low_watermark() const {
+	return session.get_send_low_watermark();
+}
+
+int SmartFoxClient::get_pending_send_bytes() const {
+	return session.get_pending_send_bytes();
+}
+
+String SmartFoxClient::get_current_zone() const {
+	std::string zone = session.get_current_zone();
+	return String::utf8(zone.data(), zone.size());
+}
+
+int SmartFoxClient::get_my_user_id() const {
+	return session.get_my_user_id();
+}
+
+String SmartFoxClient::get_my_user_name() const {
+	std::string name = session.get_my_user_name();
+	return String::utf8(name.data(), name.size());
+}
+
+void SmartFoxClient::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("connect_to_host", "host", "port"), &SmartFoxClient::connect_to_host);
+	ClassDB::bind_method(D_METHOD("disconnect_from_host"), &SmartFoxClient::disconnect_from_host);
+	ClassDB::bind_method(D_METHOD("is_connected_to_host"), &SmartFoxClient::is_connected_to_host);
+
+	ClassDB::bind_method(D_METHOD("login", "user_name", "password", "zone", "params"), &SmartFoxClient::login, DEFVAL(Dictionary()));
+	ClassDB::bind_method(D_METHOD("logout"), &SmartFoxClient::logout);
+	ClassDB::bind_method(D_METHOD("join_room", "room_name", "password"), &SmartFoxClient::join_room, DEFVAL(String()));
+
+	ClassDB::bind_method(D_METHOD("send_extension_request", "command", "params", "room_id", "udp", "replacement_key"), &SmartFoxClient::send_extension_request, DEFVAL(Dictionary()), DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("send_extension_request_async", "command", "params", "room_id", "timeout"), &SmartFoxClient::send_extension_request_async, DEFVAL(Dictionary()), DEFVAL(-1), DEFVAL(10000));
+	ClassDB::bind_method(D_METHOD("cancel_extension_request", "request_id"), &SmartFoxClient::cancel_extension_request);
+	ClassDB::bind_method(D_METHOD("send_public_message", "message", "params"), &SmartFoxClient::send_public_message, DEFVAL(Dictionary()));
+
+	ClassDB::bind_method(D_METHOD("process_events"), &SmartFoxClient::process_events);
+
+	ClassDB::bind_method(D_METHOD("set_debug", "enabled"), &SmartFoxClient::set_debug);
+	ClassDB::bind_method(D_METHOD("is_debug"), &SmartFoxClient::is_debug);
+	ClassDB::bind_method(D_METHOD("set_poll_mode", "enabled"), &SmartFoxClient::set_poll_mode);
+	ClassDB::bind_method(D_METHOD("is_poll_mode"), &SmartFoxClient::is_poll_mode);
+	ClassDB::bind_method(D_METHOD("set_reconnection_seconds", "seconds"), &SmartFoxClient::set_reconnection_seconds);
+	ClassDB::bind_method(D_METHOD("get_reconnection_seconds"), &SmartFoxClient::get_reconnection_seconds);
+	ClassDB::bind_method(D_METHOD("set_send_watermarks", "high_watermark", "low_watermark"), &SmartFoxClient::set_send_watermarks);
+	ClassDB::bind_method(D_METHOD("get_send_high_watermark"), &SmartFoxClient::get_send_high_watermark);
+	ClassDB::bind_method(D_METHOD("get_send_low_watermark"), &SmartFoxClient::get_send_low_watermark);
+	ClassDB::bind_method(D_METHOD("get_pending_send_bytes"), &SmartFoxClient::get_pending_send_bytes);
+
+	ClassDB::bind_method(D_METHOD("get_current_zone"), &SmartFoxClient::get_current_zone);
+	ClassDB::bind_method(D_METHOD("get_my_user_id"), &SmartFoxClient::get_my_user_id);
+	ClassDB::bind_method(D_METHOD("get_my_user_name"), &SmartFoxClient::get_my_user_name);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "debug"), "set_debug", "is_debug");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "poll_mode"), "set_poll_mode", "is_poll_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "reconnection_seconds"), "set_reconnection_seconds", "get_reconnection_seconds");
+
+	for (int i = 0; _signals[i].event_type != NULL; i++) {
+		MethodInfo mi;
+		mi.name = _signals[i].name;
+		for (int j = 0; j < SIGNAL_ARGS_MAX && _signals[i].args[j] != NULL; j++) {
+			mi.arguments.push_back(PropertyInfo(_signals[i].types[j], _signals[i].args[j]));
+		}
+		ADD_SIGNAL(mi);
+	}
 }
 
-void SmartFoxServer::_bind_methods() {
-    ClassDB::bind_method(D_METHOD("add", "value"), &SmartFoxServer::add);
-    ClassDB::bind_method(D_METHOD("reset"), &SmartFoxServer::reset);
-    ClassDB::bind_method(D_METHOD("get_total"), &SmartFoxServer::get_total);
+SmartFoxClient::SmartFoxClient() {
+	session.set_event_callback(&SmartFoxClient::_on_session_event, this);
 }
 
-SmartFoxServer::SmartFoxServer() {
-    count = 0;
+SmartFoxClient::~SmartFoxClient() {
+	session.dispose();
 }
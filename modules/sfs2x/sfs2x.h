@@ -2,22 +2,66 @@
 #ifndef SFS2X_H
 #define SFS2X_H
 
-#include "reference.h"
+#include "scene/main/node.h"
 
-class SmartFoxServer : public Reference {
-    GDCLASS(SmartFoxServer, Reference);
+#include "sfs2x_session.h"
 
-    int count;
+/*
+ * Scene node wrapping the SmartFoxServer 2X client.
+ *
+ * The client runs in thread safe mode: network events are queued by the API
+ * threads and dispatched from NOTIFICATION_PROCESS, so every signal is emitted
+ * on the main thread. In poll mode the API has no threads at all and the
+ * network work itself runs from NOTIFICATION_PROCESS. SFSObject/SFSArray payloads are exchanged as
+ * Dictionary/Array (see sfs2x_variant.h).
+ */
+class SmartFoxClient : public Node {
+	GDCLASS(SmartFoxClient, Node);
+
+	SFS2XSession session;
+
+	static void _on_session_event(void *p_userdata, const std::string &p_type, const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_args);
 
 protected:
-    static void _bind_methods();
+	void _notification(int p_what);
+	static void _bind_methods();
 
 public:
-    void add(int value);
-    void reset();
-    int get_total() const;
+	void connect_to_host(const String &p_host, int p_port);
+	void disconnect_from_host();
+	bool is_connected_to_host() const;
+
+	void login(const String &p_user_name, const String &p_password, const String &p_zone, const Dictionary &p_params = Dictionary());
+	void logout();
+	void join_room(const String &p_room_name, const String &p_password = String());
+
+	void send_extension_request(const String &p_command, const Dictionary &p_params = Dictionary(), int p_room_id = -1, bool p_udp = false, const String &p_replacement_key = String());
+	int send_extension_request_async(const String &p_command, const Dictionary &p_params = Dictionary(), int p_room_id = -1, int p_timeout = 10000);
+	bool cancel_extension_request(int p_request_id);
+	void send_public_message(const String &p_message, const Dictionary &p_params = Dictionary());
+
+	void process_events();
+
+	void set_debug(bool p_enabled);
+	bool is_debug() const;
+
+	void set_poll_mode(bool p_enabled);
+	bool is_poll_mode() const;
+
+	void set_reconnection_seconds(int p_seconds);
+	int get_reconnection_seconds() const;
+
+	void set_send_watermarks(int p_high_watermark, int p_low_watermark);
+	int get_send_high_watermark() const;
+	int get_send_low_watermark() const;
+	int get_pending_send_bytes() const;
+
+	String get_current_zone() const;
+	int get_my_user_id() const;
+	String get_my_user_name() const;
 
-    SmartFoxServer();
+	SmartFoxClient();
+	~SmartFoxClient();
 };
 
 #endif
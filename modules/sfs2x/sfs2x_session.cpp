@@ -0,0 +1,356 @@
+/* sfs2x_session.cpp */
+
+#include "sfs2x_session.h"
+
+#include "SmartFox.h"
+#include "Core/SFSEvent.h"
+#include "Entities/Data/SFSObject.h"
+#include "Requests/ExtensionRequest.h"
+#include "Requests/JoinRoomRequest.h"
+#include "Requests/LoginRequest.h"
+#include "Requests/LogoutRequest.h"
+#include "Requests/PublicMessageRequest.h"
+
+typedef std::map<std::string, boost::shared_ptr<void> > EventParams;
+
+const char *SFS2XSession::EXTENSION_REPLY = "extensionReply";
+
+static boost::shared_ptr<string> *_forwarded_events[] = {
+	&SFSEvent::CONNECTION,
+	&SFSEvent::CONNECTION_LOST,
+	&SFSEvent::CONNECTION_RETRY,
+	&SFSEvent::CONNECTION_RESUME,
+	&SFSEvent::SFS_SOCKET_ERROR,
+	&SFSEvent::LOGIN,
+	&SFSEvent::LOGIN_ERROR,
+	&SFSEvent::LOGOUT,
+	&SFSEvent::ROOM_JOIN,
+	&SFSEvent::ROOM_JOIN_ERROR,
+	&SFSEvent::USER_ENTER_ROOM,
+	&SFSEvent::USER_EXIT_ROOM,
+	&SFSEvent::PUBLIC_MESSAGE,
+	&SFSEvent::EXTENSION_RESPONSE,
+	&SFSEvent::PING_PONG,
+	&SFSEvent::OUTBOUND_CONGESTION,
+	&SFSEvent::EXTENSION_REQUEST_FAILED,
+	NULL
+};
+
+template <class T>
+static boost::shared_ptr<T> _param(const boost::shared_ptr<EventParams> &p_params, const char *p_key) {
+	if (p_params == NULL) {
+		return boost::shared_ptr<T>();
+	}
+	EventParams::const_iterator it = p_params->find(p_key);
+	if (it == p_params->end()) {
+		return boost::shared_ptr<T>();
+	}
+	return boost::static_pointer_cast<T>(it->second);
+}
+
+static void _put_user(const boost::shared_ptr<ISFSObject> &p_args, const char *p_id_key, const char *p_name_key, const boost::shared_ptr<User> &p_user) {
+	if (p_user == NULL) {
+		return;
+	}
+	p_args->PutInt(p_id_key, p_user->Id());
+	p_args->PutUtfString(p_name_key, p_user->Name());
+}
+
+static void _put_room(const boost::shared_ptr<ISFSObject> &p_args, const boost::shared_ptr<Room> &p_room) {
+	if (p_room == NULL) {
+		return;
+	}
+	p_args->PutInt("room_id", p_room->Id());
+	p_args->PutUtfString("room_name", p_room->Name());
+}
+
+static void _put_error(const boost::shared_ptr<ISFSObject> &p_args, const boost::shared_ptr<EventParams> &p_params) {
+	boost::shared_ptr<short int> code = _param<short int>(p_params, "errorCode");
+	boost::shared_ptr<string> message = _param<string>(p_params, "errorMessage");
+	if (code != NULL) {
+		p_args->PutInt("error_code", (long int)*code);
+	}
+	if (message != NULL) {
+		p_args->PutUtfString("error_message", message);
+	}
+}
+
+void SFS2XSession::_on_sfs_event(unsigned long long p_context, boost::shared_ptr<BaseEvent> p_event) {
+	SFS2XSession *instance = (SFS2XSession *)p_context;
+	instance->_on_event(p_event);
+}
+
+void SFS2XSession::_on_event(const boost::shared_ptr<BaseEvent> &p_event) {
+
+	if (callback == NULL) {
+		return;
+	}
+
+	const string &type = *p_event->Type();
+	boost::shared_ptr<EventParams> params = p_event->Params();
+	boost::shared_ptr<ISFSObject> args = SFSObject::NewInstance();
+
+	if (type == *SFSEvent::CONNECTION) {
+		boost::shared_ptr<bool> success = _param<bool>(params, "success");
+		args->PutBool("success", success != NULL && *success);
+		_put_error(args, params);
+	} else if (type == *SFSEvent::CONNECTION_LOST) {
+		boost::shared_ptr<string> reason = _param<string>(params, "reason");
+		args->PutUtfString("reason", reason != NULL ? *reason : string());
+	} else if (type == *SFSEvent::SFS_SOCKET_ERROR) {
+		boost::shared_ptr<string> message = _param<string>(params, "errorMessage");
+		args->PutUtfString("error_message", message != NULL ? *message : string());
+	} else if (type == *SFSEvent::LOGIN) {
+		_put_user(args, "user_id", "user_name", _param<User>(params, "user"));
+		boost::shared_ptr<string> zone = _param<string>(params, "zone");
+		args->PutUtfString("zone", zone != NULL ? *zone : string());
+		boost::shared_ptr<ISFSObject> data = _param<ISFSObject>(params, "data");
+		args->PutSFSObject("data", data != NULL ? data : SFSObject::NewInstance());
+	} else if (type == *SFSEvent::LOGIN_ERROR || type == *SFSEvent::ROOM_JOIN_ERROR) {
+		_put_error(args, params);
+	} else if (type == *SFSEvent::ROOM_JOIN) {
+		_put_room(args, _param<Room>(params, "room"));
+	} else if (type == *SFSEvent::USER_ENTER_ROOM || type == *SFSEvent::USER_EXIT_ROOM) {
+		_put_user(args, "user_id", "user_name", _param<User>(params, "user"));
+		_put_room(args, _param<Room>(params, "room"));
+	} else if (type == *SFSEvent::PUBLIC_MESSAGE) {
+		_put_user(args, "sender_id", "sender_name", _param<User>(params, "sender"));
+		_put_room(args, _param<Room>(params, "room"));
+		boost::shared_ptr<string> message = _param<string>(params, "message");
+		args->PutUtfString("message", message != NULL ? *message : string());
+		boost::shared_ptr<ISFSObject> data = _param<ISFSObject>(params, "data");
+		args->PutSFSObject("data", data != NULL ? data : SFSObject::NewInstance());
+	} else if (type == *SFSEvent::EXTENSION_RESPONSE) {
+		boost::shared_ptr<string> cmd = _param<string>(params, "cmd");
+		args->PutUtfString("cmd", cmd != NULL ? *cmd : string());
+		boost::shared_ptr<ISFSObject> data = _param<ISFSObject>(params, "params");
+		args->PutSFSObject("params", data != NULL ? data : SFSObject::NewInstance());
+		boost::shared_ptr<long int> sourceRoom = _param<long int>(params, "sourceRoom");
+		args->PutInt("room_id", sourceRoom != NULL ? *sourceRoom : -1L);
+		boost::shared_ptr<long int> request_id = _param<long int>(params, "requestId");
+		if (request_id != NULL) {
+			args->PutInt("request_id", *request_id);
+		}
+	} else if (type == *SFSEvent::EXTENSION_REQUEST_FAILED) {
+		boost::shared_ptr<long int> request_id = _param<long int>(params, "requestId");
+		args->PutInt("request_id", request_id != NULL ? *request_id : 0L);
+		boost::shared_ptr<string> cmd = _param<string>(params, "cmd");
+		args->PutUtfString("cmd", cmd != NULL ? *cmd : string());
+		boost::shared_ptr<string> reason = _param<string>(params, "reason");
+		args->PutUtfString("reason", reason != NULL ? *reason : string());
+	} else if (type == *SFSEvent::PING_PONG) {
+		boost::shared_ptr<long int> lag = _param<long int>(params, "lagValue");
+		args->PutInt("lag", lag != NULL ? *lag : 0L);
+	} else if (type == *SFSEvent::OUTBOUND_CONGESTION) {
+		boost::shared_ptr<bool> congested = _param<bool>(params, "congested");
+		args->PutBool("congested", congested != NULL && *congested);
+		boost::shared_ptr<long int> pending_bytes = _param<long int>(params, "pendingBytes");
+		args->PutInt("pending_bytes", pending_bytes != NULL ? *pending_bytes : 0L);
+	}
+
+	callback(userdata, type, args);
+
+	if (type == *SFSEvent::EXTENSION_RESPONSE && args->ContainsKey("request_id")) {
+		// The answer to an asynchronous request is also reported on its own, so it can be awaited by id
+		callback(userdata, EXTENSION_REPLY, args);
+	}
+}
+
+void SFS2XSession::_create() {
+
+	if (sfs != NULL) {
+		return;
+	}
+
+	sfs = boost::shared_ptr<SmartFox>(new SmartFox(debug));
+	sfs->ThreadSafeMode(true);
+	sfs->PollMode(poll_mode);
+
+	listener = boost::shared_ptr<EventListenerDelegate>(new EventListenerDelegate(&SFS2XSession::_on_sfs_event, (unsigned long long)this));
+	for (int i = 0; _forwarded_events[i] != NULL; i++) {
+		sfs->AddEventListener(*_forwarded_events[i], listener);
+	}
+}
+
+void SFS2XSession::set_event_callback(EventCallback p_callback, void *p_userdata) {
+	callback = p_callback;
+	userdata = p_userdata;
+}
+
+void SFS2XSession::connect(const std::string &p_host, int p_port) {
+	_create();
+	sfs->Connect(p_host, p_port);
+}
+
+void SFS2XSession::disconnect() {
+	if (sfs != NULL) {
+		sfs->Disconnect();
+	}
+}
+
+bool SFS2XSession::is_connected() const {
+	return sfs != NULL && sfs->IsConnected();
+}
+
+void SFS2XSession::login(const std::string &p_user_name, const std::string &p_password, const std::string &p_zone, const boost::shared_ptr<ISFSObject> &p_params) {
+	if (sfs == NULL) {
+		return;
+	}
+	sfs->Send(boost::shared_ptr<IRequest>(new LoginRequest(p_user_name, p_password, p_zone, p_params)));
+}
+
+void SFS2XSession::logout() {
+	if (sfs == NULL) {
+		return;
+	}
+	sfs->Send(boost::shared_ptr<IRequest>(new LogoutRequest()));
+}
+
+void SFS2XSession::join_room(const std::string &p_room_name, const std::string &p_password) {
+	if (sfs == NULL) {
+		return;
+	}
+	sfs->Send(boost::shared_ptr<IRequest>(new JoinRoomRequest(p_room_name, p_password)));
+}
+
+void SFS2XSession::send_extension_request(const std::string &p_command, const boost::shared_ptr<ISFSObject> &p_params, int p_room_id, bool p_udp, const std::string &p_replacement_key) {
+	if (sfs == NULL) {
+		return;
+	}
+	boost::shared_ptr<Room> room = p_room_id >= 0 ? sfs->GetRoomById(p_room_id) : boost::shared_ptr<Room>();
+	// A non empty key lets the request replace the previous one with the same key while that is still unsent
+	boost::shared_ptr<std::string> replacement_key = p_replacement_key.empty() ? boost::shared_ptr<std::string>() : boost::shared_ptr<std::string>(new std::string(p_replacement_key));
+	sfs->Send(boost::shared_ptr<IRequest>(new ExtensionRequest(p_command, p_params, room, p_udp)), replacement_key);
+}
+
+int SFS2XSession::send_extension_request_async(const std::string &p_command, const boost::shared_ptr<ISFSObject> &p_params, int p_room_id, int p_timeout) {
+	if (sfs == NULL) {
+		return 0;
+	}
+	boost::shared_ptr<Room> room = p_room_id >= 0 ? sfs->GetRoomById(p_room_id) : boost::shared_ptr<Room>();
+	// No callback: the outcome is reported by the extension reply and request failed events
+	return (int)sfs->SendAsync(boost::shared_ptr<IRequest>(new ExtensionRequest(p_command, p_params, room)), boost::shared_ptr<ExtensionResponseDelegate>(), p_timeout > 0 ? p_timeout : 0);
+}
+
+bool SFS2XSession::cancel_extension_request(int p_request_id) {
+	return sfs != NULL && sfs->CancelAsync(p_request_id);
+}
+
+void SFS2XSession::send_public_message(const std::string &p_message, const boost::shared_ptr<ISFSObject> &p_params) {
+	if (sfs == NULL) {
+		return;
+	}
+	sfs->Send(boost::shared_ptr<IRequest>(new PublicMessageRequest(p_message, p_params)));
+}
+
+void SFS2XSession::process_events() {
+	if (sfs == NULL) {
+		return;
+	}
+	if (poll_mode) {
+		// Runs the pending network work, then dispatches the events it has produced
+		sfs->Poll(0);
+	} else {
+		sfs->ProcessEvents();
+	}
+}
+
+void SFS2XSession::set_debug(bool p_enabled) {
+	debug = p_enabled;
+	if (sfs != NULL) {
+		sfs->Debug(p_enabled);
+	}
+}
+
+bool SFS2XSession::is_debug() const {
+	return debug;
+}
+
+void SFS2XSession::set_poll_mode(bool p_enabled) {
+	// The client refuses the change while connected, it then applies from the next session
+	if (sfs != NULL && sfs->IsConnected()) {
+		return;
+	}
+	poll_mode = p_enabled;
+	if (sfs != NULL) {
+		sfs->PollMode(p_enabled);
+	}
+}
+
+bool SFS2XSession::is_poll_mode() const {
+	return poll_mode;
+}
+
+void SFS2XSession::set_reconnection_seconds(int p_seconds) {
+	_create();
+	sfs->SetReconnectionSeconds(p_seconds);
+}
+
+int SFS2XSession::get_reconnection_seconds() const {
+	return sfs != NULL ? (int)sfs->GetReconnectionSeconds() : 0;
+}
+
+void SFS2XSession::set_send_watermarks(int p_high_watermark, int p_low_watermark) {
+	_create();
+	if (p_high_watermark > 0 && (p_low_watermark < 0 || p_low_watermark > p_high_watermark)) {
+		// The client throws on an invalid pair, which must not reach the engine: clamp the low watermark instead
+		p_low_watermark = p_low_watermark < 0 ? 0 : p_high_watermark;
+	}
+	sfs->SendWatermarks(p_high_watermark, p_low_watermark);
+}
+
+int SFS2XSession::get_send_high_watermark() const {
+	return sfs != NULL ? (int)sfs->SendHighWatermark() : 0;
+}
+
+int SFS2XSession::get_send_low_watermark() const {
+	return sfs != NULL ? (int)sfs->SendLowWatermark() : 0;
+}
+
+int SFS2XSession::get_pending_send_bytes() const {
+	return sfs != NULL ? (int)sfs->PendingSendBytes() : 0;
+}
+
+std::string SFS2XSession::get_current_zone() const {
+	if (sfs == NULL || sfs->CurrentZone() == NULL) {
+		return std::string();
+	}
+	return *sfs->CurrentZone();
+}
+
+int SFS2XSession::get_my_user_id() const {
+	if (sfs == NULL || sfs->MySelf() == NULL) {
+		return -1;
+	}
+	return (int)sfs->MySelf()->Id();
+}
+
+std::string SFS2XSession::get_my_user_name() const {
+	if (sfs == NULL || sfs->MySelf() == NULL) {
+		return std::string();
+	}
+	return *sfs->MySelf()->Name();
+}
+
+void SFS2XSession::dispose() {
+
+	if (sfs == NULL) {
+		return;
+	}
+
+	sfs->RemoveAllEventListeners();
+	sfs->Dispose();
+	sfs = boost::shared_ptr<SmartFox>();
+	listener = boost::shared_ptr<EventListenerDelegate>();
+}
+
+SFS2XSession::SFS2XSession() {
+	callback = NULL;
+	userdata = NULL;
+	debug = false;
+	poll_mode = false;
+}
+
+SFS2XSession::~SFS2XSession() {
+	dispose();
+}
@@ -0,0 +1,101 @@
+/* sfs2x_session.h */
+#ifndef SFS2X_SESSION_H
+#define SFS2X_SESSION_H
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+
+namespace Sfs2X {
+class SmartFox;
+namespace Core {
+class BaseEvent;
+} // namespace Core
+namespace Entities {
+namespace Data {
+class ISFSObject;
+} // namespace Data
+} // namespace Entities
+namespace Util {
+template <class type>
+class DelegateOneArgument;
+} // namespace Util
+} // namespace Sfs2X
+
+/*
+ * Owns a SmartFox client instance and flattens its events.
+ *
+ * This translation unit is the only one of the module that includes the full
+ * client API: its headers bring several namespaces into the global scope
+ * (Sfs2X::Logging among them) that clash with engine class names, so the
+ * engine-facing code only sees this interface and the SFSObject/SFSArray
+ * headers.
+ *
+ * Every event is reported as its SFSEvent type plus an SFSObject holding the
+ * event arguments; users and rooms are reduced to their ids and names, payload
+ * objects are attached as they are, without copying.
+ */
+class SFS2XSession {
+
+public:
+	typedef void (*EventCallback)(void *p_userdata, const std::string &p_type, const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_args);
+
+	// Type of the event reporting the answer to send_extension_request_async, besides its extension response
+	static const char *EXTENSION_REPLY;
+
+private:
+	boost::shared_ptr<Sfs2X::SmartFox> sfs;
+	boost::shared_ptr<Sfs2X::Util::DelegateOneArgument<boost::shared_ptr<Sfs2X::Core::BaseEvent> > > listener;
+	EventCallback callback;
+	void *userdata;
+	bool debug;
+	bool poll_mode;
+
+	void _create();
+	void _on_event(const boost::shared_ptr<Sfs2X::Core::BaseEvent> &p_event);
+
+	static void _on_sfs_event(unsigned long long p_context, boost::shared_ptr<Sfs2X::Core::BaseEvent> p_event);
+
+public:
+	void set_event_callback(EventCallback p_callback, void *p_userdata);
+
+	void connect(const std::string &p_host, int p_port);
+	void disconnect();
+	bool is_connected() const;
+
+	void login(const std::string &p_user_name, const std::string &p_password, const std::string &p_zone, const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_params);
+	void logout();
+	void join_room(const std::string &p_room_name, const std::string &p_password);
+
+	void send_extension_request(const std::string &p_command, const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_params, int p_room_id, bool p_udp, const std::string &p_replacement_key);
+	int send_extension_request_async(const std::string &p_command, const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_params, int p_room_id, int p_timeout);
+	bool cancel_extension_request(int p_request_id);
+	void send_public_message(const std::string &p_message, const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_params);
+
+	void process_events();
+
+	void set_debug(bool p_enabled);
+	bool is_debug() const;
+
+	void set_poll_mode(bool p_enabled);
+	bool is_poll_mode() const;
+
+	void set_reconnection_seconds(int p_seconds);
+	int get_reconnection_seconds() const;
+
+	void set_send_watermarks(int p_high_watermark, int p_low_watermark);
+	int get_send_high_watermark() const;
+	int get_send_low_watermark() const;
+	int get_pending_send_bytes() const;
+
+	std::string get_current_zone() const;
+	int get_my_user_id() const;
+	std::string get_my_user_name() const;
+
+	void dispose();
+
+	SFS2XSession();
+	~SFS2XSession();
+};
+
+#endif
@@ -0,0 +1,327 @@
+/* sfs2x_variant.cpp */
+
+#include "sfs2x_variant.h"
+
+#include "pool_vector.h"
+#include "ustring.h"
+
+#include "Entities/Data/SFSArray.h"
+#include "Entities/Data/SFSDataType.h"
+#include "Entities/Data/SFSDataValue.h"
+#include "Entities/Data/SFSDataWrapper.h"
+#include "Entities/Data/SFSObject.h"
+#include "Util/ByteArray.h"
+
+#include <string.h>
+
+using Sfs2X::Entities::Data::ISFSArray;
+using Sfs2X::Entities::Data::ISFSObject;
+using Sfs2X::Entities::Data::SFSArray;
+using Sfs2X::Entities::Data::SFSDataValue;
+using Sfs2X::Entities::Data::SFSDataWrapper;
+using Sfs2X::Entities::Data::SFSObject;
+using Sfs2X::Util::ByteArray;
+
+static String _utf8_to_string(const std::string &p_utf8) {
+	return String::utf8(p_utf8.data(), p_utf8.size());
+}
+
+static std::string _string_to_utf8(const String &p_string) {
+	CharString utf8 = p_string.utf8();
+	return std::string(utf8.get_data(), utf8.length());
+}
+
+template <class T>
+static PoolIntArray _to_pool_int_array(const std::vector<T> &p_values) {
+	PoolIntArray result;
+	result.resize(p_values.size());
+	PoolIntArray::Write w = result.write();
+	for (size_t i = 0; i < p_values.size(); i++) {
+		w[i] = (int)p_values[i];
+	}
+	return result;
+}
+
+template <class T>
+static PoolRealArray _to_pool_real_array(const std::vector<T> &p_values) {
+	PoolRealArray result;
+	result.resize(p_values.size());
+	PoolRealArray::Write w = result.write();
+	if (sizeof(T) == sizeof(real_t)) {
+		if (!p_values.empty()) {
+			memcpy(w.ptr(), &p_values[0], p_values.size() * sizeof(real_t));
+		}
+	} else {
+		for (size_t i = 0; i < p_values.size(); i++) {
+			w[i] = (real_t)p_values[i];
+		}
+	}
+	return result;
+}
+
+// Typed arrays, nested objects and arrays, held by the value through a shared pointer
+static Variant _sfs_reference_to_variant(long int p_type, const boost::shared_ptr<void> &p_data) {
+
+	if (p_data == NULL) {
+		return Variant();
+	}
+
+	void *data = p_data.get();
+
+	switch (p_type) {
+		case Sfs2X::Entities::Data::SFSDATATYPE_BOOL_ARRAY: {
+			const std::vector<bool> &values = *(std::vector<bool> *)data;
+			Array result;
+			result.resize(values.size());
+			for (size_t i = 0; i < values.size(); i++) {
+				result[i] = (bool)values[i];
+			}
+			return result;
+		}
+		case Sfs2X::Entities::Data::SFSDATATYPE_BYTE_ARRAY: {
+			boost::shared_ptr<vector<unsigned char> > bytes = ((ByteArray *)data)->Bytes();
+			PoolByteArray result;
+			if (bytes != NULL && !bytes->empty()) {
+				result.resize(bytes->size());
+				PoolByteArray::Write w = result.write();
+				memcpy(w.ptr(), &(*bytes)[0], bytes->size());
+			}
+			return result;
+		}
+		case Sfs2X::Entities::Data::SFSDATATYPE_SHORT_ARRAY:
+			return _to_pool_int_array(*(std::vector<short int> *)data);
+		case Sfs2X::Entities::Data::SFSDATATYPE_INT_ARRAY:
+			return _to_pool_int_array(*(std::vector<long int> *)data);
+		case Sfs2X::Entities::Data::SFSDATATYPE_LONG_ARRAY: {
+			// 64 bit values do not fit a PoolIntArray
+			const std::vector<long long> &values = *(std::vector<long long> *)data;
+			Array result;
+			result.resize(values.size());
+			for (size_t i = 0; i < values.size(); i++) {
+				result[i] = (int64_t)values[i];
+			}
+			return result;
+		}
+		case Sfs2X::Entities::Data::SFSDATATYPE_FLOAT_ARRAY:
+			return _to_pool_real_array(*(std::vector<float> *)data);
+		case Sfs2X::Entities::Data::SFSDATATYPE_DOUBLE_ARRAY:
+			return _to_pool_real_array(*(std::vector<double> *)data);
+		case Sfs2X::Entities::Data::SFSDATATYPE_UTF_STRING_ARRAY: {
+			const std::vector<std::string> &values = *(std::vector<std::string> *)data;
+			PoolStringArray result;
+			result.resize(values.size());
+			PoolStringArray::Write w = result.write();
+			for (size_t i = 0; i < values.size(); i++) {
+				w[i] = _utf8_to_string(values[i]);
+			}
+			return result;
+		}
+		case Sfs2X::Entities::Data::SFSDATATYPE_SFS_ARRAY:
+			return sfs_array_to_array(boost::static_pointer_cast<ISFSArray>(p_data));
+		case Sfs2X::Entities::Data::SFSDATATYPE_SFS_OBJECT:
+		case Sfs2X::Entities::Data::SFSDATATYPE_CLASS:
+			return sfs_object_to_dictionary(boost::static_pointer_cast<ISFSObject>(p_data));
+		default:
+			return Variant();
+	}
+}
+
+Variant sfs_value_to_variant(const SFSDataValue &p_value) {
+
+	// Primitives and strings are read in place, without boxing them
+	switch (p_value.Type()) {
+		case Sfs2X::Entities::Data::SFSDATATYPE_NULL:
+			return Variant();
+		case Sfs2X::Entities::Data::SFSDATATYPE_BOOL:
+			return p_value.BoolValue();
+		case Sfs2X::Entities::Data::SFSDATATYPE_BYTE:
+			return (int64_t)p_value.ByteValue();
+		case Sfs2X::Entities::Data::SFSDATATYPE_SHORT:
+			return (int64_t)p_value.ShortValue();
+		case Sfs2X::Entities::Data::SFSDATATYPE_INT:
+			return (int64_t)p_value.IntValue();
+		case Sfs2X::Entities::Data::SFSDATATYPE_LONG:
+			return (int64_t)p_value.LongValue();
+		case Sfs2X::Entities::Data::SFSDATATYPE_FLOAT:
+			return (double)p_value.FloatValue();
+		case Sfs2X::Entities::Data::SFSDATATYPE_DOUBLE:
+			return p_value.DoubleValue();
+		case Sfs2X::Entities::Data::SFSDATATYPE_UTF_STRING:
+		case Sfs2X::Entities::Data::SFSDATATYPE_TEXT: {
+			const std::string *value = p_value.StringValue();
+			return value == NULL ? Variant() : Variant(_utf8_to_string(*value));
+		}
+		default:
+			return _sfs_reference_to_variant(p_value.Type(), p_value.Data());
+	}
+}
+
+Variant sfs_data_to_variant(const boost::shared_ptr<SFSDataWrapper> &p_data) {
+
+	if (p_data == NULL) {
+		return Variant();
+	}
+
+	return sfs_value_to_variant(SFSDataValue(p_data->Type(), p_data->Data()));
+}
+
+Variant sfs_object_field_to_variant(const boost::shared_ptr<ISFSObject> &p_object, const std::string &p_key) {
+
+	if (p_object == NULL) {
+		return Variant();
+	}
+
+	SFSObject *object = dynamic_cast<SFSObject *>(p_object.get());
+	if (object != NULL) {
+		const SFSDataValue *value = object->FindValue(p_key);
+		return value == NULL ? Variant() : sfs_value_to_variant(*value);
+	}
+
+	return p_object->ContainsKey(p_key) ? sfs_data_to_variant(p_object->GetData(p_key)) : Variant();
+}
+
+Dictionary sfs_object_to_dictionary(const boost::shared_ptr<ISFSObject> &p_object) {
+
+	Dictionary result;
+	if (p_object == NULL) {
+		return result;
+	}
+
+	SFSObject *object = dynamic_cast<SFSObject *>(p_object.get());
+	if (object != NULL) {
+		long int size = object->Size();
+		for (long int i = 0; i < size; i++) {
+			result[_utf8_to_string(object->KeyAt(i))] = sfs_value_to_variant(object->ValueAt(i));
+		}
+		return result;
+	}
+
+	boost::shared_ptr<vector<string> > keys = p_object->GetKeys();
+	for (vector<string>::const_iterator it = keys->begin(); it != keys->end(); ++it) {
+		result[_utf8_to_string(*it)] = sfs_data_to_variant(p_object->GetData(*it));
+	}
+
+	return result;
+}
+
+Array sfs_array_to_array(const boost::shared_ptr<ISFSArray> &p_array) {
+
+	Array result;
+	if (p_array == NULL) {
+		return result;
+	}
+
+	long int size = p_array->Size();
+	result.resize(size);
+
+	SFSArray *array = dynamic_cast<SFSArray *>(p_array.get());
+	if (array != NULL) {
+		for (long int i = 0; i < size; i++) {
+			result[i] = sfs_value_to_variant(array->ValueAt(i));
+		}
+		return result;
+	}
+
+	for (long int i = 0; i < size; i++) {
+		result[i] = sfs_data_to_variant(p_array->GetWrappedElementAt(i));
+	}
+
+	return result;
+}
+
+static SFSDataValue _wrap(Sfs2X::Entities::Data::SFSDataType p_type, const boost::shared_ptr<void> &p_data) {
+	SFSDataValue result;
+	result.SetData(p_type, p_data);
+	return result;
+}
+
+SFSDataValue variant_to_sfs_value(const Variant &p_value) {
+
+	// Primitives are stored inline in the value, only strings and containers are allocated
+	SFSDataValue result;
+
+	switch (p_value.get_type()) {
+		case Variant::NIL:
+			return result;
+		case Variant::BOOL:
+			result.SetBool((bool)p_value);
+			return result;
+		case Variant::INT: {
+			int64_t value = p_value;
+			if (value >= -2147483647LL - 1 && value <= 2147483647LL) {
+				result.SetInt((long int)value);
+			} else {
+				result.SetLong((long long)value);
+			}
+			return result;
+		}
+		case Variant::REAL:
+			result.SetDouble((double)p_value);
+			return result;
+		case Variant::STRING:
+			return _wrap(Sfs2X::Entities::Data::SFSDATATYPE_UTF_STRING, boost::shared_ptr<string>(new string(_string_to_utf8(p_value))));
+		case Variant::DICTIONARY:
+			return _wrap(Sfs2X::Entities::Data::SFSDATATYPE_SFS_OBJECT, dictionary_to_sfs_object(p_value));
+		case Variant::ARRAY:
+			return _wrap(Sfs2X::Entities::Data::SFSDATATYPE_SFS_ARRAY, array_to_sfs_array(p_value));
+		case Variant::POOL_BYTE_ARRAY: {
+			PoolByteArray values = p_value;
+			PoolByteArray::Read r = values.read();
+			boost::shared_ptr<vector<unsigned char> > bytes(new vector<unsigned char>(r.ptr(), r.ptr() + values.size()));
+			return _wrap(Sfs2X::Entities::Data::SFSDATATYPE_BYTE_ARRAY, boost::shared_ptr<ByteArray>(new ByteArray(bytes)));
+		}
+		case Variant::POOL_INT_ARRAY: {
+			PoolIntArray values = p_value;
+			PoolIntArray::Read r = values.read();
+			boost::shared_ptr<vector<long int> > ints(new vector<long int>(r.ptr(), r.ptr() + values.size()));
+			return _wrap(Sfs2X::Entities::Data::SFSDATATYPE_INT_ARRAY, ints);
+		}
+		case Variant::POOL_REAL_ARRAY: {
+			PoolRealArray values = p_value;
+			PoolRealArray::Read r = values.read();
+			boost::shared_ptr<vector<float> > floats(new vector<float>(r.ptr(), r.ptr() + values.size()));
+			return _wrap(Sfs2X::Entities::Data::SFSDATATYPE_FLOAT_ARRAY, floats);
+		}
+		case Variant::POOL_STRING_ARRAY: {
+			PoolStringArray values = p_value;
+			PoolStringArray::Read r = values.read();
+			boost::shared_ptr<vector<string> > strings(new vector<string>());
+			strings->reserve(values.size());
+			for (int i = 0; i < values.size(); i++) {
+				strings->push_back(_string_to_utf8(r[i]));
+			}
+			return _wrap(Sfs2X::Entities::Data::SFSDATATYPE_UTF_STRING_ARRAY, strings);
+		}
+		default:
+			// Vectors, colors, nodes etc. have no SFS2X counterpart, send their text form
+			return _wrap(Sfs2X::Entities::Data::SFSDATATYPE_UTF_STRING, boost::shared_ptr<string>(new string(_string_to_utf8(p_value.operator String()))));
+	}
+}
+
+boost::shared_ptr<SFSDataWrapper> variant_to_sfs_data(const Variant &p_value) {
+	return variant_to_sfs_value(p_value).ToWrapper();
+}
+
+boost::shared_ptr<ISFSObject> dictionary_to_sfs_object(const Dictionary &p_dictionary) {
+
+	boost::shared_ptr<SFSObject> result = SFSObject::NewInstance();
+	result->Reserve(p_dictionary.size());
+
+	const Variant *key = NULL;
+	while ((key = p_dictionary.next(key))) {
+		result->PutValue(_string_to_utf8(*key), variant_to_sfs_value(p_dictionary[*key]));
+	}
+
+	return result;
+}
+
+boost::shared_ptr<ISFSArray> array_to_sfs_array(const Array &p_array) {
+
+	boost::shared_ptr<SFSArray> result = SFSArray::NewInstance();
+
+	for (int i = 0; i < p_array.size(); i++) {
+		result->AddValue(variant_to_sfs_value(p_array[i]));
+	}
+
+	return result;
+}
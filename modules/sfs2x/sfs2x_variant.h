@@ -0,0 +1,61 @@
+/* sfs2x_variant.h */
+#ifndef SFS2X_VARIANT_H
+#define SFS2X_VARIANT_H
+
+#include "array.h"
+#include "dictionary.h"
+#include "variant.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+
+namespace Sfs2X {
+namespace Entities {
+namespace Data {
+class ISFSObject;
+class ISFSArray;
+class SFSDataWrapper;
+class SFSDataValue;
+} // namespace Data
+} // namespace Entities
+} // namespace Sfs2X
+
+/*
+ * Direct conversion between SFS2X data and Godot variants.
+ *
+ * SFSObject and SFSArray are walked through their SFSDataValue entries and
+ * each value is written straight into the target Variant; outgoing values are
+ * stored the same way, so primitive fields never reach the heap. Other ISFSObject
+ * and ISFSArray implementations go through SFSDataWrapper. Typed SFS arrays map
+ * onto Pool*Array and are filled through a single write lock.
+ *
+ *   SFS                        Godot
+ *   BOOL                       bool
+ *   BYTE / SHORT / INT / LONG  int
+ *   FLOAT / DOUBLE             float
+ *   UTF_STRING / TEXT          String
+ *   BYTE_ARRAY                 PoolByteArray
+ *   SHORT_ARRAY / INT_ARRAY    PoolIntArray
+ *   FLOAT_ARRAY / DOUBLE_ARRAY PoolRealArray
+ *   UTF_STRING_ARRAY           PoolStringArray
+ *   BOOL_ARRAY / LONG_ARRAY    Array
+ *   SFS_ARRAY                  Array
+ *   SFS_OBJECT / CLASS         Dictionary
+ *
+ * In the opposite direction integers are sent as INT when they fit in 32 bits
+ * and as LONG otherwise, floats are sent as DOUBLE.
+ */
+
+Variant sfs_value_to_variant(const Sfs2X::Entities::Data::SFSDataValue &p_value);
+Variant sfs_data_to_variant(const boost::shared_ptr<Sfs2X::Entities::Data::SFSDataWrapper> &p_data);
+Variant sfs_object_field_to_variant(const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_object, const std::string &p_key);
+Dictionary sfs_object_to_dictionary(const boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> &p_object);
+Array sfs_array_to_array(const boost::shared_ptr<Sfs2X::Entities::Data::ISFSArray> &p_array);
+
+Sfs2X::Entities::Data::SFSDataValue variant_to_sfs_value(const Variant &p_value);
+boost::shared_ptr<Sfs2X::Entities::Data::SFSDataWrapper> variant_to_sfs_data(const Variant &p_value);
+boost::shared_ptr<Sfs2X::Entities::Data::ISFSObject> dictionary_to_sfs_object(const Dictionary &p_dictionary);
+boost::shared_ptr<Sfs2X::Entities::Data::ISFSArray> array_to_sfs_array(const Array &p_array);
+
+#endif
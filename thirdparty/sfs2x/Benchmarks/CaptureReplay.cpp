@@ -0,0 +1,458 @@
+// ===================================================================
+//
+// Description
+//		Capture replay: feeds the inbound traffic of a packet capture (see
+//		SmartFox::StartPacketCapture) back through SFSIOHandler::OnDataRead,
+//		SFSProtocolCodec and the controllers of a SmartFox instance that is
+//		never connected, and reports the parse/dispatch cost per message type.
+//
+//		Usage: CaptureReplay <capture file> [options]
+//			--speed original|max|F		replay pacing: capture timestamps, none, or F times faster (max)
+//			--repeat N					replay the capture N times (1)
+//			--chunks					feed the chunks as read from the socket instead of whole packets
+//			--key HEX --iv HEX			session key, to replay the encrypted packets of a capture
+//			--csv						CSV output
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "../SmartFox.h"
+#include "../Core/SFSEvent.h"
+#include "../Core/PacketCapture.h"
+#include "../Core/DefaultPacketEncrypter.h"
+#include "../Entities/Data/SFSObject.h"
+#include "../Util/ByteArray.h"
+#include "../Util/CryptoKey.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Sfs2X;
+using namespace Sfs2X::Core;
+using namespace Sfs2X::Entities::Data;
+using namespace Sfs2X::Util;
+
+typedef boost::chrono::high_resolution_clock ReplayClock;
+
+// -------------------------------------------------------------------
+// Replay settings
+// -------------------------------------------------------------------
+static string fileName;
+static double speed = 1.0;					// 0 replays at maximum speed
+static long int repeat = 1;
+static bool chunks = false;
+static string keyHex;
+static string ivHex;
+static bool csv = false;
+
+static boost::shared_ptr<SmartFox> sfs;
+static boost::shared_ptr<IPacketEncrypter> encrypter;
+static unsigned long long dispatchedEvents = 0;
+
+// Timings of one message type, in nanoseconds
+struct MessageStats
+{
+	vector<long long> durations;
+	unsigned long long bytes;
+};
+
+// -------------------------------------------------------------------
+// SystemActionName
+// -------------------------------------------------------------------
+static const char* SystemActionName(long int action)
+{
+	static const char* names[] = {
+		"Handshake", "Login", "Logout", "GetRoomList", "JoinRoom", "AutoJoin", "CreateRoom", "GenericMessage",
+		"ChangeRoomName", "ChangeRoomPassword", "ObjectMessage", "SetRoomVariables", "SetUserVariables", "CallExtension",
+		"LeaveRoom", "SubscribeRoomGroup", "UnsubscribeRoomGroup", "SpectatorToPlayer", "PlayerToSpectator",
+		"ChangeRoomCapacity", "PublicMessage", "PrivateMessage", "ModeratorMessage", "AdminMessage", "KickUser",
+		"BanUser", "ManualDisconnection", "FindRooms", "FindUsers", "PingPong", "SetUserPosition"
+	};
+
+	if (action >= 0 && action < (long int)(sizeof(names) / sizeof(names[0])))
+	{
+		return names[action];
+	}
+
+	return NULL;
+}
+
+// -------------------------------------------------------------------
+// MessageType
+// -------------------------------------------------------------------
+// Decodes a copy of a framed packet to name its controller and action;
+// extension responses are told apart by their command
+static string MessageType(boost::shared_ptr<vector<unsigned char> > packet)
+{
+	unsigned char headerByte = (*packet)[0];
+	size_t offset = ((headerByte & 0x08) != 0) ? 5 : 3;
+
+	boost::shared_ptr<ByteArray> data (new ByteArray(boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>(packet->begin() + offset, packet->end()))));
+
+	try
+	{
+		if ((headerByte & 0x40) != 0)
+		{
+			if (encrypter == NULL)
+			{
+				return "encrypted";
+			}
+
+			encrypter->Decrypt(data);
+		}
+
+		if ((headerByte & 0x20) != 0)
+		{
+			data->Uncompress();
+		}
+
+		boost::shared_ptr<ISFSObject> message = SFSObject::NewFromBinaryData(data);
+
+		long int controller = *(message->GetByte("c"));
+		long int action = *(message->GetShort("a"));
+
+		char name[64];
+		if (controller == 1)
+		{
+			boost::shared_ptr<ISFSObject> params = message->GetSFSObject("p");
+			boost::shared_ptr<string> cmd = params != NULL ? params->GetUtfString("c") : boost::shared_ptr<string>();
+			return string("extension/") + (cmd != NULL ? *cmd : string("?"));
+		}
+
+		const char* actionName = controller == 0 ? SystemActionName(action) : NULL;
+		if (actionName != NULL)
+		{
+			sprintf(name, "system/%s", actionName);
+		}
+		else
+		{
+			sprintf(name, "%s/%ld", controller == 0 ? "system" : "controller", action);
+		}
+
+		return name;
+	}
+	catch (...)
+	{
+		return "undecodable";
+	}
+}
+
+// -------------------------------------------------------------------
+// ParseHex
+// -------------------------------------------------------------------
+static boost::shared_ptr<ByteArray> ParseHex(const string& text)
+{
+	boost::shared_ptr<vector<unsigned char> > bytes (new vector<unsigned char>());
+
+	for (size_t i = 0; i + 1 < text.size(); i += 2)
+	{
+		bytes->push_back((unsigned char)strtol(text.substr(i, 2).c_str(), NULL, 16));
+	}
+
+	return boost::shared_ptr<ByteArray>(new ByteArray(bytes));
+}
+
+// -------------------------------------------------------------------
+// OnEvent
+// -------------------------------------------------------------------
+static void OnEvent(unsigned long long context, boost::shared_ptr<BaseEvent> e)
+{
+	dispatchedEvents++;
+}
+
+// -------------------------------------------------------------------
+// Setup
+// -------------------------------------------------------------------
+static void Setup()
+{
+	sfs = boost::shared_ptr<SmartFox>(new SmartFox());
+
+	// Registering a listener initializes the API (BitSwarmClient, SFSIOHandler, controllers)
+	boost::shared_ptr<EventListenerDelegate> listener (new EventListenerDelegate(&OnEvent, 0));
+	sfs->AddEventListener(SFSEvent::CONNECTION, listener);
+	sfs->AddEventListener(SFSEvent::LOGIN, listener);
+	sfs->AddEventListener(SFSEvent::LOGIN_ERROR, listener);
+	sfs->AddEventListener(SFSEvent::LOGOUT, listener);
+	sfs->AddEventListener(SFSEvent::ROOM_JOIN, listener);
+	sfs->AddEventListener(SFSEvent::ROOM_JOIN_ERROR, listener);
+	sfs->AddEventListener(SFSEvent::USER_ENTER_ROOM, listener);
+	sfs->AddEventListener(SFSEvent::USER_EXIT_ROOM, listener);
+	sfs->AddEventListener(SFSEvent::PUBLIC_MESSAGE, listener);
+	sfs->AddEventListener(SFSEvent::OBJECT_MESSAGE, listener);
+	sfs->AddEventListener(SFSEvent::EXTENSION_RESPONSE, listener);
+
+	// Dispatch synchronously so that the measured time includes the event delivery
+	sfs->ThreadSafeMode(false);
+
+	if (!keyHex.empty())
+	{
+		boost::shared_ptr<CryptoKey> key (new CryptoKey(ParseHex(ivHex), ParseHex(keyHex)));
+		sfs->BitSwarm()->CryptoKey(key);
+
+		encrypter = boost::shared_ptr<IPacketEncrypter>(new DefaultPacketEncrypter(sfs->BitSwarm()));
+	}
+}
+
+// -------------------------------------------------------------------
+// Teardown
+// -------------------------------------------------------------------
+static void Teardown()
+{
+	encrypter = boost::shared_ptr<IPacketEncrypter>();
+
+	sfs->RemoveAllEventListeners();
+	sfs->Dispose();
+	sfs = boost::shared_ptr<SmartFox>();
+}
+
+// -------------------------------------------------------------------
+// WaitUntil
+// -------------------------------------------------------------------
+// Paces the replay on the capture timestamps, scaled by the speed factor
+static void WaitUntil(ReplayClock::time_point start, long long timestamp)
+{
+	if (speed <= 0)
+	{
+		return;
+	}
+
+	ReplayClock::time_point due = start + boost::chrono::microseconds((long long)(timestamp / speed));
+	if (due > ReplayClock::now())
+	{
+		boost::this_thread::sleep_for(due - ReplayClock::now());
+	}
+}
+
+// -------------------------------------------------------------------
+// Feed
+// -------------------------------------------------------------------
+// Hands one buffer to the reader side of the API and returns the elapsed nanoseconds
+static long long Feed(boost::shared_ptr<vector<unsigned char> > bytes, unsigned long long& errors)
+{
+	boost::shared_ptr<ByteArray> data (new ByteArray(boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>(*bytes))));
+
+	ReplayClock::time_point begin = ReplayClock::now();
+	try
+	{
+		sfs->BitSwarm()->IoHandler()->OnDataRead(data);
+	}
+	catch (...)
+	{
+		errors++;
+	}
+	ReplayClock::time_point end = ReplayClock::now();
+
+	return boost::chrono::duration_cast<boost::chrono::nanoseconds>(end - begin).count();
+}
+
+// -------------------------------------------------------------------
+// Percentile
+// -------------------------------------------------------------------
+static long long Percentile(const vector<long long>& sorted, double percentile)
+{
+	if (sorted.empty()) return 0;
+
+	size_t index = (size_t)(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+	return sorted[index];
+}
+
+// -------------------------------------------------------------------
+// ParseArguments
+// -------------------------------------------------------------------
+static bool ParseArguments(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+
+		if (strcmp(argv[i], "--speed") == 0 && hasValue)
+		{
+			i++;
+			if (strcmp(argv[i], "max") == 0) speed = 0;
+			else if (strcmp(argv[i], "original") == 0) speed = 1.0;
+			else speed = atof(argv[i]);
+
+			if (speed < 0) return false;
+		}
+		else if (strcmp(argv[i], "--repeat") == 0 && hasValue) repeat = atol(argv[++i]);
+		else if (strcmp(argv[i], "--key") == 0 && hasValue) keyHex = argv[++i];
+		else if (strcmp(argv[i], "--iv") == 0 && hasValue) ivHex = argv[++i];
+		else if (strcmp(argv[i], "--chunks") == 0) chunks = true;
+		else if (strcmp(argv[i], "--csv") == 0) csv = true;
+		else if (argv[i][0] != '-' && fileName.empty()) fileName = argv[i];
+		else return false;
+	}
+
+	return !fileName.empty() && repeat > 0 && keyHex.empty() == ivHex.empty();
+}
+
+// -------------------------------------------------------------------
+// main
+// -------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	if (!ParseArguments(argc, argv))
+	{
+		fprintf(stderr, "Usage: %s <capture file> [--speed original|max|F] [--repeat N] [--chunks] [--key HEX --iv HEX] [--csv]\n", argv[0]);
+		return 1;
+	}
+
+	vector<PacketCaptureRecord> records;
+	if (!PacketCapture::Load(fileName, records))
+	{
+		fprintf(stderr, "%s: not a packet capture\n", fileName.c_str());
+		return 1;
+	}
+
+	vector<boost::shared_ptr<vector<unsigned char> > > packets;
+	if (!PacketCapture::SplitPackets(records, PacketCapture::DIRECTION_IN, packets))
+	{
+		fprintf(stderr, "%s: the inbound stream is truncated or not framed as expected, replaying %lu whole packets\n", fileName.c_str(), (unsigned long)packets.size());
+	}
+
+	// Whole packets are paced on the timestamp of the chunk that completed them
+	vector<PacketCaptureRecord> inbound;
+	vector<long long> packetTimestamps;
+	size_t streamBytes = 0;
+	size_t packetBytes = 0;
+	size_t packetIndex = 0;
+	for (size_t i = 0; i < records.size(); i++)
+	{
+		if (records[i].direction != PacketCapture::DIRECTION_IN) continue;
+
+		inbound.push_back(records[i]);
+		streamBytes += records[i].data->size();
+
+		while (packetIndex < packets.size() && packetBytes + packets[packetIndex]->size() <= streamBytes)
+		{
+			packetBytes += packets[packetIndex]->size();
+			packetTimestamps.push_back(records[i].timestamp);
+			packetIndex++;
+		}
+	}
+
+	Setup();
+
+	vector<string> types;
+	size_t encryptedPackets = 0;
+	for (size_t i = 0; i < packets.size(); i++)
+	{
+		types.push_back(MessageType(packets[i]));
+		if (((*packets[i])[0] & 0x40) != 0) encryptedPackets++;
+	}
+
+	// Without the session key the API cannot decrypt, encrypted packets are left out
+	if (encrypter == NULL && encryptedPackets > 0)
+	{
+		if (chunks)
+		{
+			fprintf(stderr, "%s: %lu packets are encrypted, pass --key and --iv to replay the chunks\n", fileName.c_str(), (unsigned long)encryptedPackets);
+			Teardown();
+			return 1;
+		}
+
+		fprintf(stderr, "%s: skipping %lu encrypted packets, pass --key and --iv to replay them\n", fileName.c_str(), (unsigned long)encryptedPackets);
+	}
+
+	map<string, MessageStats> stats;
+	unsigned long long errors = 0;
+	long long totalNs = 0;
+	long long replayed = 0;
+
+	ReplayClock::time_point wallStart = ReplayClock::now();
+
+	for (long int pass = 0; pass < repeat; pass++)
+	{
+		ReplayClock::time_point start = ReplayClock::now();
+
+		if (chunks)
+		{
+			for (size_t i = 0; i < inbound.size(); i++)
+			{
+				WaitUntil(start, inbound[i].timestamp);
+
+				long long ns = Feed(inbound[i].data, errors);
+				MessageStats& entry = stats["chunk"];
+				entry.durations.push_back(ns);
+				entry.bytes += inbound[i].data->size();
+				totalNs += ns;
+				replayed++;
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < packets.size(); i++)
+			{
+				if (encrypter == NULL && types[i] == "encrypted") continue;
+
+				WaitUntil(start, packetTimestamps[i]);
+
+				long long ns = Feed(packets[i], errors);
+				MessageStats& entry = stats[types[i]];
+				entry.durations.push_back(ns);
+				entry.bytes += packets[i]->size();
+				totalNs += ns;
+				replayed++;
+			}
+		}
+	}
+
+	double wallSeconds = boost::chrono::duration_cast<boost::chrono::microseconds>(ReplayClock::now() - wallStart).count() / 1e6;
+
+	if (csv)
+	{
+		printf("type,count,bytes,mean_ns,p50_ns,p99_ns,max_ns\n");
+	}
+	else
+	{
+		printf("Capture              %s: %lu records, %lu inbound packets, %lu outbound records\n", fileName.c_str(),
+			(unsigned long)records.size(), (unsigned long)packets.size(), (unsigned long)(records.size() - inbound.size()));
+		printf("Replayed             %lld %s in %.3f s (%s), %llu events, %llu errors\n", replayed, chunks ? "chunks" : "packets", wallSeconds,
+			speed <= 0 ? "max speed" : (speed == 1.0 ? "original speed" : "scaled speed"), dispatchedEvents, errors);
+		printf("Parse/dispatch       %.1f ns per %s, %.1f messages/s of CPU\n\n", replayed > 0 ? (double)totalNs / replayed : 0, chunks ? "chunk" : "packet",
+			totalNs > 0 ? replayed / (totalNs / 1e9) : 0);
+		printf("%-40s %10s %12s %12s %12s %12s %12s\n", "type", "count", "bytes", "mean ns", "p50 ns", "p99 ns", "max ns");
+	}
+
+	map<string, MessageStats>::iterator iterator;
+	for (iterator = stats.begin(); iterator != stats.end(); ++iterator)
+	{
+		vector<long long>& durations = iterator->second.durations;
+		sort(durations.begin(), durations.end());
+
+		long long sum = 0;
+		for (size_t i = 0; i < durations.size(); i++)
+		{
+			sum += durations[i];
+		}
+
+		double mean = (double)sum / durations.size();
+
+		if (csv)
+		{
+			printf("%s,%lu,%llu,%.1f,%lld,%lld,%lld\n", iterator->first.c_str(), (unsigned long)durations.size(), iterator->second.bytes,
+				mean, Percentile(durations, 50), Percentile(durations, 99), durations.back());
+		}
+		else
+		{
+			printf("%-40s %10lu %12llu %12.1f %12lld %12lld %12lld\n", iterator->first.c_str(), (unsigned long)durations.size(), iterator->second.bytes,
+				mean, Percentile(durations, 50), Percentile(durations, 99), durations.back());
+		}
+	}
+
+	Teardown();
+
+	return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,490 @@
+// ===================================================================
+//
+// Description
+//		End-to-end benchmark: N SmartFox clients connect to a LoopbackServer
+//		(in-process by default), login, join a room, then exchange echo
+//		extension requests. Reports round trip percentiles, messages/sec
+//		and CPU time per message.
+//
+//		Usage: LoopbackBenchmark [options]
+//			--clients N					concurrent clients (10)
+//			--messages N				echo round trips per client (1000)
+//			--window N					requests in flight per client (1)
+//			--payload N					bytes carried by each request (64)
+//			--compression-threshold N	server compression threshold (1024)
+//			--encrypt					encrypt traffic after the handshake
+//			--arena						decode inbound packets into per-packet arenas
+//			--poll						run the clients in poll mode from the main thread
+//			--push-rate N				server pushes per second to each client (0)
+//			--host H --port P			use an external server instead
+//			--server [--port P]			only run the loopback server
+//			--capture FILE				record the traffic of the first client (see CaptureReplay)
+//			--csv						one CSV line instead of the report
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "LoopbackServer.h"
+#include "../SmartFox.h"
+#include "../Core/SFSEvent.h"
+#include "../Requests/ExtensionRequest.h"
+#include "../Requests/JoinRoomRequest.h"
+#include "../Requests/LoginRequest.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Sfs2X;
+using namespace Sfs2X::Benchmarks;
+using namespace Sfs2X::Core;
+using namespace Sfs2X::Requests;
+
+// -------------------------------------------------------------------
+// Benchmark settings
+// -------------------------------------------------------------------
+static long int clientCount = 10;
+static long int messagesPerClient = 1000;
+static long int window = 1;
+static long int payloadSize = 64;
+static long int compressionThreshold = 1024;
+static bool encrypt = false;
+static bool arena = false;
+static bool pollMode = false;
+static long int pushRate = 0;
+static string host = "127.0.0.1";
+static long int port = 0;
+static bool serverOnly = false;
+static bool csv = false;
+static string captureFile;
+
+static boost::shared_ptr<CryptoKey> cryptoKey;
+
+// -------------------------------------------------------------------
+// Class BenchmarkClient
+// -------------------------------------------------------------------
+// One SmartFox instance and its measurements. Events are dispatched
+// synchronously on the API threads (ThreadSafeMode off), so the round trip
+// does not include any polling delay of the application.
+struct BenchmarkClient
+{
+	long int index;
+	boost::shared_ptr<SmartFox> sfs;
+	boost::shared_ptr<ByteArray> payload;
+
+	boost::mutex lock;
+	vector<long long> roundTrips;			// Microseconds
+	vector<long long> pushLatencies;		// Microseconds, server to client
+	long int sent;
+	long int received;
+	bool ready;
+	bool failed;
+};
+
+static vector<boost::shared_ptr<BenchmarkClient> > clients;
+
+// Phase tracking shared by all the clients
+static boost::mutex phaseLock;
+static boost::condition_variable phaseChanged;
+static long int readyClients = 0;
+static long int finishedClients = 0;
+static long int failedClients = 0;
+
+// -------------------------------------------------------------------
+// SignalPhase
+// -------------------------------------------------------------------
+static void SignalPhase(long int& counter)
+{
+	boost::mutex::scoped_lock scoped (phaseLock);
+	counter++;
+	phaseChanged.notify_all();
+}
+
+// -------------------------------------------------------------------
+// PollClients
+// -------------------------------------------------------------------
+// One pass of a game loop: every client runs its network work, a short
+// sleep stands for the rest of the frame when none of them had any
+static void PollClients()
+{
+	long int processed = 0;
+	for (size_t i = 0; i < clients.size(); i++)
+	{
+		processed += clients[i]->sfs->Poll(0);
+	}
+
+	if (processed == 0)
+	{
+		boost::this_thread::sleep(boost::posix_time::microseconds(50));
+	}
+}
+
+// -------------------------------------------------------------------
+// WaitPhase
+// -------------------------------------------------------------------
+static bool WaitPhase(long int& counter, long int target, long int timeoutSeconds)
+{
+	boost::system_time deadline = boost::get_system_time() + boost::posix_time::seconds(timeoutSeconds);
+
+	if (pollMode)
+	{
+		// The clients have no thread of their own: the waiting thread runs them
+		while (boost::get_system_time() < deadline)
+		{
+			{
+				boost::mutex::scoped_lock scoped (phaseLock);
+				if (counter + failedClients >= target) break;
+			}
+
+			PollClients();
+		}
+
+		boost::mutex::scoped_lock scoped (phaseLock);
+		return counter == target;
+	}
+
+	boost::mutex::scoped_lock scoped (phaseLock);
+	while (counter + failedClients < target)
+	{
+		if (!phaseChanged.timed_wait(scoped, deadline)) break;
+	}
+
+	return counter == target;
+}
+
+// -------------------------------------------------------------------
+// SendEcho
+// -------------------------------------------------------------------
+static void SendEcho(BenchmarkClient* client)
+{
+	boost::shared_ptr<ISFSObject> params = SFSObject::NewInstance();
+	params->PutLong("t", LoopbackServer::Now());
+	params->PutInt("s", client->sent);
+	params->PutByteArray("d", client->payload);
+
+	client->sent++;
+	client->sfs->Send(boost::shared_ptr<IRequest>(new ExtensionRequest("echo", params)));
+}
+
+// -------------------------------------------------------------------
+// OnClientEvent
+// -------------------------------------------------------------------
+static void OnClientEvent(unsigned long long context, boost::shared_ptr<BaseEvent> e)
+{
+	BenchmarkClient* client = (BenchmarkClient*)context;
+	boost::shared_ptr<map<string, boost::shared_ptr<void> > > params = e->Params();
+	const string& type = *(e->Type());
+
+	if (type == *SFSEvent::EXTENSION_RESPONSE)
+	{
+		long long now = LoopbackServer::Now();
+		boost::shared_ptr<string> cmd = boost::static_pointer_cast<string>((*params)["cmd"]);
+		boost::shared_ptr<ISFSObject> data = boost::static_pointer_cast<ISFSObject>((*params)["params"]);
+
+		if (*cmd == "push")
+		{
+			boost::mutex::scoped_lock scoped (client->lock);
+			client->pushLatencies.push_back(now - *(data->GetLong("t")));
+			return;
+		}
+
+		bool finished = false;
+		{
+			boost::mutex::scoped_lock scoped (client->lock);
+			client->roundTrips.push_back(now - *(data->GetLong("t")));
+			client->received++;
+
+			if (client->sent < messagesPerClient)
+			{
+				SendEcho(client);
+			}
+
+			finished = client->received == messagesPerClient;
+		}
+
+		if (finished) SignalPhase(finishedClients);
+	}
+	else if (type == *SFSEvent::CONNECTION)
+	{
+		boost::shared_ptr<bool> success = boost::static_pointer_cast<bool>((*params)["success"]);
+		if (success == NULL || !*success)
+		{
+			client->failed = true;
+			SignalPhase(failedClients);
+			return;
+		}
+
+		// The key is normally obtained over HTTPS after the connection; the loopback server shares it upfront
+		if (cryptoKey != NULL)
+		{
+			client->sfs->BitSwarm()->CryptoKey(cryptoKey);
+		}
+
+		char name[32];
+		sprintf(name, "bench_%ld", client->index);
+		client->sfs->Send(boost::shared_ptr<IRequest>(new LoginRequest(name, "", "BenchmarkZone")));
+	}
+	else if (type == *SFSEvent::LOGIN)
+	{
+		client->sfs->Send(boost::shared_ptr<IRequest>(new JoinRoomRequest("BenchmarkRoom")));
+	}
+	else if (type == *SFSEvent::ROOM_JOIN)
+	{
+		client->ready = true;
+		SignalPhase(readyClients);
+	}
+	else if (type == *SFSEvent::LOGIN_ERROR || type == *SFSEvent::ROOM_JOIN_ERROR || type == *SFSEvent::CONNECTION_LOST)
+	{
+		if (!client->failed && client->received < messagesPerClient)
+		{
+			client->failed = true;
+			SignalPhase(failedClients);
+		}
+	}
+}
+
+// -------------------------------------------------------------------
+// Percentile
+// -------------------------------------------------------------------
+static long long Percentile(const vector<long long>& sorted, double percentile)
+{
+	if (sorted.empty()) return 0;
+
+	size_t index = (size_t)(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+	return sorted[index];
+}
+
+// -------------------------------------------------------------------
+// ProcessCpuSeconds
+// -------------------------------------------------------------------
+static double ProcessCpuSeconds()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+
+	return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+// -------------------------------------------------------------------
+// ParseArguments
+// -------------------------------------------------------------------
+static bool ParseArguments(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+
+		if (strcmp(argv[i], "--clients") == 0 && hasValue) clientCount = atol(argv[++i]);
+		else if (strcmp(argv[i], "--messages") == 0 && hasValue) messagesPerClient = atol(argv[++i]);
+		else if (strcmp(argv[i], "--window") == 0 && hasValue) window = atol(argv[++i]);
+		else if (strcmp(argv[i], "--payload") == 0 && hasValue) payloadSize = atol(argv[++i]);
+		else if (strcmp(argv[i], "--compression-threshold") == 0 && hasValue) compressionThreshold = atol(argv[++i]);
+		else if (strcmp(argv[i], "--push-rate") == 0 && hasValue) pushRate = atol(argv[++i]);
+		else if (strcmp(argv[i], "--host") == 0 && hasValue) host = argv[++i];
+		else if (strcmp(argv[i], "--port") == 0 && hasValue) port = atol(argv[++i]);
+		else if (strcmp(argv[i], "--capture") == 0 && hasValue) captureFile = argv[++i];
+		else if (strcmp(argv[i], "--encrypt") == 0) encrypt = true;
+		else if (strcmp(argv[i], "--arena") == 0) arena = true;
+		else if (strcmp(argv[i], "--poll") == 0) pollMode = true;
+		else if (strcmp(argv[i], "--server") == 0) serverOnly = true;
+		else if (strcmp(argv[i], "--csv") == 0) csv = true;
+		else return false;
+	}
+
+	return clientCount > 0 && messagesPerClient > 0 && window > 0 && payloadSize >= 0;
+}
+
+// -------------------------------------------------------------------
+// main
+// -------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	if (!ParseArguments(argc, argv))
+	{
+		fprintf(stderr, "Usage: %s [--clients N] [--messages N] [--window N] [--payload N] [--compression-threshold N]\n"
+			"          [--encrypt] [--arena] [--poll] [--push-rate N] [--host H --port P] [--server] [--capture FILE] [--csv]\n", argv[0]);
+		return 1;
+	}
+
+	if (encrypt)
+	{
+		boost::shared_ptr<vector<unsigned char> > keyBytes (new vector<unsigned char>());
+		boost::shared_ptr<vector<unsigned char> > ivBytes (new vector<unsigned char>());
+		for (unsigned char i = 0; i < 16; i++)
+		{
+			keyBytes->push_back((unsigned char)(i * 17 + 3));
+			ivBytes->push_back((unsigned char)(i * 5 + 1));
+		}
+
+		cryptoKey = boost::shared_ptr<CryptoKey>(new CryptoKey(boost::shared_ptr<ByteArray>(new ByteArray(ivBytes)), boost::shared_ptr<ByteArray>(new ByteArray(keyBytes))));
+	}
+
+	// In-process server, unless an external one was given
+	boost::shared_ptr<LoopbackServer> server;
+	bool externalServer = !serverOnly && port != 0;
+
+	if (!externalServer)
+	{
+		server = boost::shared_ptr<LoopbackServer>(new LoopbackServer((unsigned short int)port, compressionThreshold, cryptoKey));
+		server->PushRate(pushRate);
+		server->Start();
+		port = server->Port();
+	}
+
+	if (serverOnly)
+	{
+		printf("Loopback server listening on 127.0.0.1:%ld, press Enter to stop\n", port);
+		fflush(stdout);
+		getchar();
+
+		server->Stop();
+		printf("Received %lld messages, sent %lld, server CPU %.3f s\n", server->ReceivedMessages(), server->SentMessages(), server->CpuSeconds());
+		return 0;
+	}
+
+	// Clients
+	for (long int i = 0; i < clientCount; i++)
+	{
+		boost::shared_ptr<BenchmarkClient> client (new BenchmarkClient());
+		client->index = i;
+		client->sent = 0;
+		client->received = 0;
+		client->ready = false;
+		client->failed = false;
+		client->roundTrips.reserve(messagesPerClient);
+		client->payload = boost::shared_ptr<ByteArray>(new ByteArray(boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>(payloadSize, (unsigned char)i))));
+
+		client->sfs = boost::shared_ptr<SmartFox>(new SmartFox());
+
+		boost::shared_ptr<EventListenerDelegate> listener (new EventListenerDelegate(&OnClientEvent, (unsigned long long)client.get()));
+		client->sfs->AddEventListener(SFSEvent::CONNECTION, listener);
+		client->sfs->AddEventListener(SFSEvent::CONNECTION_LOST, listener);
+		client->sfs->AddEventListener(SFSEvent::LOGIN, listener);
+		client->sfs->AddEventListener(SFSEvent::LOGIN_ERROR, listener);
+		client->sfs->AddEventListener(SFSEvent::ROOM_JOIN, listener);
+		client->sfs->AddEventListener(SFSEvent::ROOM_JOIN_ERROR, listener);
+		client->sfs->AddEventListener(SFSEvent::EXTENSION_RESPONSE, listener);
+
+		client->sfs->ThreadSafeMode(false);
+		client->sfs->UseBlueBox(false);
+		client->sfs->EnablePacketArena(arena);
+		client->sfs->PollMode(pollMode);
+
+		if (i == 0 && !captureFile.empty() && !client->sfs->StartPacketCapture(captureFile))
+		{
+			fprintf(stderr, "Cannot create the capture file %s\n", captureFile.c_str());
+			return 1;
+		}
+
+		clients.push_back(client);
+	}
+
+	for (long int i = 0; i < clientCount; i++)
+	{
+		clients[i]->sfs->Connect(host, port);
+	}
+
+	if (!WaitPhase(readyClients, clientCount, 30))
+	{
+		fprintf(stderr, "Only %ld of %ld clients joined the benchmark room\n", readyClients, clientCount);
+		return 1;
+	}
+
+	// Measured phase
+	double serverCpuStart = server != NULL ? server->CpuSeconds() : 0;
+	double cpuStart = ProcessCpuSeconds();
+	long long start = LoopbackServer::Now();
+
+	for (long int i = 0; i < clientCount; i++)
+	{
+		boost::mutex::scoped_lock scoped (clients[i]->lock);
+		for (long int j = 0; j < window && clients[i]->sent < messagesPerClient; j++)
+		{
+			SendEcho(clients[i].get());
+		}
+	}
+
+	bool completed = WaitPhase(finishedClients, clientCount, 300);
+
+	long long stop = LoopbackServer::Now();
+	double cpu = ProcessCpuSeconds() - cpuStart;
+	double serverCpu = server != NULL ? server->CpuSeconds() - serverCpuStart : 0;
+
+	// Results
+	vector<long long> roundTrips;
+	vector<long long> pushLatencies;
+	for (long int i = 0; i < clientCount; i++)
+	{
+		boost::mutex::scoped_lock scoped (clients[i]->lock);
+		roundTrips.insert(roundTrips.end(), clients[i]->roundTrips.begin(), clients[i]->roundTrips.end());
+		pushLatencies.insert(pushLatencies.end(), clients[i]->pushLatencies.begin(), clients[i]->pushLatencies.end());
+	}
+
+	sort(roundTrips.begin(), roundTrips.end());
+	sort(pushLatencies.begin(), pushLatencies.end());
+
+	double seconds = (stop - start) / 1e6;
+	long int messages = (long int)roundTrips.size();
+	double messagesPerSecond = seconds > 0 ? messages / seconds : 0;
+	double cpuPerMessage = messages > 0 ? cpu * 1e6 / messages : 0;
+	double serverCpuPerMessage = messages > 0 ? serverCpu * 1e6 / messages : 0;
+
+	if (csv)
+	{
+		printf("clients,messages,window,payload,encrypt,seconds,msg_per_s,rtt_p50_us,rtt_p99_us,rtt_max_us,push_p50_us,push_p99_us,cpu_us_per_msg,client_cpu_us_per_msg\n");
+		printf("%ld,%ld,%ld,%ld,%d,%.3f,%.1f,%lld,%lld,%lld,%lld,%lld,%.1f,%.1f\n",
+			clientCount, messages, window, payloadSize, encrypt ? 1 : 0, seconds, messagesPerSecond,
+			Percentile(roundTrips, 50), Percentile(roundTrips, 99), roundTrips.empty() ? 0LL : roundTrips.back(),
+			Percentile(pushLatencies, 50), Percentile(pushLatencies, 99),
+			cpuPerMessage, cpuPerMessage - serverCpuPerMessage);
+	}
+	else
+	{
+		printf("Clients              %ld (window %ld, payload %ld bytes%s%s)\n", clientCount, window, payloadSize, encrypt ? ", encrypted" : "", pollMode ? ", poll mode" : "");
+		printf("Round trips          %ld in %.3f s, %.1f msg/s\n", messages, seconds, messagesPerSecond);
+		printf("Round trip (us)      p50 %lld  p90 %lld  p99 %lld  max %lld\n",
+			Percentile(roundTrips, 50), Percentile(roundTrips, 90), Percentile(roundTrips, 99), roundTrips.empty() ? 0LL : roundTrips.back());
+		if (!pushLatencies.empty())
+		{
+			printf("Push latency (us)    p50 %lld  p99 %lld  (%lu pushes)\n", Percentile(pushLatencies, 50), Percentile(pushLatencies, 99), (unsigned long)pushLatencies.size());
+		}
+		printf("CPU per message (us) %.1f process", cpuPerMessage);
+		if (server != NULL)
+		{
+			printf(", %.1f clients, %.1f server", cpuPerMessage - serverCpuPerMessage, serverCpuPerMessage);
+		}
+		printf("\n");
+	}
+
+	if (!completed)
+	{
+		fprintf(stderr, "Timed out: %ld of %ld clients completed, %ld failed\n", finishedClients, clientCount, failedClients);
+	}
+
+	for (long int i = 0; i < clientCount; i++)
+	{
+		clients[i]->sfs->RemoveAllEventListeners();
+		clients[i]->sfs->Disconnect();
+		clients[i]->sfs->Dispose();
+	}
+
+	clients.clear();
+
+	if (server != NULL)
+	{
+		server->Stop();
+	}
+
+	return completed ? 0 : 1;
+}
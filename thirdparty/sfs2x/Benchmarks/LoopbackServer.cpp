@@ -0,0 +1,628 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of LoopbackServer
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "LoopbackServer.h"
+#include "../Core/PacketHeader.h"
+#include "../Core/DefaultPacketEncrypter.h"
+#include "../Entities/Data/SFSArray.h"
+#include "../Requests/RequestType.h"
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+
+#include <pthread.h>
+#include <time.h>
+
+namespace Sfs2X {
+namespace Benchmarks {
+
+const long int LoopbackServer::PUSH_INTERVAL_MS = 10;
+
+static const char* ZONE_NAME = "BenchmarkZone";
+static const char* ROOM_NAME = "BenchmarkRoom";
+static const long int ROOM_ID = 1;
+static const long int MAX_MESSAGE_SIZE = 10000000;
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+LoopbackSession::LoopbackSession(LoopbackServer* server, boost::asio::io_service& service, long int id)
+	: socket(service)
+{
+	this->server = server;
+	this->id = id;
+	joined = false;
+	encrypted = false;
+	closed = false;
+	writing = false;
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+LoopbackSession::~LoopbackSession()
+{
+}
+
+// -------------------------------------------------------------------
+// Socket
+// -------------------------------------------------------------------
+tcp::socket& LoopbackSession::Socket()
+{
+	return socket;
+}
+
+// -------------------------------------------------------------------
+// Joined
+// -------------------------------------------------------------------
+bool LoopbackSession::Joined()
+{
+	return joined;
+}
+
+// -------------------------------------------------------------------
+// Start
+// -------------------------------------------------------------------
+void LoopbackSession::Start()
+{
+	boost::system::error_code error;
+	socket.set_option(tcp::no_delay(true), error);
+
+	Read();
+}
+
+// -------------------------------------------------------------------
+// Close
+// -------------------------------------------------------------------
+void LoopbackSession::Close()
+{
+	if (closed) return;
+	closed = true;
+
+	boost::system::error_code error;
+	socket.close(error);
+
+	server->RemoveSession(shared_from_this());
+}
+
+// -------------------------------------------------------------------
+// Read
+// -------------------------------------------------------------------
+void LoopbackSession::Read()
+{
+	socket.async_read_some(boost::asio::buffer(readBuffer, sizeof(readBuffer)),
+		boost::bind(&LoopbackSession::OnRead, shared_from_this(), boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred));
+}
+
+// -------------------------------------------------------------------
+// OnRead
+// -------------------------------------------------------------------
+void LoopbackSession::OnRead(const boost::system::error_code& error, size_t bytesTransferred)
+{
+	if (error)
+	{
+		Close();
+		return;
+	}
+
+	pendingData.insert(pendingData.end(), readBuffer, readBuffer + bytesTransferred);
+
+	try
+	{
+		ReadPackets();
+	}
+	catch (...)
+	{
+		// Malformed traffic: drop the client as the real server does
+		Close();
+		return;
+	}
+
+	if (!closed)
+	{
+		Read();
+	}
+}
+
+// -------------------------------------------------------------------
+// ReadPackets
+// -------------------------------------------------------------------
+void LoopbackSession::ReadPackets()
+{
+	size_t offset = 0;
+
+	while (!closed && pendingData.size() - offset >= 1)
+	{
+		unsigned char headerByte = pendingData[offset];
+		if ((headerByte & 0x80) == 0)
+		{
+			Close();
+			return;
+		}
+
+		boost::shared_ptr<Sfs2X::Core::PacketHeader> header = Sfs2X::Core::PacketHeader::FromBinary(headerByte);
+		size_t sizeBytes = header->BigSized() ? 4 : 2;
+
+		if (pendingData.size() - offset < 1 + sizeBytes) break;
+
+		size_t length = 0;
+		for (size_t i = 0; i < sizeBytes; i++)
+		{
+			length = (length << 8) | pendingData[offset + 1 + i];
+		}
+
+		if (pendingData.size() - offset < 1 + sizeBytes + length) break;
+
+		vector<unsigned char>::iterator begin = pendingData.begin() + offset + 1 + sizeBytes;
+		boost::shared_ptr<ByteArray> data (new ByteArray(boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>(begin, begin + length))));
+		offset += 1 + sizeBytes + length;
+
+		if (header->Encrypted())
+		{
+			if (server->encrypter == NULL)
+			{
+				Close();
+				return;
+			}
+
+			server->encrypter->Decrypt(data);
+			encrypted = true;
+		}
+
+		if (header->Compressed())
+		{
+			data->Uncompress();
+		}
+
+		data->Position(0);
+		HandleMessage(SFSObject::NewFromBinaryData(data));
+	}
+
+	pendingData.erase(pendingData.begin(), pendingData.begin() + offset);
+}
+
+// -------------------------------------------------------------------
+// RoomToArray
+// -------------------------------------------------------------------
+// Room layout expected by SFSRoom::FromSFSArray (regular room, 9 fields)
+boost::shared_ptr<ISFSArray> LoopbackSession::RoomToArray()
+{
+	boost::shared_ptr<ISFSArray> room = SFSArray::NewInstance();
+	room->AddInt(ROOM_ID);
+	room->AddUtfString(string(ROOM_NAME));
+	room->AddUtfString(string("default"));
+	room->AddBool(false);
+	room->AddBool(false);
+	room->AddBool(false);
+	room->AddShort((short int)server->sessions.size());
+	room->AddShort((short int)32767);
+	room->AddSFSArray(SFSArray::NewInstance());
+
+	return room;
+}
+
+// -------------------------------------------------------------------
+// UserToArray
+// -------------------------------------------------------------------
+// User layout expected by SFSUser::FromSFSArray
+boost::shared_ptr<ISFSArray> LoopbackSession::UserToArray()
+{
+	boost::shared_ptr<ISFSArray> user = SFSArray::NewInstance();
+	user->AddInt(id);
+	user->AddUtfString(userName);
+	user->AddShort((short int)0);
+	user->AddShort((short int)0);
+	user->AddSFSArray(SFSArray::NewInstance());
+
+	return user;
+}
+
+// -------------------------------------------------------------------
+// HandleMessage
+// -------------------------------------------------------------------
+void LoopbackSession::HandleMessage(boost::shared_ptr<ISFSObject> message)
+{
+	server->receivedMessages++;
+
+	unsigned char controller = *(message->GetByte("c"));
+	short int action = *(message->GetShort("a"));
+	boost::shared_ptr<ISFSObject> params = message->GetSFSObject("p");
+	boost::shared_ptr<ISFSObject> response = SFSObject::NewInstance();
+
+	// Extension controller: echo
+	if (controller == 1)
+	{
+		boost::shared_ptr<ISFSObject> extensionParams = params->GetSFSObject("p");
+
+		response->PutUtfString("c", params->GetUtfString("c"));
+		response->PutSFSObject("p", extensionParams != NULL ? extensionParams : SFSObject::NewInstance());
+
+		Send(1, action, response);
+		return;
+	}
+
+	switch (action)
+	{
+	case Sfs2X::Requests::RequestType_Handshake:
+		{
+			char token[32];
+			sprintf(token, "loopback%08ld", id);
+			response->PutUtfString("tk", string(token));
+			response->PutInt("ct", server->compressionThreshold);
+			response->PutInt("ms", MAX_MESSAGE_SIZE);
+			Send(0, action, response);
+		}
+		break;
+
+	case Sfs2X::Requests::RequestType_Login:
+		{
+			boost::shared_ptr<string> name = params->GetUtfString("un");
+			if (name != NULL && name->size() > 0)
+			{
+				userName = *name;
+			}
+			else
+			{
+				char guest[32];
+				sprintf(guest, "Guest#%ld", id);
+				userName = guest;
+			}
+
+			boost::shared_ptr<ISFSArray> roomList = SFSArray::NewInstance();
+			roomList->AddSFSArray(RoomToArray());
+
+			response->PutUtfString("zn", string(ZONE_NAME));
+			response->PutUtfString("un", userName);
+			response->PutInt("id", id);
+			response->PutShort("pi", (short int)0);
+			response->PutShort("rs", (short int)0);
+			response->PutSFSArray("rl", roomList);
+			response->PutSFSObject("p", SFSObject::NewInstance());
+			Send(0, action, response);
+		}
+		break;
+
+	case Sfs2X::Requests::RequestType_JoinRoom:
+		{
+			joined = true;
+
+			boost::shared_ptr<ISFSArray> userList = SFSArray::NewInstance();
+			userList->AddSFSArray(UserToArray());
+
+			response->PutSFSArray("r", RoomToArray());
+			response->PutSFSArray("ul", userList);
+			Send(0, action, response);
+		}
+		break;
+
+	case Sfs2X::Requests::RequestType_Logout:
+		joined = false;
+		response->PutUtfString("zn", string(ZONE_NAME));
+		Send(0, action, response);
+		break;
+
+	case Sfs2X::Requests::RequestType_PingPong:
+		Send(0, action, response);
+		break;
+
+	default:
+		// Not needed by the benchmarks: silently ignored
+		break;
+	}
+}
+
+// -------------------------------------------------------------------
+// Send
+// -------------------------------------------------------------------
+void LoopbackSession::Send(unsigned char controller, short int action, boost::shared_ptr<ISFSObject> params)
+{
+	if (closed) return;
+
+	boost::shared_ptr<ISFSObject> message = SFSObject::NewInstance();
+	message->PutByte("c", controller);
+	message->PutShort("a", action);
+	message->PutSFSObject("p", params);
+
+	boost::shared_ptr<ByteArray> binData = message->ToBinary();
+
+	bool compress = binData->Length() > server->compressionThreshold;
+	if (compress)
+	{
+		binData->Compress();
+	}
+
+	bool encrypt = encrypted && server->encrypter != NULL;
+	if (encrypt)
+	{
+		server->encrypter->Encrypt(binData);
+	}
+
+	Sfs2X::Core::PacketHeader header (encrypt, compress, false, binData->Length() > 65535);
+
+	ByteArray framed;
+	framed.WriteByte(header.Encode());
+
+	if (header.BigSized())
+	{
+		framed.WriteInt(binData->Length());
+	}
+	else
+	{
+		framed.WriteUShort((unsigned short int)binData->Length());
+	}
+
+	framed.WriteBytes(binData->Bytes());
+
+	writeQueue.push_back(framed.Bytes());
+	server->sentMessages++;
+
+	if (!writing)
+	{
+		Write();
+	}
+}
+
+// -------------------------------------------------------------------
+// Write
+// -------------------------------------------------------------------
+void LoopbackSession::Write()
+{
+	writing = true;
+
+	boost::asio::async_write(socket, boost::asio::buffer(*(writeQueue.front())),
+		boost::bind(&LoopbackSession::OnWrite, shared_from_this(), boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred));
+}
+
+// -------------------------------------------------------------------
+// OnWrite
+// -------------------------------------------------------------------
+void LoopbackSession::OnWrite(const boost::system::error_code& error, size_t bytesTransferred)
+{
+	writing = false;
+
+	if (error)
+	{
+		Close();
+		return;
+	}
+
+	writeQueue.pop_front();
+
+	if (!writeQueue.empty() && !closed)
+	{
+		Write();
+	}
+}
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+LoopbackServer::LoopbackServer(unsigned short int port, long int compressionThreshold, boost::shared_ptr<CryptoKey> cryptoKey)
+	: acceptor(service, tcp::endpoint(boost::asio::ip::address_v4::loopback(), port)),
+	  pushTimer(service)
+{
+	nextSessionId = 1;
+	this->compressionThreshold = compressionThreshold;
+	pushRate = 0;
+	pushCredit = 0;
+	pushSequence = 0;
+	receivedMessages = 0;
+	sentMessages = 0;
+	stoppedCpuSeconds = 0;
+
+	if (cryptoKey != NULL)
+	{
+		// DefaultPacketEncrypter takes its key from a BitSwarmClient: a detached one is enough
+		boost::shared_ptr<Sfs2X::Bitswarm::BitSwarmClient> keyHolder (new Sfs2X::Bitswarm::BitSwarmClient());
+		keyHolder->CryptoKey(cryptoKey);
+		encrypter = boost::shared_ptr<Sfs2X::Core::IPacketEncrypter>(new Sfs2X::Core::DefaultPacketEncrypter(keyHolder));
+	}
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+LoopbackServer::~LoopbackServer()
+{
+	Stop();
+}
+
+// -------------------------------------------------------------------
+// Port
+// -------------------------------------------------------------------
+unsigned short int LoopbackServer::Port()
+{
+	return acceptor.local_endpoint().port();
+}
+
+// -------------------------------------------------------------------
+// PushRate
+// -------------------------------------------------------------------
+// Must be set before Start
+void LoopbackServer::PushRate(long int messagesPerSecond)
+{
+	pushRate = messagesPerSecond;
+}
+
+// -------------------------------------------------------------------
+// ReceivedMessages
+// -------------------------------------------------------------------
+long long LoopbackServer::ReceivedMessages()
+{
+	return receivedMessages;
+}
+
+// -------------------------------------------------------------------
+// SentMessages
+// -------------------------------------------------------------------
+long long LoopbackServer::SentMessages()
+{
+	return sentMessages;
+}
+
+// -------------------------------------------------------------------
+// Now
+// -------------------------------------------------------------------
+long long LoopbackServer::Now()
+{
+	return boost::chrono::duration_cast<boost::chrono::microseconds>(boost::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// -------------------------------------------------------------------
+// CpuSeconds
+// -------------------------------------------------------------------
+double LoopbackServer::CpuSeconds()
+{
+	if (thread == NULL) return stoppedCpuSeconds;
+
+	clockid_t clock;
+	struct timespec ts;
+	if (pthread_getcpuclockid(thread->native_handle(), &clock) != 0 || clock_gettime(clock, &ts) != 0)
+	{
+		return 0;
+	}
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// -------------------------------------------------------------------
+// Start
+// -------------------------------------------------------------------
+void LoopbackServer::Start()
+{
+	if (thread != NULL) return;
+
+	Accept();
+
+	if (pushRate > 0)
+	{
+		SchedulePush();
+	}
+
+	thread = boost::shared_ptr<boost::thread>(new boost::thread(boost::bind(&LoopbackServer::Run, this)));
+}
+
+// -------------------------------------------------------------------
+// Stop
+// -------------------------------------------------------------------
+void LoopbackServer::Stop()
+{
+	if (thread == NULL) return;
+
+	service.post(boost::bind(&LoopbackServer::DoStop, this));
+	thread->join();
+	thread = boost::shared_ptr<boost::thread>();
+}
+
+// -------------------------------------------------------------------
+// Run
+// -------------------------------------------------------------------
+void LoopbackServer::Run()
+{
+	service.run();
+
+	struct timespec ts;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+	{
+		stoppedCpuSeconds = ts.tv_sec + ts.tv_nsec / 1e9;
+	}
+}
+
+// -------------------------------------------------------------------
+// DoStop
+// -------------------------------------------------------------------
+void LoopbackServer::DoStop()
+{
+	boost::system::error_code error;
+	acceptor.close(error);
+	pushTimer.cancel(error);
+
+	// Close() removes the session from the list
+	while (!sessions.empty())
+	{
+		sessions.front()->Close();
+	}
+}
+
+// -------------------------------------------------------------------
+// Accept
+// -------------------------------------------------------------------
+void LoopbackServer::Accept()
+{
+	boost::shared_ptr<LoopbackSession> session (new LoopbackSession(this, service, nextSessionId++));
+	acceptor.async_accept(session->Socket(), boost::bind(&LoopbackServer::OnAccept, this, session, boost::asio::placeholders::error));
+}
+
+// -------------------------------------------------------------------
+// OnAccept
+// -------------------------------------------------------------------
+void LoopbackServer::OnAccept(boost::shared_ptr<LoopbackSession> session, const boost::system::error_code& error)
+{
+	if (error) return;
+
+	sessions.push_back(session);
+	session->Start();
+
+	Accept();
+}
+
+// -------------------------------------------------------------------
+// RemoveSession
+// -------------------------------------------------------------------
+void LoopbackServer::RemoveSession(boost::shared_ptr<LoopbackSession> session)
+{
+	sessions.remove(session);
+}
+
+// -------------------------------------------------------------------
+// SchedulePush
+// -------------------------------------------------------------------
+void LoopbackServer::SchedulePush()
+{
+	pushTimer.expires_from_now(boost::posix_time::milliseconds(PUSH_INTERVAL_MS));
+	pushTimer.async_wait(boost::bind(&LoopbackServer::OnPush, this, boost::asio::placeholders::error));
+}
+
+// -------------------------------------------------------------------
+// OnPush
+// -------------------------------------------------------------------
+void LoopbackServer::OnPush(const boost::system::error_code& error)
+{
+	if (error) return;
+
+	pushCredit += (double)pushRate * PUSH_INTERVAL_MS / 1000.0;
+	long int count = (long int)pushCredit;
+	pushCredit -= count;
+
+	// Sessions may close while being written to, iterate over a snapshot
+	list<boost::shared_ptr<LoopbackSession> > targets = sessions;
+	for (long int i = 0; i < count; i++)
+	{
+		for (list<boost::shared_ptr<LoopbackSession> >::iterator it = targets.begin(); it != targets.end(); ++it)
+		{
+			if (!(*it)->Joined()) continue;
+
+			boost::shared_ptr<ISFSObject> params = SFSObject::NewInstance();
+			params->PutLong("t", Now());
+			params->PutLong("s", pushSequence++);
+
+			boost::shared_ptr<ISFSObject> response = SFSObject::NewInstance();
+			response->PutUtfString("c", string("push"));
+			response->PutSFSObject("p", params);
+
+			(*it)->Send(1, Sfs2X::Requests::RequestType_CallExtension, response);
+		}
+	}
+
+	SchedulePush();
+}
+
+}	// namespace Benchmarks
+}	// namespace Sfs2X
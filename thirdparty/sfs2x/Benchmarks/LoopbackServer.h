@@ -0,0 +1,197 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of LoopbackServer, a minimal stand-in for
+//		SmartFoxServer 2X used by the end-to-end benchmarks
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __LoopbackServer__
+#define __LoopbackServer__
+
+#include "../Entities/Data/SFSObject.h"
+#include "../Core/IPacketEncrypter.h"
+#include "../Util/ByteArray.h"
+#include "../Util/CryptoKey.h"
+
+#include <boost/shared_ptr.hpp>						// Boost shared pointer
+#include <boost/enable_shared_from_this.hpp>		// Boost shared_ptr for this
+#include <boost/asio.hpp>							// Boost Asio
+#include <boost/thread.hpp>							// Boost thread
+
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Sfs2X::Entities::Data;
+using namespace Sfs2X::Util;
+using boost::asio::ip::tcp;
+
+namespace Sfs2X {
+namespace Benchmarks {
+
+	class LoopbackServer;
+
+	// -------------------------------------------------------------------
+	// Class LoopbackSession
+	// -------------------------------------------------------------------
+	// One client connection: reassembles the BitSwarm framing (header byte,
+	// 2 or 4 bytes size, optionally compressed/encrypted payload) and answers
+	// the handful of requests a benchmark client needs
+	class LoopbackSession : public boost::enable_shared_from_this<LoopbackSession>
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		LoopbackSession(LoopbackServer* server, boost::asio::io_service& service, long int id);
+		virtual ~LoopbackSession();
+
+		tcp::socket& Socket();
+		void Start();
+		void Close();
+
+		/// <summary>
+		/// Frames and queues a server message; must be called from the server thread
+		/// </summary>
+		void Send(unsigned char controller, short int action, boost::shared_ptr<ISFSObject> params);
+
+		bool Joined();
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		void Read();
+		void OnRead(const boost::system::error_code& error, size_t bytesTransferred);
+		void ReadPackets();
+		void HandleMessage(boost::shared_ptr<ISFSObject> message);
+		void Write();
+		void OnWrite(const boost::system::error_code& error, size_t bytesTransferred);
+
+		boost::shared_ptr<ISFSArray> RoomToArray();
+		boost::shared_ptr<ISFSArray> UserToArray();
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		LoopbackServer* server;
+		tcp::socket socket;
+		long int id;
+		string userName;
+		bool joined;
+		bool encrypted;								// Responses are encrypted once the client sent an encrypted packet
+		bool closed;
+
+		unsigned char readBuffer[16384];
+		vector<unsigned char> pendingData;			// Received bytes not yet forming a whole packet
+
+		deque<boost::shared_ptr<vector<unsigned char> > > writeQueue;
+		bool writing;
+	};
+
+	// -------------------------------------------------------------------
+	// Class LoopbackServer
+	// -------------------------------------------------------------------
+	// Listens on localhost and serves handshake, login, join room, logout and
+	// ping requests; extension requests are echoed back as extension responses
+	// with the same command and parameters. All sessions are served by one
+	// thread, whose CPU time is reported separately from the clients'.
+	class LoopbackServer
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		/// <summary>
+		/// Creates a server; port 0 picks an ephemeral port, see <see cref="Port"/>
+		/// </summary>
+		/// <param name="compressionThreshold">Payloads bigger than this are compressed, in both directions</param>
+		/// <param name="cryptoKey">Key used for encrypted packets, or an empty pointer to serve clear traffic only</param>
+		LoopbackServer(unsigned short int port, long int compressionThreshold, boost::shared_ptr<CryptoKey> cryptoKey);
+		virtual ~LoopbackServer();
+
+		void Start();
+		void Stop();
+
+		unsigned short int Port();
+
+		/// <summary>
+		/// Pushes "push" extension responses to every joined session at the given rate (0 disables)
+		/// </summary>
+		/// <remarks>
+		/// Each push carries the server timestamp (key "t", see <see cref="Now"/>) and a sequence number (key "s")
+		/// </remarks>
+		void PushRate(long int messagesPerSecond);
+
+		long long ReceivedMessages();
+		long long SentMessages();
+
+		/// <summary>
+		/// CPU time consumed so far by the server thread, in seconds
+		/// </summary>
+		double CpuSeconds();
+
+		/// <summary>
+		/// Monotonic clock in microseconds shared by the server and the benchmark clients
+		/// </summary>
+		static long long Now();
+
+	private:
+
+		friend class LoopbackSession;
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		void Run();
+		void Accept();
+		void OnAccept(boost::shared_ptr<LoopbackSession> session, const boost::system::error_code& error);
+		void SchedulePush();
+		void OnPush(const boost::system::error_code& error);
+		void DoStop();
+		void RemoveSession(boost::shared_ptr<LoopbackSession> session);
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		static const long int PUSH_INTERVAL_MS;
+
+		boost::asio::io_service service;
+		tcp::acceptor acceptor;
+		boost::asio::deadline_timer pushTimer;
+		boost::shared_ptr<boost::thread> thread;
+
+		list<boost::shared_ptr<LoopbackSession> > sessions;
+		long int nextSessionId;
+
+		long int compressionThreshold;
+		boost::shared_ptr<Sfs2X::Core::IPacketEncrypter> encrypter;
+
+		long int pushRate;
+		double pushCredit;							// Fractional pushes carried over between timer ticks
+		long long pushSequence;
+
+		long long receivedMessages;
+		long long sentMessages;
+		double stoppedCpuSeconds;					// Server thread CPU time, taken when the thread exits
+	};
+
+}	// namespace Benchmarks
+}	// namespace Sfs2X
+
+#endif
@@ -0,0 +1,712 @@
+// ===================================================================
+//
+// Description
+//		Serialization micro-benchmark: measures encode/decode throughput
+//		and heap allocations of representative SFSObject/SFSArray payloads
+//		through DefaultSFSDataSerializer, ByteArray and SFSIOHandler
+//
+//		Usage: SerializationBenchmark [--iterations N] [--filter text] [--csv]
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "../SmartFox.h"
+#include "../Core/SFSEvent.h"
+#include "../Core/PacketHeader.h"
+#include "../Core/DefaultPacketEncrypter.h"
+#include "../Entities/Data/SFSObject.h"
+#include "../Entities/Data/SFSArray.h"
+#include "../Util/ByteArray.h"
+#include "../Util/CryptoKey.h"
+#include "../Util/PacketArena.h"
+#include "../Protocol/Serialization/DefaultSFSDataSerializer.h"
+#include "../Protocol/Serialization/SFSStructCodec.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Sfs2X;
+using namespace Sfs2X::Core;
+using namespace Sfs2X::Entities::Data;
+using namespace Sfs2X::Util;
+using namespace Sfs2X::Protocol::Serialization;
+
+// -------------------------------------------------------------------
+// Allocation counters
+// -------------------------------------------------------------------
+// Every heap allocation of the process goes through the replaced global
+// operators below; the counters are only advanced while a case is measured.
+// API worker threads are idle during the run, so plain counters are enough.
+static bool countAllocations = false;
+static unsigned long long allocationCount = 0;
+static unsigned long long allocationBytes = 0;
+
+// Once these are inlined GCC pairs free() with the operator new call and reports a mismatch
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size)
+{
+	if (countAllocations)
+	{
+		allocationCount++;
+		allocationBytes += size;
+	}
+
+	void* ptr = malloc(size > 0 ? size : 1);
+	if (ptr == NULL) throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) throw()
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr) throw()
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t) throw()
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) throw()
+{
+	free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// -------------------------------------------------------------------
+// Benchmark context
+// -------------------------------------------------------------------
+// Shared fixtures: a SmartFox instance that is never connected provides the
+// BitSwarmClient, the real SFSIOHandler/SFSProtocolCodec pipeline and the
+// controllers; packets fed to OnDataRead end up as EXTENSION_RESPONSE events
+static boost::shared_ptr<SmartFox> sfs;
+static boost::shared_ptr<IPacketEncrypter> encrypter;
+static unsigned long long dispatchedEvents = 0;
+
+// Payload under test, rebuilt by each case before measuring
+static boost::shared_ptr<ISFSObject> payload;
+static boost::shared_ptr<ByteArray> payloadBinary;
+static boost::shared_ptr<ByteArray> payloadCompressed;
+static boost::shared_ptr<ByteArray> payloadEncrypted;
+static ZlibCompressor compressor;		// Kept across iterations, as SFSIOHandler does for a connection
+static boost::shared_ptr<ByteArray> packet;
+
+typedef boost::shared_ptr<ISFSObject> (*PayloadBuilder)();
+typedef void (*BenchmarkBody)();
+
+struct BenchmarkPayload
+{
+	const char* name;
+	PayloadBuilder builder;
+	long int iterations;
+};
+
+struct BenchmarkOperation
+{
+	const char* name;
+	BenchmarkBody body;
+	long int weight;				// Divides the payload iterations for the heavier operations
+};
+
+// A fixed schema gameplay message, encoded by SFSStructCodec or through an SFSObject
+struct PlayerState
+{
+	long int id;
+	unsigned char team;
+	short int health;
+	long long tick;
+	float x;
+	float y;
+	double heading;
+	string name;
+	vector<long int> path;
+
+	SFS_STRUCT_FIELDS("bench.PlayerState")
+		SFS_STRUCT_FIELD(id)
+		SFS_STRUCT_FIELD(team)
+		SFS_STRUCT_FIELD(health)
+		SFS_STRUCT_FIELD(tick)
+		SFS_STRUCT_FIELD(x)
+		SFS_STRUCT_FIELD(y)
+		SFS_STRUCT_FIELD(heading)
+		SFS_STRUCT_FIELD(name)
+		SFS_STRUCT_FIELD(path)
+	SFS_STRUCT_FIELDS_END()
+};
+
+static PlayerState playerState;
+static boost::shared_ptr<ByteArray> playerStateBinary;
+
+// -------------------------------------------------------------------
+// BuildFlat
+// -------------------------------------------------------------------
+// A typical game state update: a couple dozen primitives
+static boost::shared_ptr<ISFSObject> BuildFlat()
+{
+	boost::shared_ptr<ISFSObject> obj = SFSObject::NewInstance();
+
+	char key[16];
+	for (long int i = 0; i < 3; i++)
+	{
+		sprintf(key, "b%ld", i);
+		obj->PutBool(key, (i & 1) != 0);
+		sprintf(key, "y%ld", i);
+		obj->PutByte(key, (unsigned char)i);
+		sprintf(key, "s%ld", i);
+		obj->PutShort(key, (short int)(i * 300));
+		sprintf(key, "i%ld", i);
+		obj->PutInt(key, i * 100000);
+		sprintf(key, "l%ld", i);
+		obj->PutLong(key, i * 10000000000LL);
+		sprintf(key, "f%ld", i);
+		obj->PutFloat(key, i * 0.5f);
+		sprintf(key, "d%ld", i);
+		obj->PutDouble(key, i * 0.25);
+		sprintf(key, "u%ld", i);
+		obj->PutUtfString(key, string("value"));
+	}
+
+	return obj;
+}
+
+// -------------------------------------------------------------------
+// BuildNestedLevel
+// -------------------------------------------------------------------
+static boost::shared_ptr<ISFSObject> BuildNestedLevel(long int depth)
+{
+	boost::shared_ptr<ISFSObject> obj = SFSObject::NewInstance();
+	obj->PutInt("id", depth);
+	obj->PutUtfString("name", string("node"));
+	obj->PutDouble("x", depth * 1.5);
+	obj->PutDouble("y", depth * 2.5);
+
+	if (depth > 0)
+	{
+		boost::shared_ptr<ISFSArray> children = SFSArray::NewInstance();
+		for (long int i = 0; i < 3; i++)
+		{
+			children->AddSFSObject(BuildNestedLevel(depth - 1));
+		}
+
+		obj->PutSFSArray("children", children);
+		obj->PutSFSObject("first", BuildNestedLevel(depth - 1));
+	}
+
+	return obj;
+}
+
+// -------------------------------------------------------------------
+// BuildNested
+// -------------------------------------------------------------------
+// Objects within arrays within objects, four levels deep
+static boost::shared_ptr<ISFSObject> BuildNested()
+{
+	return BuildNestedLevel(4);
+}
+
+// -------------------------------------------------------------------
+// BuildTypedArrays
+// -------------------------------------------------------------------
+// Bulk numeric data (terrain, paths, replays): large typed arrays
+static boost::shared_ptr<ISFSObject> BuildTypedArrays()
+{
+	boost::shared_ptr<ISFSObject> obj = SFSObject::NewInstance();
+
+	boost::shared_ptr<vector<long int> > ints (new vector<long int>());
+	boost::shared_ptr<vector<float> > floats (new vector<float>());
+	boost::shared_ptr<vector<double> > doubles (new vector<double>());
+	boost::shared_ptr<vector<short int> > shorts (new vector<short int>());
+	boost::shared_ptr<vector<unsigned char> > bytes (new vector<unsigned char>());
+
+	for (long int i = 0; i < 4096; i++)
+	{
+		ints->push_back(i * 7);
+		floats->push_back(i * 0.5f);
+		doubles->push_back(i * 0.125);
+		shorts->push_back((short int)(i & 0x7fff));
+	}
+
+	for (long int i = 0; i < 16384; i++)
+	{
+		bytes->push_back((unsigned char)(i * 31));
+	}
+
+	obj->PutIntArray("ints", ints);
+	obj->PutFloatArray("floats", floats);
+	obj->PutDoubleArray("doubles", doubles);
+	obj->PutShortArray("shorts", shorts);
+	obj->PutByteArray("bytes", boost::shared_ptr<ByteArray>(new ByteArray(bytes)));
+
+	return obj;
+}
+
+// -------------------------------------------------------------------
+// BuildUserList
+// -------------------------------------------------------------------
+// A room list / user list update: many small string-heavy objects
+static boost::shared_ptr<ISFSObject> BuildUserList()
+{
+	boost::shared_ptr<ISFSObject> obj = SFSObject::NewInstance();
+	boost::shared_ptr<ISFSArray> users = SFSArray::NewInstance();
+
+	char buffer[64];
+	for (long int i = 0; i < 200; i++)
+	{
+		boost::shared_ptr<ISFSObject> user = SFSObject::NewInstance();
+		user->PutInt("id", i);
+		sprintf(buffer, "player_%04ld", i);
+		user->PutUtfString("name", string(buffer));
+		sprintf(buffer, "Player Number %ld of the Guild", i);
+		user->PutUtfString("nick", string(buffer));
+		user->PutShort("privilege", (short int)(i % 4));
+
+		boost::shared_ptr<vector<string> > tags (new vector<string>());
+		tags->push_back("online");
+		tags->push_back("europe-west");
+		tags->push_back("level-42");
+		user->PutUtfStringArray("tags", tags);
+
+		users->AddSFSObject(user);
+	}
+
+	obj->PutSFSArray("users", users);
+	obj->PutUtfString("room", string("Lobby"));
+
+	return obj;
+}
+
+// -------------------------------------------------------------------
+// FramePacket
+// -------------------------------------------------------------------
+// Wraps the payload as an extension response and frames it the same way
+// SFSIOHandler::OnDataWrite/WriteBinaryData do for the outgoing direction
+static boost::shared_ptr<ByteArray> FramePacket(boost::shared_ptr<ISFSObject> params, bool compress, bool encrypt)
+{
+	boost::shared_ptr<ISFSObject> content = SFSObject::NewInstance();
+	content->PutUtfString("c", string("bench"));
+	content->PutSFSObject("p", params);
+
+	boost::shared_ptr<ISFSObject> message = SFSObject::NewInstance();
+	message->PutByte("c", (unsigned char)1);
+	message->PutShort("a", (short int)13);
+	message->PutSFSObject("p", content);
+
+	boost::shared_ptr<ByteArray> binData = message->ToBinary();
+
+	if (compress) binData->Compress();
+	if (encrypt) encrypter->Encrypt(binData);
+
+	PacketHeader header (encrypt, compress, false, binData->Length() > 65535);
+
+	boost::shared_ptr<ByteArray> framed (new ByteArray());
+	framed->WriteByte(header.Encode());
+
+	if (header.BigSized())
+	{
+		framed->WriteInt(binData->Length());
+	}
+	else
+	{
+		framed->WriteUShort((unsigned short int)binData->Length());
+	}
+
+	framed->WriteBytes(binData->Bytes());
+	framed->Position(0);
+
+	return framed;
+}
+
+// -------------------------------------------------------------------
+// CopyOf
+// -------------------------------------------------------------------
+static boost::shared_ptr<ByteArray> CopyOf(boost::shared_ptr<ByteArray> data)
+{
+	return boost::shared_ptr<ByteArray>(new ByteArray(boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>(*(data->Bytes())))));
+}
+
+// -------------------------------------------------------------------
+// Benchmark bodies
+// -------------------------------------------------------------------
+static void RunEncode()
+{
+	payload->ToBinary();
+}
+
+static void RunDecode()
+{
+	payloadBinary->Position(0);
+	SFSObject::NewFromBinaryData(payloadBinary);
+}
+
+static void RunDecodeArena()
+{
+	// Same chunk sizing as SFSProtocolCodec::OnPacketRead
+	size_t chunkSize = (size_t)payloadBinary->Length() * 4;
+	boost::shared_ptr<PacketArena> arena (new PacketArena(chunkSize < PacketArena::DEFAULT_CHUNK_SIZE ? chunkSize : PacketArena::DEFAULT_CHUNK_SIZE));
+	DefaultSFSDataSerializer::Instance()->Binary2Object(payloadBinary, arena);
+}
+
+static void RunCompress()
+{
+	CopyOf(payloadBinary)->Compress();
+}
+
+static void RunUncompress()
+{
+	CopyOf(payloadCompressed)->Uncompress();
+}
+
+static void RunCompressReuse()
+{
+	CopyOf(payloadBinary)->Compress(compressor);
+}
+
+static void RunUncompressReuse()
+{
+	CopyOf(payloadCompressed)->Uncompress(compressor);
+}
+
+static void RunEncrypt()
+{
+	encrypter->Encrypt(CopyOf(payloadBinary));
+}
+
+static void RunDecrypt()
+{
+	encrypter->Decrypt(CopyOf(payloadEncrypted));
+}
+
+static void RunPacketRead()
+{
+	sfs->BitSwarm()->IoHandler()->OnDataRead(packet);
+}
+
+static void RunStructEncode()
+{
+	SFSStructCodec<PlayerState>::Encode(playerState);
+}
+
+static void RunStructDecode()
+{
+	PlayerState decoded;
+	SFSStructCodec<PlayerState>::Decode(playerStateBinary, decoded);
+}
+
+static void RunStructMapEncode()
+{
+	boost::shared_ptr<ISFSObject> obj = SFSObject::NewInstance();
+	obj->PutInt("id", playerState.id);
+	obj->PutByte("team", playerState.team);
+	obj->PutShort("health", playerState.health);
+	obj->PutLong("tick", playerState.tick);
+	obj->PutFloat("x", playerState.x);
+	obj->PutFloat("y", playerState.y);
+	obj->PutDouble("heading", playerState.heading);
+	obj->PutUtfString("name", playerState.name);
+	obj->PutIntArray("path", boost::shared_ptr<vector<long int> >(new vector<long int>(playerState.path)));
+	obj->ToBinary();
+}
+
+static void RunStructMapDecode()
+{
+	playerStateBinary->Position(0);
+	boost::shared_ptr<ISFSObject> obj = SFSObject::NewFromBinaryData(playerStateBinary);
+
+	PlayerState decoded;
+	decoded.id = obj->GetIntOr("id", 0);
+	decoded.team = obj->GetByteOr("team", 0);
+	decoded.health = obj->GetShortOr("health", 0);
+	decoded.tick = obj->GetLongOr("tick", 0);
+	decoded.x = obj->GetFloatOr("x", 0);
+	decoded.y = obj->GetFloatOr("y", 0);
+	decoded.heading = obj->GetDoubleOr("heading", 0);
+	decoded.name = *(obj->GetUtfString("name"));
+	decoded.path = *(obj->GetIntArray("path"));
+}
+
+static void RunByteArrayPrimitives()
+{
+	ByteArray buffer;
+	for (long int i = 0; i < 256; i++)
+	{
+		buffer.WriteInt(i);
+		buffer.WriteShort((short int)i);
+		buffer.WriteDouble(i * 0.5);
+		buffer.WriteUTF(string("primitive"));
+	}
+
+	buffer.Position(0);
+
+	boost::int32_t intValue;
+	short int shortValue;
+	double doubleValue;
+	string stringValue;
+	for (long int i = 0; i < 256; i++)
+	{
+		buffer.ReadInt(intValue);
+		buffer.ReadShort(shortValue);
+		buffer.ReadDouble(doubleValue);
+		buffer.ReadUTF(stringValue);
+	}
+}
+
+// -------------------------------------------------------------------
+// OnExtensionResponse
+// -------------------------------------------------------------------
+static void OnExtensionResponse(unsigned long long context, boost::shared_ptr<BaseEvent> e)
+{
+	dispatchedEvents++;
+}
+
+// -------------------------------------------------------------------
+// Measure
+// -------------------------------------------------------------------
+static void Measure(const string& name, BenchmarkBody body, long int iterations, long int bytesPerOperation, bool csv)
+{
+	// Warm up caches and lazily created singletons
+	for (long int i = 0; i < iterations / 10 + 1; i++)
+	{
+		body();
+	}
+
+	allocationCount = 0;
+	allocationBytes = 0;
+	countAllocations = true;
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for (long int i = 0; i < iterations; i++)
+	{
+		body();
+	}
+	boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+
+	countAllocations = false;
+
+	double elapsedNs = (double)(stop - start).total_microseconds() * 1000.0;
+	double nsPerOperation = elapsedNs / iterations;
+	double megabytesPerSecond = elapsedNs > 0 ? ((double)bytesPerOperation * iterations / (1024.0 * 1024.0)) / (elapsedNs / 1e9) : 0;
+	double allocationsPerOperation = (double)allocationCount / iterations;
+	double allocatedBytesPerOperation = (double)allocationBytes / iterations;
+
+	if (csv)
+	{
+		printf("%s,%ld,%ld,%.1f,%.2f,%.1f,%.1f\n", name.c_str(), iterations, bytesPerOperation, nsPerOperation, megabytesPerSecond, allocationsPerOperation, allocatedBytesPerOperation);
+	}
+	else
+	{
+		printf("%-44s %10ld %10ld %14.1f %10.2f %12.1f %14.1f\n", name.c_str(), iterations, bytesPerOperation, nsPerOperation, megabytesPerSecond, allocationsPerOperation, allocatedBytesPerOperation);
+	}
+
+	fflush(stdout);
+}
+
+// -------------------------------------------------------------------
+// Setup
+// -------------------------------------------------------------------
+static void Setup()
+{
+	sfs = boost::shared_ptr<SmartFox>(new SmartFox());
+
+	// Registering a listener initializes the API (BitSwarmClient, SFSIOHandler, controllers)
+	sfs->AddEventListener(SFSEvent::EXTENSION_RESPONSE, boost::shared_ptr<EventListenerDelegate>(new EventListenerDelegate(&OnExtensionResponse, 0)));
+
+	// Dispatch synchronously so that the measured time includes the event delivery
+	sfs->ThreadSafeMode(false);
+
+	boost::shared_ptr<vector<unsigned char> > keyBytes (new vector<unsigned char>());
+	boost::shared_ptr<vector<unsigned char> > ivBytes (new vector<unsigned char>());
+	for (unsigned char i = 0; i < 16; i++)
+	{
+		keyBytes->push_back((unsigned char)(i * 17 + 3));
+		ivBytes->push_back((unsigned char)(i * 5 + 1));
+	}
+
+	boost::shared_ptr<CryptoKey> key (new CryptoKey(boost::shared_ptr<ByteArray>(new ByteArray(ivBytes)), boost::shared_ptr<ByteArray>(new ByteArray(keyBytes))));
+	sfs->BitSwarm()->CryptoKey(key);
+
+	encrypter = boost::shared_ptr<IPacketEncrypter>(new DefaultPacketEncrypter(sfs->BitSwarm()));
+}
+
+// -------------------------------------------------------------------
+// Teardown
+// -------------------------------------------------------------------
+static void Teardown()
+{
+	packet = boost::shared_ptr<ByteArray>();
+	payload = boost::shared_ptr<ISFSObject>();
+	encrypter = boost::shared_ptr<IPacketEncrypter>();
+
+	sfs->RemoveAllEventListeners();
+	sfs->Dispose();
+	sfs = boost::shared_ptr<SmartFox>();
+}
+
+// -------------------------------------------------------------------
+// main
+// -------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	long int iterationsOverride = 0;
+	string filter;
+	bool csv = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+		{
+			iterationsOverride = atol(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+		{
+			filter = argv[++i];
+		}
+		else if (strcmp(argv[i], "--csv") == 0)
+		{
+			csv = true;
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [--iterations N] [--filter text] [--csv]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	static const BenchmarkPayload payloads[] = {
+		{ "flat", &BuildFlat, 20000 },
+		{ "nested", &BuildNested, 500 },
+		{ "typed_arrays", &BuildTypedArrays, 500 },
+		{ "user_list", &BuildUserList, 200 },
+	};
+
+	static const BenchmarkOperation operations[] = {
+		{ "encode", &RunEncode, 1 },
+		{ "decode", &RunDecode, 1 },
+		{ "decode_arena", &RunDecodeArena, 1 },
+		{ "compress", &RunCompress, 4 },
+		{ "uncompress", &RunUncompress, 1 },
+		{ "compress_reuse", &RunCompressReuse, 4 },
+		{ "uncompress_reuse", &RunUncompressReuse, 1 },
+		{ "encrypt", &RunEncrypt, 1 },
+		{ "decrypt", &RunDecrypt, 1 },
+	};
+
+	static const struct { const char* name; bool compress; bool encrypt; } packets[] = {
+		{ "packet_read", false, false },
+		{ "packet_read_compressed", true, false },
+		{ "packet_read_encrypted", false, true },
+		{ "packet_read_compressed_encrypted", true, true },
+	};
+
+	Setup();
+
+	if (csv)
+	{
+		printf("case,iterations,payload_bytes,ns_per_op,mb_per_s,allocs_per_op,alloc_bytes_per_op\n");
+	}
+	else
+	{
+		printf("%-44s %10s %10s %14s %10s %12s %14s\n", "case", "iterations", "payload", "ns/op", "MB/s", "allocs/op", "alloc bytes/op");
+	}
+
+	string name = "bytearray/primitives";
+	if (filter.empty() || name.find(filter) != string::npos)
+	{
+		Measure(name, &RunByteArrayPrimitives, iterationsOverride > 0 ? iterationsOverride : 20000, 256 * (4 + 2 + 8 + 2 + 9), csv);
+	}
+
+	static const BenchmarkOperation structOperations[] = {
+		{ "struct/encode", &RunStructEncode, 1 },
+		{ "struct/decode", &RunStructDecode, 1 },
+		{ "struct/sfsobject_encode", &RunStructMapEncode, 1 },
+		{ "struct/sfsobject_decode", &RunStructMapDecode, 1 },
+	};
+
+	playerState.id = 4242;
+	playerState.team = 2;
+	playerState.health = 87;
+	playerState.tick = 123456789LL;
+	playerState.x = 10.5f;
+	playerState.y = -3.25f;
+	playerState.heading = 1.5707963;
+	playerState.name = "player";
+	for (long int i = 0; i < 8; i++)
+	{
+		playerState.path.push_back(i * 16);
+	}
+
+	playerStateBinary = SFSStructCodec<PlayerState>::Encode(playerState);
+
+	for (size_t o = 0; o < sizeof(structOperations) / sizeof(structOperations[0]); o++)
+	{
+		name = structOperations[o].name;
+		if (!filter.empty() && name.find(filter) == string::npos) continue;
+
+		Measure(name, structOperations[o].body, iterationsOverride > 0 ? iterationsOverride : 20000, playerStateBinary->Length(), csv);
+	}
+
+	for (size_t p = 0; p < sizeof(payloads) / sizeof(payloads[0]); p++)
+	{
+		payload = payloads[p].builder();
+		payloadBinary = payload->ToBinary();
+		payloadCompressed = CopyOf(payloadBinary);
+		payloadCompressed->Compress();
+		payloadEncrypted = CopyOf(payloadBinary);
+		encrypter->Encrypt(payloadEncrypted);
+
+		for (size_t o = 0; o < sizeof(operations) / sizeof(operations[0]); o++)
+		{
+			name = string(payloads[p].name) + "/" + operations[o].name;
+			if (!filter.empty() && name.find(filter) == string::npos) continue;
+
+			long int iterations = iterationsOverride > 0 ? iterationsOverride : payloads[p].iterations / operations[o].weight;
+			Measure(name, operations[o].body, iterations > 0 ? iterations : 1, payloadBinary->Length(), csv);
+		}
+
+		for (size_t k = 0; k < sizeof(packets) / sizeof(packets[0]); k++)
+		{
+			name = string(payloads[p].name) + "/" + packets[k].name;
+			if (!filter.empty() && name.find(filter) == string::npos) continue;
+
+			packet = FramePacket(payload, packets[k].compress, packets[k].encrypt);
+
+			unsigned long long eventsBefore = dispatchedEvents;
+			Measure(name, &RunPacketRead, iterationsOverride > 0 ? iterationsOverride : payloads[p].iterations, payloadBinary->Length(), csv);
+
+			if (dispatchedEvents == eventsBefore)
+			{
+				fprintf(stderr, "%s: no event dispatched, the packet was not decoded\n", name.c_str());
+				Teardown();
+				return 1;
+			}
+		}
+	}
+
+	Teardown();
+	return 0;
+}
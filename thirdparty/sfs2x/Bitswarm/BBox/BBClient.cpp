@@ -171,7 +171,7 @@ void BBClient::Connect (boost::shared_ptr<string> host, unsigned short int port)
 	this->port = port;
 
 	char buffer[512];
-	sprintf (buffer, "http://%s:%ld/%s", host->c_str(), port, BB_SERVLET->c_str());
+	sprintf (buffer, "http://%s:%d/%s", host->c_str(), (int)port, BB_SERVLET->c_str());
 
 	bbUrl = boost::shared_ptr<string>(new string(buffer));
 
@@ -237,7 +237,7 @@ void BBClient::OnHttpResponse (unsigned long long context, bool error, boost::sh
 		// Obtain splitted params
 		vector<string> reqBits; 
 
-		int start = 0, end = 0;
+		string::size_type start = 0, end = 0;
 		while ((end = response->find(SEP, start)) != string::npos) 
 		{
 			reqBits.push_back(response->substr(start, end - start));
@@ -297,7 +297,7 @@ void BBClient::OnHttpResponse (unsigned long long context, bool error, boost::sh
 			instance->DispatchEvent(evt);
 			return;
 		}
-	} catch (exception e) {
+	} catch (const exception& e) {
 		//calling e.Result will throw an exception at the local scope when it encouters something like a 404 or a 405
 		boost::shared_ptr<BBEvent> evt (new BBEvent(BBEvent::IO_ERROR));
 		boost::shared_ptr<map<string, boost::shared_ptr<void> > > parameters (new map<string, boost::shared_ptr<void> >());
@@ -495,9 +495,9 @@ boost::shared_ptr<string> BBClient::EncodeRequest (boost::shared_ptr<string> cmd
 	}
 
 	encoded->append((sessId == NULL ? (*BB_NULL) : (*sessId)));
-	encoded->append(&SEP);
+	encoded->push_back(SEP);
 	encoded->append(*cmd);
-	encoded->append(&SEP);
+	encoded->push_back(SEP);
 	encoded->append(*stringData);
 
 	return encoded;
@@ -9,16 +9,19 @@
 //
 // ===================================================================
 #include "BBEvent.h"
+#include "../../Util/KeyTable.h"
+
+using namespace Sfs2X::Util;
 
 namespace Sfs2X {
 namespace Bitswarm {
 namespace BBox {
 
-boost::shared_ptr<string> BBEvent::CONNECT (new string("bb-connect"));
-boost::shared_ptr<string> BBEvent::DISCONNECT (new string("bb-disconnect"));
-boost::shared_ptr<string> BBEvent::DATA (new string("bb-data"));
-boost::shared_ptr<string> BBEvent::IO_ERROR (new string("bb-ioError"));
-boost::shared_ptr<string> BBEvent::SECURITY_ERROR (new string("bb-securityError"));
+boost::shared_ptr<string> BBEvent::CONNECT (KeyTable::Atom("bb-connect"));
+boost::shared_ptr<string> BBEvent::DISCONNECT (KeyTable::Atom("bb-disconnect"));
+boost::shared_ptr<string> BBEvent::DATA (KeyTable::Atom("bb-data"));
+boost::shared_ptr<string> BBEvent::IO_ERROR (KeyTable::Atom("bb-ioError"));
+boost::shared_ptr<string> BBEvent::SECURITY_ERROR (KeyTable::Atom("bb-securityError"));
 
 // -------------------------------------------------------------------
 // Constructor
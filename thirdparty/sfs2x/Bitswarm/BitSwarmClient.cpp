@@ -9,9 +9,12 @@
 //
 // ===================================================================
 #include "BitSwarmClient.h"
+#include "../Core/Sockets/WebSocketLayer.h"
 #include "../Controllers/ExtensionController.h"
 #include "../Controllers/SystemController.h"
 #include "./BBox/BBEvent.h"
+#include "../Exceptions/SFSCodecError.h"
+#include "../Requests/RequestType.h"
 
 namespace Sfs2X {
 namespace Bitswarm {
@@ -23,10 +26,12 @@ BitSwarmClient::BitSwarmClient()
 {
 	sfs = boost::shared_ptr<SmartFox>();
 	socket = boost::shared_ptr<ISocketLayer>();
+	replacedSocket = boost::shared_ptr<ISocketLayer>();
 	controllers.clear();
 	compressionThreshold = 2000000;
 	maxMessageSize = 10000;
 	lastIpAddress = boost::shared_ptr<string>(new string());
+	lastIpAddresses = boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >(new vector<boost::shared_ptr<IPAddress> >());
 	lastTcpPort = 0;
 	reconnectionSeconds = 0;
 	attemptingReconnection = false;
@@ -39,6 +44,8 @@ BitSwarmClient::BitSwarmClient()
 	dispatcher = boost::shared_ptr<EventDispatcher>();
 	bbClient = boost::shared_ptr<BBClient>();
 	useBlueBox = false;
+	useWebSocket = false;
+	useWebSocketSSL = false;
 	bbConnected = false;
 	isDisposed = false;
 	threadManager = boost::shared_ptr<Sfs2X::Core::ThreadManager>(new Sfs2X::Core::ThreadManager());
@@ -47,6 +54,20 @@ BitSwarmClient::BitSwarmClient()
 //	retryTimer = boost::shared_ptr<boost::asio::deadline_timer>(new boost::asio::deadline_timer(*(this->GetBoostService())));
 	io_service_retryTimer = boost::shared_ptr<boost::asio::io_service>(new boost::asio::io_service());
 	retryTimer = boost::shared_ptr<boost::asio::deadline_timer>(new boost::asio::deadline_timer(*io_service_retryTimer));
+	fastReconnection = false;
+	pendingMessagesLimit = 0;
+	pendingMessages = boost::shared_ptr<list<boost::shared_ptr<IMessage> > >(new list<boost::shared_ptr<IMessage> >());
+	reconnectionCount = 0;
+	lastReconnectionTime = 0;
+	totalReconnectionTime = 0;
+	replayedMessages = 0;
+	droppedMessages = 0;
+	replacedMessages = 0;
+	sendHighWatermark = 0;
+	sendLowWatermark = 0;
+	isSendCongested = false;
+	packetCapture = boost::shared_ptr<Sfs2X::Core::PacketCapture>();
+	usePacketArena = false;
 }
 		
 // -------------------------------------------------------------------
@@ -57,10 +78,12 @@ BitSwarmClient::BitSwarmClient(boost::shared_ptr<SmartFox> sfs)
 	this->sfs = sfs;
 	log = sfs->Log();
 	socket = boost::shared_ptr<ISocketLayer>();
+	replacedSocket = boost::shared_ptr<ISocketLayer>();
 	controllers.clear();
 	compressionThreshold = 2000000;
 	maxMessageSize = 10000;
 	lastIpAddress = boost::shared_ptr<string>(new string());
+	lastIpAddresses = boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >(new vector<boost::shared_ptr<IPAddress> >());
 	lastTcpPort = 0;
 	reconnectionSeconds = 0;
 	attemptingReconnection = false;
@@ -71,6 +94,8 @@ BitSwarmClient::BitSwarmClient(boost::shared_ptr<SmartFox> sfs)
 	dispatcher = boost::shared_ptr<EventDispatcher>();
 	bbClient = boost::shared_ptr<BBClient>();
 	useBlueBox = false;
+	useWebSocket = false;
+	useWebSocketSSL = false;
 	bbConnected = false;
 	isDisposed = false;
 	connectionMode = boost::shared_ptr<string>();
@@ -80,6 +105,20 @@ BitSwarmClient::BitSwarmClient(boost::shared_ptr<SmartFox> sfs)
 //	retryTimer = boost::shared_ptr<boost::asio::deadline_timer>(new boost::asio::deadline_timer(*(this->GetBoostService())));
 	io_service_retryTimer = boost::shared_ptr<boost::asio::io_service>(new boost::asio::io_service());
 	retryTimer = boost::shared_ptr<boost::asio::deadline_timer>(new boost::asio::deadline_timer(*io_service_retryTimer));
+	fastReconnection = false;
+	pendingMessagesLimit = 0;
+	pendingMessages = boost::shared_ptr<list<boost::shared_ptr<IMessage> > >(new list<boost::shared_ptr<IMessage> >());
+	reconnectionCount = 0;
+	lastReconnectionTime = 0;
+	totalReconnectionTime = 0;
+	replayedMessages = 0;
+	droppedMessages = 0;
+	replacedMessages = 0;
+	sendHighWatermark = 0;
+	sendLowWatermark = 0;
+	isSendCongested = false;
+	packetCapture = boost::shared_ptr<Sfs2X::Core::PacketCapture>();
+	usePacketArena = false;
 }
 
 // -------------------------------------------------------------------
@@ -136,6 +175,12 @@ void BitSwarmClient::Dispose()
 		socket = boost::shared_ptr<ISocketLayer>();
 	}
 
+	if (replacedSocket != NULL)
+	{
+		replacedSocket->Dispose();
+		replacedSocket = boost::shared_ptr<ISocketLayer>();
+	}
+
 	if (ioHandler != NULL)
 	{
 		ioHandler->Dispose();
@@ -153,6 +198,12 @@ void BitSwarmClient::Dispose()
 		udpManager->Dispose();
 		udpManager = boost::shared_ptr<IUDPManager>();
 	}
+
+	if (packetCapture != NULL)
+	{
+		packetCapture->Close();
+		packetCapture = boost::shared_ptr<Sfs2X::Core::PacketCapture>();
+	}
 }
 
 // -------------------------------------------------------------------
@@ -195,6 +246,14 @@ bool BitSwarmClient::UseBlueBox()
 	return useBlueBox;
 }
 
+// -------------------------------------------------------------------
+// UseWebSocket
+// -------------------------------------------------------------------
+bool BitSwarmClient::UseWebSocket()
+{
+	return useWebSocket;
+}
+
 // -------------------------------------------------------------------
 // Debug
 // -------------------------------------------------------------------
@@ -372,6 +431,225 @@ void BitSwarmClient::ReconnectionSeconds(long int value)
 	reconnectionSeconds = value;
 }
 
+// -------------------------------------------------------------------
+// FastReconnection
+// -------------------------------------------------------------------
+bool BitSwarmClient::FastReconnection()
+{
+	return fastReconnection;
+}
+
+// -------------------------------------------------------------------
+// EnableFastReconnection
+// -------------------------------------------------------------------
+void BitSwarmClient::EnableFastReconnection(bool enabled, long int bufferSize)
+{
+	fastReconnection = enabled;
+	pendingMessagesLimit = bufferSize < 0 ? 0 : bufferSize;
+
+	if (!enabled)
+	{
+		ClearPendingMessages();
+	}
+}
+
+// -------------------------------------------------------------------
+// IsBufferingMessages
+// -------------------------------------------------------------------
+bool BitSwarmClient::IsBufferingMessages()
+{
+	return fastReconnection && attemptingReconnection;
+}
+
+// -------------------------------------------------------------------
+// CompleteReconnection
+// -------------------------------------------------------------------
+void BitSwarmClient::CompleteReconnection()
+{
+	if (!reconnectionStartTime.is_not_a_date_time())
+	{
+		boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::local_time() - reconnectionStartTime;
+		lastReconnectionTime = (long int)elapsed.total_milliseconds();
+		totalReconnectionTime += lastReconnectionTime;
+		reconnectionStartTime = boost::posix_time::ptime();
+	}
+
+	reconnectionCount++;
+
+	// The reconnection window is closed by ReplayMessages, once the buffered messages have been written
+	ReplayMessages();
+}
+
+// -------------------------------------------------------------------
+// ReconnectionCount
+// -------------------------------------------------------------------
+long int BitSwarmClient::ReconnectionCount()
+{
+	return reconnectionCount;
+}
+
+// -------------------------------------------------------------------
+// LastReconnectionTime
+// -------------------------------------------------------------------
+long int BitSwarmClient::LastReconnectionTime()
+{
+	return lastReconnectionTime;
+}
+
+// -------------------------------------------------------------------
+// TotalReconnectionTime
+// -------------------------------------------------------------------
+long int BitSwarmClient::TotalReconnectionTime()
+{
+	return totalReconnectionTime;
+}
+
+// -------------------------------------------------------------------
+// ReplayedMessages
+// -------------------------------------------------------------------
+long int BitSwarmClient::ReplayedMessages()
+{
+	return replayedMessages;
+}
+
+// -------------------------------------------------------------------
+// DroppedMessages
+// -------------------------------------------------------------------
+long int BitSwarmClient::DroppedMessages()
+{
+	return droppedMessages;
+}
+
+// -------------------------------------------------------------------
+// ReplacedMessages
+// -------------------------------------------------------------------
+long int BitSwarmClient::ReplacedMessages()
+{
+	return replacedMessages + ((threadManager != NULL) ? threadManager->ReplacedMessages() : 0);
+}
+
+// -------------------------------------------------------------------
+// PendingSendBytes
+// -------------------------------------------------------------------
+long int BitSwarmClient::PendingSendBytes()
+{
+	long int pending = (threadManager != NULL) ? threadManager->PendingSendBytes() : 0;
+
+	boost::shared_ptr<ISocketLayer> layer = socket;
+	if (layer != NULL)
+	{
+		pending += layer->PendingWriteBytes();
+	}
+
+	return pending;
+}
+
+// -------------------------------------------------------------------
+// SendWatermarks
+// -------------------------------------------------------------------
+void BitSwarmClient::SendWatermarks(long int highWatermark, long int lowWatermark)
+{
+	if (highWatermark > 0 && (lowWatermark < 0 || lowWatermark > highWatermark))
+	{
+		boost::throw_exception(boost::enable_error_info (std::runtime_error("The low send watermark must be between 0 and the high watermark"))); 
+	}
+
+	boost::lock_guard<boost::mutex> lock(lockSendWatermarks);
+
+	sendHighWatermark = highWatermark;
+	sendLowWatermark = lowWatermark;
+	isSendCongested = false;
+}
+
+// -------------------------------------------------------------------
+// SendHighWatermark
+// -------------------------------------------------------------------
+long int BitSwarmClient::SendHighWatermark()
+{
+	return sendHighWatermark;
+}
+
+// -------------------------------------------------------------------
+// SendLowWatermark
+// -------------------------------------------------------------------
+long int BitSwarmClient::SendLowWatermark()
+{
+	return sendLowWatermark;
+}
+
+// -------------------------------------------------------------------
+// CheckSendWatermarks
+// -------------------------------------------------------------------
+void BitSwarmClient::CheckSendWatermarks()
+{
+	if (sendHighWatermark <= 0)
+	{
+		return;
+	}
+
+	boost::shared_ptr<long int> pendingBytes (new long int());
+	boost::shared_ptr<bool> congested (new bool());
+
+	{
+		// The bytes are counted holding the lock, so that a stale count cannot revert a more recent crossing
+		boost::lock_guard<boost::mutex> lock(lockSendWatermarks);
+
+		*pendingBytes = PendingSendBytes();
+
+		if (isSendCongested == false && *pendingBytes >= sendHighWatermark)
+		{
+			isSendCongested = true;
+		}
+		else if (isSendCongested == true && *pendingBytes <= sendLowWatermark)
+		{
+			isSendCongested = false;
+		}
+		else
+		{
+			return;
+		}
+
+		*congested = isSendCongested;
+	}
+
+	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
+	evtParams->insert(pair<string, boost::shared_ptr<void> >("congested", congested));
+	evtParams->insert(pair<string, boost::shared_ptr<void> >("pendingBytes", pendingBytes));
+
+	boost::shared_ptr<SFSEvent> evt (new SFSEvent(SFSEvent::OUTBOUND_CONGESTION, evtParams));
+	sfs->DispatchEvent(evt);
+}
+
+// -------------------------------------------------------------------
+// ResetSendCongestion
+// -------------------------------------------------------------------
+void BitSwarmClient::ResetSendCongestion()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(lockSendWatermarks);
+
+		if (isSendCongested == false)
+		{
+			return;
+		}
+
+		isSendCongested = false;
+	}
+
+	boost::shared_ptr<long int> pendingBytes (new long int());
+	*pendingBytes = PendingSendBytes();
+
+	boost::shared_ptr<bool> congested (new bool());
+	*congested = false;
+
+	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
+	evtParams->insert(pair<string, boost::shared_ptr<void> >("congested", congested));
+	evtParams->insert(pair<string, boost::shared_ptr<void> >("pendingBytes", pendingBytes));
+
+	boost::shared_ptr<SFSEvent> evt (new SFSEvent(SFSEvent::OUTBOUND_CONGESTION, evtParams));
+	sfs->DispatchEvent(evt);
+}
+
 // -------------------------------------------------------------------
 // Dispatcher
 // -------------------------------------------------------------------
@@ -419,6 +697,38 @@ void BitSwarmClient::CryptoKey(boost::shared_ptr<Sfs2X::Util::CryptoKey> value)
 	cryptoKey = value;
 }
 
+// -------------------------------------------------------------------
+// PacketCapture
+// -------------------------------------------------------------------
+boost::shared_ptr<Sfs2X::Core::PacketCapture> BitSwarmClient::PacketCapture()
+{
+	return packetCapture;
+}
+
+// -------------------------------------------------------------------
+// PacketCapture
+// -------------------------------------------------------------------
+void BitSwarmClient::PacketCapture(boost::shared_ptr<Sfs2X::Core::PacketCapture> value)
+{
+	packetCapture = value;
+}
+
+// -------------------------------------------------------------------
+// UsePacketArena
+// -------------------------------------------------------------------
+bool BitSwarmClient::UsePacketArena()
+{
+	return usePacketArena;
+}
+
+// -------------------------------------------------------------------
+// UsePacketArena
+// -------------------------------------------------------------------
+void BitSwarmClient::UsePacketArena(bool value)
+{
+	usePacketArena = value;
+}
+
 // -------------------------------------------------------------------
 // ForceBlueBox
 // -------------------------------------------------------------------
@@ -435,6 +745,97 @@ void BitSwarmClient::ForceBlueBox(bool val)
 	}
 }
 
+// -------------------------------------------------------------------
+// ForceWebSocket
+// -------------------------------------------------------------------
+void BitSwarmClient::ForceWebSocket(bool val, bool useSSL)
+{
+	ForceWebSocket(val, useSSL, string());
+}
+
+// -------------------------------------------------------------------
+// ForceWebSocket
+// -------------------------------------------------------------------
+void BitSwarmClient::ForceWebSocket(bool val, bool useSSL, const string& host)
+{
+	if ((socket != NULL) && (socket->IsConnected()))
+	{
+		boost::throw_exception(boost::enable_error_info (std::runtime_error("You can't change the WebSocket mode while the connection is running"))); 
+	}
+
+	useWebSocket = val;
+	useWebSocketSSL = useSSL;
+	webSocketHost = host;
+}
+
+// -------------------------------------------------------------------
+// PollMode
+// -------------------------------------------------------------------
+bool BitSwarmClient::PollMode()
+{
+	return threadManager->PollMode();
+}
+
+// -------------------------------------------------------------------
+// PollMode
+// -------------------------------------------------------------------
+void BitSwarmClient::PollMode(bool value)
+{
+	if ((socket != NULL) && (socket->IsConnected()))
+	{
+		boost::throw_exception(boost::enable_error_info (std::runtime_error("You can't change the poll mode while the connection is running"))); 
+	}
+
+	threadManager->PollMode(value);
+
+	// A reconnection attempt must not block the caller of Poll, so its timer runs on the polled service
+	retryTimer->cancel();
+	retryTimer = boost::shared_ptr<boost::asio::deadline_timer>(new boost::asio::deadline_timer(value == true ? *GetBoostService() : *io_service_retryTimer));
+}
+
+// -------------------------------------------------------------------
+// Poll
+// -------------------------------------------------------------------
+long int BitSwarmClient::Poll(long int timeout)
+{
+	boost::shared_ptr<boost::asio::io_service> service = GetBoostService();
+
+	// Connection results and errors queued by the previous completions
+	long int processed = threadManager->Poll();
+
+	// The service stops whenever it runs out of work, e.g. before the first connection
+	service->reset();
+	processed += (long int)service->poll();
+
+	if (processed == 0 && timeout > 0)
+	{
+		// Nothing was ready: wait for the first completion or the timeout, whichever comes first
+		boost::asio::deadline_timer timer(*service);
+		timer.expires_from_now(boost::posix_time::milliseconds(timeout));
+		timer.async_wait(&BitSwarmClient::OnPollTimeout);
+
+		processed += (long int)service->run_one();
+		timer.cancel();
+
+		service->reset();
+		processed += (long int)service->poll();
+
+		// Either run_one or the last poll has run the handler of the timer
+		processed--;
+	}
+
+	processed += threadManager->Poll();
+
+	return processed;
+}
+
+// -------------------------------------------------------------------
+// OnPollTimeout
+// -------------------------------------------------------------------
+void BitSwarmClient::OnPollTimeout(const boost::system::error_code& code)
+{
+}
+
 // -------------------------------------------------------------------
 // EnableBlueBoxDebug
 // -------------------------------------------------------------------
@@ -463,7 +864,62 @@ void BitSwarmClient::Init()
 
 	if (socket != NULL) return; // Don't init the socket layer if it's already initialized
 		
-	socket = boost::shared_ptr<ISocketLayer>(new TCPSocketLayer(shared_from_this()));
+	InitSocket();
+
+	bbClient = boost::shared_ptr<BBClient>(new BBClient(shared_from_this()));
+	bbClient->Initialize();
+
+	bbClient->AddEventListener(BBEvent::CONNECT, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBConnect, (unsigned long long)this)));
+	bbClient->AddEventListener(BBEvent::DATA, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBData, (unsigned long long)this)));
+	bbClient->AddEventListener(BBEvent::DISCONNECT, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBDisconnect, (unsigned long long)this)));
+	bbClient->AddEventListener(BBEvent::IO_ERROR, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBError, (unsigned long long)this)));
+	bbClient->AddEventListener(BBEvent::SECURITY_ERROR, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBError, (unsigned long long)this)));
+
+	threadManager->Start();
+}
+
+// -------------------------------------------------------------------
+// InitSocket
+// -------------------------------------------------------------------
+void BitSwarmClient::InitSocket()
+{
+	// The socket layer is replaced only when the requested transport differs from the current one
+	boost::shared_ptr<WebSocketLayer> webSocket = boost::dynamic_pointer_cast<WebSocketLayer>(socket);
+
+	if (socket != NULL)
+	{
+		if (useWebSocket == true && webSocket != NULL && webSocket->UseSSL() == useWebSocketSSL && webSocket->Host() == webSocketHost)
+		{
+			return;
+		}
+
+		if (useWebSocket == false && webSocket == NULL)
+		{
+			return;
+		}
+
+		socket->OnConnect(boost::shared_ptr<ConnectionDelegate>());
+		socket->OnDisconnect(boost::shared_ptr<ConnectionDelegate>());
+		socket->OnData(boost::shared_ptr<OnDataDelegate>());
+		socket->OnError(boost::shared_ptr<OnErrorDelegate>());
+
+		// The transport is usually switched from the error callback of the current layer, that cannot be disposed under its own feet
+		if (replacedSocket != NULL)
+		{
+			replacedSocket->Dispose();
+		}
+
+		replacedSocket = socket;
+	}
+
+	if (useWebSocket == true)
+	{
+		socket = boost::shared_ptr<ISocketLayer>(new WebSocketLayer(shared_from_this(), useWebSocketSSL, webSocketHost));
+	}
+	else
+	{
+		socket = boost::shared_ptr<ISocketLayer>(new TCPSocketLayer(shared_from_this()));
+	}
 
 	boost::shared_ptr<ConnectionDelegate> delegateConnection (new ConnectionDelegate(&BitSwarmClient::OnSocketConnect, (unsigned long long)this));
 	socket->OnConnect(delegateConnection);
@@ -476,17 +932,6 @@ void BitSwarmClient::Init()
 
 	boost::shared_ptr<OnErrorDelegate> delegateOnError (new OnErrorDelegate(&BitSwarmClient::OnSocketError, (unsigned long long)this));
 	socket->OnError(delegateOnError); 
-
-	bbClient = boost::shared_ptr<BBClient>(new BBClient(shared_from_this()));
-	bbClient->Initialize();
-
-	bbClient->AddEventListener(BBEvent::CONNECT, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBConnect, (unsigned long long)this)));
-	bbClient->AddEventListener(BBEvent::DATA, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBData, (unsigned long long)this)));
-	bbClient->AddEventListener(BBEvent::DISCONNECT, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBDisconnect, (unsigned long long)this)));
-	bbClient->AddEventListener(BBEvent::IO_ERROR, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBError, (unsigned long long)this)));
-	bbClient->AddEventListener(BBEvent::SECURITY_ERROR, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(&BitSwarmClient::OnBBError, (unsigned long long)this)));
-
-	threadManager->Start();
 }
 
 // -------------------------------------------------------------------
@@ -598,7 +1043,20 @@ void BitSwarmClient::Connect()
 // -------------------------------------------------------------------
 void BitSwarmClient::Connect(boost::shared_ptr<string> ip, unsigned short int port)
 {
-	lastIpAddress = ip;
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ips (new vector<boost::shared_ptr<IPAddress> >());
+	ips->push_back(boost::shared_ptr<IPAddress>(new IPAddress(*ip)));
+
+	Connect(ips, port);
+}
+
+// -------------------------------------------------------------------
+// Connect
+// -------------------------------------------------------------------
+void BitSwarmClient::Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ips, unsigned short int port)
+{
+	// The preferred address is the one reported and used by BlueBox, the socket attempts all of them
+	lastIpAddress = boost::shared_ptr<string>(new string(*(ips->front()->Address())));
+	lastIpAddresses = ips;
 	lastTcpPort = port;
 
 	threadManager->Start();
@@ -607,13 +1065,15 @@ void BitSwarmClient::Connect(boost::shared_ptr<string> ip, unsigned short int po
 	{
 		connectionMode = ConnectionModes::HTTP;
 		bbClient->PollSpeed((sfs->Config() != NULL) ? sfs->Config()->BlueBoxPollingRate() : 750);
-		bbClient->Connect(ip, port);
+		bbClient->Connect(lastIpAddress, port);
 	} 
 	else 
 	{
-		boost::shared_ptr<IPAddress> address(new IPAddress(*lastIpAddress));
-		socket->Connect(address, lastTcpPort);
-		connectionMode = ConnectionModes::SOCKET;
+		// The transport may have changed since the previous connection, e.g. when falling back to the WebSocket
+		InitSocket();
+
+		socket->Connect(lastIpAddresses, lastTcpPort);
+		connectionMode = (useWebSocket == true) ? ConnectionModes::WEBSOCKET : ConnectionModes::SOCKET;
 	}
 }
 
@@ -622,7 +1082,135 @@ void BitSwarmClient::Connect(boost::shared_ptr<string> ip, unsigned short int po
 // -------------------------------------------------------------------
 void BitSwarmClient::Send(boost::shared_ptr<IMessage> message)
 {
+	// While the session is being resumed only the reconnection handshake can reach the server,
+	// everything else is held and replayed once the server has accepted the reconnection token
+	// The check and the enqueue are done under the same lock that ReplayMessages holds while draining the buffer,
+	// so a message can neither overtake the replayed ones nor be buffered after the buffer has been drained
+	lockPendingMessages.lock();
+
+	if (IsBufferingMessages() && !IsHandshake(message))
+	{
+		BufferMessage(message);
+		lockPendingMessages.unlock();
+		return;
+	}
+
+	lockPendingMessages.unlock();
+
 	ioHandler->Codec()->OnPacketWrite(message);
+
+	CheckSendWatermarks();
+}
+
+// -------------------------------------------------------------------
+// IsHandshake
+// -------------------------------------------------------------------
+bool BitSwarmClient::IsHandshake(boost::shared_ptr<IMessage> message)
+{
+	return message->TargetController() == 0 && message->Id() == Sfs2X::Requests::RequestType_Handshake;
+}
+
+// -------------------------------------------------------------------
+// BufferMessage
+// -------------------------------------------------------------------
+void BitSwarmClient::BufferMessage(boost::shared_ptr<IMessage> message)
+{
+	lockPendingMessages.lock();
+
+	// Only the latest value of a state is worth replaying: the one buffered with the same key is dropped,
+	// and the new one is buffered at the tail, after the messages sent since the dropped one
+	if (message->ReplacementKey() != NULL)
+	{
+		list<boost::shared_ptr<IMessage> >::iterator iterator;
+		for (iterator = pendingMessages->begin(); iterator != pendingMessages->end(); ++iterator)
+		{
+			if ((*iterator)->ReplacementKey() != NULL && *((*iterator)->ReplacementKey()) == *(message->ReplacementKey()))
+			{
+				pendingMessages->erase(iterator);
+				replacedMessages++;
+				break;
+			}
+		}
+	}
+
+	if ((long int)pendingMessages->size() >= pendingMessagesLimit)
+	{
+		droppedMessages++;
+		lockPendingMessages.unlock();
+
+		char buffer[512];
+		sprintf (buffer, "Reconnection buffer is full (%ld messages), message %ld has been dropped", pendingMessagesLimit, message->Id());
+		string logMessage = buffer;
+
+		boost::shared_ptr<vector<string> > logMessages (new vector<string>());
+		logMessages->push_back(logMessage);
+		Log()->Warn(logMessages);
+
+		return;
+	}
+
+	pendingMessages->push_back(message);
+
+	lockPendingMessages.unlock();
+}
+
+// -------------------------------------------------------------------
+// ReplayMessages
+// -------------------------------------------------------------------
+void BitSwarmClient::ReplayMessages()
+{
+	// The lock is held until the buffer has been drained and the reconnection window closed:
+	// concurrent Send calls wait here and are written after the replayed messages
+	lockPendingMessages.lock();
+
+	if (fastReconnection)
+	{
+		char buffer[512];
+		sprintf (buffer, "Session resumed in %ld ms, replaying %ld pending messages", lastReconnectionTime, (long int)pendingMessages->size());
+		string logMessage = buffer;
+
+		boost::shared_ptr<vector<string> > logMessages (new vector<string>());
+		logMessages->push_back(logMessage);
+		Log()->Debug(logMessages);
+	}
+
+	boost::shared_ptr<list<boost::shared_ptr<IMessage> > > messages = pendingMessages;
+	pendingMessages = boost::shared_ptr<list<boost::shared_ptr<IMessage> > >(new list<boost::shared_ptr<IMessage> >());
+
+	list<boost::shared_ptr<IMessage> >::iterator iterator;
+	for (iterator = messages->begin(); iterator != messages->end(); iterator++)
+	{
+		try
+		{
+			ioHandler->Codec()->OnPacketWrite(*iterator);
+			replayedMessages++;
+		}
+		catch (boost::shared_ptr<SFSCodecError> error)
+		{
+			droppedMessages++;
+
+			boost::shared_ptr<vector<string> > logMessages (new vector<string>());
+			logMessages->push_back(*(error->Message()));
+			Log()->Warn(logMessages);
+		}
+	}
+
+	attemptingReconnection = false;
+
+	lockPendingMessages.unlock();
+
+	CheckSendWatermarks();
+}
+
+// -------------------------------------------------------------------
+// ClearPendingMessages
+// -------------------------------------------------------------------
+void BitSwarmClient::ClearPendingMessages()
+{
+	lockPendingMessages.lock();
+	droppedMessages += (long int)pendingMessages->size();
+	pendingMessages->clear();
+	lockPendingMessages.unlock();
 }
 
 // -------------------------------------------------------------------
@@ -731,6 +1319,12 @@ void BitSwarmClient::OnSocketClose(unsigned long long context)
 		return;
 	}
 
+	// Nothing will be written on the closed connection: an application throttled by the congestion can stop waiting
+	if (instance->sfs != NULL)
+	{
+		instance->ResetSendCongestion();
+	}
+
 	bool isRegularDisconnection = instance->sfs==NULL || (!instance->attemptingReconnection && instance->sfs->GetReconnectionSeconds() == 0);
 	//bool isManualDisconnection = (evt!=null) && (string)evt.Params["reason"] == ClientDisconnectionReason.MANUAL;
 	bool isManualDisconnection = instance->manualDisconnection;
@@ -777,7 +1371,14 @@ void BitSwarmClient::OnSocketClose(unsigned long long context)
 	}
 
 	char buffer[512];
-	sprintf (buffer, "Attempting reconnection in %ld sec", instance->ReconnectionSeconds());
+	if (instance->fastReconnection)
+	{
+		sprintf (buffer, "Attempting fast reconnection");
+	}
+	else
+	{
+		sprintf (buffer, "Attempting reconnection in %ld sec", instance->ReconnectionSeconds());
+	}
 	string logMessage = buffer;
 
 	boost::shared_ptr<vector<string> > logMessages (new vector<string>());
@@ -793,14 +1394,16 @@ void BitSwarmClient::OnSocketClose(unsigned long long context)
 		* reconnection to the server.
 		*/
 		instance->attemptingReconnection = true;
+		instance->reconnectionStartTime = boost::posix_time::microsec_clock::local_time();
 
 		// Fire event and retry
 		boost::shared_ptr<BitSwarmEvent> evt (new BitSwarmEvent(BitSwarmEvent::RECONNECTION_TRY));
 		instance->DispatchEvent(evt);
 
 		// Retry connection: pause n seconds and retry
+		// In fast reconnection mode the socket is reopened straight away, without blocking this thread on the retry timer
 		// instance->RetryConnection(instance->ReconnectionSeconds()/**1000*/);
-		instance->RetryConnection(1);
+		instance->RetryConnection(instance->fastReconnection ? 0 : 1);
 	}
 
 	instance->lockDispose.unlock();
@@ -811,7 +1414,11 @@ void BitSwarmClient::OnSocketClose(unsigned long long context)
 // -------------------------------------------------------------------
 void BitSwarmClient::StopReconnection() 
 {
+	lockPendingMessages.lock();
 	attemptingReconnection = false;
+	reconnectionStartTime = boost::posix_time::ptime();
+	ClearPendingMessages();
+	lockPendingMessages.unlock();
 	//firstReconnAttempt = DateTime.MinValue;
 			
 	if (socket->IsConnected()) 
@@ -860,8 +1467,22 @@ void BitSwarmClient::ReleaseResources()
 // -------------------------------------------------------------------
 void BitSwarmClient::RetryConnection(long int timeout)
 {
+	if (timeout <= 0)
+	{
+		OnRetryConnectionEvent(boost::system::error_code());
+		return;
+	}
+
 	// Start deadline timer for tcp connection task
     retryTimer->expires_from_now(boost::posix_time::seconds(timeout));
+
+	if (PollMode() == true)
+	{
+		// The timer expires in a later Poll
+		retryTimer->async_wait(boost::bind(&BitSwarmClient::OnRetryConnectionEvent, this, boost::asio::placeholders::error));
+		return;
+	}
+
 //	retryTimer->async_wait(boost::bind(&BitSwarmClient::OnRetryConnectionEvent, this, boost::asio::placeholders::error));
 	io_service_retryTimer->reset();
 	retryTimer->async_wait(boost::bind(&BitSwarmClient::OnRetryConnectionEvent, this, boost::asio::placeholders::error));
@@ -887,8 +1508,7 @@ void BitSwarmClient::OnRetryConnectionEvent(const boost::system::error_code& cod
 		socket->Disconnect();
     }
 
-	boost::shared_ptr<IPAddress> address(new IPAddress(*lastIpAddress));
-	socket->Connect(address, lastTcpPort);
+	socket->Connect(lastIpAddresses, lastTcpPort);
 }
 
 // -------------------------------------------------------------------
@@ -915,7 +1535,7 @@ void BitSwarmClient::OnSocketData(unsigned long long context, boost::shared_ptr<
 		boost::shared_ptr<ByteArray> buffer (new ByteArray(data));
 		instance->ioHandler->OnDataRead(buffer);
 	}
-	catch (exception e) 
+	catch (const exception& e) 
 	{
 		boost::shared_ptr<string> message (new string(e.what()));
 
@@ -959,7 +1579,7 @@ void BitSwarmClient::OnSocketError(unsigned long long context, boost::shared_ptr
 	char buffer[1024];
 	if (se != SocketErrors_NotSocket)
 	{
-		sprintf (buffer, "%s [%ld]", message->c_str(), se);
+		sprintf (buffer, "%s [%d]", message->c_str(), (int)se);
 	}
 	else
 	{
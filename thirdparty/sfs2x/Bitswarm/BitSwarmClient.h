@@ -34,8 +34,11 @@ namespace Bitswarm {
 #include "../Util/ClientDisconnectionReason.h"
 #include "../Exceptions/SFSError.h"
 #include "../Util/CryptoKey.h"
+#include "../Core/PacketCapture.h"
 
 #include <boost/asio/deadline_timer.hpp>		// Boost Asio header
+#include <boost/date_time/posix_time/posix_time.hpp>	// Boost posix time
+#include <boost/thread/recursive_mutex.hpp>		// Boost recursive mutex
 #include <boost/shared_ptr.hpp>					// Boost Asio shared pointer
 #include <boost/enable_shared_from_this.hpp>	// Boost shared_ptr for this
 
@@ -45,6 +48,7 @@ namespace Bitswarm {
 #include <string>						// STL library: string object
 #include <map>							// STL library: map object
 #include <vector>						// STL library: vector object
+#include <list>							// STL library: list object
 using namespace std;					// STL library: declare the STL namespace
 
 using namespace Sfs2X;
@@ -79,6 +83,7 @@ namespace Bitswarm {
 		boost::shared_ptr<Sfs2X::Core::ThreadManager> ThreadManager();
 		boost::shared_ptr<string> ConnectionMode();
 		bool UseBlueBox();
+		bool UseWebSocket();
 		bool Debug();
 		boost::shared_ptr<SmartFox> Sfs();
 		bool Connected();
@@ -94,11 +99,36 @@ namespace Bitswarm {
 		void IsReconnecting(bool value);
 		long int ReconnectionSeconds();
 		void ReconnectionSeconds(long int value);
+		bool FastReconnection();
+		void EnableFastReconnection(bool enabled, long int bufferSize);
+		bool IsBufferingMessages();
+		void CompleteReconnection();
+		long int ReconnectionCount();
+		long int LastReconnectionTime();
+		long int TotalReconnectionTime();
+		long int ReplayedMessages();
+		long int DroppedMessages();
+		long int ReplacedMessages();						// Messages superseded by a newer one with the same replacement key before being written
+		long int PendingSendBytes();						// Bytes queued for sending plus bytes not yet written by the socket
+		void SendWatermarks(long int highWatermark, long int lowWatermark);
+		long int SendHighWatermark();
+		long int SendLowWatermark();
+		void CheckSendWatermarks();							// Dispatches OUTBOUND_CONGESTION when the pending bytes cross a watermark
+		void ResetSendCongestion();							// Dispatches OUTBOUND_CONGESTION with congested false if the output was congested, e.g. when the connection is closed
 		void Dispatcher(boost::shared_ptr<EventDispatcher> value);
 		boost::shared_ptr<Logger> Log();
 		boost::shared_ptr<Sfs2X::Util::CryptoKey> CryptoKey();
 		void CryptoKey(boost::shared_ptr<Sfs2X::Util::CryptoKey> value);
+		boost::shared_ptr<Sfs2X::Core::PacketCapture> PacketCapture();
+		void PacketCapture(boost::shared_ptr<Sfs2X::Core::PacketCapture> value);
+		bool UsePacketArena();
+		void UsePacketArena(bool value);
 		void ForceBlueBox(bool val);
+		void ForceWebSocket(bool val, bool useSSL);		// Socket connections go through a WebSocket on the HTTP port
+		void ForceWebSocket(bool val, bool useSSL, const string& host);	// As above, the host name is sent in the upgrade request and for TLS
+		bool PollMode();
+		void PollMode(bool value);						// No internal thread: the caller runs the network through Poll
+		long int Poll(long int timeout);
 		void EnableBlueBoxDebug(bool val);
 		void Init();
 		void Destroy();
@@ -107,6 +137,7 @@ namespace Bitswarm {
 		long int ConnectionPort();
 		void Connect();
 		void Connect(boost::shared_ptr<string> ip, unsigned short int port);
+		void Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ips, unsigned short int port);		// Addresses of the server, in order of preference
 		void Send(boost::shared_ptr<IMessage> message);
 		void Disconnect();
 		void Disconnect(boost::shared_ptr<string> reason);
@@ -152,9 +183,15 @@ namespace Bitswarm {
 		void InitControllers();
 		void RetryConnection(long int timeout);
 		void OnRetryConnectionEvent(const boost::system::error_code& code);
+		static void OnPollTimeout(const boost::system::error_code& code);
 
+		void InitSocket();
 		void ExecuteDisconnection();
 		void ReleaseResources();
+		void BufferMessage(boost::shared_ptr<IMessage> message);
+		void ReplayMessages();
+		void ClearPendingMessages();
+		bool IsHandshake(boost::shared_ptr<IMessage> message);
 
 		static void OnBBConnect(unsigned long long context, boost::shared_ptr<BaseEvent> e);
 		static void OnBBData(unsigned long long context, boost::shared_ptr<BaseEvent> e);
@@ -173,11 +210,13 @@ namespace Bitswarm {
 		// -------------------------------------------------------------------
 
 		boost::shared_ptr<ISocketLayer> socket;
+		boost::shared_ptr<ISocketLayer> replacedSocket;		// Previous socket layer, kept until it can no longer be running a callback
 		std::map<long int, boost::shared_ptr<IController> > controllers;
 		long int compressionThreshold; 
 		long int maxMessageSize;
 		boost::shared_ptr<SmartFox> sfs;						
 		boost::shared_ptr<string> lastIpAddress; 
+		boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > lastIpAddresses;
 		unsigned short int lastTcpPort; 
 		long int reconnectionSeconds;
 		bool attemptingReconnection;  
@@ -187,6 +226,9 @@ namespace Bitswarm {
 		boost::shared_ptr<EventDispatcher> dispatcher;
 		boost::shared_ptr<BBClient> bbClient;
 		volatile bool useBlueBox;
+		volatile bool useWebSocket;
+		bool useWebSocketSSL;
+		string webSocketHost;
 		bool bbConnected;
 		boost::shared_ptr<string> connectionMode;
 		boost::shared_ptr<Sfs2X::Core::ThreadManager> threadManager;		
@@ -199,6 +241,29 @@ namespace Bitswarm {
 		boost::shared_ptr<boost::asio::io_service> io_service_retryTimer;
 
 		boost::shared_ptr<Sfs2X::Util::CryptoKey> cryptoKey;
+		boost::shared_ptr<Sfs2X::Core::PacketCapture> packetCapture;		// Raw traffic recorder, empty when the capture is off
+		volatile bool usePacketArena;												// Inbound packets are decoded into a per-packet arena
+
+		// Fast reconnection: outbound messages are held while the session is being resumed and replayed in order afterwards
+		bool fastReconnection;
+		long int pendingMessagesLimit;
+		boost::shared_ptr<list<boost::shared_ptr<IMessage> > > pendingMessages;
+		boost::recursive_mutex lockPendingMessages;
+
+		// Reconnection metrics (times are expressed in milliseconds)
+		boost::posix_time::ptime reconnectionStartTime;
+		long int reconnectionCount;
+		long int lastReconnectionTime;
+		long int totalReconnectionTime;
+		long int replayedMessages;
+		long int droppedMessages;
+		long int replacedMessages;
+
+		// Outbound flow control: the application is notified when the pending bytes cross the watermarks
+		long int sendHighWatermark;											// 0 disables the notifications
+		long int sendLowWatermark;
+		bool isSendCongested;
+		boost::mutex lockSendWatermarks;
 
 	};
 
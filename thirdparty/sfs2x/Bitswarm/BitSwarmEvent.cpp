@@ -9,16 +9,19 @@
 //
 // ===================================================================
 #include "BitSwarmEvent.h"
+#include "../Util/KeyTable.h"
+
+using namespace Sfs2X::Util;
 
 namespace Sfs2X {
 namespace Bitswarm {
 
-boost::shared_ptr<string> BitSwarmEvent::CONNECT (new string("connect"));
-boost::shared_ptr<string> BitSwarmEvent::DISCONNECT (new string("disconnect"));
-boost::shared_ptr<string> BitSwarmEvent::RECONNECTION_TRY (new string("reconnectionTry"));
-boost::shared_ptr<string> BitSwarmEvent::IO_ERROR (new string("ioError"));
-boost::shared_ptr<string> BitSwarmEvent::SECURITY_ERROR (new string("securityError"));
-boost::shared_ptr<string> BitSwarmEvent::DATA_ERROR (new string("dataError"));
+boost::shared_ptr<string> BitSwarmEvent::CONNECT (KeyTable::Atom("connect"));
+boost::shared_ptr<string> BitSwarmEvent::DISCONNECT (KeyTable::Atom("disconnect"));
+boost::shared_ptr<string> BitSwarmEvent::RECONNECTION_TRY (KeyTable::Atom("reconnectionTry"));
+boost::shared_ptr<string> BitSwarmEvent::IO_ERROR (KeyTable::Atom("ioError"));
+boost::shared_ptr<string> BitSwarmEvent::SECURITY_ERROR (KeyTable::Atom("securityError"));
+boost::shared_ptr<string> BitSwarmEvent::DATA_ERROR (KeyTable::Atom("dataError"));
 
 // -------------------------------------------------------------------
 // Constructor
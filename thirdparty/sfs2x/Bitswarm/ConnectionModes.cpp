@@ -21,6 +21,7 @@ namespace Bitswarm {
 
 boost::shared_ptr<string> ConnectionModes::SOCKET (new string("socket"));
 boost::shared_ptr<string> ConnectionModes::HTTP (new string("http"));
+boost::shared_ptr<string> ConnectionModes::WEBSOCKET (new string("websocket"));
 
 }	// namespace Bitswarm
 }	// namespace Sfs2X
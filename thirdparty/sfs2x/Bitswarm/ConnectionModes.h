@@ -39,6 +39,7 @@ namespace Bitswarm {
 
 		static boost::shared_ptr<string> SOCKET;
 		static boost::shared_ptr<string> HTTP;
+		static boost::shared_ptr<string> WEBSOCKET;
 
 	protected:
 
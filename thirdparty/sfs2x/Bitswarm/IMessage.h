@@ -43,6 +43,9 @@ namespace Bitswarm {
 
 		virtual long long PacketId() = 0;
 		virtual void PacketId(long long value) = 0;
+
+		virtual boost::shared_ptr<string> ReplacementKey() = 0;
+		virtual void ReplacementKey(boost::shared_ptr<string> value) = 0;
 	};
 
 }	// namespace Bitswarm
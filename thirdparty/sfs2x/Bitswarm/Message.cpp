@@ -24,6 +24,7 @@ Message::Message()
 	isEncrypted = false;
 	isUDP = false;
 	packetId = 0;
+	replacementKey = boost::shared_ptr<string>();
 }
 
 // -------------------------------------------------------------------
@@ -129,6 +130,22 @@ void Message::PacketId(long long value)
 	packetId = value;
 }
 
+// -------------------------------------------------------------------
+// ReplacementKey
+// -------------------------------------------------------------------
+boost::shared_ptr<string> Message::ReplacementKey()
+{
+	return replacementKey;
+}
+
+// -------------------------------------------------------------------
+// ReplacementKey
+// -------------------------------------------------------------------
+void Message::ReplacementKey(boost::shared_ptr<string> value)
+{
+	replacementKey = value;
+}
+
 // -------------------------------------------------------------------
 // ToString
 // -------------------------------------------------------------------
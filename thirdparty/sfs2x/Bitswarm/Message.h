@@ -53,6 +53,12 @@ namespace Bitswarm {
 		long long PacketId();
 		void PacketId(long long value);
 
+		// ReplacementKey
+		// Messages sharing a replacement key carry successive values of the same state:
+		// a message still waiting to be written is replaced by the next one with its key
+		boost::shared_ptr<string> ReplacementKey();
+		void ReplacementKey(boost::shared_ptr<string> value);
+
 		boost::shared_ptr<string> ToString();
 		
 		// -------------------------------------------------------------------
@@ -85,6 +91,7 @@ namespace Bitswarm {
 		bool isEncrypted;
 		bool isUDP;
 		long long packetId;
+		boost::shared_ptr<string> replacementKey;
 	};
 
 }	// namespace Bitswarm
@@ -125,7 +125,7 @@ void UDPManager::Send(boost::shared_ptr<ByteArray> binaryData)
 				log->Info(logMessages);
 			}
 		}
-		catch(exception ex) {
+		catch(const exception& ex) {
 
 			boost::shared_ptr<string> message (new string(ex.what()));
 
@@ -205,21 +205,24 @@ void UDPManager::OnUDPData(unsigned long long context, boost::shared_ptr<vector<
 		instance->log->Info(logMessages);
 	}
 
+	// Header byte and size are read as one block, already checked above
+	ByteReader reader = bytes->Reader(3);
+
 	// Skip the header byte
 	unsigned char header;
-	bytes->ReadByte(header);
+	reader.ReadByte(header);
 
 	// Get the compression and encryption flags
 	bool compressed = (header & 0x20) > 0; 
 	bool encrypted = (header & 0x40) > 0;
 
-	// Read the size of message (UDP can only use the short version)
-	short dataSize;
-	bytes->ReadShort(dataSize);
+	// Read the size of message (UDP can only use the short version, which is unsigned)
+	unsigned short int dataSize;
+	reader.ReadUShort(dataSize);
 
-	if (dataSize != bytes->BytesAvailable()) {
+	if ((long int)dataSize != bytes->BytesAvailable()) {
 		char buffer[512];
-		sprintf (buffer, "Insufficient UDP data. Expected: %ld, got: %ld", dataSize, bytes->BytesAvailable());
+		sprintf (buffer, "Insufficient UDP data. Expected: %ld, got: %ld", (long int)dataSize, bytes->BytesAvailable());
 		string logMessage = buffer;
 
 		boost::shared_ptr<vector<string> > logMessages (new vector<string>());
@@ -230,8 +233,7 @@ void UDPManager::OnUDPData(unsigned long long context, boost::shared_ptr<vector<
 	}
 
 	// Grab the message body and deserialize it
-	boost::shared_ptr<vector<unsigned char> > data (new vector<unsigned char>());
-	bytes->ReadBytes(bytes->BytesAvailable(), *(data.get()));
+	boost::shared_ptr<vector<unsigned char> > data (new vector<unsigned char>(bt->begin() + bytes->Position(), bt->end()));
 	boost::shared_ptr<ByteArray> objBytes (new ByteArray(data));
 
 	// Handle encryption
@@ -241,7 +243,7 @@ void UDPManager::OnUDPData(unsigned long long context, boost::shared_ptr<vector<
 		{
 			instance->packetEncrypter->Decrypt(objBytes);
 		}
-		catch(exception ex) {
+		catch(const exception& ex) {
 
 			boost::shared_ptr<string> message (new string(ex.what()));
 
@@ -259,7 +261,7 @@ void UDPManager::OnUDPData(unsigned long long context, boost::shared_ptr<vector<
 
 	// Handle compression
 	if (compressed) {
-		objBytes->Uncompress();
+		objBytes->Uncompress(instance->compressor);
 	}
 
 	boost::shared_ptr<ISFSObject> reqObj = SFSObject::NewFromBinaryData(objBytes);
@@ -295,7 +297,7 @@ void UDPManager::OnUDPError(unsigned long long context, boost::shared_ptr<string
 	UDPManager* instance = (UDPManager*)context;
 
 	char buffer[512];
-	sprintf (buffer, "Unexpected UDP I/O Error. %s [%ld]", msg->c_str(), se);
+	sprintf (buffer, "Unexpected UDP I/O Error. %s [%d]", msg->c_str(), (int)se);
 	string logMessage = buffer;
 
 	boost::shared_ptr<vector<string> > logMessages (new vector<string>());
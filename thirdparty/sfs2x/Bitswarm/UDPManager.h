@@ -16,6 +16,7 @@
 #include "../SmartFox.h"					// SmartFox class
 #include "../Logging/Logger.h"				// Logging service
 #include "../Core/IPacketEncrypter.h"
+#include "../Util/ZlibCompressor.h"
 
 #include <boost/bind.hpp>						// Boost Asio header
 #include <boost/asio.hpp>						// Boost Asio header
@@ -100,6 +101,7 @@ namespace Bitswarm {
 		long int currentAttempt;
 
 		boost::shared_ptr<IPacketEncrypter> packetEncrypter;
+		ZlibCompressor compressor;
 	};
 
 }	// namespace Bitswarm
@@ -55,10 +55,18 @@ void ExtensionController::HandleMessage(boost::shared_ptr<IMessage> message)
 	evtParams->insert(pair<string, boost::shared_ptr<void> >("cmd", cmd));
 	boost::shared_ptr<ISFSObject> params = obj->GetSFSObject(*KEY_PARAMS);
 	evtParams->insert(pair<string, boost::shared_ptr<void> >("params", params));
+
+	// Responses to the requests sent by SendAsync bring back the id of the request
+	if (params != NULL && params->ContainsKey(*ExtensionRequest::KEY_REQUEST_ID))
+	{
+		boost::shared_ptr<long int> requestId (new long int());
+		*requestId = params->GetIntOr(*ExtensionRequest::KEY_REQUEST_ID, 0);
+		evtParams->insert(pair<string, boost::shared_ptr<void> >("requestId", requestId));
+	}
 			
 	if (obj->ContainsKey(*KEY_ROOM)) 
 	{
-		long int roomId = *(obj->GetInt(*KEY_ROOM));
+		long int roomId = obj->GetIntOr(*KEY_ROOM, 0);
 
 		boost::shared_ptr<long int> sourceRoom (new long int());
 		*sourceRoom = roomId;
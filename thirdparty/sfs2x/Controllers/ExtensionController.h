@@ -23,6 +23,7 @@ namespace Controllers {
 #include "../Bitswarm/IMessage.h"
 #include "../Entities/Data/ISFSObject.h"
 #include "../Core/SFSEvent.h"
+#include "../Requests/ExtensionRequest.h"
 
 #include <boost/shared_ptr.hpp>				// Boost Asio shared pointer
 
@@ -30,6 +31,7 @@ using namespace Sfs2X;
 using namespace Sfs2X::Bitswarm;
 using namespace Sfs2X::Core;
 using namespace Sfs2X::Entities::Data;
+using namespace Sfs2X::Requests;
 
 namespace Sfs2X {
 namespace Controllers {
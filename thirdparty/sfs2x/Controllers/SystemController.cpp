@@ -167,17 +167,17 @@ void SystemController::FnLogin(unsigned long long context, boost::shared_ptr<IMe
 		instance->PopulateRoomList(obj->GetSFSArray(LoginRequest::KEY_ROOMLIST));
 			
 		// create local user
-		boost::shared_ptr<User> localUser (new SFSUser (*(obj->GetInt(LoginRequest::KEY_ID)), (*(obj->GetUtfString(LoginRequest::KEY_USER_NAME))), true));
+		boost::shared_ptr<User> localUser (new SFSUser (obj->GetIntOr(*LoginRequest::KEY_ID, 0), obj->GetUtfStringOr(*LoginRequest::KEY_USER_NAME, string()), true));
 		instance->sfs->MySelf(localUser);
 				
 		instance->sfs->MySelf()->UserManager(instance->sfs->UserManager());
-		instance->sfs->MySelf()->PrivilegeId(*(obj->GetShort(LoginRequest::KEY_PRIVILEGE_ID)));
+		instance->sfs->MySelf()->PrivilegeId(obj->GetShortOr(*LoginRequest::KEY_PRIVILEGE_ID, 0));
 		instance->sfs->UserManager()->AddUser(instance->sfs->MySelf());
 				
 		// set the reconnection seconds
-		instance->sfs->SetReconnectionSeconds(*(obj->GetShort(LoginRequest::KEY_RECONNECTION_SECONDS)));
+		instance->sfs->SetReconnectionSeconds(obj->GetShortOr(*LoginRequest::KEY_RECONNECTION_SECONDS, 0));
 				
-		instance->sfs->MySelf()->PrivilegeId(*(obj->GetShort(LoginRequest::KEY_PRIVILEGE_ID)));
+		instance->sfs->MySelf()->PrivilegeId(obj->GetShortOr(*LoginRequest::KEY_PRIVILEGE_ID, 0));
 				
 		// Fire success event
 		evtParams->insert(pair<string, boost::shared_ptr<void> >("zone", obj->GetUtfString(LoginRequest::KEY_ZONE_NAME)));
@@ -323,8 +323,7 @@ void SystemController::FnUserEnterRoom(unsigned long long context, boost::shared
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 
-	boost::shared_ptr<string> keyGetInt (new string("r"));
-	boost::shared_ptr<Room> room = instance->sfs->RoomManager()->GetRoomById(*(sfso->GetInt(keyGetInt)));
+	boost::shared_ptr<Room> room = instance->sfs->RoomManager()->GetRoomById(sfso->GetIntOr("r", 0));
 
 	if (room != NULL) {
 		boost::shared_ptr<string> keyGetSFSArray (new string("u"));
@@ -349,18 +348,13 @@ void SystemController::FnUserCountChange(unsigned long long context, boost::shar
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 
-	boost::shared_ptr<string> keyGetInt (new string("r"));
-	boost::shared_ptr<Room> room = instance->sfs->RoomManager()->GetRoomById(*(sfso->GetInt(keyGetInt)));
+	boost::shared_ptr<Room> room = instance->sfs->RoomManager()->GetRoomById(sfso->GetIntOr("r", 0));
 
 	if (room != NULL) {
-		boost::shared_ptr<string> keyGetShort (new string("uc"));
-		long int uCount = *(sfso->GetShort(keyGetShort));
-		long int sCount = 0;
+		long int uCount = sfso->GetShortOr("uc", 0);
 
 		// Check for optional spectator count
-		boost::shared_ptr<string> keyContains (new string("sc"));
-		if (sfso->ContainsKey(keyContains))
-			sCount = *(sfso->GetShort(keyContains));
+		long int sCount = sfso->GetShortOr("sc", 0);
 
 		room->UserCount(uCount);
 		room->SpectatorCount(sCount);
@@ -391,8 +385,7 @@ void SystemController::FnUserLost(unsigned long long context, boost::shared_ptr<
 
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 
-	boost::shared_ptr<string> keyGetInt (new string("u"));
-	long int uId = *(sfso->GetInt(keyGetInt));
+	long int uId = sfso->GetIntOr("u", 0);
 	boost::shared_ptr<User> user = instance->sfs->UserManager()->GetUserById(uId);
 
 	if (user != NULL) {
@@ -439,8 +432,7 @@ void SystemController::FnRoomLost(unsigned long long context, boost::shared_ptr<
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 
-	boost::shared_ptr<string> keyGetInt (new string("r"));
-	long int rId = *(sfso->GetInt(keyGetInt));
+	long int rId = sfso->GetIntOr("r", 0);
 	boost::shared_ptr<Room> room = instance->sfs->RoomManager()->GetRoomById(rId);
 	boost::shared_ptr<IUserManager> globalUserManager = instance->sfs->UserManager(); 
 
@@ -473,11 +465,8 @@ void SystemController::FnUserExitRoom(unsigned long long context, boost::shared_
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 
-	boost::shared_ptr<string> keyGetInt (new string("r"));
-	long int rId = *(sfso->GetInt(keyGetInt));
-
-	keyGetInt = boost::shared_ptr<string>(new string("u"));
-	long int uId = *(sfso->GetInt(keyGetInt));
+	long int rId = sfso->GetIntOr("r", 0);
+	long int uId = sfso->GetIntOr("u", 0);
 	boost::shared_ptr<Room> room = instance->sfs->RoomManager()->GetRoomById(rId);
 	boost::shared_ptr<User> user = instance->sfs->UserManager()->GetUserById(uId);
 
@@ -528,8 +517,7 @@ void SystemController::FnClientDisconnection(unsigned long long context, boost::
 
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 
-	boost::shared_ptr<string> keyGetByte (new string("dr"));
-	long int reasonId = *(sfso->GetByte(keyGetByte));
+	long int reasonId = sfso->GetByteOr("dr", 0);
 
 	instance->sfs->HandleClientDisconnection(ClientDisconnectionReason::GetReason(reasonId));
 }
@@ -542,7 +530,7 @@ void SystemController::FnSetRoomVariables(unsigned long long context, boost::sha
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 
-	long int rId = *(sfso->GetInt(SetRoomVariablesRequest::KEY_VAR_ROOM));
+	long int rId = sfso->GetIntOr(*SetRoomVariablesRequest::KEY_VAR_ROOM, 0);
 	boost::shared_ptr<ISFSArray> varListData = sfso->GetSFSArray(SetRoomVariablesRequest::KEY_VAR_LIST);
 
 	boost::shared_ptr<Room> targetRoom = instance->sfs->RoomManager()->GetRoomById(rId);
@@ -582,7 +570,7 @@ void SystemController::FnSetUserVariables(unsigned long long context, boost::sha
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 
-	long int uId = *(sfso->GetInt(SetUserVariablesRequest::KEY_USER));
+	long int uId = sfso->GetIntOr(*SetUserVariablesRequest::KEY_USER, 0);
 	boost::shared_ptr<ISFSArray> varListData = sfso->GetSFSArray(SetUserVariablesRequest::KEY_VAR_LIST);
 
 	boost::shared_ptr<User> user = instance->sfs->UserManager()->GetUserById(uId);
@@ -669,7 +657,7 @@ void SystemController::FnUnsubscribeRoomGroup(unsigned long long context, boost:
 
 	// ::: SUCCESS ::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 	if (sfso->IsNull(BaseRequest::KEY_ERROR_CODE)) {
-		boost::shared_ptr<string> groupId (new string(*(sfso->GetUtfString(UnsubscribeRoomGroupRequest::KEY_GROUP_ID))));
+		boost::shared_ptr<string> groupId (new string(sfso->GetUtfStringOr(*UnsubscribeRoomGroupRequest::KEY_GROUP_ID, string())));
 		// Integrity Check
 		if (!instance->sfs->RoomManager()->ContainsGroup(*groupId))
 		{
@@ -710,14 +698,14 @@ void SystemController::FnChangeRoomName(unsigned long long context, boost::share
 	// ::: SUCCESS ::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 	if (sfso->IsNull(BaseRequest::KEY_ERROR_CODE)) {
 		// Obtain the target Room
-		long int roomId = *(sfso->GetInt(ChangeRoomNameRequest::KEY_ROOM));
+		long int roomId = sfso->GetIntOr(*ChangeRoomNameRequest::KEY_ROOM, 0);
 		boost::shared_ptr<Room> targetRoom = instance->sfs->RoomManager()->GetRoomById(roomId);
 
 		if (targetRoom != NULL) 	{
 			boost::shared_ptr<string> valueRoomName (new string (*targetRoom->Name()));
 			evtParams->insert(pair<string, boost::shared_ptr<void> >("oldName", valueRoomName));
 
-			instance->sfs->RoomManager()->ChangeRoomName(targetRoom, *(sfso->GetUtfString(ChangeRoomNameRequest::KEY_NAME)));
+			instance->sfs->RoomManager()->ChangeRoomName(targetRoom, sfso->GetUtfStringOr(*ChangeRoomNameRequest::KEY_NAME, string()));
 
 			evtParams->insert(pair<string, boost::shared_ptr<void> >("room", targetRoom));
 
@@ -761,11 +749,11 @@ void SystemController::FnChangeRoomPassword(unsigned long long context, boost::s
 	// ::: SUCCESS ::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 	if (sfso->IsNull(BaseRequest::KEY_ERROR_CODE)) {
 		// Obtain the target Room
-		long int roomId = *(sfso->GetInt(ChangeRoomPasswordStateRequest::KEY_ROOM));
+		long int roomId = sfso->GetIntOr(*ChangeRoomPasswordStateRequest::KEY_ROOM, 0);
 		boost::shared_ptr<Room> targetRoom = instance->sfs->RoomManager()->GetRoomById(roomId);
 
 		if (targetRoom != NULL) {
-			instance->sfs->RoomManager()->ChangeRoomPasswordState(targetRoom, *(sfso->GetBool(ChangeRoomPasswordStateRequest::KEY_PASS)));
+			instance->sfs->RoomManager()->ChangeRoomPasswordState(targetRoom, sfso->GetBoolOr(*ChangeRoomPasswordStateRequest::KEY_PASS, false));
 			evtParams->insert(pair<string, boost::shared_ptr<void> >("room", targetRoom));
 
 			boost::shared_ptr<SFSEvent> evt (new SFSEvent(SFSEvent::ROOM_PASSWORD_STATE_CHANGE, evtParams));
@@ -804,14 +792,14 @@ void SystemController::FnChangeRoomCapacity(unsigned long long context, boost::s
 	// ::: SUCCESS ::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 	if (sfso->IsNull(BaseRequest::KEY_ERROR_CODE)) {
 		// Obtain the target Room
-		long int roomId = *(sfso->GetInt(ChangeRoomCapacityRequest::KEY_ROOM));
+		long int roomId = sfso->GetIntOr(*ChangeRoomCapacityRequest::KEY_ROOM, 0);
 		boost::shared_ptr<Room> targetRoom = instance->sfs->RoomManager()->GetRoomById(roomId);
 
 		if (targetRoom != NULL) {
 			instance->sfs->RoomManager()->ChangeRoomCapacity(
 				targetRoom,
-				*(sfso->GetInt(ChangeRoomCapacityRequest::KEY_USER_SIZE)), 
-				*(sfso->GetInt(ChangeRoomCapacityRequest::KEY_SPEC_SIZE))
+				sfso->GetIntOr(*ChangeRoomCapacityRequest::KEY_USER_SIZE, 0), 
+				sfso->GetIntOr(*ChangeRoomCapacityRequest::KEY_SPEC_SIZE, 0)
 				);
 
 			evtParams->insert(pair<string, boost::shared_ptr<void> >("room", targetRoom));
@@ -908,9 +896,9 @@ void SystemController::FnSpectatorToPlayer(unsigned long long context, boost::sh
 	if (sfso->IsNull(BaseRequest::KEY_ERROR_CODE))
 	{
 		// Obtain the target Room
-		long int roomId = *(sfso->GetInt(SpectatorToPlayerRequest::KEY_ROOM_ID));
-		long int userId = *(sfso->GetInt(SpectatorToPlayerRequest::KEY_USER_ID));
-		long int playerId = *(sfso->GetShort(SpectatorToPlayerRequest::KEY_PLAYER_ID));
+		long int roomId = sfso->GetIntOr(*SpectatorToPlayerRequest::KEY_ROOM_ID, 0);
+		long int userId = sfso->GetIntOr(*SpectatorToPlayerRequest::KEY_USER_ID, 0);
+		long int playerId = sfso->GetShortOr(*SpectatorToPlayerRequest::KEY_PLAYER_ID, 0);
 
 		boost::shared_ptr<User> user = instance->sfs->UserManager()->GetUserById(userId);
 		boost::shared_ptr<Room> targetRoom = instance->sfs->RoomManager()->GetRoomById(roomId);
@@ -986,8 +974,8 @@ void SystemController::FnPlayerToSpectator(unsigned long long context, boost::sh
 	// ::: SUCCESS ::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 	if (sfso->IsNull(BaseRequest::KEY_ERROR_CODE)) {
 		// Obtain the target Room
-		long int roomId = *(sfso->GetInt(PlayerToSpectatorRequest::KEY_ROOM_ID));
-		long int userId = *(sfso->GetInt(PlayerToSpectatorRequest::KEY_USER_ID));
+		long int roomId = sfso->GetIntOr(*PlayerToSpectatorRequest::KEY_ROOM_ID, 0);
+		long int userId = sfso->GetIntOr(*PlayerToSpectatorRequest::KEY_USER_ID, 0);
 
 		boost::shared_ptr<User> user = instance->sfs->UserManager()->GetUserById(userId);
 		boost::shared_ptr<Room> targetRoom = instance->sfs->RoomManager()->GetRoomById(roomId);
@@ -1212,7 +1200,7 @@ void SystemController::FnBlockBuddy(unsigned long long context, boost::shared_pt
 		else if (buddy != NULL) 
 		{
 			// Set the BuddyBlock State
-			buddy->IsBlocked(*(sfso->GetBool(BlockBuddyRequest::KEY_BUDDY_BLOCK_STATE)));
+			buddy->IsBlocked(sfso->GetBoolOr(*BlockBuddyRequest::KEY_BUDDY_BLOCK_STATE, false));
 		} 
 		else 
 		{
@@ -1254,7 +1242,7 @@ void SystemController::FnGoOnline(unsigned long long context, boost::shared_ptr<
 		boost::shared_ptr<string> buddyName = sfso->GetUtfString(GoOnlineRequest::KEY_BUDDY_NAME);
 		boost::shared_ptr<Buddy> buddy = instance->sfs->BuddyManager()->GetBuddyByName(*buddyName);
 		bool isItMe = (*buddyName) == (*instance->sfs->MySelf()->Name());
-		long int onlineValue = *(sfso->GetByte(GoOnlineRequest::KEY_ONLINE));
+		long int onlineValue = sfso->GetByteOr(*GoOnlineRequest::KEY_ONLINE, 0);
 		bool onlineState = (onlineValue == (long int)BUDDYONLINESTATE_ONLINE);
 
 		bool fireEvent = true;
@@ -1268,7 +1256,7 @@ void SystemController::FnGoOnline(unsigned long long context, boost::shared_ptr<
 			if (instance->sfs->BuddyManager()->MyOnlineState() != onlineState) {
 
 				char buffer[512];
-				sprintf (buffer, "Unexpected: MyOnlineState is not in synch with the server. Resynching: %ld", onlineState);
+				sprintf (buffer, "Unexpected: MyOnlineState is not in synch with the server. Resynching: %d", (int)onlineState);
 				string logMessage = buffer;
 
 				boost::shared_ptr<vector<string> > logMessages (new vector<string>());
@@ -1282,7 +1270,7 @@ void SystemController::FnGoOnline(unsigned long long context, boost::shared_ptr<
 		// Another buddy in my list went online/offline
 		else if (buddy != NULL) {
 			// Set the BuddyBlock State
-			buddy->Id(*(sfso->GetInt(GoOnlineRequest::KEY_BUDDY_ID)));
+			buddy->Id(sfso->GetIntOr(*GoOnlineRequest::KEY_BUDDY_ID, 0));
 			boost::shared_ptr<bool> onlineStateValue (new bool());
 			*onlineStateValue = onlineState;
 			boost::shared_ptr<BuddyVariable> bvar (new SFSBuddyVariable(ReservedBuddyVariables::BV_ONLINE, onlineStateValue, VARIABLETYPE_BOOL));
@@ -1493,12 +1481,12 @@ void SystemController::FnInviteUsers(unsigned long long context, boost::shared_p
 
 	// Determine if the user is local (id was sent) or not (whole User object was sent)
 	if (sfso->ContainsKey(InviteUsersRequest::KEY_USER_ID))
-		inviter = instance->sfs->UserManager()->GetUserById(*(sfso->GetInt(InviteUsersRequest::KEY_USER_ID)));
+		inviter = instance->sfs->UserManager()->GetUserById(sfso->GetIntOr(*InviteUsersRequest::KEY_USER_ID, 0));
 	else
 		inviter = SFSUser::FromSFSArray(sfso->GetSFSArray(InviteUsersRequest::KEY_USER));
 
-	long int expiryTime = *(sfso->GetShort(InviteUsersRequest::KEY_TIME));
-	long int invitationId = *(sfso->GetInt(InviteUsersRequest::KEY_INVITATION_ID));
+	long int expiryTime = sfso->GetShortOr(*InviteUsersRequest::KEY_TIME, 0);
+	long int invitationId = sfso->GetIntOr(*InviteUsersRequest::KEY_INVITATION_ID, 0);
 	boost::shared_ptr<ISFSObject> invParams = sfso->GetSFSObject(InviteUsersRequest::KEY_PARAMS);
 	boost::shared_ptr<Sfs2X::Entities::Invitation::Invitation> invitation (new SFSInvitation(inviter, instance->sfs->MySelf(), expiryTime, invParams));
 	invitation->Id(invitationId);
@@ -1523,7 +1511,7 @@ void SystemController::FnInvitationReply(unsigned long long context, boost::shar
 
 		// Determine if the invitee is local (id was sent) or not (whole User object was sent)
 		if (sfso->ContainsKey(InviteUsersRequest::KEY_USER_ID))
-			invitee = instance->sfs->UserManager()->GetUserById(*(sfso->GetInt(InviteUsersRequest::KEY_USER_ID)));
+			invitee = instance->sfs->UserManager()->GetUserById(sfso->GetIntOr(*InviteUsersRequest::KEY_USER_ID, 0));
 		else
 			invitee = SFSUser::FromSFSArray(sfso->GetSFSArray(InviteUsersRequest::KEY_USER));
 
@@ -1597,7 +1585,7 @@ void SystemController::FnSetUserPosition(unsigned long long context, boost::shar
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 
-	long int roomId = *(sfso->GetInt(SetUserPositionRequest::KEY_ROOM));
+	long int roomId = sfso->GetIntOr(*SetUserPositionRequest::KEY_ROOM, 0);
 
 	boost::shared_ptr<vector<long int> > minusUserList = sfso->GetIntArray(SetUserPositionRequest::KEY_MINUS_USER_LIST);
 	boost::shared_ptr<ISFSArray> plusUserList = sfso->GetSFSArray(SetUserPositionRequest::KEY_PLUS_USER_LIST);
@@ -1721,8 +1709,8 @@ void SystemController::FnSetMMOItemVariables(unsigned long long context, boost::
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
 
-	long int roomId = *(sfso->GetInt(SetMMOItemVariables::KEY_ROOM_ID));
-	long int mmoItemId = *(sfso->GetInt(SetMMOItemVariables::KEY_ITEM_ID));
+	long int roomId = sfso->GetIntOr(*SetMMOItemVariables::KEY_ROOM_ID, 0);
+	long int mmoItemId = sfso->GetIntOr(*SetMMOItemVariables::KEY_ITEM_ID, 0);
 	boost::shared_ptr<ISFSArray> varList = sfso->GetSFSArray(SetMMOItemVariables::KEY_VAR_LIST);
 			
 	boost::shared_ptr<MMORoom> mmoRoom = ((boost::static_pointer_cast<MMORoom>)(instance->sfs->GetRoomById(roomId)));
@@ -1771,7 +1759,7 @@ void SystemController::FnGenericMessage(unsigned long long context, boost::share
 	SystemController* instance = (SystemController*)context;
 
 	boost::shared_ptr<ISFSObject> sfso = msg->Content();
-	long int msgType = *(sfso->GetByte(GenericMessageRequest::KEY_MESSAGE_TYPE));
+	long int msgType = sfso->GetByteOr(*GenericMessageRequest::KEY_MESSAGE_TYPE, 0);
 
 	switch ((GenericMessageType)msgType) {
 	case GENERICMESSAGETYPE_PUBLIC_MSG:
@@ -1799,12 +1787,12 @@ void SystemController::HandlePublicMessage(boost::shared_ptr<ISFSObject> sfso)
 {
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 
-	long int rId = *(sfso->GetInt(GenericMessageRequest::KEY_ROOM_ID));
+	long int rId = sfso->GetIntOr(*GenericMessageRequest::KEY_ROOM_ID, 0);
 	boost::shared_ptr<Room> room = sfs->RoomManager()->GetRoomById(rId);
 
 	if (room != NULL) {
 		evtParams->insert(pair<string, boost::shared_ptr<void> >("room", room));
-		evtParams->insert(pair<string, boost::shared_ptr<void> >("sender", sfs->UserManager()->GetUserById(*(sfso->GetInt(GenericMessageRequest::KEY_USER_ID)))));
+		evtParams->insert(pair<string, boost::shared_ptr<void> >("sender", sfs->UserManager()->GetUserById(sfso->GetIntOr(*GenericMessageRequest::KEY_USER_ID, 0))));
 		evtParams->insert(pair<string, boost::shared_ptr<void> >("message", sfso->GetUtfString(GenericMessageRequest::KEY_MESSAGE)));
 		evtParams->insert(pair<string, boost::shared_ptr<void> >("data", sfso->GetSFSObject(GenericMessageRequest::KEY_XTRA_PARAMS)));
 
@@ -1826,7 +1814,7 @@ void SystemController::HandlePublicMessage(boost::shared_ptr<ISFSObject> sfso)
 void SystemController::HandlePrivateMessage(boost::shared_ptr<ISFSObject> sfso)
 {
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
-	long int senderId = *(sfso->GetInt(GenericMessageRequest::KEY_USER_ID));
+	long int senderId = sfso->GetIntOr(*GenericMessageRequest::KEY_USER_ID, 0);
 
 	// See if user exists locally
 	boost::shared_ptr<User> sender = sfs->UserManager()->GetUserById(senderId);
@@ -1905,7 +1893,7 @@ void SystemController::HandleModMessage(boost::shared_ptr<ISFSObject> sfso, boos
 void SystemController::HandleObjectMessage(boost::shared_ptr<ISFSObject> sfso)
 {
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
-	long int senderId = *(sfso->GetInt(GenericMessageRequest::KEY_USER_ID));
+	long int senderId = sfso->GetIntOr(*GenericMessageRequest::KEY_USER_ID, 0);
 
 	evtParams->insert(pair<string, boost::shared_ptr<void> >("sender", sfs->UserManager()->GetUserById(senderId)));
 	evtParams->insert(pair<string, boost::shared_ptr<void> >("message", sfso->GetSFSObject(GenericMessageRequest::KEY_XTRA_PARAMS)));
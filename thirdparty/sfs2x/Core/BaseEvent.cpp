@@ -78,7 +78,7 @@ boost::shared_ptr<string> BaseEvent::ToString()
 	else
 	{
 		char buffer[100];
-		sprintf (buffer, "%s [%ld]", type->c_str(), (unsigned long int*)target.get());
+		sprintf (buffer, "%s [%p]", type->c_str(), target.get());
 
 		log = boost::shared_ptr<string>(new string(buffer));
 	}
@@ -0,0 +1,266 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of PacketCapture
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "PacketCapture.h"
+
+namespace Sfs2X {
+namespace Core {
+
+const unsigned char PacketCapture::DIRECTION_IN = 0;
+const unsigned char PacketCapture::DIRECTION_OUT = 1;
+
+const char PacketCapture::SIGNATURE[6] = { 'S', 'F', 'S', 'C', 'A', 'P' };
+const unsigned char PacketCapture::VERSION = 1;
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+PacketCapture::PacketCapture()
+{
+	recordCount = 0;
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+PacketCapture::~PacketCapture()
+{
+	Close();
+}
+
+// -------------------------------------------------------------------
+// Open
+// -------------------------------------------------------------------
+bool PacketCapture::Open(string fileName)
+{
+	boost::lock_guard<boost::mutex> lock(lockStream);
+
+	if (stream.is_open())
+	{
+		stream.close();
+	}
+
+	stream.clear();
+	stream.open(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	stream.write(SIGNATURE, sizeof(SIGNATURE));
+	stream.put((char)VERSION);
+	stream.put(0);
+
+	startTime = boost::posix_time::microsec_clock::universal_time();
+	recordCount = 0;
+
+	return stream.good();
+}
+
+// -------------------------------------------------------------------
+// Close
+// -------------------------------------------------------------------
+void PacketCapture::Close()
+{
+	boost::lock_guard<boost::mutex> lock(lockStream);
+
+	if (stream.is_open())
+	{
+		stream.close();
+	}
+}
+
+// -------------------------------------------------------------------
+// IsOpen
+// -------------------------------------------------------------------
+bool PacketCapture::IsOpen()
+{
+	boost::lock_guard<boost::mutex> lock(lockStream);
+	return stream.is_open();
+}
+
+// -------------------------------------------------------------------
+// RecordCount
+// -------------------------------------------------------------------
+long long PacketCapture::RecordCount()
+{
+	boost::lock_guard<boost::mutex> lock(lockStream);
+	return recordCount;
+}
+
+// -------------------------------------------------------------------
+// Record
+// -------------------------------------------------------------------
+void PacketCapture::Record(unsigned char direction, boost::shared_ptr<vector<unsigned char> > data)
+{
+	if (data == NULL || data->size() == 0)
+	{
+		return;
+	}
+
+	boost::lock_guard<boost::mutex> lock(lockStream);
+
+	if (!stream.is_open())
+	{
+		return;
+	}
+
+	boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::universal_time() - startTime;
+
+	stream.put((char)direction);
+	WriteInteger(stream, (unsigned long long)elapsed.total_microseconds(), 8);
+	WriteInteger(stream, (unsigned long long)data->size(), 4);
+	stream.write((const char*)&(*data)[0], data->size());
+
+	recordCount++;
+}
+
+// -------------------------------------------------------------------
+// Load
+// -------------------------------------------------------------------
+bool PacketCapture::Load(string fileName, vector<PacketCaptureRecord>& records)
+{
+	ifstream is;
+	is.open(fileName.c_str(), ios::in | ios::binary);
+	if (!is.is_open())
+	{
+		return false;
+	}
+
+	char signature[sizeof(SIGNATURE) + 2];
+	is.read(signature, sizeof(signature));
+	if (!is.good() || memcmp(signature, SIGNATURE, sizeof(SIGNATURE)) != 0 || (unsigned char)signature[sizeof(SIGNATURE)] != VERSION)
+	{
+		return false;
+	}
+
+	while (true)
+	{
+		int direction = is.get();
+		if (direction == EOF)
+		{
+			break;
+		}
+
+		unsigned long long timestamp = 0;
+		unsigned long long length = 0;
+		if (!ReadInteger(is, timestamp, 8) || !ReadInteger(is, length, 4))
+		{
+			break;
+		}
+
+		PacketCaptureRecord record;
+		record.direction = (unsigned char)direction;
+		record.timestamp = (long long)timestamp;
+		record.data = boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>((size_t)length));
+
+		if (length > 0)
+		{
+			is.read((char*)&(*record.data)[0], (streamsize)length);
+			if (is.gcount() != (streamsize)length)
+			{
+				break;
+			}
+		}
+
+		records.push_back(record);
+	}
+
+	is.close();
+
+	return true;
+}
+
+// -------------------------------------------------------------------
+// SplitPackets
+// -------------------------------------------------------------------
+bool PacketCapture::SplitPackets(vector<PacketCaptureRecord>& records, unsigned char direction, vector<boost::shared_ptr<vector<unsigned char> > >& packets)
+{
+	vector<unsigned char> stream;
+
+	vector<PacketCaptureRecord>::iterator iterator;
+	for (iterator = records.begin(); iterator != records.end(); ++iterator)
+	{
+		if (iterator->direction == direction)
+		{
+			stream.insert(stream.end(), iterator->data->begin(), iterator->data->end());
+		}
+	}
+
+	size_t position = 0;
+	while (position < stream.size())
+	{
+		unsigned char headerByte = stream[position];
+
+		// Packets always have the binary flag set; anything else means the stream is not framed as expected
+		if ((headerByte & 0x80) == 0)
+		{
+			return false;
+		}
+
+		size_t sizeBytes = ((headerByte & 0x08) != 0) ? 4 : 2;
+		if (position + 1 + sizeBytes > stream.size())
+		{
+			return false;
+		}
+
+		size_t length = 0;
+		for (size_t i = 0; i < sizeBytes; i++)
+		{
+			length = (length << 8) | stream[position + 1 + i];
+		}
+
+		size_t packetLength = 1 + sizeBytes + length;
+		if (position + packetLength > stream.size())
+		{
+			return false;
+		}
+
+		packets.push_back(boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>(stream.begin() + position, stream.begin() + position + packetLength)));
+		position += packetLength;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------
+// WriteInteger
+// -------------------------------------------------------------------
+void PacketCapture::WriteInteger(ofstream& stream, unsigned long long value, long int size)
+{
+	for (long int shift = (size - 1) * 8; shift >= 0; shift -= 8)
+	{
+		stream.put((char)((value >> shift) & 0xFF));
+	}
+}
+
+// -------------------------------------------------------------------
+// ReadInteger
+// -------------------------------------------------------------------
+bool PacketCapture::ReadInteger(ifstream& stream, unsigned long long& value, long int size)
+{
+	value = 0;
+
+	for (long int i = 0; i < size; i++)
+	{
+		int byte = stream.get();
+		if (byte == EOF)
+		{
+			return false;
+		}
+
+		value = (value << 8) | (unsigned char)byte;
+	}
+
+	return true;
+}
+
+}	// namespace Core
+}	// namespace Sfs2X
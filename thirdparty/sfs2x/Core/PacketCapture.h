@@ -0,0 +1,134 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of PacketCapture
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __PacketCapture__
+#define __PacketCapture__
+
+#include "../Util/Common.h"
+
+#include <boost/shared_ptr.hpp>				// Boost Asio shared pointer
+#include <boost/thread/mutex.hpp>			// Boost mutex
+#include <boost/thread/locks.hpp>			// Boost lock guard
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <string>						// STL library: string object
+#include <vector>						// STL library: vector object
+#include <fstream>						// STL library:	file stream object
+using namespace std;					// STL library: declare the STL namespace
+
+namespace Sfs2X {
+namespace Core {
+
+	// -------------------------------------------------------------------
+	// Class PacketCaptureRecord
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// A chunk of raw bytes read from, or written to, the network, as stored in a capture file
+	/// </summary>
+	class DLLImportExport PacketCaptureRecord
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		unsigned char direction;					// PacketCapture::DIRECTION_IN or PacketCapture::DIRECTION_OUT
+		long long timestamp;						// Microseconds elapsed since the capture was opened
+		boost::shared_ptr<vector<unsigned char> > data;
+	};
+
+	// -------------------------------------------------------------------
+	// Class PacketCapture
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Records the framed bytes exchanged with the server to a compact binary file, so that a session can be replayed offline
+	/// </summary>
+	///
+	/// <remarks>
+	/// The file starts with an 8 bytes signature ("SFSCAP", format version, reserved byte) followed by one record per chunk:
+	/// direction (1 byte), timestamp in microseconds (8 bytes), length (4 bytes) and the raw bytes, all integers in network byte order.<br/>
+	/// Inbound chunks are stored as they were received from the socket, so a packet may span several records;
+	/// outbound records always hold one whole packet, after compression and encryption.
+	/// </remarks>
+	class DLLImportExport PacketCapture
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		PacketCapture();
+		virtual ~PacketCapture();
+
+		/// <summary>
+		/// Creates (or truncates) the capture file and starts the capture clock
+		/// </summary>
+		/// <returns>false if the file cannot be opened for writing</returns>
+		bool Open(string fileName);
+		void Close();
+		bool IsOpen();
+
+		/// <summary>
+		/// Appends a record to the capture file; safe to call from the reader and writer threads at the same time
+		/// </summary>
+		void Record(unsigned char direction, boost::shared_ptr<vector<unsigned char> > data);
+
+		long long RecordCount();
+
+		/// <summary>
+		/// Reads all the records of a capture file
+		/// </summary>
+		/// <returns>false if the file cannot be read or is not a capture file; records read before a truncated tail are kept</returns>
+		static bool Load(string fileName, vector<PacketCaptureRecord>& records);
+
+		/// <summary>
+		/// Reassembles the records of the given direction into whole framed packets (header byte, size and payload)
+		/// </summary>
+		/// <returns>false if the stream contains an invalid header or ends inside a packet</returns>
+		static bool SplitPackets(vector<PacketCaptureRecord>& records, unsigned char direction, vector<boost::shared_ptr<vector<unsigned char> > >& packets);
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		static const unsigned char DIRECTION_IN;
+		static const unsigned char DIRECTION_OUT;
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		static void WriteInteger(ofstream& stream, unsigned long long value, long int size);
+		static bool ReadInteger(ifstream& stream, unsigned long long& value, long int size);
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		static const char SIGNATURE[6];
+		static const unsigned char VERSION;
+
+		ofstream stream;
+		boost::posix_time::ptime startTime;
+		long long recordCount;
+		boost::mutex lockStream;
+	};
+
+}	// namespace Core
+}	// namespace Sfs2X
+
+#endif
@@ -9,18 +9,21 @@
 //
 // ===================================================================
 #include "SFSBuddyEvent.h"
+#include "../Util/KeyTable.h"
+
+using namespace Sfs2X::Util;
 
 namespace Sfs2X {
 namespace Core {
 
-boost::shared_ptr<string> SFSBuddyEvent::BUDDY_LIST_INIT (new string("buddyListInit"));
-boost::shared_ptr<string> SFSBuddyEvent::BUDDY_ADD (new string("buddyAdd"));
-boost::shared_ptr<string> SFSBuddyEvent::BUDDY_REMOVE (new string("buddyRemove"));
-boost::shared_ptr<string> SFSBuddyEvent::BUDDY_BLOCK (new string("buddyBlock"));
-boost::shared_ptr<string> SFSBuddyEvent::BUDDY_ERROR (new string("buddyError"));
-boost::shared_ptr<string> SFSBuddyEvent::BUDDY_ONLINE_STATE_UPDATE (new string("buddyOnlineStateChange"));
-boost::shared_ptr<string> SFSBuddyEvent::BUDDY_VARIABLES_UPDATE (new string("buddyVariablesUpdate"));
-boost::shared_ptr<string> SFSBuddyEvent::BUDDY_MESSAGE (new string("buddyMessage"));
+boost::shared_ptr<string> SFSBuddyEvent::BUDDY_LIST_INIT (KeyTable::Atom("buddyListInit"));
+boost::shared_ptr<string> SFSBuddyEvent::BUDDY_ADD (KeyTable::Atom("buddyAdd"));
+boost::shared_ptr<string> SFSBuddyEvent::BUDDY_REMOVE (KeyTable::Atom("buddyRemove"));
+boost::shared_ptr<string> SFSBuddyEvent::BUDDY_BLOCK (KeyTable::Atom("buddyBlock"));
+boost::shared_ptr<string> SFSBuddyEvent::BUDDY_ERROR (KeyTable::Atom("buddyError"));
+boost::shared_ptr<string> SFSBuddyEvent::BUDDY_ONLINE_STATE_UPDATE (KeyTable::Atom("buddyOnlineStateChange"));
+boost::shared_ptr<string> SFSBuddyEvent::BUDDY_VARIABLES_UPDATE (KeyTable::Atom("buddyVariablesUpdate"));
+boost::shared_ptr<string> SFSBuddyEvent::BUDDY_MESSAGE (KeyTable::Atom("buddyMessage"));
 
 // -------------------------------------------------------------------
 // Constructor
@@ -9,8 +9,10 @@
 //
 // ===================================================================
 #include "SFSEvent.h"
+#include "../Util/KeyTable.h"
 
 using namespace Sfs2X::Core;
+using namespace Sfs2X::Util;
 
 #if defined(_MSC_VER)
 #pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
@@ -22,59 +24,61 @@ using namespace std;					// STL library: declare the STL namespace
 namespace Sfs2X {
 namespace Core {
 
-boost::shared_ptr<string> SFSEvent::HANDSHAKE (new string("handshake"));
-boost::shared_ptr<string> SFSEvent::UDP_INIT (new string("udpInit"));
-boost::shared_ptr<string> SFSEvent::CONNECTION (new string("connection"));
-boost::shared_ptr<string> SFSEvent::PING_PONG (new string("pingPong"));
-boost::shared_ptr<string> SFSEvent::SFS_SOCKET_ERROR (new string("socketError"));
-boost::shared_ptr<string> SFSEvent::CONNECTION_LOST (new string("connectionLost"));
-boost::shared_ptr<string> SFSEvent::CONNECTION_RETRY (new string("connectionRetry"));
-boost::shared_ptr<string> SFSEvent::CONNECTION_RESUME (new string("connectionResume"));
-boost::shared_ptr<string> SFSEvent::CONNECTION_ATTEMPT_HTTP (new string("connectionAttemptHttp"));
-boost::shared_ptr<string> SFSEvent::CONFIG_LOAD_SUCCESS (new string("configLoadSuccess"));
-boost::shared_ptr<string> SFSEvent::CONFIG_LOAD_FAILURE (new string("configLoadFailure"));
-boost::shared_ptr<string> SFSEvent::LOGIN (new string("login"));
-boost::shared_ptr<string> SFSEvent::LOGIN_ERROR (new string("loginError"));
-boost::shared_ptr<string> SFSEvent::LOGOUT (new string("logout"));
-boost::shared_ptr<string> SFSEvent::ROOM_ADD (new string("roomAdd"));
-boost::shared_ptr<string> SFSEvent::ROOM_REMOVE (new string("roomRemove"));
-boost::shared_ptr<string> SFSEvent::ROOM_CREATION_ERROR (new string("roomCreationError"));
-boost::shared_ptr<string> SFSEvent::ROOM_JOIN (new string("roomJoin"));
-boost::shared_ptr<string> SFSEvent::ROOM_JOIN_ERROR (new string("roomJoinError"));
-boost::shared_ptr<string> SFSEvent::USER_ENTER_ROOM (new string("userEnterRoom"));
-boost::shared_ptr<string> SFSEvent::USER_EXIT_ROOM (new string("userExitRoom"));
-boost::shared_ptr<string> SFSEvent::USER_COUNT_CHANGE (new string("userCountChange"));
-boost::shared_ptr<string> SFSEvent::PUBLIC_MESSAGE (new string("publicMessage"));
-boost::shared_ptr<string> SFSEvent::PRIVATE_MESSAGE (new string("privateMessage"));
-boost::shared_ptr<string> SFSEvent::MODERATOR_MESSAGE (new string("moderatorMessage"));
-boost::shared_ptr<string> SFSEvent::ADMIN_MESSAGE (new string("adminMessage"));
-boost::shared_ptr<string> SFSEvent::OBJECT_MESSAGE (new string("objectMessage"));
-boost::shared_ptr<string> SFSEvent::EXTENSION_RESPONSE (new string("extensionResponse"));
-boost::shared_ptr<string> SFSEvent::ROOM_VARIABLES_UPDATE (new string("roomVariablesUpdate"));
-boost::shared_ptr<string> SFSEvent::USER_VARIABLES_UPDATE (new string("userVariablesUpdate"));
-boost::shared_ptr<string> SFSEvent::ROOM_GROUP_SUBSCRIBE (new string("roomGroupSubscribe"));
-boost::shared_ptr<string> SFSEvent::ROOM_GROUP_UNSUBSCRIBE (new string("roomGroupUnsubscribe"));
-boost::shared_ptr<string> SFSEvent::ROOM_GROUP_SUBSCRIBE_ERROR (new string("roomGroupSubscribeError"));
-boost::shared_ptr<string> SFSEvent::ROOM_GROUP_UNSUBSCRIBE_ERROR (new string("roomGroupUnsubscribeError"));
-boost::shared_ptr<string> SFSEvent::SPECTATOR_TO_PLAYER (new string("spectatorToPlayer"));
-boost::shared_ptr<string> SFSEvent::PLAYER_TO_SPECTATOR (new string("playerToSpectator"));
-boost::shared_ptr<string> SFSEvent::SPECTATOR_TO_PLAYER_ERROR (new string("spectatorToPlayerError"));
-boost::shared_ptr<string> SFSEvent::PLAYER_TO_SPECTATOR_ERROR (new string("playerToSpectatorError"));
-boost::shared_ptr<string> SFSEvent::ROOM_NAME_CHANGE (new string("roomNameChange"));
-boost::shared_ptr<string> SFSEvent::ROOM_NAME_CHANGE_ERROR (new string("roomNameChangeError"));
-boost::shared_ptr<string> SFSEvent::ROOM_PASSWORD_STATE_CHANGE (new string("roomPasswordStateChange"));
-boost::shared_ptr<string> SFSEvent::ROOM_PASSWORD_STATE_CHANGE_ERROR (new string("roomPasswordStateChangeError"));
-boost::shared_ptr<string> SFSEvent::ROOM_CAPACITY_CHANGE (new string("roomCapacityChange"));
-boost::shared_ptr<string> SFSEvent::ROOM_CAPACITY_CHANGE_ERROR (new string("roomCapacityChangeError"));
-boost::shared_ptr<string> SFSEvent::ROOM_FIND_RESULT (new string("roomFindResult"));
-boost::shared_ptr<string> SFSEvent::USER_FIND_RESULT (new string("userFindResult"));
-boost::shared_ptr<string> SFSEvent::INVITATION (new string("invitation"));
-boost::shared_ptr<string> SFSEvent::INVITATION_REPLY (new string("invitationReply"));
-boost::shared_ptr<string> SFSEvent::INVITATION_REPLY_ERROR (new string("invitationReplyError"));
-boost::shared_ptr<string> SFSEvent::DEBUG_MESSAGE (new string("debugMessage"));
-boost::shared_ptr<string> SFSEvent::PROXIMITY_LIST_UPDATE (new string("proximityListUpdate"));
-boost::shared_ptr<string> SFSEvent::MMOITEM_VARIABLES_UPDATE (new string("mmoItemVariablesUpdate"));
-boost::shared_ptr<string> SFSEvent::CRYPTO_INIT (new string("cryptoInit"));
+boost::shared_ptr<string> SFSEvent::HANDSHAKE (KeyTable::Atom("handshake"));
+boost::shared_ptr<string> SFSEvent::UDP_INIT (KeyTable::Atom("udpInit"));
+boost::shared_ptr<string> SFSEvent::CONNECTION (KeyTable::Atom("connection"));
+boost::shared_ptr<string> SFSEvent::PING_PONG (KeyTable::Atom("pingPong"));
+boost::shared_ptr<string> SFSEvent::SFS_SOCKET_ERROR (KeyTable::Atom("socketError"));
+boost::shared_ptr<string> SFSEvent::CONNECTION_LOST (KeyTable::Atom("connectionLost"));
+boost::shared_ptr<string> SFSEvent::CONNECTION_RETRY (KeyTable::Atom("connectionRetry"));
+boost::shared_ptr<string> SFSEvent::CONNECTION_RESUME (KeyTable::Atom("connectionResume"));
+boost::shared_ptr<string> SFSEvent::CONNECTION_ATTEMPT_HTTP (KeyTable::Atom("connectionAttemptHttp"));
+boost::shared_ptr<string> SFSEvent::CONFIG_LOAD_SUCCESS (KeyTable::Atom("configLoadSuccess"));
+boost::shared_ptr<string> SFSEvent::CONFIG_LOAD_FAILURE (KeyTable::Atom("configLoadFailure"));
+boost::shared_ptr<string> SFSEvent::LOGIN (KeyTable::Atom("login"));
+boost::shared_ptr<string> SFSEvent::LOGIN_ERROR (KeyTable::Atom("loginError"));
+boost::shared_ptr<string> SFSEvent::LOGOUT (KeyTable::Atom("logout"));
+boost::shared_ptr<string> SFSEvent::ROOM_ADD (KeyTable::Atom("roomAdd"));
+boost::shared_ptr<string> SFSEvent::ROOM_REMOVE (KeyTable::Atom("roomRemove"));
+boost::shared_ptr<string> SFSEvent::ROOM_CREATION_ERROR (KeyTable::Atom("roomCreationError"));
+boost::shared_ptr<string> SFSEvent::ROOM_JOIN (KeyTable::Atom("roomJoin"));
+boost::shared_ptr<string> SFSEvent::ROOM_JOIN_ERROR (KeyTable::Atom("roomJoinError"));
+boost::shared_ptr<string> SFSEvent::USER_ENTER_ROOM (KeyTable::Atom("userEnterRoom"));
+boost::shared_ptr<string> SFSEvent::USER_EXIT_ROOM (KeyTable::Atom("userExitRoom"));
+boost::shared_ptr<string> SFSEvent::USER_COUNT_CHANGE (KeyTable::Atom("userCountChange"));
+boost::shared_ptr<string> SFSEvent::PUBLIC_MESSAGE (KeyTable::Atom("publicMessage"));
+boost::shared_ptr<string> SFSEvent::PRIVATE_MESSAGE (KeyTable::Atom("privateMessage"));
+boost::shared_ptr<string> SFSEvent::MODERATOR_MESSAGE (KeyTable::Atom("moderatorMessage"));
+boost::shared_ptr<string> SFSEvent::ADMIN_MESSAGE (KeyTable::Atom("adminMessage"));
+boost::shared_ptr<string> SFSEvent::OBJECT_MESSAGE (KeyTable::Atom("objectMessage"));
+boost::shared_ptr<string> SFSEvent::EXTENSION_RESPONSE (KeyTable::Atom("extensionResponse"));
+boost::shared_ptr<string> SFSEvent::ROOM_VARIABLES_UPDATE (KeyTable::Atom("roomVariablesUpdate"));
+boost::shared_ptr<string> SFSEvent::USER_VARIABLES_UPDATE (KeyTable::Atom("userVariablesUpdate"));
+boost::shared_ptr<string> SFSEvent::ROOM_GROUP_SUBSCRIBE (KeyTable::Atom("roomGroupSubscribe"));
+boost::shared_ptr<string> SFSEvent::ROOM_GROUP_UNSUBSCRIBE (KeyTable::Atom("roomGroupUnsubscribe"));
+boost::shared_ptr<string> SFSEvent::ROOM_GROUP_SUBSCRIBE_ERROR (KeyTable::Atom("roomGroupSubscribeError"));
+boost::shared_ptr<string> SFSEvent::ROOM_GROUP_UNSUBSCRIBE_ERROR (KeyTable::Atom("roomGroupUnsubscribeError"));
+boost::shared_ptr<string> SFSEvent::SPECTATOR_TO_PLAYER (KeyTable::Atom("spectatorToPlayer"));
+boost::shared_ptr<string> SFSEvent::PLAYER_TO_SPECTATOR (KeyTable::Atom("playerToSpectator"));
+boost::shared_ptr<string> SFSEvent::SPECTATOR_TO_PLAYER_ERROR (KeyTable::Atom("spectatorToPlayerError"));
+boost::shared_ptr<string> SFSEvent::PLAYER_TO_SPECTATOR_ERROR (KeyTable::Atom("playerToSpectatorError"));
+boost::shared_ptr<string> SFSEvent::ROOM_NAME_CHANGE (KeyTable::Atom("roomNameChange"));
+boost::shared_ptr<string> SFSEvent::ROOM_NAME_CHANGE_ERROR (KeyTable::Atom("roomNameChangeError"));
+boost::shared_ptr<string> SFSEvent::ROOM_PASSWORD_STATE_CHANGE (KeyTable::Atom("roomPasswordStateChange"));
+boost::shared_ptr<string> SFSEvent::ROOM_PASSWORD_STATE_CHANGE_ERROR (KeyTable::Atom("roomPasswordStateChangeError"));
+boost::shared_ptr<string> SFSEvent::ROOM_CAPACITY_CHANGE (KeyTable::Atom("roomCapacityChange"));
+boost::shared_ptr<string> SFSEvent::ROOM_CAPACITY_CHANGE_ERROR (KeyTable::Atom("roomCapacityChangeError"));
+boost::shared_ptr<string> SFSEvent::ROOM_FIND_RESULT (KeyTable::Atom("roomFindResult"));
+boost::shared_ptr<string> SFSEvent::USER_FIND_RESULT (KeyTable::Atom("userFindResult"));
+boost::shared_ptr<string> SFSEvent::INVITATION (KeyTable::Atom("invitation"));
+boost::shared_ptr<string> SFSEvent::INVITATION_REPLY (KeyTable::Atom("invitationReply"));
+boost::shared_ptr<string> SFSEvent::INVITATION_REPLY_ERROR (KeyTable::Atom("invitationReplyError"));
+boost::shared_ptr<string> SFSEvent::DEBUG_MESSAGE (KeyTable::Atom("debugMessage"));
+boost::shared_ptr<string> SFSEvent::PROXIMITY_LIST_UPDATE (KeyTable::Atom("proximityListUpdate"));
+boost::shared_ptr<string> SFSEvent::MMOITEM_VARIABLES_UPDATE (KeyTable::Atom("mmoItemVariablesUpdate"));
+boost::shared_ptr<string> SFSEvent::CRYPTO_INIT (KeyTable::Atom("cryptoInit"));
+boost::shared_ptr<string> SFSEvent::OUTBOUND_CONGESTION (KeyTable::Atom("outboundCongestion"));
+boost::shared_ptr<string> SFSEvent::EXTENSION_REQUEST_FAILED (KeyTable::Atom("extensionRequestFailed"));
 
 // -------------------------------------------------------------------
 // Constructor
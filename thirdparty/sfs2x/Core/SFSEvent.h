@@ -1146,6 +1146,10 @@ namespace Core {
 		///     <term>packetId</term>
 		///     <description>(<b>long</b>) (optional) the id of the packet for an UDP message, the id is an auto increment value sent by the server. It can be used to detect out of order UDP packets.</description>
 		///   </item>
+		///   <item>
+		///     <term>requestId</term>
+		///     <description>(<b>long int</b>) (optional) the id of the request sent by <see cref="Sfs2X.SmartFox.SendAsync"/> that the message answers, when the Extension has returned it.</description>
+		///   </item>
 		/// </list>
 		/// </remarks>
         /// <seealso cref="Requests.ExtensionRequest"/>
@@ -1801,6 +1805,66 @@ namespace Core {
 		/// <seealso cref="Sfs2X.SmartFox.InitCrypto()"/>
 		static boost::shared_ptr<string> CRYPTO_INIT;
 
+		/// <summary>
+		/// Dispatched when the outgoing data crosses one of the send watermarks.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The event is fired once when the bytes waiting to be sent reach the high watermark, and once more when they fall back to the low watermark:
+		/// in between the link is saturated, and optional traffic (chat, cosmetic updates) should be held back by the application.
+		/// The watermarks are set by <see cref="Sfs2X.SmartFox.SendWatermarks"/>.
+		/// <para/>
+		/// The <see cref="BaseEvent.Params"/> object contains the following parameters:
+		/// <list type="table">
+		///   <listheader>
+		///     <term>Parameter</term>
+		///     <description>Description</description>
+		///   </listheader>
+		///   <item>
+		///     <term>congested</term>
+		///     <description>(<b>bool</b>) <c>true</c> if the high watermark has been reached, <c>false</c> if the output has drained to the low watermark.</description>
+		///   </item>
+		///   <item>
+		///     <term>pendingBytes</term>
+		///     <description>(<b>long int</b>) The quantity of bytes waiting to be sent when the event was fired.</description>
+		///   </item>
+		/// </list>
+		/// </remarks>
+		/// 
+		/// <seealso cref="Sfs2X.SmartFox.PendingSendBytes"/>
+		static boost::shared_ptr<string> OUTBOUND_CONGESTION;
+
+		/// <summary>
+		/// Dispatched when a request sent by <see cref="Sfs2X.SmartFox.SendAsync"/> will not receive its response.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The event is also passed to the callback of the request. A response arriving after the event is still dispatched as an <see cref="EXTENSION_RESPONSE"/>.
+		/// <para/>
+		/// The <see cref="BaseEvent.Params"/> object contains the following parameters:
+		/// <list type="table">
+		///   <listheader>
+		///     <term>Parameter</term>
+		///     <description>Description</description>
+		///   </listheader>
+		///   <item>
+		///     <term>requestId</term>
+		///     <description>(<b>long int</b>) The id returned by <see cref="Sfs2X.SmartFox.SendAsync"/>.</description>
+		///   </item>
+		///   <item>
+		///     <term>cmd</term>
+		///     <description>(<b>string</b>) The command of the request.</description>
+		///   </item>
+		///   <item>
+		///     <term>reason</term>
+		///     <description>(<b>string</b>) "timeout" if no response has arrived in time, "cancelled" if the request has been cancelled by <see cref="Sfs2X.SmartFox.CancelAsync"/>, "connectionLost" if the connection has been closed.</description>
+		///   </item>
+		/// </list>
+		/// </remarks>
+		/// 
+		/// <seealso cref="EXTENSION_RESPONSE"/>
+		static boost::shared_ptr<string> EXTENSION_REQUEST_FAILED;
+
 	protected:
 
 		// -------------------------------------------------------------------
@@ -1,5 +1,6 @@
 #include "SFSIOHandler.h"
 #include "DefaultPacketEncrypter.h"
+#include "../Requests/RequestType.h"
 
 namespace Sfs2X {
 namespace Core {
@@ -7,10 +8,70 @@ namespace Core {
 const long int SFSIOHandler::SHORT_BYTE_SIZE = 2;
 const long int SFSIOHandler::INT_BYTE_SIZE = 4;
 
+// Next state by current state (rows) and transition (columns)
+const SFSIOHandler::ReadStateTable::Table SFSIOHandler::READ_STATE_TABLE =
+{
+	// PACKETREADSTATE_WAIT_NEW_PACKET
+	{
+		PACKETREADSTATE_WAIT_DATA_SIZE,				// PacketReadTransition_HeaderReceived
+		PACKETREADSTATE_WAIT_NEW_PACKET,			// PacketReadTransition_SizeReceived
+		PACKETREADSTATE_WAIT_NEW_PACKET,			// PacketReadTransition_IncompleteSize
+		PACKETREADSTATE_WAIT_NEW_PACKET,			// PacketReadTransition_WholeSizeReceived
+		PACKETREADSTATE_WAIT_NEW_PACKET,			// PacketReadTransition_PacketFinished
+		PACKETREADSTATE_WAIT_NEW_PACKET,			// PacketReadTransition_InvalidData
+		PACKETREADSTATE_WAIT_NEW_PACKET				// PacketReadTransition_InvalidDataFinished
+	},
+
+	// PACKETREADSTATE_WAIT_DATA_SIZE
+	{
+		PACKETREADSTATE_WAIT_DATA_SIZE,				// PacketReadTransition_HeaderReceived
+		PACKETREADSTATE_WAIT_DATA,					// PacketReadTransition_SizeReceived
+		PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT,	// PacketReadTransition_IncompleteSize
+		PACKETREADSTATE_WAIT_DATA_SIZE,				// PacketReadTransition_WholeSizeReceived
+		PACKETREADSTATE_WAIT_DATA_SIZE,				// PacketReadTransition_PacketFinished
+		PACKETREADSTATE_WAIT_DATA_SIZE,				// PacketReadTransition_InvalidData
+		PACKETREADSTATE_WAIT_DATA_SIZE				// PacketReadTransition_InvalidDataFinished
+	},
+
+	// PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT
+	{
+		PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT,	// PacketReadTransition_HeaderReceived
+		PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT,	// PacketReadTransition_SizeReceived
+		PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT,	// PacketReadTransition_IncompleteSize
+		PACKETREADSTATE_WAIT_DATA,					// PacketReadTransition_WholeSizeReceived
+		PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT,	// PacketReadTransition_PacketFinished
+		PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT,	// PacketReadTransition_InvalidData
+		PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT		// PacketReadTransition_InvalidDataFinished
+	},
+
+	// PACKETREADSTATE_WAIT_DATA
+	{
+		PACKETREADSTATE_WAIT_DATA,					// PacketReadTransition_HeaderReceived
+		PACKETREADSTATE_WAIT_DATA,					// PacketReadTransition_SizeReceived
+		PACKETREADSTATE_WAIT_DATA,					// PacketReadTransition_IncompleteSize
+		PACKETREADSTATE_WAIT_DATA,					// PacketReadTransition_WholeSizeReceived
+		PACKETREADSTATE_WAIT_NEW_PACKET,			// PacketReadTransition_PacketFinished
+		PACKETREADSTATE_INVALID_DATA,				// PacketReadTransition_InvalidData
+		PACKETREADSTATE_WAIT_DATA					// PacketReadTransition_InvalidDataFinished
+	},
+
+	// PACKETREADSTATE_INVALID_DATA
+	{
+		PACKETREADSTATE_INVALID_DATA,				// PacketReadTransition_HeaderReceived
+		PACKETREADSTATE_INVALID_DATA,				// PacketReadTransition_SizeReceived
+		PACKETREADSTATE_INVALID_DATA,				// PacketReadTransition_IncompleteSize
+		PACKETREADSTATE_INVALID_DATA,				// PacketReadTransition_WholeSizeReceived
+		PACKETREADSTATE_INVALID_DATA,				// PacketReadTransition_PacketFinished
+		PACKETREADSTATE_INVALID_DATA,				// PacketReadTransition_InvalidData
+		PACKETREADSTATE_WAIT_NEW_PACKET				// PacketReadTransition_InvalidDataFinished
+	}
+};
+
 // ------------------------------------------------------------------- 
 // Constructor
 // -------------------------------------------------------------------
 SFSIOHandler::SFSIOHandler(boost::shared_ptr<BitSwarmClient> bitSwarm)
+	: fsm(READ_STATE_TABLE, PACKETREADSTATE_WAIT_NEW_PACKET)
 {
 	skipBytes = 0;
 	EMPTY_BUFFER = boost::shared_ptr<ByteArray>(new ByteArray());
@@ -75,7 +136,7 @@ boost::shared_ptr<IProtocolCodec> SFSIOHandler::Codec()
 // -------------------------------------------------------------------
 PacketReadState SFSIOHandler::ReadState()
 {
-	return (PacketReadState)fsm->GetCurrentState();
+	return fsm.GetCurrentState();
 }
 
 // -------------------------------------------------------------------
@@ -83,25 +144,8 @@ PacketReadState SFSIOHandler::ReadState()
 // -------------------------------------------------------------------
 void SFSIOHandler::InitStates()
 {
-	fsm = boost::shared_ptr<FiniteStateMachine>(new FiniteStateMachine());
-
-	std::vector<long int> states;
-	for (long int enumerator = PACKETREADSTATE_WAIT_NEW_PACKET; enumerator <= PACKETREADSTATE_INVALID_DATA; enumerator++)
-	{
-		states.push_back(enumerator);
-	}
-	fsm->AddAllStates(states);
-						
-	fsm->AddStateTransition(PACKETREADSTATE_WAIT_NEW_PACKET, PACKETREADSTATE_WAIT_DATA_SIZE, PacketReadTransition_HeaderReceived);
-	fsm->AddStateTransition(PACKETREADSTATE_WAIT_DATA_SIZE, PACKETREADSTATE_WAIT_DATA, PacketReadTransition_SizeReceived);
-	fsm->AddStateTransition(PACKETREADSTATE_WAIT_DATA_SIZE, PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT, PacketReadTransition_IncompleteSize);
-	fsm->AddStateTransition(PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT, PACKETREADSTATE_WAIT_DATA, PacketReadTransition_WholeSizeReceived);
-	fsm->AddStateTransition(PACKETREADSTATE_WAIT_DATA, PACKETREADSTATE_WAIT_NEW_PACKET, PacketReadTransition_PacketFinished);
-			
-	fsm->AddStateTransition(PACKETREADSTATE_WAIT_DATA, PACKETREADSTATE_INVALID_DATA, PacketReadTransition_InvalidData);
-	fsm->AddStateTransition(PACKETREADSTATE_INVALID_DATA, PACKETREADSTATE_WAIT_NEW_PACKET, PacketReadTransition_InvalidDataFinished);
-		
-	fsm->SetCurrentState(PACKETREADSTATE_WAIT_NEW_PACKET);
+	// The transitions are the constant READ_STATE_TABLE
+	fsm.SetCurrentState(PACKETREADSTATE_WAIT_NEW_PACKET);
 }
 
 // -------------------------------------------------------------------
@@ -133,29 +177,36 @@ void SFSIOHandler::OnDataRead(boost::shared_ptr<ByteArray> data)
 		}
 	}		
 			
+	if (bitSwarm != NULL && bitSwarm->PacketCapture() != NULL)
+	{
+		bitSwarm->PacketCapture()->Record(PacketCapture::DIRECTION_IN, data->Bytes());
+	}
+
 	data->Position(0);
 								
 	while (data->Length() > 0)
 	{
-		if (ReadState() == PACKETREADSTATE_WAIT_NEW_PACKET) 
+		switch (ReadState())
 		{
+		case PACKETREADSTATE_WAIT_NEW_PACKET:
 			data = HandleNewPacket(data);
-		}
-		else if (ReadState() == PACKETREADSTATE_WAIT_DATA_SIZE) 
-		{
+			break;
+
+		case PACKETREADSTATE_WAIT_DATA_SIZE:
 			data = HandleDataSize(data);
-		} 
-		else if (ReadState() == PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT) 
-		{
+			break;
+
+		case PACKETREADSTATE_WAIT_DATA_SIZE_FRAGMENT:
 			data = HandleDataSizeFragment(data);
-		}
-		else if (ReadState() == PACKETREADSTATE_WAIT_DATA)
-		{
+			break;
+
+		case PACKETREADSTATE_WAIT_DATA:
 			data = HandlePacketData(data);
-		}
-		else if (ReadState() == PACKETREADSTATE_INVALID_DATA) 
-		{
+			break;
+
+		case PACKETREADSTATE_INVALID_DATA:
 			data = HandleInvalidData(data);
+			break;
 		}
 	}			
 }
@@ -178,7 +229,7 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandleNewPacket(boost::shared_ptr<Byt
 	unsigned char headerByte;
 	data->ReadByte(headerByte);
 			
-	if (~(headerByte & 128) > 0) 
+	if (!(headerByte & 128)) 
 	{
 		// NOTE: Added extra debug info, for unexpected packets
 		boost::shared_ptr<string> logMessage (new string());
@@ -196,7 +247,7 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandleNewPacket(boost::shared_ptr<Byt
 	pendingPacket = boost::shared_ptr<PendingPacket>(new PendingPacket(header));
 			
 	// Change state
-	fsm->ApplyTransition(PacketReadTransition_HeaderReceived);
+	fsm.ApplyTransition(PacketReadTransition_HeaderReceived);
 			
 	// Resize the array
 	return ResizeByteArray(data, 1, data->Length()-1);
@@ -256,12 +307,12 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandleDataSize(boost::shared_ptr<Byte
 		pendingPacket->Header()->ExpectedLength(dataSize);
 		data = ResizeByteArray(data, sizeBytes, data->Length() - sizeBytes);
 				
-		fsm->ApplyTransition(PacketReadTransition_SizeReceived);
+		fsm.ApplyTransition(PacketReadTransition_SizeReceived);
 	}
 	// We didn't decode the whole size
 	else
 	{
-		fsm->ApplyTransition(PacketReadTransition_IncompleteSize);
+		fsm.ApplyTransition(PacketReadTransition_IncompleteSize);
 		// Store the data we have
 		pendingPacket->Buffer()->WriteBytes(data->Bytes());
 				
@@ -294,19 +345,18 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandleDataSizeFragment(boost::shared_
 		pendingPacket->Buffer()->WriteBytes(data->Bytes(), 0, remaining);
 								
 		long int neededLength = pendingPacket->Header()->BigSized() ? 4 : 2;
-		boost::shared_ptr<ByteArray> size (new ByteArray());
-		size->WriteBytes(pendingPacket->Buffer()->Bytes(), 0, neededLength);
-		size->Position(0);
+		ByteReader size (&(*pendingPacket->Buffer()->Bytes())[0], neededLength);
 		boost::int32_t dataSize;
 		if (pendingPacket->Header()->BigSized())
 		{
-			size->ReadInt(dataSize);
+			size.ReadInt(dataSize);
 		}
 		else
 		{
-			short int dataSizeShort;
-			size->ReadShort(dataSizeShort);
-			dataSize = dataSizeShort;
+			// Small sizes are unsigned, as in HandleDataSize
+			unsigned short int dataSizeUShort;
+			size.ReadUShort(dataSizeUShort);
+			dataSize = dataSizeUShort;
 		}
 
 		logMessages->clear();
@@ -324,7 +374,7 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandleDataSizeFragment(boost::shared_
 		pendingPacket->Buffer(value);
 								
 		// Next state
-		fsm->ApplyTransition(PacketReadTransition_WholeSizeReceived);
+		fsm.ApplyTransition(PacketReadTransition_WholeSizeReceived);
 				
 		// Remove bytes that were analyzed
 		if (data->Length() > remaining) 
@@ -387,13 +437,13 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandlePacketData(boost::shared_ptr<By
 			// Handle compression
 			if (pendingPacket->Header()->Compressed())
 			{
-				pendingPacket->Buffer()->Uncompress();
+				pendingPacket->Buffer()->Uncompress(compressor);
 			}
 					
 			// Send to protocol codec
 			protocolCodec->OnPacketRead(pendingPacket->Buffer());
 					
-			fsm->ApplyTransition(PacketReadTransition_PacketFinished);
+			fsm.ApplyTransition(PacketReadTransition_PacketFinished);
 		}
 				
 		// Not enough data to complete the packet
@@ -412,7 +462,7 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandlePacketData(boost::shared_ptr<By
 			data = EMPTY_BUFFER;
 		}	
 	}
-	catch (exception ex) 
+	catch (const exception& ex) 
 	{
 		boost::shared_ptr<vector<string> > logMessages (new vector<string>());
 		boost::shared_ptr<string> logMessage (new string());
@@ -425,7 +475,7 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandlePacketData(boost::shared_ptr<By
 		
 		// Save how many bytes we should skip
 		skipBytes = remaining;				
-		fsm->ApplyTransition(PacketReadTransition_InvalidData);
+		fsm.ApplyTransition(PacketReadTransition_InvalidData);
 		return currentData;
 	}
 			
@@ -439,7 +489,7 @@ boost::shared_ptr<ByteArray> SFSIOHandler::HandleInvalidData(boost::shared_ptr<B
 {
 	if (skipBytes == 0) 
 	{
-		fsm->ApplyTransition(PacketReadTransition_InvalidDataFinished);
+		fsm.ApplyTransition(PacketReadTransition_InvalidDataFinished);
 		return data;
 	}
 			
@@ -477,7 +527,7 @@ void SFSIOHandler::WriteBinaryData(unsigned long long context, boost::shared_ptr
 	// 1. Handle Compression
 	if (header->Compressed())	
 	{
-		binData->Compress();
+		binData->Compress(instance->compressor);
 	}	
 			
 	// B. Handle Encryption
@@ -486,21 +536,30 @@ void SFSIOHandler::WriteBinaryData(unsigned long long context, boost::shared_ptr
 		instance->packetEncrypter->Encrypt(binData);
 	}
 
+	// Header byte, size and data are written as one block
+	long int sizeBytes = header->BigSized() ? INT_BYTE_SIZE : SHORT_BYTE_SIZE;
+	ByteWriter writer = writeBuffer->Writer(1 + sizeBytes + binData->Length());
+
 	// 1. Write packet header byte
-	writeBuffer->WriteByte(header->Encode());
+	writer.WriteByte(header->Encode());
 			
 	// 2. Write packet size
 	if (header->BigSized()) 
 	{
-		writeBuffer->WriteInt(binData->Length());
+		writer.WriteInt(binData->Length());
 	}		
 	else 
 	{
-		writeBuffer->WriteUShort((unsigned short int)(binData->Length()));
+		writer.WriteUShort((unsigned short int)(binData->Length()));
 	}
 			
 	// 3. Write actual packet data
-	writeBuffer->WriteBytes(binData->Bytes());
+	writer.WriteBytes(binData->Length() > 0 ? &(*binData->Bytes())[0] : NULL, binData->Length());
+
+	if (instance->bitSwarm->PacketCapture() != NULL)
+	{
+		instance->bitSwarm->PacketCapture()->Record(PacketCapture::DIRECTION_OUT, writeBuffer->Bytes());
+	}
 				
 	// 4. Send in hyperspace!
 	if (instance->bitSwarm->UseBlueBox()) 
@@ -528,7 +587,10 @@ void SFSIOHandler::OnDataWrite(boost::shared_ptr<IMessage> message)
 	boost::shared_ptr<ByteArray> binData = message->Content()->ToBinary();
 			
 	bool compress = binData->Length() > bitSwarm->CompressionThreshold();
-	bool encrypt = bitSwarm->CryptoKey() != NULL && !bitSwarm->IsReconnecting();
+	// The crypto session survives a reconnection: only the reconnection handshake itself travels in clear,
+	// any other message is encrypted with the key negotiated at login
+	bool isReconnectionHandshake = bitSwarm->IsReconnecting() && message->TargetController() == 0 && message->Id() == Sfs2X::Requests::RequestType_Handshake;
+	bool encrypt = bitSwarm->CryptoKey() != NULL && !isReconnectionHandshake;
 			
 	if (binData->Length() > bitSwarm->MaxMessageSize()) 
 	{
@@ -571,7 +633,7 @@ void SFSIOHandler::OnDataWrite(boost::shared_ptr<IMessage> message)
 	boost::shared_ptr<WriteBinaryDataDelegate> callback (new WriteBinaryDataDelegate(&SFSIOHandler::WriteBinaryData, (unsigned long long)this));
 	boost::shared_ptr<bool> isUDP (new bool());
 	*isUDP = message->IsUDP();
-	this->bitSwarm->ThreadManager()->EnqueueSend(callback, packetHeader, binData, isUDP);
+	this->bitSwarm->ThreadManager()->EnqueueSend(callback, packetHeader, binData, isUDP, message->ReplacementKey());
 }
 
 // -------------------------------------------------------------------
@@ -11,7 +11,7 @@
 #ifndef __SFSIOHandler__
 #define __SFSIOHandler__
 
-#include "../FSM/FiniteStateMachine.h"
+#include "../FSM/StateTable.h"
 #include "../Bitswarm/BitSwarmClient.h"
 #include "../Bitswarm/PendingPacket.h"
 #include "../Bitswarm/PacketReadState.h"
@@ -22,6 +22,7 @@
 #include "../Exceptions/SFSError.h"
 #include "../Core/SFSProtocolCodec.h"
 #include "IPacketEncrypter.h"
+#include "../Util/ZlibCompressor.h"
 
 #include <boost/shared_ptr.hpp>					// Boost Asio shared pointer
 #include <boost/enable_shared_from_this.hpp>	// Boost shared_ptr for this
@@ -78,6 +79,9 @@ namespace Core {
 		static const long int SHORT_BYTE_SIZE;
 		static const long int INT_BYTE_SIZE;
 
+		static const long int READ_STATES = PACKETREADSTATE_INVALID_DATA + 1;
+		static const long int READ_TRANSITIONS = PacketReadTransition_InvalidDataFinished + 1;
+
 	protected:
 
 		// -------------------------------------------------------------------
@@ -90,6 +94,12 @@ namespace Core {
 
 	private:
 
+		// -------------------------------------------------------------------
+		// Private types
+		// -------------------------------------------------------------------
+
+		typedef StateTable<PacketReadState, PacketReadTransition, READ_STATES, READ_TRANSITIONS> ReadStateTable;
+
 		// -------------------------------------------------------------------
 		// Private methods
 		// -------------------------------------------------------------------
@@ -115,8 +125,10 @@ namespace Core {
 		boost::shared_ptr<PendingPacket> pendingPacket;
 		boost::shared_ptr<IProtocolCodec> protocolCodec; 
 		long int skipBytes;
-		boost::shared_ptr<FiniteStateMachine> fsm;
+		ReadStateTable fsm;							// Only the reader thread drives the packet state, so the table takes no lock
+		static const ReadStateTable::Table READ_STATE_TABLE;
 		boost::shared_ptr<IPacketEncrypter> packetEncrypter;
+		ZlibCompressor compressor;				// Inbound packets are uncompressed by the reader thread, outbound ones compressed by the sender thread
 	};
 
 }	// namespace Core
@@ -9,15 +9,16 @@
 //
 // ===================================================================
 #include "SFSProtocolCodec.h"
+#include "../Util/KeyTable.h"
 
 namespace Sfs2X {
 namespace Core {
 	
-boost::shared_ptr<string> SFSProtocolCodec::CONTROLLER_ID (new string("c"));
-boost::shared_ptr<string> SFSProtocolCodec::ACTION_ID (new string("a"));
-boost::shared_ptr<string> SFSProtocolCodec::PARAM_ID (new string("p"));
-boost::shared_ptr<string> SFSProtocolCodec::USER_ID (new string("u"));				// UDP Only
-boost::shared_ptr<string> SFSProtocolCodec::UDP_PACKET_ID (new string("i"));		// UDP Only
+boost::shared_ptr<string> SFSProtocolCodec::CONTROLLER_ID (KeyTable::Atom("c"));
+boost::shared_ptr<string> SFSProtocolCodec::ACTION_ID (KeyTable::Atom("a"));
+boost::shared_ptr<string> SFSProtocolCodec::PARAM_ID (KeyTable::Atom("p"));
+boost::shared_ptr<string> SFSProtocolCodec::USER_ID (KeyTable::Atom("u"));				// UDP Only
+boost::shared_ptr<string> SFSProtocolCodec::UDP_PACKET_ID (KeyTable::Atom("i"));		// UDP Only
 
 // -------------------------------------------------------------------
 // Constructor
@@ -87,7 +88,19 @@ void SFSProtocolCodec::OnPacketRead(boost::shared_ptr<ISFSObject> packet)
 // -------------------------------------------------------------------
 void SFSProtocolCodec::OnPacketRead(boost::shared_ptr<ByteArray> packet)
 {
-	boost::shared_ptr<ISFSObject> sfsObj = SFSObject::NewFromBinaryData(packet);
+	boost::shared_ptr<ISFSObject> sfsObj;
+
+	if (bitSwarm->UsePacketArena())
+	{
+		// Decoded objects take a few times the size of their binary form; the arena grows by chunks of that size
+		size_t chunkSize = (size_t)packet->Length() * 4;
+		boost::shared_ptr<PacketArena> arena (new PacketArena(chunkSize < PacketArena::DEFAULT_CHUNK_SIZE ? chunkSize : PacketArena::DEFAULT_CHUNK_SIZE));
+		sfsObj = DefaultSFSDataSerializer::Instance()->Binary2Object(packet, arena);
+	}
+	else
+	{
+		sfsObj = SFSObject::NewFromBinaryData(packet);
+	}
 									
 	// Create a Request and dispatch to ProtocolCodec
 	DispatchRequest(sfsObj);
@@ -128,14 +141,10 @@ boost::shared_ptr<ISFSObject> SFSProtocolCodec::PrepareTCPPacket(boost::shared_p
 	boost::shared_ptr<ISFSObject> sfsObj (new SFSObject());
 			
 	// Target controller
-	boost::shared_ptr<unsigned char> valueTargetController (new unsigned char());
-	*valueTargetController = (unsigned char)(message->TargetController());
-	sfsObj->PutByte(CONTROLLER_ID, valueTargetController);
+	sfsObj->PutByte(CONTROLLER_ID, (unsigned char)(message->TargetController()));
 			
 	// Action id
-	boost::shared_ptr<short int> valueActionId (new short int());
-	*valueActionId = (short int)message->Id();
-	sfsObj->PutShort(ACTION_ID, valueActionId);
+	sfsObj->PutShort(ACTION_ID, (short int)message->Id());
 			
 	// Params
 	sfsObj->PutSFSObject(PARAM_ID, message->Content());
@@ -151,19 +160,13 @@ boost::shared_ptr<ISFSObject> SFSProtocolCodec::PrepareUDPPacket(boost::shared_p
 	boost::shared_ptr<ISFSObject> sfsObj (new SFSObject());
 				
 	// Target controller
-	boost::shared_ptr<unsigned char> valueTargetController (new unsigned char());
-	*valueTargetController = (unsigned char)(message->TargetController());
-	sfsObj->PutByte(CONTROLLER_ID, valueTargetController);
+	sfsObj->PutByte(CONTROLLER_ID, (unsigned char)(message->TargetController()));
 			
 	// User id: in case we're not logged in the packet will sent with UID = -1, and the server will refuse it
-	boost::shared_ptr<long int> valueUserId (new long int());
-	*valueUserId = bitSwarm->Sfs()->MySelf() != NULL ? bitSwarm->Sfs()->MySelf()->Id() : -1;
-	sfsObj->PutInt(USER_ID, valueUserId);
+	sfsObj->PutInt(USER_ID, (long int)(bitSwarm->Sfs()->MySelf() != NULL ? bitSwarm->Sfs()->MySelf()->Id() : -1));
 			
 	// Packet id	
-	boost::shared_ptr<long long> valuePacketId (new long long());
-	*valuePacketId = bitSwarm->NextUdpPacketId();
-	sfsObj->PutLong(UDP_PACKET_ID, valuePacketId);
+	sfsObj->PutLong(UDP_PACKET_ID, (long long)bitSwarm->NextUdpPacketId());
 				
 	// Params
 	sfsObj->PutSFSObject(PARAM_ID, message->Content());
@@ -195,14 +198,14 @@ void SFSProtocolCodec::DispatchRequest(boost::shared_ptr<ISFSObject> requestObje
 	}
 			
 			
-	message->Id((long int)(*(requestObject->GetShort(ACTION_ID))));
+	message->Id((long int)(requestObject->GetShortOr(*ACTION_ID, 0)));
 	message->Content(requestObject->GetSFSObject(PARAM_ID));
 	message->IsUDP(requestObject->ContainsKey(UDP_PACKET_ID));
 			
 	if (message->IsUDP())
-		message->PacketId(*(requestObject->GetLong(UDP_PACKET_ID)));
+		message->PacketId(requestObject->GetLongOr(*UDP_PACKET_ID, 0));
 			
-	int controllerId = *(requestObject->GetByte(CONTROLLER_ID));
+	int controllerId = requestObject->GetByteOr(*CONTROLLER_ID, 0);
 	boost::shared_ptr<IController> controller = bitSwarm->GetController(controllerId);
 			
 	if (controller == NULL) 
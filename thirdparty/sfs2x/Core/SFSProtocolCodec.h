@@ -19,11 +19,14 @@
 #include "../Exceptions/SFSCodecError.h"
 #include "../Entities/Data/ISFSObject.h"
 #include "../Entities/Data/SFSObject.h"
+#include "../Protocol/Serialization/DefaultSFSDataSerializer.h"
+#include "../Util/PacketArena.h"
 
 #include <boost/shared_ptr.hpp>				// Boost Asio shared pointer
 
 using namespace Sfs2X::Bitswarm;
 using namespace Sfs2X::Protocol;
+using namespace Sfs2X::Protocol::Serialization;
 using namespace Sfs2X::Logging;
 
 using namespace Sfs2X::Entities::Data;
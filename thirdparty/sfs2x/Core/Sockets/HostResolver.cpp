@@ -0,0 +1,344 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of HostResolver
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "HostResolver.h"
+
+namespace Sfs2X {
+namespace Core {
+namespace Sockets {
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+HostResolver::HostResolver()
+{
+	cacheLifetime = DEFAULT_CACHE_LIFETIME;
+	isDisposed = false;
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+HostResolver::~HostResolver()
+{
+	Dispose();
+}
+
+// -------------------------------------------------------------------
+// Dispose
+// -------------------------------------------------------------------
+void HostResolver::Dispose()
+{
+	boost::shared_ptr<boost::thread> stoppedWorker;
+
+	{
+		boost::lock_guard<boost::mutex> lock(mtxResolver);
+
+		isDisposed = true;
+		boostWork = boost::shared_ptr<boost::asio::io_service::work>();
+		stoppedWorker = worker;
+		worker = boost::shared_ptr<boost::thread>();
+	}
+
+	if (stoppedWorker == NULL)
+	{
+		return;
+	}
+
+	boostIoService.stop();
+
+	// A callback running on the resolver thread can dispose the resolver: that thread cannot wait for itself
+	if (stoppedWorker->get_id() == boost::this_thread::get_id())
+	{
+		stoppedWorker->detach();
+	}
+	else
+	{
+		stoppedWorker->join();
+	}
+}
+
+// -------------------------------------------------------------------
+// CacheLifetime
+// -------------------------------------------------------------------
+long int HostResolver::CacheLifetime()
+{
+	return cacheLifetime;
+}
+
+// -------------------------------------------------------------------
+// CacheLifetime
+// -------------------------------------------------------------------
+void HostResolver::CacheLifetime(long int value)
+{
+	cacheLifetime = value;
+}
+
+// -------------------------------------------------------------------
+// ClearCache
+// -------------------------------------------------------------------
+void HostResolver::ClearCache()
+{
+	boost::lock_guard<boost::mutex> lock(mtxResolver);
+	cache.clear();
+}
+
+// -------------------------------------------------------------------
+// Resolve
+// -------------------------------------------------------------------
+boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > HostResolver::Resolve(string host, bool forceIPv6)
+{
+	bool isExpired = false;
+
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses = Lookup(host, forceIPv6, &isExpired);
+	if (addresses != NULL)
+	{
+		// The expired addresses are most likely still valid: they are used while the asynchronous lookup refreshes them
+		if (isExpired == true)
+		{
+			ResolveAsync(host, forceIPv6, boost::shared_ptr<HostResolvedDelegate>());
+		}
+
+		return addresses;
+	}
+
+	boost::asio::io_service service;
+	tcp::resolver resolver(service);
+
+	addresses = OrderAddresses(resolver.resolve(CreateQuery(host, forceIPv6)), forceIPv6);
+	if (addresses->size() == 0)
+	{
+		boost::throw_exception(boost::enable_error_info(std::runtime_error("Unable to get IP address")));
+	}
+
+	Store(host, forceIPv6, addresses);
+
+	return addresses;
+}
+
+// -------------------------------------------------------------------
+// ResolveAsync
+// -------------------------------------------------------------------
+void HostResolver::ResolveAsync(string host, bool forceIPv6, boost::shared_ptr<HostResolvedDelegate> callback)
+{
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses = Lookup(host, forceIPv6, NULL);
+	if (addresses != NULL)
+	{
+		if (callback != NULL)
+		{
+			callback->Invoke(addresses, boost::shared_ptr<string>());
+		}
+
+		return;
+	}
+
+	boost::lock_guard<boost::mutex> lock(mtxResolver);
+
+	if (isDisposed == true)
+	{
+		return;
+	}
+
+	// The lookup itself is blocking, Boost Asio runs it on its own internal thread;
+	// the worker thread only runs the completion handlers
+	if (worker == NULL)
+	{
+		boostIoService.reset();
+		boostWork = boost::shared_ptr<boost::asio::io_service::work>(new boost::asio::io_service::work(boostIoService));
+		worker = boost::shared_ptr<boost::thread>(new boost::thread(boost::bind(static_cast<size_t (boost::asio::io_service::*)()>(&boost::asio::io_service::run), &boostIoService)));
+	}
+
+	boost::shared_ptr<tcp::resolver> resolver (new tcp::resolver(boostIoService));
+	resolver->async_resolve(CreateQuery(host, forceIPv6), boost::bind(&HostResolver::OnBoostAsioResolved, this, host, forceIPv6, callback, resolver, boost::asio::placeholders::error, boost::asio::placeholders::iterator));
+}
+
+// -------------------------------------------------------------------
+// ResolveAsync
+// -------------------------------------------------------------------
+void HostResolver::ResolveAsync(string host, bool forceIPv6, boost::asio::io_service& service, boost::shared_ptr<HostResolvedDelegate> callback)
+{
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses = Lookup(host, forceIPv6, NULL);
+	if (addresses != NULL)
+	{
+		if (callback != NULL)
+		{
+			callback->Invoke(addresses, boost::shared_ptr<string>());
+		}
+
+		return;
+	}
+
+	// Boost Asio still runs the blocking lookup on its own internal thread, but the completion handler is run by the given service
+	boost::shared_ptr<tcp::resolver> resolver (new tcp::resolver(service));
+	resolver->async_resolve(CreateQuery(host, forceIPv6), boost::bind(&HostResolver::OnBoostAsioResolved, this, host, forceIPv6, callback, resolver, boost::asio::placeholders::error, boost::asio::placeholders::iterator));
+}
+
+// -------------------------------------------------------------------
+// OnBoostAsioResolved
+// -------------------------------------------------------------------
+void HostResolver::OnBoostAsioResolved(string host, bool forceIPv6, boost::shared_ptr<HostResolvedDelegate> callback, boost::shared_ptr<tcp::resolver> resolver, const boost::system::error_code& error, tcp::resolver::iterator iterator)
+{
+	if (error == boost::asio::error::operation_aborted)
+	{
+		return;
+	}
+
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses (new vector<boost::shared_ptr<IPAddress> >());
+	boost::shared_ptr<string> message;
+
+	if (error)
+	{
+		message = boost::shared_ptr<string>(new string(error.message()));
+	}
+	else
+	{
+		addresses = OrderAddresses(iterator, forceIPv6);
+		if (addresses->size() == 0)
+		{
+			message = boost::shared_ptr<string>(new string("Unable to get IP address"));
+		}
+		else
+		{
+			Store(host, forceIPv6, addresses);
+		}
+	}
+
+	// A refresh of an expired entry has no callback
+	if (callback != NULL)
+	{
+		callback->Invoke(addresses, message);
+	}
+}
+
+// -------------------------------------------------------------------
+// Lookup
+// -------------------------------------------------------------------
+boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > HostResolver::Lookup(const string& host, bool forceIPv6, bool* isExpired)
+{
+	// An ip address needs no lookup
+	boost::system::error_code error;
+	boost::asio::ip::address address = boost::asio::ip::address::from_string(host, error);
+	if (!error)
+	{
+		boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses (new vector<boost::shared_ptr<IPAddress> >());
+		addresses->push_back(boost::shared_ptr<IPAddress>(new IPAddress(address.to_string())));
+
+		return addresses;
+	}
+
+	boost::lock_guard<boost::mutex> lock(mtxResolver);
+
+	map<string, CacheEntry>::iterator iterator = cache.find(CacheKey(host, forceIPv6));
+	if (iterator == cache.end())
+	{
+		return boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >();
+	}
+
+	// Expired entries are kept until they are refreshed, so that a blocking lookup can go on with them
+	bool isEntryExpired = iterator->second.expiration <= boost::posix_time::microsec_clock::universal_time();
+
+	if (isExpired == NULL)
+	{
+		return isEntryExpired ? boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >() : iterator->second.addresses;
+	}
+
+	*isExpired = isEntryExpired;
+
+	return iterator->second.addresses;
+}
+
+// -------------------------------------------------------------------
+// Store
+// -------------------------------------------------------------------
+void HostResolver::Store(const string& host, bool forceIPv6, boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses)
+{
+	if (cacheLifetime <= 0)
+	{
+		return;
+	}
+
+	CacheEntry entry;
+	entry.addresses = addresses;
+	entry.expiration = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::seconds(cacheLifetime);
+
+	boost::lock_guard<boost::mutex> lock(mtxResolver);
+	cache[CacheKey(host, forceIPv6)] = entry;
+}
+
+// -------------------------------------------------------------------
+// OrderAddresses
+// -------------------------------------------------------------------
+boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > HostResolver::OrderAddresses(tcp::resolver::iterator iterator, bool forceIPv6)
+{
+	vector<string> addressesV4;
+	vector<string> addressesV6;
+
+	tcp::resolver::iterator end;
+	for (; iterator != end; ++iterator)
+	{
+		boost::asio::ip::address address = iterator->endpoint().address();
+
+		vector<string>& family = address.is_v6() ? addressesV6 : addressesV4;
+		string text = address.to_string();
+
+		if (std::find(family.begin(), family.end(), text) == family.end())
+		{
+			family.push_back(text);
+		}
+	}
+
+	if (forceIPv6 == true)
+	{
+		addressesV4.clear();
+	}
+
+	// Alternate the families, so that a family failing as a whole delays the connection by a single attempt
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses (new vector<boost::shared_ptr<IPAddress> >());
+	for (size_t index = 0; index < addressesV4.size() || index < addressesV6.size(); index++)
+	{
+		if (index < addressesV4.size())
+		{
+			addresses->push_back(boost::shared_ptr<IPAddress>(new IPAddress(addressesV4[index])));
+		}
+
+		if (index < addressesV6.size())
+		{
+			addresses->push_back(boost::shared_ptr<IPAddress>(new IPAddress(addressesV6[index])));
+		}
+	}
+
+	return addresses;
+}
+
+// -------------------------------------------------------------------
+// CreateQuery
+// -------------------------------------------------------------------
+tcp::resolver::query HostResolver::CreateQuery(const string& host, bool forceIPv6)
+{
+	// Ports are set by the connections; a numeric service avoids a lookup of the service name
+	if (forceIPv6 == true)
+	{
+		return tcp::resolver::query(tcp::v6(), host, "0");
+	}
+
+	return tcp::resolver::query(host, "0");
+}
+
+// -------------------------------------------------------------------
+// CacheKey
+// -------------------------------------------------------------------
+string HostResolver::CacheKey(const string& host, bool forceIPv6)
+{
+	return (forceIPv6 == true ? "6/" : "*/") + host;
+}
+
+}	// namespace Sockets
+}	// namespace Core
+}	// namespace Sfs2X
@@ -0,0 +1,179 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of HostResolver
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __HostResolver__
+#define __HostResolver__
+
+#include "../../Util/Common.h"					// Common API items
+#include "../../Util/DelegateTwoArguments.h"	// Delegate with two parameters
+#include "IPAddress.h"							// IP address
+
+#include <boost/asio.hpp>						// Boost Asio header
+#include <boost/shared_ptr.hpp>					// Boost Asio shared pointer
+#include <boost/thread.hpp>						// Boost thread
+#include <boost/thread/mutex.hpp>				// Boost mutex
+#include <boost/date_time/posix_time/posix_time.hpp>	// Boost time
+using boost::asio::ip::tcp;						// Boost Asio namespace
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <string>						// STL library: string object
+#include <vector>						// STL library: vector object
+#include <map>							// STL library: map object
+#include <algorithm>					// STL library: find algorithm
+using namespace std;					// STL library: declare the STL namespace
+
+using namespace Sfs2X::Util;
+
+namespace Sfs2X {
+namespace Core {
+namespace Sockets {
+
+	// -------------------------------------------------------------------
+	// Definition of delegates specific for the host resolver
+	// -------------------------------------------------------------------
+	typedef DelegateTwoArguments<boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >, boost::shared_ptr<string> > HostResolvedDelegate;
+
+	// -------------------------------------------------------------------
+	// Class HostResolver
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Resolves host names into the addresses to connect to, and caches the results
+	/// </summary>
+	///
+	/// <remarks>
+	/// A single instance serves the TCP, UDP and HTTP connections of a client, so a host is looked up once for all of them.
+	/// Asynchronous lookups run on a private io_service, because the one of the client only runs while a socket is open.
+	/// The system resolver does not report the time to live of the records, so entries expire after <see cref="CacheLifetime"/> seconds.
+	/// <br/>
+	/// Addresses are ordered as <see cref="TCPClient.Connect"/> attempts them: IPv4 and IPv6 addresses alternate, starting with IPv4.
+	/// When IPv6 is forced only IPv6 addresses are returned.
+	/// </remarks>
+	class HostResolver
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		HostResolver();
+		~HostResolver();
+
+		/// <summary>
+		/// Resolves a host name on the calling thread, unless it is in the cache
+		/// </summary>
+		/// <remarks>
+		/// If provided an ip address instead of an host name, returns the address itself.<br/>
+		/// An expired entry is still returned, and refreshed by an asynchronous lookup: the calling thread only blocks on a host never resolved before.
+		/// </remarks>
+		/// <exception cref="std::runtime_error">The host has no address</exception>
+		boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > Resolve(string host, bool forceIPv6);
+
+		/// <summary>
+		/// Resolves a host name without blocking the calling thread
+		/// </summary>
+		/// <remarks>
+		/// Ip addresses and cached host names are notified before the method returns; other host names are notified on the resolver thread.
+		/// On failure the callback receives an empty address list and the error message. A NULL callback only refreshes the cache.
+		/// </remarks>
+		void ResolveAsync(string host, bool forceIPv6, boost::shared_ptr<HostResolvedDelegate> callback);
+
+		/// <summary>
+		/// Resolves a host name without blocking the calling thread, notifying the result on the given io_service
+		/// </summary>
+		/// <remarks>
+		/// Ip addresses and cached host names are notified before the method returns; other host names are notified
+		/// by the thread that runs or polls the service, e.g. the caller of <see cref="SmartFox.Poll"/> in poll mode.
+		/// </remarks>
+		void ResolveAsync(string host, bool forceIPv6, boost::asio::io_service& service, boost::shared_ptr<HostResolvedDelegate> callback);
+
+		/// <summary>
+		/// Number of seconds a resolved host is kept in the cache; 0 disables the cache
+		/// </summary>
+		long int CacheLifetime();
+		void CacheLifetime(long int value);
+
+		/// <summary>
+		/// Forgets every cached host, e.g. after the network has changed
+		/// </summary>
+		void ClearCache();
+
+		/// <summary>
+		/// Stops the resolver thread; pending lookups are not notified
+		/// </summary>
+		void Dispose();
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		const static long int DEFAULT_CACHE_LIFETIME = 60;
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private types
+		// -------------------------------------------------------------------
+
+		struct CacheEntry
+		{
+			boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses;
+			boost::posix_time::ptime expiration;
+		};
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		// Lookup
+		// Return the addresses of an ip address or of a cached host, NULL otherwise
+		//		isExpired	Set when the returned entry has expired; when NULL, expired entries are not returned
+		boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > Lookup(const string& host, bool forceIPv6, bool* isExpired);
+
+		// Store
+		// Add the addresses of an host to the cache
+		void Store(const string& host, bool forceIPv6, boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses);
+
+		// OrderAddresses
+		// Return the resolved addresses without duplicates, alternating the address families
+		static boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > OrderAddresses(tcp::resolver::iterator iterator, bool forceIPv6);
+
+		// CreateQuery
+		// Return the resolver query for an host
+		static tcp::resolver::query CreateQuery(const string& host, bool forceIPv6);
+
+		// CacheKey
+		static string CacheKey(const string& host, bool forceIPv6);
+
+		// OnBoostAsioResolved
+		// Callback to notify the completion of an asynchronous lookup
+		void OnBoostAsioResolved(string host, bool forceIPv6, boost::shared_ptr<HostResolvedDelegate> callback, boost::shared_ptr<tcp::resolver> resolver, const boost::system::error_code& error, tcp::resolver::iterator iterator);
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		boost::asio::io_service boostIoService;							// Boost Asio IO service of the asynchronous lookups
+		boost::shared_ptr<boost::asio::io_service::work> boostWork;		// Keeps the resolver thread running between lookups
+		boost::shared_ptr<boost::thread> worker;						// Resolver thread, started by the first asynchronous lookup
+
+		boost::mutex mtxResolver;						// Mutex to synchronize the cache and the resolver thread
+		map<string, CacheEntry> cache;					// Resolved hosts
+		long int cacheLifetime;
+		bool isDisposed;
+	};
+
+}	// namespace Sockets
+}	// namespace Core
+}	// namespace Sfs2X
+
+#endif
@@ -47,6 +47,7 @@ namespace Sockets {
 	{
 	public:
 		virtual void Connect(boost::shared_ptr<IPAddress> address, unsigned short int port) = 0;
+		virtual void Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, unsigned short int port) = 0;		// Addresses in order of preference
 		virtual bool IsConnected() = 0;
 		virtual bool RequiresConnection() = 0;
 		virtual void Disconnect() = 0;
@@ -58,6 +59,7 @@ namespace Sockets {
 		virtual void OnDisconnect(boost::shared_ptr<ConnectionDelegate> onDisconnect) = 0;	// Set delegate
 
 		virtual void Write(boost::shared_ptr<vector<unsigned char> >) = 0;
+		virtual long int PendingWriteBytes() = 0;											// Bytes written by the client and not yet sent by the socket
 
 		virtual boost::shared_ptr<OnDataDelegate> OnData() = 0;								// Get delegate
 		virtual void OnData(boost::shared_ptr<OnDataDelegate> onData) = 0;					// Set delegate
@@ -10,10 +10,6 @@
 // =================================================================== 
 #include "TCPClient.h"
 
-#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-#include <boost/detail/interlocked.hpp>			// Boost Asio header
-#endif
-
 namespace Sfs2X {
 namespace Core {
 namespace Sockets {
@@ -24,21 +20,18 @@ namespace Sockets {
 TCPClient::TCPClient (boost::asio::io_service& io_service)
 	: boostIoService(io_service),
 	  boostTcpResolver(io_service),
-      boostTcpSocket(io_service),
-	  boostTimerTaskDeadline(io_service)
+      boostTcpSocket(new tcp::socket(io_service)),
+	  boostTimerTaskDeadline(io_service),
+	  boostTimerAttemptDelay(io_service)
 {
 	this->isDisposed = false;
-	this->isCallbackCallInProgress = false;
 	callbackTCPConnection = boost::shared_ptr<TCPConnectionDelegate>();
 	callbackTCPDataRead = boost::shared_ptr<TCPDataReadDelegate>();
 	callbackTCPDataWrite = boost::shared_ptr<TCPDataWriteDelegate>();
-	#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-		BOOST_INTERLOCKED_EXCHANGE(&counterAsyncReadOperationsInProgress, 0);
-		BOOST_INTERLOCKED_EXCHANGE(&counterAsyncWriteOperationsInProgress, 0);
-	#else
-		counterAsyncReadOperationsInProgress = 0;
-		counterAsyncWriteOperationsInProgress = 0;
-	#endif
+	isWriteInProgress = false;
+	pendingWriteBytes = 0;
+	connectEndpointNext = 0;
+	isConnectCompleted = false;
 }
 
 // -------------------------------------------------------------------
@@ -46,15 +39,8 @@ TCPClient::TCPClient (boost::asio::io_service& io_service)
 // -------------------------------------------------------------------
 TCPClient::~TCPClient()
 {
-	// Wait for completion of asynchronous operations 
-	long int counterInProgressAsyncRead = counterAsyncReadOperationsInProgress = 0;
-	long int counterInProgressAsyncWrite = counterAsyncWriteOperationsInProgress = 0;
-	do
-	{
-		counterInProgressAsyncRead = counterAsyncReadOperationsInProgress;
-		counterInProgressAsyncWrite = counterAsyncWriteOperationsInProgress;
-	} while ((counterInProgressAsyncRead > 0) || (counterInProgressAsyncWrite > 0));
-	//MAX while ((counterAsyncReadOperationsInProgress > 0) || (counterAsyncWriteOperationsInProgress > 0));
+	// Nothing to wait for: every pending asynchronous operation holds a reference to the client,
+	// so the destructor only runs once all of them have completed
 }
 
 // -------------------------------------------------------------------
@@ -69,6 +55,17 @@ void TCPClient::Dispose()
 // Connect
 // -------------------------------------------------------------------
 void TCPClient::Connect (boost::shared_ptr<IPAddress> ipAddress, unsigned short int ipPort, long int timeout, boost::shared_ptr<TCPConnectionDelegate> callback)
+{
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ipAddresses (new vector<boost::shared_ptr<IPAddress> >());
+	ipAddresses->push_back(ipAddress);
+
+	Connect(ipAddresses, ipPort, timeout, callback);
+}
+
+// -------------------------------------------------------------------
+// Connect
+// -------------------------------------------------------------------
+void TCPClient::Connect (boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ipAddresses, unsigned short int ipPort, long int timeout, boost::shared_ptr<TCPConnectionDelegate> callback)
 {
 	if (this->isDisposed == true)
 	{
@@ -78,13 +75,65 @@ void TCPClient::Connect (boost::shared_ptr<IPAddress> ipAddress, unsigned short
 	// Preserve callback that will be used to notify tcp connection result
 	callbackTCPConnection = callback;
 
+	boost::lock_guard<boost::mutex> lockConnect(mtxConnect);
+
+	connectEndpoints.clear();
+	vector<boost::shared_ptr<IPAddress> >::iterator iterator;
+	for (iterator = ipAddresses->begin(); iterator != ipAddresses->end(); ++iterator)
+	{
+		connectEndpoints.push_back(tcp::endpoint(boost::asio::ip::address::from_string(*((*iterator)->Address())), ipPort));
+	}
+
+	connectEndpointNext = 0;
+	isConnectCompleted = false;
+
 	// Start deadline timer for tcp connection task
     boostTimerTaskDeadline.expires_from_now(boost::posix_time::seconds(timeout));
-	boostTimerTaskDeadline.async_wait(boost::bind(&TCPClient::OnBoostAsioConnectTimedout, this, boost::asio::placeholders::error));
+	boostTimerTaskDeadline.async_wait(boost::bind(&TCPClient::OnBoostAsioConnectTimedout, shared_from_this(), boost::asio::placeholders::error));
 
 	// Attempt to establish a tcp connection
-	boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(*(ipAddress->Address())), ipPort);
-	boostTcpSocket.async_connect(endpoint,  boost::bind(&TCPClient::OnBoostAsioConnect, this, boost::asio::placeholders::error));
+	StartConnectAttempt();
+}
+
+// -------------------------------------------------------------------
+// StartConnectAttempt
+// -------------------------------------------------------------------
+bool TCPClient::StartConnectAttempt()
+{
+	if (connectEndpointNext >= connectEndpoints.size())
+	{
+		return false;
+	}
+
+	// Each attempt has its own socket, the first one to connect becomes the connection
+	boost::shared_ptr<tcp::socket> attempt (new tcp::socket(boostIoService));
+	connectAttempts.push_back(attempt);
+
+	attempt->async_connect(connectEndpoints[connectEndpointNext++], boost::bind(&TCPClient::OnBoostAsioConnect, shared_from_this(), attempt, boost::asio::placeholders::error));
+
+	// Start the next attempt if this one is still pending after a while
+	if (connectEndpointNext < connectEndpoints.size())
+	{
+		boostTimerAttemptDelay.expires_from_now(boost::posix_time::milliseconds(CONNECT_ATTEMPT_DELAY));
+		boostTimerAttemptDelay.async_wait(boost::bind(&TCPClient::OnBoostAsioConnectAttemptDelay, shared_from_this(), boost::asio::placeholders::error));
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------
+// CloseConnectAttempts
+// -------------------------------------------------------------------
+void TCPClient::CloseConnectAttempts()
+{
+	vector<boost::shared_ptr<tcp::socket> >::iterator iterator;
+	for (iterator = connectAttempts.begin(); iterator != connectAttempts.end(); ++iterator)
+	{
+		boost::system::error_code error;
+		(*iterator)->close(error);
+	}
+
+	connectAttempts.clear();
 }
 
 // -------------------------------------------------------------------
@@ -101,7 +150,7 @@ void TCPClient::SynchConnect (boost::shared_ptr<IPAddress> ipAddress, unsigned s
 
 	// Attempt to establish a tcp connection
 	boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(*(ipAddress->Address())), ipPort);
-	boostTcpSocket.connect(endpoint, error);
+	boostTcpSocket->connect(endpoint, error);
 }
 
 // -------------------------------------------------------------------
@@ -109,32 +158,86 @@ void TCPClient::SynchConnect (boost::shared_ptr<IPAddress> ipAddress, unsigned s
 // -------------------------------------------------------------------
 void TCPClient::Shutdown()
 {
+	boost::lock_guard<boost::mutex> lockConnect(mtxConnect);
+
+	// Drop a connect task in progress: the aborted attempts notify its failure
+	connectEndpointNext = connectEndpoints.size();
+	boostTimerAttemptDelay.cancel();
+	CloseConnectAttempts();
+
 	// Cancel all asynchronous operations associated with the socket
-	boostTcpSocket.shutdown(boost::asio::socket_base::shutdown_both);
-    boostTcpSocket.close();
+	boostTcpSocket->shutdown(boost::asio::socket_base::shutdown_both);
+    boostTcpSocket->close();
     //boostIoService.stop();
 }
 
 // -------------------------------------------------------------------
 // OnBoostAsioConnect
 // -------------------------------------------------------------------
-void TCPClient::OnBoostAsioConnect(const boost::system::error_code& code)
+void TCPClient::OnBoostAsioConnect(boost::shared_ptr<tcp::socket> attempt, const boost::system::error_code& code)
 {
+	{
+		boost::lock_guard<boost::mutex> lockConnect(mtxConnect);
+
+		if (isConnectCompleted == true)
+		{
+			// Another attempt has connected, or the connect task has timed out
+			return;
+		}
+
+		connectAttempts.erase(std::remove(connectAttempts.begin(), connectAttempts.end(), attempt), connectAttempts.end());
+
+		if (!code)
+		{
+			// The socket of the first attempt to connect becomes the connection
+			isConnectCompleted = true;
+			boostTcpSocket = attempt;
+
+			boostTimerAttemptDelay.cancel();
+			CloseConnectAttempts();
+		}
+		else
+		{
+			boost::system::error_code error;
+			attempt->close(error);
+
+			// Attempt the next address right away instead of waiting for the delay
+			boostTimerAttemptDelay.cancel();
+			if ((StartConnectAttempt() == true) || (connectAttempts.empty() == false))
+			{
+				return;
+			}
+
+			// Every address has failed
+			isConnectCompleted = true;
+		}
+	}
+
 	// Stop deadline timer for tcp connection task
 	boostTimerTaskDeadline.cancel();
 
-	this->isCallbackCallInProgress = true;
+	// Notify the establishment of the tcp connection
+	NotifyConnection((SocketErrors)(code.value()));
+}
 
-	if (this->isDisposed == true)
+// -------------------------------------------------------------------
+// OnBoostAsioConnectAttemptDelay
+// -------------------------------------------------------------------
+void TCPClient::OnBoostAsioConnectAttemptDelay(const boost::system::error_code& code)
+{
+	if (code == boost::asio::error::operation_aborted)
 	{
-		this->isCallbackCallInProgress = false;
+		// An attempt has completed before the delay
+		// Nothing to do
 		return;
 	}
 
-	// Notify the establishment of the tcp connection
-	callbackTCPConnection->Invoke((SocketErrors)(code.value()));
+	boost::lock_guard<boost::mutex> lockConnect(mtxConnect);
 
-	this->isCallbackCallInProgress = false;
+	if (isConnectCompleted == false)
+	{
+		StartConnectAttempt();
+	}
 }
 
 // -------------------------------------------------------------------
@@ -150,19 +253,40 @@ void TCPClient::OnBoostAsioConnectTimedout(const boost::system::error_code& code
 	}
 
 	// Deadline timer for tcp connection task is expired
+	{
+		boost::lock_guard<boost::mutex> lockConnect(mtxConnect);
+
+		if (isConnectCompleted == true)
+		{
+			return;
+		}
 
-	this->isCallbackCallInProgress = true;
+		isConnectCompleted = true;
+
+		boostTimerAttemptDelay.cancel();
+		CloseConnectAttempts();
+	}
+
+	NotifyConnection(SocketErrors_TimedOut);
+}
+
+// -------------------------------------------------------------------
+// NotifyConnection
+// -------------------------------------------------------------------
+void TCPClient::NotifyConnection(SocketErrors code)
+{
+	BeginCallback();
 
 	if (this->isDisposed == true)
 	{
-		this->isCallbackCallInProgress = false;
+		EndCallback();
 		return;
 	}
 
-	// Notify the establishment of the tco connection
-	callbackTCPConnection->Invoke((SocketErrors)(code.value()));
+	// Notify the establishment of the tcp connection
+	callbackTCPConnection->Invoke(code);
 
-	this->isCallbackCallInProgress = false;
+	EndCallback();
 }
 
 // -------------------------------------------------------------------
@@ -184,12 +308,7 @@ void TCPClient::AsynchRead (boost::shared_ptr<TCPDataReadDelegate> callback)
 	boost::lock_guard<boost::recursive_mutex> unlock(mtxDisconnection);
 
 	// Schedule asyncronous read
-	#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-		BOOST_INTERLOCKED_INCREMENT(&counterAsyncReadOperationsInProgress);
-	#else
-		counterAsyncReadOperationsInProgress++;
-	#endif
-	boostTcpSocket.async_read_some(boost::asio::buffer(boostTcpInputBuffer), boost::bind(&TCPClient::OnBoostAsioDataReceived, this, _1, _2));
+	boostTcpSocket->async_read_some(boost::asio::buffer(boostTcpInputBuffer), boost::bind(&TCPClient::OnBoostAsioDataReceived, shared_from_this(), _1, _2));
 }
 
 // -------------------------------------------------------------------
@@ -205,7 +324,7 @@ boost::shared_ptr<vector<unsigned char> > TCPClient::SynchRead ()
 		return boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>());
 	}
 
-	length = boostTcpSocket.read_some(boost::asio::buffer(boostTcpInputBuffer), error);
+	length = boostTcpSocket->read_some(boost::asio::buffer(boostTcpInputBuffer), error);
 
 	if (error == boost::asio::error::eof)
 	{
@@ -243,26 +362,43 @@ void TCPClient::AsynchWrite (boost::shared_ptr<vector<unsigned char> > data, boo
 
 	boost::lock_guard<boost::recursive_mutex> unlock(mtxDisconnection);
 
-	// Allocate a smart pointer to a vector where take place outgoing data
-	boost::shared_ptr<unsigned char> bufferOutput(new unsigned char[data->size()], array_deleter<unsigned char>());
+	if (data->empty() == true)
+	{
+		return;
+	}
 
-	unsigned char* writerBufferOutput = bufferOutput.get();
-	long int offsetBufferOutput = 0;
-	vector<unsigned char>::iterator iterator;
-	for(iterator = data->begin(); iterator != data->end(); ++iterator)
+	// Queue outgoing data; if a write is already in flight, its completion sends the queue
+	boost::lock_guard<boost::mutex> lockWrite(mtxWrite);
+
+	writeQueue.push_back(data);
+	pendingWriteBytes += (long int)data->size();
+
+	if (isWriteInProgress == false)
 	{
-		*(writerBufferOutput + offsetBufferOutput) = (*iterator);
-		offsetBufferOutput++;
+		StartWrite();
 	}
-	//memcpy ((void*)(bufferOutput.get()), data->data(), data->size());
+}
 
-	// Schedule an asynchronous write to dispatch outgoing data over Tcp socket
-	#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-		BOOST_INTERLOCKED_INCREMENT(&counterAsyncWriteOperationsInProgress);
-	#else
-		counterAsyncWriteOperationsInProgress++;	
-	#endif
-	boostTcpSocket.async_write_some(boost::asio::buffer((void*)bufferOutput.get(), (size_t)data->size()), boost::bind(&TCPClient::OnBoostAsioDataSent, this, bufferOutput, data->size(), boost::asio::placeholders::bytes_transferred, boost::asio::placeholders::error));
+// -------------------------------------------------------------------
+// StartWrite
+// -------------------------------------------------------------------
+void TCPClient::StartWrite()
+{
+	isWriteInProgress = true;
+
+	// The in flight list is empty here, so swapping leaves the queue empty and keeps its capacity
+	writeInFlight.swap(writeQueue);
+
+	writeBuffers.clear();
+	vector<boost::shared_ptr<vector<unsigned char> > >::iterator iterator;
+	for (iterator = writeInFlight.begin(); iterator != writeInFlight.end(); ++iterator)
+	{
+		writeBuffers.push_back(boost::asio::buffer(**iterator));
+	}
+
+	// Schedule an asynchronous write to dispatch all queued data over Tcp socket;
+	// async_write completes only when every byte has been transmitted or an error occurred
+	boost::asio::async_write(*boostTcpSocket, writeBuffers, boost::bind(&TCPClient::OnBoostAsioDataSent, shared_from_this(), boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred));
 }
 
 // -------------------------------------------------------------------
@@ -288,22 +424,37 @@ void TCPClient::SynchWrite (boost::shared_ptr<vector<unsigned char> > data)
 	}
 
 	// Dispatch outgoing data over Tcp socket
-	boostTcpSocket.write_some (boost::asio::buffer((void*)bufferOutput.get(), (size_t)data->size()));
+	boostTcpSocket->write_some (boost::asio::buffer((void*)bufferOutput.get(), (size_t)data->size()));
+}
+
+// -------------------------------------------------------------------
+// PendingWriteBytes
+// -------------------------------------------------------------------
+long int TCPClient::PendingWriteBytes()
+{
+	boost::lock_guard<boost::mutex> lockWrite(mtxWrite);
+	return pendingWriteBytes;
 }
 
 // -------------------------------------------------------------------
 // OnBoostAsioDataSent
 // -------------------------------------------------------------------
-void TCPClient::OnBoostAsioDataSent(boost::shared_ptr<unsigned char> bufferOutput, size_t length, size_t transferred, const boost::system::error_code& error)
+void TCPClient::OnBoostAsioDataSent(const boost::system::error_code& error, size_t transferred)
 {
-	this->isCallbackCallInProgress = true;
+	BeginCallback();
 
 	if (this->isDisposed == true)
 	{
-		this->isCallbackCallInProgress = false;
+		EndCallback();
 		return;
 	}
 
+	// The bytes just sent are no longer pending by the time the completion is notified
+	{
+		boost::lock_guard<boost::mutex> lockWrite(mtxWrite);
+		pendingWriteBytes -= (long int)transferred;
+	}
+
 	// Notify operation status
 	boost::lock_guard<boost::recursive_mutex> lock(mtxDisconnection);
 
@@ -314,34 +465,30 @@ void TCPClient::OnBoostAsioDataSent(boost::shared_ptr<unsigned char> bufferOutpu
 
 	boost::lock_guard<boost::recursive_mutex> unlock(mtxDisconnection);
 
-	// Check if all output data have been transmitted
-	if (transferred != length)
+	// Release the buffers just sent and send what has been queued meanwhile
 	{
-		// Not all data have been transmitted
-
-		// Allocate a smart pointer to a vector where take place outgoing data
-		boost::shared_ptr<unsigned char> bufferNextOutput(new unsigned char[length - transferred], array_deleter<unsigned char>());
-		memcpy ((void*)(bufferNextOutput.get()), bufferOutput.get() + transferred, length - transferred);
-
-		// Schedule an asynchronous write to dispatch outgoing data over Tcp socket
-		boostTcpSocket.async_write_some(boost::asio::buffer((void*)bufferNextOutput.get(), (length - transferred)), boost::bind(&TCPClient::OnBoostAsioDataSent, this, bufferNextOutput, (length - transferred), boost::asio::placeholders::bytes_transferred, boost::asio::placeholders::error));
-
-		this->isCallbackCallInProgress = false;
-
-		return;
+		boost::lock_guard<boost::mutex> lockWrite(mtxWrite);
+
+		writeInFlight.clear();
+
+		if (error)
+		{
+			// The connection is failing: queued data can no longer be delivered
+			writeQueue.clear();
+			pendingWriteBytes = 0;
+			isWriteInProgress = false;
+		}
+		else if (writeQueue.empty() == false)
+		{
+			StartWrite();
+		}
+		else
+		{
+			isWriteInProgress = false;
+		}
 	}
 
-	// Decrease counter of asynchronous write that are in progress
-	if (counterAsyncWriteOperationsInProgress > 0)
-	{
-		#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-			BOOST_INTERLOCKED_DECREMENT(&counterAsyncWriteOperationsInProgress);
-		#else
-			counterAsyncWriteOperationsInProgress--;
-		#endif
-	}
-
-	this->isCallbackCallInProgress = false;
+	EndCallback();
 }
 
 // -------------------------------------------------------------------
@@ -349,11 +496,11 @@ void TCPClient::OnBoostAsioDataSent(boost::shared_ptr<unsigned char> bufferOutpu
 // -------------------------------------------------------------------
 void TCPClient::OnBoostAsioDataReceived(const boost::system::error_code& error, long int length)
 {
-	this->isCallbackCallInProgress = true;
+	BeginCallback();
 
 	if (this->isDisposed == true)
 	{
-		this->isCallbackCallInProgress = false;
+		EndCallback();
 		return;
 	}
 
@@ -380,25 +527,71 @@ void TCPClient::OnBoostAsioDataReceived(const boost::system::error_code& error,
 
 	boost::lock_guard<boost::recursive_mutex> unlock(mtxDisconnection);
 
-	// Decrease counter of asynchronous read that are in progress
-	if (counterAsyncReadOperationsInProgress > 0)
+	EndCallback();
+}
+
+// -------------------------------------------------------------------
+// CallbackCallInProgress
+// -------------------------------------------------------------------
+bool TCPClient::CallbackCallInProgress()
+{
+	boost::lock_guard<boost::mutex> lock(mtxCallbacks);
+	return !callbackThreads.empty();
+}
+
+// -------------------------------------------------------------------
+// WaitCallbackCompletion
+// -------------------------------------------------------------------
+void TCPClient::WaitCallbackCompletion()
+{
+	boost::thread::id self = boost::this_thread::get_id();
+
+	boost::unique_lock<boost::mutex> lock(mtxCallbacks);
+	while (true)
 	{
-		#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-			BOOST_INTERLOCKED_DECREMENT(&counterAsyncReadOperationsInProgress);
-		#else
-			counterAsyncReadOperationsInProgress--;
-		#endif
+		// Callbacks running on the calling thread are not waited for
+		bool otherCallbackInProgress = false;
+		for (vector<boost::thread::id>::iterator iterator = callbackThreads.begin(); iterator != callbackThreads.end(); ++iterator)
+		{
+			if (*iterator != self)
+			{
+				otherCallbackInProgress = true;
+				break;
+			}
+		}
+
+		if (!otherCallbackInProgress)
+		{
+			return;
+		}
+
+		conditionCallbacks.wait(lock);
 	}
+}
 
-	this->isCallbackCallInProgress = false;
+// -------------------------------------------------------------------
+// BeginCallback
+// -------------------------------------------------------------------
+void TCPClient::BeginCallback()
+{
+	boost::lock_guard<boost::mutex> lock(mtxCallbacks);
+	callbackThreads.push_back(boost::this_thread::get_id());
 }
 
 // -------------------------------------------------------------------
-// CallbackCallInProgress
+// EndCallback
 // -------------------------------------------------------------------
-bool TCPClient::CallbackCallInProgress()
+void TCPClient::EndCallback()
 {
-	return isCallbackCallInProgress;
+	boost::lock_guard<boost::mutex> lock(mtxCallbacks);
+
+	vector<boost::thread::id>::iterator iterator = std::find(callbackThreads.begin(), callbackThreads.end(), boost::this_thread::get_id());
+	if (iterator != callbackThreads.end())
+	{
+		callbackThreads.erase(iterator);
+	}
+
+	conditionCallbacks.notify_all();
 }
 
 }	// namespace Sockets
@@ -24,11 +24,15 @@
 #include <boost/enable_shared_from_this.hpp>	// Boost Asio shared from this
 #include <boost/thread/recursive_mutex.hpp>		// Boost Asio header
 #include <boost/thread/lock_guard.hpp>			// Boost Asio header
+#include <boost/thread/mutex.hpp>				// Boost Asio header
+#include <boost/thread/condition_variable.hpp>	// Boost Asio header
+#include <boost/thread/thread.hpp>				// Boost Asio header
 
 #if defined(_MSC_VER)
 #pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
 #endif
 #include <vector>						// STL library: vector object
+#include <algorithm>					// STL library: find algorithm
 using namespace std;					// STL library: declare the STL namespace
 
 using boost::asio::ip::tcp;					// Boost Asio namespace
@@ -73,6 +77,17 @@ namespace Sockets {
 		//		timeout			Connection timeout expressed in seconds
 		//		callback		Callback to notify operation result
 		void Connect (boost::shared_ptr<IPAddress> ipAddress, unsigned short int ipPort, long int timeout, boost::shared_ptr<TCPConnectionDelegate> callback);
+
+		// Connect
+		// Attemps to establish a tcp client connection with the first server address that answers
+		// Addresses are attempted in order: an attempt starts when the previous one fails or has not succeeded
+		// within CONNECT_ATTEMPT_DELAY milliseconds, without cancelling it, so an unreachable address family
+		// delays the connection by a fraction of a second instead of the whole connection timeout
+		//		ipAddresses		Server ip addresses expressed in dotted form, in order of preference
+		//		ipPort			Server ip port
+		//		timeout			Connection timeout expressed in seconds
+		//		callback		Callback to notify operation result
+		void Connect (boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ipAddresses, unsigned short int ipPort, long int timeout, boost::shared_ptr<TCPConnectionDelegate> callback);
 		
 		// Connect
 		// Attemps to establish a tcp client connection
@@ -91,6 +106,8 @@ namespace Sockets {
 
 		// AsynchWrite
 		// Asynchronous write data on the underlying socket
+		// Only one write is in flight at a time: data queued meanwhile is sent with the next write, gathered in a single call.
+		// The buffer is sent without being copied, so it must not be changed after the call
 		//		data		Buffer that contains data to write
 		//		callback	Callback to notify the completion of sent task
 		void AsynchWrite (boost::shared_ptr<vector<unsigned char> > data, boost::shared_ptr<TCPDataWriteDelegate> callback);
@@ -105,8 +122,17 @@ namespace Sockets {
 		//		data		Buffer that contains data to write
 		void SynchWrite (boost::shared_ptr<vector<unsigned char> > data);
 
+		// PendingWriteBytes
+		// Returns the quantity of bytes accepted by AsynchWrite and not yet written to the socket
+		long int PendingWriteBytes();
+
 		bool CallbackCallInProgress();
 
+		// WaitCallbackCompletion
+		// Blocks until no callback of this client is running, being woken up as soon as the last one returns
+		// Returns at once when called from within a callback, that would otherwise wait for itself
+		void WaitCallbackCompletion();
+
 		// -------------------------------------------------------------------
 		// Public members
 		// -------------------------------------------------------------------
@@ -127,10 +153,32 @@ namespace Sockets {
 		// Private methods
 		// -------------------------------------------------------------------
 
+		// StartConnectAttempt
+		// Start connecting to the next server address, if any
+		// Must be called with mtxConnect held
+		// Return: false when every address has been attempted
+		bool StartConnectAttempt();
+
+		// CloseConnectAttempts
+		// Close the sockets of the attempts in progress
+		// Must be called with mtxConnect held
+		void CloseConnectAttempts();
+
+		// NotifyConnection
+		// Notify the result of the connect task
+		//		code		Error code
+		void NotifyConnection(SocketErrors code);
+
 		// OnBoostAsioConnect
 		// Callback to receive Boost Asio notification regarding connect task
+		//		attempt		Socket of the connect attempt
+		//		code		Error code
+	    void OnBoostAsioConnect(boost::shared_ptr<tcp::socket> attempt, const boost::system::error_code& code);
+
+		// OnBoostAsioConnectAttemptDelay
+		// Callback to receive Boost Asio notification regarding the delay before the next connect attempt
 		//		code		Error code
-	    void OnBoostAsioConnect(const boost::system::error_code& code);
+		void OnBoostAsioConnectAttemptDelay(const boost::system::error_code& code);
 
 		// OnBoostAsioConnectTimedout
 		// Callback to receive Boost Asio notification regarding timedout connect task
@@ -143,24 +191,34 @@ namespace Sockets {
 		//		length		Length received data
 		void OnBoostAsioDataReceived(const boost::system::error_code& error, long int length);
 
+		// StartWrite
+		// Move the queued buffers in flight and send them with a single gathered write
+		// Must be called with mtxWrite held
+		void StartWrite();
+
 		// OnBoostAsioDataSent
 		// Callback to notify the completion of asynchronous write over the socket
-		//		bufferOutput		Output data
-		//		length				Quantity of bytes into output data
-		//		transferred			Quantity of transferred bytes
 		//		error				Error code
-		void OnBoostAsioDataSent(boost::shared_ptr<unsigned char> bufferOutput, size_t length, size_t transferred, const boost::system::error_code& error);
+		//		transferred			Quantity of transferred bytes
+		void OnBoostAsioDataSent(const boost::system::error_code& error, size_t transferred);
+
+		// BeginCallback / EndCallback
+		// Mark the calling thread as running a callback of this client
+		void BeginCallback();
+		void EndCallback();
 
 		// -------------------------------------------------------------------
 		// Private members
 		// -------------------------------------------------------------------
 
 		const static long int READ_BUFFER_SIZE = 4096;
+		const static long int CONNECT_ATTEMPT_DELAY = 250;			// Delay before attempting the next server address [msec.]
 
 		boost::asio::io_service& boostIoService;					// Boost Asio IO service		
 		tcp::resolver boostTcpResolver;								// Boost Asio Tcp resolver
-		tcp::socket boostTcpSocket;									// Boost Asio Tcp socket
+		boost::shared_ptr<tcp::socket> boostTcpSocket;				// Boost Asio Tcp socket; the winning attempt once connected
 		boost::asio::deadline_timer boostTimerTaskDeadline;			// Boost Asio deadline timer
+		boost::asio::deadline_timer boostTimerAttemptDelay;			// Boost Asio deadline timer of the next connect attempt
 		boost::array<char, READ_BUFFER_SIZE> boostTcpInputBuffer;	// Boost Asio Tcp input buffer
 
 		boost::shared_ptr<TCPConnectionDelegate> callbackTCPConnection;		// Callback to notify tcp connection result
@@ -169,10 +227,24 @@ namespace Sockets {
 
 		boost::recursive_mutex mtxDisconnection;			// Mutex to synchronize Tcp disconnection tasks 
 
-		long int counterAsyncReadOperationsInProgress;		// Counter of asynchronous read operations that are in progress
-		long int counterAsyncWriteOperationsInProgress;		// Counter of asynchronous write operations that are in progress
+		boost::mutex mtxCallbacks;							// Mutex to synchronize the tracking of running callbacks
+		boost::condition_variable conditionCallbacks;		// Signaled when a callback returns
+		vector<boost::thread::id> callbackThreads;			// Threads that are running a callback
+
+		boost::mutex mtxWrite;													// Mutex to synchronize the write queue
+		vector<boost::shared_ptr<vector<unsigned char> > > writeQueue;			// Buffers waiting for the write in flight to complete
+		vector<boost::shared_ptr<vector<unsigned char> > > writeInFlight;		// Buffers of the write in flight
+		vector<boost::asio::const_buffer> writeBuffers;							// Gathered buffers of the write in flight
+		bool isWriteInProgress;
+		long int pendingWriteBytes;												// Bytes queued or in flight
+
+		boost::mutex mtxConnect;									// Mutex to synchronize the connect attempts
+		vector<tcp::endpoint> connectEndpoints;						// Server addresses to attempt
+		size_t connectEndpointNext;									// Index of the next server address to attempt
+		vector<boost::shared_ptr<tcp::socket> > connectAttempts;	// Sockets of the attempts in progress
+		bool isConnectCompleted;
+
 		bool isDisposed;
-		bool isCallbackCallInProgress;
 	};
 
 }	// namespace Sockets
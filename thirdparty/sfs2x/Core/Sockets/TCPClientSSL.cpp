@@ -10,14 +10,28 @@
 // =================================================================== 
 #include "TCPClientSSL.h"
 
-#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-#include <boost/detail/interlocked.hpp>			// Boost Asio header
-#endif
-
 namespace Sfs2X {
 namespace Core {
 namespace Sockets {
 
+boost::shared_ptr<boost::asio::ssl::context> TCPClientSSL::sharedContext;
+map<string, SSL_SESSION*> TCPClientSSL::sessions;
+boost::mutex TCPClientSSL::mtxSessions;
+long int TCPClientSSL::maxRecordSize = 0;
+int TCPClientSSL::sessionKeyIndex = -1;
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+TCPClientSSL::TCPClientSSL (boost::asio::io_service& io_service)
+	: boostIoService(io_service),
+	  boostTcpResolver(io_service),
+      boostTcpSocket(io_service, *SharedContext()),
+	  boostTimerTaskDeadline(io_service)
+{
+	Initialize();
+}
+
 // -------------------------------------------------------------------
 // Constructor
 // -------------------------------------------------------------------
@@ -26,22 +40,182 @@ TCPClientSSL::TCPClientSSL (boost::asio::io_service& io_service, boost::asio::ss
 	  boostTcpResolver(io_service),
       boostTcpSocket(io_service, context),
 	  boostTimerTaskDeadline(io_service)
+{
+	Initialize();
+}
+
+// -------------------------------------------------------------------
+// Initialize
+// -------------------------------------------------------------------
+void TCPClientSSL::Initialize()
 {
 	this->isDisposed = false;
-	this->isCallbackCallInProgress = false;
 	callbackTCPConnection = boost::shared_ptr<TCPConnectionDelegate>();
 	callbackTCPDataRead = boost::shared_ptr<TCPDataReadDelegate>();
 	callbackTCPDataWrite = boost::shared_ptr<TCPDataWriteDelegate>();
-	#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-		BOOST_INTERLOCKED_EXCHANGE(&counterAsyncReadOperationsInProgress, 0);
-		BOOST_INTERLOCKED_EXCHANGE(&counterAsyncWriteOperationsInProgress, 0);
-	#else
-		counterAsyncReadOperationsInProgress = 0;
-		counterAsyncWriteOperationsInProgress = 0;
-	#endif
 
     boostTcpSocket.set_verify_mode(boost::asio::ssl::verify_peer);
     boostTcpSocket.set_verify_callback(boost::bind(&TCPClientSSL::OnBoostAsioVerifyCertificate, this, _1, _2));
+
+	// The new session callback finds the server of the connection through this pointer
+	{
+		boost::lock_guard<boost::mutex> lock(mtxSessions);
+
+		if (sessionKeyIndex < 0)
+		{
+			sessionKeyIndex = SSL_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+		}
+	}
+
+	SSL_set_ex_data(boostTcpSocket.native_handle(), sessionKeyIndex, &sessionKey);
+
+	if (maxRecordSize > 0)
+	{
+		SSL_set_max_send_fragment(boostTcpSocket.native_handle(), maxRecordSize);
+	}
+}
+
+// -------------------------------------------------------------------
+// SharedContext
+// -------------------------------------------------------------------
+boost::shared_ptr<boost::asio::ssl::context> TCPClientSSL::SharedContext()
+{
+	boost::lock_guard<boost::mutex> lock(mtxSessions);
+
+	if (sharedContext == NULL)
+	{
+		// Create a context that uses the default paths for finding CA certificates
+		sharedContext = boost::shared_ptr<boost::asio::ssl::context>(new boost::asio::ssl::context(boost::asio::ssl::context::sslv23));
+		sharedContext->set_default_verify_paths();
+
+		// Sessions are kept by the clients, keyed by server, rather than by the OpenSSL cache that is meant for servers
+		SSL_CTX_set_session_cache_mode(sharedContext->native_handle(), SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+		SSL_CTX_sess_set_new_cb(sharedContext->native_handle(), &TCPClientSSL::OnOpenSSLNewSession);
+	}
+
+	return sharedContext;
+}
+
+// -------------------------------------------------------------------
+// MaxRecordSize
+// -------------------------------------------------------------------
+long int TCPClientSSL::MaxRecordSize()
+{
+	return maxRecordSize;
+}
+
+// -------------------------------------------------------------------
+// MaxRecordSize
+// -------------------------------------------------------------------
+void TCPClientSSL::MaxRecordSize(long int value)
+{
+	// Applies to the clients created afterwards
+	maxRecordSize = (value <= 0) ? 0 : std::max(512L, std::min(16384L, value));
+}
+
+// -------------------------------------------------------------------
+// ClearSessions
+// -------------------------------------------------------------------
+void TCPClientSSL::ClearSessions()
+{
+	boost::lock_guard<boost::mutex> lock(mtxSessions);
+
+	map<string, SSL_SESSION*>::iterator iterator;
+	for (iterator = sessions.begin(); iterator != sessions.end(); iterator++)
+	{
+		SSL_SESSION_free(iterator->second);
+	}
+
+	sessions.clear();
+}
+
+// -------------------------------------------------------------------
+// ResumeSession
+// -------------------------------------------------------------------
+void TCPClientSSL::ResumeSession(const string& server, unsigned short int ipPort)
+{
+	std::stringstream ss;
+	ss << server << ":" << ipPort;
+	sessionKey = ss.str();
+
+	boost::lock_guard<boost::mutex> lock(mtxSessions);
+
+	map<string, SSL_SESSION*>::iterator iterator = sessions.find(sessionKey);
+	if (iterator != sessions.end())
+	{
+		// An expired or rejected session simply results in a full handshake
+		SSL_set_session(boostTcpSocket.native_handle(), iterator->second);
+	}
+}
+
+// -------------------------------------------------------------------
+// ServerName
+// -------------------------------------------------------------------
+void TCPClientSSL::ServerName(const string& hostName)
+{
+	boost::system::error_code error;
+	boost::asio::ip::address::from_string(hostName, error);
+
+	if (hostName.size() == 0 || !error)
+	{
+		return;
+	}
+
+	SSL_set_tlsext_host_name(boostTcpSocket.native_handle(), hostName.c_str());
+}
+
+// -------------------------------------------------------------------
+// ForgetSession
+// -------------------------------------------------------------------
+void TCPClientSSL::ForgetSession()
+{
+	boost::lock_guard<boost::mutex> lock(mtxSessions);
+
+	map<string, SSL_SESSION*>::iterator iterator = sessions.find(sessionKey);
+	if (iterator != sessions.end())
+	{
+		SSL_SESSION_free(iterator->second);
+		sessions.erase(iterator);
+	}
+}
+
+// -------------------------------------------------------------------
+// OnOpenSSLNewSession
+// -------------------------------------------------------------------
+int TCPClientSSL::OnOpenSSLNewSession(SSL* ssl, SSL_SESSION* session)
+{
+	string* key = (string*)SSL_get_ex_data(ssl, sessionKeyIndex);
+	if (key == NULL || key->size() == 0)
+	{
+		return 0;
+	}
+
+	boost::lock_guard<boost::mutex> lock(mtxSessions);
+
+	map<string, SSL_SESSION*>::iterator iterator = sessions.find(*key);
+	if (iterator != sessions.end())
+	{
+		SSL_SESSION_free(iterator->second);
+		sessions.erase(iterator);
+	}
+	else if ((long int)sessions.size() >= MAX_SESSIONS)
+	{
+		SSL_SESSION_free(sessions.begin()->second);
+		sessions.erase(sessions.begin());
+	}
+
+	sessions[*key] = session;
+
+	// Returning 1 keeps the reference to the session, released when it is replaced or forgotten
+	return 1;
+}
+
+// -------------------------------------------------------------------
+// IsSessionResumed
+// -------------------------------------------------------------------
+bool TCPClientSSL::IsSessionResumed()
+{
+	return SSL_session_reused(boostTcpSocket.native_handle()) == 1;
 }
 
 // -------------------------------------------------------------------
@@ -49,15 +223,8 @@ TCPClientSSL::TCPClientSSL (boost::asio::io_service& io_service, boost::asio::ss
 // -------------------------------------------------------------------
 TCPClientSSL::~TCPClientSSL()
 {
-	// Wait for completion of asynchronous operations 
-	long int counterInProgressAsyncRead = counterAsyncReadOperationsInProgress = 0;
-	long int counterInProgressAsyncWrite = counterAsyncWriteOperationsInProgress = 0;
-	do
-	{
-		counterInProgressAsyncRead = counterAsyncReadOperationsInProgress;
-		counterInProgressAsyncWrite = counterAsyncWriteOperationsInProgress;
-	} while ((counterInProgressAsyncRead > 0) || (counterInProgressAsyncWrite > 0));
-	//MAX while ((counterAsyncReadOperationsInProgress > 0) || (counterAsyncWriteOperationsInProgress > 0));
+	// Nothing to wait for: every pending asynchronous operation holds a reference to the client,
+	// so the destructor only runs once all of them have completed
 }
 
 // -------------------------------------------------------------------
@@ -81,9 +248,11 @@ void TCPClientSSL::Connect (boost::shared_ptr<IPAddress> ipAddress, unsigned sho
 	// Preserve callback that will be used to notify tcp connection result
 	callbackTCPConnection = callback;
 
+	ResumeSession(*(ipAddress->Address()), ipPort);
+
 	// Start deadline timer for tcp connection task
     boostTimerTaskDeadline.expires_from_now(boost::posix_time::seconds(timeout));
-	boostTimerTaskDeadline.async_wait(boost::bind(&TCPClientSSL::OnBoostAsioConnectTimedout, this, boost::asio::placeholders::error));
+	boostTimerTaskDeadline.async_wait(boost::bind(&TCPClientSSL::OnBoostAsioConnectTimedout, shared_from_this(), boost::asio::placeholders::error));
 
 	// Attempt to establish a tcp connection
 	//boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(*(ipAddress->Address())), ipPort);
@@ -93,7 +262,39 @@ void TCPClientSSL::Connect (boost::shared_ptr<IPAddress> ipAddress, unsigned sho
     boost::asio::ip::tcp::resolver::query query(*(ipAddress->Address()), ss.str());
 	boost::asio::ip::tcp::resolver::iterator endpoint_iterator = boostTcpResolver.resolve(query);
 
-	boost::asio::async_connect(boostTcpSocket.lowest_layer(), endpoint_iterator,  boost::bind(&TCPClientSSL::OnBoostAsioConnect, this, boost::asio::placeholders::error));
+	boost::asio::async_connect(boostTcpSocket.lowest_layer(), endpoint_iterator,  boost::bind(&TCPClientSSL::OnBoostAsioConnect, shared_from_this(), boost::asio::placeholders::error));
+}
+
+// -------------------------------------------------------------------
+// Connect
+// -------------------------------------------------------------------
+void TCPClientSSL::Connect (boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ipAddresses, const string& hostName, unsigned short int ipPort, long int timeout, boost::shared_ptr<TCPConnectionDelegate> callback)
+{
+	if (this->isDisposed == true)
+	{
+		return;
+	}
+
+	// Preserve callback that will be used to notify tcp connection result
+	callbackTCPConnection = callback;
+
+	// The session belongs to the server rather than to one of its addresses
+	ServerName(hostName);
+	ResumeSession((hostName.size() > 0) ? hostName : *(ipAddresses->front()->Address()), ipPort);
+
+	connectEndpoints.clear();
+	vector<boost::shared_ptr<IPAddress> >::iterator iterator;
+	for (iterator = ipAddresses->begin(); iterator != ipAddresses->end(); ++iterator)
+	{
+		connectEndpoints.push_back(tcp::endpoint(boost::asio::ip::address::from_string(*((*iterator)->Address())), ipPort));
+	}
+
+	// Start deadline timer for tcp connection task
+    boostTimerTaskDeadline.expires_from_now(boost::posix_time::seconds(timeout));
+	boostTimerTaskDeadline.async_wait(boost::bind(&TCPClientSSL::OnBoostAsioConnectTimedout, shared_from_this(), boost::asio::placeholders::error));
+
+	// Attempt to establish a tcp connection; the socket is closed and the next address is attempted when one fails
+	boost::asio::async_connect(boostTcpSocket.lowest_layer(), connectEndpoints.begin(), connectEndpoints.end(), boost::bind(&TCPClientSSL::OnBoostAsioConnect, shared_from_this(), boost::asio::placeholders::error));
 }
 
 // -------------------------------------------------------------------
@@ -120,8 +321,15 @@ void TCPClientSSL::SynchConnect (boost::shared_ptr<IPAddress> ipAddress, unsigne
 
     if (!error)
     {
+		ResumeSession(*(ipAddress->Address()), ipPort);
+
 	    boostTcpSocket.set_verify_mode(boost::asio::ssl::context::verify_none);
 		boostTcpSocket.handshake(boost::asio::ssl::stream_base::client, error);
+
+		if (error)
+		{
+			ForgetSession();
+		}
     }
 }
 
@@ -130,6 +338,12 @@ void TCPClientSSL::SynchConnect (boost::shared_ptr<IPAddress> ipAddress, unsigne
 // -------------------------------------------------------------------
 void TCPClientSSL::Shutdown()
 {
+	// The connection is closed without the TLS closure alert: OpenSSL would then discard the session as if it had been broken
+	if (SSL_is_init_finished(boostTcpSocket.native_handle()))
+	{
+		SSL_set_shutdown(boostTcpSocket.native_handle(), SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+	}
+
 	// Cancel all asynchronous operations associated with the socket
     boostTcpSocket.lowest_layer().close();
     //boostIoService.stop();
@@ -163,23 +377,27 @@ void TCPClientSSL::OnBoostAsioConnect(const boost::system::error_code& code)
 	// Stop deadline timer for tcp connection task
 	boostTimerTaskDeadline.cancel();
 
-	this->isCallbackCallInProgress = true;
+	BeginCallback();
 
 	if (this->isDisposed == true)
 	{
-		this->isCallbackCallInProgress = false;
+		EndCallback();
 		return;
 	}
 
-	// Notify the establishment of the tcp connection
-	callbackTCPConnection->Invoke((SocketErrors)(code.value()));
-
-	this->isCallbackCallInProgress = false;
-
     if (!code)
     {
-		boostTcpSocket.async_handshake(boost::asio::ssl::stream_base::client, boost::bind(&TCPClientSSL::OnBoostAsioHandleHandshake, this, boost::asio::placeholders::error));
+		// The connection is notified once the TLS handshake has completed, data cannot be exchanged before
+		boostTcpSocket.async_handshake(boost::asio::ssl::stream_base::client, boost::bind(&TCPClientSSL::OnBoostAsioHandleHandshake, shared_from_this(), boost::asio::placeholders::error));
+
+		EndCallback();
+		return;
     }
+
+	// Notify the establishment of the tcp connection
+	callbackTCPConnection->Invoke((SocketErrors)(code.value()));
+
+	EndCallback();
 }
 
 // -------------------------------------------------------------------
@@ -187,7 +405,23 @@ void TCPClientSSL::OnBoostAsioConnect(const boost::system::error_code& code)
 // -------------------------------------------------------------------
 void TCPClientSSL::OnBoostAsioHandleHandshake(const boost::system::error_code& error)
 {
-	// quando questo metodo  stato chiamato si pu iniziare a fare send/receive
+	BeginCallback();
+
+	if (this->isDisposed == true)
+	{
+		EndCallback();
+		return;
+	}
+
+	if (error)
+	{
+		ForgetSession();
+	}
+
+	// Notify the establishment of the tcp connection, data can now be exchanged
+	callbackTCPConnection->Invoke((SocketErrors)(error.value()));
+
+	EndCallback();
 }
 
 // -------------------------------------------------------------------
@@ -204,18 +438,18 @@ void TCPClientSSL::OnBoostAsioConnectTimedout(const boost::system::error_code& c
 
 	// Deadline timer for tcp connection task is expired
 
-	this->isCallbackCallInProgress = true;
+	BeginCallback();
 
 	if (this->isDisposed == true)
 	{
-		this->isCallbackCallInProgress = false;
+		EndCallback();
 		return;
 	}
 
-	// Notify the establishment of the tco connection
-	callbackTCPConnection->Invoke((SocketErrors)(code.value()));
+	// Notify the failure of the tcp connection: the expired timer reports no error by itself
+	callbackTCPConnection->Invoke(SocketErrors_TimedOut);
 
-	this->isCallbackCallInProgress = false;
+	EndCallback();
 }
 
 // -------------------------------------------------------------------
@@ -237,12 +471,7 @@ void TCPClientSSL::AsynchRead (boost::shared_ptr<TCPDataReadDelegate> callback)
 	boost::lock_guard<boost::recursive_mutex> unlock(mtxDisconnection);
 
 	// Schedule asyncronous read
-	#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-		BOOST_INTERLOCKED_INCREMENT(&counterAsyncReadOperationsInProgress);
-	#else
-		counterAsyncReadOperationsInProgress++;
-	#endif
-	boostTcpSocket.async_read_some(boost::asio::buffer(boostTcpInputBuffer), boost::bind(&TCPClientSSL::OnBoostAsioDataReceived, this, _1, _2));
+	boostTcpSocket.async_read_some(boost::asio::buffer(boostTcpInputBuffer), boost::bind(&TCPClientSSL::OnBoostAsioDataReceived, shared_from_this(), _1, _2));
 }
 
 // -------------------------------------------------------------------
@@ -310,12 +539,8 @@ void TCPClientSSL::AsynchWrite (boost::shared_ptr<vector<unsigned char> > data,
 	//memcpy ((void*)(bufferOutput.get()), data->data(), data->size());
 
 	// Schedule an asynchronous write to dispatch outgoing data over Tcp socket
-	#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-		BOOST_INTERLOCKED_INCREMENT(&counterAsyncWriteOperationsInProgress);
-	#else
-		counterAsyncWriteOperationsInProgress++;	
-	#endif
-	boostTcpSocket.async_write_some(boost::asio::buffer((void*)bufferOutput.get(), (size_t)data->size()), boost::bind(&TCPClientSSL::OnBoostAsioDataSent, this, bufferOutput, data->size(), boost::asio::placeholders::bytes_transferred, boost::asio::placeholders::error));
+	// async_write completes only when every byte has been transmitted, so a single write is in progress on the SSL stream
+	boost::asio::async_write(boostTcpSocket, boost::asio::buffer((void*)bufferOutput.get(), (size_t)data->size()), boost::bind(&TCPClientSSL::OnBoostAsioDataSent, shared_from_this(), bufferOutput, data->size(), boost::asio::placeholders::bytes_transferred, boost::asio::placeholders::error));
 }
 
 // -------------------------------------------------------------------
@@ -349,11 +574,11 @@ void TCPClientSSL::SynchWrite (boost::shared_ptr<vector<unsigned char> > data)
 // -------------------------------------------------------------------
 void TCPClientSSL::OnBoostAsioDataSent(boost::shared_ptr<unsigned char> bufferOutput, size_t length, size_t transferred, const boost::system::error_code& error)
 {
-	this->isCallbackCallInProgress = true;
+	BeginCallback();
 
 	if (this->isDisposed == true)
 	{
-		this->isCallbackCallInProgress = false;
+		EndCallback();
 		return;
 	}
 
@@ -367,34 +592,7 @@ void TCPClientSSL::OnBoostAsioDataSent(boost::shared_ptr<unsigned char> bufferOu
 
 	boost::lock_guard<boost::recursive_mutex> unlock(mtxDisconnection);
 
-	// Check if all output data have been transmitted
-	if (transferred != length)
-	{
-		// Not all data have been transmitted
-
-		// Allocate a smart pointer to a vector where take place outgoing data
-		boost::shared_ptr<unsigned char> bufferNextOutput(new unsigned char[length - transferred], array_deleter<unsigned char>());
-		memcpy ((void*)(bufferNextOutput.get()), bufferOutput.get() + transferred, length - transferred);
-
-		// Schedule an asynchronous write to dispatch outgoing data over Tcp socket
-		boostTcpSocket.async_write_some(boost::asio::buffer((void*)bufferNextOutput.get(), (length - transferred)), boost::bind(&TCPClientSSL::OnBoostAsioDataSent, this, bufferNextOutput, (length - transferred), boost::asio::placeholders::bytes_transferred, boost::asio::placeholders::error));
-
-		this->isCallbackCallInProgress = false;
-
-		return;
-	}
-
-	// Decrease counter of asynchronous write that are in progress
-	if (counterAsyncWriteOperationsInProgress > 0)
-	{
-		#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-			BOOST_INTERLOCKED_DECREMENT(&counterAsyncWriteOperationsInProgress);
-		#else
-			counterAsyncWriteOperationsInProgress--;
-		#endif
-	}
-		
-	this->isCallbackCallInProgress = false;
+	EndCallback();
 }
 
 // -------------------------------------------------------------------
@@ -402,11 +600,11 @@ void TCPClientSSL::OnBoostAsioDataSent(boost::shared_ptr<unsigned char> bufferOu
 // -------------------------------------------------------------------
 void TCPClientSSL::OnBoostAsioDataReceived(const boost::system::error_code& error, long int length)
 {
-	this->isCallbackCallInProgress = true;
+	BeginCallback();
 
 	if (this->isDisposed == true)
 	{
-		this->isCallbackCallInProgress = false;
+		EndCallback();
 		return;
 	}
 
@@ -433,25 +631,71 @@ void TCPClientSSL::OnBoostAsioDataReceived(const boost::system::error_code& erro
 
 	boost::lock_guard<boost::recursive_mutex> unlock(mtxDisconnection);
 
-	// Decrease counter of asynchronous read that are in progress
-	if (counterAsyncReadOperationsInProgress > 0)
+	EndCallback();
+}
+
+// -------------------------------------------------------------------
+// CallbackCallInProgress
+// -------------------------------------------------------------------
+bool TCPClientSSL::CallbackCallInProgress()
+{
+	boost::lock_guard<boost::mutex> lock(mtxCallbacks);
+	return !callbackThreads.empty();
+}
+
+// -------------------------------------------------------------------
+// WaitCallbackCompletion
+// -------------------------------------------------------------------
+void TCPClientSSL::WaitCallbackCompletion()
+{
+	boost::thread::id self = boost::this_thread::get_id();
+
+	boost::unique_lock<boost::mutex> lock(mtxCallbacks);
+	while (true)
 	{
-		#if defined( WIN32 ) || defined( _WIN32 ) || defined( __WIN32__ ) || defined( __CYGWIN__ )
-			BOOST_INTERLOCKED_DECREMENT(&counterAsyncReadOperationsInProgress);
-		#else
-			counterAsyncReadOperationsInProgress--;
-		#endif
+		// Callbacks running on the calling thread are not waited for
+		bool otherCallbackInProgress = false;
+		for (vector<boost::thread::id>::iterator iterator = callbackThreads.begin(); iterator != callbackThreads.end(); ++iterator)
+		{
+			if (*iterator != self)
+			{
+				otherCallbackInProgress = true;
+				break;
+			}
+		}
+
+		if (!otherCallbackInProgress)
+		{
+			return;
+		}
+
+		conditionCallbacks.wait(lock);
 	}
+}
 
-	this->isCallbackCallInProgress = false;
+// -------------------------------------------------------------------
+// BeginCallback
+// -------------------------------------------------------------------
+void TCPClientSSL::BeginCallback()
+{
+	boost::lock_guard<boost::mutex> lock(mtxCallbacks);
+	callbackThreads.push_back(boost::this_thread::get_id());
 }
 
 // -------------------------------------------------------------------
-// CallbackCallInProgress
+// EndCallback
 // -------------------------------------------------------------------
-bool TCPClientSSL::CallbackCallInProgress()
+void TCPClientSSL::EndCallback()
 {
-	return isCallbackCallInProgress;
+	boost::lock_guard<boost::mutex> lock(mtxCallbacks);
+
+	vector<boost::thread::id>::iterator iterator = std::find(callbackThreads.begin(), callbackThreads.end(), boost::this_thread::get_id());
+	if (iterator != callbackThreads.end())
+	{
+		callbackThreads.erase(iterator);
+	}
+
+	conditionCallbacks.notify_all();
 }
 
 }	// namespace Sockets
@@ -24,12 +24,18 @@
 #include <boost/enable_shared_from_this.hpp>	// Boost Asio shared from this
 #include <boost/thread/recursive_mutex.hpp>		// Boost Asio header
 #include <boost/thread/lock_guard.hpp>			// Boost Asio header
+#include <boost/thread/mutex.hpp>				// Boost Asio header
+#include <boost/thread/condition_variable.hpp>	// Boost Asio header
+#include <boost/thread/thread.hpp>				// Boost Asio header
 #include <boost/asio/ssl.hpp>					// Boost Asio header
 
 #if defined(_MSC_VER)
 #pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
 #endif
 #include <vector>						// STL library: vector object
+#include <string>						// STL library: string object
+#include <map>							// STL library: map object
+#include <algorithm>					// STL library: find algorithm
 using namespace std;					// STL library: declare the STL namespace
 
 using boost::asio::ip::tcp;					// Boost Asio namespace
@@ -59,6 +65,12 @@ namespace Sockets {
 		// -------------------------------------------------------------------
 
 		// Constructor
+		// Uses the SSL context shared by all the clients, that resumes the sessions of previous connections
+		//		io_service		Boost Asio service
+		TCPClientSSL (boost::asio::io_service& io_service);
+
+		// Constructor
+		// Sessions are resumed only if the context caches them as the shared one does
 		//		io_service		Boost Asio service
 		//		context			SSL context
 		TCPClientSSL (boost::asio::io_service& io_service, boost::asio::ssl::context& context);
@@ -75,6 +87,16 @@ namespace Sockets {
 		//		timeout			Connection timeout expressed in seconds
 		//		callback		Callback to notify operation result
 		void Connect (boost::shared_ptr<IPAddress> ipAddress, unsigned short int ipPort, long int timeout, boost::shared_ptr<TCPConnectionDelegate> callback);
+
+		// Connect
+		// Attemps to establish a tcp client connection to one of the addresses of a server
+		// Addresses are attempted in order: the next one is tried when the previous one fails
+		//		ipAddresses		Server ip addresses expressed in dotted form
+		//		hostName		Server host name, sent for SNI and used to resume the session; empty to use the ip address
+		//		ipPort			Server ip port
+		//		timeout			Connection timeout expressed in seconds
+		//		callback		Callback to notify operation result
+		void Connect (boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ipAddresses, const string& hostName, unsigned short int ipPort, long int timeout, boost::shared_ptr<TCPConnectionDelegate> callback);
 		
 		// Connect
 		// Attemps to establish a tcp client connection
@@ -109,6 +131,30 @@ namespace Sockets {
 
 		bool CallbackCallInProgress();
 
+		// IsSessionResumed
+		// Returns true when the handshake has resumed the session of a previous connection instead of negotiating a new one
+		bool IsSessionResumed();
+
+		// SharedContext
+		// Returns the SSL context shared by the clients: it is created once, with the default CA paths,
+		// and keeps the sessions of the servers for the following connections
+		static boost::shared_ptr<boost::asio::ssl::context> SharedContext();
+
+		// MaxRecordSize
+		// Largest TLS record sent, in bytes (512 to 16384); 0 keeps the OpenSSL default of 16384
+		// Smaller records let the receiver decrypt the first bytes of a message sooner over slow links
+		static long int MaxRecordSize();
+		static void MaxRecordSize(long int value);
+
+		// ClearSessions
+		// Forgets the sessions kept for resumption, so the next connections perform a full handshake
+		static void ClearSessions();
+
+		// WaitCallbackCompletion
+		// Blocks until no callback of this client is running, being woken up as soon as the last one returns
+		// Returns at once when called from within a callback, that would otherwise wait for itself
+		void WaitCallbackCompletion();
+
 		// -------------------------------------------------------------------
 		// Public members
 		// -------------------------------------------------------------------
@@ -157,6 +203,33 @@ namespace Sockets {
 		//		error				Error code
 		void OnBoostAsioDataSent(boost::shared_ptr<unsigned char> bufferOutput, size_t length, size_t transferred, const boost::system::error_code& error);
 
+		// Initialize
+		// Common setup of the constructors
+		void Initialize();
+
+		// ResumeSession
+		// Offers the session of the previous connection to the same server, if any, to the next handshake
+		//		server		Host name or ip address of the server
+		//		ipPort		Server ip port
+		void ResumeSession(const string& server, unsigned short int ipPort);
+
+		// ServerName
+		// Sets the host name sent for SNI; ip addresses are not sent
+		void ServerName(const string& hostName);
+
+		// ForgetSession
+		// Drops the session kept for the server, e.g. when the handshake has failed
+		void ForgetSession();
+
+		// OnOpenSSLNewSession
+		// Callback of OpenSSL to notify a session that can be resumed; with TLS 1.3 it arrives after the handshake
+		static int OnOpenSSLNewSession(SSL* ssl, SSL_SESSION* session);
+
+		// BeginCallback / EndCallback
+		// Mark the calling thread as running a callback of this client
+		void BeginCallback();
+		void EndCallback();
+
 		// -------------------------------------------------------------------
 		// Private members
 		// -------------------------------------------------------------------
@@ -175,10 +248,22 @@ namespace Sockets {
 
 		boost::recursive_mutex mtxDisconnection;			// Mutex to synchronize Tcp disconnection tasks 
 
-		long int counterAsyncReadOperationsInProgress;		// Counter of asynchronous read operations that are in progress
-		long int counterAsyncWriteOperationsInProgress;		// Counter of asynchronous write operations that are in progress
+		boost::mutex mtxCallbacks;							// Mutex to synchronize the tracking of running callbacks
+		boost::condition_variable conditionCallbacks;		// Signaled when a callback returns
+		vector<boost::thread::id> callbackThreads;			// Threads that are running a callback
+
 		bool isDisposed;
-		bool isCallbackCallInProgress;
+
+		string sessionKey;									// Server host name or address and port the session is kept for
+		vector<tcp::endpoint> connectEndpoints;				// Server addresses to attempt
+
+		static boost::shared_ptr<boost::asio::ssl::context> sharedContext;
+		static map<string, SSL_SESSION*> sessions;			// Resumable sessions by server
+		static boost::mutex mtxSessions;					// Mutex to synchronize the shared context and the sessions
+		static long int maxRecordSize;
+		static int sessionKeyIndex;							// Index of the OpenSSL data that maps a connection to its client
+
+		const static long int MAX_SESSIONS = 32;
 	};
 
 }	// namespace Sockets
@@ -16,14 +16,42 @@ namespace Sfs2X {
 namespace Core {
 namespace Sockets {
 
+// Next state by current state (rows) and transition (columns)
+const TCPSocketLayer::SocketStateTable::Table TCPSocketLayer::SOCKET_STATE_TABLE =
+{
+	// States_Disconnected
+	{
+		States_Connecting,			// Transitions_StartConnect
+		States_Disconnected,		// Transitions_ConnectionSuccess
+		States_Disconnected,		// Transitions_ConnectionFailure
+		States_Disconnected			// Transitions_Disconnect
+	},
+
+	// States_Connecting
+	{
+		States_Connecting,			// Transitions_StartConnect
+		States_Connected,			// Transitions_ConnectionSuccess
+		States_Disconnected,		// Transitions_ConnectionFailure
+		States_Connecting			// Transitions_Disconnect
+	},
+
+	// States_Connected
+	{
+		States_Connected,			// Transitions_StartConnect
+		States_Connected,			// Transitions_ConnectionSuccess
+		States_Connected,			// Transitions_ConnectionFailure
+		States_Disconnected			// Transitions_Disconnect
+	}
+};
+
 // -------------------------------------------------------------------
 // Constructor
 // -------------------------------------------------------------------
 TCPSocketLayer::TCPSocketLayer (boost::shared_ptr<BitSwarmClient> bs) 
+	: fsm(SOCKET_STATE_TABLE, States_Disconnected)
 {
-	fsm = boost::shared_ptr<FiniteStateMachine>();
 	connection = boost::shared_ptr<TCPClient>();
-	ipAddress = boost::shared_ptr<IPAddress>();
+	ipAddresses = boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >();
 	onConnect = boost::shared_ptr<ConnectionDelegate>();
 	onDisconnect = boost::shared_ptr<ConnectionDelegate>();
 	onError = boost::shared_ptr<OnErrorDelegate>();
@@ -49,10 +77,7 @@ void TCPSocketLayer::Dispose()
 	{
 		this->connection->Dispose();
 
-		while (this->connection->CallbackCallInProgress() == true)
-		{
-			boost::this_thread::sleep(boost::posix_time::milliseconds(100));
-		}
+		this->connection->WaitCallbackCompletion();
 	}
 
 	lockDispose.lock();
@@ -76,21 +101,8 @@ TCPSocketLayer::~TCPSocketLayer()
 // -------------------------------------------------------------------
 void TCPSocketLayer::InitStates() 
 {
-	fsm = boost::shared_ptr<FiniteStateMachine>(new FiniteStateMachine());
-
-	std::vector<long int> states;
-	for (long int enumerator = TCPSocketLayer::States_Disconnected; enumerator <= TCPSocketLayer::States_Connected; enumerator++)
-	{
-		states.push_back(enumerator);
-	}
-	fsm->AddAllStates(states);
-			
-	fsm->AddStateTransition(States_Disconnected, States_Connecting, Transitions_StartConnect);
-	fsm->AddStateTransition(States_Connecting, States_Connected, Transitions_ConnectionSuccess);
-	fsm->AddStateTransition(States_Connecting, States_Disconnected, Transitions_ConnectionFailure);
-	fsm->AddStateTransition(States_Connected, States_Disconnected, Transitions_Disconnect);
-				
-	fsm->SetCurrentState(States_Disconnected);
+	// The transitions are the constant SOCKET_STATE_TABLE
+	fsm.SetCurrentState(States_Disconnected);
 }
 		
 // -------------------------------------------------------------------
@@ -98,7 +110,7 @@ void TCPSocketLayer::InitStates()
 // -------------------------------------------------------------------
 TCPSocketLayer::States TCPSocketLayer::State() 
 {
-	return (States)fsm->GetCurrentState();
+	return fsm.GetCurrentState();
 }
 			
 // -------------------------------------------------------------------
@@ -214,7 +226,7 @@ void TCPSocketLayer::HandleErrorCallback(unsigned long long context, boost::shar
 		
 	SocketErrors se = (SocketErrors)errAsInteger;
 			
-	instance->fsm->ApplyTransition(Transitions_ConnectionFailure);
+	instance->fsm.ApplyTransition(Transitions_ConnectionFailure);
 
 	// Dont spam errors when disconnecting
 	if (!instance->isDisconnecting) 
@@ -236,7 +248,7 @@ void TCPSocketLayer::HandleDisconnection()
 		return;
 	}
 
-	fsm->ApplyTransition(Transitions_Disconnect);
+	fsm.ApplyTransition(Transitions_Disconnect);
 	CallOnDisconnect();
 }
 
@@ -311,7 +323,7 @@ void TCPSocketLayer::OnSocketConnection(unsigned long long context, SocketErrors
 		// Connection established
 
 		// Notify connection result
-		instance->fsm->ApplyTransition(Transitions_ConnectionSuccess);
+		instance->fsm.ApplyTransition(Transitions_ConnectionSuccess);
 		instance->CallOnConnect();
 
 		// Schedule an asynchronous read
@@ -334,10 +346,18 @@ void TCPSocketLayer::OnSocketDataSent(unsigned long long context, SocketErrors c
 	// Map context
 	TCPSocketLayer* instance = (TCPSocketLayer*)context;
 
+	// The bytes just written, or dropped by a failed write, may bring the output back under the low watermark
+	boost::shared_ptr<BitSwarmClient> client = instance->bitSwarm;
+	if (client != NULL)
+	{
+		client->CheckSendWatermarks();
+	}
+
 	if (code != SocketErrors_Success) 
 	{
 		boost::shared_ptr<string> message (new string("Error sending data to remote side over the established connection"));
 		instance->HandleError(message, code);	
+		return;
     }
 }
 
@@ -421,6 +441,17 @@ void TCPSocketLayer::WriteSocket(boost::shared_ptr<vector<unsigned char> > data)
 // Connect
 // -------------------------------------------------------------------
 void TCPSocketLayer::Connect(boost::shared_ptr<IPAddress> address, unsigned short int port)
+{
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses (new vector<boost::shared_ptr<IPAddress> >());
+	addresses->push_back(address);
+
+	Connect(addresses, port);
+}
+
+// -------------------------------------------------------------------
+// Connect
+// -------------------------------------------------------------------
+void TCPSocketLayer::Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, unsigned short int port)
 {
 	if (State() != States_Disconnected) 
 	{
@@ -435,9 +466,9 @@ void TCPSocketLayer::Connect(boost::shared_ptr<IPAddress> address, unsigned shor
 	}
 
 	socketNumber = port;
-	ipAddress = address;
+	ipAddresses = addresses;
 			
-	fsm->ApplyTransition(Transitions_StartConnect);
+	fsm.ApplyTransition(Transitions_StartConnect);
 
 	try
 	{
@@ -450,20 +481,22 @@ void TCPSocketLayer::Connect(boost::shared_ptr<IPAddress> address, unsigned shor
 		{
 			connection->Dispose();
 
-			while (connection->CallbackCallInProgress() == true)
-			{
-				boost::this_thread::sleep(boost::posix_time::milliseconds(100));
-			}
+			connection->WaitCallbackCompletion();
 		}
 
 		connection = boost::shared_ptr<TCPClient>(new TCPClient(*(bitSwarm->GetBoostService())));
 
 		this->me = shared_from_this();
 		boost::shared_ptr<TCPConnectionDelegate> callback (new TCPConnectionDelegate(&TCPSocketLayer::OnSocketConnection, (unsigned long long)this));
-		connection->Connect(ipAddress, socketNumber, Const_TimeoutConnect, callback);
+		// Every address is attempted, the first one to connect is used
+		connection->Connect(ipAddresses, socketNumber, Const_TimeoutConnect, callback);
 
-		bitSwarm->GetBoostService()->reset();
-		boost::thread t(boost::bind(static_cast<size_t (boost::asio::io_service::*)()>(&boost::asio::io_service::run), bitSwarm->GetBoostService()));
+		// In poll mode the completions run on the thread that calls Poll
+		if (bitSwarm->PollMode() == false)
+		{
+			bitSwarm->GetBoostService()->reset();
+			boost::thread t(boost::bind(static_cast<size_t (boost::asio::io_service::*)()>(&boost::asio::io_service::run), bitSwarm->GetBoostService()));
+		}
 	}
 	catch (...)
 	{
@@ -502,10 +535,7 @@ void TCPSocketLayer::Disconnect()
 
 	isDisconnecting = true;
 			
-    while (this->connection->CallbackCallInProgress() == true)
-    {
-        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
-    }
+    this->connection->WaitCallbackCompletion();
 
 	try 
 	{
@@ -559,6 +589,15 @@ void TCPSocketLayer::Write(boost::shared_ptr<vector<unsigned char> > data)
 	WriteSocket(data);
 }
 
+// -------------------------------------------------------------------
+// PendingWriteBytes
+// -------------------------------------------------------------------
+long int TCPSocketLayer::PendingWriteBytes()
+{
+	boost::shared_ptr<TCPClient> client = connection;
+	return (client != NULL) ? client->PendingWriteBytes() : 0;
+}
+
 // -------------------------------------------------------------------
 // OnData
 // -------------------------------------------------------------------
@@ -598,10 +637,7 @@ void TCPSocketLayer::Kill()
 {
 	isDisconnecting = true;
 			
-    while (this->connection->CallbackCallInProgress() == true)
-    {
-        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
-    }
+    this->connection->WaitCallbackCompletion();
 
 	try 
 	{
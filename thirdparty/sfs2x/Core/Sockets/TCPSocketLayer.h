@@ -14,7 +14,7 @@
 #include "ISocketLayer.h"						// ISocketLayer interface
 #include "../../Logging/Logger.h"				// Logging service
 #include "../../Bitswarm/BitSwarmClient.h"		// Bitswarm
-#include "../../FSM/FiniteStateMachine.h"		// State machine
+#include "../../FSM/StateTable.h"				// State machine
 #include "TCPClient.h"							// TCP client handler
 #include "../../Util/Common.h"					// Common API items
 
@@ -93,6 +93,7 @@ namespace Sockets {
 		// ISocketLayer implementation
 
 		virtual void Connect(boost::shared_ptr<IPAddress> address, unsigned short int port);
+		virtual void Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, unsigned short int port);
 		virtual bool IsConnected();
 		virtual bool RequiresConnection();
 		virtual void Disconnect();
@@ -104,6 +105,7 @@ namespace Sockets {
 		virtual void OnDisconnect(boost::shared_ptr<ConnectionDelegate> onDisconnect);	// Set delegate
 
 		virtual void Write(boost::shared_ptr<vector<unsigned char> >);
+		virtual long int PendingWriteBytes();
 
 		virtual boost::shared_ptr<OnDataDelegate> OnData();								// Get delegate
 		virtual void OnData(boost::shared_ptr<OnDataDelegate> onData);					// Set delegate
@@ -173,10 +175,13 @@ namespace Sockets {
 		// Private members
 		// -------------------------------------------------------------------
 
+		typedef StateTable<States, Transitions, States_Connected + 1, Transitions_Disconnect + 1> SocketStateTable;
+
 		const static long int READ_BUFFER_SIZE = 4096;
 		boost::shared_ptr<Logger> log;
 		boost::shared_ptr<BitSwarmClient> bitSwarm;
-		boost::shared_ptr<FiniteStateMachine> fsm;
+		SocketStateTable fsm;									// Transitions follow the connection sequence, one thread at a time
+		static const SocketStateTable::Table SOCKET_STATE_TABLE;
 		volatile bool isDisconnecting;
 		long int socketPollSleep;
 
@@ -187,7 +192,7 @@ namespace Sockets {
 
 		boost::shared_ptr<TCPClient> connection;
 		unsigned short int socketNumber;
-		boost::shared_ptr<IPAddress> ipAddress;
+		boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ipAddresses;
 
 		boost::shared_ptr<ConnectionDelegate> onConnect;		// Callback to notify tcp connection result
 		boost::shared_ptr<ConnectionDelegate> onDisconnect;		// Callback to notify tcp disconnection result
@@ -69,15 +69,22 @@ void UDPClient::Connect (boost::shared_ptr<IPAddress> ipAddress, unsigned short
 
 	// Attempt to establish a udp connection
 	char buffer[512];
-	sprintf (buffer, "%ld", ipPort);
+	sprintf (buffer, "%d", (int)ipPort);
 	boost::shared_ptr<string> ipPortAsString (new string(buffer));
 
-    udp::resolver::query query(udp::v4(), *(ipAddress->Address()), *ipPortAsString); 
-    udp::resolver::iterator itr = boostUdpResolver.resolve(query);
-    boostUdpEndpoint = *itr; 
-
-	string endpointAddress = boostUdpEndpoint.address().to_string();
-	unsigned short int endpointPort = boostUdpEndpoint.port();
+	// SmartFox resolves the host before initializing UDP, so the address is normally an ip address of either family
+	boost::system::error_code error;
+	boost::asio::ip::address address = boost::asio::ip::address::from_string(*(ipAddress->Address()), error);
+	if (!error)
+	{
+		boostUdpEndpoint = udp::endpoint(address, ipPort);
+	}
+	else
+	{
+		udp::resolver::query query(udp::v4(), *(ipAddress->Address()), *ipPortAsString); 
+		udp::resolver::iterator itr = boostUdpResolver.resolve(query);
+		boostUdpEndpoint = *itr; 
+	}
 
 	boostUdpSocket.async_connect(boostUdpEndpoint,  boost::bind(&UDPClient::OnBoostAsioConnect, this, boost::asio::placeholders::error));
 }
@@ -284,7 +284,12 @@ void UDPSocketLayer::Connect(boost::shared_ptr<IPAddress> address, unsigned shor
 		connection = boost::shared_ptr<UDPClient>(new UDPClient(*(bitSwarm->GetBoostService())));
 		boost::shared_ptr<UDPConnectionDelegate> callback (new UDPConnectionDelegate(&UDPSocketLayer::OnSocketConnection, (unsigned long long)this));
 		connection->Connect(ipAddress, socketNumber, Const_TimeoutConnect, callback);
-		boost::thread bt(boost::bind(static_cast<size_t (boost::asio::io_service::*)()>(&boost::asio::io_service::run), bitSwarm->GetBoostService()));
+
+		// In poll mode the completions run on the thread that calls Poll
+		if (bitSwarm->PollMode() == false)
+		{
+			boost::thread bt(boost::bind(static_cast<size_t (boost::asio::io_service::*)()>(&boost::asio::io_service::run), bitSwarm->GetBoostService()));
+		}
 	}
 	catch (...)
 	{
@@ -293,6 +298,15 @@ void UDPSocketLayer::Connect(boost::shared_ptr<IPAddress> address, unsigned shor
 	}
 }
 
+// -------------------------------------------------------------------
+// Connect
+// -------------------------------------------------------------------
+void UDPSocketLayer::Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, unsigned short int port)
+{
+	// Datagrams are not acknowledged, there is no connection result to pick an address with
+	Connect(addresses->front(), port);
+}
+
 // -------------------------------------------------------------------
 // IsConnected
 // -------------------------------------------------------------------
@@ -376,6 +390,15 @@ void UDPSocketLayer::Write(boost::shared_ptr<vector<unsigned char> > data)
 	WriteSocket(data);
 }
 
+// -------------------------------------------------------------------
+// PendingWriteBytes
+// -------------------------------------------------------------------
+long int UDPSocketLayer::PendingWriteBytes()
+{
+	// Datagrams are handed to the system one at a time and never queued
+	return 0;
+}
+
 // -------------------------------------------------------------------
 // OnData
 // -------------------------------------------------------------------
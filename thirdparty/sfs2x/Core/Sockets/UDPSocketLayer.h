@@ -60,6 +60,7 @@ namespace Sockets {
 		// ISocketLayer implementation
 
 		virtual void Connect(boost::shared_ptr<IPAddress> address, unsigned short int port);
+		virtual void Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, unsigned short int port);
 		virtual bool IsConnected();
 		virtual bool RequiresConnection();
 		virtual void Disconnect();
@@ -71,6 +72,7 @@ namespace Sockets {
 		virtual void OnDisconnect(boost::shared_ptr<ConnectionDelegate> onDisconnect);	// Set delegate
 
 		virtual void Write(boost::shared_ptr<vector<unsigned char> >);
+		virtual long int PendingWriteBytes();
 
 		virtual boost::shared_ptr<OnDataDelegate> OnData();								// Get delegate
 		virtual void OnData(boost::shared_ptr<OnDataDelegate> onData);					// Set delegate
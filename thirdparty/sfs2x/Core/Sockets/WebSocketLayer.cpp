@@ -0,0 +1,1226 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of an handler for a WebSocket connection
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "WebSocketLayer.h"
+#include "../../Util/StringFormatter.h"
+using namespace Sfs2X::Util;
+
+#include <openssl/sha.h>
+#include <openssl/rand.h>
+#include <openssl/evp.h>
+
+#include <algorithm>					// STL library: transform algorithm
+
+namespace Sfs2X {
+namespace Core {
+namespace Sockets {
+
+boost::shared_ptr<string> WebSocketLayer::WEBSOCKET_PATH (new string("/websocket"));
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+WebSocketLayer::WebSocketLayer (boost::shared_ptr<BitSwarmClient> bs, bool useSSL, const string& host)
+{
+	fsm = boost::shared_ptr<FiniteStateMachine>();
+	connection = boost::shared_ptr<TCPClient>();
+	connectionSSL = boost::shared_ptr<TCPClientSSL>();
+	ipAddresses = boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >();
+	onConnect = boost::shared_ptr<ConnectionDelegate>();
+	onDisconnect = boost::shared_ptr<ConnectionDelegate>();
+	onError = boost::shared_ptr<OnErrorDelegate>();
+	onData = boost::shared_ptr<OnDataDelegate>();
+
+	this->useSSL = useSSL;
+	this->host = host;
+	isDisconnecting = false;
+	isDisposed = false;
+	isCloseSent = false;
+	isCloseReceived = false;
+	isClosePending = false;
+	isWriteInProgress = false;
+	outputInFlight = 0;
+	closeTimer = boost::shared_ptr<boost::asio::deadline_timer>();
+
+	log = bs->Log();
+	bitSwarm = bs;
+
+	InitStates();
+}
+
+// -------------------------------------------------------------------
+// Dispose
+// -------------------------------------------------------------------
+void WebSocketLayer::Dispose()
+{
+	isDisposed = true;
+
+	{
+		boost::lock_guard<boost::mutex> lock(mtxWrite);
+		isClosePending = false;
+	}
+
+	DisposeClient();
+
+	lockDispose.lock();
+
+	this->log = boost::shared_ptr<Logger>();
+	this->bitSwarm = boost::shared_ptr<BitSwarmClient>();
+	this->me = boost::shared_ptr<WebSocketLayer>();
+
+	lockDispose.unlock();
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+WebSocketLayer::~WebSocketLayer()
+{
+}
+
+// -------------------------------------------------------------------
+// InitStates
+// -------------------------------------------------------------------
+void WebSocketLayer::InitStates()
+{
+	fsm = boost::shared_ptr<FiniteStateMachine>(new FiniteStateMachine());
+
+	std::vector<long int> states;
+	for (long int enumerator = WebSocketLayer::States_Disconnected; enumerator <= WebSocketLayer::States_Connected; enumerator++)
+	{
+		states.push_back(enumerator);
+	}
+	fsm->AddAllStates(states);
+
+	fsm->AddStateTransition(States_Disconnected, States_Connecting, Transitions_StartConnect);
+	fsm->AddStateTransition(States_Connecting, States_Upgrading, Transitions_StartUpgrade);
+	fsm->AddStateTransition(States_Upgrading, States_Connected, Transitions_UpgradeSuccess);
+	fsm->AddStateTransition(States_Connecting, States_Disconnected, Transitions_ConnectionFailure);
+	fsm->AddStateTransition(States_Upgrading, States_Disconnected, Transitions_ConnectionFailure);
+	fsm->AddStateTransition(States_Connected, States_Disconnected, Transitions_Disconnect);
+
+	fsm->SetCurrentState(States_Disconnected);
+}
+
+// -------------------------------------------------------------------
+// State
+// -------------------------------------------------------------------
+WebSocketLayer::States WebSocketLayer::State()
+{
+	return (States)fsm->GetCurrentState();
+}
+
+// -------------------------------------------------------------------
+// UseSSL
+// -------------------------------------------------------------------
+bool WebSocketLayer::UseSSL()
+{
+	return useSSL;
+}
+
+// -------------------------------------------------------------------
+// Host
+// -------------------------------------------------------------------
+const string& WebSocketLayer::Host()
+{
+	return host;
+}
+
+// -------------------------------------------------------------------
+// LogWarn
+// -------------------------------------------------------------------
+void WebSocketLayer::LogWarn(boost::shared_ptr<string> msg)
+{
+	lockDispose.lock();
+
+	if (isDisposed == true)
+	{
+		lockDispose.unlock();
+		return;
+	}
+
+	if (log == NULL)
+	{
+		lockDispose.unlock();
+		return;
+	}
+
+	boost::shared_ptr<std::vector<string> > messages (new std::vector<string>());
+	messages->push_back("WebSocketLayer: ");
+	messages->push_back(*msg);
+
+	log->Warn(messages);
+
+	lockDispose.unlock();
+}
+
+// -------------------------------------------------------------------
+// LogError
+// -------------------------------------------------------------------
+void WebSocketLayer::LogError(boost::shared_ptr<string> msg)
+{
+	lockDispose.lock();
+
+	if (isDisposed == true)
+	{
+		lockDispose.unlock();
+		return;
+	}
+
+	if (log == NULL)
+	{
+		lockDispose.unlock();
+		return;
+	}
+
+	boost::shared_ptr<std::vector<string> > messages (new std::vector<string>());
+	messages->push_back("WebSocketLayer: ");
+	messages->push_back(*msg);
+
+	log->Error(messages);
+
+	lockDispose.unlock();
+}
+
+// -------------------------------------------------------------------
+// HandleError
+// -------------------------------------------------------------------
+void WebSocketLayer::HandleError(boost::shared_ptr<string> err)
+{
+	HandleError(err, SocketErrors_NotSocket);
+}
+
+// -------------------------------------------------------------------
+// HandleError
+// -------------------------------------------------------------------
+void WebSocketLayer::HandleError(boost::shared_ptr<string> err, SocketErrors se)
+{
+	lockDispose.lock();
+
+	if (isDisposed == true)
+	{
+		lockDispose.unlock();
+		return;
+	}
+
+	boost::shared_ptr<std::map<string, boost::shared_ptr<void> > > data (new std::map<string, boost::shared_ptr<void> >());
+	data->insert(std::pair<string, boost::shared_ptr<void> >("err", err));
+
+	stringstream converterIntToString;
+	converterIntToString << (long int)se;
+	boost::shared_ptr<string> convertedString (new string(converterIntToString.str()));
+	data->insert(std::pair<string, boost::shared_ptr<void> >("se", convertedString));
+
+	boost::shared_ptr<ParameterizedThreadStart> callback (new ParameterizedThreadStart(&WebSocketLayer::HandleErrorCallback, (unsigned long long)this));
+	boost::shared_ptr<ThreadManager> manager = bitSwarm->ThreadManager();
+	if (manager != NULL)
+	{
+		manager->EnqueueCustom(callback, data);
+	}
+
+	lockDispose.unlock();
+}
+
+// -------------------------------------------------------------------
+// HandleErrorCallback
+// -------------------------------------------------------------------
+void WebSocketLayer::HandleErrorCallback(unsigned long long context, boost::shared_ptr<void> state)
+{
+	// Map context
+	WebSocketLayer* instance = (WebSocketLayer*)context;
+
+	boost::shared_ptr<std::map<string, boost::shared_ptr<void> > > data = (boost::static_pointer_cast<std::map<string, boost::shared_ptr<void> > >)(state);
+	boost::shared_ptr<string> err = (boost::static_pointer_cast<string>)((*data)["err"]);
+
+	long int errAsInteger = 0;
+
+	boost::shared_ptr<string> format (new string("%d"));
+	StringFormatter<long int> ((boost::static_pointer_cast<string>)((*data)["se"]), format, errAsInteger);
+
+	SocketErrors se = (SocketErrors)errAsInteger;
+
+	instance->fsm->ApplyTransition(Transitions_ConnectionFailure);
+
+	// Dont spam errors when disconnecting
+	if (!instance->isDisconnecting)
+	{
+		instance->LogError(err);
+		instance->CallOnError(err, se);
+	}
+
+	instance->HandleDisconnection();
+}
+
+// -------------------------------------------------------------------
+// HandleDisconnection
+// -------------------------------------------------------------------
+void WebSocketLayer::HandleDisconnection()
+{
+	if (State() == States_Disconnected)
+	{
+		return;
+	}
+
+	fsm->ApplyTransition(Transitions_Disconnect);
+	CallOnDisconnect();
+}
+
+// -------------------------------------------------------------------
+// CompleteDisconnection
+// -------------------------------------------------------------------
+void WebSocketLayer::CompleteDisconnection()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(mtxWrite);
+
+		if (isClosePending == false)
+		{
+			return;
+		}
+
+		isClosePending = false;
+	}
+
+	if (closeTimer != NULL)
+	{
+		closeTimer->cancel();
+	}
+
+	ShutdownClient();
+
+	HandleDisconnection();
+	isDisconnecting = false;
+}
+
+// -------------------------------------------------------------------
+// OnBoostAsioCloseTimedout
+// -------------------------------------------------------------------
+void WebSocketLayer::OnBoostAsioCloseTimedout(const boost::system::error_code& code)
+{
+	if (code == boost::asio::error::operation_aborted)
+	{
+		// The close frame has been written in time
+		return;
+	}
+
+	CompleteDisconnection();
+}
+
+// -------------------------------------------------------------------
+// CallOnError
+// -------------------------------------------------------------------
+void WebSocketLayer::CallOnError(boost::shared_ptr<string> msg, SocketErrors se)
+{
+	if (onError != NULL)
+	{
+		onError->Invoke(msg, se);
+	}
+}
+
+// -------------------------------------------------------------------
+// CallOnData
+// -------------------------------------------------------------------
+void WebSocketLayer::CallOnData(boost::shared_ptr<vector<unsigned char> > data)
+{
+	lockDispose.lock();
+
+	if (isDisposed == true)
+	{
+		lockDispose.unlock();
+		return;
+	}
+
+	if (onData != NULL)
+	{
+		boost::shared_ptr<ThreadManager> manager = bitSwarm->ThreadManager();
+		if (manager != NULL)
+		{
+			manager->EnqueueDataCall(onData, data);
+		}
+	}
+
+	lockDispose.unlock();
+}
+
+// -------------------------------------------------------------------
+// CallOnConnect
+// -------------------------------------------------------------------
+void WebSocketLayer::CallOnConnect()
+{
+	if (onConnect != NULL)
+	{
+		onConnect->Invoke();
+	}
+}
+
+// -------------------------------------------------------------------
+// CallOnDisconnect
+// -------------------------------------------------------------------
+void WebSocketLayer::CallOnDisconnect()
+{
+	if (onDisconnect != NULL)
+	{
+		onDisconnect->Invoke();
+	}
+}
+
+// -------------------------------------------------------------------
+// ConnectClient
+// -------------------------------------------------------------------
+void WebSocketLayer::ConnectClient(unsigned short int port)
+{
+	boost::shared_ptr<TCPConnectionDelegate> callback (new TCPConnectionDelegate(&WebSocketLayer::OnSocketConnection, (unsigned long long)this));
+
+	if (useSSL == true)
+	{
+		// Every address is attempted in order; the host name is sent for SNI and keys the session that reconnections resume
+		connectionSSL = boost::shared_ptr<TCPClientSSL>(new TCPClientSSL(*boostIoService));
+		connectionSSL->Connect(ipAddresses, host, port, Const_TimeoutConnect, callback);
+	}
+	else
+	{
+		// Every address is attempted, the first one to connect is used
+		connection = boost::shared_ptr<TCPClient>(new TCPClient(*boostIoService));
+		connection->Connect(ipAddresses, port, Const_TimeoutConnect, callback);
+	}
+}
+
+// -------------------------------------------------------------------
+// ReadClient
+// -------------------------------------------------------------------
+void WebSocketLayer::ReadClient()
+{
+	boost::shared_ptr<TCPDataReadDelegate> callback (new TCPDataReadDelegate(&WebSocketLayer::OnSocketDataReceived, (unsigned long long)this));
+
+	if (connectionSSL != NULL)
+	{
+		connectionSSL->AsynchRead(callback);
+	}
+	else if (connection != NULL)
+	{
+		connection->AsynchRead(callback);
+	}
+}
+
+// -------------------------------------------------------------------
+// WriteClient
+// -------------------------------------------------------------------
+void WebSocketLayer::WriteClient(boost::shared_ptr<vector<unsigned char> > data)
+{
+	boost::shared_ptr<TCPDataWriteDelegate> callback (new TCPDataWriteDelegate(&WebSocketLayer::OnSocketDataSent, (unsigned long long)this));
+
+	if (connectionSSL != NULL)
+	{
+		connectionSSL->AsynchWrite(data, callback);
+	}
+	else if (connection != NULL)
+	{
+		connection->AsynchWrite(data, callback);
+	}
+}
+
+// -------------------------------------------------------------------
+// ShutdownClient
+// -------------------------------------------------------------------
+void WebSocketLayer::ShutdownClient()
+{
+	if (connectionSSL != NULL)
+	{
+		connectionSSL->WaitCallbackCompletion();
+	}
+
+	if (connection != NULL)
+	{
+		connection->WaitCallbackCompletion();
+	}
+
+	try
+	{
+		if (connectionSSL != NULL)
+		{
+			connectionSSL->Shutdown();
+		}
+
+		if (connection != NULL)
+		{
+			connection->Shutdown();
+		}
+	}
+	catch (...)
+	{
+	}
+}
+
+// -------------------------------------------------------------------
+// DisposeClient
+// -------------------------------------------------------------------
+void WebSocketLayer::DisposeClient()
+{
+	// Mark the clients as disposed before waiting, so that no callback is started on an instance being replaced
+	if (connectionSSL != NULL)
+	{
+		connectionSSL->Dispose();
+
+		connectionSSL->WaitCallbackCompletion();
+	}
+
+	if (connection != NULL)
+	{
+		connection->Dispose();
+
+		connection->WaitCallbackCompletion();
+	}
+}
+
+// -------------------------------------------------------------------
+// SendUpgradeRequest
+// -------------------------------------------------------------------
+void WebSocketLayer::SendUpgradeRequest()
+{
+	// The key is 16 random bytes encoded in base64, the server proves that it understood the request by hashing it
+	unsigned char nonce[16];
+	RAND_bytes(nonce, sizeof(nonce));
+
+	unsigned char encodedNonce[32];
+	int encodedLength = EVP_EncodeBlock(encodedNonce, nonce, sizeof(nonce));
+	handshakeKey.assign((const char*)encodedNonce, encodedLength);
+
+	// Virtual hosts and reverse proxies route the request by the host name, the address is only used when there is none
+	string hostHeader = (host.size() > 0) ? host : *(ipAddresses->front()->Address());
+	if (hostHeader.find(':') != string::npos)
+	{
+		hostHeader = "[" + hostHeader + "]";
+	}
+
+	stringstream request;
+	request << "GET " << *WEBSOCKET_PATH << " HTTP/1.1\r\n";
+	request << "Host: " << hostHeader << ":" << socketNumber << "\r\n";
+	request << "Upgrade: websocket\r\n";
+	request << "Connection: Upgrade\r\n";
+	request << "Sec-WebSocket-Key: " << handshakeKey << "\r\n";
+	request << "Sec-WebSocket-Version: 13\r\n";
+	request << "\r\n";
+
+	QueueBytes(request.str());
+}
+
+// -------------------------------------------------------------------
+// HandleUpgradeResponse
+// -------------------------------------------------------------------
+bool WebSocketLayer::HandleUpgradeResponse()
+{
+	static const char terminator[] = "\r\n\r\n";
+
+	vector<unsigned char>::iterator headersEnd = std::search(inputBuffer.begin(), inputBuffer.end(), terminator, terminator + 4);
+	if (headersEnd == inputBuffer.end())
+	{
+		if ((long int)inputBuffer.size() > MAX_HANDSHAKE_SIZE)
+		{
+			boost::shared_ptr<string> message (new string("WebSocket upgrade failed: response headers too large"));
+			HandleError(message);
+			return false;
+		}
+
+		// Wait for the rest of the headers
+		return true;
+	}
+
+	string headers (inputBuffer.begin(), headersEnd);
+
+	// Bytes following the headers already belong to the first frames
+	inputBuffer.erase(inputBuffer.begin(), headersEnd + 4);
+
+	string statusLine = headers.substr(0, headers.find("\r\n"));
+	if (statusLine.compare(0, 12, "HTTP/1.1 101") != 0)
+	{
+		boost::shared_ptr<string> message (new string("WebSocket upgrade refused by the server: " + statusLine));
+		HandleError(message);
+		return false;
+	}
+
+	// Header names are case insensitive
+	string lowerHeaders = headers;
+	std::transform(lowerHeaders.begin(), lowerHeaders.end(), lowerHeaders.begin(), ::tolower);
+
+	string accept;
+	static const string acceptHeader = "\r\nsec-websocket-accept:";
+	size_t position = lowerHeaders.find(acceptHeader);
+	if (position != string::npos)
+	{
+		position += acceptHeader.size();
+		size_t end = headers.find("\r\n", position);
+		accept = headers.substr(position, (end == string::npos ? headers.size() : end) - position);
+
+		accept.erase(0, accept.find_first_not_of(" \t"));
+		accept.erase(accept.find_last_not_of(" \t") + 1);
+	}
+
+	// Expected answer: base64 of the SHA-1 of the key followed by the GUID defined by RFC 6455
+	string keyAndGuid = handshakeKey + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+	unsigned char digest[SHA_DIGEST_LENGTH];
+	SHA1((const unsigned char*)keyAndGuid.data(), keyAndGuid.size(), digest);
+
+	unsigned char encodedDigest[32];
+	int encodedLength = EVP_EncodeBlock(encodedDigest, digest, SHA_DIGEST_LENGTH);
+
+	if (accept != string((const char*)encodedDigest, encodedLength))
+	{
+		boost::shared_ptr<string> message (new string("WebSocket upgrade failed: invalid Sec-WebSocket-Accept"));
+		HandleError(message);
+		return false;
+	}
+
+	fsm->ApplyTransition(Transitions_UpgradeSuccess);
+	CallOnConnect();
+
+	return true;
+}
+
+// -------------------------------------------------------------------
+// HandleFrames
+// -------------------------------------------------------------------
+bool WebSocketLayer::HandleFrames()
+{
+	size_t offset = 0;
+	bool keepReading = true;
+
+	while (keepReading == true)
+	{
+		size_t available = inputBuffer.size() - offset;
+		if (available < 2)
+		{
+			break;
+		}
+
+		const unsigned char* frame = &inputBuffer[offset];
+		bool isFinal = (frame[0] & 0x80) != 0;
+		unsigned char opcode = frame[0] & 0x0F;
+		bool isMasked = (frame[1] & 0x80) != 0;
+
+		size_t headerLength = 2;
+		unsigned long long payloadLength = frame[1] & 0x7F;
+
+		if (payloadLength == 126)
+		{
+			headerLength = 4;
+			if (available < headerLength) break;
+
+			payloadLength = ((unsigned long long)frame[2] << 8) | frame[3];
+		}
+		else if (payloadLength == 127)
+		{
+			headerLength = 10;
+			if (available < headerLength) break;
+
+			payloadLength = 0;
+			for (long int index = 2; index < 10; index++)
+			{
+				payloadLength = (payloadLength << 8) | frame[index];
+			}
+		}
+
+		if (payloadLength > (unsigned long long)MAX_FRAME_SIZE || messageBuffer.size() + payloadLength > (unsigned long long)MAX_FRAME_SIZE)
+		{
+			boost::shared_ptr<string> message (new string("WebSocket message exceeds the maximum size"));
+			HandleError(message);
+			return false;
+		}
+
+		// Servers do not mask their frames, a masked one is accepted anyway
+		size_t maskOffset = headerLength;
+		if (isMasked == true)
+		{
+			headerLength += 4;
+		}
+
+		if (available < headerLength + payloadLength)
+		{
+			break;
+		}
+
+		// Pointer arithmetic rather than indexing: an empty control frame can end the buffer
+		unsigned char* payload = &inputBuffer[0] + offset + headerLength;
+		if (isMasked == true)
+		{
+			const unsigned char* mask = &inputBuffer[0] + offset + maskOffset;
+			for (size_t index = 0; index < payloadLength; index++)
+			{
+				payload[index] ^= mask[index & 3];
+			}
+		}
+
+		offset += headerLength + (size_t)payloadLength;
+
+		switch (opcode)
+		{
+		case Opcodes_Continuation:
+		case Opcodes_Text:
+		case Opcodes_Binary:
+			messageBuffer.insert(messageBuffer.end(), payload, payload + payloadLength);
+
+			if (isFinal == true && messageBuffer.size() > 0)
+			{
+				boost::shared_ptr<vector<unsigned char> > data (new vector<unsigned char>());
+				data->swap(messageBuffer);
+
+				CallOnData(data);
+			}
+			break;
+
+		case Opcodes_Ping:
+			QueueFrame(Opcodes_Pong, payload, (size_t)payloadLength);
+			break;
+
+		case Opcodes_Pong:
+			break;
+
+		case Opcodes_Close:
+			{
+				// Echo the status code of the server, then the connection is over
+				// once the echo has been written (see OnSocketDataSent)
+				// The close frame of a disconnection being answered by the server completes the closing handshake
+				bool isClosed = true;
+
+				if (isCloseSent == false)
+				{
+					isCloseSent = true;
+					QueueFrame(Opcodes_Close, payload, payloadLength >= 2 ? 2 : 0);
+
+					boost::lock_guard<boost::mutex> lock(mtxWrite);
+					if (isWriteInProgress == true)
+					{
+						isCloseReceived = true;
+						isClosed = false;
+					}
+				}
+
+				if (isClosed == true && isDisconnecting == true)
+				{
+					CompleteDisconnection();
+				}
+				else if (isClosed == true)
+				{
+					boost::shared_ptr<string> message (new string("Connection closed by the remote side"));
+					HandleError(message);
+				}
+
+				keepReading = false;
+			}
+			break;
+
+		default:
+			{
+				boost::shared_ptr<string> message (new string("Unsupported WebSocket frame received"));
+				HandleError(message);
+				keepReading = false;
+			}
+			break;
+		}
+	}
+
+	inputBuffer.erase(inputBuffer.begin(), inputBuffer.begin() + offset);
+
+	return keepReading;
+}
+
+// -------------------------------------------------------------------
+// QueueFrame
+// -------------------------------------------------------------------
+void WebSocketLayer::QueueFrame(unsigned char opcode, const unsigned char* data, size_t length)
+{
+	// Frames sent by a client must be masked with a random key
+	unsigned char mask[4];
+	RAND_bytes(mask, sizeof(mask));
+
+	boost::lock_guard<boost::mutex> lock(mtxWrite);
+
+	pendingOutput.push_back(0x80 | opcode);
+
+	if (length < 126)
+	{
+		pendingOutput.push_back(0x80 | (unsigned char)length);
+	}
+	else if (length <= 0xFFFF)
+	{
+		pendingOutput.push_back(0x80 | 126);
+		pendingOutput.push_back((unsigned char)(length >> 8));
+		pendingOutput.push_back((unsigned char)length);
+	}
+	else
+	{
+		pendingOutput.push_back(0x80 | 127);
+		for (long int shift = 56; shift >= 0; shift -= 8)
+		{
+			pendingOutput.push_back((unsigned char)((unsigned long long)length >> shift));
+		}
+	}
+
+	pendingOutput.insert(pendingOutput.end(), mask, mask + 4);
+
+	size_t payloadOffset = pendingOutput.size();
+	pendingOutput.resize(payloadOffset + length);
+	for (size_t index = 0; index < length; index++)
+	{
+		pendingOutput[payloadOffset + index] = data[index] ^ mask[index & 3];
+	}
+
+	ScheduleFlush();
+}
+
+// -------------------------------------------------------------------
+// QueueBytes
+// -------------------------------------------------------------------
+void WebSocketLayer::QueueBytes(const string& data)
+{
+	boost::lock_guard<boost::mutex> lock(mtxWrite);
+
+	pendingOutput.insert(pendingOutput.end(), data.begin(), data.end());
+
+	ScheduleFlush();
+}
+
+// -------------------------------------------------------------------
+// ScheduleFlush
+// -------------------------------------------------------------------
+void WebSocketLayer::ScheduleFlush()
+{
+	// Frames queued while a write is in progress are sent together by the next one
+	if (isWriteInProgress == true || boostIoService == NULL)
+	{
+		return;
+	}
+
+	isWriteInProgress = true;
+	boostIoService->post(boost::bind(&WebSocketLayer::FlushOutput, shared_from_this()));
+}
+
+// -------------------------------------------------------------------
+// FlushOutput
+// -------------------------------------------------------------------
+void WebSocketLayer::FlushOutput()
+{
+	boost::shared_ptr<vector<unsigned char> > data (new vector<unsigned char>());
+
+	{
+		boost::lock_guard<boost::mutex> lock(mtxWrite);
+
+		if (pendingOutput.size() == 0 || isDisposed == true)
+		{
+			isWriteInProgress = false;
+			return;
+		}
+
+		data->swap(pendingOutput);
+		outputInFlight = (long int)data->size();
+	}
+
+	try
+	{
+		WriteClient(data);
+	}
+	catch (...)
+	{
+		boost::lock_guard<boost::mutex> lock(mtxWrite);
+		isWriteInProgress = false;
+		outputInFlight = 0;
+
+		boost::shared_ptr<string> message (new string("General error writing to socket: "));
+		HandleError(message);
+	}
+}
+
+// -------------------------------------------------------------------
+// OnSocketConnection
+// -------------------------------------------------------------------
+void WebSocketLayer::OnSocketConnection(unsigned long long context, SocketErrors code)
+{
+	// Map context
+	WebSocketLayer* instance = (WebSocketLayer*)context;
+
+	if (code == SocketErrors_Success)
+	{
+		// Connection established, the WebSocket is open once the server has accepted the upgrade
+		instance->fsm->ApplyTransition(Transitions_StartUpgrade);
+		instance->SendUpgradeRequest();
+
+		// Schedule an asynchronous read
+		instance->ReadClient();
+	}
+	else
+	{
+		boost::shared_ptr<string> message (new string("Connection error: "));
+		instance->HandleError(message, code);
+	}
+}
+
+// -------------------------------------------------------------------
+// OnSocketDataSent
+// -------------------------------------------------------------------
+void WebSocketLayer::OnSocketDataSent(unsigned long long context, SocketErrors code)
+{
+	// Map context
+	WebSocketLayer* instance = (WebSocketLayer*)context;
+
+	if (code != SocketErrors_Success)
+	{
+		{
+			boost::lock_guard<boost::mutex> lock(instance->mtxWrite);
+			instance->pendingOutput.clear();
+			instance->isWriteInProgress = false;
+			instance->outputInFlight = 0;
+		}
+
+		// The dropped output may bring the pending bytes back under the low watermark
+		boost::shared_ptr<BitSwarmClient> client = instance->bitSwarm;
+		if (client != NULL)
+		{
+			client->CheckSendWatermarks();
+		}
+
+		boost::shared_ptr<string> message (new string("Error sending data to remote side over the established connection"));
+		instance->HandleError(message, code);
+		return;
+	}
+
+	{
+		boost::lock_guard<boost::mutex> lock(instance->mtxWrite);
+		instance->outputInFlight = 0;
+	}
+
+	// Send what has been queued in the meantime; this runs on the Boost Asio thread already
+	instance->FlushOutput();
+
+	// The bytes just written may bring the output back under the low watermark
+	boost::shared_ptr<BitSwarmClient> client = instance->bitSwarm;
+	if (client != NULL)
+	{
+		client->CheckSendWatermarks();
+	}
+
+	// The echo of a close frame received from the server, or the close frame of a disconnection, has been written: the connection is over
+	bool isClosed = false;
+	bool isDisconnected = false;
+
+	{
+		boost::lock_guard<boost::mutex> lock(instance->mtxWrite);
+
+		if (instance->isWriteInProgress == false)
+		{
+			isClosed = instance->isCloseReceived;
+			isDisconnected = instance->isClosePending;
+			instance->isCloseReceived = false;
+		}
+	}
+
+	if (isDisconnected == true)
+	{
+		instance->CompleteDisconnection();
+	}
+	else if (isClosed == true)
+	{
+		boost::shared_ptr<string> message (new string("Connection closed by the remote side"));
+		instance->HandleError(message);
+	}
+}
+
+// -------------------------------------------------------------------
+// OnSocketDataReceived
+// -------------------------------------------------------------------
+void WebSocketLayer::OnSocketDataReceived(unsigned long long context, boost::shared_ptr<vector<unsigned char> > data)
+{
+	// Map context
+	WebSocketLayer* instance = (WebSocketLayer*)context;
+
+	if (data->size() < 1)
+	{
+		boost::shared_ptr<string> message (new string("Connection closed by the remote side"));
+		instance->HandleError(message);
+		return;
+	}
+
+	instance->inputBuffer.insert(instance->inputBuffer.end(), data->begin(), data->end());
+
+	if (instance->State() == States_Upgrading)
+	{
+		if (instance->HandleUpgradeResponse() == false)
+		{
+			// The upgrade failed and the error has been reported
+			return;
+		}
+
+		if (instance->State() == States_Upgrading)
+		{
+			// Schedule an asynchronous read for the rest of the headers
+			instance->ReadClient();
+			return;
+		}
+	}
+
+	if (instance->HandleFrames() == false)
+	{
+		return;
+	}
+
+	// Schedule an asynchronous read
+	instance->ReadClient();
+}
+
+// ISocketLayer implementation
+
+// -------------------------------------------------------------------
+// Connect
+// -------------------------------------------------------------------
+void WebSocketLayer::Connect(boost::shared_ptr<IPAddress> address, unsigned short int port)
+{
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses (new vector<boost::shared_ptr<IPAddress> >());
+	addresses->push_back(address);
+
+	Connect(addresses, port);
+}
+
+// -------------------------------------------------------------------
+// Connect
+// -------------------------------------------------------------------
+void WebSocketLayer::Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, unsigned short int port)
+{
+	// A disconnection still waiting for its close frame is completed at once, the connection is being replaced
+	CompleteDisconnection();
+
+	if (State() != States_Disconnected)
+	{
+		boost::shared_ptr<string> message (new string("Calling connect when the socket is not disconnected"));
+		LogWarn(message);
+		return;
+	}
+
+	if (bitSwarm == NULL)
+	{
+		return;
+	}
+
+	socketNumber = port;
+	ipAddresses = addresses;
+
+	fsm->ApplyTransition(Transitions_StartConnect);
+
+	try
+	{
+		// As for the tcp socket layer, the clients of a previous connection must not call back into a reset instance
+		DisposeClient();
+
+		connection = boost::shared_ptr<TCPClient>();
+		connectionSSL = boost::shared_ptr<TCPClientSSL>();
+		boostIoService = bitSwarm->GetBoostService();
+
+		inputBuffer.clear();
+		messageBuffer.clear();
+		isCloseSent = false;
+
+		{
+			boost::lock_guard<boost::mutex> lock(mtxWrite);
+			pendingOutput.clear();
+			isWriteInProgress = false;
+			isCloseReceived = false;
+			outputInFlight = 0;
+		}
+
+		this->me = shared_from_this();
+		ConnectClient(socketNumber);
+
+		// In poll mode the completions run on the thread that calls Poll
+		if (bitSwarm->PollMode() == false)
+		{
+			boostIoService->reset();
+			boost::thread t(boost::bind(static_cast<size_t (boost::asio::io_service::*)()>(&boost::asio::io_service::run), boostIoService));
+		}
+	}
+	catch (...)
+	{
+		boost::shared_ptr<string> message (new string("General exception on connection: "));
+		HandleError(message);
+	}
+}
+
+// -------------------------------------------------------------------
+// IsConnected
+// -------------------------------------------------------------------
+bool WebSocketLayer::IsConnected()
+{
+	return State() == States_Connected;
+}
+
+// -------------------------------------------------------------------
+// RequiresConnection
+// -------------------------------------------------------------------
+bool WebSocketLayer::RequiresConnection()
+{
+	return true;
+}
+
+// -------------------------------------------------------------------
+// Disconnect
+// -------------------------------------------------------------------
+void WebSocketLayer::Disconnect()
+{
+	if (State() != States_Connected)
+	{
+		boost::shared_ptr<string> message (new string("Calling disconnect when the socket is not connected"));
+		LogWarn(message);
+		return;
+	}
+
+	isDisconnecting = true;
+
+	// The closing handshake: a close frame with the normal closure status is sent first, and the connection
+	// is shut down once it has been written or after a short timeout (see CompleteDisconnection)
+	if (isCloseSent == false && boostIoService != NULL)
+	{
+		isCloseSent = true;
+
+		{
+			boost::lock_guard<boost::mutex> lock(mtxWrite);
+			isClosePending = true;
+		}
+
+		closeTimer = boost::shared_ptr<boost::asio::deadline_timer>(new boost::asio::deadline_timer(*boostIoService));
+		closeTimer->expires_from_now(boost::posix_time::milliseconds(CLOSE_TIMEOUT));
+		closeTimer->async_wait(boost::bind(&WebSocketLayer::OnBoostAsioCloseTimedout, shared_from_this(), boost::asio::placeholders::error));
+
+		static const unsigned char normalClosure[2] = { 0x03, 0xE8 };
+		QueueFrame(Opcodes_Close, normalClosure, sizeof(normalClosure));
+
+		return;
+	}
+
+	ShutdownClient();
+
+	HandleDisconnection();
+	isDisconnecting = false;
+}
+
+// -------------------------------------------------------------------
+// OnConnect
+// -------------------------------------------------------------------
+boost::shared_ptr<ConnectionDelegate> WebSocketLayer::OnConnect()
+{
+	return onConnect;
+}
+
+// -------------------------------------------------------------------
+// OnConnect
+// -------------------------------------------------------------------
+void WebSocketLayer::OnConnect(boost::shared_ptr<ConnectionDelegate> onConnect)
+{
+	this->onConnect = onConnect;
+}
+
+// -------------------------------------------------------------------
+// OnDisconnect
+// -------------------------------------------------------------------
+boost::shared_ptr<ConnectionDelegate> WebSocketLayer::OnDisconnect()
+{
+	return onDisconnect;
+}
+
+// -------------------------------------------------------------------
+// OnDisconnect
+// -------------------------------------------------------------------
+void WebSocketLayer::OnDisconnect(boost::shared_ptr<ConnectionDelegate> onDisconnect)
+{
+	this->onDisconnect = onDisconnect;
+}
+
+// -------------------------------------------------------------------
+// Write
+// -------------------------------------------------------------------
+void WebSocketLayer::Write(boost::shared_ptr<vector<unsigned char> > data)
+{
+	// Nothing may follow a close frame
+	if (State() != States_Connected || isCloseSent == true)
+	{
+		boost::shared_ptr<string> message (new string("Trying to write to disconnected socket"));
+		LogError(message);
+
+		data->clear();
+		return;
+	}
+
+	if (data->size() == 0)
+	{
+		return;
+	}
+
+	// Each BitSwarm packet travels as one binary message
+	QueueFrame(Opcodes_Binary, &(*data)[0], data->size());
+}
+
+// -------------------------------------------------------------------
+// PendingWriteBytes
+// -------------------------------------------------------------------
+long int WebSocketLayer::PendingWriteBytes()
+{
+	boost::lock_guard<boost::mutex> lock(mtxWrite);
+	return (long int)pendingOutput.size() + outputInFlight;
+}
+
+// -------------------------------------------------------------------
+// OnData
+// -------------------------------------------------------------------
+boost::shared_ptr<OnDataDelegate> WebSocketLayer::OnData()
+{
+	return onData;
+}
+
+// -------------------------------------------------------------------
+// OnData
+// -------------------------------------------------------------------
+void WebSocketLayer::OnData(boost::shared_ptr<OnDataDelegate> onData)
+{
+	this->onData = onData;
+}
+
+// -------------------------------------------------------------------
+// OnError
+// -------------------------------------------------------------------
+boost::shared_ptr<OnErrorDelegate> WebSocketLayer::OnError()
+{
+	return onError;
+}
+
+// -------------------------------------------------------------------
+// OnError
+// -------------------------------------------------------------------
+void WebSocketLayer::OnError(boost::shared_ptr<OnErrorDelegate> onError)
+{
+	this->onError = onError;
+}
+
+// -------------------------------------------------------------------
+// Kill
+// -------------------------------------------------------------------
+void WebSocketLayer::Kill()
+{
+	isDisconnecting = true;
+
+	// No need to wait for the close frame of a disconnection any longer
+	{
+		boost::lock_guard<boost::mutex> lock(mtxWrite);
+		isClosePending = false;
+	}
+
+	ShutdownClient();
+
+	HandleDisconnection();
+	isDisconnecting = false;
+}
+
+}	// namespace Sockets
+}	// namespace Core
+}	// namespace Sfs2X
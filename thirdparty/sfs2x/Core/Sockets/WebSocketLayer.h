@@ -0,0 +1,318 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of an handler for a WebSocket connection
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __WebSocketLayer__
+#define __WebSocketLayer__
+
+#include "ISocketLayer.h"						// ISocketLayer interface
+#include "../../Logging/Logger.h"				// Logging service
+#include "../../Bitswarm/BitSwarmClient.h"		// Bitswarm
+#include "../../FSM/FiniteStateMachine.h"		// State machine
+#include "TCPClient.h"							// TCP client handler
+#include "TCPClientSSL.h"						// TCP SSL client handler
+#include "../../Util/Common.h"					// Common API items
+
+#include <boost/asio.hpp>						// Boost Asio header
+#include <boost/asio/ssl.hpp>					// Boost Asio header
+#include <boost/shared_ptr.hpp>					// Boost Asio shared pointer
+#include <boost/enable_shared_from_this.hpp>	// Boost shared_ptr for this
+#include <boost/thread/mutex.hpp>				// Boost mutex
+using boost::asio::ip::tcp;						// Boost Asio namespace
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <string>						// STL library: string object
+#include <vector>						// STL library: vector object
+#include <map>							// STL library: map object
+using namespace std;					// STL library: declare the STL namespace
+
+using namespace Sfs2X::Logging;
+using namespace Sfs2X::Bitswarm;
+using namespace Sfs2X::FSM;
+
+namespace Sfs2X {
+namespace Core {
+namespace Sockets {
+
+	// -------------------------------------------------------------------
+	// Class WebSocketLayer
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Socket layer that carries the BitSwarm binary protocol over a WebSocket connection (RFC 6455)
+	/// </summary>
+	///
+	/// <remarks>
+	/// A WebSocket goes through the HTTP port of the server, like BlueBox, but keeps a single persistent connection:
+	/// messages are pushed by both sides as soon as they are available instead of being collected by polling.
+	/// <br/>
+	/// Every message is sent as a binary frame; the data of the received frames is handed to the BitSwarm client as it is,
+	/// the same as the data read from a plain socket.
+	/// </remarks>
+	class WebSocketLayer : public ISocketLayer, public boost::enable_shared_from_this<WebSocketLayer>
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public types
+		// -------------------------------------------------------------------
+
+		enum States
+		{
+			States_Disconnected,
+			States_Connecting,
+			States_Upgrading,
+			States_Connected
+		};
+
+		enum Transitions
+		{
+			Transitions_StartConnect,
+			Transitions_StartUpgrade,
+			Transitions_UpgradeSuccess,
+			Transitions_ConnectionFailure,
+			Transitions_Disconnect
+		};
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		// Constructor
+		// Creates and initializes an instance of this class
+		//		bs		Bitswarm client
+		//		useSSL	Connect over TLS (wss) instead of plain tcp (ws)
+		//		host	Host name of the server, sent in the upgrade request and for the TLS handshake;
+		//				empty to use the ip address of the connection
+		WebSocketLayer (boost::shared_ptr<BitSwarmClient> bs, bool useSSL, const string& host);
+
+		// Destructor
+		// Destroy an instance of this class
+		virtual ~WebSocketLayer();
+
+		// State
+		// Returns the state
+		States State();
+
+		// UseSSL
+		// Returns true when the connection is established over TLS
+		bool UseSSL();
+
+		// Host
+		// Returns the host name of the server, empty when the ip address of the connection is used
+		const string& Host();
+
+		// ISocketLayer implementation
+
+		virtual void Connect(boost::shared_ptr<IPAddress> address, unsigned short int port);
+		virtual void Connect(boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, unsigned short int port);
+		virtual bool IsConnected();
+		virtual bool RequiresConnection();
+		virtual void Disconnect();
+
+		virtual boost::shared_ptr<ConnectionDelegate> OnConnect();						// Get delegate
+		virtual void OnConnect(boost::shared_ptr<ConnectionDelegate> onConnect);			// Set delegate
+
+		virtual boost::shared_ptr<ConnectionDelegate> OnDisconnect();						// Get delegate
+		virtual void OnDisconnect(boost::shared_ptr<ConnectionDelegate> onDisconnect);	// Set delegate
+
+		virtual void Write(boost::shared_ptr<vector<unsigned char> >);
+		virtual long int PendingWriteBytes();
+
+		virtual boost::shared_ptr<OnDataDelegate> OnData();								// Get delegate
+		virtual void OnData(boost::shared_ptr<OnDataDelegate> onData);					// Set delegate
+
+		virtual boost::shared_ptr<OnErrorDelegate> OnError();								// Get delegate
+		virtual void OnError(boost::shared_ptr<OnErrorDelegate> onError);					// Set delegate
+
+		virtual void Kill();
+
+		virtual void Dispose();
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		/// <summary>
+		/// Path of the WebSocket endpoint on the HTTP port of the server
+		/// </summary>
+		static boost::shared_ptr<string> WEBSOCKET_PATH;
+
+	protected:
+
+		// -------------------------------------------------------------------
+		// Protected methods
+		// -------------------------------------------------------------------
+
+		// -------------------------------------------------------------------
+		// Protected members
+		// -------------------------------------------------------------------
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private types
+		// -------------------------------------------------------------------
+
+		enum Opcodes
+		{
+			Opcodes_Continuation = 0x0,
+			Opcodes_Text = 0x1,
+			Opcodes_Binary = 0x2,
+			Opcodes_Close = 0x8,
+			Opcodes_Ping = 0x9,
+			Opcodes_Pong = 0xA
+		};
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		void InitStates();
+		void LogWarn(boost::shared_ptr<string> msg);
+		void LogError(boost::shared_ptr<string> msg);
+		void HandleError(boost::shared_ptr<string> err);
+		void HandleError(boost::shared_ptr<string> err, SocketErrors se);
+		static void HandleErrorCallback(unsigned long long context, boost::shared_ptr<void> state);
+		void CallOnConnect();
+		void CallOnDisconnect();
+		void CallOnData(boost::shared_ptr<vector<unsigned char> > data);
+		void CallOnError(boost::shared_ptr<string> msg, SocketErrors se);
+		void HandleDisconnection();
+
+		// CompleteDisconnection
+		// Shuts the connection down once the close frame of a disconnection has been written, or its timeout has expired
+		void CompleteDisconnection();
+
+		// OnBoostAsioCloseTimedout
+		// Callback to receive Boost Asio notification regarding the timeout of the close frame of a disconnection
+		//		code		Error code
+		void OnBoostAsioCloseTimedout(const boost::system::error_code& code);
+
+		// Connection: the underlying client is either a plain tcp client or a TLS one
+
+		void ConnectClient(unsigned short int port);
+		void ReadClient();
+		void WriteClient(boost::shared_ptr<vector<unsigned char> > data);
+		void ShutdownClient();
+		void DisposeClient();
+
+		// Handshake
+
+		// SendUpgradeRequest
+		// Queues the HTTP request that asks the server to switch the connection to the WebSocket protocol
+		void SendUpgradeRequest();
+
+		// HandleUpgradeResponse
+		// Checks the HTTP response of the server once its headers have been received, then opens the WebSocket
+		// Returns false when the upgrade has failed; the state is still Upgrading when the headers are incomplete
+		bool HandleUpgradeResponse();
+
+		// Framing
+
+		// HandleFrames
+		// Consumes the complete frames of the input buffer
+		// Returns false when the connection must not be read any longer
+		bool HandleFrames();
+
+		// QueueFrame
+		// Appends a masked frame to the output
+		//		opcode		Frame opcode
+		//		data		Frame payload
+		//		length		Quantity of bytes of the payload
+		void QueueFrame(unsigned char opcode, const unsigned char* data, size_t length);
+
+		// QueueBytes
+		// Appends raw bytes to the output
+		void QueueBytes(const string& data);
+
+		// ScheduleFlush
+		// Starts the transmission of the output, unless a write is already in progress
+		// Must be called holding mtxWrite
+		void ScheduleFlush();
+
+		// FlushOutput
+		// Writes all the queued output at once; runs on the Boost Asio thread, the only one that uses the TLS stream
+		void FlushOutput();
+
+		// Connection
+
+		// OnSocketConnection
+		// Notifies the result of a network connection task
+		//		context		Optional context
+		//		code		Error code for connection task
+		static void OnSocketConnection(unsigned long long context, SocketErrors code);
+
+		// OnSocketDataReceived
+		// Notifies the receiving of data from network connection
+		//		context		Optional context
+		//		data		Received data
+		static void OnSocketDataReceived(unsigned long long context, boost::shared_ptr<vector<unsigned char> > data);
+
+		// OnSocketDataSent
+		// Notifies the completion of data transmission over network connection
+		//		context		Optional context
+		//		code		Error code for data send task
+		static void OnSocketDataSent(unsigned long long context, SocketErrors code);
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		const static long int MAX_HANDSHAKE_SIZE = 8192;				// Largest HTTP response accepted for the upgrade [bytes]
+		const static long int MAX_FRAME_SIZE = 16 * 1024 * 1024;		// Largest frame or fragmented message accepted [bytes]
+		const static long int CLOSE_TIMEOUT = 1000;					// Longest wait for the close frame of a disconnection to be written [msec.]
+
+		boost::shared_ptr<Logger> log;
+		boost::shared_ptr<BitSwarmClient> bitSwarm;
+		boost::shared_ptr<FiniteStateMachine> fsm;
+		volatile bool isDisconnecting;
+
+		boost::recursive_mutex lockDispose;
+		bool isDisposed;
+
+		// Connection
+
+		bool useSSL;
+		string host;
+		boost::shared_ptr<boost::asio::io_service> boostIoService;
+		boost::shared_ptr<TCPClient> connection;
+		boost::shared_ptr<TCPClientSSL> connectionSSL;
+		unsigned short int socketNumber;
+		boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > ipAddresses;
+
+		boost::shared_ptr<ConnectionDelegate> onConnect;		// Callback to notify tcp connection result
+		boost::shared_ptr<ConnectionDelegate> onDisconnect;		// Callback to notify tcp disconnection result
+		boost::shared_ptr<OnErrorDelegate> onError;				// Callback to notify errors
+		boost::shared_ptr<OnDataDelegate> onData;				// Callback to notify data
+
+		// Handshake and framing
+		string handshakeKey;									// Sec-WebSocket-Key of the upgrade request
+		vector<unsigned char> inputBuffer;						// Received bytes not yet consumed
+		vector<unsigned char> messageBuffer;					// Payload of a fragmented message being reassembled
+		bool isCloseSent;
+
+		// Writing
+		boost::mutex mtxWrite;									// Mutex to synchronize the output
+		vector<unsigned char> pendingOutput;					// Frames queued while a write is in progress
+		long int outputInFlight;								// Quantity of bytes of the write in progress
+		bool isWriteInProgress;
+		bool isCloseReceived;									// The echo of a close frame of the server is being written
+		bool isClosePending;									// The close frame of a disconnection is being written
+		boost::shared_ptr<boost::asio::deadline_timer> closeTimer;	// Timeout of the close frame of a disconnection
+
+		boost::shared_ptr<WebSocketLayer> me;
+	};
+
+}	// namespace Sockets
+}	// namespace Core
+}	// namespace Sfs2X
+
+#endif
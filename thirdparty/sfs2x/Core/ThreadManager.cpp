@@ -19,6 +19,9 @@ namespace Core {
 ThreadManager::ThreadManager()
 {
 	running = false;
+	pollMode = false;
+	replacedMessages = 0;
+	outQueueBytes = 0;
 	inThreadQueue = boost::shared_ptr<list<boost::shared_ptr<map<string, boost::shared_ptr<void> > > > >(new list<boost::shared_ptr<map<string, boost::shared_ptr<void> > > >());
 	inThread = boost::shared_ptr<boost::thread>();
 		
@@ -31,19 +34,7 @@ ThreadManager::ThreadManager()
 // -------------------------------------------------------------------
 ThreadManager::~ThreadManager()
 {
-	running = false;
-	if (this->inThread != NULL)
-	{
-		this->inThread->interrupt();
-		this->inThread->join();
-		this->inThread = boost::shared_ptr<boost::thread>();
-	}
-	if (this->outThread != NULL)
-	{
-		this->outThread->interrupt();
-		this->outThread->join();
-		this->outThread= boost::shared_ptr<boost::thread>();
-	}
+	Stop();
 
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > item;
 
@@ -62,6 +53,8 @@ ThreadManager::~ThreadManager()
 
 		item->clear();
 	}
+
+	outThreadKeys.clear();
 }
 
 // -------------------------------------------------------------------
@@ -77,24 +70,7 @@ void ThreadManager::InThread()
 
 		if (running == false) break;
 
-		boost::shared_ptr<map<string, boost::shared_ptr<void> > > item;
-
-		while (true)
-		{
-			inQueueLocker.lock();
-			if (inThreadQueue->size() <= 0) 
-			{
-				inQueueLocker.unlock();
-				break;
-			}
-
-			item = inThreadQueue->front();
-			inThreadQueue->pop_front();
-			inQueueLocker.unlock();
-
-			ProcessItem(item);
-			item->clear();
-		}
+		ProcessInQueue();
 	}
 }
 
@@ -111,25 +87,68 @@ void ThreadManager::OutThread()
 
 		if (running == false) break;
 
-		boost::shared_ptr<map<string, boost::shared_ptr<void> > > item;
+		ProcessOutQueue();
+	}
+}
 
-		while (true)
+// -------------------------------------------------------------------
+// ProcessInQueue
+// -------------------------------------------------------------------
+long int ThreadManager::ProcessInQueue()
+{
+	long int processed = 0;
+	boost::shared_ptr<map<string, boost::shared_ptr<void> > > item;
+
+	while (true)
+	{
+		inQueueLocker.lock();
+		if (inThreadQueue->size() <= 0) 
 		{
-			outQueueLocker.lock();
-			if (outThreadQueue->size() <= 0) 
-			{
-				outQueueLocker.unlock();
-				break;
-			}
-
-			item = outThreadQueue->front();
-			outThreadQueue->pop_front();
-			outQueueLocker.unlock();
+			inQueueLocker.unlock();
+			break;
+		}
+
+		item = inThreadQueue->front();
+		inThreadQueue->pop_front();
+		inQueueLocker.unlock();
+
+		ProcessItem(item);
+		item->clear();
+		processed++;
+	}
 
-			ProcessOutItem(item);
-			item->clear();
+	return processed;
+}
+
+// -------------------------------------------------------------------
+// ProcessOutQueue
+// -------------------------------------------------------------------
+long int ThreadManager::ProcessOutQueue()
+{
+	long int processed = 0;
+	boost::shared_ptr<map<string, boost::shared_ptr<void> > > item;
+
+	while (true)
+	{
+		outQueueLocker.lock();
+		if (outThreadQueue->size() <= 0) 
+		{
+			outQueueLocker.unlock();
+			break;
 		}
+
+		item = outThreadQueue->front();
+		outThreadQueue->pop_front();
+		ForgetReplacementKey(item);
+		outQueueBytes -= ItemBytes(item);
+		outQueueLocker.unlock();
+
+		ProcessOutItem(item);
+		item->clear();
+		processed++;
 	}
+
+	return processed;
 }
 
 // -------------------------------------------------------------------
@@ -197,7 +216,7 @@ void ThreadManager::ProcessItem(boost::shared_ptr<map<string, boost::shared_ptr<
 // -------------------------------------------------------------------
 void ThreadManager::Start()
 {
-	if (running) return;
+	if (running || pollMode) return;
 			
 	running = true;
 		
@@ -212,6 +231,56 @@ void ThreadManager::Start()
 	}
 }
 
+// -------------------------------------------------------------------
+// Stop
+// -------------------------------------------------------------------
+void ThreadManager::Stop()
+{
+	running = false;
+	if (this->inThread != NULL)
+	{
+		this->inThread->interrupt();
+		this->inThread->join();
+		this->inThread = boost::shared_ptr<boost::thread>();
+	}
+	if (this->outThread != NULL)
+	{
+		this->outThread->interrupt();
+		this->outThread->join();
+		this->outThread= boost::shared_ptr<boost::thread>();
+	}
+}
+
+// -------------------------------------------------------------------
+// PollMode
+// -------------------------------------------------------------------
+bool ThreadManager::PollMode()
+{
+	return pollMode;
+}
+
+// -------------------------------------------------------------------
+// PollMode
+// -------------------------------------------------------------------
+void ThreadManager::PollMode(bool value)
+{
+	pollMode = value;
+
+	if (pollMode == true)
+	{
+		// Items left by the threads are processed by the next Poll
+		Stop();
+	}
+}
+
+// -------------------------------------------------------------------
+// Poll
+// -------------------------------------------------------------------
+long int ThreadManager::Poll()
+{
+	return ProcessInQueue() + ProcessOutQueue();
+}
+
 // -------------------------------------------------------------------
 // EnqueueDataCall
 // -------------------------------------------------------------------
@@ -223,6 +292,16 @@ void ThreadManager::EnqueueDataCall(boost::shared_ptr<OnDataDelegate> callback,
 
 	inQueueLocker.lock();
 
+	// In poll mode the data is processed at once, unless it must wait for the items queued before it
+	if (pollMode == true && inThreadQueue->size() == 0)
+	{
+		inQueueLocker.unlock();
+
+		ProcessItem(args);
+		args->clear();
+		return;
+	}
+
 	inThreadQueue->push_back(args);
 	
 	inQueueLocker.unlock();
@@ -246,6 +325,14 @@ void ThreadManager::EnqueueCustom(boost::shared_ptr<ParameterizedThreadStart> ca
 // EnqueueSend
 // -------------------------------------------------------------------
 void ThreadManager::EnqueueSend(boost::shared_ptr<WriteBinaryDataDelegate> callback, boost::shared_ptr<PacketHeader> header, boost::shared_ptr<ByteArray> data, boost::shared_ptr<bool> udp)
+{
+	EnqueueSend(callback, header, data, udp, boost::shared_ptr<string>());
+}
+
+// -------------------------------------------------------------------
+// EnqueueSend
+// -------------------------------------------------------------------
+void ThreadManager::EnqueueSend(boost::shared_ptr<WriteBinaryDataDelegate> callback, boost::shared_ptr<PacketHeader> header, boost::shared_ptr<ByteArray> data, boost::shared_ptr<bool> udp, boost::shared_ptr<string> replacementKey)
 {
 	boost::shared_ptr<map<string, boost::shared_ptr<void> > > args (new map<string, boost::shared_ptr<void> >());
 	args->insert (pair<string, boost::shared_ptr<void> >("callback", callback));
@@ -253,12 +340,92 @@ void ThreadManager::EnqueueSend(boost::shared_ptr<WriteBinaryDataDelegate> callb
 	args->insert (pair<string, boost::shared_ptr<void> >("data", data));
 	args->insert (pair<string, boost::shared_ptr<void> >("udp", udp));
 
+	if (replacementKey != NULL)
+	{
+		args->insert (pair<string, boost::shared_ptr<void> >("key", replacementKey));
+	}
+
 	outQueueLocker.lock();
 
+	// A queued message with the same key has not been written yet: it is dropped, and the new one is queued at the tail,
+	// so that it is not written ahead of the messages sent after the dropped one
+	if (replacementKey != NULL)
+	{
+		map<string, list<boost::shared_ptr<map<string, boost::shared_ptr<void> > > >::iterator>::iterator iteratorKey = outThreadKeys.find(*replacementKey);
+		if (iteratorKey != outThreadKeys.end())
+		{
+			outQueueBytes -= ItemBytes(*(iteratorKey->second));
+
+			(*(iteratorKey->second))->clear();
+			outThreadQueue->erase(iteratorKey->second);
+			outThreadKeys.erase(iteratorKey);
+			replacedMessages++;
+		}
+	}
+
+	// In poll mode the message is written at once, unless it must wait for the messages queued before it
+	if (pollMode == true && outThreadQueue->size() == 0)
+	{
+		outQueueLocker.unlock();
+
+		ProcessOutItem(args);
+		args->clear();
+		return;
+	}
+
 	outThreadQueue->push_back(args);
+	outQueueBytes += ItemBytes(args);
+
+	if (replacementKey != NULL)
+	{
+		outThreadKeys[*replacementKey] = --(outThreadQueue->end());
+	}
 		
 	outQueueLocker.unlock();
 }
 
+// -------------------------------------------------------------------
+// ForgetReplacementKey
+// -------------------------------------------------------------------
+void ThreadManager::ForgetReplacementKey(boost::shared_ptr<map<string, boost::shared_ptr<void> > > item)
+{
+	map<string, boost::shared_ptr<void> >::iterator iterator = item->find("key");
+	if (iterator != item->end())
+	{
+		outThreadKeys.erase(*((boost::static_pointer_cast<string>)(iterator->second)));
+	}
+}
+
+// -------------------------------------------------------------------
+// ReplacedMessages
+// -------------------------------------------------------------------
+long int ThreadManager::ReplacedMessages()
+{
+	return replacedMessages;
+}
+
+// -------------------------------------------------------------------
+// PendingSendBytes
+// -------------------------------------------------------------------
+long int ThreadManager::PendingSendBytes()
+{
+	boost::lock_guard<boost::mutex> lock(outQueueLocker);
+	return outQueueBytes;
+}
+
+// -------------------------------------------------------------------
+// ItemBytes
+// -------------------------------------------------------------------
+long int ThreadManager::ItemBytes(boost::shared_ptr<map<string, boost::shared_ptr<void> > > item)
+{
+	map<string, boost::shared_ptr<void> >::iterator iterator = item->find("data");
+	if (iterator == item->end() || iterator->second == NULL)
+	{
+		return 0;
+	}
+
+	return (boost::static_pointer_cast<ByteArray>)(iterator->second)->Length();
+}
+
 }	// namespace Core
 }	// namespace Sfs2X
@@ -60,12 +60,37 @@ namespace Core {
 		void EnqueueDataCall(boost::shared_ptr<OnDataDelegate> callback, boost::shared_ptr<vector<unsigned char> > data);
 		void EnqueueSend(boost::shared_ptr<WriteBinaryDataDelegate> callback, boost::shared_ptr<PacketHeader> header, boost::shared_ptr<ByteArray> data, boost::shared_ptr<bool> udp);
 
+		// EnqueueSend
+		// As above; when a message with the same replacement key is still queued, that older message is dropped and the new one
+		// is appended at the tail like any other, so that only the latest value of a state is written and it never overtakes
+		// the messages queued before it
+		void EnqueueSend(boost::shared_ptr<WriteBinaryDataDelegate> callback, boost::shared_ptr<PacketHeader> header, boost::shared_ptr<ByteArray> data, boost::shared_ptr<bool> udp, boost::shared_ptr<string> replacementKey);
+
+		// ReplacedMessages
+		// Returns the number of queued messages replaced by a newer one before being written
+		long int ReplacedMessages();
+
+		// PendingSendBytes
+		// Returns the quantity of bytes of the messages queued for sending, before compression and encryption
+		long int PendingSendBytes();
+
 		// -------------------------------------------------------------------
 		// Public members
 		// -------------------------------------------------------------------
 
 		void Start();
 
+		// PollMode
+		// When true no thread is started: data and sends are processed at once on the calling thread,
+		// while the other items wait for Poll. Enabling it stops the threads already running
+		bool PollMode();
+		void PollMode(bool value);
+
+		// Poll
+		// Processes the queued items on the calling thread
+		// Returns the number of processed items
+		long int Poll();
+
 	protected:
 
 		// -------------------------------------------------------------------
@@ -84,6 +109,18 @@ namespace Core {
 
 		void InThread();
 		void OutThread();
+		void Stop();
+		long int ProcessInQueue();
+		long int ProcessOutQueue();
+
+		// ForgetReplacementKey
+		// Removes a message leaving the out queue from the index of the replacement keys
+		// Must be called holding outQueueLocker
+		void ForgetReplacementKey(boost::shared_ptr<map<string, boost::shared_ptr<void> > > item);
+
+		// ItemBytes
+		// Returns the quantity of bytes of the data carried by a send item
+		static long int ItemBytes(boost::shared_ptr<map<string, boost::shared_ptr<void> > > item);
 		void ProcessOutItem(boost::shared_ptr<map<string, boost::shared_ptr<void> > > item);
 		void ProcessItem(boost::shared_ptr<map<string, boost::shared_ptr<void> > > item);
 
@@ -92,6 +129,9 @@ namespace Core {
 		// -------------------------------------------------------------------
 
 		bool running;
+		volatile bool pollMode;
+		long int replacedMessages;
+		long int outQueueBytes;
 		
 		boost::shared_ptr<boost::thread> inThread;
 		boost::shared_ptr<list<boost::shared_ptr<map<string, boost::shared_ptr<void> > > > > inThreadQueue;
@@ -99,6 +139,7 @@ namespace Core {
 		
 		boost::shared_ptr<boost::thread> outThread;
 		boost::shared_ptr<list<boost::shared_ptr<map<string, boost::shared_ptr<void> > > > > outThreadQueue;
+		map<string, list<boost::shared_ptr<map<string, boost::shared_ptr<void> > > >::iterator> outThreadKeys;		// Queued messages by replacement key
 		boost::mutex outQueueLocker;
 	};
 
@@ -49,6 +49,11 @@ namespace Data {
 		/// <summary>
 		/// Returns true if the passed object is contained in the Array
 		/// </summary>
+		/// <remarks>
+		/// The object is compared by pointer, so only the elements held by reference can match: strings, typed arrays and classes.
+		/// Primitive elements are stored by value and never match; use <see cref="SFSArray.Contains(const SFSDataValue&)"/> to look them up.<br/>
+		/// <b>Deprecated</b> for primitive values.
+		/// </remarks>
 		/// <param name="obj">
 		/// A void pointer
 		/// </param>
@@ -262,7 +267,20 @@ namespace Data {
 		/// <param name="val">
 		/// A string pointer
 		/// </param>
-		virtual void AddUtfString(string val) = 0;
+		virtual void AddUtfString(const string& val) = 0;
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Appends a UTF-8 string (with max length of 32 KBytes) value to the end of this array.
+		/// </summary>
+		/// <remarks>
+		/// The string is moved into the array instead of being copied.
+		/// </remarks>
+		/// <param name="val">
+		/// The value to be appended to this array.
+		/// </param>
+		virtual void AddUtfString(string&& val) = 0;
+#endif
 
 		/// <summary>
 		/// Appends a UTF-8 string (with max length of 2 GBytes) value to the end of this array.
@@ -278,7 +296,20 @@ namespace Data {
 		/// <param name="val">
 		/// The value to be appended to this array.
 		/// </param>
-		virtual void AddText(string val) = 0;
+		virtual void AddText(const string& val) = 0;
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Appends a UTF-8 string (with max length of 2 GBytes) value to the end of this array.
+		/// </summary>
+		/// <remarks>
+		/// The string is moved into the array instead of being copied.
+		/// </remarks>
+		/// <param name="val">
+		/// The value to be appended to this array.
+		/// </param>
+		virtual void AddText(string&& val) = 0;
+#endif
 
 		/// <summary>
 		/// Add an array of Booleans
@@ -666,6 +697,165 @@ namespace Data {
 		/// </returns>
 		/// <seealso cref="AddClass"/>
 		virtual boost::shared_ptr<void> GetClass(unsigned long int index) = 0;
+
+		/*
+		* :::::::::::::::::::::::::::::::::::::::::
+		* Checked value getters
+		* :::::::::::::::::::::::::::::::::::::::::	
+		* Unlike the getters above, these do not throw when the index is out of range
+		*/
+
+		/// <summary>
+		/// Reads the element at the provided index as a boolean
+		/// </summary>
+		/// <param name="index">
+		/// An unsigned long integer
+		/// </param>
+		/// <param name="value">
+		/// Receives the value; left unchanged when the method returns false
+		/// </param>
+		/// <returns>
+		/// true if the index is in range and the element is a numeric or boolean value
+		/// </returns>
+		virtual bool TryGetBool(unsigned long int index, bool& value) = 0;
+
+		/// <summary>
+		/// Get a boolean element at the provided index, or <paramref name="defaultValue"/> if there is no such numeric or boolean element
+		/// </summary>
+		virtual bool GetBoolOr(unsigned long int index, bool defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element at the provided index as a byte (8 bits)
+		/// </summary>
+		/// <param name="index">
+		/// An unsigned long integer
+		/// </param>
+		/// <param name="value">
+		/// Receives the value; left unchanged when the method returns false
+		/// </param>
+		/// <returns>
+		/// true if the index is in range and the element is a numeric or boolean value
+		/// </returns>
+		virtual bool TryGetByte(unsigned long int index, unsigned char& value) = 0;
+
+		/// <summary>
+		/// Get a byte (8 bits) element at the provided index, or <paramref name="defaultValue"/> if there is no such numeric or boolean element
+		/// </summary>
+		virtual unsigned char GetByteOr(unsigned long int index, unsigned char defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element at the provided index as a short integer (16 bits)
+		/// </summary>
+		/// <param name="index">
+		/// An unsigned long integer
+		/// </param>
+		/// <param name="value">
+		/// Receives the value; left unchanged when the method returns false
+		/// </param>
+		/// <returns>
+		/// true if the index is in range and the element is a numeric or boolean value
+		/// </returns>
+		virtual bool TryGetShort(unsigned long int index, short int& value) = 0;
+
+		/// <summary>
+		/// Get a short integer (16 bits) element at the provided index, or <paramref name="defaultValue"/> if there is no such numeric or boolean element
+		/// </summary>
+		virtual short int GetShortOr(unsigned long int index, short int defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element at the provided index as an integer (32 bits)
+		/// </summary>
+		/// <param name="index">
+		/// An unsigned long integer
+		/// </param>
+		/// <param name="value">
+		/// Receives the value; left unchanged when the method returns false
+		/// </param>
+		/// <returns>
+		/// true if the index is in range and the element is a numeric or boolean value
+		/// </returns>
+		virtual bool TryGetInt(unsigned long int index, long int& value) = 0;
+
+		/// <summary>
+		/// Get an integer (32 bits) element at the provided index, or <paramref name="defaultValue"/> if there is no such numeric or boolean element
+		/// </summary>
+		virtual long int GetIntOr(unsigned long int index, long int defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element at the provided index as a long integer (64 bits)
+		/// </summary>
+		/// <param name="index">
+		/// An unsigned long integer
+		/// </param>
+		/// <param name="value">
+		/// Receives the value; left unchanged when the method returns false
+		/// </param>
+		/// <returns>
+		/// true if the index is in range and the element is a numeric or boolean value
+		/// </returns>
+		virtual bool TryGetLong(unsigned long int index, long long& value) = 0;
+
+		/// <summary>
+		/// Get a long integer (64 bits) element at the provided index, or <paramref name="defaultValue"/> if there is no such numeric or boolean element
+		/// </summary>
+		virtual long long GetLongOr(unsigned long int index, long long defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element at the provided index as a floating point number (32 bits)
+		/// </summary>
+		/// <param name="index">
+		/// An unsigned long integer
+		/// </param>
+		/// <param name="value">
+		/// Receives the value; left unchanged when the method returns false
+		/// </param>
+		/// <returns>
+		/// true if the index is in range and the element is a numeric or boolean value
+		/// </returns>
+		virtual bool TryGetFloat(unsigned long int index, float& value) = 0;
+
+		/// <summary>
+		/// Get a floating point number (32 bits) element at the provided index, or <paramref name="defaultValue"/> if there is no such numeric or boolean element
+		/// </summary>
+		virtual float GetFloatOr(unsigned long int index, float defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element at the provided index as a double precision number (64 bits)
+		/// </summary>
+		/// <param name="index">
+		/// An unsigned long integer
+		/// </param>
+		/// <param name="value">
+		/// Receives the value; left unchanged when the method returns false
+		/// </param>
+		/// <returns>
+		/// true if the index is in range and the element is a numeric or boolean value
+		/// </returns>
+		virtual bool TryGetDouble(unsigned long int index, double& value) = 0;
+
+		/// <summary>
+		/// Get a double precision number (64 bits) element at the provided index, or <paramref name="defaultValue"/> if there is no such numeric or boolean element
+		/// </summary>
+		virtual double GetDoubleOr(unsigned long int index, double defaultValue) = 0;
+
+		/// <summary>
+		/// Copies the UTF-8 string (UTF_STRING or TEXT) element at the provided index
+		/// </summary>
+		/// <param name="index">
+		/// An unsigned long integer
+		/// </param>
+		/// <param name="value">
+		/// Receives the value; left unchanged when the method returns false
+		/// </param>
+		/// <returns>
+		/// true if the index is in range and the element is a non-null string
+		/// </returns>
+		virtual bool TryGetUtfString(unsigned long int index, string& value) = 0;
+
+		/// <summary>
+		/// Get a copy of the UTF-8 string element at the provided index, or <paramref name="defaultValue"/> if there is no such string element
+		/// </summary>
+		virtual string GetUtfStringOr(unsigned long int index, const string& defaultValue) = 0;
 	};
 
 }	// namespace Data
@@ -52,7 +52,7 @@ namespace Data {
 		/// <param name="key">The key to be checked.</param>
 		/// 
 		/// <returns><c>true</c> if the value mapped by the passed key is <c>null</c> or the mapping doesn't exist for that key.</returns>
-		virtual bool IsNull(string key) = 0;
+		virtual bool IsNull(const string& key) = 0;
 
 		/// <summary>
 		/// Indicates if the value mapped by the specified key is <c>null</c>.
@@ -70,7 +70,7 @@ namespace Data {
 		/// <param name="key">The key whose presence in this object is to be tested.</param>
 		/// 
 		/// <returns><c>true</c> if this object contains a mapping for the specified key.</returns>
-		virtual bool ContainsKey(string key) = 0;
+		virtual bool ContainsKey(const string& key) = 0;
 
 		/// <summary>
 		/// Indicates whether this object contains a mapping for the specified key or not.
@@ -86,7 +86,7 @@ namespace Data {
 		/// </summary>
 		/// 
 		/// <param name="key">The key of the element to be removed.</param>
-		virtual void RemoveElement(string key) = 0;
+		virtual void RemoveElement(const string& key) = 0;
 
 		/// <summary>
 		/// Removes the element corresponding to the passed key from this object.
@@ -152,7 +152,7 @@ namespace Data {
 		*/
 
 		/// <exclude />
-		virtual boost::shared_ptr<SFSDataWrapper> GetData(string key) = 0;
+		virtual boost::shared_ptr<SFSDataWrapper> GetData(const string& key) = 0;
 		virtual boost::shared_ptr<SFSDataWrapper> GetData(boost::shared_ptr<string> key) = 0;
 
 		/// <summary>
@@ -162,7 +162,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>false</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<bool> GetBool(string key) = 0;
+		virtual boost::shared_ptr<bool> GetBool(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as a boolean.
@@ -180,7 +180,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>0</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<unsigned char> GetByte(string key) = 0;
+		virtual boost::shared_ptr<unsigned char> GetByte(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as a signed byte (8 bits).
@@ -198,7 +198,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>0</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<short int> GetShort(string key) = 0;
+		virtual boost::shared_ptr<short int> GetShort(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as a short integer (16 bits).
@@ -216,7 +216,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>0</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<long int> GetInt(string key) = 0;
+		virtual boost::shared_ptr<long int> GetInt(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an integer (32 bits).
@@ -234,7 +234,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>0</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<long long> GetLong(string key) = 0;
+		virtual boost::shared_ptr<long long> GetLong(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as a long integer (64 bits).
@@ -252,7 +252,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>0</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<float> GetFloat(string key) = 0;
+		virtual boost::shared_ptr<float> GetFloat(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as a floating point number.
@@ -270,7 +270,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>0</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<double> GetDouble(string key) = 0;
+		virtual boost::shared_ptr<double> GetDouble(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as a double precision number.
@@ -288,7 +288,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<string> GetUtfString(string key) = 0;
+		virtual boost::shared_ptr<string> GetUtfString(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an UTF-8 string, with max length of 32 KBytes.
@@ -306,7 +306,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object associated with the specified key; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<string> GetText(string key) = 0;
+		virtual boost::shared_ptr<string> GetText(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an UTF-8 string, with max length of 2 GBytes.
@@ -324,7 +324,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object as an array of booleans; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<vector<bool> > GetBoolArray(string key) = 0;
+		virtual boost::shared_ptr<vector<bool> > GetBoolArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an array of booleans.
@@ -346,7 +346,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object as a ByteArray object; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<ByteArray> GetByteArray(string key) = 0;
+		virtual boost::shared_ptr<ByteArray> GetByteArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as a ByteArray object.
@@ -368,7 +368,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object as an array of shorts; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<vector<short int> > GetShortArray(string key) = 0;
+		virtual boost::shared_ptr<vector<short int> > GetShortArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an array of shorts.
@@ -386,7 +386,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object as an array of integers; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<vector<long int> > GetIntArray(string key) = 0;
+		virtual boost::shared_ptr<vector<long int> > GetIntArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an array of integers.
@@ -404,7 +404,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object as an array of longs; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<vector<long long> > GetLongArray(string key) = 0;
+		virtual boost::shared_ptr<vector<long long> > GetLongArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an array of longs.
@@ -422,7 +422,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object as an array of floats; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<vector<float> > GetFloatArray(string key) = 0;
+		virtual boost::shared_ptr<vector<float> > GetFloatArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an array of floats.
@@ -440,7 +440,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object as an array of doubles; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<vector<double> > GetDoubleArray(string key) = 0;
+		virtual boost::shared_ptr<vector<double> > GetDoubleArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an array of doubles.
@@ -458,7 +458,7 @@ namespace Data {
 		/// <param name="key">The key whose associated value is to be returned.</param>
 		/// 
 		/// <returns>The element of this object as an array of UTF-8 strings; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
-		virtual boost::shared_ptr<vector<string> > GetUtfStringArray(string key) = 0;
+		virtual boost::shared_ptr<vector<string> > GetUtfStringArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an array of UTF-8 strings.
@@ -478,7 +478,7 @@ namespace Data {
 		/// <returns>The element of this object as an object implementing the ISFSArray interface; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
 		/// 
 		/// <seealso cref="SFSArray"/>
-		virtual boost::shared_ptr<ISFSArray> GetSFSArray(string key) = 0;
+		virtual boost::shared_ptr<ISFSArray> GetSFSArray(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an ISFSArray object.
@@ -500,7 +500,7 @@ namespace Data {
 		/// <returns>The element of this object as an object implementing the ISFSObject interface; <c>null</c> if a mapping for the passed key doesn't exist.</returns>
 		/// 
 		/// <seealso cref="SFSObject"/>
-		virtual boost::shared_ptr<ISFSObject> GetSFSObject(string key) = 0;
+		virtual boost::shared_ptr<ISFSObject> GetSFSObject(const string& key) = 0;
 
 		/// <summary>
 		/// Returns the element corresponding to the specified key as an ISFSObject object.
@@ -582,9 +582,136 @@ namespace Data {
 		/// <returns>
 		/// A void pointer
 		/// </returns>
-		virtual boost::shared_ptr<void> GetClass(string key) = 0;
+		virtual boost::shared_ptr<void> GetClass(const string& key) = 0;
 		virtual boost::shared_ptr<void> GetClass(boost::shared_ptr<string> key) = 0;
 
+		/*
+		* :::::::::::::::::::::::::::::::::::::::::
+		* Value getters
+		* :::::::::::::::::::::::::::::::::::::::::	
+		* Unlike the pointer getters above, these never allocate; numeric values are converted from the stored type
+		*/
+
+		/// <summary>
+		/// Reads the element corresponding to the specified key as a boolean.
+		/// </summary>
+		/// 
+		/// <param name="key">The key whose associated value is to be read.</param>
+		/// <param name="value">Receives the value; left unchanged when the method returns <c>false</c>.</param>
+		/// 
+		/// <returns><c>true</c> if a non-null numeric or boolean value is mapped by the passed key.</returns>
+		virtual bool TryGetBool(const string& key, bool& value) = 0;
+
+		/// <summary>
+		/// Returns the element corresponding to the specified key as a boolean, or <paramref name="defaultValue"/> if the key is missing or mapped to <c>null</c>.
+		/// </summary>
+		virtual bool GetBoolOr(const string& key, bool defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element corresponding to the specified key as a byte (8 bits).
+		/// </summary>
+		/// 
+		/// <param name="key">The key whose associated value is to be read.</param>
+		/// <param name="value">Receives the value; left unchanged when the method returns <c>false</c>.</param>
+		/// 
+		/// <returns><c>true</c> if a non-null numeric or boolean value is mapped by the passed key.</returns>
+		virtual bool TryGetByte(const string& key, unsigned char& value) = 0;
+
+		/// <summary>
+		/// Returns the element corresponding to the specified key as a byte (8 bits), or <paramref name="defaultValue"/> if the key is missing or mapped to <c>null</c>.
+		/// </summary>
+		virtual unsigned char GetByteOr(const string& key, unsigned char defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element corresponding to the specified key as a short integer (16 bits).
+		/// </summary>
+		/// 
+		/// <param name="key">The key whose associated value is to be read.</param>
+		/// <param name="value">Receives the value; left unchanged when the method returns <c>false</c>.</param>
+		/// 
+		/// <returns><c>true</c> if a non-null numeric or boolean value is mapped by the passed key.</returns>
+		virtual bool TryGetShort(const string& key, short int& value) = 0;
+
+		/// <summary>
+		/// Returns the element corresponding to the specified key as a short integer (16 bits), or <paramref name="defaultValue"/> if the key is missing or mapped to <c>null</c>.
+		/// </summary>
+		virtual short int GetShortOr(const string& key, short int defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element corresponding to the specified key as an integer (32 bits).
+		/// </summary>
+		/// 
+		/// <param name="key">The key whose associated value is to be read.</param>
+		/// <param name="value">Receives the value; left unchanged when the method returns <c>false</c>.</param>
+		/// 
+		/// <returns><c>true</c> if a non-null numeric or boolean value is mapped by the passed key.</returns>
+		virtual bool TryGetInt(const string& key, long int& value) = 0;
+
+		/// <summary>
+		/// Returns the element corresponding to the specified key as an integer (32 bits), or <paramref name="defaultValue"/> if the key is missing or mapped to <c>null</c>.
+		/// </summary>
+		virtual long int GetIntOr(const string& key, long int defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element corresponding to the specified key as a long integer (64 bits).
+		/// </summary>
+		/// 
+		/// <param name="key">The key whose associated value is to be read.</param>
+		/// <param name="value">Receives the value; left unchanged when the method returns <c>false</c>.</param>
+		/// 
+		/// <returns><c>true</c> if a non-null numeric or boolean value is mapped by the passed key.</returns>
+		virtual bool TryGetLong(const string& key, long long& value) = 0;
+
+		/// <summary>
+		/// Returns the element corresponding to the specified key as a long integer (64 bits), or <paramref name="defaultValue"/> if the key is missing or mapped to <c>null</c>.
+		/// </summary>
+		virtual long long GetLongOr(const string& key, long long defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element corresponding to the specified key as a floating point number (32 bits).
+		/// </summary>
+		/// 
+		/// <param name="key">The key whose associated value is to be read.</param>
+		/// <param name="value">Receives the value; left unchanged when the method returns <c>false</c>.</param>
+		/// 
+		/// <returns><c>true</c> if a non-null numeric or boolean value is mapped by the passed key.</returns>
+		virtual bool TryGetFloat(const string& key, float& value) = 0;
+
+		/// <summary>
+		/// Returns the element corresponding to the specified key as a floating point number (32 bits), or <paramref name="defaultValue"/> if the key is missing or mapped to <c>null</c>.
+		/// </summary>
+		virtual float GetFloatOr(const string& key, float defaultValue) = 0;
+
+		/// <summary>
+		/// Reads the element corresponding to the specified key as a double precision number (64 bits).
+		/// </summary>
+		/// 
+		/// <param name="key">The key whose associated value is to be read.</param>
+		/// <param name="value">Receives the value; left unchanged when the method returns <c>false</c>.</param>
+		/// 
+		/// <returns><c>true</c> if a non-null numeric or boolean value is mapped by the passed key.</returns>
+		virtual bool TryGetDouble(const string& key, double& value) = 0;
+
+		/// <summary>
+		/// Returns the element corresponding to the specified key as a double precision number (64 bits), or <paramref name="defaultValue"/> if the key is missing or mapped to <c>null</c>.
+		/// </summary>
+		virtual double GetDoubleOr(const string& key, double defaultValue) = 0;
+
+		/// <summary>
+		/// Copies the element corresponding to the specified key as a UTF-8 string (UTF_STRING or TEXT).
+		/// </summary>
+		/// 
+		/// <param name="key">The key whose associated value is to be read.</param>
+		/// <param name="value">Receives the value; left unchanged when the method returns <c>false</c>.</param>
+		/// 
+		/// <returns><c>true</c> if a non-null string is mapped by the passed key.</returns>
+		virtual bool TryGetUtfString(const string& key, string& value) = 0;
+
+		/// <summary>
+		/// Returns a copy of the element corresponding to the specified key as a UTF-8 string, or <paramref name="defaultValue"/> if no string is mapped by the key.
+		/// </summary>
+		virtual string GetUtfStringOr(const string& key, const string& defaultValue) = 0;
+
 		/*
 		* :::::::::::::::::::::::::::::::::::::::::
 		* Type setters
@@ -592,7 +719,7 @@ namespace Data {
 		*/
 
 		/// <exclude />
-		virtual void PutNull(string key) = 0;
+		virtual void PutNull(const string& key) = 0;
 		virtual void PutNull(boost::shared_ptr<string> key) = 0;
 		
 		/// <summary>
@@ -601,7 +728,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutBool(string key, boost::shared_ptr<bool> val) = 0;
+		virtual void PutBool(const string& key, boost::shared_ptr<bool> val) = 0;
 
 		/// <summary>
 		/// Associates the passed boolean value with the specified key in this object.
@@ -617,7 +744,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutBool(string key, bool val) = 0;
+		virtual void PutBool(const string& key, bool val) = 0;
 
 		/// <summary>
 		/// Associates the passed boolean value with the specified key in this object.
@@ -633,7 +760,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutByte(string key, boost::shared_ptr<unsigned char> val) = 0;
+		virtual void PutByte(const string& key, boost::shared_ptr<unsigned char> val) = 0;
 
 		/// <summary>
 		/// Associates the passed byte value with the specified key in this object.
@@ -649,7 +776,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutByte(string key, unsigned char val) = 0;
+		virtual void PutByte(const string& key, unsigned char val) = 0;
 
 		/// <summary>
 		/// Associates the passed byte value with the specified key in this object.
@@ -665,7 +792,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutShort(string key, boost::shared_ptr<short int> val) = 0;
+		virtual void PutShort(const string& key, boost::shared_ptr<short int> val) = 0;
 
 		/// <summary>
 		/// Associates the passed short value with the specified key in this object.
@@ -681,7 +808,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutShort(string key, short int val) = 0;
+		virtual void PutShort(const string& key, short int val) = 0;
 
 		/// <summary>
 		/// Associates the passed short value with the specified key in this object.
@@ -697,7 +824,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutInt(string key, boost::shared_ptr<long int> val) = 0;
+		virtual void PutInt(const string& key, boost::shared_ptr<long int> val) = 0;
 
 		/// <summary>
 		/// Associates the passed integer value with the specified key in this object.
@@ -713,7 +840,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutInt(string key, long int val) = 0;
+		virtual void PutInt(const string& key, long int val) = 0;
 
 		/// <summary>
 		/// Associates the passed integer value with the specified key in this object.
@@ -729,7 +856,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutLong(string key, boost::shared_ptr<long long> val) = 0;
+		virtual void PutLong(const string& key, boost::shared_ptr<long long> val) = 0;
 
 		/// <summary>
 		/// Associates the passed long value with the specified key in this object.
@@ -745,7 +872,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutLong(string key, long long val) = 0;
+		virtual void PutLong(const string& key, long long val) = 0;
 
 		/// <summary>
 		/// Associates the passed long value with the specified key in this object.
@@ -761,7 +888,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutFloat(string key, boost::shared_ptr<float> val) = 0;
+		virtual void PutFloat(const string& key, boost::shared_ptr<float> val) = 0;
 
 		/// <summary>
 		/// Associates the passed float value with the specified key in this object.
@@ -777,7 +904,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutFloat(string key, float val) = 0;
+		virtual void PutFloat(const string& key, float val) = 0;
 
 		/// <summary>
 		/// Associates the passed float value with the specified key in this object.
@@ -793,7 +920,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutDouble(string key, boost::shared_ptr<double> val) = 0;
+		virtual void PutDouble(const string& key, boost::shared_ptr<double> val) = 0;
 
 		/// <summary>
 		/// Associates the passed double value with the specified key in this object.
@@ -809,7 +936,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutDouble(string key, double val) = 0;
+		virtual void PutDouble(const string& key, double val) = 0;
 
 		/// <summary>
 		/// Associates the passed double value with the specified key in this object.
@@ -825,7 +952,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutUtfString(string key, boost::shared_ptr<string> val) = 0;
+		virtual void PutUtfString(const string& key, boost::shared_ptr<string> val) = 0;
 
 		/// <summary>
 		/// Associates the passed UTF-8 string value (max length: 32 KBytes) with the specified key in this object.
@@ -841,15 +968,28 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutUtfString(string key, string val) = 0;
+		virtual void PutUtfString(const string& key, const string& val) = 0;
+
+		/// <summary>
+		/// Associates the passed UTF-8 string value (max length: 32 KBytes) with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <param name="key">The key with which the specified value is to be associated.</param>
+		/// <param name="val">The value to be associated with the specified key.</param>
+		virtual void PutUtfString(boost::shared_ptr<string> key, const string& val) = 0;
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
 		/// <summary>
 		/// Associates the passed UTF-8 string value (max length: 32 KBytes) with the specified key in this object.
 		/// </summary>
 		/// 
+		/// <remarks>
+		/// The string is moved into the object instead of being copied.
+		/// </remarks>
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutUtfString(boost::shared_ptr<string> key, string val) = 0;
+		virtual void PutUtfString(const string& key, string&& val) = 0;
+#endif
 
 		/// <summary>
 		/// Associates the passed UTF-8 string value (max length: 2 GBytes) with the specified key in this object.
@@ -857,7 +997,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutText(string key, boost::shared_ptr<string> val) = 0;
+		virtual void PutText(const string& key, boost::shared_ptr<string> val) = 0;
 
 		/// <summary>
 		/// Associates the passed UTF-8 string value (max length: 2 GBytes) with the specified key in this object.
@@ -873,7 +1013,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutText(string key, string val) = 0;
+		virtual void PutText(const string& key, const string& val) = 0;
 
 		/// <summary>
 		/// Associates the passed UTF-8 string value (max length: 2 GBytes) with the specified key in this object.
@@ -881,7 +1021,20 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified value is to be associated.</param>
 		/// <param name="val">The value to be associated with the specified key.</param>
-		virtual void PutText(boost::shared_ptr<string> key, string val) = 0;
+		virtual void PutText(boost::shared_ptr<string> key, const string& val) = 0;
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Associates the passed UTF-8 string value (max length: 2 GBytes) with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The string is moved into the object instead of being copied.
+		/// </remarks>
+		/// <param name="key">The key with which the specified value is to be associated.</param>
+		/// <param name="val">The value to be associated with the specified key.</param>
+		virtual void PutText(const string& key, string&& val) = 0;
+#endif
 
 		/// <summary>
 		/// Associates the passed array of booleans with the specified key in this object.
@@ -889,7 +1042,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified array is to be associated.</param>
 		/// <param name="val">The array of booleans to be associated with the specified key.</param>
-		virtual void PutBoolArray(string key, boost::shared_ptr<vector<bool> > val) = 0;
+		virtual void PutBoolArray(const string& key, boost::shared_ptr<vector<bool> > val) = 0;
 
 		/// <summary>
 		/// Associates the passed array of booleans with the specified key in this object.
@@ -899,6 +1052,19 @@ namespace Data {
 		/// <param name="val">The array of booleans to be associated with the specified key.</param>
 		virtual void PutBoolArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<bool> > val) = 0;
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Associates the passed array of booleans with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The elements are moved into the object instead of being copied.
+		/// </remarks>
+		/// <param name="key">The key with which the specified array is to be associated.</param>
+		/// <param name="val">The array of booleans to be associated with the specified key.</param>
+		virtual void PutBoolArray(const string& key, vector<bool>&& val) = 0;
+#endif
+
 		/// <summary>
 		/// Associates the passed ByteArray object with the specified key in this object.
 		/// </summary>
@@ -909,7 +1075,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified object is to be associated.</param>
 		/// <param name="val">The object to be associated with the specified key.</param>
-		virtual void PutByteArray(string key, boost::shared_ptr<ByteArray> val) = 0;
+		virtual void PutByteArray(const string& key, boost::shared_ptr<ByteArray> val) = 0;
 
 		/// <summary>
 		/// Associates the passed ByteArray object with the specified key in this object.
@@ -929,7 +1095,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified array is to be associated.</param>
 		/// <param name="val">The array of shorts to be associated with the specified key.</param>
-		virtual void PutShortArray(string key, boost::shared_ptr<vector<short int> > val) = 0;
+		virtual void PutShortArray(const string& key, boost::shared_ptr<vector<short int> > val) = 0;
 
 		/// <summary>
 		/// Associates the passed array of shorts with the specified key in this object.
@@ -939,13 +1105,26 @@ namespace Data {
 		/// <param name="val">The array of shorts to be associated with the specified key.</param>
 		virtual void PutShortArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<short int> > val) = 0;
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Associates the passed array of shorts with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The elements are moved into the object instead of being copied.
+		/// </remarks>
+		/// <param name="key">The key with which the specified array is to be associated.</param>
+		/// <param name="val">The array of shorts to be associated with the specified key.</param>
+		virtual void PutShortArray(const string& key, vector<short int>&& val) = 0;
+#endif
+
 		/// <summary>
 		/// Associates the passed array of integers with the specified key in this object.
 		/// </summary>
 		/// 
 		/// <param name="key">The key with which the specified array is to be associated.</param>
 		/// <param name="val">The array of integers to be associated with the specified key.</param>
-		virtual void PutIntArray(string key, boost::shared_ptr<vector<long int> > val) = 0;
+		virtual void PutIntArray(const string& key, boost::shared_ptr<vector<long int> > val) = 0;
 
 		/// <summary>
 		/// Associates the passed array of integers with the specified key in this object.
@@ -955,13 +1134,26 @@ namespace Data {
 		/// <param name="val">The array of integers to be associated with the specified key.</param>
 		virtual void PutIntArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<long int> > val) = 0;
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Associates the passed array of integers with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The elements are moved into the object instead of being copied.
+		/// </remarks>
+		/// <param name="key">The key with which the specified array is to be associated.</param>
+		/// <param name="val">The array of integers to be associated with the specified key.</param>
+		virtual void PutIntArray(const string& key, vector<long int>&& val) = 0;
+#endif
+
 		/// <summary>
 		/// Associates the passed array of longs with the specified key in this object.
 		/// </summary>
 		/// 
 		/// <param name="key">The key with which the specified array is to be associated.</param>
 		/// <param name="val">The array of longs to be associated with the specified key.</param>
-		virtual void PutLongArray(string key, boost::shared_ptr<vector<long long> > val) = 0;
+		virtual void PutLongArray(const string& key, boost::shared_ptr<vector<long long> > val) = 0;
 
 		/// <summary>
 		/// Associates the passed array of longs with the specified key in this object.
@@ -971,13 +1163,26 @@ namespace Data {
 		/// <param name="val">The array of longs to be associated with the specified key.</param>
 		virtual void PutLongArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<long long> > val) = 0;
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Associates the passed array of longs with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The elements are moved into the object instead of being copied.
+		/// </remarks>
+		/// <param name="key">The key with which the specified array is to be associated.</param>
+		/// <param name="val">The array of longs to be associated with the specified key.</param>
+		virtual void PutLongArray(const string& key, vector<long long>&& val) = 0;
+#endif
+
 		/// <summary>
 		/// Associates the passed array of floats with the specified key in this object.
 		/// </summary>
 		/// 
 		/// <param name="key">The key with which the specified array is to be associated.</param>
 		/// <param name="val">The array of floats to be associated with the specified key.</param>
-		virtual void PutFloatArray(string key, boost::shared_ptr<vector<float> > val) = 0;
+		virtual void PutFloatArray(const string& key, boost::shared_ptr<vector<float> > val) = 0;
 
 		/// <summary>
 		/// Associates the passed array of floats with the specified key in this object.
@@ -987,13 +1192,26 @@ namespace Data {
 		/// <param name="val">The array of floats to be associated with the specified key.</param>
 		virtual void PutFloatArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<float> > val) = 0;
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Associates the passed array of floats with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The elements are moved into the object instead of being copied.
+		/// </remarks>
+		/// <param name="key">The key with which the specified array is to be associated.</param>
+		/// <param name="val">The array of floats to be associated with the specified key.</param>
+		virtual void PutFloatArray(const string& key, vector<float>&& val) = 0;
+#endif
+
 		/// <summary>
 		/// Associates the passed array of doubles with the specified key in this object.
 		/// </summary>
 		/// 
 		/// <param name="key">The key with which the specified array is to be associated.</param>
 		/// <param name="val">The array of doubles to be associated with the specified key.</param>
-		virtual void PutDoubleArray(string key, boost::shared_ptr<vector<double> > val) = 0;
+		virtual void PutDoubleArray(const string& key, boost::shared_ptr<vector<double> > val) = 0;
 
 		/// <summary>
 		/// Associates the passed array of doubles with the specified key in this object.
@@ -1003,13 +1221,26 @@ namespace Data {
 		/// <param name="val">The array of doubles to be associated with the specified key.</param>
 		virtual void PutDoubleArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<double> > val) = 0;
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Associates the passed array of doubles with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The elements are moved into the object instead of being copied.
+		/// </remarks>
+		/// <param name="key">The key with which the specified array is to be associated.</param>
+		/// <param name="val">The array of doubles to be associated with the specified key.</param>
+		virtual void PutDoubleArray(const string& key, vector<double>&& val) = 0;
+#endif
+
 		/// <summary>
 		/// Associates the passed array of UTF-8 strings with the specified key in this object.
 		/// </summary>
 		/// 
 		/// <param name="key">The key with which the specified array is to be associated.</param>
 		/// <param name="val">The array of UTF-8 strings to be associated with the specified key.</param>
-		virtual void PutUtfStringArray(string key, boost::shared_ptr<vector<string> > val) = 0;
+		virtual void PutUtfStringArray(const string& key, boost::shared_ptr<vector<string> > val) = 0;
 
 		/// <summary>
 		/// Associates the passed array of UTF-8 strings with the specified key in this object.
@@ -1019,13 +1250,26 @@ namespace Data {
 		/// <param name="val">The array of UTF-8 strings to be associated with the specified key.</param>
 		virtual void PutUtfStringArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<string> > val) = 0;
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		/// <summary>
+		/// Associates the passed array of UTF-8 strings with the specified key in this object.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The elements are moved into the object instead of being copied.
+		/// </remarks>
+		/// <param name="key">The key with which the specified array is to be associated.</param>
+		/// <param name="val">The array of UTF-8 strings to be associated with the specified key.</param>
+		virtual void PutUtfStringArray(const string& key, vector<string>&& val) = 0;
+#endif
+
 		/// <summary>
 		/// Associates the passed ISFSArray object with the specified key in this object.
 		/// </summary>
 		/// 
 		/// <param name="key">The key with which the specified object is to be associated.</param>
 		/// <param name="val">The object to be associated with the specified key.</param>
-		virtual void PutSFSArray(string key, boost::shared_ptr<ISFSArray> val) = 0;
+		virtual void PutSFSArray(const string& key, boost::shared_ptr<ISFSArray> val) = 0;
 
 		/// <summary>
 		/// Associates the passed ISFSArray object with the specified key in this object.
@@ -1041,7 +1285,7 @@ namespace Data {
 		/// 
 		/// <param name="key">The key with which the specified object is to be associated.</param>
 		/// <param name="val">The object to be associated with the specified key.</param>
-		virtual void PutSFSObject(string key, boost::shared_ptr<ISFSObject> val) = 0;
+		virtual void PutSFSObject(const string& key, boost::shared_ptr<ISFSObject> val) = 0;
 
 		/// <summary>
 		/// Associates the passed ISFSObject object with the specified key in this object.
@@ -1064,7 +1308,7 @@ namespace Data {
 		/// <param name="val">The custom class instance to be associated with the specified key.</param>
 		/// 
 		/// <seealso cref="GetClass"/>
-		virtual void PutClass(string key, boost::shared_ptr<void> val) = 0;
+		virtual void PutClass(const string& key, boost::shared_ptr<void> val) = 0;
 
 		/// <summary>
 		/// Associates the passed custom class instance with the specified key in this object.
@@ -1082,7 +1326,7 @@ namespace Data {
 		virtual void PutClass(boost::shared_ptr<string> key, boost::shared_ptr<void> val) = 0;
 
 		/// <exclude/>
-		virtual void Put(string key, boost::shared_ptr<SFSDataWrapper> val) = 0;
+		virtual void Put(const string& key, boost::shared_ptr<SFSDataWrapper> val) = 0;
 
 		/// <exclude/>
 		virtual void Put(boost::shared_ptr<string> key, boost::shared_ptr<SFSDataWrapper> val) = 0;
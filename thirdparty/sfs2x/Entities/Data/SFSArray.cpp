@@ -11,18 +11,23 @@
 #include "SFSArray.h"
 #include "../../Protocol/Serialization/DefaultSFSDataSerializer.h"
 #include <typeinfo>
+#include <stdexcept>
+#include <string.h>
 
 namespace Sfs2X {
 namespace Entities {
 namespace Data {
 
+const long int SFSArray::MIXED_CONTENT = -1;
+
 // -------------------------------------------------------------------
 // Constructor
 // -------------------------------------------------------------------
 SFSArray::SFSArray()
 {
-	dataHolder = boost::shared_ptr<vector<boost::shared_ptr<SFSDataWrapper> > >(new vector<boost::shared_ptr<SFSDataWrapper> >());
 	serializer = DefaultSFSDataSerializer::Instance();
+	columnType = MIXED_CONTENT;
+	columnSize = 0;
 }
 
 // -------------------------------------------------------------------
@@ -30,8 +35,8 @@ SFSArray::SFSArray()
 // -------------------------------------------------------------------
 SFSArray::~SFSArray()
 {
-	dataHolder->clear();
-	dataHolder = boost::shared_ptr<vector<boost::shared_ptr<SFSDataWrapper> > >();
+	dataHolder.clear();
+	column.clear();
 }
 
 // -------------------------------------------------------------------
@@ -72,11 +77,18 @@ bool SFSArray::Contains(boost::shared_ptr<void> obj)
 		throw exception;
 	}
 
+	// The comparison is by pointer: primitive elements are stored by value and cannot match,
+	// so a typed column is not scanned and no element is boxed
+	if (columnType != MIXED_CONTENT)
+	{
+		return false;
+	}
+
 	for (int j = 0; j < Size(); j++)	
 	{
-		boost::shared_ptr<void> wrappedObj = GetElementAt(j);
+		SFSDataValue value = ValueAt(j);
 				
-		if (wrappedObj == obj)
+		if (!value.IsPrimitive() && value.Data() == obj)
 		{
 			return true;
 		}
@@ -85,12 +97,28 @@ bool SFSArray::Contains(boost::shared_ptr<void> obj)
 	return false;
 }
 
+// -------------------------------------------------------------------
+// Contains
+// -------------------------------------------------------------------
+bool SFSArray::Contains(const SFSDataValue& value)
+{
+	for (long int j = 0; j < Size(); j++)
+	{
+		if (ValueAt(j).Equals(value))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 // -------------------------------------------------------------------
 // GetWrappedElementAt
 // -------------------------------------------------------------------
 boost::shared_ptr<SFSDataWrapper> SFSArray::GetWrappedElementAt(long int index)
 {
-	return dataHolder->at(index);
+	return ValueAt(index).ToWrapper();
 }
 
 
@@ -99,14 +127,8 @@ boost::shared_ptr<SFSDataWrapper> SFSArray::GetWrappedElementAt(long int index)
 // -------------------------------------------------------------------
 boost::shared_ptr<void> SFSArray::GetElementAt(long int index)
 {
-	boost::shared_ptr<void> obj = boost::shared_ptr<void>();
 	//if (index < 0 || dataHolder->size() <= index) return obj;
-	if (dataHolder->at(index) != NULL) 
-	{
-		obj = dataHolder->at(index)->Data();
-	}
-	
-	return obj;
+	return ValueAt(index).Data();
 }
 
 // -------------------------------------------------------------------
@@ -114,10 +136,21 @@ boost::shared_ptr<void> SFSArray::GetElementAt(long int index)
 // -------------------------------------------------------------------
 boost::shared_ptr<void> SFSArray::RemoveElementAt(unsigned long int index)
 {
-	if (index >= dataHolder->size()) return boost::shared_ptr<void>();
-	boost::shared_ptr<SFSDataWrapper> elem = dataHolder->at(index);
-	dataHolder->erase (dataHolder->begin() + index);
-	return elem->Data();
+	if (index >= (unsigned long int)Size()) return boost::shared_ptr<void>();
+	SFSDataValue elem = ValueAt(index);
+
+	if (columnType != MIXED_CONTENT)
+	{
+		long int elementSize = ColumnElementSize(columnType);
+		column.erase (column.begin() + index * elementSize, column.begin() + (index + 1) * elementSize);
+		columnSize--;
+	}
+	else
+	{
+		dataHolder.erase (dataHolder.begin() + index);
+	}
+
+	return elem.Data();
 }
 
 // -------------------------------------------------------------------
@@ -125,7 +158,7 @@ boost::shared_ptr<void> SFSArray::RemoveElementAt(unsigned long int index)
 // -------------------------------------------------------------------
 long int SFSArray::Size()
 {
-	return (long int)dataHolder->size();
+	return columnType != MIXED_CONTENT ? columnSize : (long int)dataHolder.size();
 }
 
 // -------------------------------------------------------------------
@@ -166,15 +199,14 @@ boost::shared_ptr<string> SFSArray::Dump()
 {
 	boost::shared_ptr<string> strDump (new string());
 	strDump->append(1, DefaultObjectDumpFormatter::TOKEN_INDENT_OPEN);
-	boost::shared_ptr<SFSDataWrapper> wrapper;
 
 	long int type;
 
-	vector<boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	for(iterator = dataHolder->begin(); iterator != dataHolder->end(); ++iterator)
+	long int size = Size();
+	for (long int i = 0; i < size; i++)
 	{
-		wrapper = *iterator;
-		type = wrapper->Type();
+		SFSDataValue value = ValueAt(i);
+		type = value.Type();
 
 		switch (type)
 		{
@@ -195,7 +227,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 
 				boost::shared_ptr<string> temporaryString (new string());
 				boost::shared_ptr<string> format (new string("[%d]"));
-				StringFormatter<bool> (temporaryString, format, *((boost::static_pointer_cast<bool>)(wrapper->Data()).get()));
+				StringFormatter<bool> (temporaryString, format, value.BoolValue());
 
 				strDump->append(*temporaryString);
 
@@ -209,7 +241,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 
 				boost::shared_ptr<string> temporaryString (new string());
 				boost::shared_ptr<string> format (new string("[%d]"));
-				StringFormatter<unsigned char> (temporaryString, format, *((boost::static_pointer_cast<unsigned char>)(wrapper->Data()).get()));
+				StringFormatter<unsigned char> (temporaryString, format, value.ByteValue());
 
 				strDump->append(*temporaryString);
 
@@ -223,7 +255,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 
 				boost::shared_ptr<string> temporaryString (new string());
 				boost::shared_ptr<string> format (new string("[%d]"));
-				StringFormatter<short int> (temporaryString, format, *((boost::static_pointer_cast<short int>)(wrapper->Data()).get()));
+				StringFormatter<short int> (temporaryString, format, value.ShortValue());
 
 				strDump->append(*temporaryString);
 
@@ -237,7 +269,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 
 				boost::shared_ptr<string> temporaryString (new string());
 				boost::shared_ptr<string> format (new string("[%ld]"));
-				StringFormatter<long int> (temporaryString, format, *((boost::static_pointer_cast<long int>)(wrapper->Data()).get()));
+				StringFormatter<long int> (temporaryString, format, value.IntValue());
 
 				strDump->append(*temporaryString);
 
@@ -251,7 +283,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 
 				boost::shared_ptr<string> temporaryString (new string());
 				boost::shared_ptr<string> format (new string("[%ld]"));
-				StringFormatter<long long> (temporaryString, format, *((boost::static_pointer_cast<long long>)(wrapper->Data()).get()));
+				StringFormatter<long long> (temporaryString, format, value.LongValue());
 
 				strDump->append(*temporaryString);
 
@@ -265,7 +297,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 
 				boost::shared_ptr<string> temporaryString (new string());
 				boost::shared_ptr<string> format (new string("[%f]"));
-				StringFormatter<float> (temporaryString, format, *((boost::static_pointer_cast<float>)(wrapper->Data()).get()));
+				StringFormatter<float> (temporaryString, format, value.FloatValue());
 
 				strDump->append(*temporaryString);
 
@@ -279,7 +311,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 
 				boost::shared_ptr<string> temporaryString (new string());
 				boost::shared_ptr<string> format (new string("[%f]"));
-				StringFormatter<double> (temporaryString, format, *((boost::static_pointer_cast<double>)(wrapper->Data()).get()));
+				StringFormatter<double> (temporaryString, format, value.DoubleValue());
 
 				strDump->append(*temporaryString);
 
@@ -292,7 +324,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append(") ");
 
 				strDump->append("[");
-				strDump->append(*((boost::static_pointer_cast<string>)(wrapper->Data()).get()));
+				strDump->append(*((boost::static_pointer_cast<string>)(value.Data()).get()));
 				strDump->append("]");
 
 				break;
@@ -306,7 +338,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("[");
 
 				vector<boost::shared_ptr<bool> >::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<bool> > >)(wrapper->Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<bool> > >)(wrapper->Data()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<bool> > >)(value.Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<bool> > >)(value.Data()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 					boost::shared_ptr<string> format (new string("[%d]"));
@@ -328,7 +360,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("[");
 
 				vector<boost::shared_ptr<unsigned char> >::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<unsigned char> > >)(wrapper->Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<unsigned char> > >)(wrapper->Data()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<unsigned char> > >)(value.Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<unsigned char> > >)(value.Data()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 					boost::shared_ptr<string> format (new string("[%d]"));
@@ -350,7 +382,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("[");
 
 				vector<boost::shared_ptr<short int> >::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<short int> > >)(wrapper->Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<short int> > >)(wrapper->Data()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<short int> > >)(value.Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<short int> > >)(value.Data()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 					boost::shared_ptr<string> format (new string("[%d]"));
@@ -372,7 +404,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("[");
 
 				vector<boost::shared_ptr<long int> >::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<long int> > >)(wrapper->Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<long int> > >)(wrapper->Data()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<long int> > >)(value.Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<long int> > >)(value.Data()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 					boost::shared_ptr<string> format (new string("[%ld]"));
@@ -394,7 +426,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("[");
 
 				vector<boost::shared_ptr<long long> >::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<long long> > >)(wrapper->Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<long long> > >)(wrapper->Data()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<long long> > >)(value.Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<long long> > >)(value.Data()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 					boost::shared_ptr<string> format (new string("[%ld]"));
@@ -416,7 +448,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("[");
 
 				vector<boost::shared_ptr<float> >::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<float> > >)(wrapper->Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<float> > >)(wrapper->Data()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<float> > >)(value.Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<float> > >)(value.Data()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 					boost::shared_ptr<string> format (new string("[%f]"));
@@ -438,7 +470,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("[");
 
 				vector<boost::shared_ptr<double> >::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<double> > >)(wrapper->Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<double> > >)(wrapper->Data()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<double> > >)(value.Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<double> > >)(value.Data()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 					boost::shared_ptr<string> format (new string("[%f]"));
@@ -460,7 +492,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("[");
 
 				vector<boost::shared_ptr<string> >::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<string> > >)(wrapper->Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<string> > >)(wrapper->Data()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((boost::static_pointer_cast<vector<boost::shared_ptr<string> > >)(value.Data()))->begin(); iteratorWrapperData != ((boost::static_pointer_cast<vector<boost::shared_ptr<string> > >)(value.Data()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 					boost::shared_ptr<string> format (new string("[%s]"));
@@ -479,7 +511,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("sfs_array");
 				strDump->append(") ");
 
-				strDump->append(*(((boost::static_pointer_cast<SFSArray>)(wrapper->Data()))->GetDump(false))); 
+				strDump->append(*(((boost::static_pointer_cast<SFSArray>)(value.Data()))->GetDump(false))); 
 				break;
 			}
 		case SFSDATATYPE_SFS_OBJECT: 
@@ -488,7 +520,7 @@ boost::shared_ptr<string> SFSArray::Dump()
 				strDump->append("sfs_object");
 				strDump->append(") ");
 
-				strDump->append(*(((boost::static_pointer_cast<SFSObject>)(wrapper->Data()))->GetDump(false))); 
+				strDump->append(*(((boost::static_pointer_cast<SFSObject>)(value.Data()))->GetDump(false))); 
 				break;
 			}
 		case SFSDATATYPE_CLASS:  
@@ -541,9 +573,9 @@ void SFSArray::AddBool(boost::shared_ptr<bool> val)
 
 void SFSArray::AddBool(bool val)
 {
-	boost::shared_ptr<bool> value (new bool());
-	*value = val;
-	AddBool(value);
+	SFSDataValue value;
+	value.SetBool(val);
+	AddValue(value);
 }
 
 void SFSArray::AddByte(boost::shared_ptr<unsigned char> val)
@@ -553,9 +585,9 @@ void SFSArray::AddByte(boost::shared_ptr<unsigned char> val)
 
 void SFSArray::AddByte(unsigned char val)
 {
-	boost::shared_ptr<unsigned char> value (new unsigned char());
-	*value = val;
-	AddByte(value);
+	SFSDataValue value;
+	value.SetByte(val);
+	AddValue(value);
 }
 
 void SFSArray::AddShort(boost::shared_ptr<short int> val)
@@ -565,9 +597,9 @@ void SFSArray::AddShort(boost::shared_ptr<short int> val)
 
 void SFSArray::AddShort(short int val)
 {
-	boost::shared_ptr<short int> value (new short int());
-	*value = val;
-	AddShort(value);
+	SFSDataValue value;
+	value.SetShort(val);
+	AddValue(value);
 }
 
 void SFSArray::AddInt(boost::shared_ptr<long int> val)
@@ -577,9 +609,9 @@ void SFSArray::AddInt(boost::shared_ptr<long int> val)
 
 void SFSArray::AddInt(long int val)
 {
-	boost::shared_ptr<long int> value (new long int());
-	*value = val;
-	AddInt(value);
+	SFSDataValue value;
+	value.SetInt(val);
+	AddValue(value);
 }
 
 void SFSArray::AddLong(boost::shared_ptr<long long> val)
@@ -589,9 +621,9 @@ void SFSArray::AddLong(boost::shared_ptr<long long> val)
 
 void SFSArray::AddLong(long long val)
 {
-	boost::shared_ptr<long long> value (new long long());
-	*value = val;
-	AddLong(value);
+	SFSDataValue value;
+	value.SetLong(val);
+	AddValue(value);
 }
 
 void SFSArray::AddFloat(boost::shared_ptr<float> val)
@@ -601,9 +633,9 @@ void SFSArray::AddFloat(boost::shared_ptr<float> val)
 
 void SFSArray::AddFloat(float val)
 {
-	boost::shared_ptr<float> value (new float());
-	*value = val;
-	AddFloat(value);
+	SFSDataValue value;
+	value.SetFloat(val);
+	AddValue(value);
 }
 
 void SFSArray::AddDouble(boost::shared_ptr<double> val)
@@ -613,9 +645,9 @@ void SFSArray::AddDouble(boost::shared_ptr<double> val)
 
 void SFSArray::AddDouble(double val)
 {
-	boost::shared_ptr<double> value (new double());
-	*value = val;
-	AddDouble(value);
+	SFSDataValue value;
+	value.SetDouble(val);
+	AddValue(value);
 }
 
 void SFSArray::AddUtfString(boost::shared_ptr<string> val)
@@ -623,7 +655,7 @@ void SFSArray::AddUtfString(boost::shared_ptr<string> val)
 	AddObject((boost::static_pointer_cast<void>)(val), SFSDATATYPE_UTF_STRING);
 }
 
-void SFSArray::AddUtfString(string val)
+void SFSArray::AddUtfString(const string& val)
 {
 	boost::shared_ptr<string> value (new string(val));
 	AddUtfString(value);
@@ -634,12 +666,29 @@ void SFSArray::AddText(boost::shared_ptr<string> val)
 	AddObject((boost::static_pointer_cast<void>)(val), SFSDATATYPE_TEXT);
 }
 
-void SFSArray::AddText(string val)
+void SFSArray::AddText(const string& val)
 {
 	boost::shared_ptr<string> value(new string(val));
 	AddText(value);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+void SFSArray::AddUtfString(string&& val)
+{
+	// Take over the characters of the passed string
+	boost::shared_ptr<string> value (new string());
+	value->swap(val);
+	AddUtfString(value);
+}
+
+void SFSArray::AddText(string&& val)
+{
+	boost::shared_ptr<string> value (new string());
+	value->swap(val);
+	AddText(value);
+}
+#endif
+
 void SFSArray::AddBoolArray(boost::shared_ptr<vector<boost::shared_ptr<bool> > > val)
 {
 	AddObject((boost::static_pointer_cast<void>)(val), SFSDATATYPE_BOOL_ARRAY);
@@ -697,13 +746,43 @@ void SFSArray::AddClass(boost::shared_ptr<void> val)
 
 void SFSArray::Add(boost::shared_ptr<SFSDataWrapper> wrappedObject)
 {
-	dataHolder->push_back(wrappedObject);
+	if (wrappedObject == NULL)
+	{
+		AddValue(SFSDataValue());
+		return;
+	}
+
+	AddValue(SFSDataValue(wrappedObject->Type(), wrappedObject->Data()));
 }
 
 void SFSArray::AddObject(boost::shared_ptr<void> val, SFSDataType tp)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper((long int)tp, val));
-	dataHolder->push_back(wrapper);
+	AddValue(SFSDataValue((long int)tp, val));
+}
+
+void SFSArray::AddValue(const SFSDataValue& value)
+{
+	if (columnType != MIXED_CONTENT && value.Type() != columnType)
+	{
+		ConvertToMixed();
+	}
+	else if (columnType == MIXED_CONTENT && dataHolder.empty() && value.IsPrimitive())
+	{
+		// First element of an empty array: start a typed column
+		columnType = value.Type();
+	}
+
+	switch (columnType)
+	{
+	case SFSDATATYPE_BOOL: ColumnAppend<bool>(value.BoolValue()); break;
+	case SFSDATATYPE_BYTE: ColumnAppend<unsigned char>(value.ByteValue()); break;
+	case SFSDATATYPE_SHORT: ColumnAppend<short int>(value.ShortValue()); break;
+	case SFSDATATYPE_INT: ColumnAppend<long int>(value.IntValue()); break;
+	case SFSDATATYPE_LONG: ColumnAppend<long long>(value.LongValue()); break;
+	case SFSDATATYPE_FLOAT: ColumnAppend<float>(value.FloatValue()); break;
+	case SFSDATATYPE_DOUBLE: ColumnAppend<double>(value.DoubleValue()); break;
+	default: dataHolder.push_back(value); break;
+	}
 }
 
 /*
@@ -711,161 +790,400 @@ void SFSArray::AddObject(boost::shared_ptr<void> val, SFSDataType tp)
 * Type getters
 * :::::::::::::::::::::::::::::::::::::::::	
 */
+SFSDataValue SFSArray::ValueAt(long int index)
+{
+	CheckIndex(index);
+
+	if (columnType == MIXED_CONTENT)
+	{
+		return dataHolder[index];
+	}
+
+	SFSDataValue value;
+
+	switch (columnType)
+	{
+	case SFSDATATYPE_BOOL: value.SetBool(ColumnAt<bool>(index)); break;
+	case SFSDATATYPE_BYTE: value.SetByte(ColumnAt<unsigned char>(index)); break;
+	case SFSDATATYPE_SHORT: value.SetShort(ColumnAt<short int>(index)); break;
+	case SFSDATATYPE_INT: value.SetInt(ColumnAt<long int>(index)); break;
+	case SFSDATATYPE_LONG: value.SetLong(ColumnAt<long long>(index)); break;
+	case SFSDATATYPE_FLOAT: value.SetFloat(ColumnAt<float>(index)); break;
+	case SFSDATATYPE_DOUBLE: value.SetDouble(ColumnAt<double>(index)); break;
+	}
+
+	return value;
+}
+
 bool SFSArray::IsNull(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return true;
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (wrapper->Type() == (long int)SFSDATATYPE_NULL);
+	CheckIndex(index);
+	return (columnType == MIXED_CONTENT && dataHolder[index].Type() == (long int)SFSDATATYPE_NULL);
 }
 
 bool SFSArray::GetBool(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return false;
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (bool)(*((boost::static_pointer_cast<bool>)(wrapper->Data())));
+	if (columnType == SFSDATATYPE_BOOL)
+	{
+		CheckIndex(index);
+		return ColumnAt<bool>(index);
+	}
+
+	return ValueAt(index).BoolValue();
 }
 
 unsigned char SFSArray::GetByte(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return 0;
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (unsigned char)(*((boost::static_pointer_cast<unsigned char>)(wrapper->Data())));
+	if (columnType == SFSDATATYPE_BYTE)
+	{
+		CheckIndex(index);
+		return ColumnAt<unsigned char>(index);
+	}
+
+	return ValueAt(index).ByteValue();
 }
 
 short int SFSArray::GetShort(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return 0;
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (short int)(*((boost::static_pointer_cast<short int>)(wrapper->Data())));
+	if (columnType == SFSDATATYPE_SHORT)
+	{
+		CheckIndex(index);
+		return ColumnAt<short int>(index);
+	}
+
+	return ValueAt(index).ShortValue();
 }
 
 long int SFSArray::GetInt(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return 0;
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (long int)(*((boost::static_pointer_cast<long int>)(wrapper->Data())));
+	if (columnType == SFSDATATYPE_INT)
+	{
+		CheckIndex(index);
+		return ColumnAt<long int>(index);
+	}
+
+	return ValueAt(index).IntValue();
 }
 
 long long SFSArray::GetLong(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return 0;
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (long long)(*((boost::static_pointer_cast<long long>)(wrapper->Data())));
+	if (columnType == SFSDATATYPE_LONG)
+	{
+		CheckIndex(index);
+		return ColumnAt<long long>(index);
+	}
+
+	return ValueAt(index).LongValue();
 }
 
 float SFSArray::GetFloat(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return 0;
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (float)(*((boost::static_pointer_cast<float>)(wrapper->Data())));
+	if (columnType == SFSDATATYPE_FLOAT)
+	{
+		CheckIndex(index);
+		return ColumnAt<float>(index);
+	}
+
+	return ValueAt(index).FloatValue();
 }
 
 double SFSArray::GetDouble(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return 0;
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (double)(*((boost::static_pointer_cast<double>)(wrapper->Data())));
+	if (columnType == SFSDATATYPE_DOUBLE)
+	{
+		CheckIndex(index);
+		return ColumnAt<double>(index);
+	}
+
+	return ValueAt(index).DoubleValue();
 }
 
 boost::shared_ptr<string> SFSArray::GetUtfString(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<string>(new string());
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<string>)(wrapper->Data());
+	return (boost::static_pointer_cast<string>)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<string> SFSArray::GetText(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<string>(new string());
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<string>)(wrapper->Data());
+	return (boost::static_pointer_cast<string>)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<vector<boost::shared_ptr<void> > > SFSArray::GetArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<vector<boost::shared_ptr<void> > >();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<vector<boost::shared_ptr<void> > >)(wrapper->Data());
+	return (boost::static_pointer_cast<vector<boost::shared_ptr<void> > >)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<vector<bool> > SFSArray::GetBoolArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<vector<bool> >();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<vector<bool> >)(wrapper->Data());
+	return (boost::static_pointer_cast<vector<bool> >)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<ByteArray> SFSArray::GetByteArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<ByteArray>();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<ByteArray>)(wrapper->Data());
+	return (boost::static_pointer_cast<ByteArray>)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<vector<short int> > SFSArray::GetShortArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<vector<short int> >();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<vector<short int> >)(wrapper->Data());
+	return (boost::static_pointer_cast<vector<short int> >)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<vector<long int> > SFSArray::GetIntArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<vector<long int> >();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<vector<long int> >)(wrapper->Data());
+	return (boost::static_pointer_cast<vector<long int> >)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<vector<long long> > SFSArray::GetLongArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<vector<long long> >();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<vector<long long> >)(wrapper->Data());
+	return (boost::static_pointer_cast<vector<long long> >)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<vector<float> > SFSArray::GetFloatArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<vector<float> >();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<vector<float> >)(wrapper->Data());
+	return (boost::static_pointer_cast<vector<float> >)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<vector<double> > SFSArray::GetDoubleArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<vector<double> >();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<vector<double> >)(wrapper->Data());
+	return (boost::static_pointer_cast<vector<double> >)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<vector<string> > SFSArray::GetUtfStringArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<vector<string> >();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<vector<string> >)(wrapper->Data());
+	return (boost::static_pointer_cast<vector<string> >)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<ISFSArray> SFSArray::GetSFSArray(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<ISFSArray>();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<ISFSArray>)(wrapper->Data());
+	return (boost::static_pointer_cast<ISFSArray>)(ValueAt(index).Data());
 }
 
 boost::shared_ptr<void> SFSArray::GetClass(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<void>();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return wrapper != NULL ? (boost::static_pointer_cast<void>)(wrapper->Data()) : NULL;
+	return ValueAt(index).Data();
 }
 
 boost::shared_ptr<ISFSObject> SFSArray::GetSFSObject(unsigned long int index)
 {
 	//if (index >= dataHolder->size()) return boost::shared_ptr<ISFSObject>();
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(index);
-	return (boost::static_pointer_cast<ISFSObject>)(wrapper->Data());
+	return (boost::static_pointer_cast<ISFSObject>)(ValueAt(index).Data());
+}
+
+bool SFSArray::TryGetBool(unsigned long int index, bool& value)
+{
+	return TryGetPrimitive(index, SFSDATATYPE_BOOL, &SFSDataValue::BoolValue, value);
+}
+
+bool SFSArray::GetBoolOr(unsigned long int index, bool defaultValue)
+{
+	TryGetPrimitive(index, SFSDATATYPE_BOOL, &SFSDataValue::BoolValue, defaultValue);
+	return defaultValue;
+}
+
+bool SFSArray::TryGetByte(unsigned long int index, unsigned char& value)
+{
+	return TryGetPrimitive(index, SFSDATATYPE_BYTE, &SFSDataValue::ByteValue, value);
+}
+
+unsigned char SFSArray::GetByteOr(unsigned long int index, unsigned char defaultValue)
+{
+	TryGetPrimitive(index, SFSDATATYPE_BYTE, &SFSDataValue::ByteValue, defaultValue);
+	return defaultValue;
+}
+
+bool SFSArray::TryGetShort(unsigned long int index, short int& value)
+{
+	return TryGetPrimitive(index, SFSDATATYPE_SHORT, &SFSDataValue::ShortValue, value);
+}
+
+short int SFSArray::GetShortOr(unsigned long int index, short int defaultValue)
+{
+	TryGetPrimitive(index, SFSDATATYPE_SHORT, &SFSDataValue::ShortValue, defaultValue);
+	return defaultValue;
+}
+
+bool SFSArray::TryGetInt(unsigned long int index, long int& value)
+{
+	return TryGetPrimitive(index, SFSDATATYPE_INT, &SFSDataValue::IntValue, value);
+}
+
+long int SFSArray::GetIntOr(unsigned long int index, long int defaultValue)
+{
+	TryGetPrimitive(index, SFSDATATYPE_INT, &SFSDataValue::IntValue, defaultValue);
+	return defaultValue;
+}
+
+bool SFSArray::TryGetLong(unsigned long int index, long long& value)
+{
+	return TryGetPrimitive(index, SFSDATATYPE_LONG, &SFSDataValue::LongValue, value);
+}
+
+long long SFSArray::GetLongOr(unsigned long int index, long long defaultValue)
+{
+	TryGetPrimitive(index, SFSDATATYPE_LONG, &SFSDataValue::LongValue, defaultValue);
+	return defaultValue;
+}
+
+bool SFSArray::TryGetFloat(unsigned long int index, float& value)
+{
+	return TryGetPrimitive(index, SFSDATATYPE_FLOAT, &SFSDataValue::FloatValue, value);
+}
+
+float SFSArray::GetFloatOr(unsigned long int index, float defaultValue)
+{
+	TryGetPrimitive(index, SFSDATATYPE_FLOAT, &SFSDataValue::FloatValue, defaultValue);
+	return defaultValue;
+}
+
+bool SFSArray::TryGetDouble(unsigned long int index, double& value)
+{
+	return TryGetPrimitive(index, SFSDATATYPE_DOUBLE, &SFSDataValue::DoubleValue, value);
+}
+
+double SFSArray::GetDoubleOr(unsigned long int index, double defaultValue)
+{
+	TryGetPrimitive(index, SFSDATATYPE_DOUBLE, &SFSDataValue::DoubleValue, defaultValue);
+	return defaultValue;
+}
+
+bool SFSArray::TryGetUtfString(unsigned long int index, string& value)
+{
+	// Strings are never stored in a typed column
+	if (columnType != MIXED_CONTENT || index >= dataHolder.size() || dataHolder[index].StringValue() == NULL)
+	{
+		return false;
+	}
+
+	value = *(dataHolder[index].StringValue());
+	return true;
+}
+
+string SFSArray::GetUtfStringOr(unsigned long int index, const string& defaultValue)
+{
+	string value = defaultValue;
+	TryGetUtfString(index, value);
+	return value;
+}
+
+// -------------------------------------------------------------------
+// CheckIndex
+// -------------------------------------------------------------------
+void SFSArray::CheckIndex(unsigned long int index)
+{
+	if (index >= (unsigned long int)Size())
+	{
+		boost::throw_exception(std::out_of_range("SFSArray: index out of range"));
+	}
+}
+
+// -------------------------------------------------------------------
+// ConvertToMixed
+// -------------------------------------------------------------------
+void SFSArray::ConvertToMixed()
+{
+	// Move the typed column into one slot per element, before an element of another type is added
+	dataHolder.reserve(columnSize + 1);
+	for (long int i = 0; i < columnSize; i++)
+	{
+		dataHolder.push_back(ValueAt(i));
+	}
+
+	vector<unsigned char>().swap(column);
+	columnSize = 0;
+	columnType = MIXED_CONTENT;
+}
+
+// -------------------------------------------------------------------
+// ColumnElementSize
+// -------------------------------------------------------------------
+long int SFSArray::ColumnElementSize(long int type)
+{
+	switch (type)
+	{
+	case SFSDATATYPE_BOOL: return sizeof(bool);
+	case SFSDATATYPE_BYTE: return sizeof(unsigned char);
+	case SFSDATATYPE_SHORT: return sizeof(short int);
+	case SFSDATATYPE_INT: return sizeof(long int);
+	case SFSDATATYPE_LONG: return sizeof(long long);
+	case SFSDATATYPE_FLOAT: return sizeof(float);
+	case SFSDATATYPE_DOUBLE: return sizeof(double);
+	default: return 0;
+	}
+}
+
+// -------------------------------------------------------------------
+// ColumnAppend
+// -------------------------------------------------------------------
+template <typename T> void SFSArray::ColumnAppend(T value)
+{
+	size_t offset = column.size();
+	column.resize(offset + sizeof(T));
+	memcpy(&column[offset], &value, sizeof(T));
+	columnSize++;
 }
 
+// -------------------------------------------------------------------
+// ColumnAt
+// -------------------------------------------------------------------
+template <typename T> T SFSArray::ColumnAt(unsigned long int index)
+{
+	T value;
+	memcpy(&value, &column[index * sizeof(T)], sizeof(T));
+	return value;
+}
+
+// -------------------------------------------------------------------
+// TryGetPrimitive
+// -------------------------------------------------------------------
+template <typename T> bool SFSArray::TryGetPrimitive(unsigned long int index, long int type, T (SFSDataValue::*accessor)() const, T& value)
+{
+	if (index >= (unsigned long int)Size())
+	{
+		return false;
+	}
+
+	if (columnType == type)
+	{
+		value = ColumnAt<T>(index);
+		return true;
+	}
 
+	if (columnType == MIXED_CONTENT)
+	{
+		if (!dataHolder[index].IsPrimitive())
+		{
+			return false;
+		}
+
+		value = (dataHolder[index].*accessor)();
+		return true;
+	}
+
+	// A column of another primitive type: convert as the typed getters do
+	value = (ValueAt(index).*accessor)();
+	return true;
+}
 
 }	// namespace Data
 }	// namespace Entities
@@ -15,6 +15,7 @@
 #include "../../Util/ByteArray.h"
 #include "../../Protocol/Serialization/ISFSDataSerializer.h"
 #include "../../Entities/Data/SFSDataWrapper.h"
+#include "../../Entities/Data/SFSDataValue.h"
 
 #include <boost/shared_ptr.hpp>					// Boost Asio shared pointer
 #include <boost/enable_shared_from_this.hpp>	// Boost shared_ptr for this
@@ -42,6 +43,9 @@ namespace Data {
 	/// For instance, a number like 100 can be transmitted as a normal <b>integer</b> (which takes 32 bits) but also a <b>short</b> (16 bit) or even a <b>byte</b> (8 bit)
 	/// <para/>
 	/// <b>SFSArray</b> supports many primitive data types and related arrays of primitives. It also allows to serialize class instances and rebuild them on the Java side. This is explained in greater detail in a separate document.
+	/// <para/>
+	/// As long as all the elements are primitives of the same type (for example a list of ids), they are stored in a single contiguous typed buffer;
+	/// the first element of a different type switches the array to one <see cref="SFSDataValue"/> slot per element.
 	/// </remarks>
 	/// <seealso cref="SFSObject"/>
 	class DLLImportExport SFSArray : public ISFSArray, public boost::enable_shared_from_this<SFSArray>
@@ -86,6 +90,14 @@ namespace Data {
 		virtual ~SFSArray();
 
 		bool Contains(boost::shared_ptr<void> obj);
+
+		/// <summary>
+		/// Returns true if an element has the same type and content as the passed value
+		/// </summary>
+		/// <remarks>
+		/// Unlike <see cref="Contains(boost::shared_ptr<void>)"/>, which compares pointers, primitive elements are matched by value.
+		/// </remarks>
+		bool Contains(const SFSDataValue& value);
 		boost::shared_ptr<SFSDataWrapper> GetWrappedElementAt(long int index);
 		boost::shared_ptr<void> GetElementAt(long int index);
 		boost::shared_ptr<void> RemoveElementAt(unsigned long int index);
@@ -116,9 +128,13 @@ namespace Data {
 		 void AddDouble(boost::shared_ptr<double> val);
 		 void AddDouble(double val);
 		 void AddUtfString(boost::shared_ptr<string> val);
-		 void AddUtfString(string val);
+		 void AddUtfString(const string& val);
 		 void AddText(boost::shared_ptr<string> val);
-		 void AddText(string val);
+		 void AddText(const string& val);
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		 void AddUtfString(string&& val);
+		 void AddText(string&& val);
+#endif
 		 void AddBoolArray(boost::shared_ptr<vector<boost::shared_ptr<bool> > > val);
 		 void AddByteArray(boost::shared_ptr<ByteArray> val);
 		 void AddShortArray(boost::shared_ptr<vector<boost::shared_ptr<short int> > > val);
@@ -133,6 +149,17 @@ namespace Data {
 		 void Add(boost::shared_ptr<SFSDataWrapper> wrappedObject);
 		 void AddObject(boost::shared_ptr<void> val, SFSDataType tp);
 
+		/// <summary>
+		/// Appends a value; primitive values are copied without any heap allocation while the content is homogeneous
+		/// </summary>
+		 void AddValue(const SFSDataValue& value);
+
+		/// <summary>
+		/// Returns a copy of the element at the passed index; primitive values are not boxed
+		/// </summary>
+		/// <exception cref="std::out_of_range">If the index is out of range</exception>
+		 SFSDataValue ValueAt(long int index);
+
 		/*
 		* :::::::::::::::::::::::::::::::::::::::::
 		* Type getters
@@ -162,6 +189,23 @@ namespace Data {
 		 boost::shared_ptr<void> GetClass(unsigned long int index);
 		 boost::shared_ptr<ISFSObject> GetSFSObject(unsigned long int index);
 
+		 bool TryGetBool(unsigned long int index, bool& value);
+		 bool GetBoolOr(unsigned long int index, bool defaultValue);
+		 bool TryGetByte(unsigned long int index, unsigned char& value);
+		 unsigned char GetByteOr(unsigned long int index, unsigned char defaultValue);
+		 bool TryGetShort(unsigned long int index, short int& value);
+		 short int GetShortOr(unsigned long int index, short int defaultValue);
+		 bool TryGetInt(unsigned long int index, long int& value);
+		 long int GetIntOr(unsigned long int index, long int defaultValue);
+		 bool TryGetLong(unsigned long int index, long long& value);
+		 long long GetLongOr(unsigned long int index, long long defaultValue);
+		 bool TryGetFloat(unsigned long int index, float& value);
+		 float GetFloatOr(unsigned long int index, float defaultValue);
+		 bool TryGetDouble(unsigned long int index, double& value);
+		 double GetDoubleOr(unsigned long int index, double defaultValue);
+		 bool TryGetUtfString(unsigned long int index, string& value);
+		 string GetUtfStringOr(unsigned long int index, const string& defaultValue);
+
 		// -------------------------------------------------------------------
 		// Public members
 		// -------------------------------------------------------------------
@@ -183,13 +227,25 @@ namespace Data {
 		// -------------------------------------------------------------------
 		
 		boost::shared_ptr<string> Dump();
+		void CheckIndex(unsigned long int index);
+		void ConvertToMixed();
+		static long int ColumnElementSize(long int type);
+		template <typename T> void ColumnAppend(T value);
+		template <typename T> T ColumnAt(unsigned long int index);
+		template <typename T> bool TryGetPrimitive(unsigned long int index, long int type, T (SFSDataValue::*accessor)() const, T& value);
 
 		// -------------------------------------------------------------------
 		// Private members
 		// -------------------------------------------------------------------
 
+		static const long int MIXED_CONTENT;
+
 		boost::shared_ptr<ISFSDataSerializer> serializer;
-		boost::shared_ptr<vector<boost::shared_ptr<SFSDataWrapper> > > dataHolder; 
+
+		long int columnType;								// Type of all the elements while they are homogeneous primitives, MIXED_CONTENT otherwise
+		long int columnSize;								// Number of elements in column
+		vector<unsigned char> column;						// Homogeneous primitive content, packed as an array of the native type
+		vector<SFSDataValue> dataHolder;					// Mixed content, one slot per element
 	};
 
 }	// namespace Data
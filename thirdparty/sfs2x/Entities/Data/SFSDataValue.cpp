@@ -0,0 +1,310 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of SFSDataValue
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "SFSDataValue.h"
+
+#include <boost/make_shared.hpp>
+
+namespace Sfs2X {
+namespace Entities {
+namespace Data {
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+SFSDataValue::SFSDataValue()
+{
+	type = SFSDATATYPE_NULL;
+	primitive.longValue = 0;
+}
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+SFSDataValue::SFSDataValue(long int type, boost::shared_ptr<void> data)
+{
+	this->type = SFSDATATYPE_NULL;
+	primitive.longValue = 0;
+	SetData(type, data);
+}
+
+// -------------------------------------------------------------------
+// Type
+// -------------------------------------------------------------------
+long int SFSDataValue::Type() const
+{
+	return type;
+}
+
+// -------------------------------------------------------------------
+// IsPrimitive
+// -------------------------------------------------------------------
+bool SFSDataValue::IsPrimitive() const
+{
+	return type >= SFSDATATYPE_BOOL && type <= SFSDATATYPE_DOUBLE;
+}
+
+// -------------------------------------------------------------------
+// SetNull
+// -------------------------------------------------------------------
+void SFSDataValue::SetNull()
+{
+	type = SFSDATATYPE_NULL;
+	primitive.longValue = 0;
+	data.reset();
+}
+
+// -------------------------------------------------------------------
+// SetBool
+// -------------------------------------------------------------------
+void SFSDataValue::SetBool(bool value)
+{
+	SetNull();
+	type = SFSDATATYPE_BOOL;
+	primitive.boolValue = value;
+}
+
+// -------------------------------------------------------------------
+// SetByte
+// -------------------------------------------------------------------
+void SFSDataValue::SetByte(unsigned char value)
+{
+	SetNull();
+	type = SFSDATATYPE_BYTE;
+	primitive.byteValue = value;
+}
+
+// -------------------------------------------------------------------
+// SetShort
+// -------------------------------------------------------------------
+void SFSDataValue::SetShort(short int value)
+{
+	SetNull();
+	type = SFSDATATYPE_SHORT;
+	primitive.shortValue = value;
+}
+
+// -------------------------------------------------------------------
+// SetInt
+// -------------------------------------------------------------------
+void SFSDataValue::SetInt(long int value)
+{
+	SetNull();
+	type = SFSDATATYPE_INT;
+	primitive.intValue = value;
+}
+
+// -------------------------------------------------------------------
+// SetLong
+// -------------------------------------------------------------------
+void SFSDataValue::SetLong(long long value)
+{
+	SetNull();
+	type = SFSDATATYPE_LONG;
+	primitive.longValue = value;
+}
+
+// -------------------------------------------------------------------
+// SetFloat
+// -------------------------------------------------------------------
+void SFSDataValue::SetFloat(float value)
+{
+	SetNull();
+	type = SFSDATATYPE_FLOAT;
+	primitive.floatValue = value;
+}
+
+// -------------------------------------------------------------------
+// SetDouble
+// -------------------------------------------------------------------
+void SFSDataValue::SetDouble(double value)
+{
+	SetNull();
+	type = SFSDATATYPE_DOUBLE;
+	primitive.doubleValue = value;
+}
+
+// -------------------------------------------------------------------
+// SetData
+// -------------------------------------------------------------------
+void SFSDataValue::SetData(long int type, boost::shared_ptr<void> data)
+{
+	// A missing value is stored as null, whatever the declared type
+	if (data == NULL)
+	{
+		SetNull();
+		return;
+	}
+
+	switch (type)
+	{
+	case SFSDATATYPE_BOOL: SetBool(*((bool*)data.get())); break;
+	case SFSDATATYPE_BYTE: SetByte(*((unsigned char*)data.get())); break;
+	case SFSDATATYPE_SHORT: SetShort(*((short int*)data.get())); break;
+	case SFSDATATYPE_INT: SetInt(*((long int*)data.get())); break;
+	case SFSDATATYPE_LONG: SetLong(*((long long*)data.get())); break;
+	case SFSDATATYPE_FLOAT: SetFloat(*((float*)data.get())); break;
+	case SFSDATATYPE_DOUBLE: SetDouble(*((double*)data.get())); break;
+	default:
+		this->type = type;
+		primitive.longValue = 0;
+		this->data = data;
+		break;
+	}
+}
+
+// -------------------------------------------------------------------
+// NumericValue
+// -------------------------------------------------------------------
+template <typename T> T SFSDataValue::NumericValue() const
+{
+	switch (type)
+	{
+	case SFSDATATYPE_BOOL: return (T)(primitive.boolValue ? 1 : 0);
+	case SFSDATATYPE_BYTE: return (T)primitive.byteValue;
+	case SFSDATATYPE_SHORT: return (T)primitive.shortValue;
+	case SFSDATATYPE_INT: return (T)primitive.intValue;
+	case SFSDATATYPE_LONG: return (T)primitive.longValue;
+	case SFSDATATYPE_FLOAT: return (T)primitive.floatValue;
+	case SFSDATATYPE_DOUBLE: return (T)primitive.doubleValue;
+	default: return (T)0;
+	}
+}
+
+// -------------------------------------------------------------------
+// BoolValue
+// -------------------------------------------------------------------
+bool SFSDataValue::BoolValue() const
+{
+	return type == SFSDATATYPE_BOOL ? primitive.boolValue : NumericValue<long long>() != 0;
+}
+
+// -------------------------------------------------------------------
+// ByteValue
+// -------------------------------------------------------------------
+unsigned char SFSDataValue::ByteValue() const
+{
+	return type == SFSDATATYPE_BYTE ? primitive.byteValue : NumericValue<unsigned char>();
+}
+
+// -------------------------------------------------------------------
+// ShortValue
+// -------------------------------------------------------------------
+short int SFSDataValue::ShortValue() const
+{
+	return type == SFSDATATYPE_SHORT ? primitive.shortValue : NumericValue<short int>();
+}
+
+// -------------------------------------------------------------------
+// IntValue
+// -------------------------------------------------------------------
+long int SFSDataValue::IntValue() const
+{
+	return type == SFSDATATYPE_INT ? primitive.intValue : NumericValue<long int>();
+}
+
+// -------------------------------------------------------------------
+// LongValue
+// -------------------------------------------------------------------
+long long SFSDataValue::LongValue() const
+{
+	return type == SFSDATATYPE_LONG ? primitive.longValue : NumericValue<long long>();
+}
+
+// -------------------------------------------------------------------
+// FloatValue
+// -------------------------------------------------------------------
+float SFSDataValue::FloatValue() const
+{
+	return type == SFSDATATYPE_FLOAT ? primitive.floatValue : NumericValue<float>();
+}
+
+// -------------------------------------------------------------------
+// DoubleValue
+// -------------------------------------------------------------------
+double SFSDataValue::DoubleValue() const
+{
+	return type == SFSDATATYPE_DOUBLE ? primitive.doubleValue : NumericValue<double>();
+}
+
+// -------------------------------------------------------------------
+// StringValue
+// -------------------------------------------------------------------
+const string* SFSDataValue::StringValue() const
+{
+	if (type != SFSDATATYPE_UTF_STRING && type != SFSDATATYPE_TEXT)
+	{
+		return NULL;
+	}
+
+	return (const string*)data.get();
+}
+
+// -------------------------------------------------------------------
+// Data
+// -------------------------------------------------------------------
+boost::shared_ptr<void> SFSDataValue::Data() const
+{
+	switch (type)
+	{
+	case SFSDATATYPE_BOOL: return boost::make_shared<bool>(primitive.boolValue);
+	case SFSDATATYPE_BYTE: return boost::make_shared<unsigned char>(primitive.byteValue);
+	case SFSDATATYPE_SHORT: return boost::make_shared<short int>(primitive.shortValue);
+	case SFSDATATYPE_INT: return boost::make_shared<long int>(primitive.intValue);
+	case SFSDATATYPE_LONG: return boost::make_shared<long long>(primitive.longValue);
+	case SFSDATATYPE_FLOAT: return boost::make_shared<float>(primitive.floatValue);
+	case SFSDATATYPE_DOUBLE: return boost::make_shared<double>(primitive.doubleValue);
+	default: return data;
+	}
+}
+
+// -------------------------------------------------------------------
+// Equals
+// -------------------------------------------------------------------
+bool SFSDataValue::Equals(const SFSDataValue& other) const
+{
+	if (type != other.type)
+	{
+		return false;
+	}
+
+	switch (type)
+	{
+	case SFSDATATYPE_NULL: return true;
+	case SFSDATATYPE_BOOL: return primitive.boolValue == other.primitive.boolValue;
+	case SFSDATATYPE_BYTE: return primitive.byteValue == other.primitive.byteValue;
+	case SFSDATATYPE_SHORT: return primitive.shortValue == other.primitive.shortValue;
+	case SFSDATATYPE_INT: return primitive.intValue == other.primitive.intValue;
+	case SFSDATATYPE_LONG: return primitive.longValue == other.primitive.longValue;
+	case SFSDATATYPE_FLOAT: return primitive.floatValue == other.primitive.floatValue;
+	case SFSDATATYPE_DOUBLE: return primitive.doubleValue == other.primitive.doubleValue;
+	case SFSDATATYPE_UTF_STRING:
+	case SFSDATATYPE_TEXT:
+		if (data == NULL || other.data == NULL)
+		{
+			return data == other.data;
+		}
+		return *StringValue() == *(other.StringValue());
+	default:
+		return data == other.data;
+	}
+}
+
+// -------------------------------------------------------------------
+// ToWrapper
+// -------------------------------------------------------------------
+boost::shared_ptr<SFSDataWrapper> SFSDataValue::ToWrapper() const
+{
+	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(type, Data()));
+}
+
+}	// namespace Data
+}	// namespace Entities
+}	// namespace Sfs2X
@@ -0,0 +1,138 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of SFSDataValue
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __SFSDataValue__
+#define __SFSDataValue__
+
+#include "SFSDataType.h"
+#include "SFSDataWrapper.h"
+#include "../../Util/Common.h"
+
+#include <boost/shared_ptr.hpp>					// Boost Asio shared pointer
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <string>						// STL library: string object
+using namespace std;					// STL library: declare the STL namespace
+
+namespace Sfs2X {
+namespace Entities {
+namespace Data {
+
+	/// <summary>
+	/// A typed value slot, used by SFSObject to store its entries
+	/// </summary>
+	/// <remarks>
+	/// Primitive values (bool, byte, short, int, long, float, double) are held inline, without any heap allocation;
+	/// strings, typed arrays, nested objects and arrays and classes are held through a shared pointer, as in <see cref="SFSDataWrapper"/>.
+	/// </remarks>
+	class DLLImportExport SFSDataValue
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		/// <summary>
+		/// Creates a null value
+		/// </summary>
+		SFSDataValue();
+
+		/// <summary>
+		/// Creates a value from a type and its data, as held by an <see cref="SFSDataWrapper"/>; primitive data is copied inline
+		/// </summary>
+		SFSDataValue(long int type, boost::shared_ptr<void> data);
+
+		long int Type() const;
+		bool IsPrimitive() const;
+
+		void SetNull();
+		void SetBool(bool value);
+		void SetByte(unsigned char value);
+		void SetShort(short int value);
+		void SetInt(long int value);
+		void SetLong(long long value);
+		void SetFloat(float value);
+		void SetDouble(double value);
+		void SetData(long int type, boost::shared_ptr<void> data);
+
+		/// <summary>
+		/// Returns true if the passed value has the same type and the same content
+		/// </summary>
+		/// <remarks>
+		/// Primitives and strings are compared by value; typed arrays, nested objects and arrays and classes by the address of their data.
+		/// </remarks>
+		bool Equals(const SFSDataValue& other) const;
+
+		/// <summary>
+		/// Primitive value accessors; numeric values are converted from the stored type, other types read as 0 (false)
+		/// </summary>
+		bool BoolValue() const;
+		unsigned char ByteValue() const;
+		short int ShortValue() const;
+		long int IntValue() const;
+		long long LongValue() const;
+		float FloatValue() const;
+		double DoubleValue() const;
+
+		/// <summary>
+		/// The held string for UTF_STRING and TEXT values, NULL for any other type; valid as long as the slot is not modified
+		/// </summary>
+		const string* StringValue() const;
+
+		/// <summary>
+		/// The held data; primitive values are returned in a new allocation, that is not shared with this slot
+		/// </summary>
+		boost::shared_ptr<void> Data() const;
+
+		/// <summary>
+		/// Creates a <see cref="SFSDataWrapper"/> holding the same type and data
+		/// </summary>
+		boost::shared_ptr<SFSDataWrapper> ToWrapper() const;
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		template <typename T> T NumericValue() const;
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		long int type;
+
+		union
+		{
+			bool boolValue;
+			unsigned char byteValue;
+			short int shortValue;
+			long int intValue;
+			long long longValue;
+			float floatValue;
+			double doubleValue;
+		} primitive;
+
+		boost::shared_ptr<void> data;			// Non primitive types only
+	};
+
+}	// namespace Data
+}	// namespace Entities
+}	// namespace Sfs2X
+
+#endif
@@ -11,16 +11,34 @@
 #include "SFSObject.h"
 #include "../../Protocol/Serialization/DefaultSFSDataSerializer.h"
 
+#include <boost/make_shared.hpp>
+#include <stdexcept>
+
 namespace Sfs2X {
 namespace Entities {
 namespace Data {
 
+// -------------------------------------------------------------------
+// SFSObjectEntry constructor
+// -------------------------------------------------------------------
+SFSObjectEntry::SFSObjectEntry()
+{
+	atom = NULL;
+}
+
+// -------------------------------------------------------------------
+// SFSObjectEntry Key
+// -------------------------------------------------------------------
+const string& SFSObjectEntry::Key() const
+{
+	return atom != NULL ? *atom : key;
+}
+
 // -------------------------------------------------------------------
 // Constructor
 // -------------------------------------------------------------------
 SFSObject::SFSObject()
 {
-	dataHolder = boost::shared_ptr<map<string, boost::shared_ptr<SFSDataWrapper> > >(new map<string, boost::shared_ptr<SFSDataWrapper> >());
 	serializer = DefaultSFSDataSerializer::Instance();
 }
 
@@ -29,8 +47,7 @@ SFSObject::SFSObject()
 // -------------------------------------------------------------------
 SFSObject::~SFSObject()
 {
-	dataHolder->clear();
-	dataHolder = boost::shared_ptr<map<string, boost::shared_ptr<SFSDataWrapper> > >();
+	dataHolder.clear();
 }
 
 // -------------------------------------------------------------------
@@ -66,16 +83,15 @@ boost::shared_ptr<string> SFSObject::Dump()
 {
 	boost::shared_ptr<string> strDump (new string());
 	strDump->append(1, DefaultObjectDumpFormatter::TOKEN_INDENT_OPEN);
-	boost::shared_ptr<SFSDataWrapper> wrapper;
 
 	long int type;
 
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	for(iterator = dataHolder->begin(); iterator != dataHolder->end(); ++iterator)
+	vector<SFSObjectEntry>::iterator iterator;
+	for(iterator = dataHolder.begin(); iterator != dataHolder.end(); ++iterator)
 	{
-		wrapper = iterator->second;
-		string key = iterator->first;
-		type = wrapper->Type();
+		const SFSDataValue& value = iterator->value;
+		const string& key = iterator->Key();
+		type = value.Type();
 
 		strDump->append("(");
 		
@@ -117,7 +133,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				boost::shared_ptr<string> temporaryString (new string());
 		
 				boost::shared_ptr<string> format (new string("[%d]"));
-				StringFormatter<bool> (temporaryString, format, *((bool*)(wrapper->Data().get())));
+				StringFormatter<bool> (temporaryString, format, value.BoolValue());
 
 				strDump->append(*temporaryString);
 
@@ -128,7 +144,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				boost::shared_ptr<string> temporaryString (new string());
 		
 				boost::shared_ptr<string> format (new string("[%d]"));
-				StringFormatter<unsigned char> (temporaryString, format, *((unsigned char*)wrapper->Data().get()));
+				StringFormatter<unsigned char> (temporaryString, format, value.ByteValue());
 
 				strDump->append(*temporaryString);
 
@@ -139,7 +155,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				boost::shared_ptr<string> temporaryString (new string());
 		
 				boost::shared_ptr<string> format (new string("[%d]"));
-				StringFormatter<short int> (temporaryString, format, *((short int*)wrapper->Data().get()));
+				StringFormatter<short int> (temporaryString, format, value.ShortValue());
 
 				strDump->append(*temporaryString);
 
@@ -150,7 +166,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				boost::shared_ptr<string> temporaryString (new string());
 		
 				boost::shared_ptr<string> format (new string("[%ld]"));
-				StringFormatter<long int> (temporaryString, format, *((long int*)wrapper->Data().get()));
+				StringFormatter<long int> (temporaryString, format, value.IntValue());
 
 				strDump->append(*temporaryString);
 
@@ -161,7 +177,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				boost::shared_ptr<string> temporaryString (new string());
 		
 				boost::shared_ptr<string> format (new string("[%ld]"));
-				StringFormatter<long long> (temporaryString, format, *((long long*)wrapper->Data().get()));
+				StringFormatter<long long> (temporaryString, format, value.LongValue());
 
 				strDump->append(*temporaryString);
 
@@ -172,7 +188,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				boost::shared_ptr<string> temporaryString (new string());
 		
 				boost::shared_ptr<string> format (new string("[%f]"));
-				StringFormatter<float> (temporaryString, format, *((float*)wrapper->Data().get()));
+				StringFormatter<float> (temporaryString, format, value.FloatValue());
 
 				strDump->append(*temporaryString);
 
@@ -183,7 +199,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				boost::shared_ptr<string> temporaryString (new string());
 		
 				boost::shared_ptr<string> format (new string("[%f]"));
-				StringFormatter<double> (temporaryString, format, *((double*)wrapper->Data().get()));
+				StringFormatter<double> (temporaryString, format, value.DoubleValue());
 
 				strDump->append(*temporaryString);
 
@@ -192,7 +208,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 		case SFSDATATYPE_UTF_STRING: 
 			{
 				strDump->append("[");
-				strDump->append(*((string*)wrapper->Data().get()));
+				strDump->append(*((string*)value.Data().get()));
 				strDump->append("]");
 
 				break;
@@ -202,7 +218,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				strDump->append("[");
 
 				vector<bool>::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((vector<bool>*)wrapper->Data().get())->begin(); iteratorWrapperData != ((vector<bool>*)wrapper->Data().get())->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((vector<bool>*)value.Data().get())->begin(); iteratorWrapperData != ((vector<bool>*)value.Data().get())->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 		
@@ -221,7 +237,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				strDump->append("[");
 
 				vector<unsigned char>::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((vector<unsigned char>*)(((ByteArray*)wrapper->Data().get())->Bytes().get()))->begin(); iteratorWrapperData != ((vector<unsigned char>*)(((ByteArray*)wrapper->Data().get())->Bytes().get()))->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((vector<unsigned char>*)(((ByteArray*)value.Data().get())->Bytes().get()))->begin(); iteratorWrapperData != ((vector<unsigned char>*)(((ByteArray*)value.Data().get())->Bytes().get()))->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 		
@@ -240,7 +256,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				strDump->append("[");
 
 				vector<short int>::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((vector<short int>*)wrapper->Data().get())->begin(); iteratorWrapperData != ((vector<short int>*)wrapper->Data().get())->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((vector<short int>*)value.Data().get())->begin(); iteratorWrapperData != ((vector<short int>*)value.Data().get())->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 		
@@ -260,7 +276,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				strDump->append("[");
 
 				vector<long int>::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((vector<long int>*)wrapper->Data().get())->begin(); iteratorWrapperData != ((vector<long int>*)wrapper->Data().get())->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((vector<long int>*)value.Data().get())->begin(); iteratorWrapperData != ((vector<long int>*)value.Data().get())->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 		
@@ -280,7 +296,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				strDump->append("[");
 
 				vector<long long>::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((vector<long long>*)wrapper->Data().get())->begin(); iteratorWrapperData != ((vector<long long>*)wrapper->Data().get())->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((vector<long long>*)value.Data().get())->begin(); iteratorWrapperData != ((vector<long long>*)value.Data().get())->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 		
@@ -299,7 +315,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				strDump->append("[");
 
 				vector<float>::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((vector<float>*)wrapper->Data().get())->begin(); iteratorWrapperData != ((vector<float>*)wrapper->Data().get())->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((vector<float>*)value.Data().get())->begin(); iteratorWrapperData != ((vector<float>*)value.Data().get())->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 		
@@ -318,7 +334,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				strDump->append("[");
 
 				vector<double>::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((vector<double>*)wrapper->Data().get())->begin(); iteratorWrapperData != ((vector<double>*)wrapper->Data().get())->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((vector<double>*)value.Data().get())->begin(); iteratorWrapperData != ((vector<double>*)value.Data().get())->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 		
@@ -337,7 +353,7 @@ boost::shared_ptr<string> SFSObject::Dump()
 				strDump->append("[");
 
 				vector<string>::iterator iteratorWrapperData;
-				for(iteratorWrapperData = ((vector<string>*)wrapper->Data().get())->begin(); iteratorWrapperData != ((vector<string>*)wrapper->Data().get())->end(); ++iteratorWrapperData)
+				for(iteratorWrapperData = ((vector<string>*)value.Data().get())->begin(); iteratorWrapperData != ((vector<string>*)value.Data().get())->end(); ++iteratorWrapperData)
 				{
 					boost::shared_ptr<string> temporaryString (new string());
 		
@@ -351,8 +367,8 @@ boost::shared_ptr<string> SFSObject::Dump()
 
 				break;
 			}
-		case SFSDATATYPE_SFS_ARRAY: strDump->append(*(((SFSArray*)wrapper->Data().get())->GetDump(false))); break;
-		case SFSDATATYPE_SFS_OBJECT: strDump->append(*(((SFSObject*)wrapper->Data().get())->GetDump(false))); break;
+		case SFSDATATYPE_SFS_ARRAY: strDump->append(*(((SFSArray*)value.Data().get())->GetDump(false))); break;
+		case SFSDATATYPE_SFS_OBJECT: strDump->append(*(((SFSObject*)value.Data().get())->GetDump(false))); break;
 		case SFSDATATYPE_CLASS:  break;
 		}
 
@@ -376,9 +392,15 @@ boost::shared_ptr<string> SFSObject::Dump()
 // -------------------------------------------------------------------
 // GetData
 // -------------------------------------------------------------------
-boost::shared_ptr<SFSDataWrapper> SFSObject::GetData(string key) 
+boost::shared_ptr<SFSDataWrapper> SFSObject::GetData(const string& key) 
 {
-	return dataHolder->at(key);
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
+	{
+		boost::throw_exception(std::out_of_range("SFSObject::GetData"));
+	}
+
+	return value->ToWrapper();
 }
 
 // -------------------------------------------------------------------
@@ -392,16 +414,20 @@ boost::shared_ptr<SFSDataWrapper> SFSObject::GetData(boost::shared_ptr<string> k
 // -------------------------------------------------------------------
 // GetBool
 // -------------------------------------------------------------------
-boost::shared_ptr<bool> SFSObject::GetBool(string key)
+boost::shared_ptr<bool> SFSObject::GetBool(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<bool>(new bool());
 	}
 
-	return (boost::static_pointer_cast<bool>)(((*iterator).second)->Data());
+	if (value->Type() == SFSDATATYPE_NULL)
+	{
+		return boost::shared_ptr<bool>();
+	}
+
+	return boost::make_shared<bool>(value->BoolValue());
 }
 
 // -------------------------------------------------------------------
@@ -415,16 +441,20 @@ boost::shared_ptr<bool> SFSObject::GetBool(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // GetByte
 // -------------------------------------------------------------------
-boost::shared_ptr<unsigned char> SFSObject::GetByte(string key)
+boost::shared_ptr<unsigned char> SFSObject::GetByte(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<unsigned char>(new unsigned char());
 	}
 
-	return (boost::static_pointer_cast<unsigned char>)(((*iterator).second)->Data());
+	if (value->Type() == SFSDATATYPE_NULL)
+	{
+		return boost::shared_ptr<unsigned char>();
+	}
+
+	return boost::make_shared<unsigned char>(value->ByteValue());
 }
 
 // -------------------------------------------------------------------
@@ -438,16 +468,20 @@ boost::shared_ptr<unsigned char> SFSObject::GetByte(boost::shared_ptr<string> ke
 // -------------------------------------------------------------------
 // GetShort
 // -------------------------------------------------------------------
-boost::shared_ptr<short int> SFSObject::GetShort(string key)
+boost::shared_ptr<short int> SFSObject::GetShort(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<short int>(new short int());
 	}
 
-	return (boost::static_pointer_cast<short int>)(((*iterator).second)->Data());
+	if (value->Type() == SFSDATATYPE_NULL)
+	{
+		return boost::shared_ptr<short int>();
+	}
+
+	return boost::make_shared<short int>(value->ShortValue());
 }
 
 // -------------------------------------------------------------------
@@ -461,16 +495,20 @@ boost::shared_ptr<short int> SFSObject::GetShort(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // GetInt
 // -------------------------------------------------------------------
-boost::shared_ptr<long int> SFSObject::GetInt(string key)
+boost::shared_ptr<long int> SFSObject::GetInt(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<long int>(new long int());
 	}
 
-	return (boost::static_pointer_cast<long int>)(((*iterator).second)->Data());
+	if (value->Type() == SFSDATATYPE_NULL)
+	{
+		return boost::shared_ptr<long int>();
+	}
+
+	return boost::make_shared<long int>(value->IntValue());
 }
 
 // -------------------------------------------------------------------
@@ -484,16 +522,20 @@ boost::shared_ptr<long int> SFSObject::GetInt(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // GetLong
 // -------------------------------------------------------------------
-boost::shared_ptr<long long> SFSObject::GetLong(string key)
+boost::shared_ptr<long long> SFSObject::GetLong(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<long long>(new long long());
 	}
 
-	return (boost::static_pointer_cast<long long>)(((*iterator).second)->Data());
+	if (value->Type() == SFSDATATYPE_NULL)
+	{
+		return boost::shared_ptr<long long>();
+	}
+
+	return boost::make_shared<long long>(value->LongValue());
 }
 
 // -------------------------------------------------------------------
@@ -507,16 +549,20 @@ boost::shared_ptr<long long> SFSObject::GetLong(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // GetFloat
 // -------------------------------------------------------------------
-boost::shared_ptr<float> SFSObject::GetFloat(string key)
+boost::shared_ptr<float> SFSObject::GetFloat(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<float>(new float());
 	}
 
-	return (boost::static_pointer_cast<float>)(((*iterator).second)->Data());
+	if (value->Type() == SFSDATATYPE_NULL)
+	{
+		return boost::shared_ptr<float>();
+	}
+
+	return boost::make_shared<float>(value->FloatValue());
 }
 
 // -------------------------------------------------------------------
@@ -530,16 +576,20 @@ boost::shared_ptr<float> SFSObject::GetFloat(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // GetDouble
 // -------------------------------------------------------------------
-boost::shared_ptr<double> SFSObject::GetDouble(string key)
+boost::shared_ptr<double> SFSObject::GetDouble(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<double>(new double());
 	}
 
-	return (boost::static_pointer_cast<double>)(((*iterator).second)->Data());
+	if (value->Type() == SFSDATATYPE_NULL)
+	{
+		return boost::shared_ptr<double>();
+	}
+
+	return boost::make_shared<double>(value->DoubleValue());
 }
 
 // -------------------------------------------------------------------
@@ -553,16 +603,15 @@ boost::shared_ptr<double> SFSObject::GetDouble(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // GetUtfString
 // -------------------------------------------------------------------
-boost::shared_ptr<string> SFSObject::GetUtfString(string key)
+boost::shared_ptr<string> SFSObject::GetUtfString(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<string>();
 	}
 
-	return (boost::static_pointer_cast<string>)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<string>)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -576,16 +625,15 @@ boost::shared_ptr<string> SFSObject::GetUtfString(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // GetText
 // -------------------------------------------------------------------
-boost::shared_ptr<string> SFSObject::GetText(string key)
+boost::shared_ptr<string> SFSObject::GetText(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<string>();
 	}
 
-	return (boost::static_pointer_cast<string>)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<string>)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -599,16 +647,15 @@ boost::shared_ptr<string> SFSObject::GetText(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // GetArray
 // -------------------------------------------------------------------
-boost::shared_ptr<vector<unsigned char> > SFSObject::GetArray(string key)
+boost::shared_ptr<vector<unsigned char> > SFSObject::GetArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<vector<unsigned char> >();
 	}
 
-	return (boost::static_pointer_cast<vector<unsigned char> >)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<vector<unsigned char> >)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -624,16 +671,15 @@ boost::shared_ptr<vector<unsigned char> > SFSObject::GetArray(boost::shared_ptr<
 // -------------------------------------------------------------------
 // GetBoolArray
 // -------------------------------------------------------------------
-boost::shared_ptr<vector<bool> > SFSObject::GetBoolArray(string key)
+boost::shared_ptr<vector<bool> > SFSObject::GetBoolArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<vector<bool> >();
 	}
 
-	return (boost::static_pointer_cast<vector<bool> >)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<vector<bool> >)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -647,16 +693,15 @@ boost::shared_ptr<vector<bool> > SFSObject::GetBoolArray(boost::shared_ptr<strin
 // -------------------------------------------------------------------
 // GetByteArray
 // -------------------------------------------------------------------
-boost::shared_ptr<ByteArray> SFSObject::GetByteArray(string key)
+boost::shared_ptr<ByteArray> SFSObject::GetByteArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<ByteArray>();
 	}
 
-	return (boost::static_pointer_cast<ByteArray>)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<ByteArray>)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -670,16 +715,15 @@ boost::shared_ptr<ByteArray> SFSObject::GetByteArray(boost::shared_ptr<string> k
 // -------------------------------------------------------------------
 // GetShortArray
 // -------------------------------------------------------------------
-boost::shared_ptr<vector<short int> > SFSObject::GetShortArray(string key)
+boost::shared_ptr<vector<short int> > SFSObject::GetShortArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<vector<short int> >();
 	}
 
-	return (boost::static_pointer_cast<vector<short int> >)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<vector<short int> >)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -693,16 +737,15 @@ boost::shared_ptr<vector<short int> > SFSObject::GetShortArray(boost::shared_ptr
 // -------------------------------------------------------------------
 // GetIntArray
 // -------------------------------------------------------------------
-boost::shared_ptr<vector<long int> > SFSObject::GetIntArray(string key)
+boost::shared_ptr<vector<long int> > SFSObject::GetIntArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<vector<long int> >();
 	}
-	
-	return (boost::static_pointer_cast<vector<long int> >)(((*iterator).second)->Data());
+
+	return (boost::static_pointer_cast<vector<long int> >)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -716,16 +759,15 @@ boost::shared_ptr<vector<long int> > SFSObject::GetIntArray(boost::shared_ptr<st
 // -------------------------------------------------------------------
 // GetLongArray
 // -------------------------------------------------------------------
-boost::shared_ptr<vector<long long> > SFSObject::GetLongArray(string key)
+boost::shared_ptr<vector<long long> > SFSObject::GetLongArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<vector<long long> >();
 	}
 
-	return (boost::static_pointer_cast<vector<long long> >)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<vector<long long> >)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -739,16 +781,15 @@ boost::shared_ptr<vector<long long> > SFSObject::GetLongArray(boost::shared_ptr<
 // -------------------------------------------------------------------
 // GetFloatArray
 // -------------------------------------------------------------------
-boost::shared_ptr<vector<float> > SFSObject::GetFloatArray(string key)
+boost::shared_ptr<vector<float> > SFSObject::GetFloatArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<vector<float> >();
 	}
 
-	return (boost::static_pointer_cast<vector<float> >)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<vector<float> >)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -762,16 +803,15 @@ boost::shared_ptr<vector<float> > SFSObject::GetFloatArray(boost::shared_ptr<str
 // -------------------------------------------------------------------
 // GetDoubleArray
 // -------------------------------------------------------------------
-boost::shared_ptr<vector<double> > SFSObject::GetDoubleArray(string key)
+boost::shared_ptr<vector<double> > SFSObject::GetDoubleArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<vector<double> >();
 	}
 
-	return (boost::static_pointer_cast<vector<double> >)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<vector<double> >)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -785,16 +825,15 @@ boost::shared_ptr<vector<double> > SFSObject::GetDoubleArray(boost::shared_ptr<s
 // -------------------------------------------------------------------
 // GetUtfStringArray
 // -------------------------------------------------------------------
-boost::shared_ptr<vector<string> > SFSObject::GetUtfStringArray(string key)
+boost::shared_ptr<vector<string> > SFSObject::GetUtfStringArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<vector<string> >();
 	}
 
-	return (boost::static_pointer_cast<vector<string> >)(((*iterator).second)->Data());
+	return (boost::static_pointer_cast<vector<string> >)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -808,16 +847,15 @@ boost::shared_ptr<vector<string> > SFSObject::GetUtfStringArray(boost::shared_pt
 // -------------------------------------------------------------------
 // GetSFSArray
 // -------------------------------------------------------------------
-boost::shared_ptr<ISFSArray> SFSObject::GetSFSArray(string key)
+boost::shared_ptr<ISFSArray> SFSObject::GetSFSArray(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<ISFSArray>();
 	}
 
-	return (boost::static_pointer_cast<ISFSArray>)((*iterator).second->Data());
+	return (boost::static_pointer_cast<ISFSArray>)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -831,16 +869,15 @@ boost::shared_ptr<ISFSArray> SFSObject::GetSFSArray(boost::shared_ptr<string> ke
 // -------------------------------------------------------------------
 // GetSFSObject
 // -------------------------------------------------------------------
-boost::shared_ptr<ISFSObject> SFSObject::GetSFSObject(string key)
+boost::shared_ptr<ISFSObject> SFSObject::GetSFSObject(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 	{
 		return boost::shared_ptr<ISFSObject>();
 	}
 
-	return (boost::static_pointer_cast<ISFSObject>)((*iterator).second->Data());
+	return (boost::static_pointer_cast<ISFSObject>)(value->Data());
 }
 
 // -------------------------------------------------------------------
@@ -854,10 +891,9 @@ boost::shared_ptr<ISFSObject> SFSObject::GetSFSObject(boost::shared_ptr<string>
 // -------------------------------------------------------------------
 // PutNull
 // -------------------------------------------------------------------
-void SFSObject::PutNull(string key)
+void SFSObject::PutNull(const string& key)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_NULL, boost::shared_ptr<void>()));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue());
 }
 
 // -------------------------------------------------------------------
@@ -871,10 +907,9 @@ void SFSObject::PutNull(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // PutBool
 // -------------------------------------------------------------------
-void SFSObject::PutBool(string key, boost::shared_ptr<bool> val)
+void SFSObject::PutBool(const string& key, boost::shared_ptr<bool> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_BOOL, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_BOOL, val));
 }
 
 // -------------------------------------------------------------------
@@ -888,11 +923,11 @@ void SFSObject::PutBool(boost::shared_ptr<string> key, boost::shared_ptr<bool> v
 // -------------------------------------------------------------------
 // PutBool
 // -------------------------------------------------------------------
-void SFSObject::PutBool(string key, bool val)
+void SFSObject::PutBool(const string& key, bool val)
 {
-	boost::shared_ptr<bool> value (new bool());
-	*value = val;
-	PutBool(key, value);
+	SFSDataValue value;
+	value.SetBool(val);
+	PutValue(key, value);
 }
 
 // -------------------------------------------------------------------
@@ -906,10 +941,9 @@ void SFSObject::PutBool(boost::shared_ptr<string> key, bool val)
 // -------------------------------------------------------------------
 // PutByte
 // -------------------------------------------------------------------
-void SFSObject::PutByte(string key, boost::shared_ptr<unsigned char> val)
+void SFSObject::PutByte(const string& key, boost::shared_ptr<unsigned char> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_BYTE, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_BYTE, val));
 }
 
 // -------------------------------------------------------------------
@@ -923,11 +957,11 @@ void SFSObject::PutByte(boost::shared_ptr<string> key, boost::shared_ptr<unsigne
 // -------------------------------------------------------------------
 // PutByte
 // -------------------------------------------------------------------
-void SFSObject::PutByte(string key, unsigned char val)
+void SFSObject::PutByte(const string& key, unsigned char val)
 {
-	boost::shared_ptr<unsigned char> value (new unsigned char());
-	*value = val;
-	PutByte(key, value);
+	SFSDataValue value;
+	value.SetByte(val);
+	PutValue(key, value);
 }
 
 // -------------------------------------------------------------------
@@ -941,10 +975,9 @@ void SFSObject::PutByte(boost::shared_ptr<string> key, unsigned char val)
 // -------------------------------------------------------------------
 // PutShort
 // -------------------------------------------------------------------
-void SFSObject::PutShort(string key, boost::shared_ptr<short int> val)
+void SFSObject::PutShort(const string& key, boost::shared_ptr<short int> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_SHORT, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_SHORT, val));
 }
 
 // -------------------------------------------------------------------
@@ -958,11 +991,11 @@ void SFSObject::PutShort(boost::shared_ptr<string> key, boost::shared_ptr<short
 // -------------------------------------------------------------------
 // PutShort
 // -------------------------------------------------------------------
-void SFSObject::PutShort(string key, short int val)
+void SFSObject::PutShort(const string& key, short int val)
 {
-	boost::shared_ptr<short int> value (new short int());
-	*value = val;
-	PutShort(key, value);
+	SFSDataValue value;
+	value.SetShort(val);
+	PutValue(key, value);
 }
 
 // -------------------------------------------------------------------
@@ -976,10 +1009,9 @@ void SFSObject::PutShort(boost::shared_ptr<string> key, short int val)
 // -------------------------------------------------------------------
 // PutInt
 // -------------------------------------------------------------------
-void SFSObject::PutInt(string key, boost::shared_ptr<long int> val)
+void SFSObject::PutInt(const string& key, boost::shared_ptr<long int> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_INT, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_INT, val));
 }
 
 // -------------------------------------------------------------------
@@ -993,11 +1025,11 @@ void SFSObject::PutInt(boost::shared_ptr<string> key, boost::shared_ptr<long int
 // -------------------------------------------------------------------
 // PutInt
 // -------------------------------------------------------------------
-void SFSObject::PutInt(string key, long int val)
+void SFSObject::PutInt(const string& key, long int val)
 {
-	boost::shared_ptr<long int> value (new long int());
-	*value = val;
-	PutInt(key, value);
+	SFSDataValue value;
+	value.SetInt(val);
+	PutValue(key, value);
 }
 
 // -------------------------------------------------------------------
@@ -1011,10 +1043,9 @@ void SFSObject::PutInt(boost::shared_ptr<string> key, long int val)
 // -------------------------------------------------------------------
 // PutLong
 // -------------------------------------------------------------------
-void SFSObject::PutLong(string key, boost::shared_ptr<long long> val)
+void SFSObject::PutLong(const string& key, boost::shared_ptr<long long> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_LONG, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_LONG, val));
 }
 
 // -------------------------------------------------------------------
@@ -1028,11 +1059,11 @@ void SFSObject::PutLong(boost::shared_ptr<string> key, boost::shared_ptr<long lo
 // -------------------------------------------------------------------
 // PutLong
 // -------------------------------------------------------------------
-void SFSObject::PutLong(string key, long long val)
+void SFSObject::PutLong(const string& key, long long val)
 {
-	boost::shared_ptr<long long> value (new long long());
-	*value = val;
-	PutLong(key, value);
+	SFSDataValue value;
+	value.SetLong(val);
+	PutValue(key, value);
 }
 
 // -------------------------------------------------------------------
@@ -1046,10 +1077,9 @@ void SFSObject::PutLong(boost::shared_ptr<string> key, long long val)
 // -------------------------------------------------------------------
 // PutFloat
 // -------------------------------------------------------------------
-void SFSObject::PutFloat(string key, boost::shared_ptr<float> val)
+void SFSObject::PutFloat(const string& key, boost::shared_ptr<float> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_FLOAT, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_FLOAT, val));
 }
 
 // -------------------------------------------------------------------
@@ -1063,11 +1093,11 @@ void SFSObject::PutFloat(boost::shared_ptr<string> key, boost::shared_ptr<float>
 // -------------------------------------------------------------------
 // PutFloat
 // -------------------------------------------------------------------
-void SFSObject::PutFloat(string key, float val)
+void SFSObject::PutFloat(const string& key, float val)
 {
-	boost::shared_ptr<float> value (new float());
-	*value = val;
-	PutFloat(key, value);
+	SFSDataValue value;
+	value.SetFloat(val);
+	PutValue(key, value);
 }
 
 // -------------------------------------------------------------------
@@ -1081,10 +1111,9 @@ void SFSObject::PutFloat(boost::shared_ptr<string> key, float val)
 // -------------------------------------------------------------------
 // PutDouble
 // -------------------------------------------------------------------
-void SFSObject::PutDouble(string key, boost::shared_ptr<double> val)
+void SFSObject::PutDouble(const string& key, boost::shared_ptr<double> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_DOUBLE, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_DOUBLE, val));
 }
 
 // -------------------------------------------------------------------
@@ -1098,11 +1127,11 @@ void SFSObject::PutDouble(boost::shared_ptr<string> key, boost::shared_ptr<doubl
 // -------------------------------------------------------------------
 // PutDouble
 // -------------------------------------------------------------------
-void SFSObject::PutDouble(string key, double val)
+void SFSObject::PutDouble(const string& key, double val)
 {
-	boost::shared_ptr<double> value (new double());
-	*value = val;
-	PutDouble(key, value);
+	SFSDataValue value;
+	value.SetDouble(val);
+	PutValue(key, value);
 }
 
 // -------------------------------------------------------------------
@@ -1116,10 +1145,9 @@ void SFSObject::PutDouble(boost::shared_ptr<string> key, double val)
 // -------------------------------------------------------------------
 // PutUtfString
 // -------------------------------------------------------------------
-void SFSObject::PutUtfString(string key, boost::shared_ptr<string> val)
+void SFSObject::PutUtfString(const string& key, boost::shared_ptr<string> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_UTF_STRING, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_UTF_STRING, val));
 }
 
 // -------------------------------------------------------------------
@@ -1133,7 +1161,7 @@ void SFSObject::PutUtfString(boost::shared_ptr<string> key, boost::shared_ptr<st
 // -------------------------------------------------------------------
 // PutUtfString
 // -------------------------------------------------------------------
-void SFSObject::PutUtfString(string key, string val)
+void SFSObject::PutUtfString(const string& key, const string& val)
 {
 	boost::shared_ptr<string> value (new string(val));
 	PutUtfString(key, value);
@@ -1142,18 +1170,30 @@ void SFSObject::PutUtfString(string key, string val)
 // -------------------------------------------------------------------
 // PutUtfString
 // -------------------------------------------------------------------
-void SFSObject::PutUtfString(boost::shared_ptr<string> key, string val)
+void SFSObject::PutUtfString(boost::shared_ptr<string> key, const string& val)
 {
 	PutUtfString(*key, val);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutUtfString
+// -------------------------------------------------------------------
+void SFSObject::PutUtfString(const string& key, string&& val)
+{
+	// Take over the characters of the passed string
+	boost::shared_ptr<string> value (new string());
+	value->swap(val);
+	PutUtfString(key, value);
+}
+#endif
+
 // -------------------------------------------------------------------
 // PutText
 // -------------------------------------------------------------------
-void SFSObject::PutText(string key, boost::shared_ptr<string> val)
+void SFSObject::PutText(const string& key, boost::shared_ptr<string> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper(new SFSDataWrapper(SFSDATATYPE_TEXT, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_TEXT, val));
 }
 
 // -------------------------------------------------------------------
@@ -1161,35 +1201,47 @@ void SFSObject::PutText(string key, boost::shared_ptr<string> val)
 // -------------------------------------------------------------------
 void SFSObject::PutText(boost::shared_ptr<string> key, boost::shared_ptr<string> val)
 {
-	PutUtfString(*key, val);
+	PutText(*key, val);
 }
 
 // -------------------------------------------------------------------
 // PutText
 // -------------------------------------------------------------------
-void SFSObject::PutText(string key, string val)
+void SFSObject::PutText(const string& key, const string& val)
 {
 	boost::shared_ptr<string> value(new string(val));
-	PutUtfString(key, value);
+	PutText(key, value);
 }
 
 // -------------------------------------------------------------------
 // PutText
 // -------------------------------------------------------------------
-void SFSObject::PutText(boost::shared_ptr<string> key, string val)
+void SFSObject::PutText(boost::shared_ptr<string> key, const string& val)
 {
-	PutUtfString(*key, val);
+	PutText(*key, val);
+}
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutText
+// -------------------------------------------------------------------
+void SFSObject::PutText(const string& key, string&& val)
+{
+	// Take over the characters of the passed string
+	boost::shared_ptr<string> value (new string());
+	value->swap(val);
+	PutText(key, value);
 }
+#endif
 
 // Arrays
 
 // -------------------------------------------------------------------
 // PutBoolArray
 // -------------------------------------------------------------------
-void SFSObject::PutBoolArray(string key, boost::shared_ptr<vector<bool> > val)
+void SFSObject::PutBoolArray(const string& key, boost::shared_ptr<vector<bool> > val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_BOOL_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_BOOL_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1200,13 +1252,24 @@ void SFSObject::PutBoolArray(boost::shared_ptr<string> key, boost::shared_ptr<ve
 	PutBoolArray(*key, val);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutBoolArray
+// -------------------------------------------------------------------
+void SFSObject::PutBoolArray(const string& key, vector<bool>&& val)
+{
+	boost::shared_ptr<vector<bool> > value (new vector<bool>());
+	value->swap(val);
+	PutBoolArray(key, value);
+}
+#endif
+
 // -------------------------------------------------------------------
 // PutByteArray
 // -------------------------------------------------------------------
-void SFSObject::PutByteArray(string key, boost::shared_ptr<ByteArray> val)
+void SFSObject::PutByteArray(const string& key, boost::shared_ptr<ByteArray> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_BYTE_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_BYTE_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1220,10 +1283,9 @@ void SFSObject::PutByteArray(boost::shared_ptr<string> key, boost::shared_ptr<By
 // -------------------------------------------------------------------
 // PutShortArray
 // -------------------------------------------------------------------
-void SFSObject::PutShortArray(string key, boost::shared_ptr<vector<short int> > val)
+void SFSObject::PutShortArray(const string& key, boost::shared_ptr<vector<short int> > val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_SHORT_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_SHORT_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1234,13 +1296,24 @@ void SFSObject::PutShortArray(boost::shared_ptr<string> key, boost::shared_ptr<v
 	PutShortArray(*key, val);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutShortArray
+// -------------------------------------------------------------------
+void SFSObject::PutShortArray(const string& key, vector<short int>&& val)
+{
+	boost::shared_ptr<vector<short int> > value (new vector<short int>());
+	value->swap(val);
+	PutShortArray(key, value);
+}
+#endif
+
 // -------------------------------------------------------------------
 // PutIntArray
 // -------------------------------------------------------------------
-void SFSObject::PutIntArray(string key, boost::shared_ptr<vector<long int> > val)
+void SFSObject::PutIntArray(const string& key, boost::shared_ptr<vector<long int> > val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_INT_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_INT_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1251,13 +1324,24 @@ void SFSObject::PutIntArray(boost::shared_ptr<string> key, boost::shared_ptr<vec
 	PutIntArray(*key, val);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutIntArray
+// -------------------------------------------------------------------
+void SFSObject::PutIntArray(const string& key, vector<long int>&& val)
+{
+	boost::shared_ptr<vector<long int> > value (new vector<long int>());
+	value->swap(val);
+	PutIntArray(key, value);
+}
+#endif
+
 // -------------------------------------------------------------------
 // PutLongArray
 // -------------------------------------------------------------------
-void SFSObject::PutLongArray(string key, boost::shared_ptr<vector<long long> > val)
+void SFSObject::PutLongArray(const string& key, boost::shared_ptr<vector<long long> > val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_LONG_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_LONG_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1268,13 +1352,24 @@ void SFSObject::PutLongArray(boost::shared_ptr<string> key, boost::shared_ptr<ve
 	PutLongArray(*key, val);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutLongArray
+// -------------------------------------------------------------------
+void SFSObject::PutLongArray(const string& key, vector<long long>&& val)
+{
+	boost::shared_ptr<vector<long long> > value (new vector<long long>());
+	value->swap(val);
+	PutLongArray(key, value);
+}
+#endif
+
 // -------------------------------------------------------------------
 // PutFloatArray
 // -------------------------------------------------------------------
-void SFSObject::PutFloatArray(string key, boost::shared_ptr<vector<float> > val)
+void SFSObject::PutFloatArray(const string& key, boost::shared_ptr<vector<float> > val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_FLOAT_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_FLOAT_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1285,13 +1380,24 @@ void SFSObject::PutFloatArray(boost::shared_ptr<string> key, boost::shared_ptr<v
 	PutFloatArray(*key, val);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutFloatArray
+// -------------------------------------------------------------------
+void SFSObject::PutFloatArray(const string& key, vector<float>&& val)
+{
+	boost::shared_ptr<vector<float> > value (new vector<float>());
+	value->swap(val);
+	PutFloatArray(key, value);
+}
+#endif
+
 // -------------------------------------------------------------------
 // PutDoubleArray
 // -------------------------------------------------------------------
-void SFSObject::PutDoubleArray(string key, boost::shared_ptr<vector<double> > val)
+void SFSObject::PutDoubleArray(const string& key, boost::shared_ptr<vector<double> > val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_DOUBLE_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_DOUBLE_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1302,13 +1408,24 @@ void SFSObject::PutDoubleArray(boost::shared_ptr<string> key, boost::shared_ptr<
 	PutDoubleArray(*key, val);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutDoubleArray
+// -------------------------------------------------------------------
+void SFSObject::PutDoubleArray(const string& key, vector<double>&& val)
+{
+	boost::shared_ptr<vector<double> > value (new vector<double>());
+	value->swap(val);
+	PutDoubleArray(key, value);
+}
+#endif
+
 // -------------------------------------------------------------------
 // PutUtfStringArray
 // -------------------------------------------------------------------
-void SFSObject::PutUtfStringArray(string key, boost::shared_ptr<vector<string> > val)
+void SFSObject::PutUtfStringArray(const string& key, boost::shared_ptr<vector<string> > val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_UTF_STRING_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_UTF_STRING_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1319,13 +1436,24 @@ void SFSObject::PutUtfStringArray(boost::shared_ptr<string> key, boost::shared_p
 	PutUtfStringArray(*key, val);
 }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+// -------------------------------------------------------------------
+// PutUtfStringArray
+// -------------------------------------------------------------------
+void SFSObject::PutUtfStringArray(const string& key, vector<string>&& val)
+{
+	boost::shared_ptr<vector<string> > value (new vector<string>());
+	value->swap(val);
+	PutUtfStringArray(key, value);
+}
+#endif
+
 // -------------------------------------------------------------------
 // PutSFSArray
 // -------------------------------------------------------------------
-void SFSObject::PutSFSArray(string key, boost::shared_ptr<ISFSArray> val)
+void SFSObject::PutSFSArray(const string& key, boost::shared_ptr<ISFSArray> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_SFS_ARRAY, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_SFS_ARRAY, val));
 }
 
 // -------------------------------------------------------------------
@@ -1339,10 +1467,9 @@ void SFSObject::PutSFSArray(boost::shared_ptr<string> key, boost::shared_ptr<ISF
 // -------------------------------------------------------------------
 // PutSFSObject
 // -------------------------------------------------------------------
-void SFSObject::PutSFSObject(string key, boost::shared_ptr<ISFSObject> val)
+void SFSObject::PutSFSObject(const string& key, boost::shared_ptr<ISFSObject> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_SFS_OBJECT, (boost::static_pointer_cast<void>)(val)));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_SFS_OBJECT, val));
 }
 
 // -------------------------------------------------------------------
@@ -1356,9 +1483,15 @@ void SFSObject::PutSFSObject(boost::shared_ptr<string> key, boost::shared_ptr<IS
 // -------------------------------------------------------------------
 // Put
 // -------------------------------------------------------------------
-void SFSObject::Put(string key, boost::shared_ptr<SFSDataWrapper> val)
+void SFSObject::Put(const string& key, boost::shared_ptr<SFSDataWrapper> val)
 {
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, val));
+	if (val == NULL)
+	{
+		PutValue(key, SFSDataValue());
+		return;
+	}
+
+	PutValue(key, SFSDataValue(val->Type(), val->Data()));
 }
 
 // -------------------------------------------------------------------
@@ -1372,16 +1505,9 @@ void SFSObject::Put(boost::shared_ptr<string> key, boost::shared_ptr<SFSDataWrap
 // -------------------------------------------------------------------
 // ContainsKey
 // -------------------------------------------------------------------
-bool SFSObject::ContainsKey(string key)
+bool SFSObject::ContainsKey(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator == dataHolder->end())
-	{
-		return false;
-	}
-
-	return true;
+	return FindValue(key) != NULL;
 }
 
 // -------------------------------------------------------------------
@@ -1389,33 +1515,175 @@ bool SFSObject::ContainsKey(string key)
 // -------------------------------------------------------------------
 bool SFSObject::ContainsKey(boost::shared_ptr<string> key)
 {
-	return ContainsKey(*key);
+	return FindValue(*key) != NULL;
 }
 
 // -------------------------------------------------------------------
 // GetClass
 // -------------------------------------------------------------------
-boost::shared_ptr<void> SFSObject::GetClass(string key)
+boost::shared_ptr<void> SFSObject::GetClass(const string& key)
 {
-	if (!ContainsKey(key))
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 		return NULL;
 
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(key);
+	return value->Data();
+}
+
+// -------------------------------------------------------------------
+// GetClass
+// -------------------------------------------------------------------
+boost::shared_ptr<void> SFSObject::GetClass(boost::shared_ptr<string> key) 
+{
+	return GetClass(*key);
+}
 
-	if (wrapper->Data() != NULL)
+// -------------------------------------------------------------------
+// TryGetBool
+// -------------------------------------------------------------------
+bool SFSObject::TryGetBool(const string& key, bool& value)
+{
+	return TryGetPrimitive(key, &SFSDataValue::BoolValue, value);
+}
+
+// -------------------------------------------------------------------
+// GetBoolOr
+// -------------------------------------------------------------------
+bool SFSObject::GetBoolOr(const string& key, bool defaultValue)
+{
+	TryGetPrimitive(key, &SFSDataValue::BoolValue, defaultValue);
+	return defaultValue;
+}
+
+// -------------------------------------------------------------------
+// TryGetByte
+// -------------------------------------------------------------------
+bool SFSObject::TryGetByte(const string& key, unsigned char& value)
+{
+	return TryGetPrimitive(key, &SFSDataValue::ByteValue, value);
+}
+
+// -------------------------------------------------------------------
+// GetByteOr
+// -------------------------------------------------------------------
+unsigned char SFSObject::GetByteOr(const string& key, unsigned char defaultValue)
+{
+	TryGetPrimitive(key, &SFSDataValue::ByteValue, defaultValue);
+	return defaultValue;
+}
+
+// -------------------------------------------------------------------
+// TryGetShort
+// -------------------------------------------------------------------
+bool SFSObject::TryGetShort(const string& key, short int& value)
+{
+	return TryGetPrimitive(key, &SFSDataValue::ShortValue, value);
+}
+
+// -------------------------------------------------------------------
+// GetShortOr
+// -------------------------------------------------------------------
+short int SFSObject::GetShortOr(const string& key, short int defaultValue)
+{
+	TryGetPrimitive(key, &SFSDataValue::ShortValue, defaultValue);
+	return defaultValue;
+}
+
+// -------------------------------------------------------------------
+// TryGetInt
+// -------------------------------------------------------------------
+bool SFSObject::TryGetInt(const string& key, long int& value)
+{
+	return TryGetPrimitive(key, &SFSDataValue::IntValue, value);
+}
+
+// -------------------------------------------------------------------
+// GetIntOr
+// -------------------------------------------------------------------
+long int SFSObject::GetIntOr(const string& key, long int defaultValue)
+{
+	TryGetPrimitive(key, &SFSDataValue::IntValue, defaultValue);
+	return defaultValue;
+}
+
+// -------------------------------------------------------------------
+// TryGetLong
+// -------------------------------------------------------------------
+bool SFSObject::TryGetLong(const string& key, long long& value)
+{
+	return TryGetPrimitive(key, &SFSDataValue::LongValue, value);
+}
+
+// -------------------------------------------------------------------
+// GetLongOr
+// -------------------------------------------------------------------
+long long SFSObject::GetLongOr(const string& key, long long defaultValue)
+{
+	TryGetPrimitive(key, &SFSDataValue::LongValue, defaultValue);
+	return defaultValue;
+}
+
+// -------------------------------------------------------------------
+// TryGetFloat
+// -------------------------------------------------------------------
+bool SFSObject::TryGetFloat(const string& key, float& value)
+{
+	return TryGetPrimitive(key, &SFSDataValue::FloatValue, value);
+}
+
+// -------------------------------------------------------------------
+// GetFloatOr
+// -------------------------------------------------------------------
+float SFSObject::GetFloatOr(const string& key, float defaultValue)
+{
+	TryGetPrimitive(key, &SFSDataValue::FloatValue, defaultValue);
+	return defaultValue;
+}
+
+// -------------------------------------------------------------------
+// TryGetDouble
+// -------------------------------------------------------------------
+bool SFSObject::TryGetDouble(const string& key, double& value)
+{
+	return TryGetPrimitive(key, &SFSDataValue::DoubleValue, value);
+}
+
+// -------------------------------------------------------------------
+// GetDoubleOr
+// -------------------------------------------------------------------
+double SFSObject::GetDoubleOr(const string& key, double defaultValue)
+{
+	TryGetPrimitive(key, &SFSDataValue::DoubleValue, defaultValue);
+	return defaultValue;
+}
+
+// -------------------------------------------------------------------
+// TryGetUtfString
+// -------------------------------------------------------------------
+bool SFSObject::TryGetUtfString(const string& key, string& value)
+{
+	const SFSDataValue* found = FindValue(key);
+	if (found == NULL || found->StringValue() == NULL)
 	{
-		return wrapper->Data();
+		return false;
 	}
 
-	return NULL;
+	value = *(found->StringValue());
+	return true;
 }
 
 // -------------------------------------------------------------------
-// GetClass
+// GetUtfStringOr
 // -------------------------------------------------------------------
-boost::shared_ptr<void> SFSObject::GetClass(boost::shared_ptr<string> key) 
+string SFSObject::GetUtfStringOr(const string& key, const string& defaultValue)
 {
-	return GetClass(*key);
+	const SFSDataValue* found = FindValue(key);
+	if (found == NULL || found->StringValue() == NULL)
+	{
+		return defaultValue;
+	}
+
+	return *(found->StringValue());
 }
 
 // -------------------------------------------------------------------
@@ -1454,10 +1722,12 @@ boost::shared_ptr<vector<string> > SFSObject::GetKeys()
 {
 	boost::shared_ptr<vector<string> > keyList (new vector<string>());
 
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	for(iterator = dataHolder->begin(); iterator != dataHolder->end(); ++iterator)
+	keyList->reserve(dataHolder.size());
+
+	vector<SFSObjectEntry>::iterator iterator;
+	for(iterator = dataHolder.begin(); iterator != dataHolder.end(); ++iterator)
 	{
-		keyList->push_back(iterator->first);
+		keyList->push_back(iterator->Key());
 	}
 
 	return keyList;
@@ -1466,13 +1736,13 @@ boost::shared_ptr<vector<string> > SFSObject::GetKeys()
 // -------------------------------------------------------------------
 // IsNull
 // -------------------------------------------------------------------
-bool SFSObject::IsNull(string key)
+bool SFSObject::IsNull(const string& key)
 {
-	if (!ContainsKey(key))
+	const SFSDataValue* value = FindValue(key);
+	if (value == NULL)
 		return true;
 
-	boost::shared_ptr<SFSDataWrapper> wrapper = dataHolder->at(key);
-	return (wrapper->Type() == (int)SFSDataType::SFSDATATYPE_NULL || wrapper->Data() == NULL);
+	return (value->Type() == (int)SFSDataType::SFSDATATYPE_NULL || (!value->IsPrimitive() && value->Data() == NULL));
 }
 
 // -------------------------------------------------------------------
@@ -1486,10 +1756,9 @@ bool SFSObject::IsNull(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 // PutClass
 // -------------------------------------------------------------------
-void SFSObject::PutClass(string key, boost::shared_ptr<void> val)
+void SFSObject::PutClass(const string& key, boost::shared_ptr<void> val)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper (new SFSDataWrapper(SFSDATATYPE_CLASS, val));
-	dataHolder->insert(pair<string, boost::shared_ptr<SFSDataWrapper> >(key, wrapper));
+	PutValue(key, SFSDataValue(SFSDATATYPE_CLASS, val));
 }
 
 // -------------------------------------------------------------------
@@ -1503,13 +1772,12 @@ void SFSObject::PutClass(boost::shared_ptr<string> key, boost::shared_ptr<void>
 // -------------------------------------------------------------------
 // RemoveElement
 // -------------------------------------------------------------------
-void SFSObject::RemoveElement(string key)
+void SFSObject::RemoveElement(const string& key)
 {
-	map<string, boost::shared_ptr<SFSDataWrapper> >::iterator iterator;
-	iterator = dataHolder->find(key);
-	if (iterator != dataHolder->end())
+	long int index = IndexOf(key);
+	if (index >= 0)
 	{
-		dataHolder->erase(iterator);
+		dataHolder.erase(dataHolder.begin() + index);
 	}
 }
 
@@ -1526,7 +1794,7 @@ void SFSObject::RemoveElement(boost::shared_ptr<string> key)
 // -------------------------------------------------------------------
 long int SFSObject::Size()
 {
-	return (long int)dataHolder->size();
+	return (long int)dataHolder.size();
 }
 
 // -------------------------------------------------------------------
@@ -1537,6 +1805,137 @@ boost::shared_ptr<ByteArray> SFSObject::ToBinary()
 	return serializer->Object2Binary(shared_from_this());
 }
 
+// -------------------------------------------------------------------
+// FindValue
+// -------------------------------------------------------------------
+const SFSDataValue* SFSObject::FindValue(const string& key)
+{
+	long int index = IndexOf(key);
+	if (index >= 0)
+	{
+		return &dataHolder[index].value;
+	}
+
+	return NULL;
+}
+
+// -------------------------------------------------------------------
+// KeyAt
+// -------------------------------------------------------------------
+const string& SFSObject::KeyAt(long int index)
+{
+	return dataHolder[index].Key();
+}
+
+// -------------------------------------------------------------------
+// ValueAt
+// -------------------------------------------------------------------
+const SFSDataValue& SFSObject::ValueAt(long int index)
+{
+	return dataHolder[index].value;
+}
+
+// -------------------------------------------------------------------
+// PutValue
+// -------------------------------------------------------------------
+void SFSObject::PutValue(const string& key, const SFSDataValue& value)
+{
+	long int index = LowerBound(key);
+	if (index < (long int)dataHolder.size() && dataHolder[index].Key() == key)
+	{
+		return;
+	}
+
+	// Entries arrive in key order when decoding, so the insert is usually an append
+	dataHolder.insert(dataHolder.begin() + index, SFSObjectEntry());
+	dataHolder[index].atom = KeyTable::Intern(key);
+	if (dataHolder[index].atom == NULL)
+	{
+		dataHolder[index].key = key;
+	}
+
+	dataHolder[index].value = value;
+}
+
+// -------------------------------------------------------------------
+// Reserve
+// -------------------------------------------------------------------
+void SFSObject::Reserve(long int capacity)
+{
+	if (capacity > 0)
+	{
+		dataHolder.reserve((size_t)capacity);
+	}
+}
+
+// -------------------------------------------------------------------
+// TryGetPrimitive
+// -------------------------------------------------------------------
+template <typename T> bool SFSObject::TryGetPrimitive(const string& key, T (SFSDataValue::*accessor)() const, T& value)
+{
+	const SFSDataValue* found = FindValue(key);
+	if (found == NULL || !found->IsPrimitive())
+	{
+		return false;
+	}
+
+	value = (found->*accessor)();
+	return true;
+}
+
+// -------------------------------------------------------------------
+// LowerBound
+// -------------------------------------------------------------------
+long int SFSObject::LowerBound(const string& key)
+{
+	// Binary search of the first entry whose key is not less than the passed one
+	long int first = 0;
+	long int count = (long int)dataHolder.size();
+
+	while (count > 0)
+	{
+		long int step = count / 2;
+		if (dataHolder[first + step].Key() < key)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
+
+	return first;
+}
+
+// -------------------------------------------------------------------
+// IndexOf
+// -------------------------------------------------------------------
+long int SFSObject::IndexOf(const string& key)
+{
+	// A key passed by its atom (as the protocol keys are) matches the entry holding the same atom,
+	// which a short scan of the few entries of a message finds without comparing any characters
+	if (dataHolder.size() <= 16)
+	{
+		for (long int index = 0; index < (long int)dataHolder.size(); index++)
+		{
+			if (dataHolder[index].atom == &key)
+			{
+				return index;
+			}
+		}
+	}
+
+	long int index = LowerBound(key);
+	if (index < (long int)dataHolder.size() && dataHolder[index].Key() == key)
+	{
+		return index;
+	}
+
+	return -1;
+}
+
 }	// namespace Data
 }	// namespace Entities
 }	// namespace Sfs2X
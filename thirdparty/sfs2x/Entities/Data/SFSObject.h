@@ -14,7 +14,9 @@
 #include "../../Protocol/Serialization/DefaultObjectDumpFormatter.h"
 #include "../../Protocol/Serialization/DefaultSFSDataSerializer.h"
 #include "ISFSObject.h"
+#include "SFSDataValue.h"
 #include "../../Util/StringFormatter.h"
+#include "../../Util/KeyTable.h"
 #include <boost/exception/exception.hpp>
 #include <boost/exception/all.hpp>
 #include <boost/shared_ptr.hpp>					// Boost Asio shared pointer
@@ -25,6 +27,7 @@
 #endif
 #include <string>						// STL library: string object
 #include <map>							// STL library: map object
+#include <vector>						// STL library: vector object
 using namespace std;					// STL library: declare the STL namespace
 
 using namespace Sfs2X::Exceptions;
@@ -35,6 +38,35 @@ namespace Sfs2X {
 namespace Entities {
 namespace Data {
 
+	// -------------------------------------------------------------------
+	// Class SFSObjectEntry
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// A key and its value, as stored by <see cref="SFSObject"/>
+	/// </summary>
+	/// <remarks>
+	/// Interned keys are referenced through their atom in the <see cref="KeyTable"/>; only the keys that could not be interned are copied.
+	/// </remarks>
+	class DLLImportExport SFSObjectEntry
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		SFSObjectEntry();
+		const string& Key() const;
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		const string* atom;				// The interned key, or NULL
+		string key;						// The key when it is not interned
+		SFSDataValue value;
+	};
+
 	/// <summary>
 	/// SFSObject
 	/// </summary>
@@ -94,130 +126,182 @@ namespace Data {
 		SFSObject();
 		virtual ~SFSObject();
 
-		boost::shared_ptr<SFSDataWrapper> GetData(string key);
+		boost::shared_ptr<SFSDataWrapper> GetData(const string& key);
 		boost::shared_ptr<SFSDataWrapper> GetData(boost::shared_ptr<string> key);
-		//T GetValue<T>(string key);
-		boost::shared_ptr<bool> GetBool(string key);
+		//T GetValue<T>(const string& key);
+		boost::shared_ptr<bool> GetBool(const string& key);
 		boost::shared_ptr<bool> GetBool(boost::shared_ptr<string> key);
-		boost::shared_ptr<unsigned char> GetByte(string key);
+		boost::shared_ptr<unsigned char> GetByte(const string& key);
 		boost::shared_ptr<unsigned char> GetByte(boost::shared_ptr<string> key);
-		boost::shared_ptr<short int> GetShort(string key);
+		boost::shared_ptr<short int> GetShort(const string& key);
 		boost::shared_ptr<short int> GetShort(boost::shared_ptr<string> key);
-		boost::shared_ptr<long int> GetInt(string key);
+		boost::shared_ptr<long int> GetInt(const string& key);
 		boost::shared_ptr<long int> GetInt(boost::shared_ptr<string> key);
-		boost::shared_ptr<long long> GetLong(string key);
+		boost::shared_ptr<long long> GetLong(const string& key);
 		boost::shared_ptr<long long> GetLong(boost::shared_ptr<string> key);
-		boost::shared_ptr<float> GetFloat(string key);
+		boost::shared_ptr<float> GetFloat(const string& key);
 		boost::shared_ptr<float> GetFloat(boost::shared_ptr<string> key);
-		boost::shared_ptr<double> GetDouble(string key);
+		boost::shared_ptr<double> GetDouble(const string& key);
 		boost::shared_ptr<double> GetDouble(boost::shared_ptr<string> key);
-		boost::shared_ptr<string> GetUtfString(string key);
+		boost::shared_ptr<string> GetUtfString(const string& key);
 		boost::shared_ptr<string> GetUtfString(boost::shared_ptr<string> key);
-		boost::shared_ptr<string> GetText(string key);
+		boost::shared_ptr<string> GetText(const string& key);
 		boost::shared_ptr<string> GetText(boost::shared_ptr<string> key);
-		boost::shared_ptr<vector<unsigned char> > GetArray(string key);
+		boost::shared_ptr<vector<unsigned char> > GetArray(const string& key);
 		boost::shared_ptr<vector<unsigned char> > GetArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<vector<bool> > GetBoolArray(string key);
+		boost::shared_ptr<vector<bool> > GetBoolArray(const string& key);
 		boost::shared_ptr<vector<bool> > GetBoolArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<ByteArray> GetByteArray(string key);
+		boost::shared_ptr<ByteArray> GetByteArray(const string& key);
 		boost::shared_ptr<ByteArray> GetByteArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<vector<short int> > GetShortArray(string key);
+		boost::shared_ptr<vector<short int> > GetShortArray(const string& key);
 		boost::shared_ptr<vector<short int> > GetShortArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<vector<long int> > GetIntArray(string key);
+		boost::shared_ptr<vector<long int> > GetIntArray(const string& key);
 		boost::shared_ptr<vector<long int> > GetIntArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<vector<long long> > GetLongArray(string key);
+		boost::shared_ptr<vector<long long> > GetLongArray(const string& key);
 		boost::shared_ptr<vector<long long> > GetLongArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<vector<float> > GetFloatArray(string key);
+		boost::shared_ptr<vector<float> > GetFloatArray(const string& key);
 		boost::shared_ptr<vector<float> > GetFloatArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<vector<double> > GetDoubleArray(string key);
+		boost::shared_ptr<vector<double> > GetDoubleArray(const string& key);
 		boost::shared_ptr<vector<double> > GetDoubleArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<vector<string> > GetUtfStringArray(string key);
+		boost::shared_ptr<vector<string> > GetUtfStringArray(const string& key);
 		boost::shared_ptr<vector<string> > GetUtfStringArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<ISFSArray> GetSFSArray(string key);
+		boost::shared_ptr<ISFSArray> GetSFSArray(const string& key);
 		boost::shared_ptr<ISFSArray> GetSFSArray(boost::shared_ptr<string> key);
-		boost::shared_ptr<ISFSObject> GetSFSObject(string key);
+		boost::shared_ptr<ISFSObject> GetSFSObject(const string& key);
 		boost::shared_ptr<ISFSObject> GetSFSObject(boost::shared_ptr<string> key);
 
-		void PutNull(string key);
+		void PutNull(const string& key);
 		void PutNull(boost::shared_ptr<string> key);
-		void PutBool(string key, boost::shared_ptr<bool> val);
+		void PutBool(const string& key, boost::shared_ptr<bool> val);
 		void PutBool(boost::shared_ptr<string> key, boost::shared_ptr<bool> val);
-		void PutBool(string key, bool val);
+		void PutBool(const string& key, bool val);
 		void PutBool(boost::shared_ptr<string> key, bool val);
-		void PutByte(string key, boost::shared_ptr<unsigned char> val);
+		void PutByte(const string& key, boost::shared_ptr<unsigned char> val);
 		void PutByte(boost::shared_ptr<string> key, boost::shared_ptr<unsigned char> val);
-		void PutByte(string key, unsigned char val);
+		void PutByte(const string& key, unsigned char val);
 		void PutByte(boost::shared_ptr<string> key, unsigned char val);
-		void PutShort(string key, boost::shared_ptr<short int> val);
+		void PutShort(const string& key, boost::shared_ptr<short int> val);
 		void PutShort(boost::shared_ptr<string> key, boost::shared_ptr<short int> val);
-		void PutShort(string key, short int val);
+		void PutShort(const string& key, short int val);
 		void PutShort(boost::shared_ptr<string> key, short int val);
-		void PutInt(string key, boost::shared_ptr<long int> val);
+		void PutInt(const string& key, boost::shared_ptr<long int> val);
 		void PutInt(boost::shared_ptr<string> key, boost::shared_ptr<long int> val);
-		void PutInt(string key, long int val);
+		void PutInt(const string& key, long int val);
 		void PutInt(boost::shared_ptr<string> key, long int val);
-		void PutLong(string key, boost::shared_ptr<long long> val);
+		void PutLong(const string& key, boost::shared_ptr<long long> val);
 		void PutLong(boost::shared_ptr<string> key, boost::shared_ptr<long long> val);
-		void PutLong(string key, long long val);
+		void PutLong(const string& key, long long val);
 		void PutLong(boost::shared_ptr<string> key, long long val);
-		void PutFloat(string key, boost::shared_ptr<float> val);
+		void PutFloat(const string& key, boost::shared_ptr<float> val);
 		void PutFloat(boost::shared_ptr<string> key, boost::shared_ptr<float> val);
-		void PutFloat(string key, float val);
+		void PutFloat(const string& key, float val);
 		void PutFloat(boost::shared_ptr<string> key, float val);
-		void PutDouble(string key, boost::shared_ptr<double> val);
+		void PutDouble(const string& key, boost::shared_ptr<double> val);
 		void PutDouble(boost::shared_ptr<string> key, boost::shared_ptr<double> val);
-		void PutDouble(string key, double val);
+		void PutDouble(const string& key, double val);
 		void PutDouble(boost::shared_ptr<string> key, double val);
-		void PutUtfString(string key, boost::shared_ptr<string> val);
+		void PutUtfString(const string& key, boost::shared_ptr<string> val);
 		void PutUtfString(boost::shared_ptr<string> key, boost::shared_ptr<string> val);
-		void PutUtfString(string key, string val);
-		void PutUtfString(boost::shared_ptr<string> key, string val);
-		void PutText(string key, boost::shared_ptr<string> val);
+		void PutUtfString(const string& key, const string& val);
+		void PutUtfString(boost::shared_ptr<string> key, const string& val);
+		void PutText(const string& key, boost::shared_ptr<string> val);
 		void PutText(boost::shared_ptr<string> key, boost::shared_ptr<string> val);
-		void PutText(string key, string val);
-		void PutText(boost::shared_ptr<string> key, string val);
+		void PutText(const string& key, const string& val);
+		void PutText(boost::shared_ptr<string> key, const string& val);
 
-		void PutBoolArray(string key, boost::shared_ptr<vector<bool> > val);
+		void PutBoolArray(const string& key, boost::shared_ptr<vector<bool> > val);
 		void PutBoolArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<bool> > val);
-		void PutByteArray(string key, boost::shared_ptr<ByteArray> val);
+		void PutByteArray(const string& key, boost::shared_ptr<ByteArray> val);
 		void PutByteArray(boost::shared_ptr<string> key, boost::shared_ptr<ByteArray> val);
-		void PutShortArray(string key, boost::shared_ptr<vector<short int> > val);
+		void PutShortArray(const string& key, boost::shared_ptr<vector<short int> > val);
 		void PutShortArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<short int> > val);
-		void PutIntArray(string key, boost::shared_ptr<vector<long int> > val);
+		void PutIntArray(const string& key, boost::shared_ptr<vector<long int> > val);
 		void PutIntArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<long int> > val);
-		void PutLongArray(string key, boost::shared_ptr<vector<long long> > val);
+		void PutLongArray(const string& key, boost::shared_ptr<vector<long long> > val);
 		void PutLongArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<long long> > val);
-		void PutFloatArray(string key, boost::shared_ptr<vector<float> > val);
+		void PutFloatArray(const string& key, boost::shared_ptr<vector<float> > val);
 		void PutFloatArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<float> > val);
-		void PutDoubleArray(string key, boost::shared_ptr<vector<double> > val);
+		void PutDoubleArray(const string& key, boost::shared_ptr<vector<double> > val);
 		void PutDoubleArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<double> > val);
-		void PutUtfStringArray(string key, boost::shared_ptr<vector<string> > val);
+		void PutUtfStringArray(const string& key, boost::shared_ptr<vector<string> > val);
 		void PutUtfStringArray(boost::shared_ptr<string> key, boost::shared_ptr<vector<string> > val);
-		void PutSFSArray(string key, boost::shared_ptr<ISFSArray> val);
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+		void PutUtfString(const string& key, string&& val);
+		void PutText(const string& key, string&& val);
+		void PutBoolArray(const string& key, vector<bool>&& val);
+		void PutShortArray(const string& key, vector<short int>&& val);
+		void PutIntArray(const string& key, vector<long int>&& val);
+		void PutLongArray(const string& key, vector<long long>&& val);
+		void PutFloatArray(const string& key, vector<float>&& val);
+		void PutDoubleArray(const string& key, vector<double>&& val);
+		void PutUtfStringArray(const string& key, vector<string>&& val);
+#endif
+		void PutSFSArray(const string& key, boost::shared_ptr<ISFSArray> val);
 		void PutSFSArray(boost::shared_ptr<string> key, boost::shared_ptr<ISFSArray> val);
-		void PutSFSObject(string key, boost::shared_ptr<ISFSObject> val);
+		void PutSFSObject(const string& key, boost::shared_ptr<ISFSObject> val);
 		void PutSFSObject(boost::shared_ptr<string> key, boost::shared_ptr<ISFSObject> val);
 
-		void Put(string key, boost::shared_ptr<SFSDataWrapper> val);
+		void Put(const string& key, boost::shared_ptr<SFSDataWrapper> val);
 		void Put(boost::shared_ptr<string> key, boost::shared_ptr<SFSDataWrapper> val);
-		bool ContainsKey(string key);
+		bool ContainsKey(const string& key);
 		bool ContainsKey(boost::shared_ptr<string> key);
-		boost::shared_ptr<void> GetClass(string key);
+		boost::shared_ptr<void> GetClass(const string& key);
 		boost::shared_ptr<void> GetClass(boost::shared_ptr<string> key);
+
+		bool TryGetBool(const string& key, bool& value);
+		bool GetBoolOr(const string& key, bool defaultValue);
+		bool TryGetByte(const string& key, unsigned char& value);
+		unsigned char GetByteOr(const string& key, unsigned char defaultValue);
+		bool TryGetShort(const string& key, short int& value);
+		short int GetShortOr(const string& key, short int defaultValue);
+		bool TryGetInt(const string& key, long int& value);
+		long int GetIntOr(const string& key, long int defaultValue);
+		bool TryGetLong(const string& key, long long& value);
+		long long GetLongOr(const string& key, long long defaultValue);
+		bool TryGetFloat(const string& key, float& value);
+		float GetFloatOr(const string& key, float defaultValue);
+		bool TryGetDouble(const string& key, double& value);
+		double GetDoubleOr(const string& key, double defaultValue);
+		bool TryGetUtfString(const string& key, string& value);
+		string GetUtfStringOr(const string& key, const string& defaultValue);
 		boost::shared_ptr<string> GetDump(bool format); 
 		boost::shared_ptr<string> GetDump();
 		boost::shared_ptr<string> GetHexDump();
 
 		boost::shared_ptr<vector<string> > GetKeys();
 		bool IsNull(boost::shared_ptr<string> key);
-		bool IsNull(string key);
-		void PutClass(string key, boost::shared_ptr<void> val);
+		bool IsNull(const string& key);
+		void PutClass(const string& key, boost::shared_ptr<void> val);
 		void PutClass(boost::shared_ptr<string> key, boost::shared_ptr<void> val);
-        void RemoveElement(string key);
+        void RemoveElement(const string& key);
         void RemoveElement(boost::shared_ptr<string> key);
 		long int Size();
 		boost::shared_ptr<ByteArray> ToBinary();
 
+		/// <summary>
+		/// Looks up the value stored with the passed key, without copying or boxing it
+		/// </summary>
+		/// <returns>
+		/// The stored value, or NULL if the key does not exist; the pointer is valid until the object is next modified
+		/// </returns>
+		const SFSDataValue* FindValue(const string& key);
+
+		/// <summary>
+		/// Positional access to the entries, in ascending key order (the order of <see cref="GetKeys"/>)
+		/// </summary>
+		const string& KeyAt(long int index);
+		const SFSDataValue& ValueAt(long int index);
+
+		/// <summary>
+		/// Stores a value with the passed key; as for the other Put methods, an existing key is left unchanged
+		/// </summary>
+		void PutValue(const string& key, const SFSDataValue& value);
+
+		/// <summary>
+		/// Reserves room for the passed number of entries, so that filling the object does not reallocate its storage
+		/// </summary>
+		void Reserve(long int capacity);
+
 		// -------------------------------------------------------------------
 		// Public members
 		// -------------------------------------------------------------------
@@ -239,12 +323,15 @@ namespace Data {
 		// -------------------------------------------------------------------
 
 		boost::shared_ptr<string> Dump();
+		long int LowerBound(const string& key);
+		long int IndexOf(const string& key);
+		template <typename T> bool TryGetPrimitive(const string& key, T (SFSDataValue::*accessor)() const, T& value);
 
 		// -------------------------------------------------------------------
 		// Private members
 		// -------------------------------------------------------------------
 
-		boost::shared_ptr<map<string, boost::shared_ptr<SFSDataWrapper> > > dataHolder;
+		vector<SFSObjectEntry> dataHolder;				// Sorted by key; primitive values are held inline
 		boost::shared_ptr<ISFSDataSerializer> serializer;
 	};
 
@@ -1337,6 +1337,9 @@ namespace Sfs2X {
 						expr->AddDouble((boost::static_pointer_cast<double>)(varValue));
 						break;
 					}
+					default:
+						// Bool and string values are not numeric conditions
+						break;
 					}
 				}
 
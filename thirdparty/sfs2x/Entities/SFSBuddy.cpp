@@ -22,9 +22,9 @@ boost::shared_ptr<Buddy> SFSBuddy::FromSFSArray(boost::shared_ptr<ISFSArray> arr
 {
 	boost::shared_ptr<Buddy> buddy (new SFSBuddy (
 		arr->GetInt(0), 									// id
-		*(arr->GetUtfString(1)), 							// name
+		arr->GetUtfStringOr(1, string()),						// name
 		arr->GetBool(2),									// blocked
-		arr->Size() > 4 ? arr->GetBool(4) : false			// isTemp is optional, we have to check
+		arr->GetBoolOr(4, false)							// isTemp is optional
 		));
 
 	boost::shared_ptr<ISFSArray> bVarsData = arr->GetSFSArray(3); // variables data array
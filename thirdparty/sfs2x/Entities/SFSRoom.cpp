@@ -28,9 +28,9 @@ boost::shared_ptr<Room> SFSRoom::FromSFSArray(boost::shared_ptr<ISFSArray> sfsa)
 	boost::shared_ptr<Room> newRoom = boost::shared_ptr<Room>();
 
 	if (isMMORoom)
-		newRoom = boost::shared_ptr<Room>(new MMORoom(sfsa->GetInt(0), *(sfsa->GetUtfString(1)), *(sfsa->GetUtfString(2))));
+		newRoom = boost::shared_ptr<Room>(new MMORoom(sfsa->GetInt(0), sfsa->GetUtfStringOr(1, string()), sfsa->GetUtfStringOr(2, string())));
 	else
-		newRoom = boost::shared_ptr<Room>(new SFSRoom(sfsa->GetInt(0), *(sfsa->GetUtfString(1)), *(sfsa->GetUtfString(2))));
+		newRoom = boost::shared_ptr<Room>(new SFSRoom(sfsa->GetInt(0), sfsa->GetUtfStringOr(1, string()), sfsa->GetUtfStringOr(2, string())));
 		
 	newRoom->IsGame(sfsa->GetBool(3));
 	newRoom->IsHidden(sfsa->GetBool(4));
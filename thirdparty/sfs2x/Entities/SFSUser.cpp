@@ -21,7 +21,7 @@ namespace Entities {
 boost::shared_ptr<User> SFSUser::FromSFSArray(boost::shared_ptr<ISFSArray> sfsa, boost::shared_ptr<Room> room)
 {
 	// Pass id and name
-	boost::shared_ptr<User> newUser (new SFSUser(sfsa->GetInt(0), *(sfsa->GetUtfString(1))));
+	boost::shared_ptr<User> newUser (new SFSUser(sfsa->GetInt(0), sfsa->GetUtfStringOr(1, string())));
 
 	// Set privileges
 	newUser->PrivilegeId(sfsa->GetShort(2));
@@ -459,7 +459,7 @@ void SFSUser::Properties(boost::shared_ptr<map<string, boost::shared_ptr<void> >
 boost::shared_ptr<string> SFSUser::ToString()
 {
 	char buffer[512];
-	sprintf (buffer, "[User: %s, Id: %ld, isMe: %ld]", name->c_str(), id, isItMe);
+	sprintf (buffer, "[User: %s, Id: %ld, isMe: %d]", name->c_str(), id, (int)isItMe);
 
 	return boost::shared_ptr<string>(new string(buffer));
 }
@@ -20,7 +20,7 @@ namespace Variables {
 boost::shared_ptr<RoomVariable> SFSRoomVariable::FromSFSArray(boost::shared_ptr<ISFSArray> sfsa)
 {
 	boost::shared_ptr<RoomVariable> variable (new SFSRoomVariable (
-		*(sfsa->GetUtfString(0)), 	// name
+		sfsa->GetUtfStringOr(0, string()), 	// name
 		sfsa->GetElementAt(2),		// typed value
 		sfsa->GetByte(1)			// type id
 	));
@@ -21,14 +21,15 @@ namespace Variables {
 boost::shared_ptr<UserVariable> SFSUserVariable::FromSFSArray(boost::shared_ptr<ISFSArray> sfsa)
 {
 	boost::shared_ptr<UserVariable> variable(new SFSUserVariable(
-									 *(sfsa->GetUtfString(0)), 	// name
+									 sfsa->GetUtfStringOr(0, string()), 	// name
 									 sfsa->GetElementAt(2),		// typed value
 									 sfsa->GetByte(1)			// type id
 									 ));
 
 	// Since SFS v2.12.0 we're getting a new element at position #3
-	if (sfsa->Size() > 3)
-		variable->IsPrivate(sfsa->GetBool(3));	// 'private' flag
+	bool isPrivate;
+	if (sfsa->TryGetBool(3, isPrivate))
+		variable->IsPrivate(isPrivate);			// 'private' flag
 
 	return variable;
 }
@@ -0,0 +1,106 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of StateTable
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __StateTable__
+#define __StateTable__
+
+namespace Sfs2X {
+namespace FSM {
+
+	// -------------------------------------------------------------------
+	// Class StateTable
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// State machine whose transitions are a constant table indexed by state and transition
+	/// </summary>
+	///
+	/// <remarks>
+	/// Each cell of the table holds the state reached by applying a transition to a state; a transition that does not apply
+	/// to a state holds that same state, so it leaves the machine unchanged as <see cref="FiniteStateMachine"/> does.
+	/// <br/>
+	/// Reading and changing the state take no lock: the owner must apply the transitions from one thread at a time.
+	/// <see cref="FiniteStateMachine"/> remains available for machines whose states are defined at runtime.
+	/// </remarks>
+	template <typename TState, typename TTransition, int STATES, int TRANSITIONS>
+	class StateTable
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public types
+		// -------------------------------------------------------------------
+
+		typedef TState Table[STATES][TRANSITIONS];
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		// Constructor
+		//		table			Transition table, usually a static constant of the owner
+		//		initialState	State of the machine before any transition
+		StateTable(const Table& table, TState initialState);
+
+		TState ApplyTransition(TTransition tr);
+		TState GetCurrentState() const;
+		void SetCurrentState(TState state);
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		const Table& table;
+		volatile TState currentState;
+	};
+
+	// -------------------------------------------------------------------
+	// Constructor
+	// -------------------------------------------------------------------
+	template <typename TState, typename TTransition, int STATES, int TRANSITIONS>
+	inline StateTable<TState, TTransition, STATES, TRANSITIONS>::StateTable(const Table& table, TState initialState)
+		: table(table)
+	{
+		currentState = initialState;
+	}
+
+	// -------------------------------------------------------------------
+	// ApplyTransition
+	// -------------------------------------------------------------------
+	template <typename TState, typename TTransition, int STATES, int TRANSITIONS>
+	inline TState StateTable<TState, TTransition, STATES, TRANSITIONS>::ApplyTransition(TTransition tr)
+	{
+		currentState = table[currentState][tr];
+		return currentState;
+	}
+
+	// -------------------------------------------------------------------
+	// GetCurrentState
+	// -------------------------------------------------------------------
+	template <typename TState, typename TTransition, int STATES, int TRANSITIONS>
+	inline TState StateTable<TState, TTransition, STATES, TRANSITIONS>::GetCurrentState() const
+	{
+		return currentState;
+	}
+
+	// -------------------------------------------------------------------
+	// SetCurrentState
+	// -------------------------------------------------------------------
+	template <typename TState, typename TTransition, int STATES, int TRANSITIONS>
+	inline void StateTable<TState, TTransition, STATES, TRANSITIONS>::SetCurrentState(TState state)
+	{
+		currentState = state;
+	}
+
+}	// namespace FSM
+}	// namespace Sfs2X
+
+#endif
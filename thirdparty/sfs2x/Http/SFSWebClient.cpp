@@ -44,7 +44,7 @@ void SFSWebClient::UploadValuesAsync (boost::shared_ptr<string> uriHost, unsigne
 		boost::shared_ptr<IPAddress> address(new IPAddress(*uriHost));
 		client->SynchConnect(address, uriPort);
 	}
-	catch (exception e) {
+	catch (const exception& e) {
 		boost::shared_ptr<string> messageException (new string(e.what()));
 		boost::shared_ptr<string> message (new string("Http error creating http connection: " + (*messageException)));
 
@@ -53,7 +53,7 @@ void SFSWebClient::UploadValuesAsync (boost::shared_ptr<string> uriHost, unsigne
 		try {
 			client->Shutdown();
 		}
-		catch (exception e) {
+		catch (const exception& e) {
 			boost::shared_ptr<string> messageException (new string(e.what()));
 			boost::shared_ptr<string> message (new string("Error during http scocket shutdown: " + (*messageException)));
 
@@ -153,7 +153,7 @@ void SFSWebClient::UploadValuesAsync (boost::shared_ptr<string> uriHost, unsigne
 		boost::shared_ptr<string> payload (new string(dataPayload));
 		OnHttpResponse()->Invoke(false, payload);
 	}
-	catch (exception e) {
+	catch (const exception& e) {
 		boost::shared_ptr<string> messageException (new string(e.what()));
 		boost::shared_ptr<string> message (new string("Error during http request: " + (*messageException)));
 
@@ -163,7 +163,7 @@ void SFSWebClient::UploadValuesAsync (boost::shared_ptr<string> uriHost, unsigne
 	try {
 		client->Shutdown();
 	}
-	catch (exception e) {
+	catch (const exception& e) {
 		boost::shared_ptr<string> messageException (new string(e.what()));
 		boost::shared_ptr<string> message (new string("Error during http scocket shutdown: " + (*messageException)));
 
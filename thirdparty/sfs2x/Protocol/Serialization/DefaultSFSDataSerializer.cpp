@@ -64,25 +64,19 @@ boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::Object2Binary(boost::shar
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::Obj2bin(boost::shared_ptr<ISFSObject> obj, boost::shared_ptr<ByteArray> buffer)
 {
-	boost::shared_ptr<vector<string> > keys = obj->GetKeys();
-	boost::shared_ptr<SFSDataWrapper> wrapper;
+	// Entries are read in place, in key order, without copying keys or boxing primitive values
+	boost::shared_ptr<SFSObject> sfsObject = (boost::static_pointer_cast<SFSObject>)(obj);
 
-	vector<string>::iterator iterator;
-	for(iterator = keys->begin(); iterator != keys->end(); ++iterator)
+	long int size = sfsObject->Size();
+	for (long int i = 0; i < size; i++)
 	{
-		boost::shared_ptr<string> key (new string(*iterator));
-
-		wrapper = obj->GetData(*key);
-
 		// Store the key
-		buffer = EncodeSFSObjectKey(buffer, key);
+		buffer->WriteUTF(sfsObject->KeyAt(i));
 																
 		// Convert 2 binary
-		buffer = EncodeObject(buffer, wrapper->Type(), wrapper->Data());
+		EncodeValue(buffer, sfsObject->ValueAt(i));
 	}
 
-	keys->clear();
-
 	return buffer;
 }
 
@@ -101,12 +95,13 @@ boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::Array2Binary(boost::share
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::Arr2bin(boost::shared_ptr<ISFSArray> arrayobj, boost::shared_ptr<ByteArray> buffer)
 {
-	boost::shared_ptr<SFSDataWrapper> wrapper;
+	// Elements are read by value, so typed columns are encoded without boxing
+	boost::shared_ptr<SFSArray> sfsArray = (boost::static_pointer_cast<SFSArray>)(arrayobj);
 
-	for (int i = 0; i < arrayobj->Size(); i++)	
+	long int size = sfsArray->Size();
+	for (long int i = 0; i < size; i++)	
 	{
-		wrapper = arrayobj->GetWrappedElementAt(i);
-		buffer = EncodeObject(buffer, wrapper->Type(), wrapper->Data());
+		EncodeValue(buffer, sfsArray->ValueAt(i));
 	}
 			
 	return buffer;
@@ -117,6 +112,11 @@ boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::Arr2bin(boost::shared_ptr
 // Binary ==> SFSObject
 
 boost::shared_ptr<ISFSObject> DefaultSFSDataSerializer::Binary2Object(boost::shared_ptr<ByteArray> data)
+{
+	return Binary2Object(data, boost::shared_ptr<PacketArena>());
+}
+
+boost::shared_ptr<ISFSObject> DefaultSFSDataSerializer::Binary2Object(boost::shared_ptr<ByteArray> data, boost::shared_ptr<PacketArena> arena)
 {
 	if (data->Length() < 3) 
 	{
@@ -129,86 +129,46 @@ boost::shared_ptr<ISFSObject> DefaultSFSDataSerializer::Binary2Object(boost::sha
 		throw exception;
 	}
 			
+	// The whole structure is validated once, then decoded without checks
 	data->Position(0);
-	return DecodeSFSObject(data);
+	ByteReader reader = data->Reader(data->Length());
+
+	ByteReader validator = reader;
+	ValidateSFSObject(validator);
+
+	boost::shared_ptr<ISFSObject> decoded = DecodeSFSObject(reader, arena);
+	data->Position(reader.Position());
+
+	return decoded;
 }
 
-boost::shared_ptr<ISFSObject> DefaultSFSDataSerializer::DecodeSFSObject(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<ISFSObject> DefaultSFSDataSerializer::DecodeSFSObject(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	boost::shared_ptr<SFSObject> sfsObject (SFSObject::NewInstance());
-						
-	// Get tpyeId
-	unsigned char headerByte;
-	buffer->ReadByte(headerByte);
+	boost::shared_ptr<SFSObject> sfsObject = PacketArena::New<SFSObject>(arena);
 						
-	// Validate typeId
-	if (headerByte != (unsigned char)SFSDATATYPE_SFS_OBJECT) 
-	{
-		boost::shared_ptr<string> err (new string());
-
-		boost::shared_ptr<string> format (new string("Invalid SFSDataType. Expected: %d, found: %d"));
-		StringFormatter<long int, unsigned char> (err, format, SFSDATATYPE_SFS_OBJECT, headerByte);
-
-		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
-		throw exception;
-	}
+	// Skip tpyeId, already validated
+	reader.Skip(1);
 	
 	short int size;
-	buffer->ReadShort(size);
+	reader.ReadShort(size);
 			
-	// Validate size
-	if (size < 0) 
-	{
-		boost::shared_ptr<string> err (new string());
-
-		boost::shared_ptr<string> format (new string("Can't decode SFSObject. Size is negative: %d"));
-		StringFormatter<long int> (err, format, size);
-
-		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
-		throw exception;
-	}		
+	sfsObject->Reserve(size);
 			
-	/*
-     * NOTE: we catch codec exceptions OUTSIDE of the loop
-     * meaning that any exception of that type will stop the process of looping through the
-     * object data and immediately discard the whole packet of data. 
-     */
+	// The key is only read here: the object stores its interned atom
+	string key;
 
-	try 
+	for (int i = 0; i < size; i++) 
 	{
-		for (int i = 0; i < size; i++) 
-		{
-			// Decode object key
-	     	string key;
-			buffer->ReadUTF(key);
+		// Decode object key
+		reader.ReadUTF(key);
 		     		
-			//Console.WriteLine("Decoding object "+key);
-					
-	     	// Decode the next object
-	     	boost::shared_ptr<SFSDataWrapper> decodedObject = DecodeObject(buffer);
+		// Decode the next object, primitive values are kept inline
+		SFSDataValue value;
+		DecodeValue(reader, value, arena);
 		     		
-	     	// Store decoded object and keep going
-	     	if (decodedObject != NULL) 
-			{
-				boost::shared_ptr<string> keyRef (new string(key));
-	     		sfsObject->Put(keyRef, decodedObject);
-			}		
-	     	else 
-			{
-				boost::shared_ptr<string> err (new string());
-
-				boost::shared_ptr<string> format (new string("Could not decode value for SFSObject with key: %s"));
-				StringFormatter<const char*> (err, format, key.c_str());
-
-				boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
-				throw exception;
-			}
-	    }	
-	}
-	catch (SFSCodecError err) 
-	{
-		throw err;
-	}
+		// Store decoded object and keep going
+		sfsObject->PutValue(key, value);
+	}	
 		
 	return sfsObject;
 }
@@ -218,6 +178,11 @@ boost::shared_ptr<ISFSObject> DefaultSFSDataSerializer::DecodeSFSObject(boost::s
 // Binary ==> SFSArray
 
 boost::shared_ptr<ISFSArray> DefaultSFSDataSerializer::Binary2Array(boost::shared_ptr<ByteArray> data)
+{
+	return Binary2Array(data, boost::shared_ptr<PacketArena>());
+}
+
+boost::shared_ptr<ISFSArray> DefaultSFSDataSerializer::Binary2Array(boost::shared_ptr<ByteArray> data, boost::shared_ptr<PacketArena> arena)
 {
 	if (data->Length() < 3) 
 	{
@@ -230,142 +195,105 @@ boost::shared_ptr<ISFSArray> DefaultSFSDataSerializer::Binary2Array(boost::share
 		throw exception;
 	}
 			
+	// The whole structure is validated once, then decoded without checks
 	data->Position(0);
-	return DecodeSFSArray(data);
+	ByteReader reader = data->Reader(data->Length());
+
+	ByteReader validator = reader;
+	ValidateSFSArray(validator);
+
+	boost::shared_ptr<ISFSArray> decoded = DecodeSFSArray(reader, arena);
+	data->Position(reader.Position());
+
+	return decoded;
 }
 
-boost::shared_ptr<ISFSArray> DefaultSFSDataSerializer::DecodeSFSArray(boost::shared_ptr<ByteArray> buffer)
+void DefaultSFSDataSerializer::SkipValue(ByteReader& reader)
 {
-	boost::shared_ptr<ISFSArray> sfsArray (SFSArray::NewInstance());
-
-	// Get tpyeId
-	unsigned char type;
-	buffer->ReadByte(type);
-	SFSDataType headerType = (SFSDataType)(long int)(type);
-			
-	// Validate typeId
-	if (headerType != SFSDATATYPE_SFS_ARRAY) 
-	{
-		boost::shared_ptr<string> err (new string());
+	ValidateValue(reader);
+}
 
-		boost::shared_ptr<string> format (new string("Invalid SFSDataType. Expected: %d, found: %d"));
-		StringFormatter<long int, long int> (err, format, SFSDATATYPE_SFS_ARRAY, headerType);
+boost::shared_ptr<ISFSArray> DefaultSFSDataSerializer::DecodeSFSArray(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
+{
+	boost::shared_ptr<SFSArray> sfsArray = PacketArena::New<SFSArray>(arena);
 
-		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
-		throw exception;
-	}
+	// Skip tpyeId, already validated
+	reader.Skip(1);
 				
 	short int size;
-	buffer->ReadShort(size);
+	reader.ReadShort(size);
 			
-	// Validate size
-	if (size < 0) 
+	for (long int i = 0; i < size; i++) 
 	{
-		boost::shared_ptr<string> err (new string());
+		// Decode the next object, homogeneous primitive items end up in a typed column
+		SFSDataValue value;
+		DecodeValue(reader, value, arena);
 
-		boost::shared_ptr<string> format (new string("Can't decode SFSArray. Size is negative: %d"));
-		StringFormatter<long int> (err, format, size);
-
-		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
-		throw exception;
-	}
-				
-	/*
-	 * NOTE: we catch codec exceptions OUTSIDE of the loop
-	 * meaning that any exception of that type will stop the process of looping through the
-	 * object data and immediately discard the whole packet of data. 
-	 */
-
-	try
-	{
-		for (long int i = 0; i < size; i++) 
-		{
-			// Decode the next object
-		    boost::shared_ptr<SFSDataWrapper> decodedObject = DecodeObject(buffer);
-
-		     // Store decoded object and keep going
-		     if (decodedObject != NULL) 
-			 {
-				sfsArray->Add(decodedObject);
-			}
-		    else 
-			{
-				boost::shared_ptr<string> err (new string());
-
-				boost::shared_ptr<string> format (new string("Could not decode SFSArray item at index: %d"));
-				StringFormatter<long int> (err, format, i);
-
-				boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
-				throw exception;
-			}
-		}	
-	}
-	catch (SFSCodecError err)
-	{
-		throw err;
-	}
+		// Store decoded object and keep going
+		sfsArray->AddValue(value);
+	}	
 		     
 	return sfsArray;
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::DecodeObject(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::DecodeObject(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
 	boost::shared_ptr<SFSDataWrapper> decodedObject;
 	unsigned char headerValue;
-	buffer->ReadByte(headerValue);
+	reader.ReadByte(headerValue);
 	SFSDataType headerByte = (SFSDataType)(long int)(headerValue);
 			
 	// Console.WriteLine(headerByte);
 	if (headerByte == SFSDATATYPE_NULL)
-	 	decodedObject = BinDecode_NULL(buffer);
+		decodedObject = BinDecode_NULL(reader);
 	else if (headerByte == SFSDATATYPE_BOOL)
-		decodedObject = BinDecode_BOOL(buffer);
+		decodedObject = BinDecode_BOOL(reader);
 	else if (headerByte == SFSDATATYPE_BOOL_ARRAY)
-		decodedObject = BinDecode_BOOL_ARRAY(buffer);
+		decodedObject = BinDecode_BOOL_ARRAY(reader, arena);
 	else if (headerByte == SFSDATATYPE_BYTE)
-		decodedObject = BinDecode_BYTE(buffer);
+		decodedObject = BinDecode_BYTE(reader);
 	else if (headerByte == SFSDATATYPE_BYTE_ARRAY)
-		decodedObject = BinDecode_BYTE_ARRAY(buffer);
+		decodedObject = BinDecode_BYTE_ARRAY(reader, arena);
 	else if (headerByte == SFSDATATYPE_SHORT)
-		decodedObject = BinDecode_SHORT(buffer);
+		decodedObject = BinDecode_SHORT(reader);
 	else if (headerByte == SFSDATATYPE_SHORT_ARRAY)
-		decodedObject = BinDecode_SHORT_ARRAY(buffer);
+		decodedObject = BinDecode_SHORT_ARRAY(reader, arena);
 	else if (headerByte == SFSDATATYPE_INT)
-		decodedObject = BinDecode_INT(buffer);
+		decodedObject = BinDecode_INT(reader);
 	else if (headerByte == SFSDATATYPE_INT_ARRAY)
-		decodedObject = BinDecode_INT_ARRAY(buffer);
+		decodedObject = BinDecode_INT_ARRAY(reader, arena);
 	else if (headerByte == SFSDATATYPE_LONG)
-		decodedObject = BinDecode_LONG(buffer);
+		decodedObject = BinDecode_LONG(reader);
 	else if (headerByte == SFSDATATYPE_LONG_ARRAY)
-		decodedObject = BinDecode_LONG_ARRAY(buffer);
+		decodedObject = BinDecode_LONG_ARRAY(reader, arena);
 	else if (headerByte == SFSDATATYPE_FLOAT)
-		decodedObject = BinDecode_FLOAT(buffer);
+		decodedObject = BinDecode_FLOAT(reader);
 	else if (headerByte == SFSDATATYPE_FLOAT_ARRAY)
-		decodedObject = BinDecode_FLOAT_ARRAY(buffer);
+		decodedObject = BinDecode_FLOAT_ARRAY(reader, arena);
 	else if (headerByte == SFSDATATYPE_DOUBLE)
-		decodedObject = BinDecode_DOUBLE(buffer);
+		decodedObject = BinDecode_DOUBLE(reader);
 	else if (headerByte == SFSDATATYPE_DOUBLE_ARRAY)
-		decodedObject = BinDecode_DOUBLE_ARRAY(buffer);
+		decodedObject = BinDecode_DOUBLE_ARRAY(reader, arena);
 	else if (headerByte == SFSDATATYPE_UTF_STRING)
-		decodedObject = BinDecode_UTF_STRING(buffer);
+		decodedObject = BinDecode_UTF_STRING(reader, arena);
 	else if (headerByte == SFSDATATYPE_TEXT)
-		decodedObject = BinDecode_TEXT(buffer);
+		decodedObject = BinDecode_TEXT(reader, arena);
 	else if (headerByte == SFSDATATYPE_UTF_STRING_ARRAY)
-		decodedObject = BinDecode_UTF_STRING_ARRAY(buffer);
+		decodedObject = BinDecode_UTF_STRING_ARRAY(reader, arena);
 	else if (headerByte == SFSDATATYPE_SFS_ARRAY) {
 		// pointer goes back 1 position
-		buffer->Position(buffer->Position() - 1);
-		decodedObject = boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper((long int)SFSDATATYPE_SFS_ARRAY, DecodeSFSArray(buffer)));
+		reader.Skip(-1);
+		decodedObject = boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper((long int)SFSDATATYPE_SFS_ARRAY, DecodeSFSArray(reader, arena)));
 	}
 	else if (headerByte == SFSDATATYPE_SFS_OBJECT)
 	{
 		// pointer goes back 1 position
-		buffer->Position(buffer->Position() - 1);
+		reader.Skip(-1);
 				
 		/*
 		* See if this is a special type of SFSObject, the one that actually describes a Class
 		*/
-		boost::shared_ptr<ISFSObject> sfsObj = DecodeSFSObject(buffer);
+		boost::shared_ptr<ISFSObject> sfsObj = DecodeSFSObject(reader, arena);
 		unsigned char type = (unsigned char)((long int)SFSDATATYPE_SFS_OBJECT);
 		boost::shared_ptr<void> finalSfsObj = sfsObj;
 				
@@ -376,17 +304,6 @@ boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::DecodeObject(boost::
 				
 		decodedObject = boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(type, finalSfsObj));
 	}
-	// What is this typeID??
-	else 
-	{
-		boost::shared_ptr<string> err (new string());
-
-		boost::shared_ptr<string> format (new string("Unknow SFSDataType ID: %d"));
-		StringFormatter<long int> (err, format, headerByte);
-
-		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
-		throw exception;
-	}
 			
 	return decodedObject;
 }
@@ -435,7 +352,7 @@ boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::EncodeObject(boost::share
 		buffer = BinEncode_SHORT_ARRAY(buffer, (boost::static_pointer_cast<vector<short int> >)(data));
 		break;
 	case SFSDATATYPE_INT_ARRAY:
-		buffer = BinEncode_INT_ARRAY(buffer, (boost::static_pointer_cast<vector<boost::int32_t> >)(data));
+		buffer = BinEncode_INT_ARRAY(buffer, (boost::static_pointer_cast<vector<long int> >)(data));
 		break;
 	case SFSDATATYPE_LONG_ARRAY:
 		buffer = BinEncode_LONG_ARRAY(buffer, (boost::static_pointer_cast<vector<long long> >)(data));
@@ -450,14 +367,22 @@ boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::EncodeObject(boost::share
 		buffer = BinEncode_UTF_STRING_ARRAY(buffer, (boost::static_pointer_cast<vector<string> >)(data));
 		break;
 	case SFSDATATYPE_SFS_ARRAY:
-		buffer = AddData(buffer, Array2Binary((boost::static_pointer_cast<ISFSArray>)(data)));
-		break;
+		{
+			boost::shared_ptr<ISFSArray> arrayobj = (boost::static_pointer_cast<ISFSArray>)(data);
+			buffer->WriteByte((unsigned char)SFSDATATYPE_SFS_ARRAY);
+			buffer->WriteShort((short int)arrayobj->Size());
+			buffer = Arr2bin(arrayobj, buffer);
+			break;
+		}
 	case SFSDATATYPE_SFS_OBJECT:
-		buffer = AddData(buffer, Object2Binary((boost::static_pointer_cast<SFSObject>)(data)));
-		break;
 	case SFSDATATYPE_CLASS:
-		buffer = AddData(buffer, Object2Binary((boost::static_pointer_cast<SFSObject>)(data)));
-		break;
+		{
+			boost::shared_ptr<ISFSObject> sfsObject = (boost::static_pointer_cast<SFSObject>)(data);
+			buffer->WriteByte((unsigned char)SFSDATATYPE_SFS_OBJECT);
+			buffer->WriteShort((short int)sfsObject->Size());
+			buffer = Obj2bin(sfsObject, buffer);
+			break;
+		}
 	default:
 		{
 			boost::shared_ptr<string> err (new string());
@@ -473,214 +398,577 @@ boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::EncodeObject(boost::share
 	return buffer;
 }
 
+void DefaultSFSDataSerializer::DecodeValue(ByteReader& reader, SFSDataValue& value, boost::shared_ptr<PacketArena> arena)
+{
+	unsigned char headerValue;
+	reader.ReadByte(headerValue);
+	SFSDataType headerByte = (SFSDataType)(long int)(headerValue);
+
+	switch (headerByte)
+	{
+	case SFSDATATYPE_NULL:
+		value.SetNull();
+		break;
+	case SFSDATATYPE_BOOL:
+		{
+			bool readValue;
+			reader.ReadBool(readValue);
+			value.SetBool(readValue);
+			break;
+		}
+	case SFSDATATYPE_BYTE:
+		{
+			unsigned char readValue;
+			reader.ReadByte(readValue);
+			value.SetByte(readValue);
+			break;
+		}
+	case SFSDATATYPE_SHORT:
+		{
+			short int readValue;
+			reader.ReadShort(readValue);
+			value.SetShort(readValue);
+			break;
+		}
+	case SFSDATATYPE_INT:
+		{
+			boost::int32_t readValue;
+			reader.ReadInt(readValue);
+			value.SetInt(readValue);
+			break;
+		}
+	case SFSDATATYPE_LONG:
+		{
+			long long readValue;
+			reader.ReadLong(readValue);
+			value.SetLong(readValue);
+			break;
+		}
+	case SFSDATATYPE_FLOAT:
+		{
+			float readValue;
+			reader.ReadFloat(readValue);
+			value.SetFloat(readValue);
+			break;
+		}
+	case SFSDATATYPE_DOUBLE:
+		{
+			double readValue;
+			reader.ReadDouble(readValue);
+			value.SetDouble(readValue);
+			break;
+		}
+	case SFSDATATYPE_UTF_STRING:
+		{
+			boost::shared_ptr<string> readValue = PacketArena::New<string>(arena);
+			reader.ReadUTF(*readValue);
+			value.SetData(SFSDATATYPE_UTF_STRING, readValue);
+			break;
+		}
+	case SFSDATATYPE_SFS_ARRAY:
+		{
+			// pointer goes back 1 position
+			reader.Skip(-1);
+			value.SetData(SFSDATATYPE_SFS_ARRAY, DecodeSFSArray(reader, arena));
+			break;
+		}
+	case SFSDATATYPE_SFS_OBJECT:
+		{
+			// pointer goes back 1 position
+			reader.Skip(-1);
+			boost::shared_ptr<ISFSObject> sfsObj = DecodeSFSObject(reader, arena);
+
+			// See if this is a special type of SFSObject, the one that actually describes a Class
+			if (sfsObj->ContainsKey(CLASS_MARKER_KEY) && sfsObj->ContainsKey(CLASS_FIELDS_KEY)) 
+			{
+				value.SetData(SFSDATATYPE_CLASS, sfsObj);
+			}
+			else
+			{
+				value.SetData(SFSDATATYPE_SFS_OBJECT, sfsObj);
+			}
+
+			break;
+		}
+	default:
+		{
+			// Typed arrays and texts: pointer goes back 1 position and the value is decoded as usual
+			reader.Skip(-1);
+			boost::shared_ptr<SFSDataWrapper> decodedObject = DecodeObject(reader, arena);
+			value.SetData(decodedObject->Type(), decodedObject->Data());
+			break;
+		}
+	}
+}
+
+void DefaultSFSDataSerializer::EncodeValue(boost::shared_ptr<ByteArray> buffer, const SFSDataValue& value)
+{
+	switch ((SFSDataType)value.Type())
+	{
+	case SFSDATATYPE_NULL:
+		buffer->WriteByte((unsigned char)0x00);
+		break;
+	case SFSDATATYPE_BOOL:
+		buffer->WriteByte(SFSDATATYPE_BOOL);
+		buffer->WriteBool(value.BoolValue());
+		break;
+	case SFSDATATYPE_BYTE:
+		buffer->WriteByte(SFSDATATYPE_BYTE);
+		buffer->WriteByte(value.ByteValue());
+		break;
+	case SFSDATATYPE_SHORT:
+		buffer->WriteByte(SFSDATATYPE_SHORT);
+		buffer->WriteShort(value.ShortValue());
+		break;
+	case SFSDATATYPE_INT:
+		buffer->WriteByte(SFSDATATYPE_INT);
+		buffer->WriteInt((boost::int32_t)value.IntValue());
+		break;
+	case SFSDATATYPE_LONG:
+		buffer->WriteByte(SFSDATATYPE_LONG);
+		buffer->WriteLong(value.LongValue());
+		break;
+	case SFSDATATYPE_FLOAT:
+		buffer->WriteByte(SFSDATATYPE_FLOAT);
+		buffer->WriteFloat(value.FloatValue());
+		break;
+	case SFSDATATYPE_DOUBLE:
+		buffer->WriteByte(SFSDATATYPE_DOUBLE);
+		buffer->WriteDouble(value.DoubleValue());
+		break;
+	case SFSDATATYPE_UTF_STRING:
+		buffer->WriteByte(SFSDATATYPE_UTF_STRING);
+		buffer->WriteUTF((boost::static_pointer_cast<string>)(value.Data()));
+		break;
+	default:
+		EncodeObject(buffer, value.Type(), value.Data());
+		break;
+	}
+}
+
 
 
 // Binary Entities Decoding Methods
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_NULL(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_NULL(ByteReader& reader)
 {
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_NULL, boost::shared_ptr<void>()));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_BOOL(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_BOOL(ByteReader& reader)
 {
 	boost::shared_ptr<bool> value (new bool());
-	buffer->ReadBool(*value);
+	reader.ReadBool(*value);
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_BOOL, (boost::static_pointer_cast<void>)(value)));
 }
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_BYTE(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_BYTE(ByteReader& reader)
 {
 	boost::shared_ptr<unsigned char> value (new unsigned char());
-	buffer->ReadByte(*value);
+	reader.ReadByte(*value);
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_BYTE, (boost::static_pointer_cast<void>)(value)));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_SHORT(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_SHORT(ByteReader& reader)
 {
 	boost::shared_ptr<short int> value (new short int());
-	buffer->ReadShort(*value);
+	reader.ReadShort(*value);
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_SHORT, (boost::static_pointer_cast<void>)(value)));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_INT(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_INT(ByteReader& reader)
 {
-	boost::shared_ptr<boost::int32_t> value (new boost::int32_t());
-	buffer->ReadInt(*value);
+	// Stored as long int, the type returned by ISFSObject::GetInt and used by INT_ARRAY
+	boost::int32_t readValue;
+	reader.ReadInt(readValue);
+	boost::shared_ptr<long int> value (new long int(readValue));
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_INT, (boost::static_pointer_cast<void>)(value)));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_LONG(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_LONG(ByteReader& reader)
 {
 	boost::shared_ptr<long long> value (new long long());
-	buffer->ReadLong(*value);
+	reader.ReadLong(*value);
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_LONG, (boost::static_pointer_cast<void>)(value)));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_FLOAT(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_FLOAT(ByteReader& reader)
 {
 	boost::shared_ptr<float> value (new float());
-	buffer->ReadFloat(*value);
+	reader.ReadFloat(*value);
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_FLOAT, (boost::static_pointer_cast<void>)(value)));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_DOUBLE(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_DOUBLE(ByteReader& reader)
 {
 	boost::shared_ptr<double> value (new double());
-	buffer->ReadDouble(*value);
+	reader.ReadDouble(*value);
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_DOUBLE, (boost::static_pointer_cast<void>)(value)));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_UTF_STRING(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_UTF_STRING(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	boost::shared_ptr<string> value (new string()); 
-	buffer->ReadUTF(*value);
+	boost::shared_ptr<string> value = PacketArena::New<string>(arena);
+	reader.ReadUTF(*value);
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_UTF_STRING, (boost::static_pointer_cast<void>)(value)));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_TEXT(boost::shared_ptr<ByteArray> buffer) 
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_TEXT(ByteReader& reader, boost::shared_ptr<PacketArena> arena) 
 {
-	boost::shared_ptr<string> value(new string());
-	buffer->ReadText(*value);
+	boost::shared_ptr<string> value = PacketArena::New<string>(arena);
+	reader.ReadText(*value);
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_UTF_STRING, (boost::static_pointer_cast<void>)(value)));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_BOOL_ARRAY(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_BOOL_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	long int size = GetTypedArraySize(buffer);
-	boost::shared_ptr<vector<bool> > arrayobj (new vector<bool>());
+	long int size = GetTypedArraySize(reader);
+	boost::shared_ptr<vector<bool> > arrayobj = PacketArena::New<vector<bool> >(arena);
+	arrayobj->reserve(size);
 			
 	for (int j = 0; j < size; j++) 
 	{
-		boost::shared_ptr<bool> value (new bool);
-		buffer->ReadBool(*value);
-		arrayobj->push_back(*value);
+		bool value;
+		reader.ReadBool(value);
+		arrayobj->push_back(value);
 	}
 			
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_BOOL_ARRAY, arrayobj));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_BYTE_ARRAY(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_BYTE_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
 	boost::int32_t size;
-	buffer->ReadInt(size);
-			
-	if (size < 0) 
-	{
-		boost::shared_ptr<string> err (new string());
-		 
-		boost::shared_ptr<string> format (new string("Array negative size: %d"));
-		StringFormatter<boost::int32_t> (err, format, size);
-
-		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
-		throw exception;
-	}
+	reader.ReadInt(size);
 	
-	// copy bytes
+	// copy bytes once, straight into the storage of the returned array
 	boost::shared_ptr<vector<unsigned char> > values (new vector<unsigned char>());
-	buffer->ReadBytes(size, *values.get());
-	boost::shared_ptr<ByteArray> arrayobj (new ByteArray());
-	arrayobj->WriteBytes(values);
+	reader.ReadBytes(size, *values.get());
+	boost::shared_ptr<ByteArray> arrayobj = PacketArena::New<ByteArray>(arena, values);
 						
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_BYTE_ARRAY, arrayobj));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_SHORT_ARRAY(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_SHORT_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	boost::int32_t size = GetTypedArraySize(buffer);
-	boost::shared_ptr<vector<short int> > arrayobj (new vector<short int>());
+	boost::int32_t size = GetTypedArraySize(reader);
+	boost::shared_ptr<vector<short int> > arrayobj = PacketArena::New<vector<short int> >(arena);
+	arrayobj->reserve(size);
 			
 	for (boost::int32_t j = 0; j < size; j++)
 	{
 		short int value;
-		buffer->ReadShort(value);
+		reader.ReadShort(value);
 		arrayobj->push_back(value);
 	}
 			
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_SHORT_ARRAY, arrayobj));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_INT_ARRAY(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_INT_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	boost::int32_t size = GetTypedArraySize(buffer);
-	boost::shared_ptr<vector<long int> > arrayobj (new vector<long int>());
+	boost::int32_t size = GetTypedArraySize(reader);
+	boost::shared_ptr<vector<long int> > arrayobj = PacketArena::New<vector<long int> >(arena);
+	arrayobj->reserve(size);
 			
 	for (boost::int32_t j = 0; j < size; j++)
 	{
 		boost::int32_t value;
-		buffer->ReadInt(value);
+		reader.ReadInt(value);
 		arrayobj->push_back(value);
 	}
 			
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_INT_ARRAY, arrayobj));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_LONG_ARRAY(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_LONG_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	boost::int32_t size = GetTypedArraySize(buffer);
-	boost::shared_ptr<vector<long long> > arrayobj (new vector<long long>());
+	boost::int32_t size = GetTypedArraySize(reader);
+	boost::shared_ptr<vector<long long> > arrayobj = PacketArena::New<vector<long long> >(arena);
+	arrayobj->reserve(size);
 			
 	for (int j = 0; j < size; j++) 
 	{
 		long long value;
-		buffer->ReadLong(value);
+		reader.ReadLong(value);
 		arrayobj->push_back(value);
 	}
 			
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_LONG_ARRAY, arrayobj));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_FLOAT_ARRAY(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_FLOAT_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	boost::int32_t size = GetTypedArraySize(buffer);
+	boost::int32_t size = GetTypedArraySize(reader);
 			
-	boost::shared_ptr<vector<float> > arrayobj (new vector<float>());
+	boost::shared_ptr<vector<float> > arrayobj = PacketArena::New<vector<float> >(arena);
+	arrayobj->reserve(size);
 			
 	for (boost::int32_t j = 0; j < size; j++)
 	{
 		float value;
-		buffer->ReadFloat(value);
+		reader.ReadFloat(value);
 		arrayobj->push_back(value);
 	}
 			
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_FLOAT_ARRAY, arrayobj));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_DOUBLE_ARRAY(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_DOUBLE_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	boost::int32_t size = GetTypedArraySize(buffer);
+	boost::int32_t size = GetTypedArraySize(reader);
 			
-	boost::shared_ptr<vector<double> > arrayobj (new vector<double>());
+	boost::shared_ptr<vector<double> > arrayobj = PacketArena::New<vector<double> >(arena);
+	arrayobj->reserve(size);
 			
 	for (boost::int32_t j = 0; j < size; j++)
 	{
 		double value;
-		buffer->ReadDouble(value);
+		reader.ReadDouble(value);
 		arrayobj->push_back(value);
 	}
 			
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_DOUBLE_ARRAY, arrayobj));
 }
 
-boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_UTF_STRING_ARRAY(boost::shared_ptr<ByteArray> buffer)
+boost::shared_ptr<SFSDataWrapper> DefaultSFSDataSerializer::BinDecode_UTF_STRING_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena)
 {
-	boost::int32_t size = GetTypedArraySize(buffer);
+	boost::int32_t size = GetTypedArraySize(reader);
 			
-	boost::shared_ptr<vector<string> > arrayobj (new vector<string>());
+	boost::shared_ptr<vector<string> > arrayobj = PacketArena::New<vector<string> >(arena);
+	arrayobj->reserve(size);
 			
 	for (boost::int32_t j = 0; j < size; j++)
 	{
-		string value;
-		buffer->ReadUTF(value);
-		arrayobj->push_back(value);
+		arrayobj->push_back(string());
+		reader.ReadUTF(arrayobj->back());
 	}
 			
 	return boost::shared_ptr<SFSDataWrapper>(new SFSDataWrapper(SFSDATATYPE_UTF_STRING_ARRAY, arrayobj));
 }
 
-boost::int32_t DefaultSFSDataSerializer::GetTypedArraySize(boost::shared_ptr<ByteArray> buffer)
+boost::int32_t DefaultSFSDataSerializer::GetTypedArraySize(ByteReader& reader)
+{
+	short int size;
+	reader.ReadShort(size);
+	return size;
+}
+
+
+
+// Binary Validation Methods
+
+void DefaultSFSDataSerializer::ValidateSFSObject(ByteReader& reader)
 {
+	ValidateLength(reader, 3);
+
+	unsigned char headerByte;
+	reader.ReadByte(headerByte);
+						
+	// Validate typeId
+	if (headerByte != (unsigned char)SFSDATATYPE_SFS_OBJECT) 
+	{
+		boost::shared_ptr<string> err (new string());
+
+		boost::shared_ptr<string> format (new string("Invalid SFSDataType. Expected: %d, found: %d"));
+		StringFormatter<long int, unsigned char> (err, format, SFSDATATYPE_SFS_OBJECT, headerByte);
+
+		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+		throw exception;
+	}
+	
 	short int size;
-	buffer->ReadShort(size);
+	reader.ReadShort(size);
+			
+	// Validate size
+	if (size < 0) 
+	{
+		boost::shared_ptr<string> err (new string());
+
+		boost::shared_ptr<string> format (new string("Can't decode SFSObject. Size is negative: %d"));
+		StringFormatter<long int> (err, format, size);
+
+		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+		throw exception;
+	}		
+
+	for (int i = 0; i < size; i++) 
+	{
+		ValidateUTF(reader);
+		ValidateValue(reader);
+	}
+}
+
+void DefaultSFSDataSerializer::ValidateSFSArray(ByteReader& reader)
+{
+	ValidateLength(reader, 3);
+
+	unsigned char type;
+	reader.ReadByte(type);
+	SFSDataType headerType = (SFSDataType)(long int)(type);
+			
+	// Validate typeId
+	if (headerType != SFSDATATYPE_SFS_ARRAY) 
+	{
+		boost::shared_ptr<string> err (new string());
+
+		boost::shared_ptr<string> format (new string("Invalid SFSDataType. Expected: %d, found: %d"));
+		StringFormatter<long int, long int> (err, format, SFSDATATYPE_SFS_ARRAY, headerType);
+
+		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+		throw exception;
+	}
+				
+	short int size;
+	reader.ReadShort(size);
+			
+	// Validate size
+	if (size < 0) 
+	{
+		boost::shared_ptr<string> err (new string());
+
+		boost::shared_ptr<string> format (new string("Can't decode SFSArray. Size is negative: %d"));
+		StringFormatter<long int> (err, format, size);
+
+		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+		throw exception;
+	}
+
+	for (long int i = 0; i < size; i++) 
+	{
+		ValidateValue(reader);
+	}
+}
+
+void DefaultSFSDataSerializer::ValidateValue(ByteReader& reader)
+{
+	ValidateLength(reader, 1);
+
+	unsigned char headerValue;
+	reader.ReadByte(headerValue);
+	SFSDataType headerByte = (SFSDataType)(long int)(headerValue);
+
+	switch (headerByte)
+	{
+	case SFSDATATYPE_NULL:
+		break;
+	case SFSDATATYPE_BOOL:
+	case SFSDATATYPE_BYTE:
+		ValidateLength(reader, 1);
+		reader.Skip(1);
+		break;
+	case SFSDATATYPE_SHORT:
+		ValidateLength(reader, 2);
+		reader.Skip(2);
+		break;
+	case SFSDATATYPE_INT:
+	case SFSDATATYPE_FLOAT:
+		ValidateLength(reader, 4);
+		reader.Skip(4);
+		break;
+	case SFSDATATYPE_LONG:
+	case SFSDATATYPE_DOUBLE:
+		ValidateLength(reader, 8);
+		reader.Skip(8);
+		break;
+	case SFSDATATYPE_UTF_STRING:
+		ValidateUTF(reader);
+		break;
+	case SFSDATATYPE_TEXT:
+	case SFSDATATYPE_BYTE_ARRAY:
+		{
+			// 4 bytes size, followed by the bytes
+			ValidateLength(reader, 4);
+
+			boost::int32_t size;
+			reader.ReadInt(size);
+
+			if (size < 0) 
+			{
+				boost::shared_ptr<string> err (new string());
+				 
+				boost::shared_ptr<string> format (new string("Array negative size: %d"));
+				StringFormatter<boost::int32_t> (err, format, size);
+
+				boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+				throw exception;
+			}
+
+			ValidateLength(reader, size);
+			reader.Skip(size);
+			break;
+		}
+	case SFSDATATYPE_BOOL_ARRAY:
+		ValidateTypedArray(reader, 1);
+		break;
+	case SFSDATATYPE_SHORT_ARRAY:
+		ValidateTypedArray(reader, 2);
+		break;
+	case SFSDATATYPE_INT_ARRAY:
+	case SFSDATATYPE_FLOAT_ARRAY:
+		ValidateTypedArray(reader, 4);
+		break;
+	case SFSDATATYPE_LONG_ARRAY:
+	case SFSDATATYPE_DOUBLE_ARRAY:
+		ValidateTypedArray(reader, 8);
+		break;
+	case SFSDATATYPE_UTF_STRING_ARRAY:
+		{
+			boost::int32_t size = ValidateTypedArraySize(reader);
+			for (boost::int32_t j = 0; j < size; j++)
+			{
+				ValidateUTF(reader);
+			}
+
+			break;
+		}
+	case SFSDATATYPE_SFS_ARRAY:
+		// pointer goes back 1 position
+		reader.Skip(-1);
+		ValidateSFSArray(reader);
+		break;
+	case SFSDATATYPE_SFS_OBJECT:
+		// pointer goes back 1 position
+		reader.Skip(-1);
+		ValidateSFSObject(reader);
+		break;
+	default:
+		{
+			boost::shared_ptr<string> err (new string());
+
+			boost::shared_ptr<string> format (new string("Unknow SFSDataType ID: %d"));
+			StringFormatter<long int> (err, format, headerByte);
+
+			boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+			throw exception;
+		}
+	}
+}
+
+void DefaultSFSDataSerializer::ValidateUTF(ByteReader& reader)
+{
+	ValidateLength(reader, 2);
+
+	unsigned short int size;
+	reader.ReadUShort(size);
+
+	ValidateLength(reader, size);
+	reader.Skip(size);
+}
+
+void DefaultSFSDataSerializer::ValidateTypedArray(ByteReader& reader, long int itemSize)
+{
+	boost::int32_t size = ValidateTypedArraySize(reader);
+
+	ValidateLength(reader, size * itemSize);
+	reader.Skip(size * itemSize);
+}
+
+boost::int32_t DefaultSFSDataSerializer::ValidateTypedArraySize(ByteReader& reader)
+{
+	ValidateLength(reader, 2);
+
+	short int size;
+	reader.ReadShort(size);
 			
 	if (size < 0) 
 	{
@@ -696,209 +984,211 @@ boost::int32_t DefaultSFSDataSerializer::GetTypedArraySize(boost::shared_ptr<Byt
 	return size;
 }
 
+void DefaultSFSDataSerializer::ValidateLength(ByteReader& reader, long int count)
+{
+	if (count > reader.Remaining()) 
+	{
+		boost::shared_ptr<string> err (new string());
+
+		boost::shared_ptr<string> format (new string("Can't decode data. Byte data is insufficient at position %d: %d byte(s) needed"));
+		StringFormatter<long int, long int> (err, format, reader.Position(), count);
+
+		boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+		throw exception;
+	}
+}
+
 
 
 // Binary Entities Encoding Methods
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_NULL(boost::shared_ptr<ByteArray> buffer)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte((unsigned char)0x00);
-	return AddData(buffer, data);
+	buffer->WriteByte((unsigned char)0x00);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_BOOL(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<bool> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_BOOL);
-	data->WriteBool(*val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_BOOL);
+	buffer->WriteBool(*val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_BYTE(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<unsigned char> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_BYTE);
-	data->WriteByte(*val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_BYTE);
+	buffer->WriteByte(*val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_SHORT(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<short int> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_SHORT);
-	data->WriteShort(*val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_SHORT);
+	buffer->WriteShort(*val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_INT(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<boost::int32_t> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_INT);
-	data->WriteInt(*val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_INT);
+	buffer->WriteInt(*val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_LONG(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<long long> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_LONG);
-	data->WriteLong(*val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_LONG);
+	buffer->WriteLong(*val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_FLOAT(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<float> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_FLOAT);
-	data->WriteFloat(*val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_FLOAT);
+	buffer->WriteFloat(*val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_DOUBLE(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<double> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_DOUBLE);
-	data->WriteDouble(*val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_DOUBLE);
+	buffer->WriteDouble(*val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_INT(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<double> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_DOUBLE);
-	data->WriteDouble(*val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_DOUBLE);
+	buffer->WriteDouble(*val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_UTF_STRING(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<string> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_UTF_STRING);
-	data->WriteUTF(val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_UTF_STRING);
+	buffer->WriteUTF(val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_TEXT(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<string> val)
 {
-	boost::shared_ptr<ByteArray> data(new ByteArray());
-	data->WriteByte(SFSDATATYPE_TEXT);
-	data->WriteText(val);
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_TEXT);
+	buffer->WriteText(val);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_BOOL_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<bool> > val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_BOOL_ARRAY);
-	data->WriteShort((short int)(val->size()));
-			
+	// Type, count and elements are written as one block sized up front
+	ByteWriter writer = buffer->Writer(3 + (long int)val->size());
+	writer.WriteByte(SFSDATATYPE_BOOL_ARRAY);
+	writer.WriteShort((short int)(val->size()));
+
 	vector<bool>::iterator iterator;
 	for(iterator = val->begin(); iterator != val->end(); ++iterator)
 	{
-		data->WriteBool(*iterator);
+		writer.WriteBool(*iterator);
 	}
 			
-	return AddData(buffer, data);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_BYTE_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<ByteArray> val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_BYTE_ARRAY);
-	data->WriteInt(val->Length());
-	data->WriteBytes(val->Bytes());
-	return AddData(buffer, data);
+	buffer->WriteByte(SFSDATATYPE_BYTE_ARRAY);
+	buffer->WriteInt(val->Length());
+	buffer->WriteBytes(val->Bytes());
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_SHORT_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<short int> > val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_SHORT_ARRAY);
-	data->WriteShort((short int)(val->size()));
+	ByteWriter writer = buffer->Writer(3 + (long int)val->size() * 2);
+	writer.WriteByte(SFSDATATYPE_SHORT_ARRAY);
+	writer.WriteShort((short int)(val->size()));
 
 	vector<short int>::iterator iterator;
 	for(iterator = val->begin(); iterator != val->end(); ++iterator)
 	{
-		data->WriteShort(*iterator);
+		writer.WriteShort(*iterator);
 	}
 			
-	return AddData(buffer, data);
+	return buffer;
 }
 
-boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_INT_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<boost::int32_t> > val)
+boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_INT_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<long int> > val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_INT_ARRAY);
-	data->WriteShort((short int)(val->size()));
+	ByteWriter writer = buffer->Writer(3 + (long int)val->size() * 4);
+	writer.WriteByte(SFSDATATYPE_INT_ARRAY);
+	writer.WriteShort((short int)(val->size()));
 
-	vector<boost::int32_t>::iterator iterator;
+	vector<long int>::iterator iterator;
 	for(iterator = val->begin(); iterator != val->end(); ++iterator)
 	{
-		data->WriteInt(*iterator);
+		writer.WriteInt((boost::int32_t)*iterator);
 	}
 			
-	return AddData(buffer, data);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_LONG_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<long long> > val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_LONG_ARRAY);
-	data->WriteShort((short int)(val->size()));
+	ByteWriter writer = buffer->Writer(3 + (long int)val->size() * 8);
+	writer.WriteByte(SFSDATATYPE_LONG_ARRAY);
+	writer.WriteShort((short int)(val->size()));
 
 	vector<long long>::iterator iterator;
 	for(iterator = val->begin(); iterator != val->end(); ++iterator)
 	{
-		data->WriteLong(*iterator);
+		writer.WriteLong(*iterator);
 	}
 			
-	return AddData(buffer, data);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_FLOAT_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<float> > val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_FLOAT_ARRAY);
-	data->WriteShort((short int)(val->size()));
-			
+	ByteWriter writer = buffer->Writer(3 + (long int)val->size() * 4);
+	writer.WriteByte(SFSDATATYPE_FLOAT_ARRAY);
+	writer.WriteShort((short int)(val->size()));
+
 	vector<float>::iterator iterator;
 	for(iterator = val->begin(); iterator != val->end(); ++iterator)
 	{
-		data->WriteFloat(*iterator);
+		writer.WriteFloat(*iterator);
 	}
 			
-	return AddData(buffer, data);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_DOUBLE_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<double> > val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_DOUBLE_ARRAY);
-	data->WriteShort((short int)(val->size()));
+	ByteWriter writer = buffer->Writer(3 + (long int)val->size() * 8);
+	writer.WriteByte(SFSDATATYPE_DOUBLE_ARRAY);
+	writer.WriteShort((short int)(val->size()));
 
 	vector<double>::iterator iterator;
 	for(iterator = val->begin(); iterator != val->end(); ++iterator)
 	{
-		data->WriteDouble(*iterator);
+		writer.WriteDouble(*iterator);
 	}
 			
-	return AddData(buffer, data);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::BinEncode_UTF_STRING_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<string> > val)
 {
-	boost::shared_ptr<ByteArray> data (new ByteArray());
-	data->WriteByte(SFSDATATYPE_UTF_STRING_ARRAY);
-	data->WriteShort((short int)(val->size()));
+	buffer->WriteByte(SFSDATATYPE_UTF_STRING_ARRAY);
+	buffer->WriteShort((short int)(val->size()));
 
 	vector<string>::iterator iterator;
 	for(iterator = val->begin(); iterator != val->end(); ++iterator)
 	{
-		data->WriteUTF(*iterator);
+		buffer->WriteUTF(*iterator);
 	}
 			
-	return AddData(buffer, data);
+	return buffer;
 }
 
 boost::shared_ptr<ByteArray> DefaultSFSDataSerializer::EncodeSFSObjectKey(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<string> val)
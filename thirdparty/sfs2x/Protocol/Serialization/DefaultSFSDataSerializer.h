@@ -17,7 +17,9 @@
 #include "../../Entities/Data/SFSObject.h"
 #include "../../Entities/Data/SFSArray.h"
 #include "../../Entities/Data/SFSDataType.h"
+#include "../../Entities/Data/SFSDataValue.h"
 #include "../../Util/ByteArray.h"
+#include "../../Util/PacketArena.h"
 #include "../../Exceptions/SFSCodecError.h"
 #include "../../Util/StringFormatter.h"
 
@@ -67,9 +69,24 @@ namespace Serialization {
 
 		boost::shared_ptr<ISFSObject> Binary2Object(boost::shared_ptr<ByteArray> data);
 
+		/// <summary>
+		/// Decodes an SFSObject, creating the objects, arrays and boxed values of the graph in the passed arena
+		/// </summary>
+		/// <remarks>
+		/// The arena is released when the last object of the graph is released; an empty arena decodes on the heap.
+		/// </remarks>
+		boost::shared_ptr<ISFSObject> Binary2Object(boost::shared_ptr<ByteArray> data, boost::shared_ptr<PacketArena> arena);
+
 		// Binary ==> SFSArray
 
 		boost::shared_ptr<ISFSArray> Binary2Array(boost::shared_ptr<ByteArray> data);
+		boost::shared_ptr<ISFSArray> Binary2Array(boost::shared_ptr<ByteArray> data, boost::shared_ptr<PacketArena> arena);
+
+		/// <summary>
+		/// Checks the value at the reader position, type id included, and moves past it without decoding it
+		/// </summary>
+		/// <exception cref="SFSCodecError">The value is malformed</exception>
+		void SkipValue(ByteReader& reader);
 
 
 		// -------------------------------------------------------------------
@@ -99,37 +116,63 @@ namespace Serialization {
 
 		boost::shared_ptr<ByteArray> Obj2bin(boost::shared_ptr<ISFSObject> obj, boost::shared_ptr<ByteArray> buffer);
 		boost::shared_ptr<ByteArray> Arr2bin(boost::shared_ptr<ISFSArray> arrayobj, boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<ISFSObject> DecodeSFSObject(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<ISFSArray> DecodeSFSArray(boost::shared_ptr<ByteArray> buffer);
+		boost::shared_ptr<ISFSObject> DecodeSFSObject(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<ISFSArray> DecodeSFSArray(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
 		boost::shared_ptr<ByteArray> EncodeObject(boost::shared_ptr<ByteArray> buffer, int typeId, boost::shared_ptr<void> data);
 
 		/*
-	 	* The buffer pointer (position) must located on the 1st byte of the object to decode
-	 	* Throws SFSCodecException
+	 	* The reader position must located on the 1st byte of the object to decode
+	 	* The data must have been validated: reads and type ids are not checked
+	 	* Boxed values are created in the arena, if any
 	 	*/
-		boost::shared_ptr<SFSDataWrapper> DecodeObject(boost::shared_ptr<ByteArray> buffer);
+		boost::shared_ptr<SFSDataWrapper> DecodeObject(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+
+		/*
+		* Same as DecodeObject, but primitive values are decoded inline into the passed slot
+		* and strings, objects and arrays are stored without an intermediate wrapper
+		*/
+		void DecodeValue(ByteReader& reader, SFSDataValue& value, boost::shared_ptr<PacketArena> arena);
+
+		/*
+		* Same as EncodeObject, but primitive values are written from the slot, without boxing
+		*/
+		void EncodeValue(boost::shared_ptr<ByteArray> buffer, const SFSDataValue& value);
 
 		// Binary Entities Decoding Methods
 
-		boost::shared_ptr<SFSDataWrapper> BinDecode_NULL(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_BOOL(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_BYTE(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_SHORT(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_INT(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_LONG(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_FLOAT(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_DOUBLE(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_UTF_STRING(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_TEXT(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_BOOL_ARRAY(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_BYTE_ARRAY(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_SHORT_ARRAY(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_INT_ARRAY(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_LONG_ARRAY(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_FLOAT_ARRAY(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_DOUBLE_ARRAY(boost::shared_ptr<ByteArray> buffer);
-		boost::shared_ptr<SFSDataWrapper> BinDecode_UTF_STRING_ARRAY(boost::shared_ptr<ByteArray> buffer);
-		boost::int32_t GetTypedArraySize(boost::shared_ptr<ByteArray> buffer);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_NULL(ByteReader& reader);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_BOOL(ByteReader& reader);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_BYTE(ByteReader& reader);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_SHORT(ByteReader& reader);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_INT(ByteReader& reader);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_LONG(ByteReader& reader);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_FLOAT(ByteReader& reader);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_DOUBLE(ByteReader& reader);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_UTF_STRING(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_TEXT(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_BOOL_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_BYTE_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_SHORT_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_INT_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_LONG_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_FLOAT_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_DOUBLE_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::shared_ptr<SFSDataWrapper> BinDecode_UTF_STRING_ARRAY(ByteReader& reader, boost::shared_ptr<PacketArena> arena);
+		boost::int32_t GetTypedArraySize(ByteReader& reader);
+
+		// Binary Validation Methods
+
+		/*
+		* Walks the binary structure without decoding it, checking every length, size and type id
+		* Throws SFSCodecException on malformed data, before any object is created
+		*/
+		void ValidateSFSObject(ByteReader& reader);
+		void ValidateSFSArray(ByteReader& reader);
+		void ValidateValue(ByteReader& reader);
+		void ValidateUTF(ByteReader& reader);
+		void ValidateTypedArray(ByteReader& reader, long int itemSize);
+		boost::int32_t ValidateTypedArraySize(ByteReader& reader);
+		void ValidateLength(ByteReader& reader, long int count);
 
 		// Binary Entities Encoding Methods
 
@@ -147,7 +190,7 @@ namespace Serialization {
 		boost::shared_ptr<ByteArray> BinEncode_BOOL_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<bool> > val);
 		boost::shared_ptr<ByteArray> BinEncode_BYTE_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<ByteArray> val);
 		boost::shared_ptr<ByteArray> BinEncode_SHORT_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<short int> > val);
-		boost::shared_ptr<ByteArray> BinEncode_INT_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<boost::int32_t> > val);
+		boost::shared_ptr<ByteArray> BinEncode_INT_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<long int> > val);
 		boost::shared_ptr<ByteArray> BinEncode_LONG_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<long long> > val);
 		boost::shared_ptr<ByteArray> BinEncode_FLOAT_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<float> > val);
 		boost::shared_ptr<ByteArray> BinEncode_DOUBLE_ARRAY(boost::shared_ptr<ByteArray> buffer, boost::shared_ptr<vector<double> > val);
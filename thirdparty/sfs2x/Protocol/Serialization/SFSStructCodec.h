@@ -0,0 +1,1050 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of SFSStructCodec
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __SFSStructCodec__
+#define __SFSStructCodec__
+
+#include "DefaultSFSDataSerializer.h"
+#include "../../Entities/Data/SFSDataType.h"
+#include "../../Util/ByteArray.h"
+#include "../../Util/ByteReader.h"
+#include "../../Util/ByteWriter.h"
+#include "../../Exceptions/SFSCodecError.h"
+#include "../../Util/StringFormatter.h"
+
+#include <boost/shared_ptr.hpp>				// Boost Asio shared pointer
+#include <boost/cstdint.hpp>					// Boost fixed size integers
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <string>						// STL library: string object
+#include <vector>						// STL library: vector object
+using namespace std;					// STL library: declare the STL namespace
+
+#include <string.h>						// memcmp, strlen
+
+using namespace Sfs2X::Entities::Data;
+using namespace Sfs2X::Util;
+using namespace Sfs2X::Exceptions;
+
+// -------------------------------------------------------------------
+// Field registration
+// -------------------------------------------------------------------
+// The fields of a struct are listed once, inside the struct:
+//
+//		struct PlayerMove
+//		{
+//			long int id;
+//			float x;
+//			float y;
+//			vector<long int> path;
+//
+//			SFS_STRUCT_FIELDS("com.mygame.PlayerMove")
+//				SFS_STRUCT_FIELD(id)
+//				SFS_STRUCT_FIELD(x)
+//				SFS_STRUCT_FIELD(y)
+//				SFS_STRUCT_FIELD_NAMED(path, "p")
+//			SFS_STRUCT_FIELDS_END()
+//		};
+//
+// Fields can be bool, unsigned char, short int, int, long int, long long, float, double, string,
+// vector of those (vector<unsigned char> is a byte array), registered structs and vectors of registered structs.
+// The class name is only written by SFSStructCodec::EncodeClass.
+
+#define SFS_STRUCT_FIELDS(className) \
+	static const char* SFSClassName() { return className; } \
+	template <class Visitor> void SFSFields(Visitor& visitor) {
+
+#define SFS_STRUCT_FIELD(field) \
+	visitor.Field(#field, sizeof(#field) - 1, field);
+
+#define SFS_STRUCT_FIELD_NAMED(field, name) \
+	visitor.Field(name, sizeof(name) - 1, field);
+
+#define SFS_STRUCT_FIELDS_END() \
+	}
+
+namespace Sfs2X {
+namespace Protocol {
+namespace Serialization {
+
+	template <class T> class SFSStructCodec;
+
+	// -------------------------------------------------------------------
+	// Class SFSStructInput
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Checked reads of the SFS binary format, shared by the struct codecs
+	/// </summary>
+	///
+	/// <remarks>
+	/// Unlike <see cref="DefaultSFSDataSerializer"/>, structs are decoded in a single pass: every length and type id is checked as it is read.
+	/// </remarks>
+	class SFSStructInput
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		static void Require(ByteReader& reader, long int count);
+		static void ReadType(ByteReader& reader, SFSDataType expected);
+		static boost::int32_t ReadSize(ByteReader& reader, long int itemSize);
+		static const char* ReadKey(ByteReader& reader, long int& length);
+		static bool IsKey(const char* key, long int length, const char* name, long int nameLength);
+	};
+
+	// -------------------------------------------------------------------
+	// Require
+	// -------------------------------------------------------------------
+	inline void SFSStructInput::Require(ByteReader& reader, long int count)
+	{
+		if (count > reader.Remaining())
+		{
+			boost::shared_ptr<string> err (new string());
+
+			boost::shared_ptr<string> format (new string("Can't decode data. Byte data is insufficient at position %d: %d byte(s) needed"));
+			StringFormatter<long int, long int> (err, format, reader.Position(), count);
+
+			boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+			throw exception;
+		}
+	}
+
+	// -------------------------------------------------------------------
+	// ReadType
+	// -------------------------------------------------------------------
+	inline void SFSStructInput::ReadType(ByteReader& reader, SFSDataType expected)
+	{
+		Require(reader, 1);
+
+		unsigned char headerValue;
+		reader.ReadByte(headerValue);
+
+		if (headerValue != (unsigned char)expected)
+		{
+			boost::shared_ptr<string> err (new string());
+
+			boost::shared_ptr<string> format (new string("Invalid SFSDataType. Expected: %d, found: %d"));
+			StringFormatter<long int, long int> (err, format, (long int)expected, (long int)headerValue);
+
+			boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+			throw exception;
+		}
+	}
+
+	// -------------------------------------------------------------------
+	// ReadSize
+	// -------------------------------------------------------------------
+	inline boost::int32_t SFSStructInput::ReadSize(ByteReader& reader, long int itemSize)
+	{
+		Require(reader, 2);
+
+		short int size;
+		reader.ReadShort(size);
+
+		if (size < 0)
+		{
+			boost::shared_ptr<string> err (new string());
+
+			boost::shared_ptr<string> format (new string("Array negative size: %d"));
+			StringFormatter<short int> (err, format, size);
+
+			boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+			throw exception;
+		}
+
+		// Fixed size items are checked all at once
+		Require(reader, size * itemSize);
+
+		return size;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadKey
+	// -------------------------------------------------------------------
+	inline const char* SFSStructInput::ReadKey(ByteReader& reader, long int& length)
+	{
+		Require(reader, 2);
+
+		unsigned short int size;
+		reader.ReadUShort(size);
+
+		Require(reader, size);
+
+		// The key is compared in place, it is never copied
+		const char* key = (const char*)reader.Cursor();
+		reader.Skip(size);
+
+		length = size;
+		return key;
+	}
+
+	// -------------------------------------------------------------------
+	// IsKey
+	// -------------------------------------------------------------------
+	inline bool SFSStructInput::IsKey(const char* key, long int length, const char* name, long int nameLength)
+	{
+		return length == nameLength && memcmp(key, name, (size_t)length) == 0;
+	}
+
+	// -------------------------------------------------------------------
+	// Class SFSStructField
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Encodes and decodes a single field value, including its type id
+	/// </summary>
+	///
+	/// <remarks>
+	/// The primary template handles registered structs, which are written as nested SFSObjects;
+	/// the specializations below map the supported C++ types to their <see cref="SFSDataType"/>.
+	/// </remarks>
+	template <class T>
+	class SFSStructField
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const T& value, bool asClass)
+		{
+			SFSStructCodec<T>::WriteObject(buffer, value, asClass);
+		}
+
+		static void Read(ByteReader& reader, T& value)
+		{
+			SFSStructCodec<T>::ReadObject(reader, value);
+		}
+	};
+
+	// -------------------------------------------------------------------
+	// Scalar fields
+	// -------------------------------------------------------------------
+	template <>
+	class SFSStructField<bool>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const bool& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(2);
+			writer.WriteByte((unsigned char)SFSDATATYPE_BOOL);
+			writer.WriteBool(value);
+		}
+
+		static void Read(ByteReader& reader, bool& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_BOOL);
+			SFSStructInput::Require(reader, 1);
+			reader.ReadBool(value);
+		}
+	};
+
+	template <>
+	class SFSStructField<unsigned char>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const unsigned char& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(2);
+			writer.WriteByte((unsigned char)SFSDATATYPE_BYTE);
+			writer.WriteByte(value);
+		}
+
+		static void Read(ByteReader& reader, unsigned char& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_BYTE);
+			SFSStructInput::Require(reader, 1);
+			reader.ReadByte(value);
+		}
+	};
+
+	template <>
+	class SFSStructField<short int>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const short int& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3);
+			writer.WriteByte((unsigned char)SFSDATATYPE_SHORT);
+			writer.WriteShort(value);
+		}
+
+		static void Read(ByteReader& reader, short int& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_SHORT);
+			SFSStructInput::Require(reader, 2);
+			reader.ReadShort(value);
+		}
+	};
+
+	template <>
+	class SFSStructField<int>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const int& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(5);
+			writer.WriteByte((unsigned char)SFSDATATYPE_INT);
+			writer.WriteInt((boost::int32_t)value);
+		}
+
+		static void Read(ByteReader& reader, int& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_INT);
+			SFSStructInput::Require(reader, 4);
+
+			boost::int32_t decoded;
+			reader.ReadInt(decoded);
+			value = (int)decoded;
+		}
+	};
+
+	template <>
+	class SFSStructField<long int>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const long int& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(5);
+			writer.WriteByte((unsigned char)SFSDATATYPE_INT);
+			writer.WriteInt((boost::int32_t)value);
+		}
+
+		static void Read(ByteReader& reader, long int& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_INT);
+			SFSStructInput::Require(reader, 4);
+
+			boost::int32_t decoded;
+			reader.ReadInt(decoded);
+			value = (long int)decoded;
+		}
+	};
+
+	template <>
+	class SFSStructField<long long>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const long long& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(9);
+			writer.WriteByte((unsigned char)SFSDATATYPE_LONG);
+			writer.WriteLong(value);
+		}
+
+		static void Read(ByteReader& reader, long long& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_LONG);
+			SFSStructInput::Require(reader, 8);
+			reader.ReadLong(value);
+		}
+	};
+
+	template <>
+	class SFSStructField<float>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const float& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(5);
+			writer.WriteByte((unsigned char)SFSDATATYPE_FLOAT);
+			writer.WriteFloat(value);
+		}
+
+		static void Read(ByteReader& reader, float& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_FLOAT);
+			SFSStructInput::Require(reader, 4);
+			reader.ReadFloat(value);
+		}
+	};
+
+	template <>
+	class SFSStructField<double>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const double& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(9);
+			writer.WriteByte((unsigned char)SFSDATATYPE_DOUBLE);
+			writer.WriteDouble(value);
+		}
+
+		static void Read(ByteReader& reader, double& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_DOUBLE);
+			SFSStructInput::Require(reader, 8);
+			reader.ReadDouble(value);
+		}
+	};
+
+	template <>
+	class SFSStructField<string>
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const string& value, bool asClass)
+		{
+			buffer.WriteByte((unsigned char)SFSDATATYPE_UTF_STRING);
+			buffer.WriteUTF(value);
+		}
+
+		static void Read(ByteReader& reader, string& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_UTF_STRING);
+
+			long int length;
+			const char* data = SFSStructInput::ReadKey(reader, length);
+			value.assign(data, (size_t)length);
+		}
+	};
+
+	// -------------------------------------------------------------------
+	// Typed array fields
+	// -------------------------------------------------------------------
+	template <>
+	class SFSStructField<vector<unsigned char> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<unsigned char>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(5 + (long int)value.size());
+			writer.WriteByte((unsigned char)SFSDATATYPE_BYTE_ARRAY);
+			writer.WriteInt((boost::int32_t)value.size());
+			writer.WriteBytes(value.empty() ? NULL : &value[0], (long int)value.size());
+		}
+
+		static void Read(ByteReader& reader, vector<unsigned char>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_BYTE_ARRAY);
+			SFSStructInput::Require(reader, 4);
+
+			boost::int32_t size;
+			reader.ReadInt(size);
+
+			if (size < 0)
+			{
+				boost::shared_ptr<string> err (new string());
+
+				boost::shared_ptr<string> format (new string("Array negative size: %d"));
+				StringFormatter<boost::int32_t> (err, format, size);
+
+				boost::shared_ptr<SFSCodecError> exception(new SFSCodecError(err));
+				throw exception;
+			}
+
+			SFSStructInput::Require(reader, size);
+
+			value.clear();
+			reader.ReadBytes(size, value);
+		}
+	};
+
+	template <>
+	class SFSStructField<vector<bool> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<bool>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3 + (long int)value.size());
+			writer.WriteByte((unsigned char)SFSDATATYPE_BOOL_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (vector<bool>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				writer.WriteBool(*iterator);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<bool>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_BOOL_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 1);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				bool item;
+				reader.ReadBool(item);
+				value[i] = item;
+			}
+		}
+	};
+
+	template <>
+	class SFSStructField<vector<short int> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<short int>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3 + 2 * (long int)value.size());
+			writer.WriteByte((unsigned char)SFSDATATYPE_SHORT_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (vector<short int>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				writer.WriteShort(*iterator);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<short int>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_SHORT_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 2);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				reader.ReadShort(value[i]);
+			}
+		}
+	};
+
+	template <>
+	class SFSStructField<vector<int> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<int>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3 + 4 * (long int)value.size());
+			writer.WriteByte((unsigned char)SFSDATATYPE_INT_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (vector<int>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				writer.WriteInt((boost::int32_t)*iterator);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<int>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_INT_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 4);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				boost::int32_t item;
+				reader.ReadInt(item);
+				value[i] = (int)item;
+			}
+		}
+	};
+
+	template <>
+	class SFSStructField<vector<long int> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<long int>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3 + 4 * (long int)value.size());
+			writer.WriteByte((unsigned char)SFSDATATYPE_INT_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (vector<long int>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				writer.WriteInt((boost::int32_t)*iterator);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<long int>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_INT_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 4);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				boost::int32_t item;
+				reader.ReadInt(item);
+				value[i] = (long int)item;
+			}
+		}
+	};
+
+	template <>
+	class SFSStructField<vector<long long> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<long long>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3 + 8 * (long int)value.size());
+			writer.WriteByte((unsigned char)SFSDATATYPE_LONG_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (vector<long long>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				writer.WriteLong(*iterator);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<long long>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_LONG_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 8);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				reader.ReadLong(value[i]);
+			}
+		}
+	};
+
+	template <>
+	class SFSStructField<vector<float> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<float>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3 + 4 * (long int)value.size());
+			writer.WriteByte((unsigned char)SFSDATATYPE_FLOAT_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (vector<float>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				writer.WriteFloat(*iterator);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<float>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_FLOAT_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 4);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				reader.ReadFloat(value[i]);
+			}
+		}
+	};
+
+	template <>
+	class SFSStructField<vector<double> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<double>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3 + 8 * (long int)value.size());
+			writer.WriteByte((unsigned char)SFSDATATYPE_DOUBLE_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (vector<double>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				writer.WriteDouble(*iterator);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<double>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_DOUBLE_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 8);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				reader.ReadDouble(value[i]);
+			}
+		}
+	};
+
+	template <>
+	class SFSStructField<vector<string> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<string>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3);
+			writer.WriteByte((unsigned char)SFSDATATYPE_UTF_STRING_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (vector<string>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				buffer.WriteUTF(*iterator);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<string>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_UTF_STRING_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 0);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				long int length;
+				const char* data = SFSStructInput::ReadKey(reader, length);
+				value[i].assign(data, (size_t)length);
+			}
+		}
+	};
+
+	// -------------------------------------------------------------------
+	// Struct array fields
+	// -------------------------------------------------------------------
+	template <class T>
+	class SFSStructField<vector<T> >
+	{
+	public:
+
+		static void Write(ByteArray& buffer, const vector<T>& value, bool asClass)
+		{
+			ByteWriter writer = buffer.Writer(3);
+			writer.WriteByte((unsigned char)SFSDATATYPE_SFS_ARRAY);
+			writer.WriteShort((short int)value.size());
+
+			for (typename vector<T>::const_iterator iterator = value.begin(); iterator != value.end(); iterator++)
+			{
+				SFSStructField<T>::Write(buffer, *iterator, asClass);
+			}
+		}
+
+		static void Read(ByteReader& reader, vector<T>& value)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_SFS_ARRAY);
+			boost::int32_t size = SFSStructInput::ReadSize(reader, 0);
+
+			value.resize(size);
+			for (boost::int32_t i = 0; i < size; i++)
+			{
+				SFSStructField<T>::Read(reader, value[i]);
+			}
+		}
+	};
+
+	// -------------------------------------------------------------------
+	// Class SFSStructCodec
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Encodes and decodes a struct registered with SFS_STRUCT_FIELDS straight to and from the SFS binary format
+	/// </summary>
+	///
+	/// <remarks>
+	/// No intermediate <see cref="SFSObject"/> is created: field values are written from, and read into, the struct members.
+	/// The output of <see cref="Encode"/> is an SFSObject with a key per field, the output of <see cref="EncodeClass"/>
+	/// is the class form used by the server for serializable types, made of the $C (class name) and $F (fields) keys.
+	/// <see cref="Decode"/> accepts both; keys that are not registered fields are skipped, fields that are not sent
+	/// keep their value.
+	/// </remarks>
+	template <class T>
+	class SFSStructCodec
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		/// <summary>
+		/// Encodes the passed struct as an SFSObject
+		/// </summary>
+		static boost::shared_ptr<ByteArray> Encode(const T& value);
+
+		/// <summary>
+		/// Encodes the passed struct in the class form ($C/$F) of the SFS protocol
+		/// </summary>
+		static boost::shared_ptr<ByteArray> EncodeClass(const T& value);
+
+		/// <summary>
+		/// Appends the encoded struct to the passed buffer
+		/// </summary>
+		static void Encode(boost::shared_ptr<ByteArray> buffer, const T& value, bool asClass);
+
+		/// <summary>
+		/// Decodes the passed SFSObject data into the struct
+		/// </summary>
+		/// <exception cref="SFSCodecError">The data is malformed or a field has an unexpected type</exception>
+		static void Decode(boost::shared_ptr<ByteArray> data, T& value);
+
+		static void WriteObject(ByteArray& buffer, const T& value, bool asClass);
+		static void ReadObject(ByteReader& reader, T& value);
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		static void WriteKey(ByteArray& buffer, const char* name, long int nameLength);
+		static void ReadClassFields(ByteReader& reader, T& value);
+
+		// -------------------------------------------------------------------
+		// Field visitors
+		// -------------------------------------------------------------------
+
+		class FieldCounter
+		{
+		public:
+			FieldCounter() : count(0) {}
+
+			template <class F> void Field(const char* name, long int nameLength, F& field)
+			{
+				count++;
+			}
+
+			short int count;
+		};
+
+		class FieldWriter
+		{
+		public:
+			FieldWriter(ByteArray& buffer, bool asClass) : buffer(buffer), asClass(asClass) {}
+
+			template <class F> void Field(const char* name, long int nameLength, F& field)
+			{
+				if (asClass)
+				{
+					// { N: name, V: value }
+					ByteWriter writer = buffer.Writer(3);
+					writer.WriteByte((unsigned char)SFSDATATYPE_SFS_OBJECT);
+					writer.WriteShort(2);
+
+					WriteKey(buffer, "N", 1);
+					buffer.WriteByte((unsigned char)SFSDATATYPE_UTF_STRING);
+					WriteKey(buffer, name, nameLength);
+					WriteKey(buffer, "V", 1);
+				}
+				else
+				{
+					WriteKey(buffer, name, nameLength);
+				}
+
+				SFSStructField<F>::Write(buffer, field, asClass);
+			}
+
+			ByteArray& buffer;
+			bool asClass;
+		};
+
+		class FieldReader
+		{
+		public:
+			FieldReader(ByteReader& reader, const char* key, long int length) : reader(reader), key(key), length(length), found(false) {}
+
+			// Fields are few: matching the key by a linear scan beats any lookup structure
+			template <class F> void Field(const char* name, long int nameLength, F& field)
+			{
+				if (!found && SFSStructInput::IsKey(key, length, name, nameLength))
+				{
+					found = true;
+					SFSStructField<F>::Read(reader, field);
+				}
+			}
+
+			ByteReader& reader;
+			const char* key;
+			long int length;
+			bool found;
+		};
+	};
+
+	// -------------------------------------------------------------------
+	// Encode
+	// -------------------------------------------------------------------
+	template <class T>
+	boost::shared_ptr<ByteArray> SFSStructCodec<T>::Encode(const T& value)
+	{
+		boost::shared_ptr<ByteArray> buffer (new ByteArray());
+		WriteObject(*buffer, value, false);
+		return buffer;
+	}
+
+	// -------------------------------------------------------------------
+	// EncodeClass
+	// -------------------------------------------------------------------
+	template <class T>
+	boost::shared_ptr<ByteArray> SFSStructCodec<T>::EncodeClass(const T& value)
+	{
+		boost::shared_ptr<ByteArray> buffer (new ByteArray());
+		WriteObject(*buffer, value, true);
+		return buffer;
+	}
+
+	// -------------------------------------------------------------------
+	// Encode
+	// -------------------------------------------------------------------
+	template <class T>
+	void SFSStructCodec<T>::Encode(boost::shared_ptr<ByteArray> buffer, const T& value, bool asClass)
+	{
+		WriteObject(*buffer, value, asClass);
+	}
+
+	// -------------------------------------------------------------------
+	// Decode
+	// -------------------------------------------------------------------
+	template <class T>
+	void SFSStructCodec<T>::Decode(boost::shared_ptr<ByteArray> data, T& value)
+	{
+		data->Position(0);
+		ByteReader reader = data->Reader(data->Length());
+
+		ReadObject(reader, value);
+		data->Position(reader.Position());
+	}
+
+	// -------------------------------------------------------------------
+	// WriteObject
+	// -------------------------------------------------------------------
+	template <class T>
+	void SFSStructCodec<T>::WriteObject(ByteArray& buffer, const T& value, bool asClass)
+	{
+		// The field list is only read: the visitors never change the struct
+		T& fields = const_cast<T&>(value);
+
+		FieldCounter counter;
+		fields.SFSFields(counter);
+
+		FieldWriter writer (buffer, asClass);
+
+		if (asClass)
+		{
+			// { $C: class name, $F: [ { N: name, V: value }, ... ] }
+			ByteWriter header = buffer.Writer(3);
+			header.WriteByte((unsigned char)SFSDATATYPE_SFS_OBJECT);
+			header.WriteShort(2);
+
+			WriteKey(buffer, "$C", 2);
+			buffer.WriteByte((unsigned char)SFSDATATYPE_UTF_STRING);
+			WriteKey(buffer, T::SFSClassName(), (long int)strlen(T::SFSClassName()));
+
+			WriteKey(buffer, "$F", 2);
+			ByteWriter fieldsHeader = buffer.Writer(3);
+			fieldsHeader.WriteByte((unsigned char)SFSDATATYPE_SFS_ARRAY);
+			fieldsHeader.WriteShort(counter.count);
+		}
+		else
+		{
+			ByteWriter header = buffer.Writer(3);
+			header.WriteByte((unsigned char)SFSDATATYPE_SFS_OBJECT);
+			header.WriteShort(counter.count);
+		}
+
+		fields.SFSFields(writer);
+	}
+
+	// -------------------------------------------------------------------
+	// ReadObject
+	// -------------------------------------------------------------------
+	template <class T>
+	void SFSStructCodec<T>::ReadObject(ByteReader& reader, T& value)
+	{
+		SFSStructInput::ReadType(reader, SFSDATATYPE_SFS_OBJECT);
+		boost::int32_t size = SFSStructInput::ReadSize(reader, 0);
+
+		for (boost::int32_t i = 0; i < size; i++)
+		{
+			long int length;
+			const char* key = SFSStructInput::ReadKey(reader, length);
+
+			if (SFSStructInput::IsKey(key, length, "$F", 2))
+			{
+				ReadClassFields(reader, value);
+				continue;
+			}
+
+			FieldReader fieldReader (reader, key, length);
+			value.SFSFields(fieldReader);
+
+			if (!fieldReader.found)
+			{
+				// Unknown keys, including the $C class name, are checked and skipped
+				DefaultSFSDataSerializer::Instance()->SkipValue(reader);
+			}
+		}
+	}
+
+	// -------------------------------------------------------------------
+	// ReadClassFields
+	// -------------------------------------------------------------------
+	template <class T>
+	void SFSStructCodec<T>::ReadClassFields(ByteReader& reader, T& value)
+	{
+		SFSStructInput::ReadType(reader, SFSDATATYPE_SFS_ARRAY);
+		boost::int32_t size = SFSStructInput::ReadSize(reader, 0);
+
+		for (boost::int32_t i = 0; i < size; i++)
+		{
+			SFSStructInput::ReadType(reader, SFSDATATYPE_SFS_OBJECT);
+			boost::int32_t entries = SFSStructInput::ReadSize(reader, 0);
+
+			// N and V can come in any order: the value is decoded once the name is known
+			const char* name = NULL;
+			long int nameLength = 0;
+			ByteReader valueReader = reader;
+			bool hasValue = false;
+
+			for (boost::int32_t j = 0; j < entries; j++)
+			{
+				long int length;
+				const char* key = SFSStructInput::ReadKey(reader, length);
+
+				if (SFSStructInput::IsKey(key, length, "N", 1))
+				{
+					SFSStructInput::ReadType(reader, SFSDATATYPE_UTF_STRING);
+					name = SFSStructInput::ReadKey(reader, nameLength);
+				}
+				else
+				{
+					if (SFSStructInput::IsKey(key, length, "V", 1))
+					{
+						valueReader = reader;
+						hasValue = true;
+					}
+
+					DefaultSFSDataSerializer::Instance()->SkipValue(reader);
+				}
+			}
+
+			if (name != NULL && hasValue)
+			{
+				FieldReader fieldReader (valueReader, name, nameLength);
+				value.SFSFields(fieldReader);
+			}
+		}
+	}
+
+	// -------------------------------------------------------------------
+	// WriteKey
+	// -------------------------------------------------------------------
+	template <class T>
+	void SFSStructCodec<T>::WriteKey(ByteArray& buffer, const char* name, long int nameLength)
+	{
+		ByteWriter writer = buffer.Writer(2 + nameLength);
+		writer.WriteUShort((unsigned short int)nameLength);
+		writer.WriteBytes((const unsigned char*)name, nameLength);
+	}
+
+}	// namespace Serialization
+}	// namespace Protocol
+}	// namespace Sfs2X
+
+#endif
@@ -16,6 +16,7 @@ namespace Requests {
 boost::shared_ptr<string> ExtensionRequest::KEY_CMD (new string("c"));
 boost::shared_ptr<string> ExtensionRequest::KEY_PARAMS (new string("p"));
 boost::shared_ptr<string> ExtensionRequest::KEY_ROOM (new string("r"));
+boost::shared_ptr<string> ExtensionRequest::KEY_REQUEST_ID (new string("__rid"));
 
 // -------------------------------------------------------------------
 // Constructor
@@ -62,6 +63,7 @@ void ExtensionRequest::Init(string extCmd, boost::shared_ptr<ISFSObject> paramet
 	this->parameters = parameters;
 	this->room = room;
 	this->useUDP = useUDP;
+	this->requestId = 0;
 			
 	// New since 0.9.6
 	if (parameters == NULL)
@@ -76,6 +78,30 @@ bool ExtensionRequest::UseUDP()
 	return useUDP;
 }
 
+// -------------------------------------------------------------------
+// Cmd
+// -------------------------------------------------------------------
+boost::shared_ptr<string> ExtensionRequest::Cmd()
+{
+	return extCmd;
+}
+
+// -------------------------------------------------------------------
+// RequestId
+// -------------------------------------------------------------------
+long int ExtensionRequest::RequestId()
+{
+	return requestId;
+}
+
+// -------------------------------------------------------------------
+// RequestId
+// -------------------------------------------------------------------
+void ExtensionRequest::RequestId(long int value)
+{
+	requestId = value;
+}
+
 // -------------------------------------------------------------------
 // Validate
 // -------------------------------------------------------------------
@@ -107,7 +133,40 @@ void ExtensionRequest::Execute (boost::shared_ptr<SmartFox> sfs)
 	boost::shared_ptr<long> valueId (new long());
 	*valueId = room == NULL ? -1 : room->Id();
 	sfso->PutInt(KEY_ROOM, valueId);
-	sfso->PutSFSObject(KEY_PARAMS, parameters);
+
+	if (requestId == 0)
+	{
+		sfso->PutSFSObject(KEY_PARAMS, parameters);
+		return;
+	}
+
+	// The id goes into a shallow copy of the parameters: the caller's object can be sent again without it.
+	// It is stored first, so that it takes precedence over a stale id found in the parameters
+	boost::shared_ptr<SFSObject> requestParameters = SFSObject::NewInstance();
+	boost::shared_ptr<SFSObject> callerParameters = boost::dynamic_pointer_cast<SFSObject>(parameters);
+
+	requestParameters->Reserve(parameters->Size() + 1);
+	requestParameters->PutInt(*KEY_REQUEST_ID, requestId);
+
+	if (callerParameters != NULL)
+	{
+		for (long int index = 0; index < callerParameters->Size(); index++)
+		{
+			requestParameters->PutValue(callerParameters->KeyAt(index), callerParameters->ValueAt(index));
+		}
+	}
+	else
+	{
+		boost::shared_ptr<vector<string> > keys = parameters->GetKeys();
+
+		vector<string>::iterator iterator;
+		for (iterator = keys->begin(); iterator != keys->end(); iterator++)
+		{
+			requestParameters->Put(*iterator, parameters->GetData(*iterator));
+		}
+	}
+
+	sfso->PutSFSObject(KEY_PARAMS, requestParameters);
 }
 
 }	// namespace Requests
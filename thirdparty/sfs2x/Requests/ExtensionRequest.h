@@ -114,6 +114,22 @@ namespace Requests {
 		virtual ~ExtensionRequest();
 
 		bool UseUDP();
+
+		/// <summary>
+		/// The command name
+		/// </summary>
+		boost::shared_ptr<string> Cmd();
+
+		/// <summary>
+		/// The id that correlates the request with its response, 0 when none
+		/// </summary>
+		/// <remarks>
+		/// A request with an id carries it in a copy of its parameters, under <see cref="KEY_REQUEST_ID"/>; the parameters passed to the constructor are left unchanged.
+		/// The id is assigned by <see cref="Sfs2X.SmartFox.SendAsync"/>.
+		/// </remarks>
+		long int RequestId();
+		void RequestId(long int value);
+
 		void Validate(boost::shared_ptr<SmartFox> sfs);
 		void Execute (boost::shared_ptr<SmartFox> sfs);
 
@@ -125,6 +141,14 @@ namespace Requests {
 		static boost::shared_ptr<string> KEY_PARAMS;
 		static boost::shared_ptr<string> KEY_ROOM;
 
+		/// <summary>
+		/// Key of the request id in the parameters of a request sent by <see cref="Sfs2X.SmartFox.SendAsync"/>
+		/// </summary>
+		/// <remarks>
+		/// The server side Extension must copy the value into the parameters of its response, under the same key.
+		/// </remarks>
+		static boost::shared_ptr<string> KEY_REQUEST_ID;
+
 	protected:
 
 		// -------------------------------------------------------------------
@@ -150,6 +174,7 @@ namespace Requests {
 		boost::shared_ptr<ISFSObject> parameters;
 		boost::shared_ptr<Room> room;		
 		bool useUDP;
+		long int requestId;
 
 	};
 
@@ -53,7 +53,7 @@ void CreateSFSGameRequest::Validate(boost::shared_ptr<SmartFox> sfs)
 	try {
 		createRoomRequest->Validate(sfs);
 	}
-	catch(SFSValidationError err) {
+	catch(SFSValidationError& err) {
 		// Take the current errors and continue checking...
 		errors = err.Errors();
 	}
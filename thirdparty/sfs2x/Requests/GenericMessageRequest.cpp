@@ -233,6 +233,9 @@ void GenericMessageRequest::ValidateSuperUserMessage(boost::shared_ptr<SmartFox>
 			errors->push_back("TO_GROUP expects a String object (the groupId) as recipient");
 		}
 		break;
+	default:
+		// TO_ZONE does not need a recipient
+		break;
 	}
 
 }
@@ -348,6 +351,8 @@ void GenericMessageRequest::ExecuteSuperUserMessage(boost::shared_ptr<SmartFox>
 			sfso->PutUtfString(KEY_RECIPIENT, recipientString);
 			break;
 		// the TO_ZONE case does not need to pass any other params
+		default:
+			break;
 	}
 }
 
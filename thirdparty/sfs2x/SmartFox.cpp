@@ -12,6 +12,7 @@
 #include "Requests/ManualDisconnectionRequest.h"
 #include "Requests/HandshakeRequest.h"
 #include "Requests/JoinRoomRequest.h"
+#include "Requests/ExtensionRequest.h"
 #include "Entities/Managers/SFSGlobalUserManager.h"
 #include "Entities/Managers/SFSRoomManager.h"
 #include "Entities/Managers/SFSBuddyManager.h"
@@ -30,6 +31,7 @@ SmartFox::SmartFox()
 {
 	service = boost::shared_ptr<boost::asio::io_service>(new boost::asio::io_service());
 	disconnectTimer = boost::shared_ptr<boost::asio::deadline_timer> (new boost::asio::deadline_timer(*service));
+	hostResolver = boost::shared_ptr<HostResolver>(new HostResolver());
 
 	dispatcher = boost::shared_ptr<EventDispatcher>();
 	inited = false;
@@ -44,6 +46,7 @@ SmartFox::SmartFox(bool debug)
 {
 	service = boost::shared_ptr<boost::asio::io_service>(new boost::asio::io_service());
 	disconnectTimer = boost::shared_ptr<boost::asio::deadline_timer>(new boost::asio::deadline_timer(*service));
+	hostResolver = boost::shared_ptr<HostResolver>(new HostResolver());
 	
 	dispatcher = boost::shared_ptr<EventDispatcher>();
 	inited = false;
@@ -81,6 +84,12 @@ void SmartFox::Dispose()
 	//ClientDisconnectionReason::Dispose();			This object is not disposed because it contains static fields
 	//SFSErrorCodes::Dispose();						This object is not disposed because it contains static fields
 
+	// Stop the lookups first, so that none completes on a disposed client
+	if (hostResolver != NULL)
+	{
+		hostResolver->Dispose();
+	}
+
 	if (disconnectTimer != NULL)
 	{
 		disconnectTimer->cancel();
@@ -129,10 +138,17 @@ void SmartFox::Dispose()
 		lagMonitor = boost::shared_ptr<Sfs2X::Util::LagMonitor>();
 	}
 
+	if (requestCorrelator != NULL)
+	{
+		requestCorrelator->Dispose();
+		requestCorrelator = boost::shared_ptr<Sfs2X::Util::RequestCorrelator>();
+	}
+
 	mySelf = boost::shared_ptr<User>();
 	lastJoinedRoom = boost::shared_ptr<Room>();
 	sessionToken = boost::shared_ptr<string>();
 	lastIpAddress = boost::shared_ptr<string>();
+	lastIpAddresses = boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >();
 	currentZone = boost::shared_ptr<string>();
 }
 
@@ -150,10 +166,13 @@ void SmartFox::Initialize()
 
 	clientDetails = boost::shared_ptr<string>(new string("C++ API"));
 	useBlueBox = true;
+	useWebSocket = false;
 	forceIPv6 = false;
 	isJoining = false;
 	threadSafeMode = true;
 	isConnecting = false;
+	connectingPort = -1;
+	connectingUdpPort = -1;
 	autoConnectOnConfig = false;
 	eventsLocker = boost::shared_ptr<SynchronizationObject>(new SynchronizationObject());
 	eventsQueue = boost::shared_ptr<vector<boost::shared_ptr<BaseEvent> > >(new vector<boost::shared_ptr<BaseEvent> >());
@@ -164,6 +183,7 @@ void SmartFox::Initialize()
 	if (debug) log->LoggingLevel(LOGLEVEL_DEBUG);
 
 	lagMonitor = boost::shared_ptr<Sfs2X::Util::LagMonitor>();
+	requestCorrelator = boost::shared_ptr<Sfs2X::Util::RequestCorrelator>();
 	config = boost::shared_ptr<ConfigData>(new ConfigData());
 
 	if (dispatcher == NULL) 
@@ -178,6 +198,7 @@ void SmartFox::Initialize()
 	buddyManager = boost::shared_ptr<IBuddyManager>();
 	sessionToken = boost::shared_ptr<string>();
 	lastIpAddress = boost::shared_ptr<string>();
+	lastIpAddresses = boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > >();
 	currentZone = boost::shared_ptr<string>();
 
 	bitSwarm = boost::shared_ptr<BitSwarmClient>(new BitSwarmClient(shared_from_this()));
@@ -330,6 +351,72 @@ void SmartFox::EnableLagMonitor(bool enabled, long int interval)
 	EnableLagMonitor(enabled, interval, 10);
 }
 
+// -------------------------------------------------------------------
+// EnableFastReconnection
+// -------------------------------------------------------------------
+void SmartFox::EnableFastReconnection(bool enabled, long int bufferSize)
+{
+	bitSwarm->EnableFastReconnection(enabled, bufferSize);
+}
+
+// -------------------------------------------------------------------
+// EnableFastReconnection
+// -------------------------------------------------------------------
+void SmartFox::EnableFastReconnection(bool enabled)
+{
+	EnableFastReconnection(enabled, 100);
+}
+
+// -------------------------------------------------------------------
+// StartPacketCapture
+// -------------------------------------------------------------------
+bool SmartFox::StartPacketCapture(string fileName)
+{
+	if (inited == false)
+	{
+		Initialize();
+	}
+
+	boost::shared_ptr<PacketCapture> capture (new PacketCapture());
+	if (!capture->Open(fileName))
+	{
+		return false;
+	}
+
+	StopPacketCapture();
+	bitSwarm->PacketCapture(capture);
+
+	return true;
+}
+
+// -------------------------------------------------------------------
+// StopPacketCapture
+// -------------------------------------------------------------------
+void SmartFox::StopPacketCapture()
+{
+	if (bitSwarm == NULL || bitSwarm->PacketCapture() == NULL)
+	{
+		return;
+	}
+
+	boost::shared_ptr<PacketCapture> capture = bitSwarm->PacketCapture();
+	bitSwarm->PacketCapture(boost::shared_ptr<PacketCapture>());
+	capture->Close();
+}
+
+// -------------------------------------------------------------------
+// EnablePacketArena
+// -------------------------------------------------------------------
+void SmartFox::EnablePacketArena(bool enabled)
+{
+	if (inited == false)
+	{
+		Initialize();
+	}
+
+	bitSwarm->UsePacketArena(enabled);
+}
+
 // -------------------------------------------------------------------
 // IsConnecting
 // -------------------------------------------------------------------
@@ -433,6 +520,29 @@ void SmartFox::UseBlueBox(bool value)
 	useBlueBox = value;
 }
 
+// -------------------------------------------------------------------
+// UseWebSocket
+// -------------------------------------------------------------------
+bool SmartFox::UseWebSocket()
+{
+	return useWebSocket;
+}
+
+// -------------------------------------------------------------------
+// UseWebSocket
+// -------------------------------------------------------------------
+void SmartFox::UseWebSocket(bool value)
+{
+	// Due to shared pointer the Initialize method cannot be invoked into class constructor
+	// so if not yet called by API user, we invoke it in main class methods
+	if (inited == false)
+	{
+		Initialize();
+	}
+
+	useWebSocket = value;
+}
+
 // -------------------------------------------------------------------
 // ForceIPv6
 // -------------------------------------------------------------------
@@ -562,27 +672,58 @@ void SmartFox::Connect(string host, long int port)
 		boost::throw_exception(boost::enable_error_info (std::runtime_error("Invalid connection port"))); 
 	}
 
+	// Resolve hostname without blocking the caller, the connection starts in OnHostResolved
+	// Note that user has provided an ip address instead of an host name, resolver returns the address itself at once
+	isConnecting = true;
+	connectingHost = host;
+	connectingPort = port;
+
+	boost::shared_ptr<HostResolvedDelegate> callback (new HostResolvedDelegate(&SmartFox::OnHostResolved, (unsigned long long)this));
+
+	if (PollMode() == true)
+	{
+		// No resolver thread may run the callback in poll mode: the lookup completes within a later Poll
+		hostResolver->ResolveAsync(host, (this->Config() != NULL ? this->Config()->ForceIPv6() : forceIPv6), *(bitSwarm->GetBoostService()), callback);
+		return;
+	}
+
+	hostResolver->ResolveAsync(host, (this->Config() != NULL ? this->Config()->ForceIPv6() : forceIPv6), callback);
+}
+
+// -------------------------------------------------------------------
+// OnHostResolved
+// -------------------------------------------------------------------
+void SmartFox::OnHostResolved(unsigned long long context, boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, boost::shared_ptr<string> error)
+{
+	// Map context
+	SmartFox* instance = (SmartFox*)context;
+
 	try
 	{
-		// Resolve hostname 
-		// Note that user has provided an ip address instead of an host name, resolver returns the address itself
-		boost::shared_ptr<string> endpointAddress = GetIPAddress(host, port);
+		if (error != NULL)
+		{
+			boost::throw_exception(boost::enable_error_info (std::runtime_error(*error))); 
+		}
 
 		// All fine and dandy, let's proceed with the connection
-		//lastIpAddress = boost::shared_ptr<string>(new string(host));
-		lastIpAddress = boost::shared_ptr<string>(endpointAddress);
-		isConnecting = true;
+		// Every address is attempted, the preferred one is reported as the connection address
+		instance->lastIpAddress = boost::shared_ptr<string>(new string(*(addresses->front()->Address())));
+		instance->lastIpAddresses = addresses;
 
-		bitSwarm->Connect(endpointAddress, (unsigned short int)port);
+		// A new connection tries the socket first, even if the previous one fell back to the WebSocket
+		instance->bitSwarm->ForceWebSocket(false, false);
+		instance->bitSwarm->Connect(addresses, (unsigned short int)instance->connectingPort);
 	}
-	catch (exception e)
+	catch (const exception& e)
 	{
+		instance->isConnecting = false;
+
 		boost::shared_ptr<string> messageException(new string(e.what()));
 		boost::shared_ptr<string> message(new string("Error creating connection: " + (*messageException)));
 
 		boost::shared_ptr<vector<string> > logMessages(new vector<string>());
 		logMessages->push_back(message->c_str());
-		log->Warn(logMessages);
+		instance->log->Warn(logMessages);
 	}
 }
 
@@ -591,30 +732,24 @@ void SmartFox::Connect(string host, long int port)
 // -------------------------------------------------------------------
 boost::shared_ptr<string> SmartFox::GetIPAddress(string host, long int port)
 {
-	// Resolve hostname 
+	// Resolve hostname, or take it from the cache shared with the socket connections
+	// The cache is warmed by Connect, which resolves the same host; an expired entry is still returned and refreshed in background
 	// Note that user has provided an ip address instead of an host name, resolver returns the address itself
-    tcp::resolver resolver(*service);
-
-	boost::shared_ptr<string> portAsString (new string());
-	boost::shared_ptr<string> format (new string("%d"));
-	StringFormatter<long int> (portAsString, format, port);
+	boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses = hostResolver->Resolve(host, (this->Config() != NULL ? this->Config()->ForceIPv6() : forceIPv6));
 
-	tcp::resolver::query query((this->Config() != NULL ? this->Config()->ForceIPv6() : forceIPv6) == false ? tcp::v4() : tcp::v6(), host, *portAsString);
-	tcp::resolver::iterator iterator = resolver.resolve(query);
-	tcp::resolver::iterator end;
-
-	if (iterator == end)
-	{
-		boost::throw_exception(boost::enable_error_info(std::runtime_error("Unable to get IP address")));
-	}
-
-	tcp::endpoint endpoint = *iterator;
-
-	boost::shared_ptr<string> endpointAddress (new string(endpoint.address().to_string()));
+	boost::shared_ptr<string> endpointAddress (new string(*(addresses->front()->Address())));
 
 	return endpointAddress;
 }
 
+// -------------------------------------------------------------------
+// GetHostResolver
+// -------------------------------------------------------------------
+boost::shared_ptr<HostResolver> SmartFox::GetHostResolver()
+{
+	return hostResolver;
+}
+
 // -------------------------------------------------------------------
 // Connect
 // -------------------------------------------------------------------
@@ -882,58 +1017,66 @@ void SmartFox::InitUDP(string udpHost, short int udpPort)
 		boost::throw_exception(boost::enable_error_info (std::runtime_error("Invalid UDP port range"))); 
 
 	// If user supplied a hostname, then lets lookup as bitclient requires IP
-	// Resolve hostname 
-	// Note that user has provided an ip address instead of an host name, resolver returns the address itself
-	try {
-		tcp::resolver resolver(*service);
-
-		boost::shared_ptr<string> portAsString (new string());
-		boost::shared_ptr<string> format (new string("%d"));
-		StringFormatter<long int> (portAsString, format, udpPort);
+	// Resolve hostname without blocking the caller, the initialization continues in OnUdpHostResolved
+	// Note that user has provided an ip address instead of an host name, resolver returns the address itself at once
+	// The UDP client is given the address, so it needs no lookup of its own
+	connectingUdpHost = udpHost;
+	connectingUdpPort = udpPort;
 
-		tcp::resolver::query query((this->Config() != NULL ? this->Config()->ForceIPv6() : forceIPv6) == false ? tcp::v4() : tcp::v6(), udpHost, *portAsString);
-		
-		tcp::resolver::iterator iterator = resolver.resolve(query);
-		tcp::endpoint endpoint = *iterator;
+	boost::shared_ptr<HostResolvedDelegate> callback (new HostResolvedDelegate(&SmartFox::OnUdpHostResolved, (unsigned long long)this));
 
-		string endpointAddress = endpoint.address().to_string();
-		unsigned short int endpointPort = endpoint.port();
+	if (PollMode() == true)
+	{
+		hostResolver->ResolveAsync(udpHost, (this->Config() != NULL ? this->Config()->ForceIPv6() : forceIPv6), *(bitSwarm->GetBoostService()), callback);
+		return;
 	}
-	catch(exception ex) {
 
-		boost::shared_ptr<string> message (new string(ex.what()));
+	hostResolver->ResolveAsync(udpHost, (this->Config() != NULL ? this->Config()->ForceIPv6() : forceIPv6), callback);
+}
 
+// -------------------------------------------------------------------
+// OnUdpHostResolved
+// -------------------------------------------------------------------
+void SmartFox::OnUdpHostResolved(unsigned long long context, boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, boost::shared_ptr<string> error)
+{
+	// Map context
+	SmartFox* instance = (SmartFox*)context;
+
+	if (error != NULL)
+	{
 		char buffer[512];
-		sprintf (buffer, "Failed to lookup hostname %s. UDP init failed. Reason %s", udpHost.c_str(), message->c_str());
+		sprintf (buffer, "Failed to lookup hostname %s. UDP init failed. Reason %s", instance->connectingUdpHost.c_str(), error->c_str());
 		string logMessage = buffer;
 
 		boost::shared_ptr<vector<string> > logMessages (new vector<string>());
 		logMessages->push_back(logMessage);
-		log->Error(logMessages);
+		instance->log->Error(logMessages);
 
 		boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
 		boost::shared_ptr<bool> value (new bool());
 		*value = false;
 		evtParams->insert(pair<string, boost::shared_ptr<void> >("success", value));
 		boost::shared_ptr<SFSEvent> evt (new SFSEvent(SFSEvent::UDP_INIT, evtParams));
-		DispatchEvent(evt);
+		instance->DispatchEvent(evt);
 		return;
 	}
 
+	string udpHost = *(addresses->front()->Address());
+
 	/*
 	* If it's already inited with success we don't allow re-assigning a new UDP manager
 	*/
-	if (bitSwarm->UdpManager() == NULL || !bitSwarm->UdpManager()->Inited()) {
-		boost::shared_ptr<IUDPManager> manager (new UDPManager(*service, shared_from_this()));
-		bitSwarm->UdpManager(manager);
+	if (instance->bitSwarm->UdpManager() == NULL || !instance->bitSwarm->UdpManager()->Inited()) {
+		boost::shared_ptr<IUDPManager> manager (new UDPManager(*(instance->service), instance->shared_from_this()));
+		instance->bitSwarm->UdpManager(manager);
 	}
 
 	// Attempt initialization
 
 	try {
-		bitSwarm->UdpManager()->Initialize(udpHost, udpPort);
+		instance->bitSwarm->UdpManager()->Initialize(udpHost, instance->connectingUdpPort);
 	}
-	catch (exception ex) {
+	catch (const exception& ex) {
 		boost::shared_ptr<string> message (new string(ex.what()));
 
 		char buffer[512];
@@ -942,7 +1085,7 @@ void SmartFox::InitUDP(string udpHost, short int udpPort)
 
 		boost::shared_ptr<vector<string> > logMessages (new vector<string>());
 		logMessages->push_back(logMessage);
-		log->Error(logMessages);
+		instance->log->Error(logMessages);
 	}
 }
 
@@ -1021,9 +1164,26 @@ void SmartFox::SetReconnectionSeconds(long int seconds)
 // Send
 // -------------------------------------------------------------------
 void SmartFox::Send(boost::shared_ptr<IRequest> request)
+{
+	Send(request, boost::shared_ptr<string>());
+}
+
+// -------------------------------------------------------------------
+// Send
+// -------------------------------------------------------------------
+void SmartFox::Send(boost::shared_ptr<IRequest> request, boost::shared_ptr<string> replacementKey)
+{
+	SendRequest(request, replacementKey);
+}
+
+// -------------------------------------------------------------------
+// SendRequest
+// -------------------------------------------------------------------
+bool SmartFox::SendRequest(boost::shared_ptr<IRequest> request, boost::shared_ptr<string> replacementKey)
 {
 	// Handshake is an exception, during a reconnection attempt
-	if (!IsConnected()) 
+	// With fast reconnection enabled requests are accepted during the outage and held until the session is resumed
+	if (!IsConnected() && !(bitSwarm != NULL && bitSwarm->IsBufferingMessages())) 
 	{
 		boost::shared_ptr<vector<string> > logMessages (new vector<string>());
 		boost::shared_ptr<string> logMessage (new string());
@@ -1034,7 +1194,7 @@ void SmartFox::Send(boost::shared_ptr<IRequest> request)
 		logMessages->push_back(*logMessage);
 		log->Warn(logMessages);
 
-		return;
+		return false;
 	}
 	
 	try 
@@ -1042,7 +1202,7 @@ void SmartFox::Send(boost::shared_ptr<IRequest> request)
 		// Activate joining flag
 		if (dynamic_cast<JoinRoomRequest*>(request.get()) != NULL) {
 			if (isJoining) {
-				return;
+				return false;
 			}		
 			else {
 				isJoining = true;
@@ -1056,9 +1216,12 @@ void SmartFox::Send(boost::shared_ptr<IRequest> request)
 		request->Execute(shared_from_this());
 				
 		// Send request to SmartFoxServer2X
-		bitSwarm->Send(request->Message());
+		boost::shared_ptr<IMessage> message = request->Message();
+		message->ReplacementKey(replacementKey);
+
+		bitSwarm->Send(message);
 		}
-		catch (SFSValidationError problem) 
+		catch (SFSValidationError& problem) 
 		{
 			boost::shared_ptr<vector<string> > logMessages (new vector<string>());
 
@@ -1072,15 +1235,21 @@ void SmartFox::Send(boost::shared_ptr<IRequest> request)
 			}
 				
 			log->Warn(logMessages);
+
+			return false;
 		}
-		catch (SFSCodecError error) 
+		catch (SFSCodecError& error) 
 		{
 			boost::shared_ptr<vector<string> > logMessages (new vector<string>());
 
 			logMessages->push_back(*(error.Message()));
 
 			log->Warn(logMessages);
+
+			return false;
 		}
+
+	return true;
 }
 
 // -------------------------------------------------------------------
@@ -1159,6 +1328,7 @@ void SmartFox::ValidateConfig(boost::shared_ptr<ConfigData> cfg)
 	this->config = cfg;
 	this->debug = cfg->Debug();
 	this->useBlueBox = cfg->UseBlueBox();
+	this->useWebSocket = cfg->UseWebSocket();
 }
 
 // -------------------------------------------------------------------
@@ -1336,6 +1506,7 @@ void SmartFox::OnConfigLoadSuccess(unsigned long long context, boost::shared_ptr
 	instance->debug = cfgData->Debug();
 				
 	instance->useBlueBox = cfgData->UseBlueBox();
+	instance->useWebSocket = cfgData->UseWebSocket();
 	instance->forceIPv6 = cfgData->ForceIPv6();
 
 	// Fire event
@@ -1395,9 +1566,9 @@ void SmartFox::HandleHandShake(boost::shared_ptr<BaseEvent> evt)
 	// Success
 	if (obj->IsNull(*BaseRequest::KEY_ERROR_CODE)) 
 	{
-		sessionToken = boost::shared_ptr<string>(new string(*(obj->GetUtfString(*HandshakeRequest::KEY_SESSION_TOKEN))));
-		bitSwarm->CompressionThreshold(*(obj->GetInt(*HandshakeRequest::KEY_COMPRESSION_THRESHOLD)));
-		bitSwarm->MaxMessageSize(*(obj->GetInt(*HandshakeRequest::KEY_MAX_MESSAGE_SIZE)));
+		sessionToken = boost::shared_ptr<string>(new string(obj->GetUtfStringOr(*HandshakeRequest::KEY_SESSION_TOKEN, string())));
+		bitSwarm->CompressionThreshold(obj->GetIntOr(*HandshakeRequest::KEY_COMPRESSION_THRESHOLD, 0));
+		bitSwarm->MaxMessageSize(obj->GetIntOr(*HandshakeRequest::KEY_MAX_MESSAGE_SIZE, 0));
 		
 		if (debug) 
 		{
@@ -1414,7 +1585,8 @@ void SmartFox::HandleHandShake(boost::shared_ptr<BaseEvent> evt)
 				
 		if (bitSwarm->IsReconnecting())
 		{
-			bitSwarm->IsReconnecting(false);
+			// Closes the reconnection window, updates the timing metrics and replays the requests held during the outage
+			bitSwarm->CompleteReconnection();
 					
 			/*
 			* Reconnection success
@@ -1533,9 +1705,24 @@ void SmartFox::HttpPort(unsigned short int httpPort)
 // -------------------------------------------------------------------
 void SmartFox::HandleConnectionProblem(boost::shared_ptr<BaseEvent> e)
 {
-	// Socket failed, attempt using the BBox if it's connection
-	if (bitSwarm->ConnectionMode() == ConnectionModes::SOCKET && useBlueBox)
+	// Socket failed, attempt using a WebSocket on the http port first
+	if (bitSwarm->ConnectionMode() == ConnectionModes::SOCKET && useWebSocket)
+	{
+		bool useSSL = (config != NULL) ? config->WebSocketSSL() : false;
+		unsigned short int wsPort = (config != NULL) ? (useSSL ? config->HttpsPort() : config->HttpPort()) : (useSSL ? DEFAULT_HTTPS_PORT : DEFAULT_HTTP_PORT);
+
+		// The WebSocket names the server by its host name, which virtual hosts and reverse proxies route by
+		bitSwarm->ForceWebSocket(true, useSSL, connectingHost);
+		bitSwarm->Connect(lastIpAddresses, wsPort);
+
+		boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
+		boost::shared_ptr<SFSEvent> evt (new SFSEvent(SFSEvent::CONNECTION_ATTEMPT_HTTP, evtParams));
+		DispatchEvent(evt);
+	}
+	// Socket or WebSocket failed, attempt using the BBox if it's connection
+	else if ((bitSwarm->ConnectionMode() == ConnectionModes::SOCKET || bitSwarm->ConnectionMode() == ConnectionModes::WEBSOCKET) && useBlueBox)
 	{
+		bitSwarm->ForceWebSocket(false, false);
 		bitSwarm->ForceBlueBox(true);
 		unsigned short int bbPort = (config != NULL) ? config->HttpPort() : DEFAULT_HTTP_PORT;
 		bitSwarm->Connect(lastIpAddress, bbPort);
@@ -1546,6 +1733,7 @@ void SmartFox::HandleConnectionProblem(boost::shared_ptr<BaseEvent> e)
 	}
 	else 
 	{
+		bitSwarm->ForceWebSocket(false, false);
 		bitSwarm->ForceBlueBox(false);
 
 		boost::shared_ptr<BitSwarmEvent> evt = (boost::static_pointer_cast<BitSwarmEvent>)(e);
@@ -1591,6 +1779,11 @@ void SmartFox::DispatchEvent(boost::shared_ptr<BaseEvent> evt)
 {
 	if (!threadSafeMode) 
 	{
+		if (requestCorrelator != NULL)
+		{
+			requestCorrelator->HandleEvent(evt);
+		}
+
 		Dispatcher()->DispatchEvent(evt);
 
 		// Cleanup
@@ -1640,6 +1833,12 @@ void SmartFox::ProcessEvents()
 	for (iterator = events.begin() ; iterator < events.end(); iterator++)
 	{
 		boost::shared_ptr<BaseEvent> evt = *iterator;
+
+		if (requestCorrelator != NULL)
+		{
+			requestCorrelator->HandleEvent(evt);
+		}
+
 		Dispatcher()->DispatchEvent(evt);
 
 		// Cleanup
@@ -1649,6 +1848,156 @@ void SmartFox::ProcessEvents()
 	events.clear();
 }
 
+// -------------------------------------------------------------------
+// PollMode
+// -------------------------------------------------------------------
+bool SmartFox::PollMode()
+{
+	return (bitSwarm != NULL) && bitSwarm->PollMode();
+}
+
+// -------------------------------------------------------------------
+// PollMode
+// -------------------------------------------------------------------
+void SmartFox::PollMode(bool value)
+{
+	// Due to shared pointer the Initialize method cannot be invoked into class constructor
+	// so if not yet called by API user, we invoke it in main class methods
+	if (inited == false)
+	{
+		Initialize();
+	}
+
+	bitSwarm->PollMode(value);
+}
+
+// -------------------------------------------------------------------
+// Poll
+// -------------------------------------------------------------------
+long int SmartFox::Poll(long int timeout)
+{
+	if (PollMode() == false)
+	{
+		return 0;
+	}
+
+	long int processed = bitSwarm->Poll(timeout);
+
+	// In thread safe mode the listeners run here, still within the poll
+	ProcessEvents();
+
+	return processed;
+}
+
+// -------------------------------------------------------------------
+// PendingSendBytes
+// -------------------------------------------------------------------
+long int SmartFox::PendingSendBytes()
+{
+	return (bitSwarm != NULL) ? bitSwarm->PendingSendBytes() : 0;
+}
+
+// -------------------------------------------------------------------
+// SendWatermarks
+// -------------------------------------------------------------------
+void SmartFox::SendWatermarks(long int highWatermark, long int lowWatermark)
+{
+	// Due to shared pointer the Initialize method cannot be invoked into class constructor
+	// so if not yet called by API user, we invoke it in main class methods
+	if (inited == false)
+	{
+		Initialize();
+	}
+
+	bitSwarm->SendWatermarks(highWatermark, lowWatermark);
+}
+
+// -------------------------------------------------------------------
+// SendHighWatermark
+// -------------------------------------------------------------------
+long int SmartFox::SendHighWatermark()
+{
+	return (bitSwarm != NULL) ? bitSwarm->SendHighWatermark() : 0;
+}
+
+// -------------------------------------------------------------------
+// SendLowWatermark
+// -------------------------------------------------------------------
+long int SmartFox::SendLowWatermark()
+{
+	return (bitSwarm != NULL) ? bitSwarm->SendLowWatermark() : 0;
+}
+
+// -------------------------------------------------------------------
+// SendAsync
+// -------------------------------------------------------------------
+long int SmartFox::SendAsync(boost::shared_ptr<IRequest> request, boost::shared_ptr<ExtensionResponseDelegate> callback)
+{
+	return SendAsync(request, callback, Sfs2X::Util::RequestCorrelator::DEFAULT_TIMEOUT);
+}
+
+// -------------------------------------------------------------------
+// SendAsync
+// -------------------------------------------------------------------
+long int SmartFox::SendAsync(boost::shared_ptr<IRequest> request, boost::shared_ptr<ExtensionResponseDelegate> callback, long int timeout)
+{
+	boost::shared_ptr<ExtensionRequest> extensionRequest = boost::dynamic_pointer_cast<ExtensionRequest>(request);
+	if (extensionRequest == NULL)
+	{
+		boost::shared_ptr<vector<string> > logMessages (new vector<string>());
+		logMessages->push_back("Only extension requests can be sent asynchronously");
+		log->Warn(logMessages);
+
+		return 0;
+	}
+
+	// Send reports the request that cannot be sent
+	if (!IsConnected() && !(bitSwarm != NULL && bitSwarm->IsBufferingMessages()))
+	{
+		Send(request);
+		return 0;
+	}
+
+	if (requestCorrelator == NULL)
+	{
+		requestCorrelator = boost::shared_ptr<Sfs2X::Util::RequestCorrelator>(new Sfs2X::Util::RequestCorrelator(*service, shared_from_this()));
+	}
+
+	// The request is tracked before it is sent, as its response can arrive on another thread
+	long int requestId = requestCorrelator->Track(extensionRequest->Cmd(), callback, timeout);
+	extensionRequest->RequestId(requestId);
+
+	// A request that is not sent would wait for its timeout, or forever without one.
+	// The requests throw their validation errors as shared pointers, which reach the caller as they do from Send
+	bool isSent = false;
+
+	try
+	{
+		isSent = SendRequest(request, boost::shared_ptr<string>());
+	}
+	catch (...)
+	{
+		requestCorrelator->Reject(requestId);
+		throw;
+	}
+
+	if (!isSent)
+	{
+		requestCorrelator->Reject(requestId);
+		return 0;
+	}
+
+	return requestId;
+}
+
+// -------------------------------------------------------------------
+// CancelAsync
+// -------------------------------------------------------------------
+bool SmartFox::CancelAsync(long int requestId)
+{
+	return (requestCorrelator != NULL) && requestCorrelator->Cancel(requestId);
+}
+
 // -------------------------------------------------------------------
 // CleanEventParams
 // -------------------------------------------------------------------
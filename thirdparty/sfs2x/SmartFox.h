@@ -29,6 +29,8 @@ using namespace std;					// STL library: declare the STL namespace
 #include "Bitswarm/BitSwarmEvent.h"
 #include "Util/EventDispatcher.h"
 #include "Core/SFSIOHandler.h"
+#include "Core/PacketCapture.h"
+#include "Core/Sockets/HostResolver.h"
 #include "Core/BaseEvent.h"
 #include "Core/SFSEvent.h"
 #include "Core/IDispatchable.h"
@@ -45,6 +47,7 @@ using namespace std;					// STL library: declare the STL namespace
 #include "Util/ConfigData.h"
 #include "Util/ConfigLoader.h"
 #include "Util/LagMonitor.h"
+#include "Util/RequestCorrelator.h"
 
 #include <boost/exception/exception.hpp>
 #include <boost/exception/all.hpp>
@@ -58,6 +61,7 @@ using namespace Sfs2X::Entities;
 using namespace Sfs2X::Entities::Data;
 using namespace Sfs2X::Requests;
 using namespace Sfs2X::Core;
+using namespace Sfs2X::Core::Sockets;
 using namespace Sfs2X::Logging;
 using namespace Sfs2X::Exceptions;
 using namespace Sfs2X::Entities::Managers;
@@ -183,6 +187,70 @@ namespace Sfs2X {
         /// </summary>
 		void EnableLagMonitor(bool enabled, long int interval);
 
+		/// <summary>
+		/// Enables the fast session resume when the connection is lost and the reconnection feature is available. <br/>
+		/// The socket is reopened immediately instead of waiting on the retry timer; requests sent during the outage are held
+		/// and sent again, in the original order, after the <b>SFSEvent.CONNECTION_RESUME</b> event.
+		/// </summary>
+		/// 
+		/// <remark>
+		/// The encryption key negotiated at login is kept across the reconnection.
+		/// Reconnection timings and counters are available through <see cref="GetSocketEngine"/>.
+		/// </remark>
+		/// 
+		/// <param name='enabled'>
+		/// \code{.cpp} true \endcode to enable the fast session resume, \code{.cpp} false \endcode to restore the default reconnection behavior.
+		/// </param>
+		/// <param name='bufferSize'>
+		/// The maximum number of requests held during the outage; further requests are dropped
+		/// </param>
+		void EnableFastReconnection(bool enabled, long int bufferSize);
+
+        /// <summary>
+        /// <see cref="EnableFastReconnection(bool, long int)"/>
+        /// </summary>
+		void EnableFastReconnection(bool enabled);
+
+		/// <summary>
+		/// Starts recording the raw traffic exchanged with the server to a binary capture file.
+		/// </summary>
+		/// 
+		/// <remark>
+		/// Received data is recorded before any decryption or decompression, sent packets after they have been framed,
+		/// each chunk with a microseconds timestamp; the capture can be replayed offline through the same parsing and dispatching code
+		/// (see the CaptureReplay benchmark). Captures of encrypted sessions can be replayed only with the session key.
+		/// </remark>
+		/// 
+		/// <param name='fileName'>
+		/// The path of the capture file; an existing file is overwritten
+		/// </param>
+		/// 
+		/// <returns>
+		/// \code{.cpp} false \endcode if the file cannot be created
+		/// </returns>
+		bool StartPacketCapture(string fileName);
+
+		/// <summary>
+		/// Stops the packet capture started by <see cref="StartPacketCapture"/> and closes the capture file.
+		/// </summary>
+		void StopPacketCapture();
+
+		/// <summary>
+		/// Decodes each inbound packet into a single memory region instead of one heap allocation per object.
+		/// </summary>
+		/// 
+		/// <remark>
+		/// The objects, arrays and boxed values decoded from a packet are carved from one arena, which is released at once
+		/// when the last of them is released; large room and user lists are then built and torn down with a handful of allocations.
+		/// Keeping any value of a packet (for example a nested SFSObject stored by the application) keeps the memory of the whole packet,
+		/// so copy the values that must outlive the event when the packets are large.
+		/// </remark>
+		/// 
+		/// <param name='enabled'>
+		/// \code{.cpp} true \endcode to decode into per-packet arenas, \code{.cpp} false \endcode to allocate every object on the heap (default)
+		/// </param>
+		void EnablePacketArena(bool enabled);
+
 		bool IsConnecting();
 
 		boost::shared_ptr<BitSwarmClient> GetSocketEngine();
@@ -236,6 +304,19 @@ namespace Sfs2X {
 		bool UseBlueBox();
 		void UseBlueBox(bool value);
 
+		/// <summary>
+		/// Indicates whether the client should attempt a WebSocket connection on the http port in case a socket connection can't be established.
+		/// </summary>
+		/// <remarks>
+		/// The WebSocket carries the same binary protocol of the socket over a single persistent connection, so it is attempted before the BlueBox, which polls the server.
+		/// The connection is encrypted when the <b>WebSocketSSL</b> setting of the configuration is <b>true</b>, then the https port is used.<br/>
+		/// <p><b>NOTE</b>: this property must be set <b>before</b> the <b>connect()</b> method is called.</p>
+		/// </remarks>
+		/// <seealso cref="UseBlueBox"/>
+		/// <seealso cref="ConnectionMode"/>
+		bool UseWebSocket();
+		void UseWebSocket(bool value);
+
 		/// <summary>
 		/// Indicates whether the client should attempt an IPv6 connection
 		/// </summary>
@@ -468,6 +549,14 @@ namespace Sfs2X {
 		/// </param>
 		boost::shared_ptr<string> GetIPAddress(string host, long int port);
 
+		/// <summary>
+		/// The resolver that looks up and caches the server host names for the TCP, UDP and HTTP connections
+		/// </summary>
+		/// <remarks>
+		/// Use it to change how long host names are cached, or to clear the cache when the network changes.
+		/// </remarks>
+		boost::shared_ptr<HostResolver> GetHostResolver();
+
 		/// <summary>
 		/// Indicates whether the client-server messages debug is enabled or not.<br/>
 		/// If set to \code{.cpp} true \endcode, detailed debugging informations for all the incoming and outgoing messages are provided.
@@ -760,6 +849,35 @@ namespace Sfs2X {
 		/// 
 		void Send(boost::shared_ptr<IRequest> request);
 
+		/// <summary>
+		/// Sends a request carrying the latest value of a state, such as the position of the user or the state of an entity.
+		/// </summary>
+		/// <remarks>
+		/// A request sent with a replacement key supersedes the previous request sent with the same key, as long as that one
+		/// is still waiting to be written: the older one is removed from the outgoing queue, or from the buffer of a fast reconnection, and is never sent.
+		/// When the connection falls behind, the server receives the freshest value instead of a backlog of stale ones.
+		/// <br/>
+		/// The newer request is queued behind every request sent before it, so a state update never overtakes a command sent earlier,
+		/// e.g. a position sent after a leave room request reaches the server after it. Requests that are already written are not affected.
+		/// Use distinct keys for independent states, e.g. "position" and "entity.42".
+		/// </remarks>
+		/// <param name="request">
+		/// a request object
+		/// </param>
+		/// <param name="replacementKey">
+		/// the key of the state carried by the request; NULL sends the request as <see cref="Send"/> does
+		/// </param>
+		/// 
+		/// <example>
+		/// The following example sends the position of the player to the server-side Extension at every frame:
+		///			\code{.cpp}
+		///				boost::shared_ptr<IRequest> request (new ExtensionRequest("setPosition", parameters, room, true));
+		///				ptrSmartFox->Send(request, boost::shared_ptr<string>(new string("position")));
+		///			\endcode
+		/// </example>
+		/// 
+		void Send(boost::shared_ptr<IRequest> request, boost::shared_ptr<string> replacementKey);
+
 		/// <summary>
 		/// Loads the client configuration file.
 		/// </summary>
@@ -903,6 +1021,142 @@ namespace Sfs2X {
         /// </example>
 		void ProcessEvents();
 
+		/// <summary>
+		/// Indicates whether the API runs the socket connection without internal threads
+		/// </summary>
+		/// <remarks>
+		/// In poll mode the API creates no thread for the socket and WebSocket connections: the application calls <see cref="Poll"/> regularly,
+		/// and network completions, packet decoding, controllers and event listeners all run within that call, on the calling thread.
+		/// Requests are written at once by <see cref="Send"/>; the host name lookup started by <see cref="Connect"/> and the UDP channel also complete within <see cref="Poll"/>.<br/>
+		/// The BlueBox keeps its own thread.
+		/// <p><b>NOTE</b>: this property must be set <b>before</b> the <b>connect()</b> method is called.</p>
+		/// </remarks>
+		/// <seealso cref="Poll"/>
+		bool PollMode();
+		void PollMode(bool value);
+
+		/// <summary>
+		/// Runs the pending network work on the calling thread, when <see cref="PollMode"/> is enabled
+		/// </summary>
+		/// <remarks>
+		/// Events are dispatched within the call: as soon as they occur if <see cref="ThreadSafeMode"/> is false, at the end of the call otherwise.
+		/// </remarks>
+		/// <param name="timeout">
+		/// Milliseconds to wait for network activity when nothing is ready; 0 returns at once
+		/// </param>
+		/// <returns>
+		/// The number of completions and queued items processed; 0 when the poll mode is disabled
+		/// </returns>
+		/// <example>
+		///		\code{.cpp}
+		/// 	void _process(float delta) {
+		/// 		ptrSmartFox->Poll(0);
+		///	}
+		///		\endcode
+		/// </example>
+		long int Poll(long int timeout);
+
+		/// <summary>
+		/// Returns the quantity of bytes sent by the application and not yet written to the network
+		/// </summary>
+		/// <remarks>
+		/// The count includes the requests queued for the connection thread and the data still waiting in the socket, or in the WebSocket, after being encoded.
+		/// Requests held during a fast reconnection, and the data of a BlueBox connection, are not counted.
+		/// </remarks>
+		/// <seealso cref="SendWatermarks"/>
+		long int PendingSendBytes();
+
+		/// <summary>
+		/// Sets the watermarks of the outgoing data, in bytes
+		/// </summary>
+		/// <remarks>
+		/// When <see cref="PendingSendBytes"/> reaches the high watermark an <see cref="SFSEvent.OUTBOUND_CONGESTION"/> event reports that the link is saturated;
+		/// a second event is fired when the pending bytes drain back to the low watermark. The application can use them to hold back optional traffic,
+		/// such as chat or cosmetic updates, instead of letting the requests pile up into seconds of latency.<br/>
+		/// The requests are never dropped by the API. A high watermark of 0, the default, disables the events.<br/>
+		/// When the connection is lost or closed while congested, the second event is fired as well.
+		/// </remarks>
+		/// <param name="highWatermark">
+		/// Pending bytes at which the link is reported as congested; 0 disables the events
+		/// </param>
+		/// <param name="lowWatermark">
+		/// Pending bytes at which the link is reported as drained; between 0 and the high watermark
+		/// </param>
+		/// <example>
+		///		\code{.cpp}
+		///			ptrSmartFox->SendWatermarks(64 * 1024, 16 * 1024);
+		///			ptrSmartFox->AddEventListener(SFSEvent::OUTBOUND_CONGESTION, boost::shared_ptr<EventListenerDelegate> (new EventListenerDelegate(CMyClass::OnOutboundCongestion, (unsigned long long)this)));
+		///		\endcode
+		/// </example>
+		void SendWatermarks(long int highWatermark, long int lowWatermark);
+		long int SendHighWatermark();
+		long int SendLowWatermark();
+
+		/// <summary>
+		/// Sends a request to a server side Extension and waits for the matching response, without blocking the caller
+		/// </summary>
+		/// <remarks>
+		/// The request is stamped with an id, stored in its parameters under <see cref="Requests.ExtensionRequest.KEY_REQUEST_ID"/>:
+		/// the Extension must copy that value into the parameters of its response, so that responses are matched by id instead of by command.
+		/// Any number of requests can be waiting at the same time, and their responses can arrive in any order.
+		/// <br/>
+		/// The callback is invoked once, while the events are dispatched: with the <see cref="SFSEvent.EXTENSION_RESPONSE"/> event of the response,
+		/// or with an <see cref="SFSEvent.EXTENSION_REQUEST_FAILED"/> event if the timeout expires, the request is cancelled or the connection is lost.
+		/// Both events also reach the listeners, as usual.
+		/// <br/>
+		/// Timeouts run on the network service of the client: they do not expire on a BlueBox connection, as long as it is open.
+		/// </remarks>
+		/// <param name="request">
+		/// an <see cref="Requests.ExtensionRequest"/> object
+		/// </param>
+		/// <param name="callback">
+		/// the delegate notified when the request is settled; can be NULL when the events are enough
+		/// </param>
+		/// <param name="timeout">
+		/// milliseconds to wait for the response; 0 waits until the connection is closed
+		/// </param>
+		/// <returns>
+		/// The id of the request, or 0 if the request has not been sent; a request that fails validation is also notified
+		/// to the callback, with an <see cref="SFSEvent.EXTENSION_REQUEST_FAILED"/> event whose reason is <see cref="Util.RequestCorrelator.REASON_REJECTED"/>
+		/// </returns>
+		/// <example>
+		///		\code{.cpp}
+		///				boost::shared_ptr<IRequest> request (new ExtensionRequest("getInventory", parameters));
+		///				ptrSmartFox->SendAsync(request, boost::shared_ptr<ExtensionResponseDelegate> (new ExtensionResponseDelegate(CMyClass::OnInventory, (unsigned long long)this)), 5000);
+		///
+		///				static void OnInventory(unsigned long long ptrContext, long int requestId, boost::shared_ptr<BaseEvent> ptrEvent);
+		///
+		///				void CMyClass::OnInventory(unsigned long long ptrContext, long int requestId, boost::shared_ptr<BaseEvent> ptrEvent)
+		///				{
+		///					if (*ptrEvent->Type() == *SFSEvent::EXTENSION_REQUEST_FAILED)
+		///					{
+		///						// Timed out, cancelled or disconnected
+		///						return;
+		///					}
+		///
+		///					boost::shared_ptr<ISFSObject> ptrParams = (boost::static_pointer_cast<ISFSObject>)((*ptrEvent->Params())["params"]);
+		///				}
+		///		\endcode
+		/// </example>
+		long int SendAsync(boost::shared_ptr<IRequest> request, boost::shared_ptr<ExtensionResponseDelegate> callback, long int timeout);
+
+		/// <summary>
+		/// <see cref="SendAsync(boost::shared_ptr<IRequest>, boost::shared_ptr<ExtensionResponseDelegate>, long int)"/>, waiting for the response up to <see cref="Util.RequestCorrelator.DEFAULT_TIMEOUT"/> milliseconds
+		/// </summary>
+		long int SendAsync(boost::shared_ptr<IRequest> request, boost::shared_ptr<ExtensionResponseDelegate> callback);
+
+		/// <summary>
+		/// Stops waiting for the response to a request sent by <see cref="SendAsync"/>
+		/// </summary>
+		/// <remarks>
+		/// The request is settled by an <see cref="SFSEvent.EXTENSION_REQUEST_FAILED"/> event, whose reason is "cancelled".
+		/// A request already written is still processed by the server.
+		/// </remarks>
+		/// <returns>
+		/// false if the request is unknown or already settled
+		/// </returns>
+		bool CancelAsync(long int requestId);
+
 		// IDispatchable implementation
 
         /// <summary>
@@ -1052,6 +1306,7 @@ namespace Sfs2X {
 		void DisconnectConnection(long int timeout);
 
 		void HandleConnectionProblem(boost::shared_ptr<BaseEvent> e);
+		bool SendRequest(boost::shared_ptr<IRequest> request, boost::shared_ptr<string> replacementKey);
 		void SendHandshakeRequest(bool isReconnection);
 		void EnqueueEvent(boost::shared_ptr<BaseEvent> evt);
 		void OnDisconnectConnectionEvent(const boost::system::error_code& code);
@@ -1074,12 +1329,15 @@ namespace Sfs2X {
 		static void OnSocketSecurityError(unsigned long long context, boost::shared_ptr<BaseEvent> e);
 		static void OnConfigLoadSuccess(unsigned long long context, boost::shared_ptr<BaseEvent> e);
 		static void OnConfigLoadFailure(unsigned long long context, boost::shared_ptr<BaseEvent> e);
+		static void OnHostResolved(unsigned long long context, boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, boost::shared_ptr<string> error);
+		static void OnUdpHostResolved(unsigned long long context, boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > addresses, boost::shared_ptr<string> error);
 
 		// -------------------------------------------------------------------
 		// Private members
 		// -------------------------------------------------------------------
 
 		const static long int DEFAULT_HTTP_PORT = 8080;
+		const static long int DEFAULT_HTTPS_PORT = 8443;
 		const static long int MAX_BB_CONNECT_ATTEMPTS = 3;
 		const static char CLIENT_TYPE_SEPARATOR = ':';
 
@@ -1095,9 +1353,15 @@ namespace Sfs2X {
 
 		boost::shared_ptr<Sfs2X::Util::LagMonitor> lagMonitor;
 
+		// Matches the requests sent by SendAsync with their responses; created by the first of them
+		boost::shared_ptr<Sfs2X::Util::RequestCorrelator> requestCorrelator;
+
 		// If true the client will fall back to BlueBox if no socket connection is available
 		bool useBlueBox;
 
+		// If true the client will fall back to a WebSocket, before the BlueBox, if no socket connection is available
+		bool useWebSocket;
+
 		// If true the client will use IPv6 for socket connection
 		bool forceIPv6;
 
@@ -1127,6 +1391,17 @@ namespace Sfs2X {
 		
 		// Connection attempt flag
 		bool isConnecting; 
+
+		// Host and port of the connection attempt; the host name also identifies the server to the WebSocket fallback
+		string connectingHost;
+		long int connectingPort;
+
+		// Host and port of the UDP initialization, while the host name is being resolved
+		string connectingUdpHost;
+		short int connectingUdpPort;
+
+		// Host name lookups and cache
+		boost::shared_ptr<HostResolver> hostResolver;
 		
 		// The global user manager
 		boost::shared_ptr<IUserManager> userManager; 
@@ -1147,6 +1422,9 @@ namespace Sfs2X {
 		
 		// Last ip address used for connection, used when falling back to BlueBox
 		boost::shared_ptr<string> lastIpAddress;
+
+		// Every address of the last connection, attempted again when falling back to the WebSocket
+		boost::shared_ptr<vector<boost::shared_ptr<IPAddress> > > lastIpAddresses;
 		
 		boost::shared_ptr<EventDispatcher> dispatcher;
 		
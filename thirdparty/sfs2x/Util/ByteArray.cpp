@@ -13,7 +13,6 @@
 #endif
 
 #include "ByteArray.h"
-#include <bitset>  
 
 namespace Sfs2X {
 namespace Util {
@@ -26,7 +25,6 @@ ByteArray::ByteArray()
 	buffer = boost::shared_ptr<vector<unsigned char> >(new vector<unsigned char>());
 	position = 0;
 	compressed = false;
-	zLibIsInitialized = false;
 }
 
 // -------------------------------------------------------------------
@@ -37,7 +35,6 @@ ByteArray::ByteArray(boost::shared_ptr<vector<unsigned char> > buf)
 	buffer = buf;
 	position = 0;
 	compressed = false;
-	zLibIsInitialized = false;
 }
 
 // -------------------------------------------------------------------
@@ -47,16 +44,6 @@ ByteArray::~ByteArray()
 {
 }
 
-// -------------------------------------------------------------------
-// IsLittleEndian
-// -------------------------------------------------------------------
-bool ByteArray::IsLittleEndian()
-{
-    short int number = 0x1;
-    char *numPtr = (char*)&number;
-    return (numPtr[0] == 1);
-}
-
 // -------------------------------------------------------------------
 // Bytes
 // -------------------------------------------------------------------
@@ -128,26 +115,22 @@ void ByteArray::Compressed(bool value)
 // Compress
 // -------------------------------------------------------------------
 void ByteArray::Compress()
+{
+	// One-off compression: the zlib state lives only for this call
+	ZlibCompressor compressor;
+	Compress(compressor);
+}
+
+// -------------------------------------------------------------------
+// Compress
+// -------------------------------------------------------------------
+void ByteArray::Compress(ZlibCompressor& compressor)
 {
 	if (compressed) {
 		boost::throw_exception(boost::enable_error_info (std::runtime_error("Buffer is already compressed"))); 
 	}
 
-	// Destination buffer must be at least 0.1% larger than sourceLen plus 12 bytes
-	// We set destination buffer length to 1% of source + 12 bytes
-	unsigned long sizeCompressed = (long int)buffer->size() + (buffer->size() / 100) + 12;
-	boost::shared_ptr<unsigned char> dataCompressed (new unsigned char[sizeCompressed], array_deleter<unsigned char>());
-	memset (dataCompressed.get(), 0x00, sizeCompressed);
-
-	boost::shared_ptr<unsigned char> dataToCompress (new unsigned char[buffer->size()], array_deleter<unsigned char>());
-	memset (dataToCompress.get(), 0x00, buffer->size());
-
-	std::copy(buffer->begin(), buffer->end(), dataToCompress.get());
-
-	compress(dataCompressed.get(), &sizeCompressed, dataToCompress.get(), (uLong)buffer->size());
-
-	buffer->clear();
-	buffer->insert(buffer->end(), &dataCompressed.get()[0], &dataCompressed.get()[sizeCompressed]);
+	compressor.Compress(*buffer);
 
 	this->position = 0;
 	this->compressed = true;
@@ -158,37 +141,16 @@ void ByteArray::Compress()
 // -------------------------------------------------------------------
 void ByteArray::Uncompress()
 {
-	// We set destination buffer length as double of source
-	unsigned long sizeAreaUncompressed = (unsigned long)(buffer->size() * 2);
-	unsigned long sizeUncompressed = 0;
-	boost::shared_ptr<unsigned char> dataUncompressed;
-
-	boost::shared_ptr<unsigned char> dataToUncompress = boost::shared_ptr<unsigned char>(new unsigned char[buffer->size()], array_deleter<unsigned char>());
-	memset (dataToUncompress.get(), 0x00, buffer->size());
-
-	std::copy(buffer->begin(), buffer->end(), dataToUncompress.get());
-
-	// Loop up to destination buffer is large enough to hold the entire uncompressed data
-	do 
-	{
-		dataUncompressed = boost::shared_ptr<unsigned char>(new unsigned char[sizeAreaUncompressed], array_deleter<unsigned char>());
-		memset (dataUncompressed.get(), 0x00, sizeAreaUncompressed);
-
-		sizeUncompressed = sizeAreaUncompressed;
-		long int result = uncompress(dataUncompressed.get(), &sizeUncompressed, dataToUncompress.get(), (uLong)buffer->size());
-
-		if (result == Z_BUF_ERROR) 
-		{
-			sizeAreaUncompressed += (unsigned long)buffer->size();
-			continue;
-		}
-
-		break;
-
-	} while (true);
+	ZlibCompressor compressor;
+	Uncompress(compressor);
+}
 
-	buffer->clear();
-	buffer->insert(buffer->end(), &dataUncompressed.get()[0], &dataUncompressed.get()[sizeUncompressed]);
+// -------------------------------------------------------------------
+// Uncompress
+// -------------------------------------------------------------------
+void ByteArray::Uncompress(ZlibCompressor& compressor)
+{
+	compressor.Uncompress(*buffer);
 
 	this->position = 0;
 	this->compressed = false;
@@ -222,9 +184,54 @@ void ByteArray::CheckCompressedRead()
 void ByteArray::ReverseOrder(vector<unsigned char>& dt)
 {
 	// if BitCOnverter becomes BigEndian in future MONO/.NET implementations, use this to work correctly
-	if (!IsLittleEndian()) return;
-
+#if BOOST_ENDIAN_LITTLE_BYTE
 	std::reverse(dt.begin(), dt.end());
+#endif
+}
+
+// -------------------------------------------------------------------
+// Reader
+// -------------------------------------------------------------------
+ByteReader ByteArray::Reader(long int count)
+{
+	CheckCompressedRead();
+	return ByteReader(ReadPointer(count), count);
+}
+
+// -------------------------------------------------------------------
+// Writer
+// -------------------------------------------------------------------
+ByteWriter ByteArray::Writer(long int count)
+{
+	CheckCompressedWrite();
+	return ByteWriter(WritePointer(count), count);
+}
+
+// -------------------------------------------------------------------
+// ReadPointer
+// -------------------------------------------------------------------
+const unsigned char* ByteArray::ReadPointer(long int count)
+{
+	if (count < 0 || position < 0 || count > (long int)buffer->size() - position)
+	{
+		boost::throw_exception(boost::enable_error_info (std::out_of_range("Read past the end of the buffer")));
+	}
+
+	const unsigned char* data = buffer->empty() ? NULL : &(*buffer)[0] + position;
+	position += count;
+
+	return data;
+}
+
+// -------------------------------------------------------------------
+// WritePointer
+// -------------------------------------------------------------------
+unsigned char* ByteArray::WritePointer(long int count)
+{
+	size_t offset = buffer->size();
+	buffer->resize(offset + (size_t)count);
+
+	return buffer->empty() ? NULL : &(*buffer)[0] + offset;
 }
 
 // -------------------------------------------------------------------
@@ -240,9 +247,7 @@ void ByteArray::WriteByte(boost::shared_ptr<SFSDataType> tp)
 // -------------------------------------------------------------------
 void ByteArray::WriteByte(unsigned char b)
 {
-	boost::shared_ptr<vector<unsigned char> > buf (new vector<unsigned char>());
-	buf->push_back(b);
-	WriteBytes(buf);
+	buffer->push_back(b);
 }
 
 // -------------------------------------------------------------------
@@ -267,10 +272,7 @@ void ByteArray::WriteBytes(boost::shared_ptr<vector<unsigned char> > data, long
 void ByteArray::WriteBool(bool b)
 {
 	CheckCompressedWrite();
-
-	boost::shared_ptr<vector<unsigned char> > buf (new vector<unsigned char>());
-	buf->push_back(b ? (unsigned char)1 : (unsigned char)0);
-	WriteBytes(buf);
+	buffer->push_back(b ? (unsigned char)1 : (unsigned char)0);
 }
 
 // -------------------------------------------------------------------
@@ -279,20 +281,7 @@ void ByteArray::WriteBool(bool b)
 void ByteArray::WriteInt(boost::int32_t i)
 {
 	CheckCompressedWrite();
-
-	unsigned char bytes[4];
-
-	bytes[0] = (i >> 24) & 0xFF;
-	bytes[1] = (i >> 16) & 0xFF;
-	bytes[2] = (i >> 8) & 0xFF;
-	bytes[3] = i & 0xFF;
-
-	boost::shared_ptr<vector<unsigned char> > buf (new vector<unsigned char>());
-	buf->push_back(bytes[0]);
-	buf->push_back(bytes[1]);
-	buf->push_back(bytes[2]);
-	buf->push_back(bytes[3]);
-	WriteBytes(buf);
+	ByteOrder::StoreBig32(WritePointer(4), (boost::uint32_t)i);
 }
 
 // -------------------------------------------------------------------
@@ -301,16 +290,7 @@ void ByteArray::WriteInt(boost::int32_t i)
 void ByteArray::WriteUShort(unsigned short int us)
 {
 	CheckCompressedWrite();
-
-	unsigned char bytes[2];
-
-	bytes[0] = (us >> 8) & 0xFF;
-	bytes[1] = us & 0xFF;
-
-	boost::shared_ptr<vector<unsigned char> > buf (new vector<unsigned char>());
-	buf->push_back(bytes[0]);
-	buf->push_back(bytes[1]);
-	WriteBytes(buf);
+	ByteOrder::StoreBig16(WritePointer(2), (boost::uint16_t)us);
 }
 
 // -------------------------------------------------------------------
@@ -319,16 +299,7 @@ void ByteArray::WriteUShort(unsigned short int us)
 void ByteArray::WriteShort(short int s)
 {
 	CheckCompressedWrite();
-
-	unsigned char bytes[2];
-
-	bytes[0] = (s >> 8) & 0xFF;
-	bytes[1] = s & 0xFF;
-
-	boost::shared_ptr<vector<unsigned char> > buf (new vector<unsigned char>());
-	buf->push_back(bytes[0]);
-	buf->push_back(bytes[1]);
-	WriteBytes(buf);
+	ByteOrder::StoreBig16(WritePointer(2), (boost::uint16_t)s);
 }
 
 // -------------------------------------------------------------------
@@ -337,28 +308,7 @@ void ByteArray::WriteShort(short int s)
 void ByteArray::WriteLong(long long l)
 {
 	CheckCompressedWrite();
-
-	unsigned char bytes[8];
-
-	bytes[0] = (l >> 56) & 0xFF;
-	bytes[1] = (l >> 48) & 0xFF;
-	bytes[2] = (l >> 40) & 0xFF;
-	bytes[3] = (l >> 32) & 0xFF;
-	bytes[4] = (l >> 24) & 0xFF;
-	bytes[5] = (l >> 16) & 0xFF;
-	bytes[6] = (l >> 8) & 0xFF;
-	bytes[7] = l & 0xFF;
-
-	boost::shared_ptr<vector<unsigned char> > buf (new vector<unsigned char>());
-	buf->push_back(bytes[0]);
-	buf->push_back(bytes[1]);
-	buf->push_back(bytes[2]);
-	buf->push_back(bytes[3]);
-	buf->push_back(bytes[4]);
-	buf->push_back(bytes[5]);
-	buf->push_back(bytes[6]);
-	buf->push_back(bytes[7]);
-	WriteBytes(buf);
+	ByteOrder::StoreBig64(WritePointer(8), (boost::uint64_t)l);
 }
 
 // -------------------------------------------------------------------
@@ -367,30 +317,7 @@ void ByteArray::WriteLong(long long l)
 void ByteArray::WriteFloat(float f)
 {
 	CheckCompressedWrite();
-
-	unsigned char bytes[4];
-
-	union  
-    {  
-         float input;   
-         long int output;  
-    }    data;  
-  
-    data.input = f;  
-  
-    std::bitset<sizeof(float) * CHAR_BIT> bits(data.output);  
-
-	bytes[0] = ((long int)data.output >> 24) & 0xFF;
-	bytes[1] = ((long int)data.output >> 16) & 0xFF;
-	bytes[2] = ((long int)data.output >> 8) & 0xFF;
-	bytes[3] = (long int)data.output & 0xFF;
-  
-	boost::shared_ptr<vector<unsigned char> > buf (new vector<unsigned char>());
-	buf->push_back(bytes[0]);
-	buf->push_back(bytes[1]);
-	buf->push_back(bytes[2]);
-	buf->push_back(bytes[3]);
-	WriteBytes(buf);
+	ByteOrder::StoreBigFloat(WritePointer(4), f);
 }
 
 // -------------------------------------------------------------------
@@ -399,50 +326,18 @@ void ByteArray::WriteFloat(float f)
 void ByteArray::WriteDouble(double d)
 {
 	CheckCompressedWrite();
-
-	unsigned char bytes[8];
-
-	union  
-    {  
-         double input;   
-         unsigned long long output;  
-    }    data;  
-  
-    data.input = d;  
-  
-    std::bitset<sizeof(double) * CHAR_BIT> bits(data.output);  
-
-	bytes[0] = ((unsigned long long)data.output >> 56) & 0xFF;
-	bytes[1] = ((unsigned long long)data.output >> 48) & 0xFF;
-	bytes[2] = ((unsigned long long)data.output >> 40) & 0xFF;
-	bytes[3] = ((unsigned long long)data.output >> 32) & 0xFF;
-	bytes[4] = ((unsigned long long)data.output >> 24) & 0xFF;
-	bytes[5] = ((unsigned long long)data.output >> 16) & 0xFF;
-	bytes[6] = ((unsigned long long)data.output >> 8) & 0xFF;
-	bytes[7] = (unsigned long long)data.output & 0xFF;
-
-	boost::shared_ptr<vector<unsigned char> > buf (new vector<unsigned char>());
-	buf->push_back(bytes[0]);
-	buf->push_back(bytes[1]);
-	buf->push_back(bytes[2]);
-	buf->push_back(bytes[3]);
-	buf->push_back(bytes[4]);
-	buf->push_back(bytes[5]);
-	buf->push_back(bytes[6]);
-	buf->push_back(bytes[7]);
-	WriteBytes(buf);
+	ByteOrder::StoreBigDouble(WritePointer(8), d);
 }
 
 // -------------------------------------------------------------------
 // WriteUTF
 // -------------------------------------------------------------------
-void ByteArray::WriteUTF(string str)
+void ByteArray::WriteUTF(boost::shared_ptr<string> str)
 {
-	boost::shared_ptr<string> value (new string(str));
-	WriteUTF(value);
+	WriteUTF(*str);
 }
 
-void ByteArray::WriteUTF(boost::shared_ptr<string> str)
+void ByteArray::WriteUTF(const string& str)
 {
 	CheckCompressedWrite();
 	
@@ -492,70 +387,34 @@ void ByteArray::WriteUTF(boost::shared_ptr<string> str)
 	WriteBytes(data);
 	*/
 
-	/* 
-	if (str->size() > 32768) 
-	{
-		boost::throw_exception(boost::enable_error_info (std::runtime_error("String length cannot be greater then 32768 !"))); 
-	}
-	
-	WriteUShort((unsigned short int)(str->size()));
-
-	vector<unsigned char>utfBuffer;
-
-	const char* utfStringArray = str->c_str();
-	for (unsigned long int enumerator = 0; enumerator < str->size(); enumerator++)
-	{
-		utfBuffer.push_back((const unsigned char)(*(utfStringArray + enumerator)));
-	}
-
-	boost::shared_ptr<vector<unsigned char> > data (new vector<unsigned char>(utfBuffer));
-	WriteBytes(data);
-	*/
-
-	vector<unsigned char>utfBuffer;
-	const char* utfStringArray = str->c_str();
-	for (unsigned long int enumerator = 0; enumerator < str->size(); enumerator++)
-	{
-		utfBuffer.push_back((const unsigned char)(*(utfStringArray + enumerator)));
-	}
-
-	if (utfBuffer.size() > 32767)
+	if (str.size() > 32767)
 	{
 		boost::throw_exception(boost::enable_error_info(std::runtime_error("String length cannot be greater than 32767 bytes!")));
 	}
 
-	WriteUShort((unsigned short int)(utfBuffer.size()));
-
-	boost::shared_ptr<vector<unsigned char> > data(new vector<unsigned char>(utfBuffer));
-	WriteBytes(data);
+	// Length prefix and bytes are written as one block
+	ByteWriter writer (WritePointer(2 + (long int)str.size()), 2 + (long int)str.size());
+	writer.WriteUShort((unsigned short int)(str.size()));
+	writer.WriteBytes((const unsigned char*)str.data(), (long int)str.size());
 }
 
 // -------------------------------------------------------------------
 // WriteText
 // -------------------------------------------------------------------
-void ByteArray::WriteText(string str)
+void ByteArray::WriteText(boost::shared_ptr<string> str)
 {
-	boost::shared_ptr<string> value(new string(str));
-	WriteText(value);
+	WriteText(*str);
 }
 
-void ByteArray::WriteText(boost::shared_ptr<string> str)
+void ByteArray::WriteText(const string& str)
 {
 	CheckCompressedWrite();
 
-	vector<unsigned char>utfBuffer;
-	const char* utfStringArray = str->c_str();
-	for (unsigned long int enumerator = 0; enumerator < str->size(); enumerator++)
-	{
-		utfBuffer.push_back((const unsigned char)(*(utfStringArray + enumerator)));
-	}
-
 	// SIZE CHECK NOT NEEDED: byte[] length can't be more than Int32.MaxValue
 
-	WriteInt((boost::int32_t)(utfBuffer.size()));
-
-	boost::shared_ptr<vector<unsigned char> > data(new vector<unsigned char>(utfBuffer));
-	WriteBytes(data);
+	ByteWriter writer (WritePointer(4 + (long int)str.size()), 4 + (long int)str.size());
+	writer.WriteInt((boost::int32_t)(str.size()));
+	writer.WriteBytes((const unsigned char*)str.data(), (long int)str.size());
 }
 
 // -------------------------------------------------------------------
@@ -565,7 +424,7 @@ void ByteArray::ReadByte(unsigned char& returnedValue)
 {
 	CheckCompressedRead();
 			
-	returnedValue = buffer->at(position++);
+	returnedValue = *ReadPointer(1);
 
 	return;
 }
@@ -575,12 +434,8 @@ void ByteArray::ReadByte(unsigned char& returnedValue)
 // -------------------------------------------------------------------
 void ByteArray::ReadBytes(long int count, vector<unsigned char>& returnedValue)
 {
-	for (long int enumerator = 0; enumerator < count; enumerator++)
-	{
-		returnedValue.push_back(buffer->at(position + enumerator));
-	}
-
-	position += count;
+	const unsigned char* data = ReadPointer(count);
+	returnedValue.insert(returnedValue.end(), data, data + count);
 	
 	return;
 }
@@ -590,12 +445,11 @@ void ByteArray::ReadBytes(long int count, vector<unsigned char>& returnedValue)
 // -------------------------------------------------------------------
 void ByteArray::ReadBytes(long int offset, long int count, vector<unsigned char>& returnedValue)
 {
-	for (long int enumerator = offset; enumerator < count + offset; enumerator++)
-	{
-		returnedValue.push_back(buffer->at(position + enumerator));
-	}
+	position += offset;
+	const unsigned char* data = ReadPointer(count);
+	position -= offset;
 
-	position += count;
+	returnedValue.insert(returnedValue.end(), data, data + count);
 	
 	return;
 }
@@ -606,7 +460,7 @@ void ByteArray::ReadBytes(long int offset, long int count, vector<unsigned char>
 void ByteArray::ReadBool(bool& returnedValue)
 {
 	CheckCompressedRead();
-	returnedValue = buffer->at(position++) == 1;
+	returnedValue = *ReadPointer(1) == 1;
 	return;
 }
 
@@ -616,14 +470,7 @@ void ByteArray::ReadBool(bool& returnedValue)
 void ByteArray::ReadInt(boost::int32_t& returnedValue)
 {
 	CheckCompressedRead();
-	vector<unsigned char> data;
-	ReadBytes(4, data);
-
-	returnedValue = (((long int)data.at(0)) << 24) |
-				    (((long int)data.at(1) << 16)) |
-				    (((long int)data.at(2) << 8)) |
-				    (((long int)data.at(3)));
-			
+	returnedValue = (boost::int32_t)ByteOrder::LoadBig32(ReadPointer(4));
 	return;
 }
 
@@ -633,12 +480,7 @@ void ByteArray::ReadInt(boost::int32_t& returnedValue)
 void ByteArray::ReadUShort(unsigned short int& returnedValue)
 {
 	CheckCompressedRead();
-	vector<unsigned char> data;
-	ReadBytes(2, data);
-
-	returnedValue = (((unsigned short int)data.at(0) << 8)) |
-				    (((unsigned short int)data.at(1)));
-			
+	returnedValue = ByteOrder::LoadBig16(ReadPointer(2));
 	return;
 }
 
@@ -648,12 +490,7 @@ void ByteArray::ReadUShort(unsigned short int& returnedValue)
 void ByteArray::ReadShort(short int& returnedValue)
 {
 	CheckCompressedRead();
-	vector<unsigned char> data;
-	ReadBytes(2, data);
-
-	returnedValue = (((short int)data.at(0) << 8)) |
-				    (((short int)data.at(1)));
-			
+	returnedValue = (short int)ByteOrder::LoadBig16(ReadPointer(2));
 	return;
 }
 
@@ -663,18 +500,7 @@ void ByteArray::ReadShort(short int& returnedValue)
 void ByteArray::ReadLong(long long& returnedValue)
 {
 	CheckCompressedRead();
-	vector<unsigned char> data;
-	ReadBytes(8, data);
-
-	returnedValue = (((unsigned long long)data.at(0)) << 56) |
-				    (((unsigned long long)data.at(1)) << 48) |
-				    (((unsigned long long)data.at(2)) << 40) |
-				    (((unsigned long long)data.at(3)) << 32) |
-				    (((unsigned long long)data.at(4)) << 24) |
-				    (((unsigned long long)data.at(5)) << 16) |
-				    (((unsigned long long)data.at(6)) << 8) |
-				    (((unsigned long long)data.at(7)));
-			
+	returnedValue = (long long)ByteOrder::LoadBig64(ReadPointer(8));
 	return;
 }
 
@@ -684,38 +510,9 @@ void ByteArray::ReadLong(long long& returnedValue)
 void ByteArray::ReadFloat(float& returnedValue)
 {
 	CheckCompressedRead();
-	vector<unsigned char> data;
-	ReadBytes(4, data);
-
-	long int readNumber = ((((long int)data.at(0)) << 24) |
-					       (((long int)data.at(1)) << 16) |
-					       (((long int)data.at(2)) << 8) |
-					       (((long int)data.at(3))));
-		
-//    std::bitset<32> set(readNumber);        
-//    long int hexNumber = set.to_ulong();  
-  
-//    bool negative = !!(hexNumber & 0x80000000);  
-//    long int exponent = (hexNumber & 0x7f800000) >> 23;      
-    bool negative = !!(readNumber & 0x80000000);  
-    long int exponent = (readNumber & 0x7f800000) >> 23;      
-    long int sign = negative ? -1 : 1;  
-  
-    // Subtract 127 from the exponent  
-    exponent -= 127;  
-  
-    // Convert the mantissa into decimal using the last 23 bits  
-    long int power = -1;  
-    float total = 0.0;  
-    for (int i = 0; i < 23; i++)  
-    {  
-        long int c = (readNumber & (0x80000000 >> (9 + i))) != 0 ? 1 : 0;  
-        total += (float)c * (float)pow(2.0, power);  
-        power--;  
-    }  
-    total += 1.0;  
-  
-    returnedValue = sign * (float)pow(2.0, exponent) * total;  
+
+	// The wire holds the IEEE 754 bits, so zero, denormals, infinities and NaN read back exactly
+	returnedValue = ByteOrder::LoadBigFloat(ReadPointer(4));
 
 	return;
 }
@@ -726,43 +523,7 @@ void ByteArray::ReadFloat(float& returnedValue)
 void ByteArray::ReadDouble(double& returnedValue)
 {
 	CheckCompressedRead();
-	vector<unsigned char> data;
-	ReadBytes(8, data);
-
-	unsigned long long readNumber = ((((unsigned long long)data.at(0)) << 56) |
-									(((unsigned long long)data.at(1)) << 48) |
-									(((unsigned long long)data.at(2)) << 40) |
-									(((unsigned long long)data.at(3)) << 32) |
-									(((unsigned long long)data.at(4)) << 24) |
-									(((unsigned long long)data.at(5)) << 16) |
-									(((unsigned long long)data.at(6)) << 8) |
-									(((unsigned long long)data.at(7))));
-		
-//    std::bitset<64> set(readNumber);        
-//    unsigned long long hexNumber = set.to_ullong();  
-  
-//    bool negative = !!(hexNumber & 0x8000000000000000);  
-//    long int exponent = (hexNumber & 0x7ff0000000000000) >> 52;      
-    bool negative = !!(readNumber & 0x8000000000000000);  
-    long int exponent = (readNumber & 0x7ff0000000000000) >> 52;      
-    long int sign = negative ? -1 : 1;  
-  
-    // Subtract 1023 from the exponent  
-    exponent -= 1023;  
-  
-    // Convert the mantissa into decimal using the last 52 bits  
-    long int power = -1;  
-    double total = 0.0;  
-    for (int i = 0; i < 52; i++)  
-    {  
-        long int c = (readNumber & (0x8000000000000000 >> (12 + i))) != 0 ? 1 : 0;  
-        total += (double)c * (double)pow(2.0, power);  
-        power--;  
-    }  
-    total += 1.0;  
-  
-    returnedValue = sign * (double)pow(2.0, exponent) * total;  
-
+	returnedValue = ByteOrder::LoadBigDouble(ReadPointer(8));
 	return;
 }
 
@@ -795,15 +556,8 @@ void ByteArray::ReadUTF(string& returnedValue)
 	unsigned short int size;
 	ReadUShort(size);
 
-	boost::shared_ptr<string> src (new string());
-
-	for (long int enumerator = 0; enumerator < size; enumerator++)
-	{
-		src->push_back(buffer->at(position + enumerator));
-	}
-
-	returnedValue.assign(src->begin(), src->end()); 
-	position += size;
+	const unsigned char* data = ReadPointer(size);
+	returnedValue.assign((const char*)data, size);
 
 	return;
 }
@@ -818,15 +572,8 @@ void ByteArray::ReadText(string& returnedValue)
 	boost::int32_t size;
 	ReadInt(size);
 
-	boost::shared_ptr<string> src(new string());
-
-	for (boost::int32_t enumerator = 0; enumerator < size; enumerator++)
-	{
-		src->push_back(buffer->at(position + enumerator));
-	}
-
-	returnedValue.assign(src->begin(), src->end());
-	position += size;
+	const unsigned char* data = ReadPointer(size);
+	returnedValue.assign((const char*)data, (size_t)size);
 }
 
 }	// namespace Util
@@ -13,9 +13,11 @@
 
 #include "./Common.h"
 #include "./StringFormatter.h"
+#include "./ZlibCompressor.h"
+#include "./ByteReader.h"
+#include "./ByteWriter.h"
 
 #include "../Entities/Data/SFSDataType.h"
-#include "../ZLib/zlib.h"
 #include <boost/container/string.hpp>
 #include <boost/exception/exception.hpp>
 #include <boost/exception/all.hpp>
@@ -31,8 +33,6 @@ using namespace std;					// STL library: declare the STL namespace
 
 using namespace Sfs2X::Entities::Data;
 
-#define ZlibChunk 1024			// Chunk size (bytes) for Zlib buffers
-
 namespace Sfs2X {
 namespace Util {
 
@@ -64,12 +64,31 @@ namespace Util {
 		void Compressed(bool value);
 
 		void Compress();
+		void Compress(ZlibCompressor& compressor);
 		void Uncompress();
+		void Uncompress(ZlibCompressor& compressor);
 		void CheckCompressedWrite();
 		void CheckCompressedRead();
 
 		void ReverseOrder(vector<unsigned char>& dt);
 
+		/// <summary>
+		/// Checks once that <paramref name="count"/> bytes can be read, then moves past them
+		/// </summary>
+		/// <returns>
+		/// A reader over the skipped bytes; it is valid until the buffer is changed
+		/// </returns>
+		/// <exception cref="std::out_of_range">Fewer bytes are available</exception>
+		ByteReader Reader(long int count);
+
+		/// <summary>
+		/// Appends <paramref name="count"/> bytes to the buffer
+		/// </summary>
+		/// <returns>
+		/// A writer over the appended bytes, which must fill all of them; it is valid until the buffer is changed
+		/// </returns>
+		ByteWriter Writer(long int count);
+
 		void WriteByte(boost::shared_ptr<SFSDataType> tp);
 		void WriteByte(unsigned char b);
 		void WriteBytes(boost::shared_ptr<vector<unsigned char> > data);
@@ -82,9 +101,9 @@ namespace Util {
 		void WriteFloat(float f);
 		void WriteDouble(double d);
 		void WriteUTF(boost::shared_ptr<string> str);
-		void WriteUTF(string str);
+		void WriteUTF(const string& str);
 		void WriteText(boost::shared_ptr<string> str);
-		void WriteText(string str);
+		void WriteText(const string& str);
 
 		void ReadByte(unsigned char&);
 		void ReadBytes(long int count, vector<unsigned char>&);
@@ -120,7 +139,8 @@ namespace Util {
 		// Private methods
 		// -------------------------------------------------------------------
 
-		bool IsLittleEndian();
+		const unsigned char* ReadPointer(long int count);
+		unsigned char* WritePointer(long int count);
 
 		// -------------------------------------------------------------------
 		// Private members
@@ -129,11 +149,6 @@ namespace Util {
 		boost::shared_ptr<vector<unsigned char> > buffer;
 		long int position;
 		bool compressed;
-
-		bool zLibIsInitialized;
-		z_stream zlibStrm;
-	    unsigned char zlibIn[ZlibChunk];
-	    unsigned char zlibOut[ZlibChunk];
 	};
 
 }	// namespace Util
@@ -0,0 +1,224 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of ByteOrder
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __ByteOrder__
+#define __ByteOrder__
+
+#include "Common.h"
+
+#include <boost/cstdint.hpp>					// Boost fixed size integers
+#include <boost/predef/other/endian.h>			// Boost compile time byte order detection
+
+#if defined(_MSC_VER)
+#include <stdlib.h>						// _byteswap_ushort, _byteswap_ulong, _byteswap_uint64
+#endif
+#include <string.h>						// memcpy
+
+namespace Sfs2X {
+namespace Util {
+
+	// -------------------------------------------------------------------
+	// Class ByteOrder
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Loads and stores of the big endian (network order) values of the SFS2X protocol
+	/// </summary>
+	///
+	/// <remarks>
+	/// The byte order of the platform is resolved at compile time: each access is a single load or store,
+	/// followed by a byte swap on little endian platforms. No bounds are checked.
+	/// </remarks>
+	class ByteOrder
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		static boost::uint16_t LoadBig16(const unsigned char* data);
+		static boost::uint32_t LoadBig32(const unsigned char* data);
+		static boost::uint64_t LoadBig64(const unsigned char* data);
+		static float LoadBigFloat(const unsigned char* data);
+		static double LoadBigDouble(const unsigned char* data);
+
+		static void StoreBig16(unsigned char* data, boost::uint16_t value);
+		static void StoreBig32(unsigned char* data, boost::uint32_t value);
+		static void StoreBig64(unsigned char* data, boost::uint64_t value);
+		static void StoreBigFloat(unsigned char* data, float value);
+		static void StoreBigDouble(unsigned char* data, double value);
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		static boost::uint16_t ToBig(boost::uint16_t value);
+		static boost::uint32_t ToBig(boost::uint32_t value);
+		static boost::uint64_t ToBig(boost::uint64_t value);
+	};
+
+	// -------------------------------------------------------------------
+	// ToBig
+	// -------------------------------------------------------------------
+	inline boost::uint16_t ByteOrder::ToBig(boost::uint16_t value)
+	{
+#if BOOST_ENDIAN_BIG_BYTE
+		return value;
+#elif defined(_MSC_VER)
+		return _byteswap_ushort(value);
+#elif defined(__GNUC__)
+		return __builtin_bswap16(value);
+#else
+		return (boost::uint16_t)((value << 8) | (value >> 8));
+#endif
+	}
+
+	// -------------------------------------------------------------------
+	// ToBig
+	// -------------------------------------------------------------------
+	inline boost::uint32_t ByteOrder::ToBig(boost::uint32_t value)
+	{
+#if BOOST_ENDIAN_BIG_BYTE
+		return value;
+#elif defined(_MSC_VER)
+		return _byteswap_ulong(value);
+#elif defined(__GNUC__)
+		return __builtin_bswap32(value);
+#else
+		return ((value & 0x000000FFUL) << 24) | ((value & 0x0000FF00UL) << 8) | ((value & 0x00FF0000UL) >> 8) | ((value & 0xFF000000UL) >> 24);
+#endif
+	}
+
+	// -------------------------------------------------------------------
+	// ToBig
+	// -------------------------------------------------------------------
+	inline boost::uint64_t ByteOrder::ToBig(boost::uint64_t value)
+	{
+#if BOOST_ENDIAN_BIG_BYTE
+		return value;
+#elif defined(_MSC_VER)
+		return _byteswap_uint64(value);
+#elif defined(__GNUC__)
+		return __builtin_bswap64(value);
+#else
+		return ((boost::uint64_t)ToBig((boost::uint32_t)value) << 32) | ToBig((boost::uint32_t)(value >> 32));
+#endif
+	}
+
+	// -------------------------------------------------------------------
+	// LoadBig16
+	// -------------------------------------------------------------------
+	inline boost::uint16_t ByteOrder::LoadBig16(const unsigned char* data)
+	{
+		boost::uint16_t value;
+		memcpy(&value, data, sizeof(value));
+		return ToBig(value);
+	}
+
+	// -------------------------------------------------------------------
+	// LoadBig32
+	// -------------------------------------------------------------------
+	inline boost::uint32_t ByteOrder::LoadBig32(const unsigned char* data)
+	{
+		boost::uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return ToBig(value);
+	}
+
+	// -------------------------------------------------------------------
+	// LoadBig64
+	// -------------------------------------------------------------------
+	inline boost::uint64_t ByteOrder::LoadBig64(const unsigned char* data)
+	{
+		boost::uint64_t value;
+		memcpy(&value, data, sizeof(value));
+		return ToBig(value);
+	}
+
+	// -------------------------------------------------------------------
+	// LoadBigFloat
+	// -------------------------------------------------------------------
+	inline float ByteOrder::LoadBigFloat(const unsigned char* data)
+	{
+		// IEEE 754 bits, as written by the server
+		boost::uint32_t bits = LoadBig32(data);
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	// -------------------------------------------------------------------
+	// LoadBigDouble
+	// -------------------------------------------------------------------
+	inline double ByteOrder::LoadBigDouble(const unsigned char* data)
+	{
+		boost::uint64_t bits = LoadBig64(data);
+		double value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	// -------------------------------------------------------------------
+	// StoreBig16
+	// -------------------------------------------------------------------
+	inline void ByteOrder::StoreBig16(unsigned char* data, boost::uint16_t value)
+	{
+		value = ToBig(value);
+		memcpy(data, &value, sizeof(value));
+	}
+
+	// -------------------------------------------------------------------
+	// StoreBig32
+	// -------------------------------------------------------------------
+	inline void ByteOrder::StoreBig32(unsigned char* data, boost::uint32_t value)
+	{
+		value = ToBig(value);
+		memcpy(data, &value, sizeof(value));
+	}
+
+	// -------------------------------------------------------------------
+	// StoreBig64
+	// -------------------------------------------------------------------
+	inline void ByteOrder::StoreBig64(unsigned char* data, boost::uint64_t value)
+	{
+		value = ToBig(value);
+		memcpy(data, &value, sizeof(value));
+	}
+
+	// -------------------------------------------------------------------
+	// StoreBigFloat
+	// -------------------------------------------------------------------
+	inline void ByteOrder::StoreBigFloat(unsigned char* data, float value)
+	{
+		boost::uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		StoreBig32(data, bits);
+	}
+
+	// -------------------------------------------------------------------
+	// StoreBigDouble
+	// -------------------------------------------------------------------
+	inline void ByteOrder::StoreBigDouble(unsigned char* data, double value)
+	{
+		boost::uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		StoreBig64(data, bits);
+	}
+
+}	// namespace Util
+}	// namespace Sfs2X
+
+#endif
@@ -0,0 +1,257 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of ByteReader
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __ByteReader__
+#define __ByteReader__
+
+#include "Common.h"
+#include "ByteOrder.h"
+
+#include <boost/cstdint.hpp>					// Boost fixed size integers
+#include <boost/exception/all.hpp>
+
+#include <stdexcept>					// STL library: out_of_range exception
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <string>						// STL library: string object
+#include <vector>						// STL library: vector object
+using namespace std;					// STL library: declare the STL namespace
+
+namespace Sfs2X {
+namespace Util {
+
+	// -------------------------------------------------------------------
+	// Class ByteReader
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Reads big endian values from a span of bytes it does not own
+	/// </summary>
+	///
+	/// <remarks>
+	/// Reads are not bounds checked: the length of a block is checked once with <see cref="Require"/>,
+	/// then its values are read with single loads. The span must outlive the reader.
+	/// </remarks>
+	class ByteReader
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		ByteReader(const unsigned char* data, long int length);
+
+		long int Position() const;
+		long int Remaining() const;
+
+		/// <summary>
+		/// Address of the next byte to read, to compare bytes in place
+		/// </summary>
+		const unsigned char* Cursor() const;
+
+		/// <summary>
+		/// Checks that at least <paramref name="count"/> bytes are left
+		/// </summary>
+		/// <exception cref="std::out_of_range">Fewer bytes are left</exception>
+		void Require(long int count) const;
+
+		/// <summary>
+		/// Moves the position by <paramref name="count"/> bytes; a negative count steps back
+		/// </summary>
+		void Skip(long int count);
+
+		void ReadByte(unsigned char& returnedValue);
+		void ReadBool(bool& returnedValue);
+		void ReadShort(short int& returnedValue);
+		void ReadUShort(unsigned short int& returnedValue);
+		void ReadInt(boost::int32_t& returnedValue);
+		void ReadLong(long long& returnedValue);
+		void ReadFloat(float& returnedValue);
+		void ReadDouble(double& returnedValue);
+		void ReadBytes(long int count, vector<unsigned char>& returnedValue);
+		void ReadUTF(string& returnedValue);
+		void ReadText(string& returnedValue);
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		const unsigned char* begin;
+		const unsigned char* cursor;
+		const unsigned char* end;
+	};
+
+	// -------------------------------------------------------------------
+	// Constructor
+	// -------------------------------------------------------------------
+	inline ByteReader::ByteReader(const unsigned char* data, long int length)
+	{
+		begin = data;
+		cursor = data;
+		end = data + length;
+	}
+
+	// -------------------------------------------------------------------
+	// Position
+	// -------------------------------------------------------------------
+	inline long int ByteReader::Position() const
+	{
+		return (long int)(cursor - begin);
+	}
+
+	// -------------------------------------------------------------------
+	// Remaining
+	// -------------------------------------------------------------------
+	inline long int ByteReader::Remaining() const
+	{
+		return (long int)(end - cursor);
+	}
+
+	// -------------------------------------------------------------------
+	// Cursor
+	// -------------------------------------------------------------------
+	inline const unsigned char* ByteReader::Cursor() const
+	{
+		return cursor;
+	}
+
+	// -------------------------------------------------------------------
+	// Require
+	// -------------------------------------------------------------------
+	inline void ByteReader::Require(long int count) const
+	{
+		if (count < 0 || count > (long int)(end - cursor))
+		{
+			boost::throw_exception(boost::enable_error_info (std::out_of_range("Read past the end of the data")));
+		}
+	}
+
+	// -------------------------------------------------------------------
+	// Skip
+	// -------------------------------------------------------------------
+	inline void ByteReader::Skip(long int count)
+	{
+		cursor += count;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadByte
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadByte(unsigned char& returnedValue)
+	{
+		returnedValue = *cursor++;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadBool
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadBool(bool& returnedValue)
+	{
+		returnedValue = *cursor++ == 1;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadShort
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadShort(short int& returnedValue)
+	{
+		returnedValue = (short int)ByteOrder::LoadBig16(cursor);
+		cursor += 2;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadUShort
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadUShort(unsigned short int& returnedValue)
+	{
+		returnedValue = ByteOrder::LoadBig16(cursor);
+		cursor += 2;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadInt
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadInt(boost::int32_t& returnedValue)
+	{
+		returnedValue = (boost::int32_t)ByteOrder::LoadBig32(cursor);
+		cursor += 4;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadLong
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadLong(long long& returnedValue)
+	{
+		returnedValue = (long long)ByteOrder::LoadBig64(cursor);
+		cursor += 8;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadFloat
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadFloat(float& returnedValue)
+	{
+		returnedValue = ByteOrder::LoadBigFloat(cursor);
+		cursor += 4;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadDouble
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadDouble(double& returnedValue)
+	{
+		returnedValue = ByteOrder::LoadBigDouble(cursor);
+		cursor += 8;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadBytes
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadBytes(long int count, vector<unsigned char>& returnedValue)
+	{
+		returnedValue.insert(returnedValue.end(), cursor, cursor + count);
+		cursor += count;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadUTF
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadUTF(string& returnedValue)
+	{
+		unsigned short int size;
+		ReadUShort(size);
+
+		returnedValue.assign((const char*)cursor, size);
+		cursor += size;
+	}
+
+	// -------------------------------------------------------------------
+	// ReadText
+	// -------------------------------------------------------------------
+	inline void ByteReader::ReadText(string& returnedValue)
+	{
+		boost::int32_t size;
+		ReadInt(size);
+
+		returnedValue.assign((const char*)cursor, (size_t)size);
+		cursor += size;
+	}
+
+}	// namespace Util
+}	// namespace Sfs2X
+
+#endif
@@ -0,0 +1,184 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of ByteWriter
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __ByteWriter__
+#define __ByteWriter__
+
+#include "Common.h"
+#include "ByteOrder.h"
+
+#include <boost/cstdint.hpp>					// Boost fixed size integers
+
+#include <string.h>						// memcpy
+
+namespace Sfs2X {
+namespace Util {
+
+	// -------------------------------------------------------------------
+	// Class ByteWriter
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Writes big endian values into a span of bytes it does not own
+	/// </summary>
+	///
+	/// <remarks>
+	/// Writes are not bounds checked: the span is sized for the whole block up front
+	/// (see <see cref="ByteArray.Writer"/>), then each value is written with a single store.
+	/// </remarks>
+	class ByteWriter
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		ByteWriter(unsigned char* data, long int length);
+
+		long int Position() const;
+		long int Remaining() const;
+
+		void WriteByte(unsigned char value);
+		void WriteBool(bool value);
+		void WriteShort(short int value);
+		void WriteUShort(unsigned short int value);
+		void WriteInt(boost::int32_t value);
+		void WriteLong(long long value);
+		void WriteFloat(float value);
+		void WriteDouble(double value);
+		void WriteBytes(const unsigned char* data, long int count);
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		unsigned char* begin;
+		unsigned char* cursor;
+		unsigned char* end;
+	};
+
+	// -------------------------------------------------------------------
+	// Constructor
+	// -------------------------------------------------------------------
+	inline ByteWriter::ByteWriter(unsigned char* data, long int length)
+	{
+		begin = data;
+		cursor = data;
+		end = data + length;
+	}
+
+	// -------------------------------------------------------------------
+	// Position
+	// -------------------------------------------------------------------
+	inline long int ByteWriter::Position() const
+	{
+		return (long int)(cursor - begin);
+	}
+
+	// -------------------------------------------------------------------
+	// Remaining
+	// -------------------------------------------------------------------
+	inline long int ByteWriter::Remaining() const
+	{
+		return (long int)(end - cursor);
+	}
+
+	// -------------------------------------------------------------------
+	// WriteByte
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteByte(unsigned char value)
+	{
+		*cursor++ = value;
+	}
+
+	// -------------------------------------------------------------------
+	// WriteBool
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteBool(bool value)
+	{
+		*cursor++ = value ? (unsigned char)1 : (unsigned char)0;
+	}
+
+	// -------------------------------------------------------------------
+	// WriteShort
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteShort(short int value)
+	{
+		ByteOrder::StoreBig16(cursor, (boost::uint16_t)value);
+		cursor += 2;
+	}
+
+	// -------------------------------------------------------------------
+	// WriteUShort
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteUShort(unsigned short int value)
+	{
+		ByteOrder::StoreBig16(cursor, (boost::uint16_t)value);
+		cursor += 2;
+	}
+
+	// -------------------------------------------------------------------
+	// WriteInt
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteInt(boost::int32_t value)
+	{
+		ByteOrder::StoreBig32(cursor, (boost::uint32_t)value);
+		cursor += 4;
+	}
+
+	// -------------------------------------------------------------------
+	// WriteLong
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteLong(long long value)
+	{
+		ByteOrder::StoreBig64(cursor, (boost::uint64_t)value);
+		cursor += 8;
+	}
+
+	// -------------------------------------------------------------------
+	// WriteFloat
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteFloat(float value)
+	{
+		ByteOrder::StoreBigFloat(cursor, value);
+		cursor += 4;
+	}
+
+	// -------------------------------------------------------------------
+	// WriteDouble
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteDouble(double value)
+	{
+		ByteOrder::StoreBigDouble(cursor, value);
+		cursor += 8;
+	}
+
+	// -------------------------------------------------------------------
+	// WriteBytes
+	// -------------------------------------------------------------------
+	inline void ByteWriter::WriteBytes(const unsigned char* data, long int count)
+	{
+		if (count > 0)
+		{
+			memcpy(cursor, data, (size_t)count);
+			cursor += count;
+		}
+	}
+
+}	// namespace Util
+}	// namespace Sfs2X
+
+#endif
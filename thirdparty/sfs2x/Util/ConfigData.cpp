@@ -28,6 +28,8 @@ ConfigData::ConfigData()
 	httpPort = 8080;
 	httpsPort = 8443;
 	useBlueBox = true;
+	useWebSocket = false;
+	webSocketSSL = false;
 	blueBoxPollingRate = 750;
 	forceIPv6 = false;
 }
@@ -176,6 +178,38 @@ void ConfigData::UseBlueBox(bool value)
 	useBlueBox = value;
 }
 
+// -------------------------------------------------------------------
+// UseWebSocket
+// -------------------------------------------------------------------
+bool ConfigData::UseWebSocket()
+{
+	return useWebSocket;
+}
+
+// -------------------------------------------------------------------
+// UseWebSocket
+// -------------------------------------------------------------------
+void ConfigData::UseWebSocket(bool value)
+{
+	useWebSocket = value;
+}
+
+// -------------------------------------------------------------------
+// WebSocketSSL
+// -------------------------------------------------------------------
+bool ConfigData::WebSocketSSL()
+{
+	return webSocketSSL;
+}
+
+// -------------------------------------------------------------------
+// WebSocketSSL
+// -------------------------------------------------------------------
+void ConfigData::WebSocketSSL(bool value)
+{
+	webSocketSSL = value;
+}
+
 // -------------------------------------------------------------------
 // BlueBoxPollingRate
 // -------------------------------------------------------------------
@@ -206,6 +206,42 @@ namespace Util {
 		/// </remarks>
 		void UseBlueBox(bool value);
 
+		/// <summary>
+		/// Get the state of the WebSocket fallback.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The default value is <c>false</c>.
+		/// </remarks>
+		bool UseWebSocket();
+
+		/// <summary>
+		/// Indicates whether a WebSocket connection on the HTTP port should be attempted when the socket connection fails, before the BlueBox.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The default value is <c>false</c>.
+		/// </remarks>
+		void UseWebSocket(bool value);
+
+		/// <summary>
+		/// Get whether the WebSocket connection is encrypted.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The default value is <c>false</c>.
+		/// </remarks>
+		bool WebSocketSSL();
+
+		/// <summary>
+		/// Indicates whether the WebSocket connection is established over TLS on the HTTPS port instead of the HTTP port.
+		/// </summary>
+		/// 
+		/// <remarks>
+		/// The default value is <c>false</c>.
+		/// </remarks>
+		void WebSocketSSL(bool value);
+
 		/// <summary>
 		/// Get the BlueBox polling speed.
 		/// </summary>
@@ -278,6 +314,8 @@ namespace Util {
 		unsigned short int httpPort;
 		unsigned short int httpsPort;
 		bool useBlueBox;
+		bool useWebSocket;
+		bool webSocketSSL;
 		long int blueBoxPollingRate;
 		bool forceIPv6;
 	};
@@ -178,6 +178,14 @@ void ConfigLoader::TryParse()
 			cfgData->UseBlueBox(true);
 		}
 
+		if ((GetNodeText(configNode, "useWebSocket") != NULL) && ((*(GetNodeText(configNode, "useWebSocket"))) == "true")) {
+			cfgData->UseWebSocket(true);
+		}
+
+		if ((GetNodeText(configNode, "webSocketSSL") != NULL) && ((*(GetNodeText(configNode, "webSocketSSL"))) == "true")) {
+			cfgData->WebSocketSSL(true);
+		}
+
 		if ((GetNodeText(configNode, "httpPort") != NULL) && ((*(GetNodeText(configNode, "httpPort"))) != "")) {
 			cfgData->HttpPort(atoi(GetNodeText(configNode, "httpPort")->c_str()));
 		}
@@ -195,7 +203,7 @@ void ConfigLoader::TryParse()
 			cfgData->ForceIPv6(true);
 		}
 	}
-	catch (exception e) 
+	catch (const exception& e) 
 	{
 		boost::shared_ptr<string> messageException (new string(e.what()));
 		boost::shared_ptr<string> message (new string("Error parsing config file: " + (*messageException)));
@@ -104,7 +104,7 @@ namespace Sfs2X {
 
 				client->SynchConnect(address, (useHttps ? sfs->Config()->HttpsPort() : sfs->Config()->HttpPort()));
 			}
-			catch (exception e) 
+			catch (const exception& e) 
 			{
 				boost::shared_ptr<string> messageException (new string(e.what()));
 				boost::shared_ptr<string> message (new string("Http error creating http connection: " + (*messageException)));
@@ -115,7 +115,7 @@ namespace Sfs2X {
 				{
 					client->Shutdown();
 				}
-				catch (exception e) 
+				catch (const exception& e) 
 				{
 					boost::shared_ptr<string> messageException (new string(e.what()));
 					boost::shared_ptr<string> message (new string("Error during http scocket shutdown: " + (*messageException)));
@@ -205,7 +205,7 @@ namespace Sfs2X {
 				this->key = boost::shared_ptr<string>(new string(dataPayload));
 				returned = true;
 			}
-			catch (exception e) 
+			catch (const exception& e) 
 			{
 				boost::shared_ptr<string> messageException (new string(e.what()));
 				boost::shared_ptr<string> message (new string("Error during http request: " + (*messageException)));
@@ -217,7 +217,7 @@ namespace Sfs2X {
 			{
 				client->Shutdown();
 			}
-			catch (exception e) 
+			catch (const exception& e) 
 			{
 				boost::shared_ptr<string> messageException (new string(e.what()));
 				boost::shared_ptr<string> message (new string("Error during http scocket shutdown: " + (*messageException)));
@@ -238,19 +238,15 @@ namespace Sfs2X {
 
 			try 
 			{
-				// Create a context that uses the default paths for
-				// finding CA certificates.
-				boost::asio::ssl::context contextSSL(boost::asio::ssl::context::sslv23);
-				contextSSL.set_default_verify_paths();
-				//contextSSL.load_verify_file("ca.pem");
-
-				client = boost::shared_ptr<TCPClientSSL>(new TCPClientSSL(*(sfs->GetBoostService()), contextSSL));
+				// The shared context uses the default paths for finding CA certificates,
+				// and resumes the TLS session of a previous key request to the same server
+				client = boost::shared_ptr<TCPClientSSL>(new TCPClientSSL(*(sfs->GetBoostService())));
 
 				boost::shared_ptr<IPAddress> address(new IPAddress(*sfs->GetIPAddress(sfs->Config()->Host(), (useHttps ? sfs->Config()->HttpsPort() : sfs->Config()->HttpPort()))));
 
 				client->SynchConnect(address, (useHttps ? sfs->Config()->HttpsPort() : sfs->Config()->HttpPort()));
 			}
-			catch (exception e) 
+			catch (const exception& e) 
 			{
 				boost::shared_ptr<string> messageException (new string(e.what()));
 				boost::shared_ptr<string> message (new string("Http error creating http connection: " + (*messageException)));
@@ -261,7 +257,7 @@ namespace Sfs2X {
 				{
 					client->Shutdown();
 				}
-				catch (exception e) 
+				catch (const exception& e) 
 				{
 					boost::shared_ptr<string> messageException (new string(e.what()));
 					boost::shared_ptr<string> message (new string("Error during http scocket shutdown: " + (*messageException)));
@@ -351,7 +347,7 @@ namespace Sfs2X {
 				this->key = boost::shared_ptr<string>(new string(dataPayload));
 				returned = true;
 			}
-			catch (exception e) 
+			catch (const exception& e) 
 			{
 				boost::shared_ptr<string> messageException (new string(e.what()));
 				boost::shared_ptr<string> message (new string("Error during http request: " + (*messageException)));
@@ -363,7 +359,7 @@ namespace Sfs2X {
 			{
 				client->Shutdown();
 			}
-			catch (exception e) 
+			catch (const exception& e) 
 			{
 				boost::shared_ptr<string> messageException (new string(e.what()));
 				boost::shared_ptr<string> message (new string("Error during http scocket shutdown: " + (*messageException)));
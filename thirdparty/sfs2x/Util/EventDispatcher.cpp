@@ -19,7 +19,7 @@ namespace Util {
 EventDispatcher::EventDispatcher(boost::shared_ptr<void> target)
 {
 	this->target = target;
-	this->lastDispatchedEvent = "";
+	this->lastDispatchedEvent = NULL;
 }
 
 // -------------------------------------------------------------------
@@ -36,7 +36,8 @@ void EventDispatcher::Dispose()
 // -------------------------------------------------------------------
 void EventDispatcher::AddEventListener(boost::shared_ptr<string> eventType, boost::shared_ptr<EventListenerDelegate> listener)
 {
-	listeners.insert(std::pair<string, boost::shared_ptr<EventListenerDelegate> >(*eventType, listener));
+	const string* type = KeyTable::Atom(*eventType).get();
+	listeners.insert(std::pair<const string*, boost::shared_ptr<EventListenerDelegate> >(type, listener));
 }
 
 // -------------------------------------------------------------------
@@ -44,8 +45,14 @@ void EventDispatcher::AddEventListener(boost::shared_ptr<string> eventType, boos
 // -------------------------------------------------------------------
 void EventDispatcher::RemoveEventListener(boost::shared_ptr<string> eventType, boost::shared_ptr<EventListenerDelegate> listener)
 {
-	map<string, boost::shared_ptr<EventListenerDelegate> >::iterator iterator;
-	iterator = listeners.find(*eventType);
+	const string* type = KeyTable::Find(*eventType);
+	if (type == NULL)
+	{
+		return;
+	}
+
+	map<const string*, boost::shared_ptr<EventListenerDelegate> >::iterator iterator;
+	iterator = listeners.find(type);
 	if (iterator != listeners.end())
 	{
 		listeners.erase (iterator); 
@@ -57,12 +64,26 @@ void EventDispatcher::RemoveEventListener(boost::shared_ptr<string> eventType, b
 // -------------------------------------------------------------------
 void EventDispatcher::DispatchEvent(boost::shared_ptr<BaseEvent> evt)
 {
-	map<string, boost::shared_ptr<EventListenerDelegate> >::iterator iterator;
-	iterator = listeners.find(*(evt->Type()));
+	// The event types of the API are atoms and match by address; any other type string is resolved to its atom
+	const string* type = evt->Type().get();
+
+	map<const string*, boost::shared_ptr<EventListenerDelegate> >::iterator iterator;
+	iterator = listeners.find(type);
+
+	if (iterator == listeners.end())
+	{
+		type = KeyTable::Find(*(evt->Type()));
+		if ((type == NULL) || (type == evt->Type().get()))
+		{
+			return;
+		}
+
+		iterator = listeners.find(type);
+	}
 
 	if (iterator != listeners.end())
 	{
-		if (FilterEvent(evt) == true)
+		if (FilterEvent(type) == true)
 		{
 			return;
 		}
@@ -70,23 +91,23 @@ void EventDispatcher::DispatchEvent(boost::shared_ptr<BaseEvent> evt)
 		evt->Target(target);
 		(*iterator).second->Invoke(evt);
 
-		lastDispatchedEvent = *(evt->Type());
+		lastDispatchedEvent = type;
 	}
 }
 
 // -------------------------------------------------------------------
 // FilterEvent
 // -------------------------------------------------------------------
-bool EventDispatcher::FilterEvent(boost::shared_ptr<BaseEvent> evt)
+bool EventDispatcher::FilterEvent(const string* type)
 {
-	if (*evt->Type() != lastDispatchedEvent)
+	if (type != lastDispatchedEvent)
 	{
 		return false;
 	}
 
 	// Filter duplicated "connection lost" events 
 	// (for instance when connection is idle, this event is triggered from both server application message and socket falldown)
-	if (evt->Type() == SFSEvent::CONNECTION_LOST)
+	if (type == SFSEvent::CONNECTION_LOST.get())
 	{
 		return true;
 	}
@@ -12,6 +12,7 @@
 #define __EventDispatcher__
 
 #include "DelegateOneArgument.h"	// Delegate with one parameter
+#include "KeyTable.h"
 #include "../Core/BaseEvent.h"
 #include "../Core/SFSEvent.h"
 
@@ -69,15 +70,15 @@ namespace Util {
 		// -------------------------------------------------------------------
 		// Private methods
 		// -------------------------------------------------------------------
-		bool FilterEvent(boost::shared_ptr<BaseEvent> evt);
+		bool FilterEvent(const string* type);
 
 		// -------------------------------------------------------------------
 		// Private members
 		// -------------------------------------------------------------------
 
 		boost::shared_ptr<void> target;
-		map<string, boost::shared_ptr<EventListenerDelegate> > listeners;
-		string lastDispatchedEvent;
+		map<const string*, boost::shared_ptr<EventListenerDelegate> > listeners;		// Keyed by the interned event type
+		const string* lastDispatchedEvent;
 	};
 
 }	// namespace Util
@@ -0,0 +1,203 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of KeyTable
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "KeyTable.h"
+
+namespace Sfs2X {
+namespace Util {
+
+const long int KeyTable::MAX_KEYS = 8192;
+const long int KeyTable::MAX_KEY_LENGTH = 64;
+const long int KeyTable::BUCKETS = 1024;
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+KeyTable::KeyTable()
+	: buckets(new boost::atomic<Entry*>[BUCKETS]),
+	  count(0)
+{
+	for (long int index = 0; index < BUCKETS; index++)
+	{
+		buckets[index].store(NULL, boost::memory_order_relaxed);
+	}
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+KeyTable::~KeyTable()
+{
+	for (long int index = 0; index < BUCKETS; index++)
+	{
+		Entry* entry = buckets[index].load(boost::memory_order_relaxed);
+		while (entry != NULL)
+		{
+			Entry* next = entry->next;
+			delete entry;
+			entry = next;
+		}
+	}
+}
+
+// -------------------------------------------------------------------
+// Atom
+// -------------------------------------------------------------------
+boost::shared_ptr<string> KeyTable::Atom(const string& key)
+{
+	KeyTable& table = Instance();
+	unsigned long int hash = Hash(key);
+
+	Entry* entry = table.Lookup(key, hash);
+	if (entry != NULL)
+	{
+		return entry->atom;
+	}
+
+	boost::lock_guard<boost::mutex> lock(table.lockTable);
+
+	// Another thread may have interned the key in the meantime
+	entry = table.Lookup(key, hash);
+	if (entry == NULL)
+	{
+		entry = table.Insert(key, hash);
+	}
+
+	return entry->atom;
+}
+
+// -------------------------------------------------------------------
+// Intern
+// -------------------------------------------------------------------
+const string* KeyTable::Intern(const string& key)
+{
+	if ((long int)key.size() > MAX_KEY_LENGTH)
+	{
+		return NULL;
+	}
+
+	KeyTable& table = Instance();
+	unsigned long int hash = Hash(key);
+
+	// Decoded objects mostly carry keys already interned: they are found without taking the lock
+	Entry* entry = table.Lookup(key, hash);
+	if (entry != NULL)
+	{
+		return entry->atom.get();
+	}
+
+	if (table.count.load(boost::memory_order_relaxed) >= MAX_KEYS)
+	{
+		return NULL;
+	}
+
+	boost::lock_guard<boost::mutex> lock(table.lockTable);
+
+	entry = table.Lookup(key, hash);
+	if (entry == NULL)
+	{
+		if (table.count.load(boost::memory_order_relaxed) >= MAX_KEYS)
+		{
+			return NULL;
+		}
+
+		entry = table.Insert(key, hash);
+	}
+
+	return entry->atom.get();
+}
+
+// -------------------------------------------------------------------
+// Find
+// -------------------------------------------------------------------
+const string* KeyTable::Find(const string& key)
+{
+	KeyTable& table = Instance();
+
+	Entry* entry = table.Lookup(key, Hash(key));
+
+	return (entry != NULL) ? entry->atom.get() : NULL;
+}
+
+// -------------------------------------------------------------------
+// Count
+// -------------------------------------------------------------------
+long int KeyTable::Count()
+{
+	return Instance().count.load(boost::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------
+// Instance
+// -------------------------------------------------------------------
+KeyTable& KeyTable::Instance()
+{
+	// Created on first use, as the constants of other modules are interned during static initialization
+	static KeyTable table;
+	return table;
+}
+
+// -------------------------------------------------------------------
+// Hash
+// -------------------------------------------------------------------
+unsigned long int KeyTable::Hash(const string& key)
+{
+	// FNV-1a
+	unsigned long int hash = 2166136261UL;
+
+	string::const_iterator iterator;
+	for (iterator = key.begin(); iterator != key.end(); ++iterator)
+	{
+		hash = ((hash ^ (unsigned char)*iterator) * 16777619UL) & 0xFFFFFFFFUL;
+	}
+
+	return hash;
+}
+
+// -------------------------------------------------------------------
+// Lookup
+// -------------------------------------------------------------------
+KeyTable::Entry* KeyTable::Lookup(const string& key, unsigned long int hash)
+{
+	// Entries are never modified nor removed once published, so the list can be walked while another thread inserts
+	Entry* entry = buckets[hash & (BUCKETS - 1)].load(boost::memory_order_acquire);
+
+	for (; entry != NULL; entry = entry->next)
+	{
+		if (entry->hash == hash && *(entry->atom) == key)
+		{
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+// -------------------------------------------------------------------
+// Insert
+// -------------------------------------------------------------------
+KeyTable::Entry* KeyTable::Insert(const string& key, unsigned long int hash)
+{
+	boost::atomic<Entry*>& bucket = buckets[hash & (BUCKETS - 1)];
+
+	Entry* entry = new Entry();
+	entry->atom = boost::shared_ptr<string>(new string(key));
+	entry->hash = hash;
+	entry->next = bucket.load(boost::memory_order_relaxed);
+
+	// The entry becomes visible to the lookups only once it is complete
+	bucket.store(entry, boost::memory_order_release);
+	count.fetch_add(1, boost::memory_order_relaxed);
+
+	return entry;
+}
+
+}	// namespace Util
+}	// namespace Sfs2X
@@ -0,0 +1,134 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of KeyTable
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __KeyTable__
+#define __KeyTable__
+
+#include "Common.h"
+
+#include <boost/shared_ptr.hpp>				// Boost Asio shared pointer
+#include <boost/scoped_array.hpp>			// Boost scoped array
+#include <boost/atomic.hpp>					// Boost atomic
+#include <boost/thread/mutex.hpp>			// Boost mutex
+#include <boost/thread/locks.hpp>			// Boost lock guard
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <string>						// STL library: string object
+using namespace std;					// STL library: declare the STL namespace
+
+namespace Sfs2X {
+namespace Util {
+
+	// -------------------------------------------------------------------
+	// Class KeyTable
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// The process wide table of interned keys
+	/// </summary>
+	///
+	/// <remarks>
+	/// Each distinct key is stored once, as an atom that is never released: two keys are equal when their atoms have the same address.<br/>
+	/// Protocol keys, event types and the keys of decoded SFSObjects are interned, so that they are not copied into every object
+	/// and can be compared without looking at their characters.<br/>
+	/// Keys coming from the network are interned only while the table has room (see <see cref="MAX_KEYS"/> and <see cref="MAX_KEY_LENGTH"/>),
+	/// so that a peer sending ever changing keys cannot grow it without bounds.<br/>
+	/// The table is thread safe: entries are only ever added, so lookups take no lock and only the insertion of a new key is serialized.
+	/// </remarks>
+	class DLLImportExport KeyTable
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		/// <summary>
+		/// Returns the atom of the passed key, interning it whatever the size of the table
+		/// </summary>
+		/// <remarks>
+		/// Meant for the constants of the API; the returned pointer must not be used to modify the key.
+		/// </remarks>
+		static boost::shared_ptr<string> Atom(const string& key);
+
+		/// <summary>
+		/// Returns the atom of the passed key, interning it if the table has room
+		/// </summary>
+		/// <returns>
+		/// The atom, or NULL if the key is not interned and cannot be
+		/// </returns>
+		static const string* Intern(const string& key);
+
+		/// <summary>
+		/// Returns the atom of the passed key, without interning it
+		/// </summary>
+		/// <returns>
+		/// The atom, or NULL if the key is not interned
+		/// </returns>
+		static const string* Find(const string& key);
+
+		static long int Count();
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		static const long int MAX_KEYS;
+		static const long int MAX_KEY_LENGTH;
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		KeyTable();
+		~KeyTable();
+		KeyTable(const KeyTable&);
+		KeyTable& operator=(const KeyTable&);
+
+		// -------------------------------------------------------------------
+		// Private types
+		// -------------------------------------------------------------------
+
+		struct Entry
+		{
+			boost::shared_ptr<string> atom;
+			unsigned long int hash;
+			Entry* next;
+		};
+
+		static KeyTable& Instance();
+		static unsigned long int Hash(const string& key);
+
+		// Lookup
+		// Return the entry of a key, NULL if the key is not interned; takes no lock
+		Entry* Lookup(const string& key, unsigned long int hash);
+
+		// Insert
+		// Add a key at the head of its bucket; must be called with lockTable held
+		Entry* Insert(const string& key, unsigned long int hash);
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		static const long int BUCKETS;
+
+		boost::mutex lockTable;										// Serializes the inserts, lookups do not take it
+		boost::scoped_array<boost::atomic<Entry*> > buckets;		// Heads of the bucket lists, published once an entry is complete
+		boost::atomic<long int> count;
+	};
+
+}	// namespace Util
+}	// namespace Sfs2X
+
+#endif
@@ -0,0 +1,105 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of PacketArena
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "PacketArena.h"
+
+namespace Sfs2X {
+namespace Util {
+
+const size_t PacketArena::ALIGNMENT = 16;
+const size_t PacketArena::DEFAULT_CHUNK_SIZE = 16384;
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+PacketArena::PacketArena(size_t chunkSize)
+{
+	this->chunkSize = chunkSize < 1024 ? 1024 : chunkSize;
+	cursor = NULL;
+	available = 0;
+	allocatedBytes = 0;
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+PacketArena::~PacketArena()
+{
+	vector<unsigned char*>::iterator iterator;
+	for (iterator = chunks.begin(); iterator != chunks.end(); ++iterator)
+	{
+		::operator delete(*iterator);
+	}
+
+	chunks.clear();
+}
+
+// -------------------------------------------------------------------
+// Allocate
+// -------------------------------------------------------------------
+void* PacketArena::Allocate(size_t size)
+{
+	size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	if (size == 0)
+	{
+		size = ALIGNMENT;
+	}
+
+	allocatedBytes += size;
+
+	// Large blocks get a chunk of their own, so that the current chunk is not wasted
+	if (size > chunkSize / 4)
+	{
+		return AllocateChunk(size);
+	}
+
+	if (size > available)
+	{
+		cursor = AllocateChunk(chunkSize);
+		available = chunkSize;
+	}
+
+	void* block = cursor;
+	cursor += size;
+	available -= size;
+
+	return block;
+}
+
+// -------------------------------------------------------------------
+// AllocatedBytes
+// -------------------------------------------------------------------
+size_t PacketArena::AllocatedBytes()
+{
+	return allocatedBytes;
+}
+
+// -------------------------------------------------------------------
+// ChunkCount
+// -------------------------------------------------------------------
+size_t PacketArena::ChunkCount()
+{
+	return chunks.size();
+}
+
+// -------------------------------------------------------------------
+// AllocateChunk
+// -------------------------------------------------------------------
+unsigned char* PacketArena::AllocateChunk(size_t size)
+{
+	// operator new returns memory aligned for any fundamental type
+	unsigned char* chunk = (unsigned char*)::operator new(size);
+	chunks.push_back(chunk);
+
+	return chunk;
+}
+
+}	// namespace Util
+}	// namespace Sfs2X
@@ -0,0 +1,223 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of PacketArena
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __PacketArena__
+#define __PacketArena__
+
+#include "Common.h"
+
+#include <boost/shared_ptr.hpp>				// Boost Asio shared pointer
+#include <boost/make_shared.hpp>			// Boost shared pointer factories
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <vector>						// STL library: vector object
+#include <new>							// STL library: placement new
+#include <cstddef>						// STL library: size_t, ptrdiff_t
+using namespace std;					// STL library: declare the STL namespace
+
+namespace Sfs2X {
+namespace Util {
+
+	// -------------------------------------------------------------------
+	// Class PacketArena
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// A bump allocator holding the object graph decoded from one inbound packet
+	/// </summary>
+	///
+	/// <remarks>
+	/// Memory is carved sequentially from a few large chunks and is never given back one block at a time:
+	/// the chunks are released together when the arena is destroyed.<br/>
+	/// Objects are created through <see cref="New"/>, whose shared pointers keep the arena alive, so the whole region
+	/// goes away with the last reference to any object of the graph. Holding on to a single decoded value therefore
+	/// keeps the memory of the whole packet.<br/>
+	/// Only the object nodes live in the arena; the contents of strings and STL containers are still allocated on the heap.
+	/// An arena is not thread safe: it is filled by one decoder, then only read.
+	/// </remarks>
+	class DLLImportExport PacketArena
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		/// <summary>
+		/// Creates an empty arena; the first chunk is allocated on the first request
+		/// </summary>
+		/// <param name="chunkSize">The size in bytes of each chunk; requests larger than a quarter of it get a chunk of their own</param>
+		PacketArena(size_t chunkSize);
+		virtual ~PacketArena();
+
+		/// <summary>
+		/// Returns a block of at least <paramref name="size"/> bytes, aligned for any fundamental type
+		/// </summary>
+		void* Allocate(size_t size);
+
+		size_t AllocatedBytes();
+		size_t ChunkCount();
+
+		/// <summary>
+		/// Creates an object in the arena, or on the heap when <paramref name="arena"/> is empty
+		/// </summary>
+		template <typename T> static boost::shared_ptr<T> New(boost::shared_ptr<PacketArena> arena);
+		template <typename T, typename A1> static boost::shared_ptr<T> New(boost::shared_ptr<PacketArena> arena, const A1& a1);
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		static const size_t ALIGNMENT;
+		static const size_t DEFAULT_CHUNK_SIZE;
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		PacketArena(const PacketArena&);
+		PacketArena& operator=(const PacketArena&);
+
+		unsigned char* AllocateChunk(size_t size);
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		vector<unsigned char*> chunks;
+		unsigned char* cursor;
+		size_t available;
+		size_t chunkSize;
+		size_t allocatedBytes;
+	};
+
+	// -------------------------------------------------------------------
+	// Class PacketArenaAllocator
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Standard allocator drawing from a <see cref="PacketArena"/>; deallocation is a no-op
+	/// </summary>
+	/// <remarks>
+	/// Every copy holds a reference to the arena, so shared pointers created with <b>boost::allocate_shared</b>
+	/// keep the arena alive through their control block.
+	/// </remarks>
+	template <typename T> class PacketArenaAllocator
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		typedef T value_type;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		template <typename U> struct rebind
+		{
+			typedef PacketArenaAllocator<U> other;
+		};
+
+		explicit PacketArenaAllocator(boost::shared_ptr<PacketArena> arena) : arena(arena)
+		{
+		}
+
+		template <typename U> PacketArenaAllocator(const PacketArenaAllocator<U>& other) : arena(other.arena)
+		{
+		}
+
+		pointer allocate(size_type count, const void* hint = 0)
+		{
+			return (pointer)arena->Allocate(count * sizeof(T));
+		}
+
+		void deallocate(pointer p, size_type count)
+		{
+		}
+
+		void construct(pointer p, const T& value)
+		{
+			new((void*)p) T(value);
+		}
+
+		void destroy(pointer p)
+		{
+			p->~T();
+		}
+
+		pointer address(reference value) const
+		{
+			return &value;
+		}
+
+		const_pointer address(const_reference value) const
+		{
+			return &value;
+		}
+
+		size_type max_size() const
+		{
+			return ((size_type)-1) / sizeof(T);
+		}
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		boost::shared_ptr<PacketArena> arena;
+	};
+
+	template <typename T, typename U> inline bool operator==(const PacketArenaAllocator<T>& a, const PacketArenaAllocator<U>& b)
+	{
+		return a.arena == b.arena;
+	}
+
+	template <typename T, typename U> inline bool operator!=(const PacketArenaAllocator<T>& a, const PacketArenaAllocator<U>& b)
+	{
+		return a.arena != b.arena;
+	}
+
+	// -------------------------------------------------------------------
+	// New
+	// -------------------------------------------------------------------
+	template <typename T> boost::shared_ptr<T> PacketArena::New(boost::shared_ptr<PacketArena> arena)
+	{
+		if (arena == NULL)
+		{
+			return boost::make_shared<T>();
+		}
+
+		return boost::allocate_shared<T>(PacketArenaAllocator<T>(arena));
+	}
+
+	// -------------------------------------------------------------------
+	// New
+	// -------------------------------------------------------------------
+	template <typename T, typename A1> boost::shared_ptr<T> PacketArena::New(boost::shared_ptr<PacketArena> arena, const A1& a1)
+	{
+		if (arena == NULL)
+		{
+			return boost::make_shared<T>(a1);
+		}
+
+		return boost::allocate_shared<T>(PacketArenaAllocator<T>(arena), a1);
+	}
+
+}	// namespace Util
+}	// namespace Sfs2X
+
+#endif
@@ -0,0 +1,264 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of RequestCorrelator
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "RequestCorrelator.h"
+
+namespace Sfs2X {
+namespace Util {
+
+boost::shared_ptr<string> RequestCorrelator::REASON_TIMEOUT (new string("timeout"));
+boost::shared_ptr<string> RequestCorrelator::REASON_CANCELLED (new string("cancelled"));
+boost::shared_ptr<string> RequestCorrelator::REASON_CONNECTION_LOST (new string("connectionLost"));
+boost::shared_ptr<string> RequestCorrelator::REASON_REJECTED (new string("rejected"));
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+RequestCorrelator::RequestCorrelator(boost::asio::io_service& io_service, boost::shared_ptr<SmartFox> sfs)
+	: boostIoService(io_service)
+{
+	this->sfs = sfs;
+	this->lastRequestId = 0;
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+RequestCorrelator::~RequestCorrelator()
+{
+}
+
+// -------------------------------------------------------------------
+// Dispose
+// -------------------------------------------------------------------
+void RequestCorrelator::Dispose()
+{
+	boost::lock_guard<boost::mutex> lock(mtxRequests);
+
+	map<long int, PendingRequest>::iterator iterator;
+	for (iterator = requests.begin(); iterator != requests.end(); iterator++)
+	{
+		if (iterator->second.timer != NULL)
+		{
+			iterator->second.timer->cancel();
+		}
+	}
+
+	requests.clear();
+	sfs = boost::shared_ptr<SmartFox>();
+}
+
+// -------------------------------------------------------------------
+// Track
+// -------------------------------------------------------------------
+long int RequestCorrelator::Track(boost::shared_ptr<string> cmd, boost::shared_ptr<ExtensionResponseDelegate> callback, long int timeout)
+{
+	boost::lock_guard<boost::mutex> lock(mtxRequests);
+
+	// Ids travel as SFSObject integers: keep them positive on 32 bits, skipping those still pending after a wrap
+	do
+	{
+		lastRequestId = (lastRequestId >= 0x7FFFFFFF) ? 1 : lastRequestId + 1;
+	}
+	while (requests.find(lastRequestId) != requests.end());
+
+	PendingRequest request;
+	request.cmd = cmd;
+	request.callback = callback;
+	request.isFailed = false;
+
+	if (timeout > 0)
+	{
+		request.timer = boost::shared_ptr<boost::asio::deadline_timer>(new boost::asio::deadline_timer(boostIoService));
+		request.timer->expires_from_now(boost::posix_time::milliseconds(timeout));
+		request.timer->async_wait(boost::bind(&RequestCorrelator::OnTimeout, shared_from_this(), lastRequestId, boost::asio::placeholders::error));
+	}
+
+	requests[lastRequestId] = request;
+
+	return lastRequestId;
+}
+
+// -------------------------------------------------------------------
+// Cancel
+// -------------------------------------------------------------------
+bool RequestCorrelator::Cancel(long int requestId)
+{
+	return Fail(requestId, REASON_CANCELLED);
+}
+
+// -------------------------------------------------------------------
+// Reject
+// -------------------------------------------------------------------
+bool RequestCorrelator::Reject(long int requestId)
+{
+	return Fail(requestId, REASON_REJECTED);
+}
+
+// -------------------------------------------------------------------
+// PendingRequests
+// -------------------------------------------------------------------
+long int RequestCorrelator::PendingRequests()
+{
+	boost::lock_guard<boost::mutex> lock(mtxRequests);
+	return (long int)requests.size();
+}
+
+// -------------------------------------------------------------------
+// HandleEvent
+// -------------------------------------------------------------------
+void RequestCorrelator::HandleEvent(boost::shared_ptr<BaseEvent> evt)
+{
+	boost::shared_ptr<string> type = evt->Type();
+
+	if (*type == *SFSEvent::CONNECTION_LOST)
+	{
+		FailAll(REASON_CONNECTION_LOST);
+		return;
+	}
+
+	if (*type != *SFSEvent::EXTENSION_RESPONSE && *type != *SFSEvent::EXTENSION_REQUEST_FAILED)
+	{
+		return;
+	}
+
+	if (evt->Params() == NULL)
+	{
+		return;
+	}
+
+	map<string, boost::shared_ptr<void> >::iterator iterator = evt->Params()->find("requestId");
+	if (iterator == evt->Params()->end() || iterator->second == NULL)
+	{
+		return;
+	}
+
+	long int requestId = *((boost::static_pointer_cast<long int>)(iterator->second));
+
+	// A response arriving after the failure of its request is left to the listeners only
+	Settle(requestId, evt, *type == *SFSEvent::EXTENSION_RESPONSE);
+}
+
+// -------------------------------------------------------------------
+// Fail
+// -------------------------------------------------------------------
+bool RequestCorrelator::Fail(long int requestId, boost::shared_ptr<string> reason)
+{
+	boost::shared_ptr<SmartFox> client;
+	boost::shared_ptr<map<string, boost::shared_ptr<void> > > evtParams (new map<string, boost::shared_ptr<void> >());
+
+	{
+		boost::lock_guard<boost::mutex> lock(mtxRequests);
+
+		map<long int, PendingRequest>::iterator iterator = requests.find(requestId);
+		if (iterator == requests.end() || iterator->second.isFailed == true)
+		{
+			return false;
+		}
+
+		iterator->second.isFailed = true;
+		if (iterator->second.timer != NULL)
+		{
+			iterator->second.timer->cancel();
+		}
+
+		evtParams->insert(pair<string, boost::shared_ptr<void> >("cmd", iterator->second.cmd));
+		client = sfs;
+	}
+
+	if (client == NULL)
+	{
+		return false;
+	}
+
+	boost::shared_ptr<long int> valueRequestId (new long int());
+	*valueRequestId = requestId;
+	evtParams->insert(pair<string, boost::shared_ptr<void> >("requestId", valueRequestId));
+	evtParams->insert(pair<string, boost::shared_ptr<void> >("reason", reason));
+
+	// The request is settled when the event is dispatched, so the callback runs where the listeners do
+	boost::shared_ptr<SFSEvent> evt (new SFSEvent(SFSEvent::EXTENSION_REQUEST_FAILED, evtParams));
+	client->DispatchEvent(evt);
+
+	return true;
+}
+
+// -------------------------------------------------------------------
+// FailAll
+// -------------------------------------------------------------------
+void RequestCorrelator::FailAll(boost::shared_ptr<string> reason)
+{
+	vector<long int> requestIds;
+
+	{
+		boost::lock_guard<boost::mutex> lock(mtxRequests);
+
+		map<long int, PendingRequest>::iterator iterator;
+		for (iterator = requests.begin(); iterator != requests.end(); iterator++)
+		{
+			requestIds.push_back(iterator->first);
+		}
+	}
+
+	vector<long int>::iterator iterator;
+	for (iterator = requestIds.begin(); iterator != requestIds.end(); iterator++)
+	{
+		Fail(*iterator, reason);
+	}
+}
+
+// -------------------------------------------------------------------
+// Settle
+// -------------------------------------------------------------------
+void RequestCorrelator::Settle(long int requestId, boost::shared_ptr<BaseEvent> evt, bool onlyPending)
+{
+	boost::shared_ptr<ExtensionResponseDelegate> callback;
+
+	{
+		boost::lock_guard<boost::mutex> lock(mtxRequests);
+
+		map<long int, PendingRequest>::iterator iterator = requests.find(requestId);
+		if (iterator == requests.end() || (onlyPending == true && iterator->second.isFailed == true))
+		{
+			return;
+		}
+
+		if (iterator->second.timer != NULL)
+		{
+			iterator->second.timer->cancel();
+		}
+
+		callback = iterator->second.callback;
+		requests.erase(iterator);
+	}
+
+	if (callback != NULL)
+	{
+		callback->Invoke(requestId, evt);
+	}
+}
+
+// -------------------------------------------------------------------
+// OnTimeout
+// -------------------------------------------------------------------
+void RequestCorrelator::OnTimeout(long int requestId, const boost::system::error_code& code)
+{
+	if (code == boost::asio::error::operation_aborted)
+	{
+		// Request settled before its timeout
+		// Nothing to do
+		return;
+	}
+
+	Fail(requestId, REASON_TIMEOUT);
+}
+
+}	// namespace Util
+}	// namespace Sfs2X
@@ -0,0 +1,163 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of RequestCorrelator
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __RequestCorrelator__
+#define __RequestCorrelator__
+
+#include "../Core/BaseEvent.h"
+#include "DelegateTwoArguments.h"						// Delegate with two parameters
+
+// Forward class declaration
+// The delegate is declared before SmartFox, whose methods use it
+namespace Sfs2X {
+namespace Util {
+	class RequestCorrelator;
+
+	// -------------------------------------------------------------------
+	// Definition of delegates specific for the request correlator
+	// -------------------------------------------------------------------
+	typedef DelegateTwoArguments<long int, boost::shared_ptr<Sfs2X::Core::BaseEvent> > ExtensionResponseDelegate;
+}	// namespace Util
+}	// namespace Sfs2X
+
+#include "../SmartFox.h"
+
+#include <boost/bind.hpp>								// Boost Asio header
+#include <boost/asio.hpp>								// Boost Asio header
+#include <boost/asio/deadline_timer.hpp>				// Boost Asio header
+#include <boost/shared_ptr.hpp>							// Boost Asio shared pointer
+#include <boost/enable_shared_from_this.hpp>			// Boost shared_ptr for this
+#include <boost/thread/mutex.hpp>						// Boost mutex
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <string>						// STL library: string object
+#include <vector>						// STL library: vector object
+#include <map>							// STL library: map object
+using namespace std;					// STL library: declare the STL namespace
+
+using namespace Sfs2X::Core;
+
+namespace Sfs2X {
+namespace Util {
+
+	// -------------------------------------------------------------------
+	// Class RequestCorrelator
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Matches the extension requests sent by <see cref="SmartFox.SendAsync"/> with their responses
+	/// </summary>
+	///
+	/// <remarks>
+	/// Every tracked request gets an id, which the server side Extension returns in the parameters of its response.
+	/// A request is settled once: by its response, or by an <see cref="SFSEvent.EXTENSION_REQUEST_FAILED"/> event on timeout, cancellation or connection loss.
+	/// <br/>
+	/// The callbacks are invoked while the events are dispatched, i.e. in <see cref="SmartFox.ProcessEvents"/> when the thread safe mode is enabled.
+	/// Timeouts run on the Boost Asio service of the client, like the lag monitor.
+	/// </remarks>
+	class DLLImportExport RequestCorrelator : public boost::enable_shared_from_this<RequestCorrelator>
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		RequestCorrelator(boost::asio::io_service& io_service, boost::shared_ptr<SmartFox> sfs);
+		virtual ~RequestCorrelator();
+		void Dispose();
+
+		// Track
+		// Starts waiting for the response to a request, and returns the id to stamp in the request
+		//		cmd			Command of the request
+		//		callback	Delegate notified when the request is settled; can be NULL
+		//		timeout		Milliseconds to wait for the response; 0 waits until the connection is closed
+		long int Track(boost::shared_ptr<string> cmd, boost::shared_ptr<ExtensionResponseDelegate> callback, long int timeout);
+
+		// Cancel
+		// Stops waiting for the response to a request
+		// Returns false when the request is unknown or already settled
+		bool Cancel(long int requestId);
+
+		// Reject
+		// Fails a request that could not be sent, e.g. because it did not pass validation
+		// Returns false when the request is unknown or already settled
+		bool Reject(long int requestId);
+
+		// PendingRequests
+		// Returns the quantity of requests still waiting for their response
+		long int PendingRequests();
+
+		// HandleEvent
+		// Settles the request answered or failed by an event, before the event reaches the listeners
+		void HandleEvent(boost::shared_ptr<BaseEvent> evt);
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+		const static long int DEFAULT_TIMEOUT = 10000;				// Default time to wait for a response [milliseconds]
+
+		static boost::shared_ptr<string> REASON_TIMEOUT;
+		static boost::shared_ptr<string> REASON_CANCELLED;
+		static boost::shared_ptr<string> REASON_CONNECTION_LOST;
+		static boost::shared_ptr<string> REASON_REJECTED;
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private types
+		// -------------------------------------------------------------------
+
+		struct PendingRequest
+		{
+			boost::shared_ptr<string> cmd;
+			boost::shared_ptr<ExtensionResponseDelegate> callback;
+			boost::shared_ptr<boost::asio::deadline_timer> timer;
+			bool isFailed;										// The failure event is being dispatched
+		};
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		// Fail
+		// Marks a pending request as failed and dispatches the failure event
+		// Returns false when the request is unknown or already settled
+		bool Fail(long int requestId, boost::shared_ptr<string> reason);
+
+		// FailAll
+		// Fails every pending request
+		void FailAll(boost::shared_ptr<string> reason);
+
+		// Settle
+		// Removes a request and notifies its callback
+		//		onlyPending		Ignore a request whose failure event is being dispatched
+		void Settle(long int requestId, boost::shared_ptr<BaseEvent> evt, bool onlyPending);
+
+		void OnTimeout(long int requestId, const boost::system::error_code& code);
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		boost::asio::io_service& boostIoService;			// Boost Asio IO service of the timeouts
+		boost::shared_ptr<SmartFox> sfs;
+
+		boost::mutex mtxRequests;							// Mutex to synchronize the pending requests
+		map<long int, PendingRequest> requests;				// Pending requests by id
+		long int lastRequestId;
+	};
+
+}	// namespace Util
+}	// namespace Sfs2X
+
+#endif
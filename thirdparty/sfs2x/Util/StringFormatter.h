@@ -102,7 +102,7 @@ namespace Util {
 	// -------------------------------------------------------------------
 	// Utf8toWStr
 	// -------------------------------------------------------------------
-	static void Utf8toWStr(boost::shared_ptr<string> src, boost::shared_ptr<wstring> dest)
+	static inline void Utf8toWStr(boost::shared_ptr<string> src, boost::shared_ptr<wstring> dest)
 	{
 		dest->clear();
 		wchar_t w = 0;
@@ -164,7 +164,7 @@ namespace Util {
 	// -------------------------------------------------------------------
 	// WStrToUtf8
 	// -------------------------------------------------------------------
-	static void WStrToUtf8(boost::shared_ptr<wstring> src, boost::shared_ptr<string> dest)
+	static inline void WStrToUtf8(boost::shared_ptr<wstring> src, boost::shared_ptr<string> dest)
 	{
 		dest->clear();
 		for (size_t i = 0; i < src->size(); i++)
@@ -0,0 +1,154 @@
+// ===================================================================
+//
+// Description
+//		Contains the implementation of ZlibCompressor
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#include "ZlibCompressor.h"
+
+#include <boost/exception/all.hpp>
+#include <cstring>
+#include <stdexcept>
+
+namespace Sfs2X {
+namespace Util {
+
+// -------------------------------------------------------------------
+// Constructor
+// -------------------------------------------------------------------
+ZlibCompressor::ZlibCompressor()
+{
+	deflateInitialized = false;
+	memset(&deflateStream, 0x00, sizeof(z_stream));
+
+	inflateInitialized = false;
+	memset(&inflateStream, 0x00, sizeof(z_stream));
+}
+
+// -------------------------------------------------------------------
+// Destructor
+// -------------------------------------------------------------------
+ZlibCompressor::~ZlibCompressor()
+{
+	if (deflateInitialized)
+	{
+		deflateEnd(&deflateStream);
+	}
+
+	if (inflateInitialized)
+	{
+		inflateEnd(&inflateStream);
+	}
+}
+
+// -------------------------------------------------------------------
+// Compress
+// -------------------------------------------------------------------
+void ZlibCompressor::Compress(vector<unsigned char>& data)
+{
+	if (!deflateInitialized)
+	{
+		if (deflateInit(&deflateStream, Z_DEFAULT_COMPRESSION) != Z_OK)
+		{
+			boost::throw_exception(boost::enable_error_info (std::runtime_error("Zlib deflate initialization failed")));
+		}
+
+		deflateInitialized = true;
+	}
+	else
+	{
+		deflateReset(&deflateStream);
+	}
+
+	// With an output as large as deflateBound, a single Z_FINISH call completes the stream
+	uLong bound = deflateBound(&deflateStream, (uLong)data.size());
+	if (deflateBuffer.size() < bound)
+	{
+		deflateBuffer.resize(bound);
+	}
+
+	deflateStream.next_in = data.empty() ? Z_NULL : &data[0];
+	deflateStream.avail_in = (uInt)data.size();
+	deflateStream.next_out = &deflateBuffer[0];
+	deflateStream.avail_out = (uInt)deflateBuffer.size();
+
+	if (deflate(&deflateStream, Z_FINISH) != Z_STREAM_END)
+	{
+		boost::throw_exception(boost::enable_error_info (std::runtime_error("Zlib deflate failed")));
+	}
+
+	data.assign(deflateBuffer.begin(), deflateBuffer.begin() + deflateStream.total_out);
+}
+
+// -------------------------------------------------------------------
+// Uncompress
+// -------------------------------------------------------------------
+void ZlibCompressor::Uncompress(vector<unsigned char>& data)
+{
+	if (!inflateInitialized)
+	{
+		if (inflateInit(&inflateStream) != Z_OK)
+		{
+			boost::throw_exception(boost::enable_error_info (std::runtime_error("Zlib inflate initialization failed")));
+		}
+
+		inflateInitialized = true;
+	}
+	else
+	{
+		inflateReset(&inflateStream);
+	}
+
+	// Start from twice the compressed size and grow as needed
+	if (inflateBuffer.size() < data.size() * 2)
+	{
+		inflateBuffer.resize(data.size() * 2);
+	}
+
+	if (inflateBuffer.empty())
+	{
+		inflateBuffer.resize(1024);
+	}
+
+	inflateStream.next_in = data.empty() ? Z_NULL : &data[0];
+	inflateStream.avail_in = (uInt)data.size();
+	inflateStream.next_out = &inflateBuffer[0];
+	inflateStream.avail_out = (uInt)inflateBuffer.size();
+
+	while (true)
+	{
+		int result = inflate(&inflateStream, Z_NO_FLUSH);
+		if (result == Z_STREAM_END)
+		{
+			break;
+		}
+
+		if (result == Z_BUF_ERROR && inflateStream.avail_out == 0)
+		{
+			result = Z_OK;
+		}
+
+		if (result != Z_OK || (inflateStream.avail_in == 0 && inflateStream.avail_out != 0))
+		{
+			boost::throw_exception(boost::enable_error_info (std::runtime_error("Invalid compressed data")));
+		}
+
+		if (inflateStream.avail_out == 0)
+		{
+			uLong produced = inflateStream.total_out;
+			inflateBuffer.resize(inflateBuffer.size() * 2);
+
+			inflateStream.next_out = &inflateBuffer[produced];
+			inflateStream.avail_out = (uInt)(inflateBuffer.size() - produced);
+		}
+	}
+
+	data.assign(inflateBuffer.begin(), inflateBuffer.begin() + inflateStream.total_out);
+}
+
+}	// namespace Util
+}	// namespace Sfs2X
@@ -0,0 +1,91 @@
+// ===================================================================
+//
+// Description
+//		Contains the definition of ZlibCompressor
+//
+// Revision history
+//		Date			Description
+//		19-Oct-2026		First version
+//
+// ===================================================================
+#ifndef __ZlibCompressor__
+#define __ZlibCompressor__
+
+#include "Common.h"
+
+#include "../ZLib/zlib.h"
+
+#if defined(_MSC_VER)
+#pragma warning(disable:4786)			// STL library: disable warning 4786; this warning is generated due to a Microsoft bug
+#endif
+#include <vector>						// STL library: vector object
+using namespace std;					// STL library: declare the STL namespace
+
+namespace Sfs2X {
+namespace Util {
+
+	// -------------------------------------------------------------------
+	// Class ZlibCompressor
+	// -------------------------------------------------------------------
+	/// <summary>
+	/// Zlib compression state, reused across the packets of a connection
+	/// </summary>
+	///
+	/// <remarks>
+	/// The deflate and inflate streams are created on first use and then only reset, so compressing a packet does not
+	/// allocate the zlib state again; the output buffers are kept too.<br/>
+	/// Compression and decompression use separate state: one thread may compress while another one uncompresses,
+	/// but each direction must be used by one thread at a time.
+	/// </remarks>
+	class DLLImportExport ZlibCompressor
+	{
+	public:
+
+		// -------------------------------------------------------------------
+		// Public methods
+		// -------------------------------------------------------------------
+
+		ZlibCompressor();
+		virtual ~ZlibCompressor();
+
+		/// <summary>
+		/// Replaces the passed bytes with their zlib stream
+		/// </summary>
+		void Compress(vector<unsigned char>& data);
+
+		/// <summary>
+		/// Replaces the passed zlib stream with the bytes it holds
+		/// </summary>
+		/// <exception cref="std::runtime_error">The data is not a valid, complete zlib stream</exception>
+		void Uncompress(vector<unsigned char>& data);
+
+		// -------------------------------------------------------------------
+		// Public members
+		// -------------------------------------------------------------------
+
+	private:
+
+		// -------------------------------------------------------------------
+		// Private methods
+		// -------------------------------------------------------------------
+
+		ZlibCompressor(const ZlibCompressor&);
+		ZlibCompressor& operator=(const ZlibCompressor&);
+
+		// -------------------------------------------------------------------
+		// Private members
+		// -------------------------------------------------------------------
+
+		bool deflateInitialized;
+		z_stream deflateStream;
+		vector<unsigned char> deflateBuffer;
+
+		bool inflateInitialized;
+		z_stream inflateStream;
+		vector<unsigned char> inflateBuffer;
+	};
+
+}	// namespace Util
+}	// namespace Sfs2X
+
+#endif